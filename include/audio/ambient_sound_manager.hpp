@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <unordered_map>
 #include <glm/vec3.hpp>
 
 namespace wowee {
@@ -74,8 +75,12 @@ public:
     };
 
     uint64_t addEmitter(const glm::vec3& position, AmbientType type);
+    // Emitter owned by an ADT tile; dropped together by removeTileEmitters()
+    uint64_t addTileEmitter(int tileX, int tileY, const glm::vec3& position, AmbientType type);
+    void removeTileEmitters(int tileX, int tileY);
     void removeEmitter(uint64_t id);
     void clearEmitters();
+    size_t getEmitterCount() const { return emitterIndex_.size(); }
 
     // Time of day control (0-24 hours)
     void setGameTime(float hours);
@@ -96,7 +101,8 @@ private:
 
     struct AmbientSample {
         std::string path;
-        std::vector<uint8_t> data;
+        std::vector<uint8_t> data;     // Encoded file (short samples only)
+        std::string streamPath;        // Loose file streamed from disk (long loops)
         bool loaded;
     };
 
@@ -160,10 +166,29 @@ private:
     std::vector<AmbientSample> bellNightElfSounds_;
     std::vector<AmbientSample> bellTribalSounds_;
 
-    // Active emitters
-    std::vector<AmbientEmitter> emitters_;
+    // Emitters bucketed per tile, and within a tile by EMITTER_CELL_SIZE
+    // cells, so an update only visits cells within range of the listener.
+    static constexpr float EMITTER_CELL_SIZE = 64.0f;  // >= largest emitter range
+    struct EmitterTile {
+        float minX, minY, maxX, maxY;  // XY extent of emitters ever added
+        std::unordered_map<uint64_t, std::vector<AmbientEmitter>> cells;
+    };
+    struct EmitterLocation {
+        uint64_t tile;
+        uint64_t cell;
+        uint32_t slot;
+    };
+    std::unordered_map<uint64_t, EmitterTile> emitterTiles_;
+    std::unordered_map<uint64_t, EmitterLocation> emitterIndex_;
     uint64_t nextEmitterId_ = 1;
 
+    static uint64_t packKey(int32_t a, int32_t b);
+    static int32_t emitterCell(float v);
+    uint64_t insertEmitter(uint64_t tileKey, const glm::vec3& position, AmbientType type);
+    void eraseEmitterSlot(const EmitterLocation& loc);
+    void updateEmitter(AmbientEmitter& emitter, float deltaTime, const glm::vec3& cameraPos,
+                       int& activeFireCount, int& activeWaterCount);
+
     // State tracking
     float gameTimeHours_ = 12.0f;  // Default noon
     float volumeScale_ = 1.0f;
@@ -204,6 +229,8 @@ private:
     void updateCityAmbience(float deltaTime);
     void updateBellTolls(float deltaTime);
     bool loadSound(const std::string& path, AmbientSample& sample, pipeline::AssetManager* assets);
+    bool playSample2D(const AmbientSample& sample, float volume);
+    bool playSample3D(const AmbientSample& sample, const glm::vec3& position, float volume);
 
     // Time of day helpers
     bool isDaytime() const { return gameTimeHours_ >= 6.0f && gameTimeHours_ < 20.0f; }
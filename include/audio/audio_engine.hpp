@@ -1,5 +1,6 @@
 #pragma once
 
+#include "audio/voice_pool.hpp"
 #include <glm/glm.hpp>
 #include <memory>
 #include <string>
@@ -41,18 +42,40 @@ public:
     void setListenerOrientation(const glm::vec3& forward, const glm::vec3& up);
     const glm::vec3& getListenerPosition() const { return listenerPosition_; }
 
-    // Simple 2D sound playback (non-blocking)
-    bool playSound2D(const std::vector<uint8_t>& wavData, float volume = 1.0f, float pitch = 1.0f);
-    bool playSound2D(const std::string& mpqPath, float volume = 1.0f, float pitch = 1.0f);
+    // Simple 2D sound playback (non-blocking); goes through the shared voice pool
+    bool playSound2D(const std::vector<uint8_t>& wavData, float volume = 1.0f, float pitch = 1.0f,
+                     SoundCategory category = SoundCategory::EFFECT);
+    bool playSound2D(const std::string& mpqPath, float volume = 1.0f, float pitch = 1.0f,
+                     SoundCategory category = SoundCategory::EFFECT);
 
     // 3D positional sound playback
     bool playSound3D(const std::vector<uint8_t>& wavData, const glm::vec3& position,
-                     float volume = 1.0f, float pitch = 1.0f, float maxDistance = 100.0f);
+                     float volume = 1.0f, float pitch = 1.0f, float maxDistance = 100.0f,
+                     SoundCategory category = SoundCategory::EFFECT);
     bool playSound3D(const std::string& mpqPath, const glm::vec3& position,
-                     float volume = 1.0f, float pitch = 1.0f, float maxDistance = 100.0f);
-
-    // Music streaming (for background music)
-    bool playMusic(const std::vector<uint8_t>& musicData, float volume = 1.0f, bool loop = true);
+                     float volume = 1.0f, float pitch = 1.0f, float maxDistance = 100.0f,
+                     SoundCategory category = SoundCategory::EFFECT);
+
+    // Streamed playback from a filesystem path (long ambience loops): only a
+    // few seconds of decoded audio are resident per voice
+    bool playStream2D(const std::string& filePath, float volume = 1.0f,
+                      SoundCategory category = SoundCategory::AMBIENT);
+    bool playStream3D(const std::string& filePath, const glm::vec3& position,
+                      float volume = 1.0f, float pitch = 1.0f, float maxDistance = 100.0f,
+                      SoundCategory category = SoundCategory::AMBIENT);
+
+    // Byte budget of the decoded one-shot PCM cache (LRU)
+    void setSfxCacheBudget(size_t bytes);
+    size_t getSfxCacheBudget() const;
+    size_t getSfxCacheBytes() const;
+
+    // Voice pool (priorities, per-category limits, virtual voices)
+    VoicePool* getVoicePool() { return voicePool_.get(); }
+
+    // Music streaming (for background music). playMusicFile() decodes from
+    // disk; playMusic() keeps the encoded file in memory while it plays.
+    bool playMusicFile(const std::string& filePath, float volume = 1.0f, bool loop = true);
+    bool playMusic(std::vector<uint8_t> musicData, float volume = 1.0f, bool loop = true);
     void stopMusic();
     bool isMusicPlaying() const;
     void setMusicVolume(float volume);
@@ -65,13 +88,10 @@ private:
     AudioEngine(const AudioEngine&) = delete;
     AudioEngine& operator=(const AudioEngine&) = delete;
 
-    // Track active one-shot sounds for cleanup
-    struct ActiveSound {
-        ma_sound* sound;
-        void* buffer;  // ma_audio_buffer* - Keep audio buffer alive
-        std::shared_ptr<const std::vector<uint8_t>> pcmDataRef;  // Keep decoded PCM alive
-    };
-    std::vector<ActiveSound> activeSounds_;
+    bool playDecoded(const std::vector<uint8_t>& wavData, VoiceRequest& request);
+
+    // One-shot sounds (fixed voice storage, reaped in update())
+    std::unique_ptr<VoicePool> voicePool_;
 
     // Music track state
     ma_sound* musicSound_ = nullptr;
@@ -3,7 +3,6 @@
 #include <string>
 #include <cstdint>
 #include <unordered_map>
-#include <vector>
 
 namespace wowee {
 namespace pipeline { class AssetManager; }
@@ -48,7 +47,11 @@ private:
     float fadeTimer = 0.0f;
     float fadeDuration = 0.0f;
 
-    std::unordered_map<std::string, std::vector<uint8_t>> musicDataCache_;
+    // MPQ path -> loose file to stream from (empty: only readable through
+    // AssetManager, so it is buffered while it plays)
+    std::unordered_map<std::string, std::string> musicPathCache_;
+
+    const std::string& resolveMusicPath(const std::string& mpqPath);
 };
 
 } // namespace audio
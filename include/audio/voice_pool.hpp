@@ -0,0 +1,151 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declare miniaudio types to avoid exposing implementation in header
+struct ma_engine;
+
+namespace wowee {
+namespace audio {
+
+/** Mixer category of a one-shot sound; drives priority and concurrency limits. */
+enum class SoundCategory : uint8_t {
+    UI = 0,
+    VOICE,
+    SPELL,
+    COMBAT,
+    FOOTSTEP,
+    MOVEMENT,
+    MOUNT,
+    AMBIENT,
+    EFFECT,
+    COUNT
+};
+
+/**
+ * Decoded PCM shared between every voice playing it. Streamed clips carry
+ * only the format and length; their samples are paged in from disk.
+ */
+struct PcmClip {
+    uint32_t format = 0;      // ma_format
+    uint32_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint64_t frames = 0;
+    std::shared_ptr<const std::vector<uint8_t>> data;
+
+    float durationSeconds() const {
+        return sampleRate ? static_cast<float>(frames) / static_cast<float>(sampleRate) : 0.0f;
+    }
+};
+
+/** One play request as handed to VoicePool::play(). */
+struct VoiceRequest {
+    PcmClip clip;
+    std::string streamPath;     // Non-empty: stream this file instead of clip.data
+    SoundCategory category = SoundCategory::EFFECT;
+    float volume = 1.0f;        // Final sound volume (master already applied)
+    float pitch = 1.0f;         // Positional sounds only
+    bool positional = false;
+    glm::vec3 position{0.0f};
+    float maxDistance = 100.0f;
+};
+
+/**
+ * VoicePool - fixed set of mixer voices shared by all one-shot sounds
+ *
+ * Every voice's ma_sound/ma_audio_buffer lives in one preallocated array, so
+ * playing a sound no longer heap-allocates per play, and the number of sounds
+ * the mixer processes is bounded by MAX_VOICES no matter how many managers
+ * fire at once.
+ *
+ * Each request gets a score = category priority x estimated gain at the
+ * listener. When a category is at its limit, or all voices are busy, the new
+ * sound steals the lowest-scoring voice if it outranks it; otherwise it
+ * becomes a virtual voice. Virtual voices keep their playback clock running
+ * without mixing and are resumed at the right offset once they are audible
+ * and a voice is free. Positional sounds beyond maxDistance (or quieter than
+ * the audibility threshold) are virtualized up front.
+ *
+ * Not thread-safe: call from the thread that drives AudioEngine.
+ */
+class VoicePool {
+public:
+    static constexpr uint32_t MAX_VOICES = 48;
+    static constexpr uint32_t MAX_VIRTUAL_VOICES = 128;
+
+    struct Stats {
+        uint32_t realVoices = 0;
+        uint32_t virtualVoices = 0;
+        uint64_t played = 0;        // Started on a real voice
+        uint64_t virtualized = 0;   // Parked (at request time or demoted later)
+        uint64_t resumed = 0;       // Virtual -> real
+        uint64_t stolen = 0;        // Real voices taken by higher-scoring sounds
+        uint64_t dropped = 0;       // Discarded (expired, too short, or no room)
+    };
+
+    explicit VoicePool(ma_engine* engine);
+    ~VoicePool();
+
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    /**
+     * Play (or virtualize) a sound
+     * @return false if the clip could not be initialized
+     */
+    bool play(const VoiceRequest& request);
+
+    /** Number of busy voices streaming from disk. */
+    uint32_t getStreamingVoiceCount() const;
+
+    /** Reap finished voices, advance virtual voices and re-rank (once per frame). */
+    void update(float deltaTime);
+
+    void setListenerPosition(const glm::vec3& position) { listenerPosition_ = position; }
+
+    void stopAll();
+
+    void setCategoryLimit(SoundCategory category, uint32_t limit);
+    uint32_t getCategoryLimit(SoundCategory category) const {
+        return categoryLimits_[static_cast<size_t>(category)];
+    }
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct Voice;
+
+    struct VirtualVoice {
+        VoiceRequest request;
+        float elapsed = 0.0f;    // Seconds of the clip already "played"
+        float score = 0.0f;
+    };
+
+    float audibility(const VoiceRequest& request) const;
+    float score(const VoiceRequest& request, float audible) const;
+
+    bool startVoice(const VoiceRequest& request, float startSeconds, float voiceScore);
+    void releaseVoice(uint32_t busyIndex);
+    void demoteVoice(uint32_t busyIndex);
+    void addVirtual(const VoiceRequest& request, float elapsed, float voiceScore);
+    int32_t findVictim(SoundCategory category, bool sameCategoryOnly) const;
+    void promoteVirtualVoices();
+
+    ma_engine* engine_ = nullptr;
+    std::unique_ptr<Voice[]> voices_;
+    std::vector<uint32_t> freeVoices_;
+    std::vector<uint32_t> busyVoices_;
+    std::vector<VirtualVoice> virtualVoices_;
+    std::array<uint32_t, static_cast<size_t>(SoundCategory::COUNT)> categoryLimits_{};
+    std::array<uint32_t, static_cast<size_t>(SoundCategory::COUNT)> categoryCounts_{};
+    glm::vec3 listenerPosition_{0.0f};
+    Stats stats_;
+};
+
+} // namespace audio
+} // namespace wowee
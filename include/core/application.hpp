@@ -3,6 +3,7 @@
 #include "core/window.hpp"
 #include "core/input.hpp"
 #include "game/character.hpp"
+#include "rendering/async_model_cache.hpp"
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,16 @@ public:
     void run();
     void shutdown();
 
+    /** Hidden window, no UI; set before initialize() (--benchmark). */
+    void setHeadless(bool headless) { headless_ = headless; }
+
+    /**
+     * Fly the camera along a benchmark script and write a JSON report
+     * (see core/benchmark.hpp). Runs instead of run(); no server connection.
+     * @return False if the script or world could not be loaded
+     */
+    bool runBenchmark(const std::string& scriptPath, const std::string& reportPath);
+
     // State management
     AppState getState() const { return state; }
     void setState(AppState newState);
@@ -123,6 +134,7 @@ private:
 
     AppState state = AppState::AUTHENTICATION;
     bool running = false;
+    bool headless_ = false;
     std::string pendingCreatedCharacterName_;  // Auto-select after character creation
     bool playerCharacterSpawned = false;
     bool npcsSpawned = false;
@@ -276,6 +288,31 @@ private:
     std::vector<PendingGameObjectSpawn> pendingGameObjectSpawns_;
     void processGameObjectSpawnQueue();
 
+    // Game object / transport doodad models being read and parsed off-thread
+    std::unique_ptr<rendering::AsyncModelCache> modelCache_;
+    struct PendingGameObjectModel {
+        PendingGameObjectSpawn spawn;
+        std::string modelPath;
+        bool isWmo = false;
+        rendering::ModelHandle handle;
+    };
+    std::unordered_map<uint64_t, PendingGameObjectModel> pendingGameObjectModels_;  // guid → waiting spawn
+    struct PendingDoodad {
+        rendering::ModelHandle handle;
+        uint32_t wmoInstanceId = 0;
+        uint32_t modelId = 0;
+        glm::mat4 localTransform{1.0f};
+    };
+    std::vector<PendingDoodad> pendingDoodads_;
+    rendering::ModelHandle pendingMountModel_;
+    static constexpr int MAX_MODEL_UPLOADS_PER_FRAME = 4;
+    static constexpr float MODEL_UPLOAD_BUDGET_MS = 4.0f;
+    void processPendingModelLoads();
+    bool finishPendingGameObject(PendingGameObjectModel& pending, int& uploads);
+    bool createGameObjectWmoInstance(const PendingGameObjectSpawn& spawn, uint32_t modelId,
+                                     const std::string& modelPath);
+    bool createGameObjectM2Instance(const PendingGameObjectSpawn& spawn, uint32_t modelId);
+
     // Quest marker billboard sprites (above NPCs)
     void loadQuestMarkerModels();  // Now loads BLP textures
     void updateQuestMarkers();     // Updates billboard positions
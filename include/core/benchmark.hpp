@@ -0,0 +1,126 @@
+#pragma once
+
+#include "game/spline_path.hpp"
+#include "core/metrics.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace wowee {
+namespace pipeline { class AssetManager; }
+
+namespace core {
+
+/**
+ * Camera path for a headless benchmark run (--benchmark <script>)
+ *
+ * Plain-text script, one directive per line, '#' starts a comment:
+ *
+ *   name      stormwind_elwynn
+ *   map       Azeroth                 # ADT map directory
+ *   timestep  0.0166667               # Fixed simulation step in seconds
+ *   warmup    120                     # Frames at the first pose, not reported
+ *   streaming sync                    # sync: finish streaming before each frame
+ *                                     # async: measure streaming hitches too
+ *   key <time> <x> <y> <z> [yaw pitch]
+ *
+ * Keyframe positions are canonical WoW coordinates (+X north, +Y west,
+ * +Z up) and are joined by a Catmull-Rom spline. Yaw/pitch are camera
+ * angles in degrees as taken by Camera::setRotation(); a key without them
+ * looks along the path at the previous key's pitch (default -10).
+ */
+struct BenchmarkScript {
+    struct Keyframe {
+        float time = 0.0f;
+        glm::vec3 canonical{0.0f};
+        float yawDeg = 0.0f;
+        float pitchDeg = -10.0f;
+        bool faceAlongPath = true;
+    };
+
+    std::string path;
+    std::string name;
+    std::string mapName = "Azeroth";
+    float timestep = 1.0f / 60.0f;
+    int warmupFrames = 120;
+    bool syncStreaming = true;
+    std::vector<Keyframe> keyframes;
+
+    /** Parse a script file; logs and returns false on malformed input. */
+    bool load(const std::string& scriptPath);
+
+    float duration() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+
+    /** Camera pose at time t (seconds), render coordinates. */
+    void sample(float t, glm::vec3& renderPos, float& yawDeg, float& pitchDeg) const;
+
+private:
+    game::SplinePath spline_;
+    mutable uint32_t cursor_ = 0;
+};
+
+/** Per-frame measurements taken by the benchmark loop. */
+struct BenchmarkFrame {
+    double updateMs = 0.0;
+    double renderMs = 0.0;
+    double swapMs = 0.0;
+    double streamWaitMs = 0.0;    // Sync streaming only; excluded from frame time
+    uint32_t m2DrawCalls = 0;
+    uint32_t wmoDrawCalls = 0;
+    uint32_t characterDrawCalls = 0;
+    uint32_t terrainChunks = 0;   // One draw each
+    int loadedTiles = 0;
+
+    double frameMs() const { return updateMs + renderMs + swapMs; }
+};
+
+/**
+ * Accumulates benchmark frames and writes the JSON report
+ *
+ * Cumulative counters (draw calls aside, which are per frame) are read from
+ * the Metrics registry and the asset manager at begin() and again when the
+ * report is written, so the report only covers the measured frames.
+ */
+class BenchmarkRecorder {
+public:
+    void begin(const pipeline::AssetManager* assets);
+
+    void addFrame(const BenchmarkFrame& frame);
+
+    /** CPU/GPU time of one frame-graph pass for the current frame. */
+    void addPassTiming(const std::string& pass, double cpuMs, double gpuMs);
+
+    size_t getFrameCount() const { return frames_.size(); }
+
+    bool writeReport(const std::string& reportPath, const BenchmarkScript& script,
+                     const pipeline::AssetManager* assets, const std::string& glRenderer,
+                     const std::string& glVersion) const;
+
+private:
+    struct CounterState {
+        uint64_t assetHits = 0;
+        uint64_t assetMisses = 0;
+        uint64_t cookedHits = 0;
+        uint64_t tileCacheHits = 0;
+        uint64_t tileCacheMisses = 0;
+        uint64_t uploadBytes = 0;
+        Histogram::Snapshot tilePrepare;
+        Histogram::Snapshot tileFinalize;
+    };
+
+    static CounterState readCounters(const pipeline::AssetManager* assets);
+
+    struct PassSamples {
+        std::vector<double> cpuMs;
+        std::vector<double> gpuMs;
+    };
+
+    std::vector<BenchmarkFrame> frames_;
+    std::map<std::string, PassSamples> passes_;
+    CounterState start_;
+};
+
+} // namespace core
+} // namespace wowee
@@ -38,6 +38,11 @@ public:
      */
     bool isMemoryPressure() const;
 
+    /**
+     * Get peak resident set size of this process in bytes
+     */
+    size_t getPeakRSS() const;
+
 private:
     MemoryMonitor() = default;
     size_t totalRAM_ = 0;
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wowee {
+namespace core {
+
+/** Number of per-thread shards behind each counter and histogram. */
+constexpr size_t METRICS_SHARDS = 16;
+
+/** Shard of the calling thread (assigned round-robin on first use). */
+size_t metricsShard();
+
+/**
+ * Monotonic counter. add() is a relaxed atomic add on the calling thread's
+ * shard, so hot paths on different threads never contend on a cache line.
+ */
+class Counter {
+public:
+    void add(uint64_t n = 1) { shards_[metricsShard()].value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, METRICS_SHARDS> shards_;
+};
+
+/** Point-in-time value (queue depth, loaded tiles, cache bytes). */
+class Gauge {
+public:
+    void set(double v) { value_.store(v, std::memory_order_relaxed); }
+    void add(double d) { value_.fetch_add(d, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * Latency histogram with fixed exponential buckets (seconds): 10us doubling
+ * up to ~84s, plus +Inf. observe() touches only the calling thread's shard;
+ * snapshot() sums shards for export and percentile estimates.
+ */
+class Histogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 24;
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT + 1> counts{};  // Per bucket (not cumulative), last = +Inf
+        uint64_t count = 0;
+        double sum = 0.0;
+
+        /** Estimated q-quantile (0..1), interpolated within its bucket. */
+        double quantile(double q) const;
+        double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    void observe(double seconds);
+    Snapshot snapshot() const;
+
+    /** Upper bound of each finite bucket in seconds. */
+    static const std::array<double, BUCKET_COUNT>& bounds();
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT + 1> counts{};
+        std::atomic<double> sum{0.0};
+    };
+    std::array<Shard, METRICS_SHARDS> shards_;
+};
+
+/** Observes the elapsed time of a scope into a histogram. */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        histogram_.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * Metrics - process-wide registry of counters, gauges and histograms
+ *
+ * Metrics are registered once by name (Prometheus naming, optional label
+ * set such as `kind="m2"`) and the returned reference stays valid for the
+ * life of the process, so call sites cache it in a function-local static:
+ *
+ *   static auto& reads = core::Metrics::getInstance().counter(
+ *       "wowee_asset_reads_total", "Asset reads");
+ *   reads.add();
+ *
+ * exportText() renders the Prometheus text exposition format. The exporter
+ * thread (startExporter) periodically writes it to $WOWEE_METRICS_FILE
+ * and/or serves it on 127.0.0.1:$WOWEE_METRICS_PORT for soak runs.
+ */
+class Metrics {
+public:
+    static Metrics& getInstance();
+
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /** Prometheus text exposition of every registered metric. */
+    std::string exportText() const;
+
+    /** Write exportText() to path (temp file + rename). */
+    bool writeTextFile(const std::string& path) const;
+
+    /** Histogram snapshots keyed by "name{labels}" (HUD display). */
+    std::vector<std::pair<std::string, Histogram::Snapshot>> histogramSnapshots() const;
+
+    /**
+     * Start the export thread if WOWEE_METRICS_FILE or WOWEE_METRICS_PORT is
+     * set (WOWEE_METRICS_INTERVAL: file write period in seconds, default 10)
+     */
+    void startExporter();
+    void stopExporter();
+
+private:
+    Metrics() = default;
+    ~Metrics();
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::string labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family {
+        Type type = Type::COUNTER;
+        std::string help;
+        std::vector<std::unique_ptr<Series>> series;
+    };
+
+    Series& findOrCreate(const std::string& name, const std::string& help,
+                         const std::string& labels, Type type);
+    void exporterLoop(std::string filePath, int port, float intervalSeconds);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+
+    std::thread exporterThread_;
+    std::mutex exporterMutex_;
+    std::condition_variable exporterCV_;
+    bool exporterStop_ = false;
+};
+
+} // namespace core
+} // namespace wowee
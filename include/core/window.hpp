@@ -14,6 +14,7 @@ struct WindowConfig {
     bool fullscreen = false;
     bool vsync = true;
     bool resizable = true;
+    bool hidden = false;        // Headless runs (benchmark); still creates a GL context
 };
 
 class Window {
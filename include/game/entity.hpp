@@ -4,6 +4,8 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace wowee {
 namespace game {
@@ -75,6 +77,7 @@ public:
         z = pz;
         orientation = o;
         isMoving_ = false; // Instant position set cancels interpolation
+        markIndexDirty();
     }
 
     // Movement interpolation (syncs entity position with renderer during movement)
@@ -93,6 +96,7 @@ public:
 
     void updateMovement(float deltaTime) {
         if (!isMoving_) return;
+        markIndexDirty();
         moveElapsed_ += deltaTime;
         float t = moveElapsed_ / moveDuration_;
         if (t >= 1.0f) {
@@ -137,6 +141,16 @@ public:
     }
 
 protected:
+    friend class EntityManager;
+
+    // Queue this entity for EntityManager::updateSpatialIndex() (no-op if not indexed)
+    void markIndexDirty() {
+        if (indexDirtyList_ && !indexDirty_) {
+            indexDirty_ = true;
+            indexDirtyList_->push_back(guid);
+        }
+    }
+
     uint64_t guid = 0;
     ObjectType type = ObjectType::OBJECT;
 
@@ -155,6 +169,10 @@ protected:
     float moveEndX_ = 0, moveEndY_ = 0, moveEndZ_ = 0;
     float moveDuration_ = 0;
     float moveElapsed_ = 0;
+
+    // Spatial index bookkeeping, owned by EntityManager
+    std::vector<uint64_t>* indexDirtyList_ = nullptr;
+    bool indexDirty_ = false;
 };
 
 /**
@@ -171,10 +189,10 @@ public:
 
     // Health
     uint32_t getHealth() const { return health; }
-    void setHealth(uint32_t h) { health = h; }
+    void setHealth(uint32_t h) { health = h; markIndexDirty(); }
 
     uint32_t getMaxHealth() const { return maxHealth; }
-    void setMaxHealth(uint32_t h) { maxHealth = h; }
+    void setMaxHealth(uint32_t h) { maxHealth = h; markIndexDirty(); }
 
     // Power (mana/rage/energy)
     uint32_t getPower() const { return power; }
@@ -196,7 +214,7 @@ public:
 
     // Display ID (model display)
     uint32_t getDisplayId() const { return displayId; }
-    void setDisplayId(uint32_t id) { displayId = id; }
+    void setDisplayId(uint32_t id) { displayId = id; markIndexDirty(); }
 
     // Mount display ID (UNIT_FIELD_MOUNTDISPLAYID, index 69)
     uint32_t getMountDisplayId() const { return mountDisplayId; }
@@ -204,7 +222,7 @@ public:
 
     // Unit flags (UNIT_FIELD_FLAGS, index 59)
     uint32_t getUnitFlags() const { return unitFlags; }
-    void setUnitFlags(uint32_t f) { unitFlags = f; }
+    void setUnitFlags(uint32_t f) { unitFlags = f; markIndexDirty(); }
 
     // Dynamic flags (UNIT_DYNAMIC_FLAGS, index 147)
     uint32_t getDynamicFlags() const { return dynamicFlags; }
@@ -221,7 +239,7 @@ public:
     uint32_t getFactionTemplate() const { return factionTemplate; }
     void setFactionTemplate(uint32_t f) { factionTemplate = f; }
     bool isHostile() const { return hostile; }
-    void setHostile(bool h) { hostile = h; }
+    void setHostile(bool h) { hostile = h; markIndexDirty(); }
 
 protected:
     std::string name;
@@ -272,7 +290,7 @@ public:
     void setEntry(uint32_t e) { entry = e; }
 
     uint32_t getDisplayId() const { return displayId; }
-    void setDisplayId(uint32_t id) { displayId = id; }
+    void setDisplayId(uint32_t id) { displayId = id; markIndexDirty(); }
 
 protected:
     std::string name;
@@ -280,11 +298,57 @@ protected:
     uint32_t displayId = 0;
 };
 
+/**
+ * Dense per-kind entity storage indexed by EntityManager
+ */
+enum class EntityKind : uint8_t {
+    UNIT = 0,
+    PLAYER = 1,
+    GAMEOBJECT = 2,
+    COUNT = 3
+};
+
+inline constexpr uint8_t entityKindBit(EntityKind kind) {
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(kind));
+}
+
+/**
+ * Hot per-entity data in SoA form (one array per field, same index per entity).
+ * Mirrors the Entity objects; an entity's slot is refreshed by
+ * EntityManager::updateSpatialIndex() after its position or hot fields change.
+ */
+struct EntityHotData {
+    std::vector<uint64_t> guid;
+    std::vector<Entity*> entity;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<uint32_t> displayId;
+    std::vector<uint32_t> flags;      // UNIT_FIELD_FLAGS (0 for game objects)
+    std::vector<uint32_t> health;
+    std::vector<uint32_t> maxHealth;
+    std::vector<uint8_t> hostile;
+
+    size_t size() const { return guid.size(); }
+};
+
 /**
  * Entity manager for tracking all entities in view
+ *
+ * Entities are owned by a GUID hash map. Units, players and game objects are
+ * additionally packed into dense per-kind SoA arrays and bucketed in a
+ * uniform 2D grid, so proximity queries (tab-targeting, resync scans) touch
+ * only nearby cells instead of every entity in view. Entities queue
+ * themselves when their position or hot fields change, so the per-frame
+ * refresh only touches entities that changed.
  */
 class EntityManager {
 public:
+    static constexpr float SPATIAL_CELL_SIZE = 32.0f;  // Grid cell edge (world units)
+    static constexpr uint8_t KIND_UNITS = entityKindBit(EntityKind::UNIT);
+    static constexpr uint8_t KIND_PLAYERS = entityKindBit(EntityKind::PLAYER);
+    static constexpr uint8_t KIND_GAMEOBJECTS = entityKindBit(EntityKind::GAMEOBJECT);
+
     // Add entity
     void addEntity(uint64_t guid, std::shared_ptr<Entity> entity);
 
@@ -298,22 +362,69 @@ public:
     bool hasEntity(uint64_t guid) const;
 
     // Get all entities
-    const std::map<uint64_t, std::shared_ptr<Entity>>& getEntities() const {
+    const std::unordered_map<uint64_t, std::shared_ptr<Entity>>& getEntities() const {
         return entities;
     }
 
     // Clear all entities
-    void clear() {
-        entities.clear();
-    }
+    void clear();
 
     // Get entity count
     size_t getEntityCount() const {
         return entities.size();
     }
 
+    /**
+     * Refresh the SoA slot and grid cell of every entity whose position or
+     * hot fields changed since the last call (setters queue them).
+     * Call once per frame after movement interpolation.
+     */
+    void updateSpatialIndex();
+
+    /** Dense hot data for one kind (indices are unstable across add/remove). */
+    const EntityHotData& getHotData(EntityKind kind) const {
+        return hotData[static_cast<size_t>(kind)];
+    }
+
+    /**
+     * Collect GUIDs of indexed entities within radius (3D distance) of a point.
+     * @param kindMask Bitmask of KIND_* values
+     * @param out Cleared, then filled in unspecified order
+     */
+    void queryRadius(float x, float y, float z, float radius, uint8_t kindMask,
+                     std::vector<uint64_t>& out) const;
+
+    /**
+     * Nearest living hostile unit/player within maxRadius; searches the grid
+     * ring by ring outward and stops once no closer cell can remain.
+     * @return GUID, or 0 if none
+     */
+    uint64_t queryNearestHostile(float x, float y, float z, float maxRadius,
+                                 uint64_t excludeGuid = 0,
+                                 uint8_t kindMask = KIND_UNITS | KIND_PLAYERS) const;
+
 private:
-    std::map<uint64_t, std::shared_ptr<Entity>> entities;
+    struct IndexRecord {
+        EntityKind kind = EntityKind::UNIT;
+        uint32_t dense = 0;
+        uint64_t cell = 0;
+        uint32_t cellSlot = 0;
+    };
+
+    static bool kindForType(ObjectType type, EntityKind& kind);
+    static uint64_t cellKey(int32_t cx, int32_t cy);
+    static int32_t cellCoord(float v);
+    void writeHotData(EntityKind kind, uint32_t dense, const Entity& entity);
+    void refreshEntity(uint64_t guid);
+    void insertIntoCell(uint64_t guid, IndexRecord& rec, uint64_t cell);
+    void removeFromCell(const IndexRecord& rec);
+    void unindex(uint64_t guid);
+
+    std::unordered_map<uint64_t, std::shared_ptr<Entity>> entities;
+    std::unordered_map<uint64_t, IndexRecord> indexRecords;
+    EntityHotData hotData[static_cast<size_t>(EntityKind::COUNT)];
+    std::unordered_map<uint64_t, std::vector<uint64_t>> spatialGrid;
+    std::vector<uint64_t> dirtyEntities;  // Queued by Entity::markIndexDirty()
 };
 
 } // namespace game
@@ -33,6 +33,7 @@ struct ExpansionProfile {
     uint32_t maxLevel = 60;
     std::vector<uint32_t> races;
     std::vector<uint32_t> classes;
+    std::vector<std::string> preloadDbcs;  // Loaded on worker threads during loading screens
 
     std::string versionString() const;  // e.g. "3.3.5a"
 };
@@ -7,9 +7,12 @@
 #include "game/inventory.hpp"
 #include "game/spell_defines.hpp"
 #include "game/group_defines.hpp"
+#include "game/spline_path.hpp"
+#include "pipeline/dbc_table.hpp"
 #include <glm/glm.hpp>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <deque>
 #include <array>
@@ -19,6 +22,9 @@
 #include <unordered_set>
 #include <map>
 #include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <algorithm>
 
 namespace wowee::game {
@@ -858,8 +864,9 @@ public:
     const TrainerListData& getTrainerSpells() const { return currentTrainerList_; }
     void trainSpell(uint32_t spellId);
     void closeTrainer();
-    const std::string& getSpellName(uint32_t spellId) const;
-    const std::string& getSpellRank(uint32_t spellId) const;
+    /** Spell.dbc name/rank (views into the DBC string block; empty if unknown). */
+    std::string_view getSpellName(uint32_t spellId) const;
+    std::string_view getSpellRank(uint32_t spellId) const;
     const std::string& getSkillLineName(uint32_t spellId) const;
 
     struct TrainerTab {
@@ -950,6 +957,20 @@ private:
      */
     void handleWardenData(network::Packet& packet);
 
+    /**
+     * Decrypt and handle one SMSG_WARDEN_DATA payload (Warden worker thread)
+     */
+    void processWardenPayload(const std::vector<uint8_t>& data);
+
+    /**
+     * Send Warden responses queued by the worker, in order (main thread)
+     */
+    void flushWardenResponses();
+
+    void startWardenWorker();
+    void stopWardenWorker();
+    void wardenWorkerLoop();
+
     /**
      * Handle SMSG_ACCOUNT_DATA_TIMES from server
      */
@@ -1206,6 +1227,11 @@ private:
     std::vector<uint64_t> tabCycleList;
     int tabCycleIndex = -1;
     bool tabCycleStale = true;
+    static constexpr float TARGETING_RANGE = 100.0f;      // First targeting search radius
+    static constexpr float MAX_TARGETING_RANGE = 1600.0f; // Search widens up to this when nothing is closer
+    // Units/players of the given kinds within the smallest range that finds any, nearest to (x, y, z) first
+    void collectTargetCandidates(uint8_t kindMask, bool hostileOnly, float x, float y, float z,
+                                 std::vector<uint64_t>& out);
 
     // Heartbeat
     uint32_t pingSequence = 0;               // Ping sequence number (increments)
@@ -1436,10 +1462,11 @@ private:
     bool taxiClientActive_ = false;
     float taxiLandingCooldown_ = 0.0f;  // Prevent re-entering taxi right after landing
     float taxiStartGrace_ = 0.0f;       // Ignore transient landing/dismount checks right after takeoff
-    size_t taxiClientIndex_ = 0;
     std::vector<glm::vec3> taxiClientPath_;
+    SplinePath taxiClientSpline_;       // Built from taxiClientPath_, with arc-length table
     float taxiClientSpeed_ = 32.0f;
-    float taxiClientSegmentProgress_ = 0.0f;
+    float taxiClientDistance_ = 0.0f;   // Distance flown along taxiClientSpline_
+    uint32_t taxiClientCursor_ = 0;     // Arc-length lookup hint
     bool taxiRecoverPending_ = false;
     uint32_t taxiRecoverMapId_ = 0;
     glm::vec3 taxiRecoverPos_{0.0f};
@@ -1492,8 +1519,7 @@ private:
     // Trainer
     bool trainerWindowOpen_ = false;
     TrainerListData currentTrainerList_;
-    struct SpellNameEntry { std::string name; std::string rank; };
-    std::unordered_map<uint32_t, SpellNameEntry> spellNameCache_;
+    pipeline::DBCTable<pipeline::SpellRecord> spellTable_;
     bool spellNameCacheLoaded_ = false;
     std::vector<TrainerTab> trainerTabs_;
     void handleTrainerList(network::Packet& packet);
@@ -1547,6 +1573,15 @@ private:
     uint8_t wardenCheckOpcodes_[9] = {};
     bool loadWardenCRFile(const std::string& moduleHashHex);
 
+    // Warden worker: module decode/init and check handling run off the main
+    // thread; payloads are processed and replies sent in arrival order
+    std::thread wardenWorker_;
+    std::mutex wardenMutex_;
+    std::condition_variable wardenCV_;
+    std::deque<std::vector<uint8_t>> wardenInbox_;   // Encrypted SMSG payloads
+    std::deque<std::vector<uint8_t>> wardenOutbox_;  // Encrypted CMSG payloads
+    bool wardenWorkerStop_ = false;
+
     // ---- XP tracking ----
     uint32_t playerXp_ = 0;
     uint32_t playerNextLevelXp_ = 0;
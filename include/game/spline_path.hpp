@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace wowee::game {
+
+/**
+ * Uniform Catmull-Rom spline through a waypoint list, precomputed for sampling
+ *
+ * Each segment's cubic is stored in power form, so a sample is one Horner
+ * evaluation instead of gathering four control points. Segments are located
+ * either by knot time (transport paths: binary search over the knot times,
+ * plus a caller-held cursor that makes steady playback O(1)) or by distance
+ * travelled (taxi flights: an arc-length table sampled per segment, which
+ * gives constant-speed motion along the curve).
+ */
+class SplinePath {
+public:
+    static constexpr uint32_t ARC_SAMPLES_PER_SEGMENT = 16;
+
+    /**
+     * Build segment coefficients; segment i runs from points[i] to points[i + 1]
+     * @param wrapIndices Take end neighbours from the other end of the list
+     *                    (index-looped path) instead of clamping
+     */
+    void build(const std::vector<glm::vec3>& points, bool wrapIndices);
+
+    /** Knot time in ms per point (one per build() point) for findSegmentByTime(). */
+    void setKnotTimes(std::vector<uint32_t> knotTimesMs);
+
+    /** Sample segment lengths for locateByDistance() and totalLength(). */
+    void buildArcLengthTable();
+
+    void clear();
+    bool empty() const { return segments_.empty(); }
+    size_t segmentCount() const { return segments_.size(); }
+
+    glm::vec3 evaluate(size_t segment, float t) const;
+    glm::vec3 derivative(size_t segment, float t) const;
+    /** Straight line from a segment's start point to its end point. */
+    glm::vec3 chord(size_t segment) const;
+
+    /**
+     * Segment i with knot[i] <= timeMs < knot[i + 1], or the last segment if
+     * none contains it (matches the old linear scan)
+     * @param cursor Segment from the previous lookup; updated
+     */
+    size_t findSegmentByTime(uint32_t timeMs, uint32_t& cursor) const;
+
+    /** Position of timeMs within a segment, clamped to [0, 1]. */
+    float segmentParam(size_t segment, uint32_t timeMs) const;
+
+    float totalLength() const { return arcLength_.empty() ? 0.0f : arcLength_.back(); }
+
+    /**
+     * Segment and local parameter at a distance along the curve (clamped
+     * to [0, totalLength()])
+     * @param cursor Arc-table interval from the previous lookup; updated
+     */
+    void locateByDistance(float distance, uint32_t& cursor, size_t& segment, float& t) const;
+
+private:
+    struct Segment {
+        glm::vec3 a, b, c, d;   // p(t) = a + b*t + c*t^2 + d*t^3
+    };
+
+    std::vector<Segment> segments_;
+    std::vector<uint32_t> knotMs_;
+    bool knotsSorted_ = true;
+    std::vector<float> arcLength_;  // Distance at each sample; last entry is the total
+};
+
+} // namespace wowee::game
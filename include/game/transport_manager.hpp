@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/spline_path.hpp"
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
@@ -30,6 +31,7 @@ struct TransportPath {
     bool zOnly;    // True if path only has Z movement (elevator/bobbing), false if real XY travel
     bool fromDBC;  // True if loaded from TransportAnimation.dbc, false for runtime fallback/custom paths
     bool worldCoords = false;  // True if points are absolute world coords (TaxiPathNode), not local offsets
+    SplinePath spline;         // Segment coefficients + knot times, built from points when the path is stored
 };
 
 struct ActiveTransport {
@@ -54,6 +56,7 @@ struct ActiveTransport {
 
     // Time-based animation (deterministic, no drift)
     uint32_t localClockMs;         // Local path time in milliseconds
+    uint32_t pathSegmentCursor = 0; // Spline segment from the last evaluation (lookup hint)
     bool hasServerClock;            // Whether we've synced with server time
     int32_t serverClockOffsetMs;   // Offset: serverClock - localNow
     bool useClientAnimation;        // Use client-side path animation
@@ -133,8 +136,8 @@ public:
 
 private:
     void updateTransportMovement(ActiveTransport& transport, float deltaTime);
-    glm::vec3 evalTimedCatmullRom(const TransportPath& path, uint32_t pathTimeMs);
-    glm::quat orientationFromTangent(const TransportPath& path, uint32_t pathTimeMs);
+    glm::vec3 evalTimedCatmullRom(const TransportPath& path, uint32_t pathTimeMs, uint32_t* segmentCursor = nullptr);
+    glm::quat orientationFromTangent(const TransportPath& path, uint32_t pathTimeMs, uint32_t* segmentCursor = nullptr);
     void updateTransformMatrices(ActiveTransport& transport);
 
     std::unordered_map<uint64_t, ActiveTransport> transports_;
@@ -137,6 +137,21 @@ public:
      */
     std::vector<uint8_t> readData(uint32_t address, size_t size);
 
+    /**
+     * Serialize emulator state: registers, module image, live stack, used
+     * heap, API stub area and heap allocation table
+     *
+     * @return Snapshot blob (empty if not initialized)
+     */
+    std::vector<uint8_t> saveSnapshot() const;
+
+    /**
+     * Rebuild the emulator from a saveSnapshot() blob instead of initialize()
+     *
+     * API hooks are not part of the snapshot; call setupCommonAPIHooks() after.
+     */
+    bool restoreSnapshot(const std::vector<uint8_t>& snapshot);
+
 private:
     uc_engine* uc_;                  // Unicorn engine instance
     uint32_t moduleBase_;            // Module base address
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 
 namespace wowee {
 namespace game {
@@ -11,9 +13,25 @@ namespace game {
  * Provides WoW.exe PE memory image for Warden MEM_CHECK responses.
  * Parses PE headers to build a flat virtual memory image, then serves
  * readMemory() calls with real bytes. Also mocks KUSER_SHARED_DATA.
+ * A sorted section table (built once at load) maps section VAs to their
+ * bytes; reads inside a section go through a binary search over it.
+ *
+ * PAGE_CHECK hashes (HMAC-SHA1 keyed by the check seed) are memoized by
+ * (seed, address, length): servers repeat the same checks every few
+ * seconds, so only the first occurrence hashes image bytes.
+ *
+ * Not thread-safe; used from the Warden worker only.
  */
 class WardenMemory {
 public:
+    /** PE section mapped into the image, sorted by virtual address. */
+    struct Section {
+        uint32_t va = 0;           // Absolute virtual address
+        uint32_t size = 0;         // Mapped bytes (VirtualSize, zero-filled past the raw data)
+        uint32_t fileOffset = 0;   // PointerToRawData
+        char name[9] = {};
+    };
+
     WardenMemory();
     ~WardenMemory();
 
@@ -29,6 +47,24 @@ public:
      */
     bool readMemory(uint32_t va, uint8_t length, uint8_t* outBuf) const;
 
+    /** Section containing va, or nullptr (headers and gaps are not sections). */
+    const Section* findSection(uint32_t va) const;
+
+    const std::vector<Section>& getSections() const { return sections_; }
+
+    /**
+     * HMAC-SHA1 of image bytes [va, va+length) keyed by the 4-byte seed
+     * @return false if the range is outside the image
+     */
+    bool hashPage(uint32_t seed, uint32_t va, uint8_t length, uint8_t outHash[20]) const;
+
+    /** True if hashPage(seed, va, length) equals expected. */
+    bool pageMatches(uint32_t seed, const uint8_t expected[20], uint32_t va, uint8_t length) const;
+
+    size_t getPageCacheSize() const { return pageHashCache_.size(); }
+    uint64_t getPageCacheHits() const { return pageCacheHits_; }
+    uint64_t getPageCacheMisses() const { return pageCacheMisses_; }
+
     bool isLoaded() const { return loaded_; }
 
 private:
@@ -42,6 +78,28 @@ private:
     static constexpr uint32_t KUSER_SIZE = 0x1000;
     uint8_t kuserData_[KUSER_SIZE] = {};
 
+    std::vector<Section> sections_;
+
+    // Memoized PAGE_CHECK hashes, key = (seed, va, length)
+    struct PageKey {
+        uint32_t seed;
+        uint32_t va;
+        uint8_t length;
+        bool operator==(const PageKey& o) const {
+            return seed == o.seed && va == o.va && length == o.length;
+        }
+    };
+    struct PageKeyHash {
+        size_t operator()(const PageKey& k) const {
+            uint64_t v = (static_cast<uint64_t>(k.seed) << 32) ^ (static_cast<uint64_t>(k.va) << 8) ^ k.length;
+            return std::hash<uint64_t>{}(v);
+        }
+    };
+    static constexpr size_t MAX_PAGE_CACHE_ENTRIES = 4096;
+    mutable std::unordered_map<PageKey, std::array<uint8_t, 20>, PageKeyHash> pageHashCache_;
+    mutable uint64_t pageCacheHits_ = 0;
+    mutable uint64_t pageCacheMisses_ = 0;
+
     bool parsePE(const std::vector<uint8_t>& fileData);
     void initKuserSharedData();
     std::string findWowExe() const;
@@ -122,6 +122,26 @@ public:
      */
     void unload();
 
+    /**
+     * Provide post-init state saved by an earlier session
+     *
+     * When set before load(), step 8 restores the emulator from it instead of
+     * running the module's init routine again. Ignored if it does not match.
+     */
+    void setInitSnapshot(std::vector<uint8_t> snapshot) { initSnapshot_ = std::move(snapshot); }
+
+    /**
+     * Serialize post-init emulator state for the snapshot cache
+     *
+     * Call right after load(); empty when built without Unicorn.
+     */
+    std::vector<uint8_t> saveInitSnapshot() const;
+
+    /**
+     * Check if load() restored a snapshot instead of initializing
+     */
+    bool isRestoredFromSnapshot() const { return restoredFromSnapshot_; }
+
     const void* getModuleMemory() const { return moduleMemory_; }
     size_t getModuleSize() const { return moduleSize_; }
     const std::vector<uint8_t>& getDecompressedData() const { return decompressedData_; }
@@ -140,6 +160,9 @@ private:
     size_t relocDataOffset_ = 0;           // Offset into decompressedData_ where relocation data starts
     WardenFuncList funcList_;              // Callback functions
     std::unique_ptr<WardenEmulator> emulator_; // Cross-platform x86 emulator
+    uint32_t funcListAddr_ = 0;            // WardenFuncList returned by module init (emulated)
+    std::vector<uint8_t> initSnapshot_;    // Post-init state to restore instead of init
+    bool restoredFromSnapshot_ = false;
 
     // Validation and loading steps
     bool verifyMD5(const std::vector<uint8_t>& data,
@@ -154,6 +177,7 @@ private:
     bool applyRelocations();
     bool bindAPIs();
     bool initializeModule();
+    bool restoreInitSnapshot();
 };
 
 /**
@@ -213,12 +237,24 @@ public:
     bool loadCachedModule(const std::vector<uint8_t>& md5Hash,
                          std::vector<uint8_t>& moduleDataOut);
 
+    /**
+     * Save a module's post-init snapshot next to its cached module (<md5>.snap)
+     */
+    bool cacheSnapshot(const std::vector<uint8_t>& md5Hash,
+                       const std::vector<uint8_t>& snapshot);
+
+    /**
+     * Load a module's post-init snapshot from disk cache
+     */
+    bool loadCachedSnapshot(const std::vector<uint8_t>& md5Hash,
+                            std::vector<uint8_t>& snapshotOut);
+
 private:
     std::map<std::vector<uint8_t>, std::shared_ptr<WardenModule>> modules_;
     std::map<std::vector<uint8_t>, std::vector<uint8_t>> downloadBuffer_; // Partial downloads
     std::string cacheDirectory_;
 
-    std::string getCachePath(const std::vector<uint8_t>& md5Hash);
+    std::string getCachePath(const std::vector<uint8_t>& md5Hash, const char* extension = ".wdn");
 };
 
 } // namespace game
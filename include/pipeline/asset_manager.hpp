@@ -2,13 +2,23 @@
 
 #include "pipeline/blp_loader.hpp"
 #include "pipeline/dbc_loader.hpp"
+#include "pipeline/dbc_cache.hpp"
 #include "pipeline/asset_manifest.hpp"
+#include "pipeline/asset_pack.hpp"
+#include "pipeline/cooked_asset.hpp"
+#include "pipeline/m2_loader.hpp"
+#include "pipeline/wmo_loader.hpp"
+#include "pipeline/terrain_mesh.hpp"
 #include "pipeline/loose_file_reader.hpp"
 #include <memory>
 #include <string>
 #include <vector>
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
+#include <set>
+#include <thread>
 
 namespace wowee {
 namespace pipeline {
@@ -16,9 +26,11 @@ namespace pipeline {
 /**
  * AssetManager - Unified interface for loading WoW assets
  *
- * Reads pre-extracted loose files indexed by manifest.json.
- * Supports an override directory (Data/override/) checked before the manifest
- * for HD textures, custom content, or mod overrides.
+ * Reads pre-extracted assets either from a packed store indexed by
+ * assets.wpi (`asset_extract --pack`, preferred when present) or from loose
+ * files indexed by manifest.json.
+ * Supports an override directory (Data/override/) checked before the base
+ * data for HD textures, custom content, or mod overrides.
  * Use the asset_extract tool to extract MPQ archives first.
  * All reads are fully parallel (no serialization mutex needed).
  */
@@ -29,7 +41,7 @@ public:
 
     /**
      * Initialize asset manager
-     * @param dataPath Path to directory containing manifest.json and extracted assets
+     * @param dataPath Path to directory containing assets.wpi or manifest.json
      * @return true if initialization succeeded
      */
     bool initialize(const std::string& dataPath);
@@ -51,20 +63,66 @@ public:
      */
     BLPImage loadTexture(const std::string& path);
 
+    /**
+     * Cooked DXT mip chain of a BLP, for glCompressedTexImage2D. Never
+     * parses the source: returns an invalid image if there is no fresh
+     * blob (or a PNG override), and callers fall back to loadTexture().
+     */
+    BLPCompressedImage loadCompressedTexture(const std::string& path);
+
+    /**
+     * Load an M2 model with its 00.skin applied (WotLK-format models).
+     * Uses the cooked blob from asset_cook when it matches the sources.
+     * @param path Virtual path to the .m2 file
+     * @return Model (check isValid())
+     */
+    M2Model loadM2Model(const std::string& path);
+
+    /**
+     * Load a root WMO and all of its group files. Groups (with collision
+     * grids) come from the cooked blob when it matches the root and every
+     * group file.
+     * @param path Virtual path to the root .wmo
+     * @return Model (check isValid())
+     */
+    WMOModel loadWMOModel(const std::string& path);
+
+    /**
+     * Cooked TerrainMeshGenerator::generate output for an ADT
+     * @return false if there is no fresh blob (caller generates the mesh)
+     */
+    bool loadCookedTerrainMesh(const std::string& adtPath, TerrainMesh& mesh);
+
     /**
      * Set expansion-specific data path for CSV DBC lookup.
      * When set, loadDBC() checks expansionDataPath/db/Name.csv before
      * falling back to the manifest (binary DBC from extracted MPQs).
+     * Parsed CSVs are compiled into the DBC binary cache for later runs.
      */
     void setExpansionDataPath(const std::string& path);
 
     /**
-     * Load a DBC file
+     * Load a DBC file. Thread-safe: concurrent requests for the same table
+     * wait for a single load; the record ID index is built before the table
+     * is published.
      * @param name DBC file name (e.g., "Map.dbc")
      * @return Loaded DBC file (check isLoaded())
      */
     std::shared_ptr<DBCFile> loadDBC(const std::string& name);
 
+    /**
+     * Load and index a set of DBCs on worker threads; returns immediately.
+     * Waits for any previous preload first.
+     * @param names DBC file names (e.g. ExpansionProfile::preloadDbcs)
+     */
+    void preloadDBCsAsync(std::vector<std::string> names);
+
+    /** True while a preloadDBCsAsync() batch is still running. */
+    bool isDBCPreloadPending() const { return dbcPreloadPending_.load(); }
+
+    /** Block until the current preload batch (if any) has finished. */
+    void waitForDBCPreload();
+
     /**
      * Get a cached DBC file
      * @param name DBC file name
@@ -94,10 +152,35 @@ public:
      */
     std::vector<uint8_t> readFileOptional(const std::string& path) const;
 
+    /**
+     * Filesystem location of a loose asset (override dir first), for callers
+     * that stream from disk instead of reading the whole file
+     * @param path Virtual file path
+     * @return Filesystem path (empty if not found or only stored in a pack)
+     */
+    std::string resolveFilesystemPath(const std::string& path) const;
+
+    /**
+     * Identity of the file a virtual path currently resolves to: size/CRC32
+     * from the pack index or manifest, or size/mtime for override and PNG
+     * replacement files. Changes whenever the data behind the path does.
+     * @return Empty string if the asset is unknown
+     */
+    std::string getSourceIdentity(const std::string& path) const;
+
+    /** Expansion data directory set by setExpansionDataPath() (may be empty). */
+    const std::string& getExpansionDataPath() const { return expansionDataPath_; }
+
     /**
      * Get loaded DBC count
      */
-    size_t getLoadedDBCCount() const { return dbcCache.size(); }
+    size_t getLoadedDBCCount() const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        return dbcCache.size();
+    }
+
+    /** Cooked blobs (Data/cooked) used instead of parsing sources. */
+    uint64_t getCookedHits() const { return cookedStore_ ? cookedStore_->getHitCount() : 0; }
 
     /**
      * Get file cache stats
@@ -122,18 +205,43 @@ private:
     std::string expansionDataPath_;  // e.g. "Data/expansions/wotlk"
     std::string overridePath_;       // e.g. "Data/override"
 
-    // Base manifest (loaded from dataPath/manifest.json)
+    // Base data: pack index (dataPath/assets.wpi) or manifest (dataPath/manifest.json)
     AssetManifest manifest_;
+    AssetPackReader pack_;
     LooseFileReader looseReader_;
 
+    /**
+     * Loose-tree relative path of an asset from the pack index or manifest
+     * (nullptr if unknown)
+     */
+    const std::string* lookupRelativePath(const std::string& normalizedPath) const;
+
     /**
      * Resolve filesystem path: check override dir first, then base manifest.
-     * Returns empty string if not found.
+     * Returns empty string if not found, or if the asset lives in a pack.
      */
     std::string resolveFile(const std::string& normalizedPath) const;
 
+    /**
+     * Size/CRC32 of the base file for cooked-blob validation; false if the
+     * asset is unknown or shadowed by the override directory
+     */
+    bool getSourceStamp(const std::string& normalizedPath, CookedSourceStamp& stamp) const;
+
+    std::unique_ptr<CookedAssetStore> cookedStore_;  // Offline-cooked blobs (asset_cook)
+
     mutable std::mutex cacheMutex;
     std::map<std::string, std::shared_ptr<DBCFile>> dbcCache;
+    std::unique_ptr<DBCBinaryCache> dbcBinaryCache_;  // Compiled CSV tables on disk
+    std::set<std::string> dbcLoading_;                // Names being loaded (guarded by cacheMutex)
+    std::condition_variable dbcLoadCV_;
+
+    // Background preload batch
+    std::thread dbcPreloadThread_;
+    std::atomic<bool> dbcPreloadPending_{false};
+
+    /** Read and parse one DBC (CSV, compiled cache, or binary); no dbcCache access. */
+    std::shared_ptr<DBCFile> loadDBCUncached(const std::string& name);
 
     // File cache (LRU, dynamic budget based on system RAM)
     struct CachedFile {
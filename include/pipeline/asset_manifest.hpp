@@ -53,6 +53,11 @@ public:
      */
     const std::string& getBasePath() const { return basePath_; }
 
+    /**
+     * All entries, keyed by normalized WoW path
+     */
+    const std::unordered_map<std::string, Entry>& getEntries() const { return entries_; }
+
     /**
      * Get total number of entries
      */
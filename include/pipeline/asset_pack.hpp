@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wowee {
+namespace pipeline {
+
+/** Per-blob compression inside a pack file. */
+enum class PackCompression : uint8_t {
+    NONE = 0,
+    ZLIB = 1
+};
+
+/** Location and identity of one stored blob. */
+struct PackBlob {
+    uint64_t hash = 0;           // FNV-1a 64 of the raw bytes
+    uint64_t offset = 0;         // Byte offset inside the pack file
+    uint32_t storedSize = 0;     // Bytes on disk (compressed size if compressed)
+    uint32_t rawSize = 0;
+    uint32_t crc32 = 0;          // CRC32 of the raw bytes
+    uint16_t packId = 0;         // pack_<id>.wpak
+    PackCompression compression = PackCompression::NONE;
+};
+
+/** Content hash used to address blobs in a pack store. */
+uint64_t packContentHash(const uint8_t* data, size_t size);
+
+/**
+ * AssetPackReader - Reads assets from a packed, content-addressed store
+ *
+ * An index file (assets.wpi, written by `asset_extract --pack`) maps WoW
+ * virtual paths to blobs in a shared pack store directory. The store holds a
+ * few large pack_NNN.wpak files, so a read is one lookup plus a copy out of a
+ * read-only mapping (or a zlib inflate) instead of an open/read/close per
+ * asset. Several expansion indexes may point at the same store, where
+ * identical files are stored once.
+ *
+ * Read-only after open(); concurrent reads are safe without a mutex.
+ */
+class AssetPackReader {
+public:
+    struct Entry {
+        std::string filesystemPath;  // Loose-tree path (used for override lookups)
+        PackBlob blob;
+    };
+
+    AssetPackReader() = default;
+    ~AssetPackReader();
+
+    AssetPackReader(const AssetPackReader&) = delete;
+    AssetPackReader& operator=(const AssetPackReader&) = delete;
+
+    /**
+     * Load an index and map the pack files it references
+     * @param indexPath Full path to assets.wpi
+     * @return true if the index and all referenced packs are available
+     */
+    bool open(const std::string& indexPath);
+
+    void close();
+
+    /**
+     * Lookup an entry by normalized WoW path (lowercase, backslash)
+     * @return Pointer to entry or nullptr if not found
+     */
+    const Entry* lookup(const std::string& normalizedWowPath) const;
+
+    bool hasEntry(const std::string& normalizedWowPath) const {
+        return lookup(normalizedWowPath) != nullptr;
+    }
+
+    /**
+     * Read (and decompress) an entry's bytes
+     * @return File contents (empty on error)
+     */
+    std::vector<uint8_t> read(const Entry& entry) const;
+
+    /** All entries, keyed by normalized WoW path. */
+    const std::unordered_map<std::string, Entry>& getEntries() const { return entries_; }
+
+    size_t getEntryCount() const { return entries_.size(); }
+    size_t getPackCount() const { return packs_.size(); }
+    const std::string& getStorePath() const { return storePath_; }
+    bool isLoaded() const { return loaded_; }
+
+private:
+    struct PackFile {
+        std::string path;
+        std::shared_ptr<const void> mapping;  // Keeps the mapping alive
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    bool readBlob(const PackBlob& blob, uint8_t* out) const;
+
+    bool loaded_ = false;
+    std::string storePath_;
+    std::vector<PackFile> packs_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+/**
+ * AssetPackWriter - Appends assets to a pack store and writes an index
+ *
+ * Blobs are keyed by (content hash, size, CRC32). Adding a file whose bytes
+ * are already in the store (from this run or from an earlier run for another
+ * expansion) only records an index entry. Blobs of at least PACK_ALIGNMENT
+ * bytes start on a 4 KB boundary; smaller blobs are packed on 16-byte
+ * boundaries without crossing a 4 KB page, so every small read touches one
+ * page and padding stays small.
+ *
+ * add() may be called from several threads; compression runs outside the lock.
+ */
+class AssetPackWriter {
+public:
+    static constexpr uint32_t PACK_ALIGNMENT = 4096;
+
+    struct Options {
+        PackCompression compression = PackCompression::ZLIB;
+        int compressionLevel = 6;
+        uint64_t maxPackBytes = 2ull * 1024 * 1024 * 1024;  // Start a new pack file beyond this
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> blobsWritten{0};
+        std::atomic<uint64_t> blobsDeduplicated{0};
+        std::atomic<uint64_t> rawBytes{0};       // Bytes added (before dedup)
+        std::atomic<uint64_t> storedBytes{0};    // Bytes appended to pack files
+    };
+
+    AssetPackWriter() = default;
+    ~AssetPackWriter();
+
+    AssetPackWriter(const AssetPackWriter&) = delete;
+    AssetPackWriter& operator=(const AssetPackWriter&) = delete;
+
+    /**
+     * Open (or create) a pack store
+     * @param storeDir Directory holding pack_NNN.wpak and catalog.wpc
+     * @param indexPath Index this run writes; existing entries are kept
+     *                  unless replaced by add()
+     */
+    bool open(const std::string& storeDir, const std::string& indexPath, const Options& options);
+
+    /**
+     * Store one file. Thread-safe.
+     * @param normalizedWowPath Index key (lowercase, backslash)
+     * @param filesystemPath Loose-tree path, kept for override lookups
+     * @param crc32 CRC32 of data
+     */
+    bool add(const std::string& normalizedWowPath, const std::string& filesystemPath,
+             const std::vector<uint8_t>& data, uint32_t crc32);
+
+    /** Flush pack data, then atomically write the store catalog and the index. */
+    bool finish();
+
+    const Stats& getStats() const { return stats_; }
+    size_t getEntryCount() const;
+
+    /** True if the index (including entries kept from a previous run) maps this path to a blob with this CRC. */
+    bool hasEntry(const std::string& normalizedWowPath, uint32_t crc32) const;
+
+private:
+    struct BlobKey {
+        uint64_t hash;
+        uint32_t size;
+        uint32_t crc32;
+        bool operator==(const BlobKey& o) const {
+            return hash == o.hash && size == o.size && crc32 == o.crc32;
+        }
+    };
+    struct BlobKeyHash {
+        size_t operator()(const BlobKey& k) const {
+            return static_cast<size_t>(k.hash ^ (static_cast<uint64_t>(k.size) << 32) ^ k.crc32);
+        }
+    };
+
+    bool loadCatalog();
+    bool writeCatalog() const;
+    bool writeIndex() const;
+    bool openPackForAppend(uint16_t packId);
+    bool appendBlob(const uint8_t* data, uint32_t size, PackBlob& blob);
+
+    Options options_;
+    std::string storeDir_;
+    std::string indexPath_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<BlobKey, PackBlob, BlobKeyHash> catalog_;
+    std::unordered_map<std::string, AssetPackReader::Entry> entries_;
+    std::FILE* packFile_ = nullptr;
+    uint16_t packId_ = 0;
+    uint64_t packOffset_ = 0;
+    Stats stats_;
+};
+
+} // namespace pipeline
+} // namespace wowee
@@ -45,6 +45,22 @@ struct BLPImage {
     bool isValid() const { return width > 0 && height > 0 && !data.empty(); }
 };
 
+/**
+ * DXT-compressed BLP texture, blocks kept as stored (no decode)
+ */
+struct BLPCompressedImage {
+    int width = 0;
+    int height = 0;
+    BLPCompression compression = BLPCompression::NONE;  // DXT1, DXT3 or DXT5
+    bool hasAlpha = false;                               // Any level-0 texel with alpha < 255
+    std::vector<std::vector<uint8_t>> levels;            // Mip levels, full resolution first
+
+    bool isValid() const { return width > 0 && height > 0 && !levels.empty(); }
+
+    /** Bytes of DXT blocks in a level of the given size. */
+    static size_t levelSize(BLPCompression compression, int width, int height);
+};
+
 /**
  * BLP texture loader
  *
@@ -61,6 +77,12 @@ public:
      */
     static BLPImage load(const std::vector<uint8_t>& blpData);
 
+    /**
+     * Copy the DXT mip chain of a BLP2 DXTC texture without decoding it
+     * @return Invalid image for palette/ARGB/BLP1 textures or truncated data
+     */
+    static BLPCompressedImage loadCompressed(const std::vector<uint8_t>& blpData);
+
     /**
      * Get format name for debugging
      */
@@ -104,6 +126,7 @@ private:
     static void decompressDXT1(const uint8_t* src, uint8_t* dst, int width, int height);
     static void decompressDXT3(const uint8_t* src, uint8_t* dst, int width, int height);
     static void decompressDXT5(const uint8_t* src, uint8_t* dst, int width, int height);
+    static bool hasTransparentTexels(const uint8_t* blocks, BLPCompression compression, int width, int height);
     static void decompressPalette(const uint8_t* src, uint8_t* dst, const uint32_t* palette, int width, int height, uint8_t alphaDepth = 8);
 };
 
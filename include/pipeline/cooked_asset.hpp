@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wowee {
+namespace pipeline {
+
+struct BLPCompressedImage;
+struct M2Model;
+struct WMOModel;
+struct TerrainMesh;
+
+/** Kind of cooked blob; each kind has its own format version. */
+enum class CookedKind : uint32_t {
+    TEXTURE = 1,       // DXT mip chain of a BLP, blocks as stored
+    M2_MODEL = 2,      // M2Model after M2Loader::load + loadSkin(00.skin)
+    WMO_GROUPS = 3,    // All groups of a WMO after loadGroup, with collision grids
+    TERRAIN_MESH = 4   // TerrainMeshGenerator::generate output for one ADT
+};
+
+/** Bump when the cooked layout or the producing transform changes. */
+constexpr uint32_t COOKED_TEXTURE_VERSION = 2;
+constexpr uint32_t COOKED_M2_VERSION = 1;
+constexpr uint32_t COOKED_WMO_VERSION = 1;
+constexpr uint32_t COOKED_TERRAIN_VERSION = 1;
+
+/**
+ * Identity of the source file(s) a blob was cooked from, taken from the
+ * manifest/pack index (size + CRC32), so checking freshness needs no source
+ * read. Files the blob also depends on (an M2's 00.skin, a WMO's group
+ * files) are folded into the aux fields in a fixed order.
+ */
+struct CookedSourceStamp {
+    uint64_t size = 0;
+    uint32_t crc32 = 0;
+    uint64_t auxSize = 0;
+    uint32_t auxCrc32 = 0;
+
+    /** Fold in one more source file; pass zeros for a missing one. */
+    void addDependency(uint64_t depSize, uint32_t depCrc32) {
+        auxSize += depSize;
+        auxCrc32 = (auxCrc32 * 16777619u) ^ depCrc32 ^ static_cast<uint32_t>(depSize == 0);
+    }
+
+    bool operator==(const CookedSourceStamp& o) const {
+        return size == o.size && crc32 == o.crc32 && auxSize == o.auxSize && auxCrc32 == o.auxCrc32;
+    }
+};
+
+/**
+ * CookedAssetStore - GPU-ready blobs written offline by asset_cook
+ *
+ * Each blob is one file under <dataPath>/cooked/<kind>/, named by a hash of
+ * the asset's virtual path: a fixed header (kind, version, source stamp),
+ * the virtual path, then 16-byte aligned sections that are raw arrays
+ * (vertices, indices, mip levels) so they can be copied straight out of a
+ * read-only mapping. A blob is used only if kind, version, path and source
+ * stamp all match; otherwise callers fall back to parsing the source.
+ *
+ * load*() and store*() are safe to call from multiple threads.
+ */
+class CookedAssetStore {
+public:
+    /** @param directory Root of the cooked tree (e.g. Data/cooked) */
+    explicit CookedAssetStore(std::string directory);
+
+    const std::string& getDirectory() const { return directory_; }
+
+    /** True if the directory exists (nothing was cooked otherwise). */
+    bool isAvailable() const { return available_; }
+
+    /**
+     * Load a cooked texture: the BLP's DXT mip chain, ready for
+     * glCompressedTexImage2D
+     * @return false on miss or stale blob
+     */
+    bool loadTexture(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                     BLPCompressedImage& image) const;
+
+    bool storeTexture(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                      const BLPCompressedImage& image) const;
+
+    /** @return false on miss or stale blob */
+    bool loadM2(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                M2Model& model) const;
+
+    bool storeM2(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                 const M2Model& model) const;
+
+    /**
+     * Fill model.groups (sized by WMOLoader::load) from a cooked blob,
+     * including each group's collision grid
+     * @param stamp Root file stamp with every group file folded in, in order
+     * @return false on miss, stale blob or group count mismatch
+     */
+    bool loadWMOGroups(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                       WMOModel& model) const;
+
+    /** Cook model.groups; builds collision grids that are not built yet. */
+    bool storeWMOGroups(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                        const WMOModel& model) const;
+
+    /** @return false on miss or stale blob */
+    bool loadTerrainMesh(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                         TerrainMesh& mesh) const;
+
+    bool storeTerrainMesh(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                          const TerrainMesh& mesh) const;
+
+    /** True if a blob for this asset exists and matches kind, version and stamp. */
+    bool isFresh(CookedKind kind, const std::string& normalizedPath, const CookedSourceStamp& stamp) const;
+
+    /** Path of the blob for an asset (whether or not it exists). */
+    std::string blobPath(CookedKind kind, const std::string& normalizedPath) const;
+
+    /** Successful loads so far (all kinds). */
+    uint64_t getHitCount() const { return hits_.load(std::memory_order_relaxed); }
+
+private:
+    std::string directory_;
+    bool available_ = false;
+    mutable std::atomic<uint64_t> hits_{0};
+};
+
+} // namespace pipeline
+} // namespace wowee
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace wowee {
+namespace pipeline {
+
+class DBCFile;
+
+/**
+ * DBCBinaryCache - compiled WDBC blobs for CSV-sourced DBC tables
+ *
+ * Parsing the expansion CSV tables (Data/expansions/<exp>/db) is the slowest
+ * part of expansion data loading. The first time a CSV is parsed its table is
+ * written out as a binary WDBC image; later loads map that file and attach a
+ * DBCFile to it without parsing or copying.
+ *
+ * Cache files live in $WOWEE_DBC_CACHE_DIR or ~/.local/share/wowee/dbc_cache
+ * and are named by a hash of the CSV path. Each file records the CSV size and
+ * mtime; an entry whose source changed (or whose format version differs) is
+ * ignored and rewritten on the next store().
+ *
+ * load() and store() are safe to call from multiple threads.
+ */
+class DBCBinaryCache {
+public:
+    DBCBinaryCache();
+
+    /** False when no writable cache directory could be created. */
+    bool isEnabled() const { return !directory_.empty(); }
+
+    const std::string& getDirectory() const { return directory_; }
+
+    /**
+     * Load the compiled table for a CSV file
+     * @param csvPath Path of the source CSV
+     * @return Mapped DBCFile, or nullptr on miss/stale entry
+     */
+    std::shared_ptr<DBCFile> load(const std::string& csvPath) const;
+
+    /**
+     * Write a parsed table as the compiled entry for csvPath
+     * @return true if the entry was written
+     */
+    bool store(const std::string& csvPath, const DBCFile& dbc) const;
+
+private:
+    struct SourceStamp {
+        std::string key;      // Canonical CSV path
+        uint64_t size = 0;
+        int64_t mtime = 0;
+    };
+
+    bool stampSource(const std::string& csvPath, SourceStamp& out) const;
+    std::string cachePathFor(const std::string& key) const;
+
+    std::string directory_;
+};
+
+} // namespace pipeline
+} // namespace wowee
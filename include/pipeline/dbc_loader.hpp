@@ -3,6 +3,8 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <string_view>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -28,6 +30,22 @@ public:
      */
     bool load(const std::vector<uint8_t>& dbcData);
 
+    /**
+     * Attach to a binary WDBC image without copying it
+     * @param data Start of the WDBC header
+     * @param size Bytes available at data
+     * @param storage Owner of the bytes (e.g. a mapped cache file); kept alive
+     *                for the lifetime of this DBCFile
+     * @return true if the image is a valid WDBC
+     */
+    bool loadView(const uint8_t* data, size_t size, std::shared_ptr<const void> storage);
+
+    /**
+     * Serialize the loaded table as a binary WDBC image
+     * (header + records + string block). Empty if not loaded.
+     */
+    std::vector<uint8_t> toWDBC() const;
+
     /**
      * Check if DBC is loaded
      */
@@ -92,6 +110,13 @@ public:
      */
     std::string getString(uint32_t recordIndex, uint32_t fieldIndex) const;
 
+    /**
+     * Get a string field without copying
+     * @return View into the string block (valid while this DBCFile lives);
+     *         the referenced bytes are NUL-terminated
+     */
+    std::string_view getStringView(uint32_t recordIndex, uint32_t fieldIndex) const;
+
     /**
      * Get string by offset in string block
      * @param offset Offset into string block
@@ -99,13 +124,26 @@ public:
      */
     std::string getStringByOffset(uint32_t offset) const;
 
+    /** Non-copying variant of getStringByOffset(). */
+    std::string_view getStringViewByOffset(uint32_t offset) const;
+
     /**
-     * Find a record by ID (assumes first field is ID)
+     * Find a record by ID (assumes first field is ID). O(1): a dense
+     * ID-to-index array, or an open-addressed hash when IDs are sparse.
+     * Duplicate IDs resolve to the last record.
      * @param id Record ID to find
      * @return Record index or -1 if not found
      */
     int32_t findRecordById(uint32_t id) const;
 
+    /**
+     * Build the record ID index now instead of on the first findRecordById().
+     * Call before sharing the table across threads.
+     */
+    void buildIndex() const {
+        if (loaded && !idIndexBuilt_) buildIdIndex();
+    }
+
 private:
     // DBC file header (20 bytes)
     struct DBCHeader {
@@ -125,15 +163,35 @@ private:
     std::vector<uint8_t> recordData;    // All record data
     std::vector<uint8_t> stringBlock;   // String block
 
-    // Cache for record ID -> index lookup
-    mutable std::map<uint32_t, uint32_t> idToIndexCache;
-    mutable bool idCacheBuilt = false;
+    // Zero-copy view set by loadView(); takes precedence over the vectors
+    std::shared_ptr<const void> viewStorage_;
+    const uint8_t* viewRecords_ = nullptr;
+    const uint8_t* viewStrings_ = nullptr;
+
+    const uint8_t* recordBase() const { return viewStorage_ ? viewRecords_ : recordData.data(); }
+    const uint8_t* stringBase() const { return viewStorage_ ? viewStrings_ : stringBlock.data(); }
+
+    /** Validate a WDBC header against the available byte count. */
+    bool readHeader(const uint8_t* data, size_t size);
+
+    // Record ID -> index lookup. Dense: idIndex_[id - idBase_] holds index + 1
+    // (0 = absent). Hashed: idHashKeys_/idIndex_ are parallel open-addressed
+    // slots of size idHashMask_ + 1.
+    mutable std::vector<uint32_t> idIndex_;
+    mutable std::vector<uint32_t> idHashKeys_;
+    mutable uint32_t idBase_ = 0;
+    mutable uint32_t idHashMask_ = 0;
+    mutable bool idIndexDense_ = true;
+    mutable bool idIndexBuilt_ = false;
 
-    void buildIdCache() const;
+    void buildIdIndex() const;
+    void resetIdIndex();
 
     /**
      * Load from CSV text format (produced by dbc_to_csv tool).
-     * Rebuilds the same in-memory layout as binary load.
+     * Rebuilds the same in-memory layout as binary load. Single pass over the
+     * buffer: records and string bytes are written in place, no per-token
+     * allocations.
      */
     bool loadCSV(const std::vector<uint8_t>& csvData);
 };
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "pipeline/dbc_loader.hpp"
+#include "pipeline/dbc_layout.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace wowee {
+namespace pipeline {
+
+/** Column of a typed DBC record: layout field name + WotLK fallback index. */
+struct DBCColumn {
+    const char* name;
+    uint32_t fallback;
+};
+
+/**
+ * DBCTable - typed, column-projected view over a DBCFile
+ *
+ * A record type names its table and the columns it reads:
+ *
+ *   struct SpellIconRecord {
+ *       static constexpr const char* TABLE = "SpellIcon";
+ *       enum Column : uint32_t { ID, Path, COLUMN_COUNT };
+ *       static constexpr DBCColumn COLUMNS[COLUMN_COUNT] = {{"ID", 0}, {"Path", 1}};
+ *   };
+ *
+ * bind() resolves every column against the DBC layout once (falling back to
+ * the hardcoded index when the layout does not list the table or field), so
+ * use sites stop doing string-keyed layout lookups per access. Lookups by ID
+ * go through DBCFile's O(1) index and strings are returned as views into the
+ * string block; nothing here allocates after bind().
+ */
+template <typename Record>
+class DBCTable {
+public:
+    using Column = typename Record::Column;
+    static constexpr uint32_t INVALID_COLUMN = 0xFFFFFFFF;
+
+    DBCTable() { columns_.fill(INVALID_COLUMN); }
+
+    /**
+     * Bind to a loaded DBC and resolve column indices
+     * @param layout Layout to resolve against (defaults to the active one)
+     * @return true if the DBC is loaded
+     */
+    bool bind(std::shared_ptr<DBCFile> dbc, const DBCLayout* layout = getActiveDBCLayout()) {
+        dbc_ = std::move(dbc);
+        if (!dbc_ || !dbc_->isLoaded()) {
+            dbc_.reset();
+            columns_.fill(INVALID_COLUMN);
+            return false;
+        }
+        const DBCFieldMap* fields = layout ? layout->getLayout(Record::TABLE) : nullptr;
+        for (uint32_t c = 0; c < Record::COLUMN_COUNT; c++) {
+            uint32_t index = Record::COLUMNS[c].fallback;
+            if (fields) {
+                auto it = fields->fields.find(Record::COLUMNS[c].name);
+                if (it != fields->fields.end()) index = it->second;
+            }
+            columns_[c] = (index < dbc_->getFieldCount()) ? index : INVALID_COLUMN;
+        }
+        dbc_->buildIndex();
+        return true;
+    }
+
+    /** Drop the DBC reference (views returned earlier become invalid). */
+    void reset() {
+        dbc_.reset();
+        columns_.fill(INVALID_COLUMN);
+    }
+
+    bool isBound() const { return dbc_ != nullptr; }
+    uint32_t size() const { return dbc_ ? dbc_->getRecordCount() : 0; }
+    const DBCFile* file() const { return dbc_.get(); }
+
+    /** Resolved field index of a column (INVALID_COLUMN if out of range). */
+    uint32_t column(Column c) const { return columns_[c]; }
+    bool hasColumn(Column c) const { return columns_[c] != INVALID_COLUMN; }
+
+    /** Record index for an ID, or -1. */
+    int32_t find(uint32_t id) const { return dbc_ ? dbc_->findRecordById(id) : -1; }
+
+    uint32_t getUInt32(uint32_t row, Column c) const {
+        return hasColumn(c) ? dbc_->getUInt32(row, columns_[c]) : 0;
+    }
+    int32_t getInt32(uint32_t row, Column c) const { return static_cast<int32_t>(getUInt32(row, c)); }
+    float getFloat(uint32_t row, Column c) const {
+        return hasColumn(c) ? dbc_->getFloat(row, columns_[c]) : 0.0f;
+    }
+    std::string_view getString(uint32_t row, Column c) const {
+        return hasColumn(c) ? dbc_->getStringView(row, columns_[c]) : std::string_view{};
+    }
+
+    /** Field of the record with the given ID (0 / empty when absent). */
+    uint32_t getUInt32ById(uint32_t id, Column c) const {
+        int32_t row = find(id);
+        return row >= 0 ? getUInt32(static_cast<uint32_t>(row), c) : 0;
+    }
+    std::string_view getStringById(uint32_t id, Column c) const {
+        int32_t row = find(id);
+        return row >= 0 ? getString(static_cast<uint32_t>(row), c) : std::string_view{};
+    }
+
+private:
+    std::shared_ptr<DBCFile> dbc_;
+    std::array<uint32_t, Record::COLUMN_COUNT> columns_{};
+};
+
+// ---- Record types shared by game and UI code ----
+
+struct SpellRecord {
+    static constexpr const char* TABLE = "Spell";
+    enum Column : uint32_t { ID, Attributes, IconID, Name, Rank, COLUMN_COUNT };
+    static constexpr DBCColumn COLUMNS[COLUMN_COUNT] = {
+        {"ID", 0}, {"Attributes", 4}, {"IconID", 133}, {"Name", 136}, {"Rank", 153},
+    };
+};
+
+struct SpellIconRecord {
+    static constexpr const char* TABLE = "SpellIcon";
+    enum Column : uint32_t { ID, Path, COLUMN_COUNT };
+    static constexpr DBCColumn COLUMNS[COLUMN_COUNT] = {{"ID", 0}, {"Path", 1}};
+};
+
+struct ItemDisplayInfoRecord {
+    static constexpr const char* TABLE = "ItemDisplayInfo";
+    enum Column : uint32_t { ID, InventoryIcon, GeosetGroup1, GeosetGroup2, GeosetGroup3, COLUMN_COUNT };
+    static constexpr DBCColumn COLUMNS[COLUMN_COUNT] = {
+        {"ID", 0}, {"InventoryIcon", 5}, {"GeosetGroup1", 7}, {"GeosetGroup2", 8}, {"GeosetGroup3", 9},
+    };
+
+    /** GeosetGroup column for group 0..2. */
+    static constexpr Column geosetGroup(int group) { return static_cast<Column>(GeosetGroup1 + group); }
+};
+
+} // namespace pipeline
+} // namespace wowee
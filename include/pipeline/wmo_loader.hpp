@@ -140,6 +140,49 @@ struct WMOBatch {
     uint8_t materialId;
 };
 
+/**
+ * 2D spatial grid over one group's triangles for floor/wall collision
+ *
+ * Triangles are binned by their XY bounding box into CELL_SIZE cells (at
+ * most 64x64 per group). Each triangle class keeps its per-cell lists flat
+ * (cell offsets + triangle start indices), so a grid built by asset_cook is
+ * restored with a few array copies.
+ */
+struct WMOCollisionGrid {
+    static constexpr float CELL_SIZE = 4.0f;
+
+    enum TriangleClass : size_t {
+        ALL = 0,
+        FLOOR,      // abs(normal.z) >= 0.35
+        WALL,       // abs(normal.z) < 0.65
+        CLASS_COUNT
+    };
+
+    struct TriBounds { float minZ; float maxZ; };
+
+    glm::vec3 boundsMin{0.0f};   // Bounds of the vertices (header bboxes can be unreliable)
+    glm::vec3 boundsMax{0.0f};
+    glm::vec2 origin{0.0f};
+    int cellsX = 0;
+    int cellsY = 0;
+    // Per class: cellOffsets[c] (cellsX * cellsY + 1 entries) indexes cellTriangles[c]
+    std::vector<uint32_t> cellOffsets[CLASS_COUNT];
+    std::vector<uint32_t> cellTriangles[CLASS_COUNT];
+    std::vector<TriBounds> triBounds;  // Indexed by triangle start / 3
+
+    bool isEmpty() const { return cellsX == 0 || cellsY == 0; }
+
+    /** Build from group geometry (positions + triangle list). */
+    void build(const std::vector<glm::vec3>& vertices, const std::vector<uint16_t>& indices);
+
+    /**
+     * Triangle start indices of one class overlapping a local-space XY range
+     * @param out Cleared, then filled (sorted and unique when several cells overlap)
+     */
+    void query(TriangleClass triangleClass, float minX, float minY, float maxX, float maxY,
+               std::vector<uint32_t>& out) const;
+};
+
 // WMO Group (individual room/section)
 struct WMOGroup {
     uint32_t flags;
@@ -170,6 +213,9 @@ struct WMOGroup {
 
     std::string name;
     std::string description;
+
+    // Collision grid; only filled for groups loaded from a cooked blob
+    WMOCollisionGrid collisionGrid;
 };
 
 // Complete WMO Model
@@ -243,6 +289,12 @@ public:
     static bool loadGroup(const std::vector<uint8_t>& groupData,
                          WMOModel& model,
                          uint32_t groupIndex);
+
+    /**
+     * Virtual path of a group file: "<root without .wmo>_NNN.wmo"
+     * (AssetManager lookups are case-insensitive)
+     */
+    static std::string groupPath(const std::string& rootPath, uint32_t groupIndex);
 };
 
 } // namespace pipeline
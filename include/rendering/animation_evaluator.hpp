@@ -0,0 +1,81 @@
+#pragma once
+
+#include "pipeline/m2_loader.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace wowee {
+namespace rendering {
+
+/**
+ * Shared skeletal pose evaluation for M2Renderer and CharacterRenderer
+ *
+ * Evaluation runs in three passes over the skeleton:
+ *  1. Sample T/R/S keyframes into SoA scratch arrays (cursor-cached lookup)
+ *  2. Compose local T(pivot)*T*R*S*T(-pivot) transforms as 3x4 matrices in a
+ *     branch-free loop over the SoA arrays (auto-vectorizes)
+ *  3. Concatenate with parents in hierarchy order
+ *
+ * Scratch storage is thread_local, so instances can be evaluated in parallel.
+ */
+
+/**
+ * Affine bone transform stored as 3 rows x 4 columns (row-major).
+ * The implicit fourth row is (0, 0, 0, 1).
+ */
+struct BoneMatrix3x4 {
+    float m[12];
+};
+
+/**
+ * Per-instance keyframe cursor cache
+ *
+ * Remembers the last keyframe bracket used for every translation/rotation/scale
+ * track of every bone, so monotonic playback resolves keyframes in O(1)
+ * instead of scanning the timestamp array each frame.
+ */
+struct AnimationCursor {
+    std::vector<uint32_t> keyIndex;  // 3 entries per bone (T, R, S)
+
+    void reset() { keyIndex.clear(); }
+};
+
+struct BoneEvalOptions {
+    // Loop durations for global-sequence tracks (nullptr = treat as regular tracks)
+    const std::vector<uint32_t>* globalSequenceDurations = nullptr;
+    // Replace near-zero scale components with 1.0 to avoid degenerate matrices
+    bool fixDegenerateScale = false;
+};
+
+/**
+ * Find the keyframe bracket [i, i+1] containing time.
+ * Returns the same index as a linear scan; checks the cursor hint and its
+ * successor first and falls back to a binary search when playback jumped.
+ * @return Index of the first keyframe of the bracket, or -1 if there are no keys
+ */
+int findKeyframeIndexCached(const std::vector<uint32_t>& timestamps, float time, uint32_t& hint);
+
+/**
+ * Evaluate the bone palette for one instance.
+ * @param bones Model bones (parents precede children)
+ * @param numBones Number of bones to evaluate (may be less than bones.size())
+ * @param seqIdx Active sequence index
+ * @param timeMs Time within the sequence (ms)
+ * @param options Global-sequence and scale handling
+ * @param cursor Per-instance keyframe cursor cache (resized as needed)
+ * @param outMatrices Model-space bone matrices (resized to numBones)
+ */
+void evaluateBonePalette(const std::vector<pipeline::M2Bone>& bones, size_t numBones,
+                         int seqIdx, float timeMs, const BoneEvalOptions& options,
+                         AnimationCursor& cursor, std::vector<glm::mat4>& outMatrices);
+
+/**
+ * Same as evaluateBonePalette, but writes packed 3x4 matrices.
+ */
+void evaluateBonePalette3x4(const std::vector<pipeline::M2Bone>& bones, size_t numBones,
+                            int seqIdx, float timeMs, const BoneEvalOptions& options,
+                            AnimationCursor& cursor, std::vector<BoneMatrix3x4>& outMatrices);
+
+} // namespace rendering
+} // namespace wowee
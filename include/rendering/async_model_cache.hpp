@@ -0,0 +1,106 @@
+#pragma once
+
+#include "pipeline/m2_loader.hpp"
+#include "pipeline/wmo_loader.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace wowee {
+namespace pipeline { class AssetManager; }
+
+namespace rendering {
+
+/**
+ * A model read and parsed by AsyncModelCache, ready for loadModel()
+ */
+struct CachedModel {
+    std::string path;
+    bool isWmo = false;
+    bool valid = false;         // False if the file was missing or did not parse
+    pipeline::M2Model m2;       // Skin (and requested .anim files) merged
+    pipeline::WMOModel wmo;     // Root plus every group that could be read
+};
+
+/**
+ * Future-like handle to a model request. Cheap to copy; the parsed model is
+ * freed once every handle to it is gone.
+ */
+class ModelHandle {
+public:
+    ModelHandle() = default;
+
+    bool valid() const { return state_ != nullptr; }
+
+    /** True once parsing has finished, whether or not it succeeded. */
+    bool isReady() const;
+
+    /** The parsed model, or nullptr until isReady(). */
+    const CachedModel* get() const;
+
+    void reset() { state_.reset(); }
+
+private:
+    friend class AsyncModelCache;
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * AsyncModelCache — M2/WMO file reads and parsing on a worker pool
+ *
+ * Replaces the synchronous readFile + M2Loader/WMOLoader sequences the
+ * main thread used to run for spawned game objects, transport doodads and
+ * mounts. Requests for the same path share one parse while any handle is
+ * alive; requests whose handles were all dropped before a worker reached
+ * them are skipped. GL upload stays with the caller, which polls handles
+ * and calls the owning renderer's loadModel() under its frame budget.
+ */
+class AsyncModelCache {
+public:
+    enum LoadFlags : uint32_t {
+        LOAD_DEFAULT = 0,
+        LOAD_BASE_ANIMS = 1u << 0,  // M2: merge external stand/walk/run .anim files
+    };
+
+    explicit AsyncModelCache(pipeline::AssetManager* assetManager);
+    ~AsyncModelCache();
+
+    AsyncModelCache(const AsyncModelCache&) = delete;
+    AsyncModelCache& operator=(const AsyncModelCache&) = delete;
+
+    /**
+     * Queue a model (kind chosen by extension) for loading.
+     * @return Handle shared with any in-flight or live request for the same path and flags
+     */
+    ModelHandle requestModel(const std::string& path, uint32_t flags = LOAD_DEFAULT);
+
+    /** Number of requests queued or being parsed. */
+    size_t getPendingCount() const { return pending_.load(); }
+
+private:
+    void workerLoop();
+    void loadM2(ModelHandle::State& state);
+    void loadWMO(ModelHandle::State& state);
+
+    pipeline::AssetManager* assetManager_ = nullptr;
+
+    std::vector<std::thread> workerThreads_;
+    std::atomic<bool> workerRunning_{false};
+    std::mutex queueMutex_;
+    std::condition_variable queueCV_;
+    std::deque<std::shared_ptr<ModelHandle::State>> jobQueue_;
+    std::unordered_map<std::string, std::weak_ptr<ModelHandle::State>> entries_;  // Keyed by normalized path + flags
+    std::atomic<size_t> pending_{0};
+    uint32_t requestsSinceSweep_ = 0;
+};
+
+} // namespace rendering
+} // namespace wowee
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "pipeline/m2_loader.hpp"
+#include "rendering/animation_evaluator.hpp"
+#include "rendering/character_skin_compositor.hpp"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -33,7 +35,8 @@ struct WeaponAttachment {
  * Features:
  * - Skeletal animation with bone transformations
  * - Keyframe interpolation (linear position/scale, slerp rotation)
- * - Vertex skinning (GPU-accelerated)
+ * - Vertex skinning (GPU-accelerated, bone palettes in a per-frame texture buffer)
+ * - Instanced draws for characters sharing a model, geosets and textures
  * - Texture loading from BLP via AssetManager
  */
 class CharacterRenderer {
@@ -97,6 +100,8 @@ public:
     bool getAttachmentTransform(uint32_t instanceId, uint32_t attachmentId, glm::mat4& outTransform);
 
     size_t getInstanceCount() const { return instances.size(); }
+    uint32_t getDrawCallCount() const { return lastDrawCallCount_; }
+    uint32_t getDrawGroupCount() const { return lastDrawGroupCount_; }
 
     void setFog(const glm::vec3& color, float start, float end) {
         fogColor = color; fogStart = start; fogEnd = end;
@@ -145,6 +150,7 @@ private:
         bool animationLoop = true;
         bool isDead = false;  // Prevents movement while in death state
         std::vector<glm::mat4> boneMatrices;  // Current bone transforms
+        AnimationCursor animCursor;           // Cached keyframe brackets per bone track
 
         // Geoset visibility — which submesh IDs to render
         // Empty = render all (for non-character models)
@@ -174,21 +180,30 @@ private:
         // Override model matrix (used for weapon instances positioned by parent bone)
         bool hasOverrideModelMatrix = false;
         glm::mat4 overrideModelMatrix{1.0f};
+
+        // Per-frame GPU data location (see uploadFrameData)
+        int32_t paletteBase = -1;  // First palette texel of this instance's bones
+        int32_t frameSlot = -1;    // Record index in the instance data buffer
+    };
+
+    // One instanced draw list: instances of the same model that resolve to the
+    // same visible batches and textures.
+    struct DrawGroup {
+        uint32_t modelId = 0;
+        std::vector<std::pair<uint32_t, GLuint>> draws;  // (batch index, texture)
+        std::vector<GLint> slots;                         // Instance records to draw
     };
 
     void setupModelBuffers(M2ModelGPU& gpuModel);
     void calculateBindPose(M2ModelGPU& gpuModel);
     void updateAnimation(CharacterInstance& instance, float deltaTime);
     void calculateBoneMatrices(CharacterInstance& instance);
-    glm::mat4 getBoneTransform(const pipeline::M2Bone& bone, float time, int sequenceIndex);
     glm::mat4 getModelMatrix(const CharacterInstance& instance) const;
 
-    // Keyframe interpolation helpers
-    static int findKeyframeIndex(const std::vector<uint32_t>& timestamps, float time);
-    static glm::vec3 interpolateVec3(const pipeline::M2AnimationTrack& track,
-                                      int seqIdx, float time, const glm::vec3& defaultVal);
-    static glm::quat interpolateQuat(const pipeline::M2AnimationTrack& track,
-                                      int seqIdx, float time);
+    // Per-frame GPU skinning data
+    void uploadFrameData();
+    void addToDrawGroup(uint32_t modelId, const std::vector<std::pair<uint32_t, GLuint>>& draws, GLint slot);
+    void drawGroups(GLint slotsLoc, GLint alphaTestLoc);
 
 public:
     /**
@@ -210,6 +225,20 @@ public:
                                 const std::vector<std::string>& baseLayers,
                                 const std::vector<std::pair<int, std::string>>& regionLayers);
 
+    /**
+     * Asynchronous compositeWithRegions: composites on a worker thread and
+     * applies the result as a texture slot override on the instance once
+     * uploaded (from update()). Cached outfits are applied immediately; a newer
+     * request for the same instance/slot supersedes one still in flight.
+     */
+    void requestCompositeWithRegions(uint32_t instanceId, uint16_t textureSlot,
+                                     const std::string& basePath,
+                                     const std::vector<std::string>& baseLayers,
+                                     const std::vector<std::pair<int, std::string>>& regionLayers);
+
+    /** Number of skin composites queued or running on worker threads. */
+    size_t getPendingCompositeCount() const { return skinCompositor_ ? skinCompositor_->getPendingCount() : 0; }
+
     /** Clear the composite texture cache (forces re-compositing on next call). */
     void clearCompositeCache();
 
@@ -251,6 +280,16 @@ private:
     };
     std::unordered_map<std::string, TextureCacheEntry> textureCache;
     std::unordered_map<std::string, GLuint> compositeCache_;  // key → GPU texture for reuse
+
+    // Worker-thread skin compositing
+    static constexpr size_t MAX_COMPOSITE_UPLOADS_PER_FRAME = 4;
+    std::unique_ptr<CharacterSkinCompositor> skinCompositor_;
+    std::unordered_map<CharacterSkinCompositor::Ticket, uint64_t> pendingSkinComposites_;  // ticket → (instance << 16 | slot)
+    std::unordered_map<uint64_t, CharacterSkinCompositor::Ticket> latestSkinTicket_;
+    std::vector<CharacterSkinCompositor::Result> finishedComposites_;
+    CharacterSkinCompositor* skinCompositor();
+    GLuint uploadCompositeTexture(const pipeline::BLPImage& image);
+    void processFinishedComposites();
     std::unordered_set<std::string> failedTextureCache_;  // negative cache for missing textures
     size_t textureCacheBytes_ = 0;
     uint64_t textureCacheCounter_ = 0;
@@ -262,9 +301,33 @@ private:
 
     uint32_t nextInstanceId = 1;
 
-    // Maximum bones supported (GPU uniform limit)
-    // WoW character models can have 210+ bones; GPU reports 4096 components (~256 mat4)
+    // Maximum bones uploaded per instance
+    // WoW character models can have 210+ bones
     static constexpr int MAX_BONES = 240;
+
+    // GPU skinning palette: every instance's bones packed as 3x4 rows (3 RGBA32F
+    // texels per bone) into one texture buffer per frame. Instance records
+    // (model matrix, palette base, bone count, opacity; 5 texels each) live in a
+    // second buffer and are selected per draw through uInstanceSlots.
+    static constexpr int MAX_INSTANCES_PER_DRAW = 64;  // Matches uInstanceSlots[64]
+    static constexpr uint32_t WHOLE_MODEL_DRAW = 0xFFFFFFFFu;  // Draw entry without batches
+    static constexpr int INSTANCE_RECORD_TEXELS = 5;
+    GLuint paletteBuffer_ = 0;
+    GLuint paletteTexture_ = 0;
+    GLuint instanceDataBuffer_ = 0;
+    GLuint instanceDataTexture_ = 0;
+    GLint maxTextureBufferTexels_ = 65536;
+    bool paletteDirty_ = true;
+    std::vector<glm::vec4> paletteData_;       // Reused each frame
+    std::vector<glm::vec4> instanceData_;      // Reused each frame
+    std::vector<DrawGroup> drawGroups_;        // Reused each frame
+    size_t drawGroupCount_ = 0;
+    std::unordered_map<uint64_t, std::vector<size_t>> drawGroupIndex_;  // signature hash -> groups
+    std::vector<std::pair<uint32_t, GLuint>> drawScratch_;
+    GLint mainSlotsLoc_ = -1;
+    GLint shadowSlotsLoc_ = -1;
+    uint32_t lastDrawCallCount_ = 0;
+    uint32_t lastDrawGroupCount_ = 0;
 };
 
 } // namespace rendering
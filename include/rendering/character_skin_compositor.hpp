@@ -0,0 +1,120 @@
+#pragma once
+
+#include "pipeline/blp_loader.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace wowee {
+namespace pipeline { class AssetManager; }
+
+namespace rendering {
+
+/**
+ * Layer list describing one composited character skin.
+ *
+ * Layer mode (regionMode == false) mirrors CharacterRenderer::compositeTextures:
+ * basePath is layer 0 and baseLayers are placed by filename keyword.
+ * Region mode mirrors compositeWithRegions: baseLayers are underwear/face
+ * overlays and regionLayers are (region_index, blp_path) equipment textures.
+ */
+struct SkinCompositeRequest {
+    std::string basePath;
+    std::vector<std::string> baseLayers;
+    std::vector<std::pair<int, std::string>> regionLayers;
+    bool regionMode = false;
+
+    /**
+     * Canonical key over the layer list (in-memory caches; the disk cache
+     * also keys on the layers' source identity)
+     */
+    std::string cacheKey() const;
+};
+
+/**
+ * CharacterSkinCompositor — CPU character skin compositing off the main thread
+ *
+ * Loads layer BLPs through the AssetManager (thread-safe reads) and alpha-blends
+ * them into an RGBA8 atlas on a small worker pool. Results are stored in an
+ * on-disk cache addressed by a hash of the layer list and the layer files'
+ * source identity, so the same outfit is only composited once across
+ * sessions until the data changes. The cache is held to a byte budget
+ * ($WOWEE_SKIN_CACHE_MB, default 512) by evicting least recently used
+ * entries. GPU upload stays with the caller.
+ */
+class CharacterSkinCompositor {
+public:
+    using Ticket = uint64_t;
+
+    struct Result {
+        Ticket ticket = 0;
+        std::string key;
+        pipeline::BLPImage image;  // Invalid when the base layer failed to load
+    };
+
+    explicit CharacterSkinCompositor(pipeline::AssetManager* assetManager);
+    ~CharacterSkinCompositor();
+
+    CharacterSkinCompositor(const CharacterSkinCompositor&) = delete;
+    CharacterSkinCompositor& operator=(const CharacterSkinCompositor&) = delete;
+
+    /**
+     * Composite synchronously (disk cache first).
+     * @return RGBA8 image (check isValid())
+     */
+    pipeline::BLPImage compose(const SkinCompositeRequest& request);
+
+    /**
+     * Queue a composite on the worker pool.
+     * @return Ticket identifying the result in collectFinished()
+     */
+    Ticket submit(SkinCompositeRequest request);
+
+    /** Move all finished results into out (main thread, once per frame). */
+    void collectFinished(std::vector<Result>& out);
+
+    /** Number of composites queued or running on workers. */
+    size_t getPendingCount() const { return pending_.load(); }
+
+    const std::string& getCacheDirectory() const { return cacheDirectory_; }
+
+private:
+    struct Job {
+        Ticket ticket = 0;
+        SkinCompositeRequest request;
+    };
+
+    void workerLoop();
+    pipeline::BLPImage composeUncached(const SkinCompositeRequest& request);
+    /** cacheKey() plus expansion and per-layer source identity. */
+    std::string diskKey(const SkinCompositeRequest& request) const;
+    std::string cachePathForKey(const std::string& key) const;
+    bool loadFromDisk(const std::string& key, pipeline::BLPImage& out) const;
+    void storeToDisk(const std::string& key, const pipeline::BLPImage& image);
+    /** Delete least recently used entries until the cache fits its budget. */
+    void enforceDiskBudget();
+
+    pipeline::AssetManager* assetManager_ = nullptr;
+    std::string cacheDirectory_;
+    uint64_t diskBudgetBytes_ = 512ull * 1024 * 1024;
+    std::atomic<uint64_t> diskBytes_{0};  // Approximate; rescanned by enforceDiskBudget()
+    std::mutex diskMutex_;                // Serializes eviction scans
+
+    std::vector<std::thread> workerThreads_;
+    std::atomic<bool> workerRunning_{false};
+    std::mutex queueMutex_;
+    std::condition_variable queueCV_;
+    std::deque<Job> jobQueue_;
+    std::vector<Result> finished_;
+    std::atomic<size_t> pending_{0};
+    Ticket nextTicket_ = 1;
+};
+
+} // namespace rendering
+} // namespace wowee
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace wowee {
+namespace rendering {
+
+/**
+ * Dynamic AABB tree over instance world bounds
+ *
+ * Broad phase for the M2/WMO collision and raycast queries. Each leaf holds a
+ * "fat" box (the instance bounds grown by a margin) and a 32-bit payload, so
+ * an instance that moves a little stays inside its leaf and update() is a
+ * containment check. Leaves that escape are reinserted with a surface-area
+ * cost descent; ancestors are refit and AVL-rotated on the way back up, which
+ * keeps the height near log2(n) under streaming churn. rebuild() restores a
+ * bulk-built (SAH) tree after many incremental inserts.
+ *
+ * Internal nodes are one cache line holding both children's boxes (SoA), so
+ * a query only touches nodes whose box it overlaps. Queries walk the tree
+ * with an on-stack traversal stack and write into a caller-owned vector;
+ * steady-state queries do not allocate. Results are conservative (tested
+ * against the fat boxes); callers do their own narrow phase.
+ */
+class DynamicBVH {
+public:
+    static constexpr int32_t NULL_NODE = -1;
+
+    /**
+     * @param margin Distance each leaf box is grown by on insertion
+     */
+    explicit DynamicBVH(float margin = 1.0f);
+
+    /**
+     * Add a leaf
+     * @return Proxy handle, valid until remove() or clear()
+     */
+    int32_t insert(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint32_t userData);
+
+    void remove(int32_t proxy);
+
+    /**
+     * Move a leaf to new tight bounds
+     * @return true if the leaf was reinserted, false if its fat box still fit
+     */
+    bool update(int32_t proxy, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    void clear();
+
+    /**
+     * Rebuild all internal nodes top-down (binned SAH) with a depth-first
+     * node layout. Proxies stay valid. Incremental insertion gives a looser
+     * tree than a bulk build, so call this after large batches of inserts.
+     */
+    void rebuild();
+
+    /**
+     * rebuild() if leaves inserted or reinserted since the last build exceed
+     * a quarter of the tree. Cheap to call once per frame.
+     * @return true if the tree was rebuilt
+     */
+    bool rebuildIfStale();
+
+    uint32_t getUserData(int32_t proxy) const { return leaves_[proxy].userData; }
+    void setUserData(int32_t proxy, uint32_t userData) { leaves_[proxy].userData = userData; }
+
+    size_t size() const { return leafCount_; }
+    int32_t getHeight() const { return heightOf(root_); }
+
+    /**
+     * Payloads of leaves overlapping an AABB. Results replace the contents
+     * of out (in no particular order).
+     */
+    void queryAABB(const glm::vec3& queryMin, const glm::vec3& queryMax, std::vector<uint32_t>& out) const;
+
+    /** Payloads of leaves whose box touches a sphere. */
+    void querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+
+    /**
+     * Payloads of leaves hit by the segment origin + direction * t,
+     * t in [0, maxDistance]. direction need not be normalized.
+     */
+    void queryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  std::vector<uint32_t>& out) const;
+
+private:
+    // Child references: >= 0 is an internal node, <= -2 a leaf (-2 - index),
+    // NULL_NODE none.
+    static bool isLeafRef(int32_t ref) { return ref < NULL_NODE; }
+    static int32_t leafRef(int32_t leaf) { return -2 - leaf; }
+    static int32_t leafIndex(int32_t ref) { return -2 - ref; }
+
+    struct alignas(64) Node {
+        float minX[2], minY[2], minZ[2];   // Child boxes
+        float maxX[2], maxY[2], maxZ[2];
+        int32_t child[2];
+        int32_t parent = NULL_NODE;        // Next free node while on the free list
+        int32_t height = -1;               // -1 = free
+    };
+
+    struct Leaf {
+        glm::vec3 boundsMin;               // Fat box
+        glm::vec3 boundsMax;
+        int32_t parent = NULL_NODE;        // Next free leaf while on the free list
+        uint32_t userData = 0;
+        bool alive = false;
+    };
+
+    struct BuildItem {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        glm::vec3 centroid;
+        int32_t ref;
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t node);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t node);
+    void refitUpwards(int32_t node);
+    int32_t buildRange(size_t begin, size_t end, int depth, glm::vec3& outMin, glm::vec3& outMax);
+
+    int32_t heightOf(int32_t ref) const;
+    void setParent(int32_t ref, int32_t parent);
+    int32_t parentOf(int32_t ref) const;
+    void setSlot(int32_t node, int slot, int32_t ref, const glm::vec3& mn, const glm::vec3& mx);
+    void slotBounds(const Node& n, int slot, glm::vec3& mn, glm::vec3& mx) const;
+    void nodeBounds(const Node& n, glm::vec3& mn, glm::vec3& mx) const;
+
+    template <typename Overlap>
+    void query(const Overlap& overlaps, std::vector<uint32_t>& out) const;
+
+    std::vector<Node> nodes_;
+    std::vector<Leaf> leaves_;
+    int32_t root_ = NULL_NODE;
+    int32_t freeNodes_ = NULL_NODE;
+    int32_t freeLeaves_ = NULL_NODE;
+    size_t leafCount_ = 0;
+    size_t insertsSinceBuild_ = 0;
+    std::vector<BuildItem> buildItems_;   // rebuild() scratch
+    float margin_;
+};
+
+} // namespace rendering
+} // namespace wowee
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wowee {
+namespace rendering {
+
+/**
+ * FrameGraph — declarative render pass scheduling
+ *
+ * Each frame the renderer declares its passes together with the resources
+ * they read and write (shadow map, HDR scene color/depth, post targets,
+ * backbuffer), then compiles and executes the graph:
+ *  - Passes whose writes never reach an output resource are culled
+ *  - Transient textures are allocated from a pool and aliased between passes
+ *    whose lifetimes do not overlap (same description)
+ *  - A pass declared with an input version is skipped while that version
+ *    matches its last execution, as long as it is the only writer of its
+ *    (imported, hence persistent) outputs; the outputs keep their contents
+ *  - Every executed pass is bracketed with a GL_TIME_ELAPSED query; results
+ *    are read back a few frames later to avoid pipeline stalls
+ *
+ * Passes run in declaration order; the graph does not reorder them.
+ */
+class FrameGraph {
+public:
+    using ResourceId = uint32_t;
+    static constexpr ResourceId INVALID_RESOURCE = 0xFFFFFFFFu;
+
+    struct TextureDesc {
+        int width = 0;
+        int height = 0;
+        GLenum internalFormat = GL_RGBA8;
+        GLenum format = GL_RGBA;
+        GLenum type = GL_UNSIGNED_BYTE;
+        GLenum filter = GL_LINEAR;
+
+        bool operator==(const TextureDesc& o) const {
+            return width == o.width && height == o.height && internalFormat == o.internalFormat &&
+                   format == o.format && type == o.type && filter == o.filter;
+        }
+    };
+
+    struct PassTiming {
+        std::string name;
+        double cpuMs = 0.0;
+        double gpuMs = 0.0;  // Latest resolved GL_TIME_ELAPSED result
+        bool culled = false;
+        bool skipped = false;  // Inputs unchanged since the last execution
+    };
+
+    FrameGraph();
+    ~FrameGraph();
+
+    FrameGraph(const FrameGraph&) = delete;
+    FrameGraph& operator=(const FrameGraph&) = delete;
+
+    /** Drop last frame's pass/resource declarations (pooled GL objects are kept). */
+    void beginFrame();
+
+    /**
+     * Declare an externally owned resource (FBO attachment, shadow map, backbuffer).
+     * @param texture Optional GL texture returned by getTexture()
+     */
+    ResourceId importResource(const std::string& name, GLuint texture = 0);
+
+    /** Declare a transient texture owned and aliased by the graph. */
+    ResourceId createTexture(const std::string& name, const TextureDesc& desc);
+
+    /**
+     * Declare a pass. Execution order follows declaration order.
+     * @param inputVersion Nonzero: a value that changes whenever anything the
+     *        pass's output depends on changes (besides its declared reads,
+     *        which are versioned by their producers); equal values let the
+     *        graph skip the pass
+     */
+    void addPass(const std::string& name,
+                 std::vector<ResourceId> reads,
+                 std::vector<ResourceId> writes,
+                 std::function<void()> execute,
+                 uint64_t inputVersion = 0);
+
+    /** Forget recorded input versions so every pass runs next frame. */
+    void invalidatePassCache() { executedVersions_.clear(); }
+
+    /** Mark a resource as a frame output (keeps its producers alive). */
+    void markOutput(ResourceId resource);
+
+    /** Cull unused passes and assign physical textures to transients. */
+    void compile();
+
+    /** Run all surviving passes with CPU/GPU timing. */
+    void execute();
+
+    /** Physical GL texture of a resource (valid after compile()). */
+    GLuint getTexture(ResourceId resource) const;
+
+    /** Per-pass timings for the last executed frame, in declaration order. */
+    const std::vector<PassTiming>& getPassTimings() const { return passTimings_; }
+
+    /** Total GPU time of the last resolved frame (ms). */
+    double getTotalGpuMs() const { return totalGpuMs_; }
+
+    /** Number of physical transient textures currently pooled. */
+    size_t getTransientTextureCount() const { return texturePool_.size(); }
+
+    /** Number of transient resources declared this frame (>= pooled textures in use). */
+    size_t getTransientResourceCount() const { return transientCount_; }
+
+    /** Delete pooled transient textures (e.g. after a resize). */
+    void releaseTransients();
+
+    /** Delete all GL objects owned by the graph. */
+    void shutdown();
+
+private:
+    static constexpr int QUERY_LATENCY = 3;           // Frames before reading a timer query
+    static constexpr uint32_t POOL_EVICT_FRAMES = 120;  // Unused pooled textures are freed
+
+    struct Resource {
+        std::string name;
+        bool transient = false;
+        TextureDesc desc;
+        GLuint texture = 0;
+        int physical = -1;        // Index into texturePool_ for transients
+        int refCount = 0;
+        int firstPass = -1;
+        int lastPass = -1;
+        bool output = false;
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+        std::function<void()> execute;
+        uint64_t inputVersion = 0;
+        int refCount = 0;
+        bool culled = false;
+        bool skipped = false;
+    };
+
+    struct PooledTexture {
+        TextureDesc desc;
+        GLuint texture = 0;
+        bool inUse = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    struct PassTimer {
+        GLuint queries[QUERY_LATENCY] = {};
+        bool pending[QUERY_LATENCY] = {};
+        double gpuMs = 0.0;
+    };
+
+    int acquirePooledTexture(const TextureDesc& desc);
+    PassTimer& timerFor(const std::string& name);
+
+    std::vector<Resource> resources_;
+    std::vector<Pass> passes_;
+    std::vector<PooledTexture> texturePool_;
+    std::unordered_map<std::string, PassTimer> timers_;
+    std::unordered_map<std::string, uint64_t> executedVersions_;  // Input version of each pass's last run
+    std::vector<PassTiming> passTimings_;
+    double totalGpuMs_ = 0.0;
+    size_t transientCount_ = 0;
+    uint64_t frameIndex_ = 0;
+    bool compiled_ = false;
+};
+
+} // namespace rendering
+} // namespace wowee
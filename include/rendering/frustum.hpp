@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace wowee {
 namespace rendering {
@@ -70,6 +72,22 @@ public:
      */
     bool intersectsAABB(const glm::vec3& min, const glm::vec3& max) const;
 
+    /**
+     * Batch sphere test over packed (SoA) bounds with a per-sphere range limit
+     *
+     * Sphere i is kept if it is not completely behind any plane and
+     * |center - eye|^2 <= min(rangeScale[i] * rangeSq, rangeCapSq). A radius
+     * of +inf skips the plane test; a negative rangeScale always rejects.
+     * Runs 8 wide with AVX2 or 4 wide with SSE when the CPU has them.
+     * @param outIndices Receives indices of kept spheres (room for count)
+     * @param outDistSq Receives their squared distance to eye (room for count)
+     * @return Number of kept spheres
+     */
+    size_t cullSpheres(const float* centerX, const float* centerY, const float* centerZ,
+                       const float* radius, const float* rangeScale, size_t count,
+                       const glm::vec3& eye, float rangeSq, float rangeCapSq,
+                       uint32_t* outIndices, float* outDistSq) const;
+
     /**
      * Get frustum plane
      */
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace wowee {
+namespace rendering {
+
+enum class UploadPriority {
+    NORMAL,
+    HIGH,       // Near the camera: may overrun the normal budget
+};
+
+/**
+ * GpuUploadManager - shared staging ring and per-frame upload budget
+ *
+ * Static geometry and texture uploads from the terrain, M2, WMO and
+ * character renderers go through uploadBufferData()/uploadTexImage2D().
+ * With ARB_buffer_storage the data is copied into a persistently mapped
+ * ring and handed to GL as a buffer-to-buffer copy or PBO unpack, so the
+ * driver does not have to block on or duplicate client memory. Each
+ * frame's slice of the ring is fenced in endFrame() and reused once the
+ * GPU has passed the fence; uploads that don't fit fall back to the
+ * direct call instead of stalling.
+ *
+ * Every upload is counted against a per-frame byte and time budget that
+ * streaming code checks with hasBudget() before starting more work.
+ *
+ * Main (GL) thread only.
+ */
+class GpuUploadManager {
+public:
+    static GpuUploadManager& getInstance();
+
+    GpuUploadManager(const GpuUploadManager&) = delete;
+    GpuUploadManager& operator=(const GpuUploadManager&) = delete;
+
+    /** Create the staging ring (needs a current GL context). */
+    bool initialize(size_t ringBytes = 32 * 1024 * 1024);
+    void shutdown();
+
+    /** Fence this frame's staging slice, reclaim finished ones, reset the budget. */
+    void endFrame();
+
+    /** glBufferData on the buffer bound to target, staged when possible. */
+    void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage);
+
+    /**
+     * glTexImage2D on the bound GL_TEXTURE_2D (GL_UNSIGNED_BYTE pixels laid
+     * out per the current GL_UNPACK_ALIGNMENT), staged when possible
+     */
+    void texImage2D(GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                    GLenum format, const void* pixels);
+
+    /** glCompressedTexImage2D on the bound GL_TEXTURE_2D, staged when possible. */
+    void compressedTexImage2D(GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                              GLsizei imageSize, const void* data);
+
+    /**
+     * Whether more uploads fit this frame. The first upload of a frame is
+     * always allowed so queues keep draining; HIGH gets twice the budget.
+     */
+    bool hasBudget(UploadPriority priority = UploadPriority::NORMAL) const;
+
+    void setFrameBudget(size_t bytes, float ms) { budgetBytes_ = bytes; budgetMs_ = ms; }
+    size_t getFrameBytes() const { return frameBytes_; }
+    float getFrameUploadMs() const { return frameUploadMs_; }
+    bool isStaging() const { return ringBuffer_ != 0; }
+
+private:
+    GpuUploadManager() = default;
+
+    /** Reserve ring space; returns false (caller uploads directly) if it doesn't fit. */
+    bool allocate(size_t bytes, size_t& offset);
+    void fenceCurrentRegion();
+    void reclaim();
+    void account(size_t bytes, std::chrono::steady_clock::time_point start);
+
+    struct Region {
+        size_t bytes = 0;       // Ring bytes held, including wrap padding
+        GLsync fence = nullptr;
+    };
+
+    GLuint ringBuffer_ = 0;
+    uint8_t* ringPtr_ = nullptr;
+    size_t ringSize_ = 0;
+    size_t head_ = 0;            // Next write offset
+    size_t used_ = 0;            // Bytes held by fenced and current regions
+    size_t currentRegion_ = 0;   // Bytes written since the last fence
+    std::deque<Region> regions_;
+
+    size_t budgetBytes_ = 16 * 1024 * 1024;
+    float budgetMs_ = 4.0f;
+    size_t frameBytes_ = 0;
+    float frameUploadMs_ = 0.0f;
+    uint32_t frameUploads_ = 0;
+};
+
+/** Shorthands for GpuUploadManager::getInstance().bufferData()/texImage2D()/compressedTexImage2D(). */
+void uploadBufferData(GLenum target, size_t bytes, const void* data, GLenum usage);
+void uploadTexImage2D(GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                      GLenum format, const void* pixels);
+void uploadCompressedTexImage2D(GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                GLsizei imageSize, const void* data);
+
+} // namespace rendering
+} // namespace wowee
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "pipeline/m2_loader.hpp"
+#include "rendering/animation_evaluator.hpp"
+#include "rendering/dynamic_bvh.hpp"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -144,6 +146,7 @@ struct M2Instance {
     int currentSequenceIndex = 0;// Index into sequences array
     float animDuration = 0.0f;   // Duration of current animation (ms)
     std::vector<glm::mat4> boneMatrices;
+    AnimationCursor animCursor;  // Cached keyframe brackets per bone track
 
     // Idle variation state
     int idleSequenceIndex = 0;   // Default idle sequence index
@@ -154,8 +157,11 @@ struct M2Instance {
     std::vector<float> emitterAccumulators;  // fractional particle counter per emitter
     std::vector<M2Particle> particles;
 
-    // Frame-skip optimization (update distant animations less frequently)
-    uint8_t frameSkipCounter = 0;
+    // Animation LOD (reduced-rate / shared-pose evaluation for small on-screen instances)
+    uint8_t animLodLevel = 0;      // 0 = evaluated every frame into boneMatrices
+    int32_t sharedPoseSlot = -1;   // Shared palette used for rendering (-1 = boneMatrices)
+
+    int32_t bvhProxy = -1;         // Leaf in M2Renderer's collision BVH
 
     void updateModelMatrix();
 };
@@ -326,6 +332,11 @@ public:
     uint32_t getInstanceCount() const { return static_cast<uint32_t>(instances.size()); }
     uint32_t getTotalTriangleCount() const;
     uint32_t getDrawCallCount() const { return lastDrawCallCount; }
+    /** Bumped whenever an instance is added, moved or removed (shadow map caching). */
+    uint64_t getShadowCasterVersion() const { return shadowCasterVersion_; }
+    uint32_t getAnimEvaluatedInstanceCount() const { return lastAnimEvaluatedCount_; }
+    uint32_t getAnimSharedPoseCount() const { return lastAnimSharedPoseCount_; }
+    uint32_t getAnimLodInstanceCount() const { return lastAnimLodInstanceCount_; }
 
     void setFog(const glm::vec3& color, float start, float end) {
         fogColor = color; fogStart = start; fogEnd = end;
@@ -357,6 +368,7 @@ private:
 
     uint32_t nextInstanceId = 1;
     uint32_t lastDrawCallCount = 0;
+    uint64_t shadowCasterVersion_ = 0;
 
     GLuint loadTexture(const std::string& path, uint32_t texFlags = 0);
     struct TextureCacheEntry {
@@ -411,14 +423,15 @@ private:
         }
     };
     GridCell toCell(const glm::vec3& p) const;
-    void rebuildSpatialIndex();
-    void gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax, std::vector<size_t>& outIndices) const;
+    void rebuildInstanceIndex();
+    void gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax, std::vector<uint32_t>& outIndices) const;
 
     static constexpr float SPATIAL_CELL_SIZE = 64.0f;
-    std::unordered_map<GridCell, std::vector<uint32_t>, GridCellHash> spatialGrid;
+    // Collision/raycast broad phase over worldBoundsMin/Max. Leaf payload is
+    // the instance index; rebuildInstanceIndex() re-keys leaves after erases.
+    DynamicBVH collisionTree_{1.0f};
     std::unordered_map<uint32_t, size_t> instanceIndexById;
-    mutable std::vector<size_t> candidateScratch;
-    mutable std::unordered_set<uint32_t> candidateIdScratch;
+    mutable std::vector<uint32_t> candidateScratch;
     mutable std::vector<uint32_t> collisionTriScratch_;
 
     // Collision query profiling (per frame).
@@ -433,6 +446,37 @@ private:
         float effectiveMaxDistSq;
     };
     std::vector<VisibleEntry> sortedVisible_;  // Reused each frame
+
+    // Render culling data, packed SoA and bucketed by the spatial grid cell
+    // holding each instance's center. render() rejects whole cells by their
+    // bounds, then tests the survivors with Frustum::cullSpheres. Kept in step
+    // with `instances` by createInstance / setInstance* / remove* / clear.
+    struct CullCell {
+        GridCell key;
+        glm::vec3 boundsMin;             // Union of the padded spheres; only grows until rebuildCullCells()
+        glm::vec3 boundsMax;
+        float maxRangeScale = -1.0f;
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> radius;       // Padded cull radius (+inf = no frustum test)
+        std::vector<float> rangeScale;   // Render distance multiplier (< 0 = never drawn)
+        std::vector<uint32_t> instanceIndex;
+    };
+    struct CullSlot {
+        uint32_t cell = UINT32_MAX;
+        uint32_t slot = 0;
+    };
+    std::vector<CullCell> cullCells_;
+    std::unordered_map<GridCell, uint32_t, GridCellHash> cullCellIndex_;
+    std::vector<CullSlot> cullSlots_;             // Parallel to instances
+    std::vector<uint32_t> cullKeptScratch_;       // Reused each frame
+    std::vector<float> cullDistScratch_;
+    void computeCullBounds(const M2Instance& inst, float& paddedRadius, float& rangeScale) const;
+    void cullInsert(uint32_t instanceIndex);
+    void cullErase(uint32_t instanceIndex);
+    void cullUpdate(uint32_t instanceIndex);
+    void rebuildCullCells();
     struct GlowSprite {
         glm::vec3 worldPos;
         glm::vec4 color;
@@ -443,7 +487,61 @@ private:
     // Animation update buffers (avoid per-frame allocation)
     std::vector<size_t> boneWorkIndices_;        // Reused each frame
     std::vector<std::future<void>> animFutures_; // Reused each frame
-    bool spatialIndexDirty_ = false;
+
+    // Animation LOD: instances that are small on screen sample poses at a
+    // quantized time. Poses are keyed by (model, sequence, quantum, bucket) and
+    // evaluated once per unique key, so identical doodads playing in phase share
+    // one palette. LOD 1-2 blend the two bracketing shared poses per frame;
+    // LOD 3 renders the shared palette directly.
+    struct SharedPoseKey {
+        uint32_t modelId;
+        int32_t sequence;
+        uint32_t lod;
+        uint32_t bucket;
+        bool operator==(const SharedPoseKey& o) const {
+            return modelId == o.modelId && sequence == o.sequence && lod == o.lod && bucket == o.bucket;
+        }
+    };
+    struct SharedPoseKeyHash {
+        size_t operator()(const SharedPoseKey& k) const {
+            uint64_t h = (static_cast<uint64_t>(k.modelId) << 32) ^
+                         (static_cast<uint64_t>(static_cast<uint32_t>(k.sequence)) << 20) ^
+                         (static_cast<uint64_t>(k.lod) << 16) ^ k.bucket;
+            return std::hash<uint64_t>()(h * 0x9e3779b97f4a7c15ull);
+        }
+    };
+    struct SharedPose {
+        uint32_t modelId = 0;
+        int32_t sequence = 0;
+        float timeMs = 0.0f;
+        uint64_t lastUsedFrame = 0;
+        AnimationCursor cursor;
+        std::vector<glm::mat4> bones;
+    };
+    struct PoseBlendWork {
+        size_t instanceIndex;
+        uint32_t slotA;
+        uint32_t slotB;
+        float blend;
+    };
+    uint32_t acquireSharedPose(uint32_t modelId, int32_t sequence, uint32_t lod,
+                               uint32_t bucket, float timeMs);
+    void releaseStaleSharedPoses();
+    const std::vector<glm::mat4>& bonePalette(const M2Instance& instance) const {
+        return instance.sharedPoseSlot >= 0 ? sharedPoses_[instance.sharedPoseSlot].bones
+                                            : instance.boneMatrices;
+    }
+    template <typename Fn> void runAnimJobs(size_t count, Fn&& job);
+
+    std::unordered_map<SharedPoseKey, uint32_t, SharedPoseKeyHash> sharedPoseIndex_;
+    std::vector<SharedPose> sharedPoses_;
+    std::vector<uint32_t> freeSharedPoseSlots_;
+    std::vector<uint32_t> poseEvalSlots_;       // Shared poses to evaluate this frame
+    std::vector<PoseBlendWork> poseBlendWork_;  // LOD 1-2 per-instance blends this frame
+    uint64_t animFrameCounter_ = 0;
+    uint32_t lastAnimEvaluatedCount_ = 0;
+    uint32_t lastAnimSharedPoseCount_ = 0;
+    uint32_t lastAnimLodInstanceCount_ = 0;
 
     // Smoke particle system
     std::vector<SmokeParticle> smokeParticles;
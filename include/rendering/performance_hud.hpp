@@ -64,6 +64,7 @@ public:
     void setShowRenderer(bool show) { showRenderer = show; }
     void setShowTerrain(bool show) { showTerrain = show; }
     void setShowCamera(bool show) { showCamera = show; }
+    void setShowMetrics(bool show) { showMetrics = show; }
     void setShowControls(bool show) { showControls = show; }
 
 private:
@@ -80,6 +81,7 @@ private:
     bool showRenderer = true;
     bool showTerrain = true;
     bool showCamera = true;
+    bool showMetrics = true;
     bool showControls = true;
 
     // FPS tracking
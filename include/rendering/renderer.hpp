@@ -37,6 +37,7 @@ class M2Renderer;
 class Minimap;
 class QuestMarkerRenderer;
 class Shader;
+class FrameGraph;
 
 class Renderer {
 public:
@@ -154,6 +155,7 @@ public:
     double getLastTerrainRenderMs() const { return lastTerrainRenderMs; }
     double getLastWMORenderMs() const { return lastWMORenderMs; }
     double getLastM2RenderMs() const { return lastM2RenderMs; }
+    const FrameGraph* getFrameGraph() const { return frameGraph.get(); }
     audio::MusicManager* getMusicManager() { return musicManager.get(); }
     game::ZoneManager* getZoneManager() { return zoneManager.get(); }
     audio::FootstepManager* getFootstepManager() { return footstepManager.get(); }
@@ -210,13 +212,12 @@ private:
     uint32_t sceneFBO = 0;          // MSAA render target
     uint32_t sceneColorRBO = 0;     // GL_RGBA16F multisampled renderbuffer
     uint32_t sceneDepthRBO = 0;     // GL_DEPTH_COMPONENT24 multisampled renderbuffer
-    uint32_t resolveFBO = 0;        // Non-MSAA resolve target
-    uint32_t resolveColorTex = 0;   // GL_RGBA16F resolved texture (sampled by post-process)
-    uint32_t resolveDepthTex = 0;   // GL_DEPTH_COMPONENT24 resolved texture (for future SSAO)
+    uint32_t resolveFBO = 0;        // Non-MSAA resolve target (frame graph transient attachments)
     uint32_t screenQuadVAO = 0;
     uint32_t screenQuadVBO = 0;
     std::unique_ptr<Shader> postProcessShader;
     int fbWidth = 0, fbHeight = 0;
+    std::unique_ptr<FrameGraph> frameGraph;  // Per-frame pass scheduling + GPU timings
 
     void initPostProcess(int w, int h);
     void resizePostProcess(int w, int h);
@@ -226,6 +227,9 @@ private:
     static constexpr int SHADOW_MAP_SIZE = 2048;
     uint32_t shadowFBO = 0;
     uint32_t shadowDepthTex = 0;
+    // Terrain/WMO/M2 depth, re-rendered only when the light or casters change
+    uint32_t staticShadowFBO = 0;
+    uint32_t staticShadowDepthTex = 0;
     uint32_t shadowShaderProgram = 0;
     glm::mat4 lightSpaceMatrix = glm::mat4(1.0f);
     glm::vec3 shadowCenter = glm::vec3(0.0f);
@@ -238,6 +242,7 @@ public:
 
 private:
     void initShadowMap();
+    void renderStaticShadowCasters();
     void renderShadowPass();
     uint32_t compileShadowShader();
     glm::mat4 computeLightSpaceMatrix();
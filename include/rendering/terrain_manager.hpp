@@ -302,7 +302,7 @@ private:
     std::mutex queueMutex;
     std::condition_variable queueCV;
     std::deque<TileCoord> loadQueue;
-    std::queue<std::shared_ptr<PendingTile>> readyQueue;
+    std::deque<std::shared_ptr<PendingTile>> readyQueue;  // Finalized nearest-first
 
     // In-RAM tile cache (LRU) to avoid re-reading from disk
     struct CachedTile {
@@ -340,7 +340,7 @@ private:
         std::string path;
     };
     std::queue<PendingM2Upload> m2UploadQueue_;
-    static constexpr int MAX_M2_UPLOADS_PER_FRAME = 5;  // Upload up to 5 models per frame
+    static constexpr int MAX_M2_UPLOADS_PER_FRAME = 5;  // Upload up to 5 models per frame (and within the GPU upload budget)
 
     void processM2UploadQueue();
 };
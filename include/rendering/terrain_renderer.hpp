@@ -150,6 +150,8 @@ public:
      */
     int getChunkCount() const { return static_cast<int>(chunks.size()); }
     int getRenderedChunkCount() const { return renderedChunks; }
+    /** Bumped whenever chunks are added or removed (shadow map caching). */
+    uint64_t getShadowCasterVersion() const { return shadowCasterVersion_; }
     int getCulledChunkCount() const { return culledChunks; }
     int getTriangleCount() const;
 
@@ -211,6 +213,7 @@ private:
     bool frustumCullingEnabled = true;
     bool fogEnabled = true;
     int renderedChunks = 0;
+    uint64_t shadowCasterVersion_ = 0;
     int culledChunks = 0;
 
     // Default white texture (fallback)
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <GL/glew.h>
 
 namespace wowee {
+namespace pipeline { struct BLPCompressedImage; }
 namespace rendering {
 
 class Texture {
@@ -34,5 +37,16 @@ private:
  */
 void applyAnisotropicFiltering();
 
+/** True if the driver takes S3TC (DXT1/3/5) textures as-is. */
+bool compressedTexturesSupported();
+
+/**
+ * Upload a DXT mip chain (e.g. from a cooked texture) to the currently
+ * bound GL_TEXTURE_2D and clamp GL_TEXTURE_MAX_LEVEL to it.
+ * @return false without touching the texture if S3TC is unsupported or the
+ *         image is invalid (caller should upload RGBA instead)
+ */
+bool uploadCompressedTexture(const pipeline::BLPCompressedImage& image);
+
 } // namespace rendering
 } // namespace wowee
@@ -1,14 +1,38 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 typedef unsigned int GLuint;
+typedef struct __GLsync* GLsync;
 
 namespace wowee {
 namespace rendering {
 
+class Shader;
+
+/**
+ * Looping background video rendered into a texture
+ *
+ * A decode thread owns the FFmpeg contexts and fills a small ring of frame
+ * slots with raw YUV 4:2:0 planes. When the driver supports persistent
+ * mapping (ARB_buffer_storage) the slots live in one mapped pixel unpack
+ * buffer, so the decoder writes straight into memory the GPU uploads from.
+ * update() on the render thread picks the newest due frame, issues the
+ * Y/U/V plane uploads from its buffer range and converts to RGB in a
+ * fragment shader pass; a fence per slot tells the decoder when it may
+ * reuse that range. Without persistent mapping the slots are plain memory
+ * and update() streams them through an orphaned PBO instead.
+ */
 class VideoPlayer {
 public:
     VideoPlayer();
@@ -24,27 +48,69 @@ public:
     int getHeight() const { return height; }
 
 private:
-    bool decodeNextFrame();
-    void uploadFrame();
+    // 3 frames queued ahead of the one the GPU may still be reading
+    static constexpr int SLOT_COUNT = 4;
+
+    enum class SlotState : uint8_t {
+        FREE,        // Decoder may fill it
+        DECODING,    // Decoder is writing planes
+        READY,       // Queued for display
+        IN_FLIGHT    // Uploads issued, waiting on fence
+    };
+
+    struct FrameSlot {
+        uint8_t* data = nullptr;    // Y, U, V planes, tightly packed
+        SlotState state = SlotState::FREE;
+        GLsync fence = nullptr;
+    };
+
+    bool createGpuResources();
+    void destroyGpuResources();
+
+    // Decode thread
+    void decodeLoop();
+    bool decodeFrame(uint8_t* dst);
+
+    // Render thread
+    void reclaimSlots();
+    void presentSlot(int slot);
 
     void* formatCtx = nullptr;
     void* codecCtx = nullptr;
     void* frame = nullptr;
-    void* rgbFrame = nullptr;
     void* packet = nullptr;
-    void* swsCtx = nullptr;
+    void* swsCtx = nullptr;         // Only for sources that are not YUV 4:2:0
 
     int videoStreamIndex = -1;
     int width = 0;
     int height = 0;
+    int chromaWidth = 0;
+    int chromaHeight = 0;
+    size_t frameBytes = 0;
+    size_t slotStride = 0;
+    bool fullRange = false;
+    bool bt709 = false;
     double frameTime = 1.0 / 30.0;
     double accumulator = 0.0;
-    bool eof = false;
 
-    GLuint textureId = 0;
+    GLuint textureId = 0;           // RGBA output
+    GLuint planeTextures[3] = {0, 0, 0};
+    GLuint fbo = 0;
+    GLuint vao = 0;
+    GLuint pbo = 0;
+    bool persistentMapping = false;
+    std::unique_ptr<Shader> yuvShader;
+    std::vector<uint8_t> cpuSlots;  // Slot storage without persistent mapping
+
     bool textureReady = false;
     std::string sourcePath;
-    std::vector<uint8_t> rgbBuffer;
+
+    std::array<FrameSlot, SLOT_COUNT> slots;
+    std::deque<int> readyQueue;
+    std::mutex slotMutex;
+    std::condition_variable slotCv;
+    std::atomic<bool> stopDecode{false};
+    std::thread decodeThread;
 };
 
 } // namespace rendering
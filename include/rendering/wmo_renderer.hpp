@@ -1,5 +1,7 @@
 #pragma once
 
+#include "rendering/dynamic_bvh.hpp"
+#include "pipeline/wmo_loader.hpp"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -100,8 +102,9 @@ public:
      * @param instanceId WMO instance to add doodad to
      * @param m2InstanceId M2 instance ID of the doodad
      * @param localTransform Local transform relative to WMO origin
+     * @return false if the WMO instance no longer exists (doodad not attached)
      */
-    void addDoodadToInstance(uint32_t instanceId, uint32_t m2InstanceId, const glm::mat4& localTransform);
+    bool addDoodadToInstance(uint32_t instanceId, uint32_t m2InstanceId, const glm::mat4& localTransform);
 
     // Forward declare DoodadTemplate for public API
     struct DoodadTemplate {
@@ -164,6 +167,8 @@ public:
      * Get total draw call count (last frame)
      */
     uint32_t getDrawCallCount() const { return lastDrawCalls; }
+    /** Bumped whenever an instance is added, moved or removed (shadow map caching). */
+    uint64_t getShadowCasterVersion() const { return shadowCasterVersion_; }
 
     /**
      * Enable/disable wireframe rendering
@@ -335,28 +340,10 @@ private:
         std::vector<glm::vec3> collisionVertices;
         std::vector<uint16_t> collisionIndices;
 
-        // 2D spatial grid for fast triangle lookup (built at load time).
-        // Bins triangles by their XY bounding box into grid cells.
-        static constexpr float COLLISION_CELL_SIZE = 4.0f;
-        int gridCellsX = 0;
-        int gridCellsY = 0;
-        glm::vec2 gridOrigin;  // XY of bounding box min
-        // cellTriangles[cellY * gridCellsX + cellX] = list of triangle start indices
-        std::vector<std::vector<uint32_t>> cellTriangles;
-
-        // Pre-classified triangle lists per cell (built at load time)
-        std::vector<std::vector<uint32_t>> cellFloorTriangles;  // abs(normal.z) >= 0.45
-        std::vector<std::vector<uint32_t>> cellWallTriangles;   // abs(normal.z) < 0.55
-
-        // Pre-computed per-triangle Z bounds for fast vertical reject
-        struct TriBounds { float minZ; float maxZ; };
-        std::vector<TriBounds> triBounds;  // indexed by triStart/3
-
-        // Build the spatial grid from collision geometry
-        void buildCollisionGrid();
-
-        // Get triangle indices for a local-space XY point
-        const std::vector<uint32_t>* getTrianglesAtLocal(float localX, float localY) const;
+        // 2D spatial grid for fast triangle lookup: cooked with the group by
+        // asset_cook, otherwise built at load time. Also holds per-triangle
+        // Z bounds (collisionGrid.triBounds, indexed by triStart/3).
+        pipeline::WMOCollisionGrid collisionGrid;
 
         // Get triangle indices for a local-space XY range (for wall collision)
         void getTrianglesInRange(float minX, float minY, float maxX, float maxY,
@@ -441,6 +428,7 @@ private:
         glm::vec3 worldBoundsMin;
         glm::vec3 worldBoundsMax;
         std::vector<std::pair<glm::vec3, glm::vec3>> worldGroupBounds;
+        int32_t bvhProxy = -1;  // Leaf in collisionTree_
 
         // Doodad tracking: M2 instances that are children of this WMO
         struct DoodadInfo {
@@ -519,26 +507,8 @@ private:
      */
     bool isGroupOccluded(uint32_t instanceId, uint32_t groupIndex) const;
 
-    struct GridCell {
-        int x;
-        int y;
-        int z;
-        bool operator==(const GridCell& other) const {
-            return x == other.x && y == other.y && z == other.z;
-        }
-    };
-    struct GridCellHash {
-        size_t operator()(const GridCell& c) const {
-            size_t h1 = std::hash<int>()(c.x);
-            size_t h2 = std::hash<int>()(c.y);
-            size_t h3 = std::hash<int>()(c.z);
-            return h1 ^ (h2 * 0x9e3779b9u) ^ (h3 * 0x85ebca6bu);
-        }
-    };
-
-    GridCell toCell(const glm::vec3& p) const;
-    void rebuildSpatialIndex();
-    void gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax, std::vector<size_t>& outIndices) const;
+    void rebuildInstanceIndex();
+    void gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax, std::vector<uint32_t>& outIndices) const;
 
     // Shader
     std::unique_ptr<Shader> shader;
@@ -582,6 +552,7 @@ private:
     float maxGroupDistance = 500.0f;
     float maxGroupDistanceSq = 250000.0f;  // maxGroupDistance^2
     uint32_t lastDrawCalls = 0;
+    uint64_t shadowCasterVersion_ = 0;
     mutable uint32_t lastPortalCulledGroups = 0;
     mutable uint32_t lastDistanceCulledGroups = 0;
     mutable uint32_t lastOcclusionCulledGroups = 0;
@@ -617,13 +588,12 @@ private:
     float collisionFocusRadius = 0.0f;
     float collisionFocusRadiusSq = 0.0f;
 
-    // Uniform grid for fast local collision queries.
-    static constexpr float SPATIAL_CELL_SIZE = 64.0f;
-    std::unordered_map<GridCell, std::vector<uint32_t>, GridCellHash> spatialGrid;
+    // Dynamic BVH over instance world bounds for collision/raycast queries.
+    // Leaf payload is the instance index (re-keyed by rebuildInstanceIndex()).
+    DynamicBVH collisionTree_{4.0f};
     std::unordered_map<uint32_t, size_t> instanceIndexById;
-    mutable std::vector<size_t> candidateScratch;
+    mutable std::vector<uint32_t> candidateScratch;
     mutable std::vector<uint32_t> wallTriScratch;  // Scratch for wall collision grid queries
-    mutable std::unordered_set<uint32_t> candidateIdScratch;
 
     // Parallel visibility culling
     uint32_t numCullThreads_ = 1;
@@ -4,6 +4,7 @@
 #include <GL/glew.h>
 #include <imgui.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -35,8 +36,9 @@ public:
     void toggle() { open = !open; }
     void setOpen(bool o) { open = o; }
 
-    // Spell name lookup — triggers DBC load if needed, used by action bar tooltips
-    std::string lookupSpellName(uint32_t spellId, pipeline::AssetManager* assetManager);
+    // Spell name lookup — triggers DBC load if needed, used by action bar tooltips.
+    // Returns a view of the cached name (empty if unknown); no allocation per call.
+    std::string_view lookupSpellName(uint32_t spellId, pipeline::AssetManager* assetManager);
 
     // Drag-and-drop state for action bar assignment
     bool isDraggingSpell() const { return draggingSpell_; }
@@ -107,7 +107,7 @@ void ActivitySoundManager::update(float deltaTime) {
 
             // Play as one-shot 2D sound
             float volume = 0.6f * volumeScale;
-            AudioEngine::instance().playSound2D(sample.data, volume, false);
+            AudioEngine::instance().playSound2D(sample.data, volume, 1.0f, SoundCategory::MOVEMENT);
 
             lastSwimStrokeAt = now;
         }
@@ -292,7 +292,7 @@ void ActivitySoundManager::playJump() {
     float volume = volumeDist(rng) * volumeScale;
     float pitch = pitchDist(rng);
 
-    if (AudioEngine::instance().playSound2D(sample.data, volume, pitch)) {
+    if (AudioEngine::instance().playSound2D(sample.data, volume, pitch, SoundCategory::MOVEMENT)) {
         lastJumpAt = now;
     }
 }
@@ -316,7 +316,7 @@ void ActivitySoundManager::playLanding(FootstepSurface surface, bool hardLanding
         std::uniform_real_distribution<float> volumeDist(baseVolume * 0.95f, baseVolume * 1.05f);
         std::uniform_real_distribution<float> pitchDist(0.95f, 1.03f);
 
-        AudioEngine::instance().playSound2D(sample.data, volumeDist(rng) * volumeScale, pitchDist(rng));
+        AudioEngine::instance().playSound2D(sample.data, volumeDist(rng) * volumeScale, pitchDist(rng), SoundCategory::MOVEMENT);
         lastLandAt = now;
     }
 
@@ -325,7 +325,7 @@ void ActivitySoundManager::playLanding(FootstepSurface surface, bool hardLanding
         const Sample& sample = hardLandClips[dist(rng)];
         std::uniform_real_distribution<float> volumeDist(0.80f, 0.88f);
         std::uniform_real_distribution<float> pitchDist(0.97f, 1.03f);
-        AudioEngine::instance().playSound2D(sample.data, volumeDist(rng) * volumeScale, pitchDist(rng));
+        AudioEngine::instance().playSound2D(sample.data, volumeDist(rng) * volumeScale, pitchDist(rng), SoundCategory::MOVEMENT);
     }
 }
 
@@ -349,7 +349,7 @@ void ActivitySoundManager::playMeleeSwing() {
     std::uniform_real_distribution<float> volumeDist(0.76f, 0.84f);
     std::uniform_real_distribution<float> pitchDist(0.96f, 1.04f);
 
-    if (AudioEngine::instance().playSound2D(sample.data, volumeDist(rng) * volumeScale, pitchDist(rng))) {
+    if (AudioEngine::instance().playSound2D(sample.data, volumeDist(rng) * volumeScale, pitchDist(rng), SoundCategory::MOVEMENT)) {
         lastMeleeSwingAt = now;
     }
 }
@@ -7,11 +7,16 @@
 #include <cmath>
 #include <chrono>
 #include <ctime>
+#include <filesystem>
 
 namespace wowee {
 namespace audio {
 
 namespace {
+    // Samples larger than this are streamed from disk instead of being held
+    // in memory (and decoded whole) for the lifetime of the manager
+    constexpr uintmax_t STREAM_MIN_BYTES = 256 * 1024;
+
     // Distance thresholds (in game units)
     constexpr float MAX_FIRE_DISTANCE = 20.0f;
     constexpr float MAX_WATER_DISTANCE = 35.0f;
@@ -230,7 +235,7 @@ bool AmbientSoundManager::initialize(pipeline::AssetManager* assets) {
 }
 
 void AmbientSoundManager::shutdown() {
-    emitters_.clear();
+    clearEmitters();
     activeSounds_.clear();
     initialized_ = false;
 }
@@ -240,6 +245,16 @@ bool AmbientSoundManager::loadSound(const std::string& path, AmbientSample& samp
     sample.loaded = false;
 
     try {
+        std::string filePath = assets->resolveFilesystemPath(path);
+        if (!filePath.empty()) {
+            std::error_code ec;
+            uintmax_t size = std::filesystem::file_size(filePath, ec);
+            if (!ec && size >= STREAM_MIN_BYTES) {
+                sample.streamPath = std::move(filePath);
+                sample.loaded = true;
+                return true;
+            }
+        }
         sample.data = assets->readFile(path);
         if (!sample.data.empty()) {
             sample.loaded = true;
@@ -252,6 +267,21 @@ bool AmbientSoundManager::loadSound(const std::string& path, AmbientSample& samp
     return false;
 }
 
+bool AmbientSoundManager::playSample2D(const AmbientSample& sample, float volume) {
+    if (!sample.streamPath.empty()) {
+        return AudioEngine::instance().playStream2D(sample.streamPath, volume, SoundCategory::AMBIENT);
+    }
+    return AudioEngine::instance().playSound2D(sample.data, volume, 1.0f, SoundCategory::AMBIENT);
+}
+
+bool AmbientSoundManager::playSample3D(const AmbientSample& sample, const glm::vec3& position, float volume) {
+    if (!sample.streamPath.empty()) {
+        return AudioEngine::instance().playStream3D(sample.streamPath, position, volume, 1.0f, 100.0f,
+                                                    SoundCategory::AMBIENT);
+    }
+    return AudioEngine::instance().playSound3D(sample.data, position, volume, 1.0f, 100.0f, SoundCategory::AMBIENT);
+}
+
 void AmbientSoundManager::update(float deltaTime, const glm::vec3& cameraPos, bool isIndoor, bool isSwimming, bool isBlacksmith) {
     if (!initialized_) return;
 
@@ -289,114 +319,135 @@ void AmbientSoundManager::update(float deltaTime, const glm::vec3& cameraPos, bo
 }
 
 void AmbientSoundManager::updatePositionalEmitters(float deltaTime, const glm::vec3& cameraPos) {
-    // First pass: mark emitters as active/inactive based on distance
+    // Visit only the cells of nearby tiles that can hold an emitter in range
     int activeFireCount = 0;
     int activeWaterCount = 0;
+    const float range = MAX_AMBIENT_DISTANCE;
+    const int32_t minCellX = emitterCell(cameraPos.x - range), maxCellX = emitterCell(cameraPos.x + range);
+    const int32_t minCellY = emitterCell(cameraPos.y - range), maxCellY = emitterCell(cameraPos.y + range);
+
+    for (auto& [tileKey, tile] : emitterTiles_) {
+        if (cameraPos.x + range < tile.minX || cameraPos.x - range > tile.maxX ||
+            cameraPos.y + range < tile.minY || cameraPos.y - range > tile.maxY) {
+            continue;
+        }
+        for (int32_t cx = minCellX; cx <= maxCellX; cx++) {
+            for (int32_t cy = minCellY; cy <= maxCellY; cy++) {
+                auto cellIt = tile.cells.find(packKey(cx, cy));
+                if (cellIt == tile.cells.end()) continue;
+                for (auto& emitter : cellIt->second) {
+                    updateEmitter(emitter, deltaTime, cameraPos, activeFireCount, activeWaterCount);
+                }
+            }
+        }
+    }
+}
+
+void AmbientSoundManager::updateEmitter(AmbientEmitter& emitter, float deltaTime, const glm::vec3& cameraPos,
+                                        int& activeFireCount, int& activeWaterCount) {
     const int MAX_ACTIVE_FIRE = 5;      // Max 5 fire sounds at once
     const int MAX_ACTIVE_WATER = 3;     // Max 3 water sounds at once
 
-    for (auto& emitter : emitters_) {
-        float distance = glm::distance(emitter.position, cameraPos);
-
-        // Determine max distance based on type
-        float maxDist = MAX_AMBIENT_DISTANCE;
-        bool isFire = false;
-        bool isWater = false;
-
-        if (emitter.type == AmbientType::FIREPLACE_SMALL ||
-            emitter.type == AmbientType::FIREPLACE_LARGE ||
-            emitter.type == AmbientType::TORCH) {
-            maxDist = MAX_FIRE_DISTANCE;
-            isFire = true;
-        } else if (emitter.type == AmbientType::WATER_SURFACE ||
-                   emitter.type == AmbientType::RIVER ||
-                   emitter.type == AmbientType::WATERFALL ||
-                   emitter.type == AmbientType::FOUNTAIN) {
-            maxDist = MAX_WATER_DISTANCE;
-            isWater = true;
-        }
+    float distance = glm::distance(emitter.position, cameraPos);
+
+    // Determine max distance based on type
+    float maxDist = MAX_AMBIENT_DISTANCE;
+    bool isFire = false;
+    bool isWater = false;
+
+    if (emitter.type == AmbientType::FIREPLACE_SMALL ||
+        emitter.type == AmbientType::FIREPLACE_LARGE ||
+        emitter.type == AmbientType::TORCH) {
+        maxDist = MAX_FIRE_DISTANCE;
+        isFire = true;
+    } else if (emitter.type == AmbientType::WATER_SURFACE ||
+               emitter.type == AmbientType::RIVER ||
+               emitter.type == AmbientType::WATERFALL ||
+               emitter.type == AmbientType::FOUNTAIN) {
+        maxDist = MAX_WATER_DISTANCE;
+        isWater = true;
+    }
 
-        // Update active state based on distance AND limits
-        bool withinRange = (distance < maxDist);
-
-        if (isFire && withinRange && activeFireCount < MAX_ACTIVE_FIRE) {
-            emitter.active = true;
-            activeFireCount++;
-        } else if (isWater && withinRange && activeWaterCount < MAX_ACTIVE_WATER) {
-            emitter.active = true;
-            activeWaterCount++;
-        } else if (!isFire && !isWater && withinRange) {
-            emitter.active = true;  // Other types (fountain, etc)
-        } else {
-            emitter.active = false;
-        }
+    // Update active state based on distance AND limits
+    bool withinRange = (distance < maxDist);
+
+    if (isFire && withinRange && activeFireCount < MAX_ACTIVE_FIRE) {
+        emitter.active = true;
+        activeFireCount++;
+    } else if (isWater && withinRange && activeWaterCount < MAX_ACTIVE_WATER) {
+        emitter.active = true;
+        activeWaterCount++;
+    } else if (!isFire && !isWater && withinRange) {
+        emitter.active = true;  // Other types (fountain, etc)
+    } else {
+        emitter.active = false;
+    }
 
-        if (!emitter.active) continue;
+    if (!emitter.active) return;
 
-        // Update play timer
-        emitter.lastPlayTime += deltaTime;
+    // Update play timer
+    emitter.lastPlayTime += deltaTime;
 
-        // Handle different emitter types
-        switch (emitter.type) {
-            case AmbientType::FIREPLACE_SMALL:
-                if (emitter.lastPlayTime >= FIRE_LOOP_INTERVAL && !fireSoundsSmall_.empty() && fireSoundsSmall_[0].loaded) {
-                    float volume = FIRE_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(fireSoundsSmall_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+    // Handle different emitter types
+    switch (emitter.type) {
+        case AmbientType::FIREPLACE_SMALL:
+            if (emitter.lastPlayTime >= FIRE_LOOP_INTERVAL && !fireSoundsSmall_.empty() && fireSoundsSmall_[0].loaded) {
+                float volume = FIRE_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(fireSoundsSmall_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            case AmbientType::FIREPLACE_LARGE:
-                if (emitter.lastPlayTime >= FIRE_LOOP_INTERVAL && !fireSoundsLarge_.empty() && fireSoundsLarge_[0].loaded) {
-                    float volume = FIRE_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(fireSoundsLarge_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+        case AmbientType::FIREPLACE_LARGE:
+            if (emitter.lastPlayTime >= FIRE_LOOP_INTERVAL && !fireSoundsLarge_.empty() && fireSoundsLarge_[0].loaded) {
+                float volume = FIRE_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(fireSoundsLarge_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            case AmbientType::TORCH:
-                if (emitter.lastPlayTime >= FIRE_LOOP_INTERVAL && !torchSounds_.empty() && torchSounds_[0].loaded) {
-                    float volume = FIRE_VOLUME * 0.7f * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(torchSounds_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+        case AmbientType::TORCH:
+            if (emitter.lastPlayTime >= FIRE_LOOP_INTERVAL && !torchSounds_.empty() && torchSounds_[0].loaded) {
+                float volume = FIRE_VOLUME * 0.7f * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(torchSounds_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            case AmbientType::WATER_SURFACE:
-                if (emitter.lastPlayTime >= 5.0f && !waterSounds_.empty() && waterSounds_[0].loaded) {
-                    float volume = WATER_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(waterSounds_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+        case AmbientType::WATER_SURFACE:
+            if (emitter.lastPlayTime >= 5.0f && !waterSounds_.empty() && waterSounds_[0].loaded) {
+                float volume = WATER_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(waterSounds_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            case AmbientType::RIVER:
-                if (emitter.lastPlayTime >= 5.0f && !riverSounds_.empty() && riverSounds_[0].loaded) {
-                    float volume = WATER_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(riverSounds_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+        case AmbientType::RIVER:
+            if (emitter.lastPlayTime >= 5.0f && !riverSounds_.empty() && riverSounds_[0].loaded) {
+                float volume = WATER_VOLUME * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(riverSounds_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            case AmbientType::WATERFALL:
-                if (emitter.lastPlayTime >= 4.0f && !waterfallSounds_.empty() && waterfallSounds_[0].loaded) {
-                    float volume = WATER_VOLUME * 1.2f * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(waterfallSounds_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+        case AmbientType::WATERFALL:
+            if (emitter.lastPlayTime >= 4.0f && !waterfallSounds_.empty() && waterfallSounds_[0].loaded) {
+                float volume = WATER_VOLUME * 1.2f * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(waterfallSounds_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            case AmbientType::FOUNTAIN:
-                if (emitter.lastPlayTime >= 6.0f && !fountainSounds_.empty() && fountainSounds_[0].loaded) {
-                    float volume = WATER_VOLUME * 0.8f * volumeScale_ * (1.0f - (distance / maxDist));
-                    AudioEngine::instance().playSound3D(fountainSounds_[0].data, emitter.position, volume);
-                    emitter.lastPlayTime = 0.0f;
-                }
-                break;
+        case AmbientType::FOUNTAIN:
+            if (emitter.lastPlayTime >= 6.0f && !fountainSounds_.empty() && fountainSounds_[0].loaded) {
+                float volume = WATER_VOLUME * 0.8f * volumeScale_ * (1.0f - (distance / maxDist));
+                playSample3D(fountainSounds_[0], emitter.position, volume);
+                emitter.lastPlayTime = 0.0f;
+            }
+            break;
 
-            default:
-                break;
-        }
+        default:
+            break;
     }
 }
 
@@ -447,7 +498,7 @@ void AmbientSoundManager::updateBlacksmithAmbience(float deltaTime) {
         // Play blacksmith ambience loop every 15 seconds
         if (blacksmithLoopTime_ >= 15.0f) {
             float volume = 0.6f * volumeScale_;  // Ambient loop volume
-            AudioEngine::instance().playSound2D(blacksmithSounds_[0].data, volume, 1.0f);
+            playSample2D(blacksmithSounds_[0], volume);
             LOG_INFO("Playing blacksmith ambience loop");
             blacksmithLoopTime_ = 0.0f;
         }
@@ -477,7 +528,7 @@ void AmbientSoundManager::updateWindAmbience(float deltaTime, bool isIndoor) {
             // Play every 15 seconds for ambient atmosphere
             if (windLoopTime_ >= 15.0f) {
                 float volume = 0.5f * volumeScale_;
-                AudioEngine::instance().playSound2D(tavernSounds_[0].data, volume, 1.0f);
+                playSample2D(tavernSounds_[0], volume);
                 LOG_INFO("Playing tavern ambience (glasses clinking)");
                 windLoopTime_ = 0.0f;
             }
@@ -489,7 +540,7 @@ void AmbientSoundManager::updateWindAmbience(float deltaTime, bool isIndoor) {
             windLoopTime_ += deltaTime;
             if (windLoopTime_ >= 30.0f) {
                 float volume = 0.3f * volumeScale_;
-                AudioEngine::instance().playSound2D(windSounds_[0].data, volume, 1.0f);
+                playSample2D(windSounds_[0], volume);
                 LOG_INFO("Playing outdoor ambience");
                 windLoopTime_ = 0.0f;
             }
@@ -497,7 +548,16 @@ void AmbientSoundManager::updateWindAmbience(float deltaTime, bool isIndoor) {
     }
 }
 
-uint64_t AmbientSoundManager::addEmitter(const glm::vec3& position, AmbientType type) {
+uint64_t AmbientSoundManager::packKey(int32_t a, int32_t b) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+}
+
+int32_t AmbientSoundManager::emitterCell(float v) {
+    if (!std::isfinite(v)) return 0;
+    return static_cast<int32_t>(std::floor(v / EMITTER_CELL_SIZE));
+}
+
+uint64_t AmbientSoundManager::insertEmitter(uint64_t tileKey, const glm::vec3& position, AmbientType type) {
     AmbientEmitter emitter;
     emitter.id = nextEmitterId_++;
     emitter.type = type;
@@ -506,20 +566,75 @@ uint64_t AmbientSoundManager::addEmitter(const glm::vec3& position, AmbientType
     emitter.lastPlayTime = randomFloat(0.0f, 2.0f);  // Random initial offset
     emitter.loopInterval = FIRE_LOOP_INTERVAL;
 
-    emitters_.push_back(emitter);
+    auto [tileIt, created] = emitterTiles_.try_emplace(tileKey);
+    EmitterTile& tile = tileIt->second;
+    if (created) {
+        tile.minX = tile.maxX = position.x;
+        tile.minY = tile.maxY = position.y;
+    } else {
+        tile.minX = std::min(tile.minX, position.x);
+        tile.minY = std::min(tile.minY, position.y);
+        tile.maxX = std::max(tile.maxX, position.x);
+        tile.maxY = std::max(tile.maxY, position.y);
+    }
+
+    const uint64_t cellKey = packKey(emitterCell(position.x), emitterCell(position.y));
+    auto& cell = tile.cells[cellKey];
+    emitterIndex_[emitter.id] = {tileKey, cellKey, static_cast<uint32_t>(cell.size())};
+    cell.push_back(emitter);
     return emitter.id;
 }
 
+uint64_t AmbientSoundManager::addEmitter(const glm::vec3& position, AmbientType type) {
+    // Emitters without an owning tile share one bucket
+    return insertEmitter(packKey(-1, -1), position, type);
+}
+
+uint64_t AmbientSoundManager::addTileEmitter(int tileX, int tileY, const glm::vec3& position, AmbientType type) {
+    return insertEmitter(packKey(tileX, tileY), position, type);
+}
+
+void AmbientSoundManager::eraseEmitterSlot(const EmitterLocation& loc) {
+    auto tileIt = emitterTiles_.find(loc.tile);
+    if (tileIt == emitterTiles_.end()) return;
+    auto cellIt = tileIt->second.cells.find(loc.cell);
+    if (cellIt == tileIt->second.cells.end()) return;
+
+    // Swap-remove and patch the moved emitter's slot
+    auto& cell = cellIt->second;
+    if (loc.slot + 1 < cell.size()) {
+        cell[loc.slot] = cell.back();
+        emitterIndex_[cell[loc.slot].id].slot = loc.slot;
+    }
+    cell.pop_back();
+    if (cell.empty()) {
+        tileIt->second.cells.erase(cellIt);
+        if (tileIt->second.cells.empty()) emitterTiles_.erase(tileIt);
+    }
+}
+
 void AmbientSoundManager::removeEmitter(uint64_t id) {
-    emitters_.erase(
-        std::remove_if(emitters_.begin(), emitters_.end(),
-            [id](const AmbientEmitter& e) { return e.id == id; }),
-        emitters_.end()
-    );
+    auto it = emitterIndex_.find(id);
+    if (it == emitterIndex_.end()) return;
+    const EmitterLocation loc = it->second;
+    emitterIndex_.erase(it);
+    eraseEmitterSlot(loc);
+}
+
+void AmbientSoundManager::removeTileEmitters(int tileX, int tileY) {
+    auto tileIt = emitterTiles_.find(packKey(tileX, tileY));
+    if (tileIt == emitterTiles_.end()) return;
+    for (const auto& [cellKey, cell] : tileIt->second.cells) {
+        for (const auto& emitter : cell) {
+            emitterIndex_.erase(emitter.id);
+        }
+    }
+    emitterTiles_.erase(tileIt);
 }
 
 void AmbientSoundManager::clearEmitters() {
-    emitters_.clear();
+    emitterTiles_.clear();
+    emitterIndex_.clear();
 }
 
 void AmbientSoundManager::setGameTime(float hours) {
@@ -606,7 +721,7 @@ void AmbientSoundManager::updateWeatherAmbience(float deltaTime, bool isIndoor)
     if (weatherLibrary && !weatherLibrary->empty() && (*weatherLibrary)[0].loaded) {
         if (weatherLoopTime_ >= loopInterval) {
             float volume = 0.4f * volumeScale_;  // Weather ambience at moderate volume
-            AudioEngine::instance().playSound2D((*weatherLibrary)[0].data, volume, 1.0f);
+            playSample2D((*weatherLibrary)[0], volume);
             LOG_INFO("Playing weather ambience: type ", static_cast<int>(currentWeather_));
             weatherLoopTime_ = 0.0f;
         }
@@ -630,7 +745,7 @@ void AmbientSoundManager::updateWaterAmbience(float deltaTime, bool isSwimming)
             // Play every 18 seconds for underwater ambience
             if (oceanLoopTime_ >= 18.0f) {
                 float volume = 0.5f * volumeScale_;
-                AudioEngine::instance().playSound2D(underwaterSounds_[0].data, volume, 1.0f);
+                playSample2D(underwaterSounds_[0], volume);
                 LOG_INFO("Playing underwater ambience");
                 oceanLoopTime_ = 0.0f;
             }
@@ -684,7 +799,7 @@ void AmbientSoundManager::updateZoneAmbience(float deltaTime, bool isIndoor) {
         // Play every 30 seconds for zone ambience (longer intervals for background atmosphere)
         if (zoneLoopTime_ >= 30.0f) {
             float volume = 0.35f * volumeScale_;  // Zone ambience at moderate-low volume
-            AudioEngine::instance().playSound2D((*zoneLibrary)[0].data, volume, 1.0f);
+            playSample2D((*zoneLibrary)[0], volume);
             LOG_INFO("Playing zone ambience: type ", static_cast<int>(currentZone_),
                      " (", isDay ? "day" : "night", ")");
             zoneLoopTime_ = 0.0f;
@@ -730,7 +845,7 @@ void AmbientSoundManager::updateCityAmbience(float deltaTime) {
         // Play every 20 seconds for city ambience (moderate intervals for urban atmosphere)
         if (cityLoopTime_ >= 20.0f) {
             float volume = 0.4f * volumeScale_;  // City ambience at moderate volume
-            AudioEngine::instance().playSound2D((*cityLibrary)[0].data, volume, 1.0f);
+            playSample2D((*cityLibrary)[0], volume);
             LOG_INFO("Playing city ambience: type ", static_cast<int>(currentCity_),
                      " (", isDay ? "day" : "night", ")");
             cityLoopTime_ = 0.0f;
@@ -798,7 +913,7 @@ void AmbientSoundManager::updateBellTolls(float deltaTime) {
 
         if (bellTollDelay_ >= 1.5f) {
             float volume = 0.6f * volumeScale_;  // Bell tolls at moderate-high volume
-            AudioEngine::instance().playSound2D((*bellLibrary)[0].data, volume, 1.0f);
+            playSample2D((*bellLibrary)[0], volume);
             remainingTolls_--;
             bellTollDelay_ = 0.0f;
 
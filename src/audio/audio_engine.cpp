@@ -7,6 +7,7 @@
 #include "../../extern/miniaudio.h"
 
 #include <cstring>
+#include <list>
 #include <memory>
 #include <unordered_map>
 
@@ -23,7 +24,80 @@ struct DecodedWavCacheEntry {
     std::shared_ptr<std::vector<uint8_t>> pcmData;
 };
 
-static std::unordered_map<uint64_t, DecodedWavCacheEntry> gDecodedWavCache;
+// Decoded one-shot PCM, evicted least-recently-used to stay under a byte
+// budget. Voices hold their own reference, so evicting an entry never cuts
+// off a sound that is still playing.
+struct DecodedWavCache {
+    struct Slot {
+        DecodedWavCacheEntry entry;
+        std::list<uint64_t>::iterator lruIt;
+    };
+    std::unordered_map<uint64_t, Slot> slots;
+    std::list<uint64_t> lru;  // Front = most recently used
+    size_t bytes = 0;
+    size_t budget = 32 * 1024 * 1024;
+
+    bool find(uint64_t key, DecodedWavCacheEntry& out) {
+        auto it = slots.find(key);
+        if (it == slots.end()) return false;
+        lru.splice(lru.begin(), lru, it->second.lruIt);
+        out = it->second.entry;
+        return true;
+    }
+
+    void evictTo(size_t limit) {
+        while (bytes > limit && !lru.empty()) {
+            auto it = slots.find(lru.back());
+            bytes -= it->second.entry.pcmData->size();
+            slots.erase(it);
+            lru.pop_back();
+        }
+    }
+
+    void insert(uint64_t key, const DecodedWavCacheEntry& entry) {
+        const size_t size = entry.pcmData->size();
+        // One clip may not take more than a quarter of the budget; larger
+        // ones play uncached (and should be streamed by the caller instead).
+        if (size > budget / 4) return;
+        evictTo(budget - size);
+        lru.push_front(key);
+        slots.emplace(key, Slot{entry, lru.begin()});
+        bytes += size;
+    }
+};
+
+static DecodedWavCache gDecodedWavCache;
+
+// Format and length of files played through playStream*(), probed once per path
+static std::unordered_map<std::string, PcmClip> gStreamInfoCache;
+
+static bool probeStream(const std::string& filePath, PcmClip& out) {
+    if (auto it = gStreamInfoCache.find(filePath); it != gStreamInfoCache.end()) {
+        out = it->second;
+        return out.frames > 0;
+    }
+
+    PcmClip info;
+    ma_decoder decoder;
+    ma_decoder_config decoderConfig = ma_decoder_config_init_default();
+    if (ma_decoder_init_file(filePath.c_str(), &decoderConfig, &decoder) == MA_SUCCESS) {
+        ma_uint64 frames = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&decoder, &frames) == MA_SUCCESS) {
+            info.format = static_cast<uint32_t>(decoder.outputFormat);
+            info.channels = decoder.outputChannels;
+            info.sampleRate = decoder.outputSampleRate;
+            info.frames = frames;
+        }
+        ma_decoder_uninit(&decoder);
+    }
+    if (info.frames == 0) {
+        LOG_WARNING("AudioEngine: cannot stream '", filePath, "'");
+    }
+    // Failures are cached too so a missing file is not re-opened every play
+    gStreamInfoCache.emplace(filePath, info);
+    out = info;
+    return info.frames > 0;
+}
 
 static uint64_t makeWavCacheKey(const std::vector<uint8_t>& wavData) {
     // FNV-1a over the first 256 bytes + last 256 bytes + total size.
@@ -51,8 +125,7 @@ static bool decodeWavCached(const std::vector<uint8_t>& wavData, DecodedWavCache
     if (wavData.empty()) return false;
 
     const uint64_t key = makeWavCacheKey(wavData);
-    if (auto it = gDecodedWavCache.find(key); it != gDecodedWavCache.end()) {
-        out = it->second;
+    if (gDecodedWavCache.find(key, out)) {
         return true;
     }
 
@@ -97,13 +170,7 @@ static bool decodeWavCached(const std::vector<uint8_t>& wavData, DecodedWavCache
     entry.sampleRate = sampleRate;
     entry.frames = framesRead;
     entry.pcmData = pcmData;
-    // Evict oldest half when cache grows too large (keeps ~128 most-recent sounds)
-    if (gDecodedWavCache.size() >= 256) {
-        auto it = gDecodedWavCache.begin();
-        for (size_t n = gDecodedWavCache.size() / 2; n > 0; --n, ++it) {}
-        gDecodedWavCache.erase(gDecodedWavCache.begin(), it);
-    }
-    gDecodedWavCache.emplace(key, entry);
+    gDecodedWavCache.insert(key, entry);
     out = entry;
     return true;
 }
@@ -164,8 +231,12 @@ bool AudioEngine::initialize() {
         default: break;
     }
 
+    voicePool_ = std::make_unique<VoicePool>(engine_);
+    voicePool_->setListenerPosition(listenerPosition_);
+
     initialized_ = true;
-    LOG_INFO("AudioEngine initialized (miniaudio, backend: ", backendName, ")");
+    LOG_INFO("AudioEngine initialized (miniaudio, backend: ", backendName, ", ",
+             VoicePool::MAX_VOICES, " voices)");
     return true;
 }
 
@@ -177,15 +248,8 @@ void AudioEngine::shutdown() {
     // Stop music
     stopMusic();
 
-    // Clean up all active sounds
-    for (auto& activeSound : activeSounds_) {
-        ma_sound_uninit(activeSound.sound);
-        delete activeSound.sound;
-        ma_audio_buffer* buffer = static_cast<ma_audio_buffer*>(activeSound.buffer);
-        ma_audio_buffer_uninit(buffer);
-        delete buffer;
-    }
-    activeSounds_.clear();
+    // Voices must be released before the engine they are attached to
+    voicePool_.reset();
 
     if (engine_) {
         ma_engine_uninit(engine_);
@@ -206,6 +270,9 @@ void AudioEngine::setMasterVolume(float volume) {
 
 void AudioEngine::setListenerPosition(const glm::vec3& position) {
     listenerPosition_ = position;
+    if (voicePool_) {
+        voicePool_->setListenerPosition(position);
+    }
     if (engine_) {
         ma_engine_listener_set_position(engine_, 0, position.x, position.y, position.z);
     }
@@ -220,173 +287,156 @@ void AudioEngine::setListenerOrientation(const glm::vec3& forward, const glm::ve
     }
 }
 
-bool AudioEngine::playSound2D(const std::vector<uint8_t>& wavData, float volume, float pitch) {
-    (void)pitch;
-    if (!initialized_ || !engine_ || wavData.empty()) return false;
+bool AudioEngine::playDecoded(const std::vector<uint8_t>& wavData, VoiceRequest& request) {
+    if (!initialized_ || !engine_ || !voicePool_ || wavData.empty()) return false;
 
     DecodedWavCacheEntry decoded;
     if (!decodeWavCached(wavData, decoded) || !decoded.pcmData || decoded.frames == 0) {
         return false;
     }
 
-    // Create audio buffer from decoded PCM data (heap allocated to keep alive)
-    ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(
-        decoded.format,
-        decoded.channels,
-        decoded.frames,
-        decoded.pcmData->data(),
-        nullptr  // No custom allocator
-    );
-    bufferConfig.sampleRate = decoded.sampleRate;  // Critical: preserve original sample rate!
+    // Decoded PCM is shared across plays; the voice holds a reference while mixing
+    request.clip.format = static_cast<uint32_t>(decoded.format);
+    request.clip.channels = decoded.channels;
+    request.clip.sampleRate = decoded.sampleRate;
+    request.clip.frames = decoded.frames;
+    request.clip.data = decoded.pcmData;
+    return voicePool_->play(request);
+}
 
-    ma_audio_buffer* audioBuffer = new ma_audio_buffer();
-    ma_result result = ma_audio_buffer_init(&bufferConfig, audioBuffer);
-    if (result != MA_SUCCESS) {
-        LOG_WARNING("Failed to create audio buffer: ", result);
-        delete audioBuffer;
-        return false;
-    }
+bool AudioEngine::playSound2D(const std::vector<uint8_t>& wavData, float volume, float pitch,
+                              SoundCategory category) {
+    (void)pitch;  // 2D voices are created with NO_PITCH
 
-    // Create sound from audio buffer
-    ma_sound* sound = new ma_sound();
-    result = ma_sound_init_from_data_source(
-        engine_,
-        audioBuffer,
-        MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC | MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION,
-        nullptr,
-        sound
-    );
+    VoiceRequest request;
+    request.category = category;
+    request.volume = volume * masterVolume_;
+    return playDecoded(wavData, request);
+}
 
-    if (result != MA_SUCCESS) {
-        LOG_WARNING("Failed to create sound: ", result);
-        ma_audio_buffer_uninit(audioBuffer);
-        delete audioBuffer;
-        delete sound;
+bool AudioEngine::playSound2D(const std::string& mpqPath, float volume, float pitch,
+                              SoundCategory category) {
+    if (!assetManager_) {
+        LOG_WARNING("AudioEngine::playSound2D(path): no AssetManager set");
         return false;
     }
-
-    // Set volume (pitch not supported with NO_PITCH flag)
-    ma_sound_set_volume(sound, volume * masterVolume_);
-
-    // Start playback
-    result = ma_sound_start(sound);
-    if (result != MA_SUCCESS) {
-        LOG_WARNING("Failed to start sound: ", result);
-        ma_sound_uninit(sound);
-        ma_audio_buffer_uninit(audioBuffer);
-        delete audioBuffer;
-        delete sound;
+    auto data = assetManager_->readFile(mpqPath);
+    if (data.empty()) {
+        LOG_WARNING("AudioEngine::playSound2D: failed to load '", mpqPath, "'");
         return false;
     }
+    return playSound2D(data, volume, pitch, category);
+}
 
-    // Track this sound for cleanup (decoded PCM shared across plays)
-    activeSounds_.push_back({sound, audioBuffer, decoded.pcmData});
-
-    return true;
+bool AudioEngine::playSound3D(const std::vector<uint8_t>& wavData, const glm::vec3& position,
+                              float volume, float pitch, float maxDistance, SoundCategory category) {
+    VoiceRequest request;
+    request.category = category;
+    request.volume = volume * masterVolume_;
+    request.pitch = pitch;
+    request.positional = true;
+    request.position = position;
+    request.maxDistance = maxDistance;
+    return playDecoded(wavData, request);
 }
 
-bool AudioEngine::playSound2D(const std::string& mpqPath, float volume, float pitch) {
+bool AudioEngine::playSound3D(const std::string& mpqPath, const glm::vec3& position,
+                              float volume, float pitch, float maxDistance, SoundCategory category) {
     if (!assetManager_) {
-        LOG_WARNING("AudioEngine::playSound2D(path): no AssetManager set");
+        LOG_WARNING("AudioEngine::playSound3D(path): no AssetManager set");
         return false;
     }
     auto data = assetManager_->readFile(mpqPath);
     if (data.empty()) {
-        LOG_WARNING("AudioEngine::playSound2D: failed to load '", mpqPath, "'");
+        LOG_WARNING("AudioEngine::playSound3D: failed to load '", mpqPath, "'");
         return false;
     }
-    return playSound2D(data, volume, pitch);
+    return playSound3D(data, position, volume, pitch, maxDistance, category);
 }
 
-bool AudioEngine::playSound3D(const std::vector<uint8_t>& wavData, const glm::vec3& position,
-                              float volume, float pitch, float maxDistance) {
-    if (!initialized_ || !engine_ || wavData.empty()) return false;
+bool AudioEngine::playStream2D(const std::string& filePath, float volume, SoundCategory category) {
+    if (!initialized_ || !engine_ || !voicePool_ || filePath.empty()) return false;
 
-    DecodedWavCacheEntry decoded;
-    if (!decodeWavCached(wavData, decoded) || !decoded.pcmData || decoded.frames == 0) {
-        return false;
-    }
+    VoiceRequest request;
+    if (!probeStream(filePath, request.clip)) return false;
+    request.streamPath = filePath;
+    request.category = category;
+    request.volume = volume * masterVolume_;
+    return voicePool_->play(request);
+}
 
-    LOG_DEBUG("playSound3D: cached WAV - format:", decoded.format,
-              " channels:", decoded.channels, " sampleRate:", decoded.sampleRate,
-              " pitch:", pitch);
+bool AudioEngine::playStream3D(const std::string& filePath, const glm::vec3& position,
+                               float volume, float pitch, float maxDistance, SoundCategory category) {
+    if (!initialized_ || !engine_ || !voicePool_ || filePath.empty()) return false;
+
+    VoiceRequest request;
+    if (!probeStream(filePath, request.clip)) return false;
+    request.streamPath = filePath;
+    request.category = category;
+    request.volume = volume * masterVolume_;
+    request.pitch = pitch;
+    request.positional = true;
+    request.position = position;
+    request.maxDistance = maxDistance;
+    return voicePool_->play(request);
+}
 
-    // Create audio buffer with correct sample rate
-    ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(
-        decoded.format,
-        decoded.channels,
-        decoded.frames,
-        decoded.pcmData->data(),
-        nullptr
-    );
-    bufferConfig.sampleRate = decoded.sampleRate;  // Critical: preserve original sample rate!
+void AudioEngine::setSfxCacheBudget(size_t bytes) {
+    gDecodedWavCache.budget = bytes;
+    gDecodedWavCache.evictTo(bytes);
+}
 
-    ma_audio_buffer* audioBuffer = new ma_audio_buffer();
-    ma_result result = ma_audio_buffer_init(&bufferConfig, audioBuffer);
-    if (result != MA_SUCCESS) {
-        delete audioBuffer;
+size_t AudioEngine::getSfxCacheBudget() const {
+    return gDecodedWavCache.budget;
+}
+
+size_t AudioEngine::getSfxCacheBytes() const {
+    return gDecodedWavCache.bytes;
+}
+
+bool AudioEngine::playMusicFile(const std::string& filePath, float volume, bool loop) {
+    if (!initialized_ || !engine_ || filePath.empty()) {
         return false;
     }
 
-    // Create 3D sound (spatialization enabled, pitch enabled)
-    ma_sound* sound = new ma_sound();
-    result = ma_sound_init_from_data_source(
+    stopMusic();
+    musicVolume_ = volume;
+
+    // Stream from disk: the resource manager decodes a few seconds ahead on
+    // its job thread instead of holding the whole encoded file in memory.
+    musicSound_ = new ma_sound();
+    ma_result result = ma_sound_init_from_file(
         engine_,
-        audioBuffer,
-        MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC,  // Removed NO_PITCH flag
+        filePath.c_str(),
+        MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION,
+        nullptr,
         nullptr,
-        sound
+        musicSound_
     );
-
     if (result != MA_SUCCESS) {
-        LOG_WARNING("playSound3D: Failed to create sound, error: ", result);
-        ma_audio_buffer_uninit(audioBuffer);
-        delete audioBuffer;
-        delete sound;
+        LOG_ERROR("Failed to open music stream '", filePath, "': ", result);
+        delete musicSound_;
+        musicSound_ = nullptr;
         return false;
     }
 
-    // Set 3D position and attenuation
-    ma_sound_set_position(sound, position.x, position.y, position.z);
-    ma_sound_set_volume(sound, volume * masterVolume_);
-    ma_sound_set_pitch(sound, pitch);  // Enable pitch variation
-    ma_sound_set_attenuation_model(sound, ma_attenuation_model_inverse);
-    ma_sound_set_min_gain(sound, 0.0f);
-    ma_sound_set_max_gain(sound, 1.0f);
-    ma_sound_set_min_distance(sound, 1.0f);
-    ma_sound_set_max_distance(sound, maxDistance);
-    ma_sound_set_rolloff(sound, 1.0f);
+    ma_sound_set_volume(musicSound_, volume * masterVolume_);
+    ma_sound_set_looping(musicSound_, loop ? MA_TRUE : MA_FALSE);
 
-    result = ma_sound_start(sound);
+    result = ma_sound_start(musicSound_);
     if (result != MA_SUCCESS) {
-        ma_sound_uninit(sound);
-        ma_audio_buffer_uninit(audioBuffer);
-        delete audioBuffer;
-        delete sound;
+        LOG_ERROR("Failed to start music stream: ", result);
+        ma_sound_uninit(musicSound_);
+        delete musicSound_;
+        musicSound_ = nullptr;
         return false;
     }
 
-    // Track for cleanup
-    activeSounds_.push_back({sound, audioBuffer, decoded.pcmData});
-
+    LOG_INFO("Music streaming from ", filePath, " - volume: ", volume, ", loop: ", loop);
     return true;
 }
 
-bool AudioEngine::playSound3D(const std::string& mpqPath, const glm::vec3& position,
-                              float volume, float pitch, float maxDistance) {
-    if (!assetManager_) {
-        LOG_WARNING("AudioEngine::playSound3D(path): no AssetManager set");
-        return false;
-    }
-    auto data = assetManager_->readFile(mpqPath);
-    if (data.empty()) {
-        LOG_WARNING("AudioEngine::playSound3D: failed to load '", mpqPath, "'");
-        return false;
-    }
-    return playSound3D(data, position, volume, pitch, maxDistance);
-}
-
-bool AudioEngine::playMusic(const std::vector<uint8_t>& musicData, float volume, bool loop) {
+bool AudioEngine::playMusic(std::vector<uint8_t> musicData, float volume, bool loop) {
     if (!initialized_ || !engine_ || musicData.empty()) {
         return false;
     }
@@ -396,8 +446,8 @@ bool AudioEngine::playMusic(const std::vector<uint8_t>& musicData, float volume,
     // Stop any currently playing music
     stopMusic();
 
-    // Keep the music data alive
-    musicData_ = musicData;
+    // Keep the encoded music data alive while the decoder streams from it
+    musicData_ = std::move(musicData);
     musicVolume_ = volume;
 
     // Create decoder from memory (for streaming MP3/OGG)
@@ -496,26 +546,12 @@ void AudioEngine::setMusicVolume(float volume) {
 }
 
 void AudioEngine::update(float deltaTime) {
-    (void)deltaTime;
-
-    if (!initialized_ || !engine_) {
+    if (!initialized_ || !engine_ || !voicePool_) {
         return;
     }
 
-    // Clean up finished sounds
-    for (auto it = activeSounds_.begin(); it != activeSounds_.end(); ) {
-        if (!ma_sound_is_playing(it->sound)) {
-            // Sound finished, clean up
-            ma_sound_uninit(it->sound);
-            delete it->sound;
-            ma_audio_buffer* buffer = static_cast<ma_audio_buffer*>(it->buffer);
-            ma_audio_buffer_uninit(buffer);
-            delete buffer;
-            it = activeSounds_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // Reap finished voices, cull inaudible ones and resume virtual voices
+    voicePool_->update(deltaTime);
 }
 
 } // namespace audio
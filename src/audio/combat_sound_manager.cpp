@@ -231,7 +231,7 @@ void CombatSoundManager::playSound(const std::vector<CombatSample>& library, flo
     if (!initialized_ || library.empty() || !library[0].loaded) return;
 
     float volume = 0.8f * volumeScale_ * volumeMultiplier;
-    AudioEngine::instance().playSound2D(library[0].data, volume, 1.0f);
+    AudioEngine::instance().playSound2D(library[0].data, volume, 1.0f, SoundCategory::COMBAT);
 }
 
 void CombatSoundManager::playRandomSound(const std::vector<CombatSample>& library, float volumeMultiplier) {
@@ -252,7 +252,7 @@ void CombatSoundManager::playRandomSound(const std::vector<CombatSample>& librar
     size_t index = dist(gen);
 
     float volume = 0.8f * volumeScale_ * volumeMultiplier;
-    AudioEngine::instance().playSound2D(loadedSounds[index]->data, volume, 1.0f);
+    AudioEngine::instance().playSound2D(loadedSounds[index]->data, volume, 1.0f, SoundCategory::COMBAT);
 }
 
 void CombatSoundManager::setVolumeScale(float scale) {
@@ -143,7 +143,7 @@ bool FootstepManager::playRandomStep(FootstepSurface surface, bool sprinting) {
     if (volume < 0.1f) volume = 0.1f;
 
     // Play using AudioEngine (non-blocking, no process spawn!)
-    bool success = AudioEngine::instance().playSound2D(sample.data, volume, pitch);
+    bool success = AudioEngine::instance().playSound2D(sample.data, volume, pitch, SoundCategory::FOOTSTEP);
 
     if (success) {
         lastPlayTime = now;
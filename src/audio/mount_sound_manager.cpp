@@ -404,7 +404,7 @@ void MountSoundManager::playRearUpSound() {
             std::uniform_int_distribution<size_t> dist(0, sounds.move.size() - 1);
             const auto& sample = sounds.move[dist(rng)];
             if (!sample.data.empty()) {
-                AudioEngine::instance().playSound2D(sample.data, 0.7f * volumeScale_, 1.0f);
+                AudioEngine::instance().playSound2D(sample.data, 0.7f * volumeScale_, 1.0f, SoundCategory::MOUNT);
             }
         }
     } else if (currentMountType_ == MountType::FLYING && !wingIdleSounds_.empty()) {
@@ -412,7 +412,7 @@ void MountSoundManager::playRearUpSound() {
         std::uniform_int_distribution<size_t> dist(0, wingIdleSounds_.size() - 1);
         const auto& sample = wingIdleSounds_[dist(rng)];
         if (!sample.data.empty()) {
-            AudioEngine::instance().playSound2D(sample.data, 0.6f * volumeScale_, 1.1f);
+            AudioEngine::instance().playSound2D(sample.data, 0.6f * volumeScale_, 1.1f, SoundCategory::MOUNT);
         }
     }
 }
@@ -432,7 +432,7 @@ void MountSoundManager::playJumpSound() {
             std::uniform_int_distribution<size_t> dist(0, sounds.jump.size() - 1);
             const auto& sample = sounds.jump[dist(rng)];
             if (!sample.data.empty()) {
-                AudioEngine::instance().playSound2D(sample.data, 0.5f * volumeScale_, 1.1f);
+                AudioEngine::instance().playSound2D(sample.data, 0.5f * volumeScale_, 1.1f, SoundCategory::MOUNT);
             }
         }
     } else if (currentMountType_ == MountType::FLYING && !wingFlapSounds_.empty()) {
@@ -440,7 +440,7 @@ void MountSoundManager::playJumpSound() {
         std::uniform_int_distribution<size_t> dist(0, wingFlapSounds_.size() - 1);
         const auto& sample = wingFlapSounds_[dist(rng)];
         if (!sample.data.empty()) {
-            AudioEngine::instance().playSound2D(sample.data, 0.4f * volumeScale_, 1.0f);
+            AudioEngine::instance().playSound2D(sample.data, 0.4f * volumeScale_, 1.0f, SoundCategory::MOUNT);
         }
     }
 }
@@ -460,7 +460,7 @@ void MountSoundManager::playLandSound() {
             std::uniform_int_distribution<size_t> dist(0, sounds.land.size() - 1);
             const auto& sample = sounds.land[dist(rng)];
             if (!sample.data.empty()) {
-                AudioEngine::instance().playSound2D(sample.data, 0.6f * volumeScale_, 0.85f);
+                AudioEngine::instance().playSound2D(sample.data, 0.6f * volumeScale_, 0.85f, SoundCategory::MOUNT);
             }
         }
     }
@@ -476,7 +476,7 @@ void MountSoundManager::playIdleSound() {
             std::uniform_int_distribution<size_t> dist(0, sounds.idle.size() - 1);
             const auto& sample = sounds.idle[dist(rng)];
             if (!sample.data.empty()) {
-                AudioEngine::instance().playSound2D(sample.data, 0.35f * volumeScale_, 0.95f);
+                AudioEngine::instance().playSound2D(sample.data, 0.35f * volumeScale_, 0.95f, SoundCategory::MOUNT);
             }
         }
     }
@@ -619,7 +619,7 @@ void MountSoundManager::updateMountSounds() {
                 std::uniform_real_distribution<float> volumeDist(0.4f, 0.5f);
                 std::uniform_real_distribution<float> pitchDist(0.95f, 1.05f);
                 AudioEngine::instance().playSound2D(
-                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng));
+                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng), SoundCategory::MOUNT);
                 soundLoopTimer_ = 0.0f;
                 playingMovementSound_ = true;
             }
@@ -630,7 +630,7 @@ void MountSoundManager::updateMountSounds() {
                 std::uniform_real_distribution<float> volumeDist(0.3f, 0.4f);
                 std::uniform_real_distribution<float> pitchDist(0.98f, 1.02f);
                 AudioEngine::instance().playSound2D(
-                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng));
+                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng), SoundCategory::MOUNT);
                 soundLoopTimer_ = 0.0f;
                 playingIdleSound_ = true;
             }
@@ -646,7 +646,7 @@ void MountSoundManager::updateMountSounds() {
                 std::uniform_real_distribution<float> volumeDist(0.35f, 0.45f);
                 std::uniform_real_distribution<float> pitchDist(0.97f, 1.03f);
                 AudioEngine::instance().playSound2D(
-                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng));
+                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng), SoundCategory::MOUNT);
                 soundLoopTimer_ = 0.0f;
                 playingMovementSound_ = true;
             }
@@ -657,7 +657,7 @@ void MountSoundManager::updateMountSounds() {
                 std::uniform_real_distribution<float> volumeDist(0.25f, 0.35f);
                 std::uniform_real_distribution<float> pitchDist(0.98f, 1.02f);
                 AudioEngine::instance().playSound2D(
-                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng));
+                    sample.data, volumeDist(rng) * volumeScale_, pitchDist(rng), SoundCategory::MOUNT);
                 soundLoopTimer_ = 0.0f;
                 playingIdleSound_ = true;
             }
@@ -186,7 +186,7 @@ void MovementSoundManager::playSound(const std::vector<MovementSample>& library,
     if (!initialized_ || library.empty() || !library[0].loaded) return;
 
     float volume = 0.7f * volumeScale_ * volumeMultiplier;
-    AudioEngine::instance().playSound2D(library[0].data, volume, 1.0f);
+    AudioEngine::instance().playSound2D(library[0].data, volume, 1.0f, SoundCategory::MOVEMENT);
 }
 
 void MovementSoundManager::playRandomSound(const std::vector<MovementSample>& library, float volumeMultiplier) {
@@ -207,7 +207,7 @@ void MovementSoundManager::playRandomSound(const std::vector<MovementSample>& li
     size_t index = dist(gen);
 
     float volume = 0.7f * volumeScale_ * volumeMultiplier;
-    AudioEngine::instance().playSound2D(loadedSounds[index]->data, volume, 1.0f);
+    AudioEngine::instance().playSound2D(loadedSounds[index]->data, volume, 1.0f, SoundCategory::MOVEMENT);
 }
 
 void MovementSoundManager::setVolumeScale(float scale) {
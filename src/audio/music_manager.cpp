@@ -3,7 +3,6 @@
 #include "pipeline/asset_manager.hpp"
 #include "core/logger.hpp"
 #include <filesystem>
-#include <fstream>
 
 namespace wowee {
 namespace audio {
@@ -24,17 +23,21 @@ void MusicManager::shutdown() {
     AudioEngine::instance().stopMusic();
     playing = false;
     currentTrack.clear();
-    musicDataCache_.clear();
+    musicPathCache_.clear();
+}
+
+const std::string& MusicManager::resolveMusicPath(const std::string& mpqPath) {
+    auto it = musicPathCache_.find(mpqPath);
+    if (it == musicPathCache_.end()) {
+        it = musicPathCache_.emplace(mpqPath, assetManager->resolveFilesystemPath(mpqPath)).first;
+    }
+    return it->second;
 }
 
 void MusicManager::preloadMusic(const std::string& mpqPath) {
+    // Music streams from disk, so preloading only resolves the file location
     if (!assetManager || mpqPath.empty()) return;
-    if (musicDataCache_.find(mpqPath) != musicDataCache_.end()) return;
-
-    auto data = assetManager->readFile(mpqPath);
-    if (!data.empty()) {
-        musicDataCache_[mpqPath] = std::move(data);
-    }
+    resolveMusicPath(mpqPath);
 }
 
 void MusicManager::playMusic(const std::string& mpqPath, bool loop) {
@@ -47,20 +50,22 @@ void MusicManager::playMusic(const std::string& mpqPath, bool loop) {
         return;
     }
 
-    // Read music file from cache or MPQ
-    auto cacheIt = musicDataCache_.find(mpqPath);
-    if (cacheIt == musicDataCache_.end()) {
-        preloadMusic(mpqPath);
-        cacheIt = musicDataCache_.find(mpqPath);
-    }
-    if (cacheIt == musicDataCache_.end() || cacheIt->second.empty()) {
-        LOG_WARNING("Music: Could not read: ", mpqPath);
-        return;
-    }
-
-    // Play with AudioEngine (non-blocking, streams from memory)
+    // Stream loose files from disk; anything else is read once and kept
+    // only while it plays
     float volume = volumePercent / 100.0f;
-    if (AudioEngine::instance().playMusic(cacheIt->second, volume, loop)) {
+    bool started = false;
+    const std::string& filePath = resolveMusicPath(mpqPath);
+    if (!filePath.empty()) {
+        started = AudioEngine::instance().playMusicFile(filePath, volume, loop);
+    } else {
+        auto data = assetManager->readFile(mpqPath);
+        if (data.empty()) {
+            LOG_WARNING("Music: Could not read: ", mpqPath);
+            return;
+        }
+        started = AudioEngine::instance().playMusic(std::move(data), volume, loop);
+    }
+    if (started) {
         playing = true;
         currentTrack = mpqPath;
         currentTrackIsFile = false;
@@ -84,25 +89,9 @@ void MusicManager::playFilePath(const std::string& filePath, bool loop) {
         return;
     }
 
-    // Read file into memory
-    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
-    if (!file) {
-        LOG_ERROR("Music: Could not open file: ", filePath);
-        return;
-    }
-
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<uint8_t> data(static_cast<size_t>(size));
-    if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
-        LOG_ERROR("Music: Could not read file: ", filePath);
-        return;
-    }
-
-    // Play with AudioEngine
+    // Stream with AudioEngine (decoded from disk as it plays)
     float volume = volumePercent / 100.0f;
-    if (AudioEngine::instance().playMusic(data, volume, loop)) {
+    if (AudioEngine::instance().playMusicFile(filePath, volume, loop)) {
         playing = true;
         currentTrack = filePath;
         currentTrackIsFile = true;
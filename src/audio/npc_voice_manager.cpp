@@ -320,7 +320,8 @@ void NpcVoiceManager::playSound(uint64_t npcGuid, VoiceType voiceType, SoundCate
         position,
         1.0f * volumeScale_,
         pitchDist(rng_),
-        60.0f
+        60.0f,
+        audio::SoundCategory::VOICE
     );
 
     if (success) {
@@ -155,7 +155,7 @@ void SpellSoundManager::playSound(const std::vector<SpellSample>& library, float
     if (!initialized_ || library.empty() || !library[0].loaded) return;
 
     float volume = 0.75f * volumeScale_ * volumeMultiplier;
-    AudioEngine::instance().playSound2D(library[0].data, volume, 1.0f);
+    AudioEngine::instance().playSound2D(library[0].data, volume, 1.0f, SoundCategory::SPELL);
 }
 
 void SpellSoundManager::playRandomSound(const std::vector<SpellSample>& library, float volumeMultiplier) {
@@ -176,7 +176,7 @@ void SpellSoundManager::playRandomSound(const std::vector<SpellSample>& library,
     size_t index = dist(gen);
 
     float volume = 0.75f * volumeScale_ * volumeMultiplier;
-    AudioEngine::instance().playSound2D(loadedSounds[index]->data, volume, 1.0f);
+    AudioEngine::instance().playSound2D(loadedSounds[index]->data, volume, 1.0f, SoundCategory::SPELL);
 }
 
 void SpellSoundManager::setVolumeScale(float scale) {
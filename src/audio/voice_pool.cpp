@@ -0,0 +1,347 @@
+#include "audio/voice_pool.hpp"
+#include "core/logger.hpp"
+
+#include "../../extern/miniaudio.h"
+
+#include <algorithm>
+
+namespace wowee {
+namespace audio {
+
+namespace {
+
+// Below this estimated gain a sound is not worth a mixer voice
+constexpr float kAudibleThreshold = 0.005f;
+// Virtual voices with less than this much clip left are dropped instead
+constexpr float kMinVirtualSeconds = 0.25f;
+
+constexpr size_t kCategoryCount = static_cast<size_t>(SoundCategory::COUNT);
+
+// Indexed by SoundCategory
+constexpr float kCategoryPriority[kCategoryCount] = {
+    8.0f,   // UI
+    6.0f,   // VOICE
+    5.0f,   // SPELL
+    4.0f,   // COMBAT
+    2.0f,   // FOOTSTEP
+    2.0f,   // MOVEMENT
+    3.0f,   // MOUNT
+    1.0f,   // AMBIENT
+    3.0f,   // EFFECT
+};
+
+constexpr uint32_t kDefaultCategoryLimit[kCategoryCount] = {
+    8,      // UI
+    4,      // VOICE
+    12,     // SPELL
+    12,     // COMBAT
+    6,      // FOOTSTEP
+    6,      // MOVEMENT
+    4,      // MOUNT
+    16,     // AMBIENT
+    12,     // EFFECT
+};
+
+float playbackRate(const VoiceRequest& request) {
+    return request.positional ? std::max(request.pitch, 0.01f) : 1.0f;
+}
+
+} // namespace
+
+struct VoicePool::Voice {
+    ma_audio_buffer buffer;     // Unused for streamed voices
+    ma_sound sound;
+    bool streaming = false;
+    VoiceRequest request;
+    float elapsed = 0.0f;
+    float score = 0.0f;
+};
+
+VoicePool::VoicePool(ma_engine* engine)
+    : engine_(engine), voices_(new Voice[MAX_VOICES]()) {
+    freeVoices_.reserve(MAX_VOICES);
+    busyVoices_.reserve(MAX_VOICES);
+    virtualVoices_.reserve(MAX_VIRTUAL_VOICES);
+    // Hand out low indices first
+    for (uint32_t i = MAX_VOICES; i > 0; i--) {
+        freeVoices_.push_back(i - 1);
+    }
+    for (size_t c = 0; c < kCategoryCount; c++) {
+        categoryLimits_[c] = kDefaultCategoryLimit[c];
+    }
+}
+
+VoicePool::~VoicePool() {
+    stopAll();
+}
+
+void VoicePool::setCategoryLimit(SoundCategory category, uint32_t limit) {
+    categoryLimits_[static_cast<size_t>(category)] = std::min(limit, MAX_VOICES);
+}
+
+float VoicePool::audibility(const VoiceRequest& request) const {
+    float gain = request.volume;
+    if (request.positional) {
+        float distance = glm::length(request.position - listenerPosition_);
+        if (distance > request.maxDistance) return 0.0f;
+        // Inverse model with minDistance 1 and rolloff 1, as set in startVoice()
+        gain /= std::max(distance, 1.0f);
+    }
+    return gain;
+}
+
+float VoicePool::score(const VoiceRequest& request, float audible) const {
+    return audible * kCategoryPriority[static_cast<size_t>(request.category)];
+}
+
+bool VoicePool::play(const VoiceRequest& request) {
+    if (!engine_ || request.clip.frames == 0) return false;
+    if (!request.clip.data && request.streamPath.empty()) return false;
+
+    const float audible = audibility(request);
+    const float requestScore = score(request, audible);
+    if (audible < kAudibleThreshold) {
+        addVirtual(request, 0.0f, requestScore);
+        return true;
+    }
+
+    // Category at its limit: compete only with voices of the same category.
+    // Pool exhausted: compete with every voice.
+    const size_t category = static_cast<size_t>(request.category);
+    const bool categoryFull = categoryCounts_[category] >= categoryLimits_[category];
+    if (categoryFull || freeVoices_.empty()) {
+        int32_t victim = findVictim(request.category, categoryFull);
+        if (victim < 0 || voices_[busyVoices_[victim]].score > requestScore) {
+            addVirtual(request, 0.0f, requestScore);
+            return true;
+        }
+        demoteVoice(static_cast<uint32_t>(victim));
+        stats_.stolen++;
+    }
+
+    if (!startVoice(request, 0.0f, requestScore)) return false;
+    stats_.played++;
+    stats_.realVoices = static_cast<uint32_t>(busyVoices_.size());
+    return true;
+}
+
+bool VoicePool::startVoice(const VoiceRequest& request, float startSeconds, float voiceScore) {
+    if (freeVoices_.empty()) return false;
+    const uint32_t index = freeVoices_.back();
+    Voice& voice = voices_[index];
+    const PcmClip& clip = request.clip;
+
+    if (startSeconds >= clip.durationSeconds()) return false;
+
+    ma_uint32 flags = request.positional ? 0 : (MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION);
+    ma_result result;
+    voice.streaming = !request.streamPath.empty();
+    if (voice.streaming) {
+        // The resource manager pages decoded audio in on its job thread, so
+        // only a couple of seconds of PCM are resident per stream.
+        result = ma_sound_init_from_file(engine_, request.streamPath.c_str(), flags | MA_SOUND_FLAG_STREAM,
+                                         nullptr, nullptr, &voice.sound);
+        if (result != MA_SUCCESS) {
+            LOG_WARNING("VoicePool: failed to open stream ", request.streamPath, ": ", result);
+            return false;
+        }
+    } else {
+        ma_audio_buffer_config bufferConfig = ma_audio_buffer_config_init(
+            static_cast<ma_format>(clip.format),
+            clip.channels,
+            clip.frames,
+            clip.data->data(),
+            nullptr
+        );
+        bufferConfig.sampleRate = clip.sampleRate;  // Critical: preserve original sample rate!
+
+        result = ma_audio_buffer_init(&bufferConfig, &voice.buffer);
+        if (result != MA_SUCCESS) {
+            LOG_WARNING("VoicePool: failed to create audio buffer: ", result);
+            return false;
+        }
+
+        flags |= MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC;
+        result = ma_sound_init_from_data_source(engine_, &voice.buffer, flags, nullptr, &voice.sound);
+        if (result != MA_SUCCESS) {
+            LOG_WARNING("VoicePool: failed to create sound: ", result);
+            ma_audio_buffer_uninit(&voice.buffer);
+            return false;
+        }
+    }
+
+    ma_sound_set_volume(&voice.sound, request.volume);
+    if (request.positional) {
+        ma_sound_set_position(&voice.sound, request.position.x, request.position.y, request.position.z);
+        ma_sound_set_pitch(&voice.sound, request.pitch);
+        ma_sound_set_attenuation_model(&voice.sound, ma_attenuation_model_inverse);
+        ma_sound_set_min_gain(&voice.sound, 0.0f);
+        ma_sound_set_max_gain(&voice.sound, 1.0f);
+        ma_sound_set_min_distance(&voice.sound, 1.0f);
+        ma_sound_set_max_distance(&voice.sound, request.maxDistance);
+        ma_sound_set_rolloff(&voice.sound, 1.0f);
+    }
+    if (startSeconds > 0.0f) {
+        // Seconds rather than frames: streams run at the engine's sample rate
+        ma_sound_seek_to_second(&voice.sound, startSeconds);
+    }
+
+    result = ma_sound_start(&voice.sound);
+    if (result != MA_SUCCESS) {
+        ma_sound_uninit(&voice.sound);
+        if (!voice.streaming) ma_audio_buffer_uninit(&voice.buffer);
+        return false;
+    }
+
+    voice.request = request;
+    voice.elapsed = startSeconds;
+    voice.score = voiceScore;
+    freeVoices_.pop_back();
+    busyVoices_.push_back(index);
+    categoryCounts_[static_cast<size_t>(request.category)]++;
+    return true;
+}
+
+void VoicePool::releaseVoice(uint32_t busyIndex) {
+    const uint32_t index = busyVoices_[busyIndex];
+    Voice& voice = voices_[index];
+    ma_sound_uninit(&voice.sound);
+    if (!voice.streaming) ma_audio_buffer_uninit(&voice.buffer);
+    categoryCounts_[static_cast<size_t>(voice.request.category)]--;
+    voice.request.clip.data.reset();
+    voice.request.streamPath.clear();
+
+    busyVoices_[busyIndex] = busyVoices_.back();
+    busyVoices_.pop_back();
+    freeVoices_.push_back(index);
+}
+
+void VoicePool::demoteVoice(uint32_t busyIndex) {
+    Voice& voice = voices_[busyVoices_[busyIndex]];
+    float elapsed = voice.elapsed;
+    float cursor = 0.0f;
+    if (ma_sound_get_cursor_in_seconds(&voice.sound, &cursor) == MA_SUCCESS) {
+        elapsed = cursor;
+    }
+    addVirtual(voice.request, elapsed, voice.score);
+    releaseVoice(busyIndex);
+}
+
+void VoicePool::addVirtual(const VoiceRequest& request, float elapsed, float voiceScore) {
+    if (request.clip.durationSeconds() - elapsed < kMinVirtualSeconds) {
+        stats_.dropped++;
+        return;
+    }
+    if (virtualVoices_.size() >= MAX_VIRTUAL_VOICES) {
+        auto weakest = std::min_element(virtualVoices_.begin(), virtualVoices_.end(),
+            [](const VirtualVoice& a, const VirtualVoice& b) { return a.score < b.score; });
+        stats_.dropped++;
+        if (weakest->score >= voiceScore) return;
+        *weakest = VirtualVoice{request, elapsed, voiceScore};
+    } else {
+        virtualVoices_.push_back(VirtualVoice{request, elapsed, voiceScore});
+    }
+    stats_.virtualized++;
+    stats_.virtualVoices = static_cast<uint32_t>(virtualVoices_.size());
+}
+
+int32_t VoicePool::findVictim(SoundCategory category, bool sameCategoryOnly) const {
+    int32_t victim = -1;
+    for (uint32_t i = 0; i < busyVoices_.size(); i++) {
+        const Voice& voice = voices_[busyVoices_[i]];
+        if (sameCategoryOnly && voice.request.category != category) continue;
+        if (victim < 0) {
+            victim = static_cast<int32_t>(i);
+            continue;
+        }
+        const Voice& best = voices_[busyVoices_[victim]];
+        // Lowest score loses; on ties the voice furthest into its clip goes first
+        if (voice.score < best.score || (voice.score == best.score && voice.elapsed > best.elapsed)) {
+            victim = static_cast<int32_t>(i);
+        }
+    }
+    return victim;
+}
+
+void VoicePool::update(float deltaTime) {
+    for (uint32_t i = 0; i < busyVoices_.size(); ) {
+        Voice& voice = voices_[busyVoices_[i]];
+        if (!ma_sound_is_playing(&voice.sound)) {
+            releaseVoice(i);  // Swap-removes: re-check slot i
+            continue;
+        }
+        voice.elapsed += deltaTime * playbackRate(voice.request);
+        if (voice.request.positional) {
+            float audible = audibility(voice.request);
+            voice.score = score(voice.request, audible);
+            if (audible < kAudibleThreshold) {
+                demoteVoice(i);
+                continue;
+            }
+        }
+        i++;
+    }
+
+    for (size_t i = 0; i < virtualVoices_.size(); ) {
+        VirtualVoice& virt = virtualVoices_[i];
+        virt.elapsed += deltaTime * playbackRate(virt.request);
+        if (virt.request.clip.durationSeconds() - virt.elapsed < kMinVirtualSeconds) {
+            virtualVoices_[i] = std::move(virtualVoices_.back());
+            virtualVoices_.pop_back();
+            stats_.dropped++;
+            continue;
+        }
+        virt.score = score(virt.request, audibility(virt.request));
+        i++;
+    }
+
+    promoteVirtualVoices();
+    stats_.realVoices = static_cast<uint32_t>(busyVoices_.size());
+    stats_.virtualVoices = static_cast<uint32_t>(virtualVoices_.size());
+}
+
+void VoicePool::promoteVirtualVoices() {
+    if (virtualVoices_.empty() || freeVoices_.empty()) return;
+
+    std::sort(virtualVoices_.begin(), virtualVoices_.end(),
+              [](const VirtualVoice& a, const VirtualVoice& b) { return a.score > b.score; });
+    bool promotedAny = false;
+    for (VirtualVoice& virt : virtualVoices_) {
+        if (freeVoices_.empty()) break;
+        if (audibility(virt.request) < kAudibleThreshold) continue;
+        const size_t category = static_cast<size_t>(virt.request.category);
+        if (categoryCounts_[category] >= categoryLimits_[category]) continue;
+        if (startVoice(virt.request, virt.elapsed, virt.score)) {
+            stats_.resumed++;
+        } else {
+            stats_.dropped++;
+        }
+        virt.request.clip.frames = 0;  // Mark for removal
+        promotedAny = true;
+    }
+    if (promotedAny) {
+        virtualVoices_.erase(std::remove_if(virtualVoices_.begin(), virtualVoices_.end(),
+                                            [](const VirtualVoice& v) { return v.request.clip.frames == 0; }),
+                             virtualVoices_.end());
+    }
+}
+
+uint32_t VoicePool::getStreamingVoiceCount() const {
+    uint32_t count = 0;
+    for (uint32_t index : busyVoices_) {
+        if (voices_[index].streaming) count++;
+    }
+    return count;
+}
+
+void VoicePool::stopAll() {
+    while (!busyVoices_.empty()) {
+        releaseVoice(static_cast<uint32_t>(busyVoices_.size() - 1));
+    }
+    virtualVoices_.clear();
+    stats_.realVoices = 0;
+    stats_.virtualVoices = 0;
+}
+
+} // namespace audio
+} // namespace wowee
@@ -5,6 +5,8 @@
 #include "core/spawn_presets.hpp"
 #include "core/logger.hpp"
 #include "core/memory_monitor.hpp"
+#include "core/metrics.hpp"
+#include "core/benchmark.hpp"
 #include "rendering/renderer.hpp"
 #include "audio/npc_voice_manager.hpp"
 #include "rendering/camera.hpp"
@@ -25,6 +27,8 @@
 #include "rendering/minimap.hpp"
 #include "rendering/quest_marker_renderer.hpp"
 #include "rendering/loading_screen.hpp"
+#include "rendering/gpu_upload_manager.hpp"
+#include "rendering/frame_graph.hpp"
 #include "audio/music_manager.hpp"
 #include "audio/footstep_manager.hpp"
 #include "audio/activity_sound_manager.hpp"
@@ -46,6 +50,7 @@
 #include <GL/glew.h>
 #include <chrono>
 #include <cstdlib>
+#include <thread>
 #include <algorithm>
 #include <cctype>
 #include <cctype>
@@ -97,6 +102,7 @@ bool Application::initialize() {
     windowConfig.width = 1280;
     windowConfig.height = 720;
     windowConfig.vsync = false;
+    windowConfig.hidden = headless_;
 
     window = std::make_unique<Window>(windowConfig);
     if (!window->initialize()) {
@@ -182,7 +188,8 @@ bool Application::initialize() {
             assetManager->setExpansionDataPath(profile->dataPath);
 
             std::string expansionManifest = profile->dataPath + "/manifest.json";
-            if (std::filesystem::exists(expansionManifest)) {
+            std::string expansionPackIndex = profile->dataPath + "/assets.wpi";
+            if (std::filesystem::exists(expansionPackIndex) || std::filesystem::exists(expansionManifest)) {
                 assetPath = profile->dataPath;
                 LOG_INFO("Using expansion-specific asset path: ", assetPath);
             }
@@ -192,9 +199,19 @@ bool Application::initialize() {
     LOG_INFO("Attempting to load WoW assets from: ", assetPath);
     if (assetManager->initialize(assetPath)) {
         LOG_INFO("Asset manager initialized successfully");
+        // Load the expansion's DBC preload set on worker threads while the
+        // login screens are up; the lookups below join in-flight loads.
+        if (expansionRegistry_) {
+            if (auto* profile = expansionRegistry_->getActive()) {
+                assetManager->preloadDBCsAsync(profile->preloadDbcs);
+            }
+        }
+
         // Eagerly load creature display DBC lookups so first spawn doesn't stall
         buildCreatureDisplayLookups();
 
+        modelCache_ = std::make_unique<rendering::AsyncModelCache>(assetManager.get());
+
         // Ensure the main in-world CharacterRenderer can load textures immediately.
         // Previously this was only wired during terrain initialization, which meant early spawns
         // (before terrain load) would render with white fallback textures (notably hair).
@@ -216,6 +233,9 @@ bool Application::initialize() {
     // Set up UI callbacks
     setupUICallbacks();
 
+    // Metrics export for soak runs (no-op unless WOWEE_METRICS_FILE/PORT is set)
+    Metrics::getInstance().startExporter();
+
     LOG_INFO("Application initialized successfully");
     running = true;
     return true;
@@ -323,6 +343,16 @@ void Application::run() {
         window->swapBuffers();
         auto t4 = std::chrono::steady_clock::now();
 
+        static auto& updateHist = Metrics::getInstance().histogram(
+            "wowee_frame_update_seconds", "Application::update time per frame");
+        static auto& renderHist = Metrics::getInstance().histogram(
+            "wowee_frame_render_seconds", "Application::render time per frame");
+        static auto& swapHist = Metrics::getInstance().histogram(
+            "wowee_frame_swap_seconds", "Buffer swap time per frame");
+        updateHist.observe(std::chrono::duration<double>(t2 - t1).count());
+        renderHist.observe(std::chrono::duration<double>(t3 - t2).count());
+        swapHist.observe(std::chrono::duration<double>(t4 - t3).count());
+
         totalUpdateMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
         totalRenderMs += std::chrono::duration<double, std::milli>(t3 - t2).count();
         totalSwapMs += std::chrono::duration<double, std::milli>(t4 - t3).count();
@@ -338,9 +368,145 @@ void Application::run() {
     LOG_INFO("Main loop ended");
 }
 
+bool Application::runBenchmark(const std::string& scriptPath, const std::string& reportPath) {
+    BenchmarkScript script;
+    if (!script.load(scriptPath)) {
+        return false;
+    }
+    if (!assetManager || !assetManager->isInitialized() || !renderer) {
+        LOG_ERROR("Benchmark: asset manager not initialized (set WOW_DATA_PATH)");
+        return false;
+    }
+
+    const auto& first = script.keyframes.front().canonical;
+    auto [tileX, tileY] = core::coords::canonicalToTile(first.x, first.y);
+    std::string adtPath = "World\\Maps\\" + script.mapName + "\\" + script.mapName + "_" +
+                          std::to_string(tileX) + "_" + std::to_string(tileY) + ".adt";
+    if (!renderer->loadTestTerrain(assetManager.get(), adtPath)) {
+        LOG_ERROR("Benchmark: failed to load terrain ", adtPath);
+        return false;
+    }
+
+    // The script owns the camera; no player, input or UI
+    auto* camera = renderer->getCamera();
+    auto* terrainMgr = renderer->getTerrainManager();
+    if (renderer->getCameraController()) {
+        renderer->getCameraController()->setEnabled(false);
+    }
+    auto applyPose = [&](float t) {
+        glm::vec3 pos;
+        float yaw, pitch;
+        script.sample(t, pos, yaw, pitch);
+        camera->setPosition(pos);
+        camera->setRotation(yaw, pitch);
+    };
+
+    auto pollQuit = [&]() {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) window->setShouldClose(true);
+        }
+        return window->shouldClose();
+    };
+
+    // Finalize every tile the streamer has queued; returns the time spent
+    auto drainStreaming = [&](float maxWaitSeconds) {
+        auto start = std::chrono::steady_clock::now();
+        while (terrainMgr && terrainMgr->getRemainingTileCount() > 0) {
+            terrainMgr->processAllReadyTiles();
+            rendering::GpuUploadManager::getInstance().endFrame();
+            auto elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed > maxWaitSeconds) {
+                LOG_WARNING("Benchmark: streaming did not settle within ", maxWaitSeconds,
+                            "s (remaining=", terrainMgr->getRemainingTileCount(), ")");
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Start from a fully streamed first pose in every mode
+    applyPose(0.0f);
+    if (terrainMgr) {
+        // Sync mode requests tiles for each pose itself, so the streamer must
+        // not hold requests back between updates
+        if (script.syncStreaming) terrainMgr->setUpdateInterval(0.0f);
+        terrainMgr->update(*camera, 1.0f);
+        drainStreaming(60.0f);
+        LOG_INFO("Benchmark: initial streaming complete, ", terrainMgr->getLoadedTileCount(), " tiles");
+    }
+
+    const int measuredFrames = std::max(1, static_cast<int>(std::ceil(script.duration() / script.timestep)));
+    const int totalFrames = script.warmupFrames + measuredFrames;
+    BenchmarkRecorder recorder;
+
+    for (int frame = 0; frame < totalFrames; frame++) {
+        if (pollQuit()) {
+            LOG_WARNING("Benchmark: aborted at frame ", frame);
+            return false;
+        }
+
+        int measuredIndex = frame - script.warmupFrames;
+        if (measuredIndex == 0) recorder.begin(assetManager.get());
+        applyPose(std::max(0, measuredIndex) * script.timestep);
+
+        BenchmarkFrame sample;
+        // Sync mode requests and finishes the tiles this pose needs before the
+        // timed update, so every run renders the same world and no tile
+        // finalize work lands in updateMs; the wait is reported separately.
+        if (script.syncStreaming && terrainMgr) {
+            auto waitStart = std::chrono::steady_clock::now();
+            terrainMgr->update(*camera, 0.0f);
+            drainStreaming(30.0f);
+            sample.streamWaitMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - waitStart).count();
+        }
+
+        auto t1 = std::chrono::steady_clock::now();
+        renderer->update(script.timestep);
+        auto t2 = std::chrono::steady_clock::now();
+        renderer->beginFrame();
+        renderer->renderWorld(world.get(), gameHandler.get());
+        renderer->endFrame();
+        auto t3 = std::chrono::steady_clock::now();
+        window->swapBuffers();
+        auto t4 = std::chrono::steady_clock::now();
+
+        if (measuredIndex < 0) continue;
+
+        sample.updateMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        sample.renderMs = std::chrono::duration<double, std::milli>(t3 - t2).count();
+        sample.swapMs = std::chrono::duration<double, std::milli>(t4 - t3).count();
+        if (auto* m2 = renderer->getM2Renderer()) sample.m2DrawCalls = m2->getDrawCallCount();
+        if (auto* wmo = renderer->getWMORenderer()) sample.wmoDrawCalls = wmo->getDrawCallCount();
+        if (auto* cr = renderer->getCharacterRenderer()) sample.characterDrawCalls = cr->getDrawCallCount();
+        if (auto* tr = renderer->getTerrainRenderer()) {
+            sample.terrainChunks = static_cast<uint32_t>(tr->getRenderedChunkCount());
+        }
+        if (terrainMgr) sample.loadedTiles = terrainMgr->getLoadedTileCount();
+        recorder.addFrame(sample);
+
+        if (const auto* fg = renderer->getFrameGraph()) {
+            for (const auto& pass : fg->getPassTimings()) {
+                if (!pass.culled) recorder.addPassTiming(pass.name, pass.cpuMs, pass.gpuMs);
+            }
+        }
+    }
+
+    auto glString = [](GLenum name) {
+        const GLubyte* s = glGetString(name);
+        return s ? std::string(reinterpret_cast<const char*>(s)) : std::string();
+    };
+    return recorder.writeReport(reportPath, script, assetManager.get(),
+                                glString(GL_RENDERER), glString(GL_VERSION));
+}
+
 void Application::shutdown() {
     LOG_INFO("Shutting down application");
 
+    Metrics::getInstance().stopExporter();
+
     // Save floor cache before renderer is destroyed
     if (renderer && renderer->getWMORenderer()) {
         size_t cacheSize = renderer->getWMORenderer()->getFloorCacheSize();
@@ -355,6 +521,12 @@ void Application::shutdown() {
     // before AssetManager is destroyed.
     renderer.reset();
 
+    // Model cache workers also read through AssetManager
+    pendingGameObjectModels_.clear();
+    pendingDoodads_.clear();
+    pendingMountModel_.reset();
+    modelCache_.reset();
+
     world.reset();
     gameHandler.reset();
     authHandler.reset();
@@ -470,6 +642,7 @@ void Application::reloadExpansionData() {
     if (assetManager && !profile->dataPath.empty()) {
         assetManager->setExpansionDataPath(profile->dataPath);
         assetManager->clearDBCCache();
+        assetManager->preloadDBCsAsync(profile->preloadDbcs);
     }
 
     // Reset map name cache so it reloads from new expansion's Map.dbc
@@ -613,23 +786,22 @@ void Application::update(float deltaTime) {
                         havePlayerPos = true;
                     }
 
-                    const float kResyncRadiusSq = 260.0f * 260.0f;
-                    for (const auto& pair : gameHandler->getEntityManager().getEntities()) {
-                        uint64_t guid = pair.first;
-                        const auto& entity = pair.second;
-                        if (!entity || guid == playerGuid) continue;
-                        if (entity->getType() != game::ObjectType::UNIT) continue;
-                        auto unit = std::dynamic_pointer_cast<game::Unit>(entity);
+                    const float kResyncRadius = 260.0f;
+                    const auto& entityManager = gameHandler->getEntityManager();
+                    // Spatial query when the player is known; otherwise scan the dense unit list
+                    std::vector<uint64_t> candidates;
+                    if (havePlayerPos) {
+                        entityManager.queryRadius(playerPos.x, playerPos.y, playerPos.z, kResyncRadius,
+                                                  game::EntityManager::KIND_UNITS, candidates);
+                    } else {
+                        candidates = entityManager.getHotData(game::EntityKind::UNIT).guid;
+                    }
+                    for (uint64_t guid : candidates) {
+                        if (guid == playerGuid) continue;
+                        auto unit = std::static_pointer_cast<game::Unit>(entityManager.getEntity(guid));
                         if (!unit || unit->getDisplayId() == 0) continue;
                         if (creatureInstances_.count(guid) || pendingCreatureSpawnGuids_.count(guid)) continue;
 
-                        if (havePlayerPos) {
-                            glm::vec3 pos(unit->getX(), unit->getY(), unit->getZ());
-                            glm::vec3 delta = pos - playerPos;
-                            float distSq = glm::dot(delta, delta);
-                            if (distSq > kResyncRadiusSq) continue;
-                        }
-
                         PendingCreatureSpawn retrySpawn{};
                         retrySpawn.guid = guid;
                         retrySpawn.displayId = unit->getDisplayId();
@@ -645,6 +817,7 @@ void Application::update(float deltaTime) {
 
             auto goq1 = std::chrono::high_resolution_clock::now();
             processGameObjectSpawnQueue();
+            processPendingModelLoads();
             auto goq2 = std::chrono::high_resolution_clock::now();
             goQTime += std::chrono::duration<float, std::milli>(goq2 - goq1).count();
 
@@ -1284,9 +1457,9 @@ void Application::setupUICallbacks() {
     gameHandler->setPlayerEquipmentCallback([this](uint64_t guid,
                                                   const std::array<uint32_t, 19>& displayInfoIds,
                                                   const std::array<uint8_t, 19>& inventoryTypes) {
-        // Queue equipment compositing instead of doing it immediately —
-        // compositeWithRegions is expensive (file I/O + CPU blit + GPU upload)
-        // and causes frame stutters if multiple players update at once.
+        // Queue equipment updates instead of applying them immediately —
+        // geoset/DBC resolution is spread across frames and skin compositing
+        // runs on CharacterRenderer's worker threads.
         deferredEquipmentQueue_.push_back({guid, {displayInfoIds, inventoryTypes}});
     });
 
@@ -1326,11 +1499,13 @@ void Application::setupUICallbacks() {
             }
             mountModelId_ = 0;
             pendingMountDisplayId_ = 0;
+            pendingMountModel_.reset();
             if (renderer) renderer->clearMount();
             LOG_INFO("Dismounted");
             return;
         }
         // Queue the mount for processing in the next update() frame
+        if (mountDisplayId != pendingMountDisplayId_) pendingMountModel_.reset();
         pendingMountDisplayId_ = mountDisplayId;
     });
 
@@ -2526,6 +2701,14 @@ void Application::loadOnlineWorldTerrain(uint32_t mapId, float x, float y, float
 
     showProgress("Entering world...", 0.0f);
 
+    // Finish the DBC preload behind the loading screen instead of stalling
+    // the first spellbook/talent/character screen that needs a table.
+    while (assetManager->isDBCPreloadPending()) {
+        showProgress("Loading game data...", 0.0f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+    assetManager->waitForDBCPreload();
+
     // Resolve map folder name from Map.dbc (authoritative for world/instance maps).
     // This is required for instances like DeeprunTram (map 369) that are not Azeroth/Kalimdor.
     if (!mapNameCacheLoaded_ && assetManager) {
@@ -2723,6 +2906,7 @@ void Application::loadOnlineWorldTerrain(uint32_t mapId, float x, float y, float
                 loadingScreen.setProgress(progress);
                 loadingScreen.render();
                 window->swapBuffers();
+                rendering::GpuUploadManager::getInstance().endFrame();
 
                 if (remaining != lastRemaining) {
                     lastRemaining = remaining;
@@ -4249,10 +4433,9 @@ void Application::setOnlinePlayerEquipment(uint64_t guid,
     const PlayerTextureSlots& slots = slotsIt->second;
     if (slots.skin < 0) return;
 
-    GLuint newTex = charRenderer->compositeWithRegions(st.bodySkinPath, st.underwearPaths, regionLayers);
-    if (newTex != 0) {
-        charRenderer->setTextureSlotOverride(st.instanceId, static_cast<uint16_t>(slots.skin), newTex);
-    }
+    // Composite on a worker thread; the skin override is applied once uploaded.
+    charRenderer->requestCompositeWithRegions(st.instanceId, static_cast<uint16_t>(slots.skin),
+                                              st.bodySkinPath, st.underwearPaths, regionLayers);
 }
 
 void Application::despawnOnlinePlayer(uint64_t guid) {
@@ -4299,6 +4482,16 @@ void Application::spawnOnlineGameObject(uint64_t guid, uint32_t entry, uint32_t
         return;
     }
 
+    auto pendingIt = pendingGameObjectModels_.find(guid);
+    if (pendingIt != pendingGameObjectModels_.end()) {
+        // Model still loading — spawn at the latest position once it's ready
+        if (pendingIt->second.spawn.displayId == displayId) {
+            pendingIt->second.spawn = {guid, entry, displayId, x, y, z, orientation};
+            return;
+        }
+        pendingGameObjectModels_.erase(pendingIt);
+    }
+
     std::string modelPath;
 
         // Override model path for transports with wrong displayIds (preloaded transports)
@@ -4344,213 +4537,266 @@ void Application::spawnOnlineGameObject(uint64_t guid, uint32_t entry, uint32_t
                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
     bool isWmo = lowerPath.size() >= 4 && lowerPath.substr(lowerPath.size() - 4) == ".wmo";
 
-    glm::vec3 renderPos = core::coords::canonicalToRender(glm::vec3(x, y, z));
-    float renderYaw = orientation;
-
-    bool loadedAsWmo = false;
+    PendingGameObjectSpawn spawn{guid, entry, displayId, x, y, z, orientation};
     if (isWmo) {
-        auto* wmoRenderer = renderer->getWMORenderer();
-        if (!wmoRenderer) return;
-
-        uint32_t modelId = 0;
         auto itCache = gameObjectDisplayIdWmoCache_.find(displayId);
         if (itCache != gameObjectDisplayIdWmoCache_.end()) {
-            modelId = itCache->second;
-            loadedAsWmo = true;
-        } else {
-            auto wmoData = assetManager->readFile(modelPath);
-            if (!wmoData.empty()) {
-                pipeline::WMOModel wmoModel = pipeline::WMOLoader::load(wmoData);
-                LOG_DEBUG("Gameobject WMO root loaded: ", modelPath, " nGroups=", wmoModel.nGroups);
-                int loadedGroups = 0;
-                if (wmoModel.nGroups > 0) {
-                    std::string basePath = modelPath;
-                    std::string extension;
-                    if (basePath.size() > 4) {
-                        extension = basePath.substr(basePath.size() - 4);
-                        std::string extLower = extension;
-                        for (char& c : extLower) c = static_cast<char>(std::tolower(c));
-                        if (extLower == ".wmo") {
-                            basePath = basePath.substr(0, basePath.size() - 4);
-                        }
-                    }
+            createGameObjectWmoInstance(spawn, itCache->second, modelPath);
+            return;
+        }
+    } else {
+        auto itCache = gameObjectDisplayIdModelCache_.find(displayId);
+        if (itCache != gameObjectDisplayIdModelCache_.end()) {
+            createGameObjectM2Instance(spawn, itCache->second);
+            return;
+        }
+    }
 
-                    for (uint32_t gi = 0; gi < wmoModel.nGroups; gi++) {
-                        char groupSuffix[16];
-                        snprintf(groupSuffix, sizeof(groupSuffix), "_%03u%s", gi, extension.c_str());
-                        std::string groupPath = basePath + groupSuffix;
-                        std::vector<uint8_t> groupData = assetManager->readFile(groupPath);
-                        if (groupData.empty()) {
-                            snprintf(groupSuffix, sizeof(groupSuffix), "_%03u.wmo", gi);
-                            groupData = assetManager->readFile(basePath + groupSuffix);
-                        }
-                        if (groupData.empty()) {
-                            snprintf(groupSuffix, sizeof(groupSuffix), "_%03u.WMO", gi);
-                            groupData = assetManager->readFile(basePath + groupSuffix);
-                        }
-                        if (!groupData.empty()) {
-                            pipeline::WMOLoader::loadGroup(groupData, wmoModel, gi);
-                            loadedGroups++;
-                        } else {
-                            LOG_WARNING("  Failed to load WMO group ", gi, " for: ", basePath);
-                        }
-                    }
-                }
+    // Model not uploaded yet: read and parse it on a worker, and create the
+    // instance from processPendingModelLoads() once it is ready.
+    if (!modelCache_) return;
+    PendingGameObjectModel pending;
+    pending.spawn = spawn;
+    pending.modelPath = modelPath;
+    pending.isWmo = isWmo;
+    pending.handle = modelCache_->requestModel(modelPath);
+    pendingGameObjectModels_[guid] = std::move(pending);
+}
 
-                if (loadedGroups > 0 || wmoModel.nGroups == 0) {
-                    modelId = nextGameObjectWmoModelId_++;
-                    if (wmoRenderer->loadModel(wmoModel, modelId)) {
-                        gameObjectDisplayIdWmoCache_[displayId] = modelId;
-                        loadedAsWmo = true;
-                    } else {
-                        LOG_WARNING("Failed to load gameobject WMO model: ", modelPath);
-                    }
-                } else {
-                    LOG_WARNING("No WMO groups loaded for gameobject: ", modelPath,
-                                " — falling back to M2");
-                }
-            } else {
-                LOG_WARNING("Failed to read gameobject WMO: ", modelPath, " — falling back to M2");
-            }
-        }
+bool Application::createGameObjectWmoInstance(const PendingGameObjectSpawn& spawn, uint32_t modelId,
+                                              const std::string& modelPath) {
+    auto* wmoRenderer = renderer ? renderer->getWMORenderer() : nullptr;
+    if (!wmoRenderer) return false;
 
-        if (loadedAsWmo) {
-            uint32_t instanceId = wmoRenderer->createInstance(modelId, renderPos,
-                glm::vec3(0.0f, 0.0f, renderYaw), 1.0f);
-            if (instanceId == 0) {
-                LOG_WARNING("Failed to create gameobject WMO instance for guid 0x", std::hex, guid, std::dec);
-                return;
-            }
+    const uint64_t guid = spawn.guid;
+    glm::vec3 renderPos = core::coords::canonicalToRender(glm::vec3(spawn.x, spawn.y, spawn.z));
+    float renderYaw = spawn.orientation;
 
-            gameObjectInstances_[guid] = {modelId, instanceId, true};
-            LOG_DEBUG("Spawned gameobject WMO: guid=0x", std::hex, guid, std::dec,
-                     " displayId=", displayId, " at (", x, ", ", y, ", ", z, ")");
+    uint32_t instanceId = wmoRenderer->createInstance(modelId, renderPos,
+        glm::vec3(0.0f, 0.0f, renderYaw), 1.0f);
+    if (instanceId == 0) {
+        LOG_WARNING("Failed to create gameobject WMO instance for guid 0x", std::hex, guid, std::dec);
+        return false;
+    }
 
-            // Spawn transport WMO doodads (chairs, furniture, etc.) as child M2 instances
-            bool isTransport = false;
-            if (gameHandler) {
-                std::string lowerModelPath = modelPath;
-                std::transform(lowerModelPath.begin(), lowerModelPath.end(), lowerModelPath.begin(),
-                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-                isTransport = (lowerModelPath.find("transport") != std::string::npos);
+    gameObjectInstances_[guid] = {modelId, instanceId, true};
+    LOG_DEBUG("Spawned gameobject WMO: guid=0x", std::hex, guid, std::dec,
+             " displayId=", spawn.displayId, " at (", spawn.x, ", ", spawn.y, ", ", spawn.z, ")");
+
+    // Spawn transport WMO doodads (chairs, furniture, etc.) as child M2 instances
+    bool isTransport = false;
+    if (gameHandler) {
+        std::string lowerModelPath = modelPath;
+        std::transform(lowerModelPath.begin(), lowerModelPath.end(), lowerModelPath.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        isTransport = (lowerModelPath.find("transport") != std::string::npos);
+    }
+
+    auto* m2Renderer = renderer->getM2Renderer();
+    if (m2Renderer && isTransport) {
+        const auto* doodadTemplates = wmoRenderer->getDoodadTemplates(modelId);
+        if (doodadTemplates && !doodadTemplates->empty()) {
+            constexpr size_t kMaxTransportDoodads = 192;
+            const size_t doodadBudget = std::min(doodadTemplates->size(), kMaxTransportDoodads);
+            LOG_INFO("Spawning ", doodadBudget, "/", doodadTemplates->size(),
+                     " doodads for transport WMO instance ", instanceId);
+            int spawnedDoodads = 0;
+            int queuedDoodads = 0;
+
+            for (size_t i = 0; i < doodadBudget; ++i) {
+                const auto& doodadTemplate = (*doodadTemplates)[i];
+                uint32_t doodadModelId = static_cast<uint32_t>(std::hash<std::string>{}(doodadTemplate.m2Path));
+
+                // Models not uploaded yet are attached by processPendingModelLoads()
+                if (!m2Renderer->hasModel(doodadModelId)) {
+                    if (!modelCache_) continue;
+                    PendingDoodad pending;
+                    pending.handle = modelCache_->requestModel(doodadTemplate.m2Path);
+                    pending.wmoInstanceId = instanceId;
+                    pending.modelId = doodadModelId;
+                    pending.localTransform = doodadTemplate.localTransform;
+                    pendingDoodads_.push_back(std::move(pending));
+                    queuedDoodads++;
+                    continue;
+                }
+
+                // Create M2 instance at world origin (placed from the WMO transform when linked)
+                uint32_t m2InstanceId = m2Renderer->createInstance(doodadModelId, glm::vec3(0.0f), glm::vec3(0.0f), 1.0f);
+                if (m2InstanceId == 0) continue;
+
+                wmoRenderer->addDoodadToInstance(instanceId, m2InstanceId, doodadTemplate.localTransform);
+                spawnedDoodads++;
             }
 
-            auto* m2Renderer = renderer->getM2Renderer();
-            if (m2Renderer && isTransport) {
-                const auto* doodadTemplates = wmoRenderer->getDoodadTemplates(modelId);
-                if (doodadTemplates && !doodadTemplates->empty()) {
-                    constexpr size_t kMaxTransportDoodads = 192;
-                    const size_t doodadBudget = std::min(doodadTemplates->size(), kMaxTransportDoodads);
-                    LOG_INFO("Spawning ", doodadBudget, "/", doodadTemplates->size(),
-                             " doodads for transport WMO instance ", instanceId);
-                    int spawnedDoodads = 0;
-
-                    for (size_t i = 0; i < doodadBudget; ++i) {
-                        const auto& doodadTemplate = (*doodadTemplates)[i];
-                        // Load M2 model (may be cached)
-                        uint32_t doodadModelId = static_cast<uint32_t>(std::hash<std::string>{}(doodadTemplate.m2Path));
-                        auto m2Data = assetManager->readFile(doodadTemplate.m2Path);
-                        if (m2Data.empty()) continue;
-
-                        pipeline::M2Model m2Model = pipeline::M2Loader::load(m2Data);
-                        std::string skinPath = doodadTemplate.m2Path.substr(0, doodadTemplate.m2Path.size() - 3) + "00.skin";
-                        std::vector<uint8_t> skinData = assetManager->readFile(skinPath);
-                        if (!skinData.empty() && m2Model.version >= 264) {
-                            pipeline::M2Loader::loadSkin(skinData, m2Model);
-                        }
-                        if (!m2Model.isValid()) continue;
+            LOG_INFO("Spawned ", spawnedDoodads, " doodads (", queuedDoodads,
+                     " loading) for transport WMO instance ", instanceId);
+        } else {
+            LOG_INFO("Transport WMO has no doodads or templates not available");
+        }
+    }
 
-                        // Load model to renderer (cached if already loaded)
-                        m2Renderer->loadModel(m2Model, doodadModelId);
+    // Transport GameObjects are not always named "transport" in their WMO path
+    // (e.g. elevators/lifts). If the server marks it as a transport, always
+    // notify so TransportManager can animate/carry passengers.
+    if (gameHandler && gameHandler->isTransportGuid(guid)) {
+        gameHandler->notifyTransportSpawned(guid, spawn.entry, spawn.displayId,
+                                            spawn.x, spawn.y, spawn.z, spawn.orientation);
+    }
+    return true;
+}
 
-                        // Create M2 instance at world origin (transform will be updated by WMO parent)
-                        uint32_t m2InstanceId = m2Renderer->createInstance(doodadModelId, glm::vec3(0.0f), glm::vec3(0.0f), 1.0f);
-                        if (m2InstanceId == 0) continue;
+bool Application::createGameObjectM2Instance(const PendingGameObjectSpawn& spawn, uint32_t modelId) {
+    auto* m2Renderer = renderer ? renderer->getM2Renderer() : nullptr;
+    if (!m2Renderer) return false;
 
-                        // Link doodad to WMO instance
-                        wmoRenderer->addDoodadToInstance(instanceId, m2InstanceId, doodadTemplate.localTransform);
-                        spawnedDoodads++;
-                    }
+    glm::vec3 renderPos = core::coords::canonicalToRender(glm::vec3(spawn.x, spawn.y, spawn.z));
+    uint32_t instanceId = m2Renderer->createInstance(modelId, renderPos,
+        glm::vec3(0.0f, 0.0f, spawn.orientation), 1.0f);
+    if (instanceId == 0) {
+        LOG_WARNING("Failed to create gameobject instance for guid 0x", std::hex, spawn.guid, std::dec);
+        return false;
+    }
 
-                    if (spawnedDoodads > 0) {
-                        LOG_INFO("Spawned ", spawnedDoodads, " doodads for transport WMO instance ", instanceId);
+    gameObjectInstances_[spawn.guid] = {modelId, instanceId, false};
+    LOG_DEBUG("Spawned gameobject: guid=0x", std::hex, spawn.guid, std::dec,
+             " displayId=", spawn.displayId, " at (", spawn.x, ", ", spawn.y, ", ", spawn.z, ")");
+    return true;
+}
 
-                        // Initial transform update to position doodads correctly
-                        // (subsequent updates will happen automatically via setInstanceTransform)
-                        glm::mat4 wmoTransform(1.0f);
-                        wmoTransform = glm::translate(wmoTransform, renderPos);
-                        wmoTransform = glm::rotate(wmoTransform, renderYaw, glm::vec3(0, 0, 1));
-                        wmoRenderer->setInstanceTransform(instanceId, wmoTransform);
-                    }
-                } else {
-                    LOG_INFO("Transport WMO has no doodads or templates not available");
-                }
-            }
+bool Application::finishPendingGameObject(PendingGameObjectModel& pending, int& uploads) {
+    const auto* loaded = pending.handle.get();
+    const auto& spawn = pending.spawn;
 
-            // Transport GameObjects are not always named "transport" in their WMO path
-            // (e.g. elevators/lifts). If the server marks it as a transport, always
-            // notify so TransportManager can animate/carry passengers.
-            if (gameHandler && gameHandler->isTransportGuid(guid)) {
-                gameHandler->notifyTransportSpawned(guid, entry, displayId, x, y, z, orientation);
-            }
+    if (pending.isWmo) {
+        auto* wmoRenderer = renderer->getWMORenderer();
+        if (!wmoRenderer) return true;
 
-            return;
+        uint32_t modelId = 0;
+        auto itCache = gameObjectDisplayIdWmoCache_.find(spawn.displayId);
+        if (itCache != gameObjectDisplayIdWmoCache_.end()) {
+            modelId = itCache->second;
+        } else if (loaded && loaded->valid) {
+            uint32_t newModelId = nextGameObjectWmoModelId_++;
+            uploads++;
+            if (wmoRenderer->loadModel(loaded->wmo, newModelId)) {
+                gameObjectDisplayIdWmoCache_[spawn.displayId] = newModelId;
+                modelId = newModelId;
+            } else {
+                LOG_WARNING("Failed to load gameobject WMO model: ", pending.modelPath);
+            }
+        }
+        if (modelId != 0) {
+            createGameObjectWmoInstance(spawn, modelId, pending.modelPath);
+            return true;
         }
 
-        // WMO failed — fall through to try as M2
-        // Convert .wmo path to .m2 for fallback
-        modelPath = modelPath.substr(0, modelPath.size() - 4) + ".m2";
+        // WMO failed — try the same path as M2
+        LOG_WARNING("Gameobject WMO unavailable: ", pending.modelPath, " — falling back to M2");
+        pending.modelPath = pending.modelPath.substr(0, pending.modelPath.size() - 4) + ".m2";
+        pending.isWmo = false;
+        if (!gameObjectDisplayIdModelCache_.count(spawn.displayId)) {
+            if (!modelCache_) return true;
+            pending.handle = modelCache_->requestModel(pending.modelPath);
+            return false;
+        }
+        loaded = nullptr;
     }
 
-    {
-        auto* m2Renderer = renderer->getM2Renderer();
-        if (!m2Renderer) return;
+    auto* m2Renderer = renderer->getM2Renderer();
+    if (!m2Renderer) return true;
 
-        uint32_t modelId = 0;
-        auto itCache = gameObjectDisplayIdModelCache_.find(displayId);
-        if (itCache != gameObjectDisplayIdModelCache_.end()) {
-            modelId = itCache->second;
-        } else {
-            modelId = nextGameObjectModelId_++;
+    uint32_t modelId = 0;
+    auto itCache = gameObjectDisplayIdModelCache_.find(spawn.displayId);
+    if (itCache != gameObjectDisplayIdModelCache_.end()) {
+        modelId = itCache->second;
+    } else {
+        if (!loaded || !loaded->valid) {
+            LOG_WARNING("Failed to read gameobject M2: ", pending.modelPath);
+            return true;
+        }
+        modelId = nextGameObjectModelId_++;
+        uploads++;
+        if (!m2Renderer->loadModel(loaded->m2, modelId)) {
+            LOG_WARNING("Failed to load gameobject model: ", pending.modelPath);
+            return true;
+        }
+        gameObjectDisplayIdModelCache_[spawn.displayId] = modelId;
+    }
 
-            auto m2Data = assetManager->readFile(modelPath);
-            if (m2Data.empty()) {
-                LOG_WARNING("Failed to read gameobject M2: ", modelPath);
-                return;
-            }
+    createGameObjectM2Instance(spawn, modelId);
+    return true;
+}
 
-            pipeline::M2Model model = pipeline::M2Loader::load(m2Data);
-            if (model.vertices.empty()) {
-                LOG_WARNING("Failed to parse gameobject M2: ", modelPath);
-                return;
-            }
+void Application::processPendingModelLoads() {
+    if (!renderer || (pendingGameObjectModels_.empty() && pendingDoodads_.empty())) return;
+
+    // GL uploads (loadModel) are the expensive part; cap them per frame and
+    // stop early when the frame's time slice is used up.
+    const auto start = std::chrono::steady_clock::now();
+    int uploads = 0;
+    auto budgetLeft = [&]() {
+        if (uploads >= MAX_MODEL_UPLOADS_PER_FRAME) return false;
+        if (!rendering::GpuUploadManager::getInstance().hasBudget()) return false;
+        float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return elapsedMs < MODEL_UPLOAD_BUDGET_MS;
+    };
 
-            std::string skinPath = modelPath.substr(0, modelPath.size() - 3) + "00.skin";
-            auto skinData = assetManager->readFile(skinPath);
-            if (!skinData.empty() && model.version >= 264) {
-                pipeline::M2Loader::loadSkin(skinData, model);
+    if (!pendingGameObjectModels_.empty()) {
+        // Move ready entries out first: instance creation can notify the game
+        // handler, which may spawn or despawn other objects.
+        std::vector<PendingGameObjectModel> ready;
+        for (auto it = pendingGameObjectModels_.begin(); it != pendingGameObjectModels_.end();) {
+            if (it->second.handle.isReady() && ready.size() < static_cast<size_t>(MAX_SPAWNS_PER_FRAME)) {
+                ready.push_back(std::move(it->second));
+                it = pendingGameObjectModels_.erase(it);
+            } else {
+                ++it;
             }
-
-            if (!m2Renderer->loadModel(model, modelId)) {
-                LOG_WARNING("Failed to load gameobject model: ", modelPath);
-                return;
+        }
+        for (auto& pending : ready) {
+            uint64_t guid = pending.spawn.guid;
+            if (!budgetLeft() || !finishPendingGameObject(pending, uploads)) {
+                // Not done (out of budget, or re-requested as M2): keep waiting
+                // unless the object was despawned or respawned meanwhile
+                if (!pendingGameObjectModels_.count(guid) && !gameObjectInstances_.count(guid)) {
+                    pendingGameObjectModels_[guid] = std::move(pending);
+                }
             }
+        }
+    }
 
-            gameObjectDisplayIdModelCache_[displayId] = modelId;
+    auto* wmoRenderer = renderer->getWMORenderer();
+    auto* m2Renderer = renderer->getM2Renderer();
+    if (!wmoRenderer || !m2Renderer) {
+        pendingDoodads_.clear();
+        return;
+    }
+    for (size_t i = 0; i < pendingDoodads_.size() && budgetLeft();) {
+        PendingDoodad& pending = pendingDoodads_[i];
+        if (!pending.handle.isReady()) {
+            i++;
+            continue;
         }
 
-        uint32_t instanceId = m2Renderer->createInstance(modelId, renderPos,
-            glm::vec3(0.0f, 0.0f, renderYaw), 1.0f);
-        if (instanceId == 0) {
-            LOG_WARNING("Failed to create gameobject instance for guid 0x", std::hex, guid, std::dec);
-            return;
+        if (!m2Renderer->hasModel(pending.modelId)) {
+            const auto* loaded = pending.handle.get();
+            if (loaded && loaded->valid && loaded->m2.isValid()) {
+                uploads++;
+                m2Renderer->loadModel(loaded->m2, pending.modelId);
+            }
+        }
+        if (m2Renderer->hasModel(pending.modelId)) {
+            uint32_t m2InstanceId = m2Renderer->createInstance(pending.modelId, glm::vec3(0.0f), glm::vec3(0.0f), 1.0f);
+            // The transport may have despawned while its doodads were loading
+            if (m2InstanceId != 0 &&
+                !wmoRenderer->addDoodadToInstance(pending.wmoInstanceId, m2InstanceId, pending.localTransform)) {
+                m2Renderer->removeInstance(m2InstanceId);
+            }
         }
 
-        gameObjectInstances_[guid] = {modelId, instanceId, false};
+        pendingDoodads_[i] = std::move(pendingDoodads_.back());
+        pendingDoodads_.pop_back();
     }
-
-    LOG_DEBUG("Spawned gameobject: guid=0x", std::hex, guid, std::dec,
-             " displayId=", displayId, " at (", x, ", ", y, ", ", z, ")");
 }
 
 void Application::processCreatureSpawnQueue() {
@@ -4624,10 +4870,13 @@ void Application::processPlayerSpawnQueue() {
 
 void Application::processDeferredEquipmentQueue() {
     if (deferredEquipmentQueue_.empty()) return;
-    // Process at most 1 per frame — compositeWithRegions is expensive
-    auto [guid, equipData] = deferredEquipmentQueue_.front();
-    deferredEquipmentQueue_.erase(deferredEquipmentQueue_.begin());
-    setOnlinePlayerEquipment(guid, equipData.first, equipData.second);
+    // Compositing is asynchronous now; only DBC lookups and geoset updates run here
+    constexpr int kMaxEquipmentUpdatesPerFrame = 4;
+    for (int i = 0; i < kMaxEquipmentUpdatesPerFrame && !deferredEquipmentQueue_.empty(); i++) {
+        auto [guid, equipData] = deferredEquipmentQueue_.front();
+        deferredEquipmentQueue_.erase(deferredEquipmentQueue_.begin());
+        setOnlinePlayerEquipment(guid, equipData.first, equipData.second);
+    }
 }
 
 void Application::processGameObjectSpawnQueue() {
@@ -4645,15 +4894,17 @@ void Application::processGameObjectSpawnQueue() {
 void Application::processPendingMount() {
     if (pendingMountDisplayId_ == 0) return;
     uint32_t mountDisplayId = pendingMountDisplayId_;
-    pendingMountDisplayId_ = 0;
-    LOG_INFO("processPendingMount: loading displayId ", mountDisplayId);
 
-    if (!renderer || !renderer->getCharacterRenderer() || !assetManager) return;
+    if (!renderer || !renderer->getCharacterRenderer() || !assetManager) {
+        pendingMountDisplayId_ = 0;
+        return;
+    }
     auto* charRenderer = renderer->getCharacterRenderer();
 
     std::string m2Path = getModelPathForDisplayId(mountDisplayId);
     if (m2Path.empty()) {
         LOG_WARNING("No model path for mount displayId ", mountDisplayId);
+        pendingMountDisplayId_ = 0;
         return;
     }
 
@@ -4663,51 +4914,38 @@ void Application::processPendingMount() {
     if (cacheIt != displayIdModelCache_.end()) {
         modelId = cacheIt->second;
     } else {
-        modelId = nextCreatureModelId_++;
-
-        auto m2Data = assetManager->readFile(m2Path);
-        if (m2Data.empty()) {
-            LOG_WARNING("Failed to read mount M2: ", m2Path);
-            return;
+        // Read the M2, skin and stand/walk/run .anim files off-thread; the
+        // player stays unmounted until they are ready.
+        if (!pendingMountModel_.valid()) {
+            if (!modelCache_) {
+                pendingMountDisplayId_ = 0;
+                return;
+            }
+            LOG_INFO("processPendingMount: loading displayId ", mountDisplayId);
+            pendingMountModel_ = modelCache_->requestModel(m2Path, rendering::AsyncModelCache::LOAD_BASE_ANIMS);
         }
+        if (!pendingMountModel_.isReady()) return;
 
-        pipeline::M2Model model = pipeline::M2Loader::load(m2Data);
-        if (model.vertices.empty()) {
-            LOG_WARNING("Failed to parse mount M2: ", m2Path);
+        const auto* loaded = pendingMountModel_.get();
+        if (!loaded->valid) {
+            LOG_WARNING("Failed to load mount M2: ", m2Path);
+            pendingMountModel_.reset();
+            pendingMountDisplayId_ = 0;
             return;
         }
 
-        // Load skin file (only for WotLK M2s - vanilla has embedded skin)
-        std::string skinPath = m2Path.substr(0, m2Path.size() - 3) + "00.skin";
-        auto skinData = assetManager->readFile(skinPath);
-        if (!skinData.empty() && model.version >= 264) {
-            pipeline::M2Loader::loadSkin(skinData, model);
-        }
-
-        // Load external .anim files (only idle + run needed for mounts)
-        std::string basePath = m2Path.substr(0, m2Path.size() - 3);
-        for (uint32_t si = 0; si < model.sequences.size(); si++) {
-            if (!(model.sequences[si].flags & 0x20)) {
-                uint32_t animId = model.sequences[si].id;
-                // Only load stand(0), walk(4), run(5) anims to avoid hang
-                if (animId != 0 && animId != 4 && animId != 5) continue;
-                char animFileName[256];
-                snprintf(animFileName, sizeof(animFileName), "%s%04u-%02u.anim",
-                    basePath.c_str(), animId, model.sequences[si].variationIndex);
-                auto animData = assetManager->readFileOptional(animFileName);
-                if (!animData.empty()) {
-                    pipeline::M2Loader::loadAnimFile(m2Data, animData, si, model);
-                }
-            }
-        }
-
-        if (!charRenderer->loadModel(model, modelId)) {
+        modelId = nextCreatureModelId_++;
+        bool uploaded = charRenderer->loadModel(loaded->m2, modelId);
+        pendingMountModel_.reset();
+        if (!uploaded) {
             LOG_WARNING("Failed to load mount model: ", m2Path);
+            pendingMountDisplayId_ = 0;
             return;
         }
 
         displayIdModelCache_[mountDisplayId] = modelId;
     }
+    pendingMountDisplayId_ = 0;
 
     // Apply creature skin textures from CreatureDisplayInfo.dbc.
     // Re-apply even for cached models so transient failures can self-heal.
@@ -4985,6 +5223,8 @@ void Application::despawnOnlineCreature(uint64_t guid) {
 }
 
 void Application::despawnOnlineGameObject(uint64_t guid) {
+    pendingGameObjectModels_.erase(guid);
+
     auto it = gameObjectInstances_.find(guid);
     if (it == gameObjectInstances_.end()) return;
 
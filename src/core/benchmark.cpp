@@ -0,0 +1,362 @@
+#include "core/benchmark.hpp"
+#include "core/coordinates.hpp"
+#include "core/logger.hpp"
+#include "core/memory_monitor.hpp"
+#include "pipeline/asset_manager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace wowee {
+namespace core {
+
+namespace {
+
+double percentile(std::vector<double> values, double q) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    // Nearest-rank: p99 of 100 frames is the worst frame but one
+    size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(values.size())));
+    return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+double mean(const std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    return sum / static_cast<double>(values.size());
+}
+
+double maxOf(const std::vector<double>& values) {
+    return values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+}
+
+std::string jsonString(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+std::string jsonNumber(double v) {
+    if (!std::isfinite(v)) return "null";
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3f", v);
+    return buf;
+}
+
+std::string jsonRate(uint64_t hits, uint64_t misses) {
+    uint64_t total = hits + misses;
+    return total ? jsonNumber(static_cast<double>(hits) / static_cast<double>(total)) : "null";
+}
+
+/** {"mean":..,"p50":..,...} over per-frame millisecond samples. */
+std::string jsonDistribution(const std::vector<double>& values) {
+    std::ostringstream ss;
+    ss << "{\"mean\": " << jsonNumber(mean(values))
+       << ", \"p50\": " << jsonNumber(percentile(values, 0.50))
+       << ", \"p90\": " << jsonNumber(percentile(values, 0.90))
+       << ", \"p95\": " << jsonNumber(percentile(values, 0.95))
+       << ", \"p99\": " << jsonNumber(percentile(values, 0.99))
+       << ", \"max\": " << jsonNumber(maxOf(values)) << "}";
+    return ss.str();
+}
+
+/** Histogram observations made between two snapshots. */
+Histogram::Snapshot snapshotDelta(const Histogram::Snapshot& end, const Histogram::Snapshot& start) {
+    Histogram::Snapshot d;
+    for (size_t i = 0; i < d.counts.size(); i++) {
+        d.counts[i] = end.counts[i] - start.counts[i];
+    }
+    d.count = end.count - start.count;
+    d.sum = end.sum - start.sum;
+    return d;
+}
+
+std::string jsonLatency(const Histogram::Snapshot& s) {
+    std::ostringstream ss;
+    ss << "{\"count\": " << s.count
+       << ", \"meanMs\": " << jsonNumber(s.mean() * 1000.0)
+       << ", \"p95Ms\": " << jsonNumber(s.count ? s.quantile(0.95) * 1000.0 : 0.0) << "}";
+    return ss.str();
+}
+
+float wrapDegrees(float deg) {
+    deg = std::fmod(deg, 360.0f);
+    if (deg > 180.0f) deg -= 360.0f;
+    if (deg < -180.0f) deg += 360.0f;
+    return deg;
+}
+
+} // namespace
+
+bool BenchmarkScript::load(const std::string& scriptPath) {
+    std::ifstream file(scriptPath);
+    if (!file) {
+        LOG_ERROR("Benchmark: cannot open script ", scriptPath);
+        return false;
+    }
+
+    path = scriptPath;
+    keyframes.clear();
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line)) {
+        lineNo++;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream ss(line);
+        std::string directive;
+        if (!(ss >> directive)) continue;
+
+        bool ok = true;
+        if (directive == "name") {
+            ok = static_cast<bool>(ss >> name);
+        } else if (directive == "map") {
+            ok = static_cast<bool>(ss >> mapName);
+        } else if (directive == "timestep") {
+            ok = static_cast<bool>(ss >> timestep) && timestep > 0.0f;
+        } else if (directive == "warmup") {
+            ok = static_cast<bool>(ss >> warmupFrames) && warmupFrames >= 0;
+        } else if (directive == "streaming") {
+            std::string mode;
+            ok = static_cast<bool>(ss >> mode) && (mode == "sync" || mode == "async");
+            syncStreaming = (mode == "sync");
+        } else if (directive == "key") {
+            Keyframe key;
+            ok = static_cast<bool>(ss >> key.time >> key.canonical.x >> key.canonical.y >> key.canonical.z);
+            float yaw, pitch;
+            if (ok && (ss >> yaw >> pitch)) {
+                key.yawDeg = yaw;
+                key.pitchDeg = pitch;
+                key.faceAlongPath = false;
+            } else if (!keyframes.empty()) {
+                key.pitchDeg = keyframes.back().pitchDeg;
+            }
+            if (ok && !keyframes.empty() && key.time <= keyframes.back().time) {
+                LOG_ERROR("Benchmark: ", scriptPath, ":", lineNo, ": key times must increase");
+                return false;
+            }
+            if (ok) keyframes.push_back(key);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            LOG_ERROR("Benchmark: ", scriptPath, ":", lineNo, ": cannot parse '", line, "'");
+            return false;
+        }
+    }
+
+    if (keyframes.empty()) {
+        LOG_ERROR("Benchmark: ", scriptPath, " has no keyframes");
+        return false;
+    }
+    if (name.empty()) {
+        name = scriptPath;
+        auto slash = name.find_last_of("/\\");
+        if (slash != std::string::npos) name = name.substr(slash + 1);
+        auto dot = name.rfind('.');
+        if (dot != std::string::npos) name.erase(dot);
+    }
+
+    std::vector<glm::vec3> points;
+    std::vector<uint32_t> knotMs;
+    points.reserve(keyframes.size());
+    knotMs.reserve(keyframes.size());
+    for (const auto& key : keyframes) {
+        points.push_back(coords::canonicalToRender(key.canonical));
+        knotMs.push_back(static_cast<uint32_t>(std::lround(key.time * 1000.0f)));
+    }
+    spline_.clear();
+    if (points.size() >= 2) {
+        spline_.build(points, false);
+        spline_.setKnotTimes(std::move(knotMs));
+    }
+    cursor_ = 0;
+
+    LOG_INFO("Benchmark script '", name, "': ", keyframes.size(), " keys, ",
+             duration(), "s on ", mapName, ", ", syncStreaming ? "sync" : "async", " streaming");
+    return true;
+}
+
+void BenchmarkScript::sample(float t, glm::vec3& renderPos, float& yawDeg, float& pitchDeg) const {
+    if (spline_.empty()) {
+        const Keyframe& key = keyframes.front();
+        renderPos = coords::canonicalToRender(key.canonical);
+        yawDeg = key.yawDeg;
+        pitchDeg = key.pitchDeg;
+        return;
+    }
+
+    uint32_t timeMs = static_cast<uint32_t>(std::lround(std::clamp(t, 0.0f, duration()) * 1000.0f));
+    size_t seg = spline_.findSegmentByTime(timeMs, cursor_);
+    float u = spline_.segmentParam(seg, timeMs);
+    renderPos = spline_.evaluate(seg, u);
+
+    const Keyframe& a = keyframes[seg];
+    const Keyframe& b = keyframes[seg + 1];
+    pitchDeg = a.pitchDeg + (b.pitchDeg - a.pitchDeg) * u;
+
+    auto tangentYaw = [&]() {
+        glm::vec3 d = spline_.derivative(seg, u);
+        if (d.x * d.x + d.y * d.y < 1e-6f) d = spline_.chord(seg);
+        return glm::degrees(std::atan2(d.y, d.x));
+    };
+    float yawA = a.faceAlongPath ? tangentYaw() : a.yawDeg;
+    float yawB = b.faceAlongPath ? tangentYaw() : b.yawDeg;
+    yawDeg = yawA + wrapDegrees(yawB - yawA) * u;
+}
+
+void BenchmarkRecorder::begin(const pipeline::AssetManager* assets) {
+    frames_.clear();
+    passes_.clear();
+    start_ = readCounters(assets);
+}
+
+void BenchmarkRecorder::addFrame(const BenchmarkFrame& frame) {
+    frames_.push_back(frame);
+}
+
+void BenchmarkRecorder::addPassTiming(const std::string& pass, double cpuMs, double gpuMs) {
+    auto& samples = passes_[pass];
+    samples.cpuMs.push_back(cpuMs);
+    samples.gpuMs.push_back(gpuMs);
+}
+
+BenchmarkRecorder::CounterState BenchmarkRecorder::readCounters(const pipeline::AssetManager* assets) {
+    auto& metrics = Metrics::getInstance();
+    CounterState s;
+    if (assets) {
+        s.assetHits = assets->getFileCacheHits();
+        s.assetMisses = assets->getFileCacheMisses();
+        s.cookedHits = assets->getCookedHits();
+    }
+    s.tileCacheHits = metrics.counter("wowee_terrain_tile_cache_total",
+        "Tile prepares by in-RAM tile cache outcome", "result=\"hit\"").value();
+    s.tileCacheMisses = metrics.counter("wowee_terrain_tile_cache_total",
+        "Tile prepares by in-RAM tile cache outcome", "result=\"miss\"").value();
+    s.uploadBytes = metrics.counter("wowee_gpu_upload_bytes_total",
+        "Bytes of geometry and texture data uploaded to the GPU").value();
+    s.tilePrepare = metrics.histogram("wowee_terrain_tile_prepare_seconds",
+        "Worker-side tile parse/prepare time").snapshot();
+    s.tileFinalize = metrics.histogram("wowee_terrain_tile_finalize_seconds",
+        "Main-thread tile finalize (GPU upload) time").snapshot();
+    return s;
+}
+
+bool BenchmarkRecorder::writeReport(const std::string& reportPath, const BenchmarkScript& script,
+                                    const pipeline::AssetManager* assets, const std::string& glRenderer,
+                                    const std::string& glVersion) const {
+    CounterState end = readCounters(assets);
+
+    std::vector<double> frameMs, updateMs, renderMs, swapMs, streamWaitMs, drawCalls;
+    std::vector<double> m2Draws, wmoDraws, characterDraws, terrainChunks;
+    for (const auto& f : frames_) {
+        frameMs.push_back(f.frameMs());
+        updateMs.push_back(f.updateMs);
+        renderMs.push_back(f.renderMs);
+        swapMs.push_back(f.swapMs);
+        streamWaitMs.push_back(f.streamWaitMs);
+        m2Draws.push_back(f.m2DrawCalls);
+        wmoDraws.push_back(f.wmoDrawCalls);
+        characterDraws.push_back(f.characterDrawCalls);
+        terrainChunks.push_back(f.terrainChunks);
+        drawCalls.push_back(static_cast<double>(f.m2DrawCalls) + f.wmoDrawCalls +
+                            f.characterDrawCalls + f.terrainChunks);
+    }
+    double totalMs = 0.0;
+    for (double ms : frameMs) totalMs += ms;
+    double streamWaitTotal = 0.0;
+    for (double ms : streamWaitMs) streamWaitTotal += ms;
+
+    std::ofstream out(reportPath);
+    if (!out) {
+        LOG_ERROR("Benchmark: cannot write report ", reportPath);
+        return false;
+    }
+
+    out << "{\n";
+    out << "  \"name\": " << jsonString(script.name) << ",\n";
+    out << "  \"script\": " << jsonString(script.path) << ",\n";
+    out << "  \"map\": " << jsonString(script.mapName) << ",\n";
+    out << "  \"streaming\": " << jsonString(script.syncStreaming ? "sync" : "async") << ",\n";
+    out << "  \"timestepMs\": " << jsonNumber(script.timestep * 1000.0) << ",\n";
+    out << "  \"warmupFrames\": " << script.warmupFrames << ",\n";
+    out << "  \"frames\": " << frames_.size() << ",\n";
+    out << "  \"gl\": {\"renderer\": " << jsonString(glRenderer)
+        << ", \"version\": " << jsonString(glVersion) << "},\n";
+
+    out << "  \"frameTimeMs\": " << jsonDistribution(frameMs) << ",\n";
+    out << "  \"averageFps\": " << jsonNumber(totalMs > 0.0 ? frames_.size() * 1000.0 / totalMs : 0.0) << ",\n";
+    out << "  \"updateMs\": " << jsonDistribution(updateMs) << ",\n";
+    out << "  \"renderMs\": " << jsonDistribution(renderMs) << ",\n";
+    out << "  \"swapMs\": " << jsonDistribution(swapMs) << ",\n";
+    out << "  \"streamWaitMs\": {\"total\": " << jsonNumber(streamWaitTotal)
+        << ", \"max\": " << jsonNumber(maxOf(streamWaitMs)) << "},\n";
+
+    out << "  \"passes\": {";
+    bool first = true;
+    for (const auto& [pass, samples] : passes_) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    " << jsonString(pass) << ": {\"cpuMs\": " << jsonDistribution(samples.cpuMs)
+            << ", \"gpuMs\": " << jsonDistribution(samples.gpuMs) << "}";
+    }
+    out << (first ? "},\n" : "\n  },\n");
+
+    out << "  \"drawCalls\": {\"total\": " << jsonDistribution(drawCalls)
+        << ",\n    \"m2\": " << jsonDistribution(m2Draws)
+        << ",\n    \"wmo\": " << jsonDistribution(wmoDraws)
+        << ",\n    \"character\": " << jsonDistribution(characterDraws)
+        << ",\n    \"terrainChunks\": " << jsonDistribution(terrainChunks) << "},\n";
+
+    out << "  \"terrain\": {\"loadedTilesEnd\": " << (frames_.empty() ? 0 : frames_.back().loadedTiles)
+        << ", \"prepare\": " << jsonLatency(snapshotDelta(end.tilePrepare, start_.tilePrepare))
+        << ", \"finalize\": " << jsonLatency(snapshotDelta(end.tileFinalize, start_.tileFinalize)) << "},\n";
+
+    uint64_t assetHits = end.assetHits - start_.assetHits;
+    uint64_t assetMisses = end.assetMisses - start_.assetMisses;
+    uint64_t tileHits = end.tileCacheHits - start_.tileCacheHits;
+    uint64_t tileMisses = end.tileCacheMisses - start_.tileCacheMisses;
+    out << "  \"caches\": {\n";
+    out << "    \"assetFile\": {\"hits\": " << assetHits << ", \"misses\": " << assetMisses
+        << ", \"hitRate\": " << jsonRate(assetHits, assetMisses) << "},\n";
+    out << "    \"terrainTile\": {\"hits\": " << tileHits << ", \"misses\": " << tileMisses
+        << ", \"hitRate\": " << jsonRate(tileHits, tileMisses) << "},\n";
+    out << "    \"cookedHits\": " << (end.cookedHits - start_.cookedHits) << "\n";
+    out << "  },\n";
+
+    out << "  \"gpuUploadBytes\": " << (end.uploadBytes - start_.uploadBytes) << ",\n";
+    out << "  \"peakRssBytes\": " << MemoryMonitor::getInstance().getPeakRSS() << "\n";
+    out << "}\n";
+
+    if (!out) {
+        LOG_ERROR("Benchmark: error writing report ", reportPath);
+        return false;
+    }
+
+    LOG_INFO("Benchmark '", script.name, "': ", frames_.size(), " frames, p50 ",
+             percentile(frameMs, 0.50), " ms, p99 ", percentile(frameMs, 0.99), " ms -> ", reportPath);
+    return true;
+}
+
+} // namespace core
+} // namespace wowee
@@ -3,6 +3,7 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <sys/resource.h>
 #include <sys/sysinfo.h>
 
 namespace wowee {
@@ -75,5 +76,11 @@ bool MemoryMonitor::isMemoryPressure() const {
     return available < (totalRAM_ * 20 / 100);
 }
 
+size_t MemoryMonitor::getPeakRSS() const {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<size_t>(usage.ru_maxrss) * 1024ull;  // Linux reports kB
+}
+
 } // namespace core
 } // namespace wowee
@@ -0,0 +1,320 @@
+#include "core/metrics.hpp"
+#include "core/logger.hpp"
+#include "network/net_platform.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace wowee {
+namespace core {
+
+size_t metricsShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % METRICS_SHARDS;
+    return shard;
+}
+
+// ---- Counter ----
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& s : shards_) total += s.value.load(std::memory_order_relaxed);
+    return total;
+}
+
+// ---- Histogram ----
+
+const std::array<double, Histogram::BUCKET_COUNT>& Histogram::bounds() {
+    static const std::array<double, BUCKET_COUNT> b = [] {
+        std::array<double, BUCKET_COUNT> out{};
+        double v = 10e-6;
+        for (auto& x : out) {
+            x = v;
+            v *= 2.0;
+        }
+        return out;
+    }();
+    return b;
+}
+
+void Histogram::observe(double seconds) {
+    if (!(seconds >= 0.0)) seconds = 0.0;  // Also catches NaN
+    const auto& b = bounds();
+    size_t bucket = static_cast<size_t>(std::lower_bound(b.begin(), b.end(), seconds) - b.begin());
+    Shard& shard = shards_[metricsShard()];
+    shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(seconds, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snap;
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i <= BUCKET_COUNT; i++) {
+            uint64_t c = shard.counts[i].load(std::memory_order_relaxed);
+            snap.counts[i] += c;
+            snap.count += c;
+        }
+        snap.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return snap;
+}
+
+double Histogram::Snapshot::quantile(double q) const {
+    if (count == 0) return 0.0;
+    q = std::clamp(q, 0.0, 1.0);
+    const auto& b = bounds();
+    double rank = q * static_cast<double>(count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i <= BUCKET_COUNT; i++) {
+        if (counts[i] == 0) continue;
+        if (static_cast<double>(seen + counts[i]) >= rank) {
+            if (i == BUCKET_COUNT) return b[BUCKET_COUNT - 1];  // +Inf bucket: report last bound
+            double lower = (i == 0) ? 0.0 : b[i - 1];
+            double fraction = (rank - static_cast<double>(seen)) / static_cast<double>(counts[i]);
+            return lower + (b[i] - lower) * std::clamp(fraction, 0.0, 1.0);
+        }
+        seen += counts[i];
+    }
+    return b[BUCKET_COUNT - 1];
+}
+
+// ---- Registry ----
+
+Metrics& Metrics::getInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+Metrics::~Metrics() {
+    stopExporter();
+}
+
+Metrics::Series& Metrics::findOrCreate(const std::string& name, const std::string& help,
+                                       const std::string& labels, Type type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, created] = families_.try_emplace(name);
+    Family& family = it->second;
+    if (created) {
+        family.type = type;
+        family.help = help;
+    } else if (family.type != type) {
+        LOG_WARNING("Metrics: '", name, "' re-registered with a different type");
+    }
+
+    for (auto& series : family.series) {
+        if (series->labels == labels) return *series;
+    }
+    auto series = std::make_unique<Series>();
+    series->labels = labels;
+    switch (family.type) {
+        case Type::COUNTER: series->counter = std::make_unique<Counter>(); break;
+        case Type::GAUGE: series->gauge = std::make_unique<Gauge>(); break;
+        case Type::HISTOGRAM: series->histogram = std::make_unique<Histogram>(); break;
+    }
+    family.series.push_back(std::move(series));
+    return *family.series.back();
+}
+
+Counter& Metrics::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    Series& s = findOrCreate(name, help, labels, Type::COUNTER);
+    if (!s.counter) s.counter = std::make_unique<Counter>();
+    return *s.counter;
+}
+
+Gauge& Metrics::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    Series& s = findOrCreate(name, help, labels, Type::GAUGE);
+    if (!s.gauge) s.gauge = std::make_unique<Gauge>();
+    return *s.gauge;
+}
+
+Histogram& Metrics::histogram(const std::string& name, const std::string& help, const std::string& labels) {
+    Series& s = findOrCreate(name, help, labels, Type::HISTOGRAM);
+    if (!s.histogram) s.histogram = std::make_unique<Histogram>();
+    return *s.histogram;
+}
+
+std::string Metrics::exportText() const {
+    std::ostringstream out;
+    out.precision(9);
+
+    auto seriesName = [](const std::string& name, const std::string& labels, const std::string& extra = "") {
+        std::string joined = labels;
+        if (!extra.empty()) joined += (joined.empty() ? "" : ",") + extra;
+        return joined.empty() ? name : name + "{" + joined + "}";
+    };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [name, family] : families_) {
+        const char* typeName = family.type == Type::COUNTER ? "counter"
+                             : family.type == Type::GAUGE ? "gauge" : "histogram";
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << typeName << "\n";
+        for (const auto& series : family.series) {
+            if (series->counter) {
+                out << seriesName(name, series->labels) << " " << series->counter->value() << "\n";
+            } else if (series->gauge) {
+                out << seriesName(name, series->labels) << " " << series->gauge->value() << "\n";
+            } else if (series->histogram) {
+                Histogram::Snapshot snap = series->histogram->snapshot();
+                const auto& b = Histogram::bounds();
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < Histogram::BUCKET_COUNT; i++) {
+                    cumulative += snap.counts[i];
+                    char le[32];
+                    std::snprintf(le, sizeof(le), "le=\"%g\"", b[i]);
+                    out << seriesName(name + "_bucket", series->labels, le) << " " << cumulative << "\n";
+                }
+                out << seriesName(name + "_bucket", series->labels, "le=\"+Inf\"") << " " << snap.count << "\n";
+                out << seriesName(name + "_sum", series->labels) << " " << snap.sum << "\n";
+                out << seriesName(name + "_count", series->labels) << " " << snap.count << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+bool Metrics::writeTextFile(const std::string& path) const {
+    std::string text = exportText();
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!file) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, Histogram::Snapshot>> Metrics::histogramSnapshots() const {
+    std::vector<std::pair<std::string, Histogram::Snapshot>> out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [name, family] : families_) {
+        if (family.type != Type::HISTOGRAM) continue;
+        for (const auto& series : family.series) {
+            std::string key = series->labels.empty() ? name : name + "{" + series->labels + "}";
+            out.emplace_back(std::move(key), series->histogram->snapshot());
+        }
+    }
+    return out;
+}
+
+// ---- Exporter ----
+
+void Metrics::startExporter() {
+    if (exporterThread_.joinable()) return;
+
+    std::string filePath;
+    int port = 0;
+    float interval = 10.0f;
+    if (const char* f = std::getenv("WOWEE_METRICS_FILE")) filePath = f;
+    if (const char* p = std::getenv("WOWEE_METRICS_PORT")) port = std::atoi(p);
+    if (const char* i = std::getenv("WOWEE_METRICS_INTERVAL")) interval = std::max(0.5f, static_cast<float>(std::atof(i)));
+    if (filePath.empty() && port <= 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(exporterMutex_);
+        exporterStop_ = false;
+    }
+    exporterThread_ = std::thread(&Metrics::exporterLoop, this, filePath, port, interval);
+    LOG_INFO("Metrics exporter started (file=", filePath.empty() ? "-" : filePath,
+             ", port=", port > 0 ? std::to_string(port) : "-", ", interval=", interval, "s)");
+}
+
+void Metrics::stopExporter() {
+    if (!exporterThread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(exporterMutex_);
+        exporterStop_ = true;
+    }
+    exporterCV_.notify_all();
+    exporterThread_.join();
+}
+
+void Metrics::exporterLoop(std::string filePath, int port, float intervalSeconds) {
+    socket_t listener = INVALID_SOCK;
+    if (port > 0) {
+        net::ensureInit();
+        listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listener != INVALID_SOCK) {
+            int yes = 1;
+            setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof(yes));
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<uint16_t>(port));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // Loopback only
+            if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+                ::listen(listener, 4) != 0 || !net::setNonBlocking(listener)) {
+                LOG_WARNING("Metrics: cannot listen on 127.0.0.1:", port, ": ",
+                            net::errorString(net::lastError()));
+                net::closeSocket(listener);
+                listener = INVALID_SOCK;
+            }
+        }
+    }
+
+    // Poll the listener at a short tick; write the file every interval
+    const auto tick = std::chrono::milliseconds(listener != INVALID_SOCK ? 100 : 1000);
+    auto nextWrite = std::chrono::steady_clock::now();
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(exporterMutex_);
+            if (exporterCV_.wait_for(lock, tick, [this] { return exporterStop_; })) break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!filePath.empty() && now >= nextWrite) {
+            if (!writeTextFile(filePath)) {
+                LOG_WARNING("Metrics: failed to write ", filePath);
+            }
+            nextWrite = now + std::chrono::milliseconds(static_cast<int>(intervalSeconds * 1000.0f));
+        }
+
+        if (listener == INVALID_SOCK) continue;
+        for (;;) {
+            socket_t client = ::accept(listener, nullptr, nullptr);
+            if (client == INVALID_SOCK) break;
+
+            // Drain the request line; any path gets the metrics page
+            net::setNonBlocking(client);
+            uint8_t request[1024];
+            for (int attempt = 0; attempt < 10; attempt++) {
+                if (net::portableRecv(client, request, sizeof(request)) > 0) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            std::string body = exportText();
+            std::string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                                   std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+            size_t sent = 0;
+            int stalls = 0;
+            while (sent < response.size() && stalls < 200) {
+                ssize_t n = net::portableSend(client, reinterpret_cast<const uint8_t*>(response.data()) + sent,
+                                              response.size() - sent);
+                if (n > 0) {
+                    sent += static_cast<size_t>(n);
+                } else if (n < 0 && net::isWouldBlock(net::lastError())) {
+                    stalls++;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                } else {
+                    break;
+                }
+            }
+            net::closeSocket(client);
+        }
+    }
+
+    if (listener != INVALID_SOCK) net::closeSocket(listener);
+    if (!filePath.empty()) writeTextFile(filePath);  // Final sample on shutdown
+}
+
+} // namespace core
+} // namespace wowee
@@ -1,5 +1,7 @@
 #include "game/entity.hpp"
 #include "core/logger.hpp"
+#include <cmath>
+#include <limits>
 
 namespace wowee {
 namespace game {
@@ -10,8 +12,33 @@ void EntityManager::addEntity(uint64_t guid, std::shared_ptr<Entity> entity) {
         return;
     }
 
+    // Replacing an existing GUID: drop the old entity's index slot first
+    unindex(guid);
     entities[guid] = entity;
 
+    EntityKind kind;
+    if (kindForType(entity->getType(), kind)) {
+        EntityHotData& hot = hotData[static_cast<size_t>(kind)];
+        IndexRecord rec;
+        rec.kind = kind;
+        rec.dense = static_cast<uint32_t>(hot.size());
+        hot.guid.push_back(guid);
+        hot.entity.push_back(entity.get());
+        hot.x.push_back(0.0f);
+        hot.y.push_back(0.0f);
+        hot.z.push_back(0.0f);
+        hot.displayId.push_back(0);
+        hot.flags.push_back(0);
+        hot.health.push_back(0);
+        hot.maxHealth.push_back(0);
+        hot.hostile.push_back(0);
+        writeHotData(kind, rec.dense, *entity);
+        insertIntoCell(guid, rec, cellKey(cellCoord(entity->getX()), cellCoord(entity->getY())));
+        indexRecords[guid] = rec;
+        entity->indexDirtyList_ = &dirtyEntities;
+        entity->indexDirty_ = false;
+    }
+
     LOG_DEBUG("Added entity: GUID=0x", std::hex, guid, std::dec,
               ", Type=", static_cast<int>(entity->getType()));
 }
@@ -20,6 +47,7 @@ void EntityManager::removeEntity(uint64_t guid) {
     auto it = entities.find(guid);
     if (it != entities.end()) {
         LOG_DEBUG("Removed entity: GUID=0x", std::hex, guid, std::dec);
+        unindex(guid);
         entities.erase(it);
     }
 }
@@ -33,5 +61,213 @@ bool EntityManager::hasEntity(uint64_t guid) const {
     return entities.find(guid) != entities.end();
 }
 
+void EntityManager::clear() {
+    // Entities may outlive the manager through other shared_ptrs
+    for (auto& hot : hotData) {
+        for (Entity* entity : hot.entity) {
+            entity->indexDirtyList_ = nullptr;
+        }
+        hot = EntityHotData{};
+    }
+    entities.clear();
+    indexRecords.clear();
+    spatialGrid.clear();
+    dirtyEntities.clear();
+}
+
+void EntityManager::updateSpatialIndex() {
+    for (uint64_t guid : dirtyEntities) {
+        refreshEntity(guid);
+    }
+    dirtyEntities.clear();
+}
+
+void EntityManager::refreshEntity(uint64_t guid) {
+    // Removed (or replaced and already fresh) since it was queued
+    auto recIt = indexRecords.find(guid);
+    if (recIt == indexRecords.end()) return;
+    IndexRecord& rec = recIt->second;
+    EntityHotData& hot = hotData[static_cast<size_t>(rec.kind)];
+    Entity& entity = *hot.entity[rec.dense];
+    entity.indexDirty_ = false;
+    writeHotData(rec.kind, rec.dense, entity);
+
+    uint64_t cell = cellKey(cellCoord(hot.x[rec.dense]), cellCoord(hot.y[rec.dense]));
+    if (cell != rec.cell) {
+        removeFromCell(rec);
+        insertIntoCell(guid, rec, cell);
+    }
+}
+
+void EntityManager::queryRadius(float x, float y, float z, float radius, uint8_t kindMask,
+                                std::vector<uint64_t>& out) const {
+    out.clear();
+    if (radius < 0.0f) return;
+    const float radiusSq = radius * radius;
+    const int32_t minX = cellCoord(x - radius), maxX = cellCoord(x + radius);
+    const int32_t minY = cellCoord(y - radius), maxY = cellCoord(y + radius);
+
+    for (int32_t cx = minX; cx <= maxX; cx++) {
+        for (int32_t cy = minY; cy <= maxY; cy++) {
+            auto cellIt = spatialGrid.find(cellKey(cx, cy));
+            if (cellIt == spatialGrid.end()) continue;
+            for (uint64_t guid : cellIt->second) {
+                const IndexRecord& rec = indexRecords.at(guid);
+                if (!(kindMask & entityKindBit(rec.kind))) continue;
+                const EntityHotData& hot = hotData[static_cast<size_t>(rec.kind)];
+                float dx = hot.x[rec.dense] - x;
+                float dy = hot.y[rec.dense] - y;
+                float dz = hot.z[rec.dense] - z;
+                if (dx * dx + dy * dy + dz * dz <= radiusSq) {
+                    out.push_back(guid);
+                }
+            }
+        }
+    }
+}
+
+uint64_t EntityManager::queryNearestHostile(float x, float y, float z, float maxRadius,
+                                            uint64_t excludeGuid, uint8_t kindMask) const {
+    if (maxRadius < 0.0f) return 0;
+    const int32_t centerX = cellCoord(x), centerY = cellCoord(y);
+    const int32_t maxRing = static_cast<int32_t>(std::ceil(maxRadius / SPATIAL_CELL_SIZE));
+
+    uint64_t best = 0;
+    float bestDistSq = maxRadius * maxRadius;
+    bool found = false;
+
+    // Expand ring by ring; once a hit is found, cells in the next ring can
+    // still be closer (up to one cell), so stop only when the ring's minimum
+    // possible distance exceeds the best candidate.
+    for (int32_t ring = 0; ring <= maxRing; ring++) {
+        if (found) {
+            float ringMinDist = static_cast<float>(ring - 1) * SPATIAL_CELL_SIZE;
+            if (ringMinDist * ringMinDist > bestDistSq) break;
+        }
+        for (int32_t cx = centerX - ring; cx <= centerX + ring; cx++) {
+            for (int32_t cy = centerY - ring; cy <= centerY + ring; cy++) {
+                // Only the ring's perimeter; inner cells were visited already
+                if (std::abs(cx - centerX) != ring && std::abs(cy - centerY) != ring) continue;
+                auto cellIt = spatialGrid.find(cellKey(cx, cy));
+                if (cellIt == spatialGrid.end()) continue;
+                for (uint64_t guid : cellIt->second) {
+                    if (guid == excludeGuid) continue;
+                    const IndexRecord& rec = indexRecords.at(guid);
+                    if (!(kindMask & entityKindBit(rec.kind))) continue;
+                    const EntityHotData& hot = hotData[static_cast<size_t>(rec.kind)];
+                    const uint32_t i = rec.dense;
+                    if (!hot.hostile[i] || hot.health[i] == 0) continue;
+                    float dx = hot.x[i] - x;
+                    float dy = hot.y[i] - y;
+                    float dz = hot.z[i] - z;
+                    float distSq = dx * dx + dy * dy + dz * dz;
+                    if (distSq <= bestDistSq) {
+                        bestDistSq = distSq;
+                        best = guid;
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+bool EntityManager::kindForType(ObjectType type, EntityKind& kind) {
+    switch (type) {
+        case ObjectType::UNIT: kind = EntityKind::UNIT; return true;
+        case ObjectType::PLAYER: kind = EntityKind::PLAYER; return true;
+        case ObjectType::GAMEOBJECT: kind = EntityKind::GAMEOBJECT; return true;
+        default: return false;
+    }
+}
+
+uint64_t EntityManager::cellKey(int32_t cx, int32_t cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+int32_t EntityManager::cellCoord(float v) {
+    if (!std::isfinite(v)) return 0;
+    return static_cast<int32_t>(std::floor(v / SPATIAL_CELL_SIZE));
+}
+
+void EntityManager::writeHotData(EntityKind kind, uint32_t dense, const Entity& entity) {
+    EntityHotData& hot = hotData[static_cast<size_t>(kind)];
+    hot.x[dense] = entity.getX();
+    hot.y[dense] = entity.getY();
+    hot.z[dense] = entity.getZ();
+    if (kind == EntityKind::GAMEOBJECT) {
+        hot.displayId[dense] = static_cast<const GameObject&>(entity).getDisplayId();
+        return;
+    }
+    const auto& unit = static_cast<const Unit&>(entity);
+    hot.displayId[dense] = unit.getDisplayId();
+    hot.flags[dense] = unit.getUnitFlags();
+    hot.health[dense] = unit.getHealth();
+    hot.maxHealth[dense] = unit.getMaxHealth();
+    hot.hostile[dense] = unit.isHostile() ? 1 : 0;
+}
+
+void EntityManager::insertIntoCell(uint64_t guid, IndexRecord& rec, uint64_t cell) {
+    auto& bucket = spatialGrid[cell];
+    rec.cell = cell;
+    rec.cellSlot = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(guid);
+}
+
+void EntityManager::removeFromCell(const IndexRecord& rec) {
+    auto cellIt = spatialGrid.find(rec.cell);
+    if (cellIt == spatialGrid.end()) return;
+    auto& bucket = cellIt->second;
+    uint64_t moved = bucket.back();
+    bucket[rec.cellSlot] = moved;
+    bucket.pop_back();
+    if (rec.cellSlot < bucket.size()) {
+        indexRecords[moved].cellSlot = rec.cellSlot;
+    }
+    if (bucket.empty()) {
+        spatialGrid.erase(cellIt);
+    }
+}
+
+void EntityManager::unindex(uint64_t guid) {
+    auto recIt = indexRecords.find(guid);
+    if (recIt == indexRecords.end()) return;
+    const IndexRecord rec = recIt->second;
+    removeFromCell(rec);
+    indexRecords.erase(recIt);
+
+    // A queued GUID left in dirtyEntities is skipped by refreshEntity()
+    EntityHotData& hot = hotData[static_cast<size_t>(rec.kind)];
+    hot.entity[rec.dense]->indexDirtyList_ = nullptr;
+    hot.entity[rec.dense]->indexDirty_ = false;
+
+    // Swap-remove from the dense arrays and patch the moved entity's record
+    const uint32_t last = static_cast<uint32_t>(hot.size() - 1);
+    if (rec.dense != last) {
+        hot.guid[rec.dense] = hot.guid[last];
+        hot.entity[rec.dense] = hot.entity[last];
+        hot.x[rec.dense] = hot.x[last];
+        hot.y[rec.dense] = hot.y[last];
+        hot.z[rec.dense] = hot.z[last];
+        hot.displayId[rec.dense] = hot.displayId[last];
+        hot.flags[rec.dense] = hot.flags[last];
+        hot.health[rec.dense] = hot.health[last];
+        hot.maxHealth[rec.dense] = hot.maxHealth[last];
+        hot.hostile[rec.dense] = hot.hostile[last];
+        indexRecords[hot.guid[rec.dense]].dense = rec.dense;
+    }
+    hot.guid.pop_back();
+    hot.entity.pop_back();
+    hot.x.pop_back();
+    hot.y.pop_back();
+    hot.z.pop_back();
+    hot.displayId.pop_back();
+    hot.flags.pop_back();
+    hot.health.pop_back();
+    hot.maxHealth.pop_back();
+    hot.hostile.pop_back();
+}
+
 } // namespace game
 } // namespace wowee
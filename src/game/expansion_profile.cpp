@@ -6,7 +6,7 @@
 #include <algorithm>
 
 // Minimal JSON parsing (no external dependency) — expansion.json is tiny and flat.
-// We parse the subset we need: strings, integers, arrays of integers.
+// We parse the subset we need: strings, integers, arrays of integers/strings.
 namespace {
 
 std::string trim(const std::string& s) {
@@ -78,6 +78,36 @@ std::vector<uint32_t> jsonUintArray(const std::string& json, const std::string&
     return result;
 }
 
+std::vector<std::string> jsonStringArray(const std::string& json, const std::string& key) {
+    std::vector<std::string> result;
+    std::string arr = jsonValue(json, key);
+    if (arr.empty() || arr.front() != '[') return result;
+    arr = arr.substr(1, arr.size() - 2);
+    std::istringstream ss(arr);
+    std::string tok;
+    while (std::getline(ss, tok, ',')) {
+        std::string t = trim(tok);
+        if (!t.empty()) result.push_back(std::move(t));
+    }
+    return result;
+}
+
+// Tables every expansion touches on first use of the world, character,
+// spellbook, talent, taxi and map screens. expansion.json can replace the
+// list with a "preloadDbcs" array.
+const std::vector<std::string> kDefaultPreloadDbcs = {
+    "Spell.dbc", "SpellIcon.dbc", "SkillLine.dbc", "SkillLineAbility.dbc",
+    "Talent.dbc", "TalentTab.dbc",
+    "ItemDisplayInfo.dbc", "CharSections.dbc", "CharHairGeosets.dbc",
+    "CharacterFacialHairStyles.dbc",
+    "CreatureDisplayInfo.dbc", "CreatureDisplayInfoExtra.dbc", "CreatureModelData.dbc",
+    "GameObjectDisplayInfo.dbc",
+    "Faction.dbc", "FactionTemplate.dbc",
+    "Map.dbc", "AreaTable.dbc", "WorldMapArea.dbc",
+    "TaxiNodes.dbc", "TaxiPath.dbc", "TaxiPathNode.dbc", "TransportAnimation.dbc",
+    "Emotes.dbc", "EmotesText.dbc", "EmotesTextData.dbc",
+};
+
 } // namespace
 
 namespace wowee {
@@ -179,6 +209,8 @@ bool ExpansionRegistry::loadProfile(const std::string& jsonPath, const std::stri
     p.maxLevel = static_cast<uint32_t>(jsonInt(json, "maxLevel", 60));
     p.races = jsonUintArray(json, "races");
     p.classes = jsonUintArray(json, "classes");
+    p.preloadDbcs = jsonStringArray(json, "preloadDbcs");
+    if (p.preloadDbcs.empty()) p.preloadDbcs = kDefaultPreloadDbcs;
 
     if (p.id.empty() || p.build == 0) {
         LOG_WARNING("ExpansionRegistry: skipping invalid profile at ", jsonPath);
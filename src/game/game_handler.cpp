@@ -19,6 +19,7 @@
 #include "pipeline/asset_manager.hpp"
 #include "pipeline/dbc_loader.hpp"
 #include "core/logger.hpp"
+#include "core/metrics.hpp"
 #include <glm/gtx/quaternion.hpp>
 #include <algorithm>
 #include <cmath>
@@ -187,6 +188,7 @@ bool GameHandler::connect(const std::string& host,
     wardenGateNextStatusLog_ = 2.0f;
     wardenPacketsAfterGate_ = 0;
     wardenCharEnumBlockedLogged_ = false;
+    stopWardenWorker();
     wardenCrypto_.reset();
     wardenState_ = WardenState::WAIT_MODULE_USE;
     wardenModuleHash_.clear();
@@ -244,6 +246,7 @@ void GameHandler::disconnect() {
     wardenGateNextStatusLog_ = 2.0f;
     wardenPacketsAfterGate_ = 0;
     wardenCharEnumBlockedLogged_ = false;
+    stopWardenWorker();
     wardenCrypto_.reset();
     wardenState_ = WardenState::WAIT_MODULE_USE;
     wardenModuleHash_.clear();
@@ -257,7 +260,7 @@ void GameHandler::disconnect() {
 
 void GameHandler::resetDbcCaches() {
     spellNameCacheLoaded_ = false;
-    spellNameCache_.clear();
+    spellTable_.reset();
     skillLineDbcLoaded_ = false;
     skillLineNames_.clear();
     skillLineCategories_.clear();
@@ -315,6 +318,9 @@ void GameHandler::update(float deltaTime) {
         return;
     }
 
+    // Send replies the Warden worker has produced since last frame
+    flushWardenResponses();
+
     // Post-gate visibility: determine whether server goes silent or closes after Warden requirement.
     if (wardenGateSeen_ && socket && socket->isConnected()) {
         wardenGateElapsed_ += deltaTime;
@@ -720,6 +726,9 @@ void GameHandler::update(float deltaTime) {
             }
         }
 
+        // Sync SoA hot data + spatial grid with this frame's positions
+        entityManager.updateSpatialIndex();
+
         auto entityEnd = std::chrono::high_resolution_clock::now();
         entityUpdateTime += std::chrono::duration<float, std::milli>(entityEnd - entityStart).count();
     }
@@ -747,6 +756,13 @@ void GameHandler::handlePacket(network::Packet& packet) {
         return;
     }
 
+    static auto& packetCount = core::Metrics::getInstance().counter(
+        "wowee_packets_handled_total", "World packets dispatched by GameHandler");
+    static auto& handleTime = core::Metrics::getInstance().histogram(
+        "wowee_packet_handle_seconds", "Time spent handling one world packet");
+    packetCount.add();
+    core::ScopedTimer handleTimer(handleTime);
+
     uint16_t opcode = packet.getOpcode();
 
     // Vanilla compatibility aliases:
@@ -1213,9 +1229,9 @@ void GameHandler::handlePacket(network::Packet& packet) {
                 LOG_INFO("Added spell ", spellId, " to known spells (trainer purchase)");
             }
 
-            const std::string& name = getSpellName(spellId);
+            std::string_view name = getSpellName(spellId);
             if (!name.empty())
-                addSystemChatMessage("You have learned " + name + ".");
+                addSystemChatMessage("You have learned " + std::string(name) + ".");
             else
                 addSystemChatMessage("Spell learned.");
             break;
@@ -1232,7 +1248,7 @@ void GameHandler::handlePacket(network::Packet& packet) {
             LOG_WARNING("Trainer buy spell failed: guid=", trainerGuid,
                        " spellId=", spellId, " error=", errorCode);
 
-            const std::string& spellName = getSpellName(spellId);
+            std::string_view spellName = getSpellName(spellId);
             std::string msg = "Cannot learn ";
             if (!spellName.empty()) msg += spellName;
             else msg += "spell #" + std::to_string(spellId);
@@ -2479,6 +2495,74 @@ void GameHandler::handleWardenData(network::Packet& packet) {
         wardenState_ = WardenState::WAIT_MODULE_USE;
     }
 
+    // Decode, module loading and check handling run on the Warden worker
+    startWardenWorker();
+    {
+        std::lock_guard<std::mutex> lock(wardenMutex_);
+        wardenInbox_.push_back(data);
+    }
+    wardenCV_.notify_one();
+}
+
+void GameHandler::startWardenWorker() {
+    if (wardenWorker_.joinable()) {
+        return;
+    }
+    wardenWorkerStop_ = false;
+    wardenWorker_ = std::thread(&GameHandler::wardenWorkerLoop, this);
+}
+
+void GameHandler::stopWardenWorker() {
+    if (!wardenWorker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wardenMutex_);
+        wardenWorkerStop_ = true;
+    }
+    wardenCV_.notify_all();
+    wardenWorker_.join();
+
+    std::lock_guard<std::mutex> lock(wardenMutex_);
+    wardenInbox_.clear();
+    wardenOutbox_.clear();
+}
+
+void GameHandler::wardenWorkerLoop() {
+    for (;;) {
+        std::vector<uint8_t> payload;
+        {
+            std::unique_lock<std::mutex> lock(wardenMutex_);
+            wardenCV_.wait(lock, [this] { return wardenWorkerStop_ || !wardenInbox_.empty(); });
+            if (wardenWorkerStop_) {
+                return;
+            }
+            payload = std::move(wardenInbox_.front());
+            wardenInbox_.pop_front();
+        }
+        processWardenPayload(payload);
+    }
+}
+
+void GameHandler::flushWardenResponses() {
+    std::deque<std::vector<uint8_t>> ready;
+    {
+        std::lock_guard<std::mutex> lock(wardenMutex_);
+        ready.swap(wardenOutbox_);
+    }
+    for (const auto& encrypted : ready) {
+        network::Packet response(wireOpcode(Opcode::CMSG_WARDEN_DATA));
+        for (uint8_t byte : encrypted) {
+            response.writeUInt8(byte);
+        }
+        if (socket && socket->isConnected()) {
+            socket->send(response);
+            LOG_INFO("Warden: Sent response (", encrypted.size(), " bytes)");
+        }
+    }
+}
+
+void GameHandler::processWardenPayload(const std::vector<uint8_t>& data) {
     // Decrypt the payload
     std::vector<uint8_t> decrypted = wardenCrypto_->decrypt(data);
 
@@ -2502,17 +2586,14 @@ void GameHandler::handleWardenData(network::Packet& packet) {
 
     uint8_t wardenOpcode = decrypted[0];
 
-    // Helper to send an encrypted Warden response
+    // Helper to queue an encrypted Warden response (sent by flushWardenResponses)
     auto sendWardenResponse = [&](const std::vector<uint8_t>& plaintext) {
         std::vector<uint8_t> encrypted = wardenCrypto_->encrypt(plaintext);
-        network::Packet response(wireOpcode(Opcode::CMSG_WARDEN_DATA));
-        for (uint8_t byte : encrypted) {
-            response.writeUInt8(byte);
-        }
-        if (socket && socket->isConnected()) {
-            socket->send(response);
-            LOG_INFO("Warden: Sent response (", plaintext.size(), " bytes plaintext)");
+        {
+            std::lock_guard<std::mutex> lock(wardenMutex_);
+            wardenOutbox_.push_back(std::move(encrypted));
         }
+        LOG_INFO("Warden: Queued response (", plaintext.size(), " bytes plaintext)");
     };
 
     switch (wardenOpcode) {
@@ -2598,11 +2679,23 @@ void GameHandler::handleWardenData(network::Packet& packet) {
                     }
                 }
 
-                // Load the module (decrypt, decompress, parse, relocate)
+                // Load the module (decrypt, decompress, parse, relocate); a
+                // post-init snapshot from an earlier session skips module init
                 wardenLoadedModule_ = std::make_shared<WardenModule>();
+                std::vector<uint8_t> snapshot;
+                if (wardenModuleManager_ && wardenModuleManager_->loadCachedSnapshot(wardenModuleHash_, snapshot)) {
+                    wardenLoadedModule_->setInitSnapshot(std::move(snapshot));
+                }
                 if (wardenLoadedModule_->load(wardenModuleData_, wardenModuleHash_, wardenModuleKey_)) {
                     LOG_INFO("Warden: Module loaded successfully (image size=",
-                             wardenLoadedModule_->getModuleSize(), " bytes)");
+                             wardenLoadedModule_->getModuleSize(), " bytes",
+                             wardenLoadedModule_->isRestoredFromSnapshot() ? ", restored from snapshot)" : ")");
+                    if (wardenModuleManager_ && !wardenLoadedModule_->isRestoredFromSnapshot()) {
+                        snapshot = wardenLoadedModule_->saveInitSnapshot();
+                        if (!snapshot.empty()) {
+                            wardenModuleManager_->cacheSnapshot(wardenModuleHash_, snapshot);
+                        }
+                    }
                 } else {
                     LOG_ERROR("Warden: Module loading FAILED");
                     wardenLoadedModule_.reset();
@@ -4876,20 +4969,33 @@ void GameHandler::targetLastTarget() {
 }
 
 void GameHandler::targetEnemy(bool reverse) {
-    // Get list of hostile entities
-    std::vector<uint64_t> hostiles;
-    auto& entities = entityManager.getEntities();
+    auto playerEntity = entityManager.getEntity(playerGuid);
+    if (!playerEntity) {
+        addSystemChatMessage("No enemies in range.");
+        return;
+    }
+    const float px = playerEntity->getX(), py = playerEntity->getY(), pz = playerEntity->getZ();
 
-    for (const auto& [guid, entity] : entities) {
-        if (entity->getType() == ObjectType::UNIT) {
-            // Check if hostile (this is simplified - would need faction checking)
-            auto unit = std::dynamic_pointer_cast<Unit>(entity);
-            if (unit && guid != playerGuid) {
-                hostiles.push_back(guid);
-            }
+    // Not cycling from a living hostile: the nearest one wins, no list needed
+    auto target = getTarget();
+    auto* targetUnit = (target && target->getType() == ObjectType::UNIT)
+        ? static_cast<Unit*>(target.get()) : nullptr;
+    if (!reverse && !(targetUnit && targetUnit->isHostile() && targetUnit->getHealth() > 0)) {
+        entityManager.updateSpatialIndex();
+        uint64_t nearest = entityManager.queryNearestHostile(px, py, pz, MAX_TARGETING_RANGE,
+                                                             playerGuid, EntityManager::KIND_UNITS);
+        if (nearest == 0) {
+            addSystemChatMessage("No enemies in range.");
+            return;
         }
+        setTarget(nearest);
+        return;
     }
 
+    // Get list of living hostile units, nearest first
+    std::vector<uint64_t> hostiles;
+    collectTargetCandidates(EntityManager::KIND_UNITS, true, px, py, pz, hostiles);
+
     if (hostiles.empty()) {
         addSystemChatMessage("No enemies in range.");
         return;
@@ -4921,14 +5027,11 @@ void GameHandler::targetEnemy(bool reverse) {
 }
 
 void GameHandler::targetFriend(bool reverse) {
-    // Get list of friendly entities (players)
+    // Get list of friendly entities (players), nearest first
     std::vector<uint64_t> friendlies;
-    auto& entities = entityManager.getEntities();
-
-    for (const auto& [guid, entity] : entities) {
-        if (entity->getType() == ObjectType::PLAYER && guid != playerGuid) {
-            friendlies.push_back(guid);
-        }
+    if (auto playerEntity = entityManager.getEntity(playerGuid)) {
+        collectTargetCandidates(EntityManager::KIND_PLAYERS, false, playerEntity->getX(),
+                                playerEntity->getY(), playerEntity->getZ(), friendlies);
     }
 
     if (friendlies.empty()) {
@@ -4961,6 +5064,33 @@ void GameHandler::targetFriend(bool reverse) {
     }
 }
 
+void GameHandler::collectTargetCandidates(uint8_t kindMask, bool hostileOnly, float x, float y, float z,
+                                          std::vector<uint64_t>& out) {
+    out.clear();
+    struct EntityDist { uint64_t guid; float distSq; };
+    std::vector<EntityDist> sortable;
+
+    // Pick up anything that moved or changed since this frame's refresh
+    entityManager.updateSpatialIndex();
+
+    // Search the grid near (x, y, z) and widen only while nothing qualifies
+    std::vector<uint64_t> nearby;
+    for (float radius = TARGETING_RANGE; sortable.empty() && radius <= MAX_TARGETING_RANGE; radius *= 2.0f) {
+        entityManager.queryRadius(x, y, z, radius, kindMask, nearby);
+        for (uint64_t guid : nearby) {
+            if (guid == playerGuid) continue;
+            auto* unit = static_cast<Unit*>(entityManager.getEntity(guid).get());
+            if (hostileOnly && (!unit->isHostile() || unit->getHealth() == 0)) continue;
+            float dx = unit->getX() - x, dy = unit->getY() - y, dz = unit->getZ() - z;
+            sortable.push_back({guid, dx * dx + dy * dy + dz * dz});
+        }
+    }
+    std::sort(sortable.begin(), sortable.end(),
+              [](const EntityDist& a, const EntityDist& b) { return a.distSq < b.distSq; });
+    out.reserve(sortable.size());
+    for (const auto& ed : sortable) out.push_back(ed.guid);
+}
+
 void GameHandler::inspectTarget() {
     if (state != WorldState::IN_WORLD || !socket) {
         LOG_WARNING("Cannot inspect: not in world or not connected");
@@ -5756,29 +5886,10 @@ void GameHandler::tabTarget(float playerX, float playerY, float playerZ) {
 
     // Rebuild cycle list if stale (entity added/removed since last tab press).
     if (tabCycleStale) {
-        tabCycleList.clear();
         tabCycleIndex = -1;
-
-        struct EntityDist { uint64_t guid; float distance; };
-        std::vector<EntityDist> sortable;
-
-        for (const auto& [guid, entity] : entityManager.getEntities()) {
-            auto t = entity->getType();
-            if (t != ObjectType::UNIT && t != ObjectType::PLAYER) continue;
-            if (guid == playerGuid) continue;
-            if (!isValidTabTarget(entity)) continue;  // Skip dead / non-hostile
-            float dx = entity->getX() - playerX;
-            float dy = entity->getY() - playerY;
-            float dz = entity->getZ() - playerZ;
-            sortable.push_back({guid, std::sqrt(dx*dx + dy*dy + dz*dz)});
-        }
-
-        std::sort(sortable.begin(), sortable.end(),
-                  [](const EntityDist& a, const EntityDist& b) { return a.distance < b.distance; });
-
-        for (const auto& ed : sortable) {
-            tabCycleList.push_back(ed.guid);
-        }
+        // Living hostiles only, nearest first
+        collectTargetCandidates(EntityManager::KIND_UNITS | EntityManager::KIND_PLAYERS, true,
+                                playerX, playerY, playerZ, tabCycleList);
         tabCycleStale = false;
     }
 
@@ -5905,12 +6016,10 @@ void GameHandler::handleCreatureQueryResponse(network::Packet& packet) {
     if (data.isValid()) {
         creatureInfoCache[data.entry] = data;
         // Update all unit entities with this entry
-        for (auto& [guid, entity] : entityManager.getEntities()) {
-            if (entity->getType() == ObjectType::UNIT) {
-                auto unit = std::static_pointer_cast<Unit>(entity);
-                if (unit->getEntry() == data.entry) {
-                    unit->setName(data.name);
-                }
+        for (Entity* entity : entityManager.getHotData(EntityKind::UNIT).entity) {
+            auto* unit = static_cast<Unit*>(entity);
+            if (unit->getEntry() == data.entry) {
+                unit->setName(data.name);
             }
         }
     }
@@ -7761,9 +7870,9 @@ void GameHandler::handleSupercededSpell(network::Packet& packet) {
 
     LOG_INFO("Spell superceded: ", oldSpellId, " -> ", newSpellId);
 
-    const std::string& newName = getSpellName(newSpellId);
+    std::string_view newName = getSpellName(newSpellId);
     if (!newName.empty()) {
-        addSystemChatMessage("Upgraded to " + newName);
+        addSystemChatMessage("Upgraded to " + std::string(newName));
     }
 }
 
@@ -8987,18 +9096,9 @@ void GameHandler::loadSpellNameCache() {
         return;
     }
 
-    const auto* spellL = pipeline::getActiveDBCLayout() ? pipeline::getActiveDBCLayout()->getLayout("Spell") : nullptr;
-    uint32_t count = dbc->getRecordCount();
-    for (uint32_t i = 0; i < count; ++i) {
-        uint32_t id = dbc->getUInt32(i, spellL ? (*spellL)["ID"] : 0);
-        if (id == 0) continue;
-        std::string name = dbc->getString(i, spellL ? (*spellL)["Name"] : 136);
-        std::string rank = dbc->getString(i, spellL ? (*spellL)["Rank"] : 153);
-        if (!name.empty()) {
-            spellNameCache_[id] = {std::move(name), std::move(rank)};
-        }
-    }
-    LOG_INFO("Trainer: Loaded ", spellNameCache_.size(), " spell names from Spell.dbc");
+    // Names/ranks are read in place from the string block on lookup
+    spellTable_.bind(dbc);
+    LOG_INFO("Trainer: Bound Spell.dbc for spell names (", spellTable_.size(), " records)");
 }
 
 void GameHandler::loadSkillLineAbilityDbc() {
@@ -9178,14 +9278,14 @@ void GameHandler::loadTalentDbc() {
 
 static const std::string EMPTY_STRING;
 
-const std::string& GameHandler::getSpellName(uint32_t spellId) const {
-    auto it = spellNameCache_.find(spellId);
-    return (it != spellNameCache_.end()) ? it->second.name : EMPTY_STRING;
+std::string_view GameHandler::getSpellName(uint32_t spellId) const {
+    if (spellId == 0) return {};
+    return spellTable_.getStringById(spellId, pipeline::SpellRecord::Name);
 }
 
-const std::string& GameHandler::getSpellRank(uint32_t spellId) const {
-    auto it = spellNameCache_.find(spellId);
-    return (it != spellNameCache_.end()) ? it->second.rank : EMPTY_STRING;
+std::string_view GameHandler::getSpellRank(uint32_t spellId) const {
+    if (spellId == 0 || getSpellName(spellId).empty()) return {};
+    return spellTable_.getStringById(spellId, pipeline::SpellRecord::Rank);
 }
 
 const std::string& GameHandler::getSkillLineName(uint32_t spellId) const {
@@ -9688,9 +9788,10 @@ void GameHandler::applyTaxiMountForCurrentNode() {
 
 void GameHandler::startClientTaxiPath(const std::vector<uint32_t>& pathNodes) {
     taxiClientPath_.clear();
-    taxiClientIndex_ = 0;
+    taxiClientSpline_.clear();
     taxiClientActive_ = false;
-    taxiClientSegmentProgress_ = 0.0f;
+    taxiClientDistance_ = 0.0f;
+    taxiClientCursor_ = 0;
 
     // Build full spline path using TaxiPathNode waypoints (not just node positions)
     for (size_t i = 0; i + 1 < pathNodes.size(); i++) {
@@ -9737,6 +9838,10 @@ void GameHandler::startClientTaxiPath(const std::vector<uint32_t>& pathNodes) {
         return;
     }
 
+    // Clamped ends: the flight starts and lands exactly on the first/last waypoint
+    taxiClientSpline_.build(taxiClientPath_, false);
+    taxiClientSpline_.buildArcLengthTable();
+
     // Set initial orientation to face the first non-degenerate flight segment.
     glm::vec3 start = taxiClientPath_[0];
     glm::vec3 dir(0.0f);
@@ -9820,75 +9925,24 @@ void GameHandler::updateClientTaxi(float deltaTime) {
             LOG_INFO("Taxi flight landed (client path)");
     };
 
-    if (taxiClientIndex_ + 1 >= taxiClientPath_.size()) {
+    // Advance a fixed distance along the curve (arc-length parameterized), so
+    // speed stays constant through dense node clusters and tight turns.
+    taxiClientDistance_ += taxiClientSpeed_ * deltaTime;
+    if (taxiClientSpline_.empty() || taxiClientDistance_ >= taxiClientSpline_.totalLength()) {
         finishTaxiFlight();
         return;
     }
 
-    float remainingDistance = taxiClientSegmentProgress_ + (taxiClientSpeed_ * deltaTime);
-    glm::vec3 start(0.0f);
-    glm::vec3 end(0.0f);
-    glm::vec3 dir(0.0f);
-    float segmentLen = 0.0f;
+    size_t segment = 0;
     float t = 0.0f;
-
-    // Consume as many tiny/finished segments as needed this frame so taxi doesn't stall
-    // on dense/degenerate node clusters near takeoff/landing.
-    while (true) {
-        if (taxiClientIndex_ + 1 >= taxiClientPath_.size()) {
-            finishTaxiFlight();
-            return;
-        }
-
-        start = taxiClientPath_[taxiClientIndex_];
-        end = taxiClientPath_[taxiClientIndex_ + 1];
-        dir = end - start;
-        segmentLen = glm::length(dir);
-
-        if (segmentLen < 0.01f) {
-            taxiClientIndex_++;
-            continue;
-        }
-
-        if (remainingDistance >= segmentLen) {
-            remainingDistance -= segmentLen;
-            taxiClientIndex_++;
-            taxiClientSegmentProgress_ = 0.0f;
-            continue;
-        }
-
-        taxiClientSegmentProgress_ = remainingDistance;
-        t = taxiClientSegmentProgress_ / segmentLen;
-        break;
-    }
-
-    // Use Catmull-Rom spline for smooth interpolation between waypoints
-    // Get surrounding points for spline curve
-    glm::vec3 p0 = (taxiClientIndex_ > 0) ? taxiClientPath_[taxiClientIndex_ - 1] : start;
-    glm::vec3 p1 = start;
-    glm::vec3 p2 = end;
-    glm::vec3 p3 = (taxiClientIndex_ + 2 < taxiClientPath_.size()) ?
-                   taxiClientPath_[taxiClientIndex_ + 2] : end;
-
-    // Catmull-Rom spline formula for smooth curves
-    float t2 = t * t;
-    float t3 = t2 * t;
-    glm::vec3 nextPos = 0.5f * (
-        (2.0f * p1) +
-        (-p0 + p2) * t +
-        (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
-        (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3
-    );
+    taxiClientSpline_.locateByDistance(taxiClientDistance_, taxiClientCursor_, segment, t);
+    glm::vec3 nextPos = taxiClientSpline_.evaluate(segment, t);
 
     // Calculate smooth direction for orientation (tangent to spline)
-    glm::vec3 tangent = 0.5f * (
-        (-p0 + p2) +
-        2.0f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t +
-        3.0f * (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t2
-    );
+    glm::vec3 tangent = taxiClientSpline_.derivative(segment, t);
     float tangentLen = glm::length(tangent);
     if (tangentLen < 0.0001f) {
-        tangent = dir;
+        tangent = taxiClientSpline_.chord(segment);
         tangentLen = glm::length(tangent);
         if (tangentLen < 0.0001f) {
             tangent = glm::vec3(std::cos(movementInfo.orientation), std::sin(movementInfo.orientation), 0.0f);
@@ -0,0 +1,153 @@
+#include "game/spline_path.hpp"
+#include <algorithm>
+
+namespace wowee::game {
+
+void SplinePath::build(const std::vector<glm::vec3>& points, bool wrapIndices) {
+    segments_.clear();
+    knotMs_.clear();
+    knotsSorted_ = true;
+    arcLength_.clear();
+
+    const size_t n = points.size();
+    if (n < 2) return;
+    segments_.reserve(n - 1);
+
+    for (size_t i = 0; i + 1 < n; i++) {
+        size_t i0, i3;
+        if (wrapIndices) {
+            i0 = (i == 0) ? (n - 1) : (i - 1);
+            i3 = (i + 2) % n;
+        } else {
+            i0 = (i == 0) ? 0 : (i - 1);
+            i3 = (i + 2 < n) ? (i + 2) : (n - 1);
+        }
+        const glm::vec3& p0 = points[i0];
+        const glm::vec3& p1 = points[i];
+        const glm::vec3& p2 = points[i + 1];
+        const glm::vec3& p3 = points[i3];
+
+        Segment seg;
+        seg.a = p1;
+        seg.b = 0.5f * (-p0 + p2);
+        seg.c = 0.5f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3);
+        seg.d = 0.5f * (-p0 + 3.0f * p1 - 3.0f * p2 + p3);
+        segments_.push_back(seg);
+    }
+}
+
+void SplinePath::setKnotTimes(std::vector<uint32_t> knotTimesMs) {
+    knotMs_ = std::move(knotTimesMs);
+    knotsSorted_ = std::is_sorted(knotMs_.begin(), knotMs_.end());
+}
+
+void SplinePath::buildArcLengthTable() {
+    arcLength_.clear();
+    if (segments_.empty()) return;
+
+    constexpr uint32_t K = ARC_SAMPLES_PER_SEGMENT;
+    arcLength_.reserve(segments_.size() * K + 1);
+    float total = 0.0f;
+    for (size_t s = 0; s < segments_.size(); s++) {
+        glm::vec3 prev = segments_[s].a;
+        for (uint32_t k = 1; k <= K; k++) {
+            arcLength_.push_back(total);
+            glm::vec3 cur = evaluate(s, static_cast<float>(k) / K);
+            total += glm::length(cur - prev);
+            prev = cur;
+        }
+    }
+    arcLength_.push_back(total);
+}
+
+void SplinePath::clear() {
+    segments_.clear();
+    knotMs_.clear();
+    knotsSorted_ = true;
+    arcLength_.clear();
+}
+
+glm::vec3 SplinePath::evaluate(size_t segment, float t) const {
+    const Segment& s = segments_[segment];
+    return s.a + t * (s.b + t * (s.c + t * s.d));
+}
+
+glm::vec3 SplinePath::derivative(size_t segment, float t) const {
+    const Segment& s = segments_[segment];
+    return s.b + t * (2.0f * s.c + t * (3.0f * s.d));
+}
+
+glm::vec3 SplinePath::chord(size_t segment) const {
+    const Segment& s = segments_[segment];
+    return s.b + s.c + s.d;
+}
+
+size_t SplinePath::findSegmentByTime(uint32_t timeMs, uint32_t& cursor) const {
+    const size_t n = segments_.size();
+    if (n == 0 || knotMs_.size() != n + 1) return 0;
+
+    auto contains = [&](size_t i) {
+        return timeMs >= knotMs_[i] && timeMs < knotMs_[i + 1];
+    };
+
+    // Playback advances at most a segment or so per frame
+    if (cursor < n) {
+        if (contains(cursor)) return cursor;
+        if (cursor + 1 < n && contains(cursor + 1)) return ++cursor;
+    }
+
+    size_t segment = n - 1;
+    if (knotsSorted_) {
+        size_t j = static_cast<size_t>(
+            std::upper_bound(knotMs_.begin(), knotMs_.end(), timeMs) - knotMs_.begin());
+        if (j > 0 && j <= n) segment = j - 1;
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            if (contains(i)) {
+                segment = i;
+                break;
+            }
+        }
+    }
+    cursor = static_cast<uint32_t>(segment);
+    return segment;
+}
+
+float SplinePath::segmentParam(size_t segment, uint32_t timeMs) const {
+    if (segment + 1 >= knotMs_.size()) return 0.0f;
+    uint32_t t1Ms = knotMs_[segment];
+    uint32_t t2Ms = knotMs_[segment + 1];
+    uint32_t segmentDurationMs = (t2Ms > t1Ms) ? (t2Ms - t1Ms) : 1;
+    // Unsigned wrap for timeMs < t1Ms clamps to the segment end, as before
+    float t = static_cast<float>(timeMs - t1Ms) / static_cast<float>(segmentDurationMs);
+    return glm::clamp(t, 0.0f, 1.0f);
+}
+
+void SplinePath::locateByDistance(float distance, uint32_t& cursor, size_t& segment, float& t) const {
+    segment = 0;
+    t = 0.0f;
+    if (arcLength_.size() < 2) return;
+
+    const size_t intervals = arcLength_.size() - 1;
+    distance = glm::clamp(distance, 0.0f, arcLength_.back());
+
+    size_t i = cursor;
+    constexpr size_t kMaxWalk = 8;
+    if (i >= intervals || distance < arcLength_[i] ||
+        (i + kMaxWalk < intervals && distance >= arcLength_[i + kMaxWalk])) {
+        size_t j = static_cast<size_t>(
+            std::upper_bound(arcLength_.begin(), arcLength_.end(), distance) - arcLength_.begin());
+        i = (j == 0) ? 0 : std::min(j - 1, intervals - 1);
+    } else {
+        while (i + 1 < intervals && arcLength_[i + 1] <= distance) i++;
+    }
+    cursor = static_cast<uint32_t>(i);
+
+    constexpr uint32_t K = ARC_SAMPLES_PER_SEGMENT;
+    float len = arcLength_[i + 1] - arcLength_[i];
+    float f = (len > 0.0f) ? (distance - arcLength_[i]) / len : 0.0f;
+    segment = i / K;
+    t = glm::clamp((static_cast<float>(i % K) + f) / K, 0.0f, 1.0f);
+}
+
+} // namespace wowee::game
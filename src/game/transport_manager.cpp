@@ -14,6 +14,25 @@
 
 namespace wowee::game {
 
+namespace {
+
+// Precompute the path's spline segments and knot-time table. Must run
+// whenever points/looping change, before the path is stored.
+void buildPathSpline(TransportPath& path) {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> knotTimes;
+    positions.reserve(path.points.size());
+    knotTimes.reserve(path.points.size());
+    for (const auto& pt : path.points) {
+        positions.push_back(pt.pos);
+        knotTimes.push_back(pt.tMs);
+    }
+    path.spline.build(positions, path.looping);
+    path.spline.setKnotTimes(std::move(knotTimes));
+}
+
+} // namespace
+
 TransportManager::TransportManager() = default;
 TransportManager::~TransportManager() = default;
 
@@ -175,6 +194,7 @@ void TransportManager::loadPathFromNodes(uint32_t pathId, const std::vector<glm:
         path.points.push_back({0, waypoints[0]});
         path.durationMs = 0;
         path.looping = false;
+        buildPathSpline(path);
         paths_[pathId] = path;
         LOG_INFO("TransportManager: Loaded stationary path ", pathId);
         return;
@@ -203,6 +223,7 @@ void TransportManager::loadPathFromNodes(uint32_t pathId, const std::vector<glm:
     }
 
     path.durationMs = cumulativeMs;
+    buildPathSpline(path);
     paths_[pathId] = path;
 
     LOG_INFO("TransportManager: Loaded path ", pathId,
@@ -281,7 +302,7 @@ void TransportManager::updateTransportMovement(ActiveTransport& transport, float
     }
 
     // Evaluate position from time (path is local offsets, add base position)
-    glm::vec3 pathOffset = evalTimedCatmullRom(path, pathTimeMs);
+    glm::vec3 pathOffset = evalTimedCatmullRom(path, pathTimeMs, &transport.pathSegmentCursor);
     // Guard against bad fallback Z curves on some remapped transport paths (notably icebreakers),
     // where path offsets can sink far below sea level when we only have spawn-time data.
     if (transport.useClientAnimation && transport.serverUpdateCount <= 1) {
@@ -300,7 +321,7 @@ void TransportManager::updateTransportMovement(ActiveTransport& transport, float
         float effectiveYaw = transport.serverYaw + (transport.serverYawFlipped180 ? glm::pi<float>() : 0.0f);
         transport.rotation = glm::angleAxis(effectiveYaw, glm::vec3(0.0f, 0.0f, 1.0f));
     } else {
-        transport.rotation = orientationFromTangent(path, pathTimeMs);
+        transport.rotation = orientationFromTangent(path, pathTimeMs, &transport.pathSegmentCursor);
     }
 
     // Update transform matrices
@@ -328,159 +349,38 @@ void TransportManager::updateTransportMovement(ActiveTransport& transport, float
     }
 }
 
-glm::vec3 TransportManager::evalTimedCatmullRom(const TransportPath& path, uint32_t pathTimeMs) {
+glm::vec3 TransportManager::evalTimedCatmullRom(const TransportPath& path, uint32_t pathTimeMs, uint32_t* segmentCursor) {
     if (path.points.empty()) {
         return glm::vec3(0.0f);
     }
-    if (path.points.size() == 1) {
+    if (path.points.size() == 1 || path.spline.empty()) {
         return path.points[0].pos;
     }
 
-    // Find the segment containing pathTimeMs
-    size_t segmentIdx = 0;
-    bool found = false;
-
-    for (size_t i = 0; i + 1 < path.points.size(); i++) {
-        if (pathTimeMs >= path.points[i].tMs && pathTimeMs < path.points[i + 1].tMs) {
-            segmentIdx = i;
-            found = true;
-            break;
-        }
-    }
-
-    // Handle not found (timing gaps or past last segment)
-    if (!found) {
-        // For time-closed paths (explicit wrap point), last valid segment is points.size() - 2
-        segmentIdx = (path.points.size() >= 2) ? (path.points.size() - 2) : 0;
-    }
-
-    size_t numPoints = path.points.size();
-
-    // Get 4 control points for Catmull-Rom
-    // Helper to clamp index (no wrapping for non-looping paths)
-    auto idxClamp = [&](size_t i) -> size_t {
-        return (i >= numPoints) ? (numPoints - 1) : i;
-    };
-
-    size_t p0Idx, p1Idx, p2Idx, p3Idx;
-    p1Idx = segmentIdx;
-
-    if (path.looping) {
-        // Index-wrapped path (old DBC style with looping=true)
-        p0Idx = (segmentIdx == 0) ? (numPoints - 1) : (segmentIdx - 1);
-        p2Idx = (segmentIdx + 1) % numPoints;
-        p3Idx = (segmentIdx + 2) % numPoints;
-    } else {
-        // Time-closed path (explicit wrap point at end, looping=false)
-        // No index wrapping - points are sequential with possible duplicate at end
-        p0Idx = (segmentIdx == 0) ? 0 : (segmentIdx - 1);
-        p2Idx = idxClamp(segmentIdx + 1);
-        p3Idx = idxClamp(segmentIdx + 2);
-    }
-
-    glm::vec3 p0 = path.points[p0Idx].pos;
-    glm::vec3 p1 = path.points[p1Idx].pos;
-    glm::vec3 p2 = path.points[p2Idx].pos;
-    glm::vec3 p3 = path.points[p3Idx].pos;
-
-    // Calculate t (0.0 to 1.0 within segment)
-    // No special case needed - wrap point is explicit in the array now
-    uint32_t t1Ms = path.points[p1Idx].tMs;
-    uint32_t t2Ms = path.points[p2Idx].tMs;
-    uint32_t segmentDurationMs = (t2Ms > t1Ms) ? (t2Ms - t1Ms) : 1;
-    float t = (float)(pathTimeMs - t1Ms) / (float)segmentDurationMs;
-    t = glm::clamp(t, 0.0f, 1.0f);
-
-    // Catmull-Rom spline formula
-    float t2 = t * t;
-    float t3 = t2 * t;
-
-    glm::vec3 result = 0.5f * (
-        (2.0f * p1) +
-        (-p0 + p2) * t +
-        (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
-        (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3
-    );
-
-    return result;
+    // Segment containing pathTimeMs (last segment for timing gaps / past the end)
+    uint32_t localCursor = 0;
+    uint32_t& cursor = segmentCursor ? *segmentCursor : localCursor;
+    size_t segmentIdx = path.spline.findSegmentByTime(pathTimeMs, cursor);
+    return path.spline.evaluate(segmentIdx, path.spline.segmentParam(segmentIdx, pathTimeMs));
 }
 
-glm::quat TransportManager::orientationFromTangent(const TransportPath& path, uint32_t pathTimeMs) {
-    if (path.points.empty()) {
-        return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-    }
-    if (path.points.size() == 1) {
+glm::quat TransportManager::orientationFromTangent(const TransportPath& path, uint32_t pathTimeMs, uint32_t* segmentCursor) {
+    if (path.points.size() <= 1 || path.spline.empty()) {
         return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
     }
 
-    // Find the segment containing pathTimeMs
-    size_t segmentIdx = 0;
-    bool found = false;
-
-    for (size_t i = 0; i + 1 < path.points.size(); i++) {
-        if (pathTimeMs >= path.points[i].tMs && pathTimeMs < path.points[i + 1].tMs) {
-            segmentIdx = i;
-            found = true;
-            break;
-        }
-    }
-
-    // Handle not found (timing gaps or past last segment)
-    if (!found) {
-        // For time-closed paths (explicit wrap point), last valid segment is points.size() - 2
-        segmentIdx = (path.points.size() >= 2) ? (path.points.size() - 2) : 0;
-    }
-
-    size_t numPoints = path.points.size();
-
-    // Get 4 control points for tangent calculation
-    // Helper to clamp index (no wrapping for non-looping paths)
-    auto idxClamp = [&](size_t i) -> size_t {
-        return (i >= numPoints) ? (numPoints - 1) : i;
-    };
-
-    size_t p0Idx, p1Idx, p2Idx, p3Idx;
-    p1Idx = segmentIdx;
-
-    if (path.looping) {
-        // Index-wrapped path (old DBC style with looping=true)
-        p0Idx = (segmentIdx == 0) ? (numPoints - 1) : (segmentIdx - 1);
-        p2Idx = (segmentIdx + 1) % numPoints;
-        p3Idx = (segmentIdx + 2) % numPoints;
-    } else {
-        // Time-closed path (explicit wrap point at end, looping=false)
-        // No index wrapping - points are sequential with possible duplicate at end
-        p0Idx = (segmentIdx == 0) ? 0 : (segmentIdx - 1);
-        p2Idx = idxClamp(segmentIdx + 1);
-        p3Idx = idxClamp(segmentIdx + 2);
-    }
-
-    glm::vec3 p0 = path.points[p0Idx].pos;
-    glm::vec3 p1 = path.points[p1Idx].pos;
-    glm::vec3 p2 = path.points[p2Idx].pos;
-    glm::vec3 p3 = path.points[p3Idx].pos;
-
-    // Calculate t (0.0 to 1.0 within segment)
-    // No special case needed - wrap point is explicit in the array now
-    uint32_t t1Ms = path.points[p1Idx].tMs;
-    uint32_t t2Ms = path.points[p2Idx].tMs;
-    uint32_t segmentDurationMs = (t2Ms > t1Ms) ? (t2Ms - t1Ms) : 1;
-    float t = (float)(pathTimeMs - t1Ms) / (float)segmentDurationMs;
-    t = glm::clamp(t, 0.0f, 1.0f);
+    uint32_t localCursor = 0;
+    uint32_t& cursor = segmentCursor ? *segmentCursor : localCursor;
+    size_t segmentIdx = path.spline.findSegmentByTime(pathTimeMs, cursor);
 
     // Tangent of Catmull-Rom spline (derivative)
-    float t2 = t * t;
-    glm::vec3 tangent = 0.5f * (
-        (-p0 + p2) +
-        (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * 2.0f * t +
-        (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * 3.0f * t2
-    );
+    glm::vec3 tangent = path.spline.derivative(segmentIdx, path.spline.segmentParam(segmentIdx, pathTimeMs));
 
     // Normalize tangent
     float tangentLength = glm::length(tangent);
     if (tangentLength < 0.001f) {
         // Fallback to simple direction
-        tangent = p2 - p1;
+        tangent = path.spline.chord(segmentIdx);
         tangentLength = glm::length(tangent);
     }
 
@@ -765,18 +665,13 @@ bool TransportManager::loadTransportAnimationDBC(pipeline::AssetManager* assetMg
         return false;
     }
 
-    // Load DBC file
-    auto dbcData = assetMgr->readFile("DBFilesClient\\TransportAnimation.dbc");
-    if (dbcData.empty()) {
+    // Shared with the DBC preload set (expansion CSV first, then binary)
+    auto dbcFile = assetMgr->loadDBC("TransportAnimation.dbc");
+    if (!dbcFile || !dbcFile->isLoaded()) {
         LOG_WARNING("TransportAnimation.dbc not found - transports will use fallback paths");
         return false;
     }
-
-    pipeline::DBCFile dbc;
-    if (!dbc.load(dbcData)) {
-        LOG_ERROR("Failed to parse TransportAnimation.dbc");
-        return false;
-    }
+    const pipeline::DBCFile& dbc = *dbcFile;
 
     LOG_INFO("TransportAnimation.dbc: ", dbc.getRecordCount(), " records, ",
              dbc.getFieldCount(), " fields per record");
@@ -934,6 +829,7 @@ bool TransportManager::loadTransportAnimationDBC(pipeline::AssetManager* assetMg
         path.durationMs = durationMs;
         path.zOnly = isZOnly;
         path.fromDBC = true;
+        buildPathSpline(path);
         paths_[transportEntry] = path;
         pathsLoaded++;
 
@@ -963,17 +859,13 @@ bool TransportManager::loadTaxiPathNodeDBC(pipeline::AssetManager* assetMgr) {
         return false;
     }
 
-    auto dbcData = assetMgr->readFile("DBFilesClient\\TaxiPathNode.dbc");
-    if (dbcData.empty()) {
+    // Shared with the DBC preload set (expansion CSV first, then binary)
+    auto dbcFile = assetMgr->loadDBC("TaxiPathNode.dbc");
+    if (!dbcFile || !dbcFile->isLoaded()) {
         LOG_WARNING("TaxiPathNode.dbc not found - MO_TRANSPORT will use fallback paths");
         return false;
     }
-
-    pipeline::DBCFile dbc;
-    if (!dbc.load(dbcData)) {
-        LOG_ERROR("Failed to parse TaxiPathNode.dbc");
-        return false;
-    }
+    const pipeline::DBCFile& dbc = *dbcFile;
 
     LOG_INFO("TaxiPathNode.dbc: ", dbc.getRecordCount(), " records, ",
              dbc.getFieldCount(), " fields per record");
@@ -1071,6 +963,7 @@ bool TransportManager::loadTaxiPathNodeDBC(pipeline::AssetManager* assetMgr) {
         path.fromDBC = true;
         path.worldCoords = true;  // TaxiPathNode uses absolute world coordinates
 
+        buildPathSpline(path);
         taxiPaths_[pathId] = path;
         pathsLoaded++;
     }
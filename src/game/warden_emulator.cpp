@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cstring>
 #include <chrono>
+#include <iterator>
 
 // Unicorn Engine headers
 #include <unicorn/unicorn.h>
@@ -15,6 +16,18 @@ constexpr uint32_t STACK_SIZE = 0x00100000;  // 1MB stack
 constexpr uint32_t HEAP_BASE  = 0x00200000;  // 2MB
 constexpr uint32_t HEAP_SIZE  = 0x01000000;  // 16MB heap
 constexpr uint32_t API_STUB_BASE = 0x70000000; // API stub area (high memory)
+constexpr uint32_t API_STUB_SIZE = 0x00010000;
+
+// Snapshot blob header
+constexpr uint32_t SNAPSHOT_MAGIC = 0x554D4557; // "WEMU"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// Registers captured in a snapshot
+constexpr int SNAPSHOT_REGISTERS[] = {
+    UC_X86_REG_EAX, UC_X86_REG_EBX, UC_X86_REG_ECX, UC_X86_REG_EDX,
+    UC_X86_REG_ESI, UC_X86_REG_EDI, UC_X86_REG_EBP, UC_X86_REG_ESP,
+    UC_X86_REG_EIP, UC_X86_REG_EFLAGS,
+};
 
 WardenEmulator::WardenEmulator()
     : uc_(nullptr)
@@ -96,7 +109,7 @@ bool WardenEmulator::initialize(const void* moduleCode, size_t moduleSize, uint3
     }
 
     // Map API stub area
-    err = uc_mem_map(uc_, apiStubBase_, 0x10000, UC_PROT_ALL);
+    err = uc_mem_map(uc_, apiStubBase_, API_STUB_SIZE, UC_PROT_ALL);
     if (err != UC_ERR_OK) {
         std::cerr << "[WardenEmulator] Failed to map API stub area: " << uc_strerror(err) << std::endl;
         uc_close(uc_);
@@ -280,6 +293,138 @@ void WardenEmulator::setRegister(int regId, uint32_t value) {
     }
 }
 
+std::vector<uint8_t> WardenEmulator::saveSnapshot() const {
+    std::vector<uint8_t> out;
+    if (!uc_) return out;
+
+    auto put32 = [&](uint32_t v) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+        out.insert(out.end(), p, p + 4);
+    };
+
+    put32(SNAPSHOT_MAGIC);
+    put32(SNAPSHOT_VERSION);
+    put32(moduleBase_);
+    put32(moduleSize_);
+    put32(nextHeapAddr_);
+
+    put32(static_cast<uint32_t>(std::size(SNAPSHOT_REGISTERS)));
+    for (int reg : SNAPSHOT_REGISTERS) {
+        uint32_t value = 0;
+        uc_reg_read(uc_, reg, &value);
+        put32(static_cast<uint32_t>(reg));
+        put32(value);
+    }
+
+    put32(static_cast<uint32_t>(allocations_.size()));
+    for (const auto& [addr, size] : allocations_) {
+        put32(addr);
+        put32(static_cast<uint32_t>(size));
+    }
+
+    // Only the parts of each mapping that can hold live state
+    uint32_t esp = 0;
+    uc_reg_read(uc_, UC_X86_REG_ESP, &esp);
+    uint32_t stackTop = stackBase_ + stackSize_;
+    uint32_t stackLive = (esp >= stackBase_ && esp < stackTop) ? (esp & ~0xFFFu) : stackBase_;
+    struct Region { uint32_t addr; uint32_t size; };
+    const Region regions[] = {
+        {moduleBase_, moduleSize_},
+        {stackLive, stackTop - stackLive},
+        {heapBase_, nextHeapAddr_ - heapBase_},
+        {apiStubBase_, API_STUB_SIZE},
+    };
+
+    put32(static_cast<uint32_t>(std::size(regions)));
+    for (const Region& r : regions) {
+        put32(r.addr);
+        put32(r.size);
+        size_t offset = out.size();
+        out.resize(offset + r.size);
+        if (r.size > 0 && uc_mem_read(uc_, r.addr, out.data() + offset, r.size) != UC_ERR_OK) {
+            std::cerr << "[WardenEmulator] Snapshot read failed at 0x" << std::hex << r.addr << std::dec << std::endl;
+            return {};
+        }
+    }
+
+    std::cout << "[WardenEmulator] Snapshot saved (" << out.size() << " bytes)" << std::endl;
+    return out;
+}
+
+bool WardenEmulator::restoreSnapshot(const std::vector<uint8_t>& snapshot) {
+    if (uc_) {
+        std::cerr << "[WardenEmulator] Already initialized" << std::endl;
+        return false;
+    }
+
+    size_t pos = 0;
+    auto get32 = [&](uint32_t& v) {
+        if (pos + 4 > snapshot.size()) return false;
+        std::memcpy(&v, snapshot.data() + pos, 4);
+        pos += 4;
+        return true;
+    };
+
+    uint32_t magic = 0, version = 0, base = 0, size = 0, nextHeap = 0, regCount = 0;
+    if (!get32(magic) || !get32(version) || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+        !get32(base) || !get32(size) || !get32(nextHeap) || !get32(regCount) ||
+        nextHeap < heapBase_ || nextHeap > heapBase_ + heapSize_) {
+        std::cerr << "[WardenEmulator] Snapshot header invalid" << std::endl;
+        return false;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> registers(regCount);
+    for (auto& [reg, value] : registers) {
+        if (!get32(reg) || !get32(value)) return false;
+    }
+
+    uint32_t allocCount = 0;
+    if (!get32(allocCount)) return false;
+    std::map<uint32_t, size_t> allocations;
+    for (uint32_t i = 0; i < allocCount; i++) {
+        uint32_t addr = 0, allocSize = 0;
+        if (!get32(addr) || !get32(allocSize)) return false;
+        allocations[addr] = allocSize;
+    }
+
+    uint32_t regionCount = 0;
+    if (!get32(regionCount) || regionCount == 0) return false;
+
+    // First region is the module image; map everything through initialize()
+    uint32_t moduleAddr = 0, moduleBytes = 0;
+    if (!get32(moduleAddr) || !get32(moduleBytes) || moduleAddr != base || moduleBytes != size ||
+        pos + moduleBytes > snapshot.size()) {
+        std::cerr << "[WardenEmulator] Snapshot module region invalid" << std::endl;
+        return false;
+    }
+    if (!initialize(snapshot.data() + pos, moduleBytes, base)) {
+        return false;
+    }
+    pos += moduleBytes;
+
+    for (uint32_t i = 1; i < regionCount; i++) {
+        uint32_t addr = 0, regionSize = 0;
+        if (!get32(addr) || !get32(regionSize) || pos + regionSize > snapshot.size() ||
+            (regionSize > 0 && uc_mem_write(uc_, addr, snapshot.data() + pos, regionSize) != UC_ERR_OK)) {
+            std::cerr << "[WardenEmulator] Snapshot region " << i << " invalid" << std::endl;
+            uc_close(uc_);
+            uc_ = nullptr;
+            hooks_.clear();
+            return false;
+        }
+        pos += regionSize;
+    }
+
+    for (const auto& [reg, value] : registers) {
+        uc_reg_write(uc_, static_cast<int>(reg), &value);
+    }
+    allocations_ = std::move(allocations);
+    nextHeapAddr_ = nextHeap;
+
+    std::cout << "[WardenEmulator] ✓ Restored from snapshot (" << snapshot.size() << " bytes)" << std::endl;
+    return true;
+}
+
 // ============================================================================
 // Windows API Implementations
 // ============================================================================
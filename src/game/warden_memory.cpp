@@ -1,5 +1,6 @@
 #include "game/warden_memory.hpp"
 #include "core/logger.hpp"
+#include "auth/crypto.hpp"
 #include <fstream>
 #include <cstring>
 #include <cstdlib>
@@ -77,6 +78,8 @@ bool WardenMemory::parsePE(const std::vector<uint8_t>& fileData) {
 
     // Section table follows optional header
     size_t secTableOfs = optOfs + optHeaderSize;
+    sections_.clear();
+    pageHashCache_.clear();
 
     for (uint16_t i = 0; i < numSections; i++) {
         size_t secOfs = secTableOfs + i * 40;
@@ -101,11 +104,21 @@ bool WardenMemory::parsePE(const std::vector<uint8_t>& fileData) {
 
         std::memcpy(image_.data() + virtualAddr, fileData.data() + rawDataOffset, copySize);
 
+        Section section;
+        section.va = imageBase_ + virtualAddr;
+        section.size = std::max(copySize, std::min(virtualSize, imageSize_ - virtualAddr));
+        section.fileOffset = rawDataOffset;
+        std::memcpy(section.name, secName, sizeof(section.name));
+        sections_.push_back(section);
+
         LOG_INFO("WardenMemory:   Section '", secName,
                  "' VA=0x", std::hex, imageBase_ + virtualAddr,
                  " size=0x", copySize, std::dec);
     }
 
+    std::sort(sections_.begin(), sections_.end(),
+              [](const Section& a, const Section& b) { return a.va < b.va; });
+
     return true;
 }
 
@@ -130,8 +143,18 @@ bool WardenMemory::readMemory(uint32_t va, uint8_t length, uint8_t* outBuf) cons
         return true;
     }
 
-    // PE image range
-    if (!loaded_ || va < imageBase_) return false;
+    if (!loaded_) return false;
+
+    // Section range: the index maps the VA straight to its bytes in the image
+    if (const Section* section = findSection(va)) {
+        if (static_cast<uint64_t>(va - section->va) + length <= section->size) {
+            std::memcpy(outBuf, image_.data() + (section->va - imageBase_) + (va - section->va), length);
+            return true;
+        }
+    }
+
+    // Headers, gaps and reads spanning sections: flat image bounds
+    if (va < imageBase_) return false;
     uint32_t offset = va - imageBase_;
     if (static_cast<uint64_t>(offset) + length > imageSize_) return false;
 
@@ -139,6 +162,49 @@ bool WardenMemory::readMemory(uint32_t va, uint8_t length, uint8_t* outBuf) cons
     return true;
 }
 
+const WardenMemory::Section* WardenMemory::findSection(uint32_t va) const {
+    auto it = std::upper_bound(sections_.begin(), sections_.end(), va,
+                               [](uint32_t addr, const Section& s) { return addr < s.va; });
+    if (it == sections_.begin()) return nullptr;
+    --it;
+    return (va - it->va < it->size) ? &*it : nullptr;
+}
+
+bool WardenMemory::hashPage(uint32_t seed, uint32_t va, uint8_t length, uint8_t outHash[20]) const {
+    PageKey key{seed, va, length};
+    auto it = pageHashCache_.find(key);
+    if (it != pageHashCache_.end()) {
+        pageCacheHits_++;
+        std::memcpy(outHash, it->second.data(), 20);
+        return true;
+    }
+
+    // Misses read through readMemory(), i.e. the section index
+    std::vector<uint8_t> bytes(length);
+    if (!readMemory(va, length, bytes.data())) return false;
+
+    std::vector<uint8_t> hmacKey = {
+        static_cast<uint8_t>(seed), static_cast<uint8_t>(seed >> 8),
+        static_cast<uint8_t>(seed >> 16), static_cast<uint8_t>(seed >> 24),
+    };
+    std::vector<uint8_t> hash = auth::Crypto::hmacSHA1(hmacKey, bytes);
+    if (hash.size() != 20) return false;
+
+    pageCacheMisses_++;
+    if (pageHashCache_.size() >= MAX_PAGE_CACHE_ENTRIES) {
+        pageHashCache_.clear();
+    }
+    std::array<uint8_t, 20>& slot = pageHashCache_[key];
+    std::memcpy(slot.data(), hash.data(), 20);
+    std::memcpy(outHash, hash.data(), 20);
+    return true;
+}
+
+bool WardenMemory::pageMatches(uint32_t seed, const uint8_t expected[20], uint32_t va, uint8_t length) const {
+    uint8_t hash[20];
+    return hashPage(seed, va, length, hash) && std::memcmp(hash, expected, 20) == 0;
+}
+
 std::string WardenMemory::findWowExe() const {
     std::vector<std::string> candidateDirs;
     if (const char* env = std::getenv("WOWEE_INTEGRITY_DIR")) {
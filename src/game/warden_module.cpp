@@ -779,6 +779,17 @@ bool WardenModule::initializeModule() {
     // Function signature: WardenFuncList* (*entryPoint)(ClientCallbacks*)
 
     #ifdef HAVE_UNICORN
+        // Reconnect: restore the state a previous init left behind
+        if (!initSnapshot_.empty()) {
+            if (restoreInitSnapshot()) {
+                std::cout << "[WardenModule] ✓ Restored post-init snapshot, WardenFuncList at 0x"
+                          << std::hex << funcListAddr_ << std::dec << std::endl;
+                return true;
+            }
+            std::cerr << "[WardenModule] Snapshot rejected, running module init" << std::endl;
+            emulator_.reset();
+        }
+
         // Use Unicorn emulator for cross-platform execution
         std::cout << "[WardenModule] Initializing Unicorn emulator..." << std::endl;
 
@@ -839,6 +850,7 @@ bool WardenModule::initializeModule() {
             }
 
             std::cout << "[WardenModule] ✓ Module initialized, WardenFuncList at 0x" << std::hex << result << std::dec << std::endl;
+            funcListAddr_ = result;
 
             // Read WardenFuncList structure from emulated memory
             // Structure has 4 function pointers (16 bytes)
@@ -901,6 +913,52 @@ bool WardenModule::initializeModule() {
     return true; // Stub implementation
 }
 
+std::vector<uint8_t> WardenModule::saveInitSnapshot() const {
+    std::vector<uint8_t> out;
+    #ifdef HAVE_UNICORN
+        if (!emulator_ || !emulator_->isInitialized() || funcListAddr_ == 0) {
+            return out;
+        }
+        std::vector<uint8_t> emuState = emulator_->saveSnapshot();
+        if (emuState.empty()) {
+            return out;
+        }
+
+        // [4 moduleSize][4 moduleBase][4 funcListAddr][emulator state]
+        const uint32_t header[3] = { static_cast<uint32_t>(moduleSize_), moduleBase_, funcListAddr_ };
+        out.resize(sizeof(header));
+        std::memcpy(out.data(), header, sizeof(header));
+        out.insert(out.end(), emuState.begin(), emuState.end());
+    #endif
+    return out;
+}
+
+bool WardenModule::restoreInitSnapshot() {
+    #ifdef HAVE_UNICORN
+        uint32_t header[3] = {};
+        if (initSnapshot_.size() <= sizeof(header)) {
+            return false;
+        }
+        std::memcpy(header, initSnapshot_.data(), sizeof(header));
+        if (header[0] != moduleSize_ || header[1] != moduleBase_ || header[2] == 0) {
+            std::cerr << "[WardenModule] Snapshot does not match loaded module" << std::endl;
+            return false;
+        }
+
+        std::vector<uint8_t> emuState(initSnapshot_.begin() + sizeof(header), initSnapshot_.end());
+        emulator_ = std::make_unique<WardenEmulator>();
+        if (!emulator_->restoreSnapshot(emuState)) {
+            return false;
+        }
+        emulator_->setupCommonAPIHooks();
+        funcListAddr_ = header[2];
+        restoredFromSnapshot_ = true;
+        return true;
+    #else
+        return false;
+    #endif
+}
+
 // ============================================================================
 // WardenModuleManager Implementation
 // ============================================================================
@@ -1014,7 +1072,61 @@ bool WardenModuleManager::loadCachedModule(const std::vector<uint8_t>& md5Hash,
     return true;
 }
 
-std::string WardenModuleManager::getCachePath(const std::vector<uint8_t>& md5Hash) {
+bool WardenModuleManager::cacheSnapshot(const std::vector<uint8_t>& md5Hash,
+                                        const std::vector<uint8_t>& snapshot) {
+    std::string cachePath = getCachePath(md5Hash, ".snap");
+    std::string tmpPath = cachePath + ".tmp";
+
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "[WardenModuleManager] Failed to write snapshot: " << tmpPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+        if (!file) {
+            std::filesystem::remove(tmpPath);
+            return false;
+        }
+    }
+
+    // Rename so a reader never sees a partially written snapshot
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    std::cout << "[WardenModuleManager] Cached snapshot to: " << cachePath
+              << " (" << snapshot.size() << " bytes)" << std::endl;
+    return true;
+}
+
+bool WardenModuleManager::loadCachedSnapshot(const std::vector<uint8_t>& md5Hash,
+                                             std::vector<uint8_t>& snapshotOut) {
+    std::string cachePath = getCachePath(md5Hash, ".snap");
+
+    std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+
+    size_t fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    snapshotOut.resize(fileSize);
+    file.read(reinterpret_cast<char*>(snapshotOut.data()), fileSize);
+    if (!file) {
+        snapshotOut.clear();
+        return false;
+    }
+
+    std::cout << "[WardenModuleManager] Loaded cached snapshot (" << fileSize << " bytes)" << std::endl;
+    return true;
+}
+
+std::string WardenModuleManager::getCachePath(const std::vector<uint8_t>& md5Hash, const char* extension) {
     // Convert MD5 hash to hex string for filename
     std::string hexHash;
     hexHash.reserve(md5Hash.size() * 2);
@@ -1025,7 +1137,7 @@ std::string WardenModuleManager::getCachePath(const std::vector<uint8_t>& md5Has
         hexHash += buf;
     }
 
-    return cacheDirectory_ + "/" + hexHash + ".wdn";
+    return cacheDirectory_ + "/" + hexHash + extension;
 }
 
 } // namespace game
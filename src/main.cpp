@@ -1,6 +1,7 @@
 #include "core/application.hpp"
 #include "core/logger.hpp"
 #include <exception>
+#include <string>
 #include <csignal>
 #include <SDL2/SDL.h>
 #include <X11/Xlib.h>
@@ -23,7 +24,7 @@ static void crashHandler(int sig) {
     std::raise(sig);
 }
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
+int main(int argc, char* argv[]) {
     g_emergencyDisplay = XOpenDisplay(nullptr);
     std::signal(SIGSEGV, crashHandler);
     std::signal(SIGABRT, crashHandler);
@@ -35,13 +36,39 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
         LOG_INFO("=== Wowee Native Client ===");
         LOG_INFO("Starting application...");
 
+        // --benchmark <script> [--benchmark-out <report.json>]
+        std::string benchmarkScript;
+        std::string benchmarkReport;
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--benchmark" && i + 1 < argc) {
+                benchmarkScript = argv[++i];
+            } else if (arg == "--benchmark-out" && i + 1 < argc) {
+                benchmarkReport = argv[++i];
+            } else {
+                LOG_WARNING("Ignoring unknown argument: ", arg);
+            }
+        }
+
         wowee::core::Application app;
+        app.setHeadless(!benchmarkScript.empty());
 
         if (!app.initialize()) {
             LOG_FATAL("Failed to initialize application");
             return 1;
         }
 
+        if (!benchmarkScript.empty()) {
+            if (benchmarkReport.empty()) {
+                std::string base = benchmarkScript.substr(benchmarkScript.find_last_of("/\\") + 1);
+                benchmarkReport = "benchmark_" + base.substr(0, base.rfind('.')) + ".json";
+            }
+            bool ok = app.runBenchmark(benchmarkScript, benchmarkReport);
+            app.shutdown();
+            if (g_emergencyDisplay) { XCloseDisplay(g_emergencyDisplay); g_emergencyDisplay = nullptr; }
+            return ok ? 0 : 1;
+        }
+
         app.run();
         app.shutdown();
 
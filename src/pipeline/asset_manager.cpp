@@ -1,7 +1,10 @@
 #include "pipeline/asset_manager.hpp"
 #include "core/logger.hpp"
 #include "core/memory_monitor.hpp"
+#include "core/metrics.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
@@ -47,24 +50,39 @@ bool AssetManager::initialize(const std::string& dataPath_) {
 
     setupFileCacheBudget();
 
+    std::string packIndexPath = dataPath + "/assets.wpi";
     std::string manifestPath = dataPath + "/manifest.json";
-    if (!std::filesystem::exists(manifestPath)) {
-        LOG_ERROR("manifest.json not found in: ", dataPath);
+    if (std::filesystem::exists(packIndexPath)) {
+        if (!pack_.open(packIndexPath)) {
+            LOG_ERROR("Failed to load asset pack index");
+            return false;
+        }
+    } else if (std::filesystem::exists(manifestPath)) {
+        if (!manifest_.load(manifestPath)) {
+            LOG_ERROR("Failed to load manifest");
+            return false;
+        }
+    } else {
+        LOG_ERROR("Neither assets.wpi nor manifest.json found in: ", dataPath);
         LOG_ERROR("Run asset_extract to extract MPQ archives first");
         return false;
     }
 
-    if (!manifest_.load(manifestPath)) {
-        LOG_ERROR("Failed to load manifest");
-        return false;
-    }
-
     if (std::filesystem::is_directory(overridePath_)) {
         LOG_INFO("Override directory found: ", overridePath_);
     }
 
+    dbcBinaryCache_ = std::make_unique<DBCBinaryCache>();
+
+    cookedStore_ = std::make_unique<CookedAssetStore>(dataPath + "/cooked");
+    if (cookedStore_->isAvailable()) {
+        LOG_INFO("Cooked assets found: ", cookedStore_->getDirectory());
+    }
+
     initialized = true;
-    LOG_INFO("Asset manager initialized: ", manifest_.getEntryCount(),
+    LOG_INFO("Asset manager initialized: ",
+             pack_.isLoaded() ? pack_.getEntryCount() : manifest_.getEntryCount(),
+             pack_.isLoaded() ? " packed" : " loose",
              " files indexed (file cache: ", fileCacheBudget / (1024 * 1024), " MB)");
     return true;
 }
@@ -109,24 +127,94 @@ void AssetManager::shutdown() {
     }
 
     clearCache();
+    pack_.close();
     initialized = false;
 }
 
+const std::string* AssetManager::lookupRelativePath(const std::string& normalizedPath) const {
+    if (pack_.isLoaded()) {
+        const auto* entry = pack_.lookup(normalizedPath);
+        return entry ? &entry->filesystemPath : nullptr;
+    }
+    const auto* entry = manifest_.lookup(normalizedPath);
+    return entry ? &entry->filesystemPath : nullptr;
+}
+
 std::string AssetManager::resolveFile(const std::string& normalizedPath) const {
     // Check override directory first (for HD upgrades, custom textures)
     if (!overridePath_.empty()) {
-        const auto* entry = manifest_.lookup(normalizedPath);
-        if (entry && !entry->filesystemPath.empty()) {
-            std::string overrideFsPath = overridePath_ + "/" + entry->filesystemPath;
+        const std::string* relativePath = lookupRelativePath(normalizedPath);
+        if (relativePath && !relativePath->empty()) {
+            std::string overrideFsPath = overridePath_ + "/" + *relativePath;
             if (LooseFileReader::fileExists(overrideFsPath)) {
                 return overrideFsPath;
             }
         }
     }
+    // Packed assets have no loose file
+    if (pack_.isLoaded()) {
+        return {};
+    }
     // Fall back to base manifest
     return manifest_.resolveFilesystemPath(normalizedPath);
 }
 
+bool AssetManager::getSourceStamp(const std::string& normalizedPath, CookedSourceStamp& stamp) const {
+    const std::string* relativePath = lookupRelativePath(normalizedPath);
+    if (!relativePath) {
+        return false;
+    }
+    // Overrides are never cooked
+    if (!overridePath_.empty() && !relativePath->empty() &&
+        LooseFileReader::fileExists(overridePath_ + "/" + *relativePath)) {
+        return false;
+    }
+    if (pack_.isLoaded()) {
+        const auto* entry = pack_.lookup(normalizedPath);
+        stamp.size = entry->blob.rawSize;
+        stamp.crc32 = entry->blob.crc32;
+    } else {
+        const auto* entry = manifest_.lookup(normalizedPath);
+        stamp.size = entry->size;
+        stamp.crc32 = entry->crc32;
+    }
+    return true;
+}
+
+std::string AssetManager::getSourceIdentity(const std::string& path) const {
+    if (!initialized) {
+        return {};
+    }
+    const std::string normalizedPath = normalizePath(path);
+
+    // Loose override files are edited in place and have no index entry
+    auto looseIdentity = [](const std::string& fsPath) -> std::string {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(fsPath, ec);
+        if (ec) return {};
+        auto mtime = std::filesystem::last_write_time(fsPath, ec);
+        if (ec) return {};
+        return "f" + std::to_string(size) + ":" + std::to_string(mtime.time_since_epoch().count());
+    };
+
+    std::string fsPath = resolveFile(normalizedPath);
+    if (!fsPath.empty() && normalizedPath.size() >= 4 &&
+        normalizedPath.compare(normalizedPath.size() - 4, 4, ".blp") == 0) {
+        std::string pngPath = fsPath.substr(0, fsPath.size() - 4) + ".png";
+        if (LooseFileReader::fileExists(pngPath)) {
+            return looseIdentity(pngPath);
+        }
+    }
+
+    CookedSourceStamp stamp;
+    if (getSourceStamp(normalizedPath, stamp)) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%llx:%08x", static_cast<unsigned long long>(stamp.size), stamp.crc32);
+        return buf;
+    }
+    return fsPath.empty() ? std::string() : looseIdentity(fsPath);
+}
+
 BLPImage AssetManager::loadTexture(const std::string& path) {
     if (!initialized) {
         LOG_ERROR("AssetManager not initialized");
@@ -159,6 +247,27 @@ BLPImage AssetManager::loadTexture(const std::string& path) {
     return image;
 }
 
+BLPCompressedImage AssetManager::loadCompressedTexture(const std::string& path) {
+    if (!initialized || !cookedStore_ || !cookedStore_->isAvailable()) {
+        return BLPCompressedImage();
+    }
+    std::string normalizedPath = normalizePath(path);
+
+    // PNG overrides replace the BLP and are only handled by loadTexture()
+    std::string fsPath = resolveFile(normalizedPath);
+    if (!fsPath.empty() && fsPath.size() >= 4 &&
+        LooseFileReader::fileExists(fsPath.substr(0, fsPath.size() - 4) + ".png")) {
+        return BLPCompressedImage();
+    }
+
+    CookedSourceStamp stamp;
+    BLPCompressedImage image;
+    if (getSourceStamp(normalizedPath, stamp)) {
+        cookedStore_->loadTexture(normalizedPath, stamp, image);
+    }
+    return image;
+}
+
 BLPImage AssetManager::tryLoadPngOverride(const std::string& normalizedPath) const {
     if (normalizedPath.size() < 4) return BLPImage();
 
@@ -194,7 +303,93 @@ BLPImage AssetManager::tryLoadPngOverride(const std::string& normalizedPath) con
     return image;
 }
 
+M2Model AssetManager::loadM2Model(const std::string& path) {
+    if (!initialized || path.size() < 3) {
+        return M2Model();
+    }
+
+    std::string normalizedPath = normalizePath(path);
+    std::string skinPath = normalizedPath.substr(0, normalizedPath.size() - 3) + "00.skin";
+
+    CookedSourceStamp stamp;
+    if (cookedStore_ && cookedStore_->isAvailable() && getSourceStamp(normalizedPath, stamp)) {
+        CookedSourceStamp skinStamp;
+        if (getSourceStamp(skinPath, skinStamp)) {
+            stamp.addDependency(skinStamp.size, skinStamp.crc32);
+        }
+        M2Model cooked;
+        if (cookedStore_->loadM2(normalizedPath, stamp, cooked)) {
+            return cooked;
+        }
+    }
+
+    std::vector<uint8_t> m2Data = readFile(normalizedPath);
+    if (m2Data.empty()) {
+        return M2Model();
+    }
+    M2Model model = M2Loader::load(m2Data);
+    // Vanilla M2s (< 264) carry their skin inline
+    if (model.version >= 264) {
+        std::vector<uint8_t> skinData = readFile(skinPath);
+        if (!skinData.empty()) {
+            M2Loader::loadSkin(skinData, model);
+        }
+    }
+    return model;
+}
+
+WMOModel AssetManager::loadWMOModel(const std::string& path) {
+    if (!initialized) {
+        return WMOModel();
+    }
+    std::string normalizedPath = normalizePath(path);
+
+    // The root is small and always parsed; the groups are what get cooked
+    std::vector<uint8_t> rootData = readFile(normalizedPath);
+    if (rootData.empty()) {
+        return WMOModel();
+    }
+    WMOModel model = WMOLoader::load(rootData);
+    if (model.nGroups == 0) {
+        return model;
+    }
+
+    CookedSourceStamp stamp;
+    if (cookedStore_ && cookedStore_->isAvailable() && getSourceStamp(normalizedPath, stamp)) {
+        for (uint32_t gi = 0; gi < model.nGroups; gi++) {
+            CookedSourceStamp groupStamp;
+            if (getSourceStamp(WMOLoader::groupPath(normalizedPath, gi), groupStamp)) {
+                stamp.addDependency(groupStamp.size, groupStamp.crc32);
+            } else {
+                stamp.addDependency(0, 0);
+            }
+        }
+        if (cookedStore_->loadWMOGroups(normalizedPath, stamp, model)) {
+            return model;
+        }
+    }
+
+    for (uint32_t gi = 0; gi < model.nGroups; gi++) {
+        std::vector<uint8_t> groupData = readFile(WMOLoader::groupPath(normalizedPath, gi));
+        if (!groupData.empty()) {
+            WMOLoader::loadGroup(groupData, model, gi);
+        }
+    }
+    return model;
+}
+
+bool AssetManager::loadCookedTerrainMesh(const std::string& adtPath, TerrainMesh& mesh) {
+    if (!initialized || !cookedStore_ || !cookedStore_->isAvailable()) {
+        return false;
+    }
+    std::string normalizedPath = normalizePath(adtPath);
+    CookedSourceStamp stamp;
+    return getSourceStamp(normalizedPath, stamp) && cookedStore_->loadTerrainMesh(normalizedPath, stamp, mesh);
+}
+
 void AssetManager::setExpansionDataPath(const std::string& path) {
+    // Preload workers read the path; switch only once they are done
+    waitForDBCPreload();
     expansionDataPath_ = path;
     LOG_INFO("Expansion data path for CSV DBCs: ", expansionDataPath_);
 }
@@ -205,18 +400,91 @@ std::shared_ptr<DBCFile> AssetManager::loadDBC(const std::string& name) {
         return nullptr;
     }
 
-    auto it = dbcCache.find(name);
-    if (it != dbcCache.end()) {
-        LOG_DEBUG("DBC already loaded (cached): ", name);
-        return it->second;
+    {
+        std::unique_lock<std::mutex> lock(cacheMutex);
+        // Another thread (e.g. a preload worker) may be loading this table already
+        dbcLoadCV_.wait(lock, [&]() { return dbcLoading_.count(name) == 0; });
+        auto it = dbcCache.find(name);
+        if (it != dbcCache.end()) {
+            LOG_DEBUG("DBC already loaded (cached): ", name);
+            return it->second;
+        }
+        dbcLoading_.insert(name);
+    }
+
+    auto dbc = loadDBCUncached(name);
+    if (dbc) {
+        // Index before publishing so findRecordById never builds lazily across threads
+        dbc->buildIndex();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        dbcLoading_.erase(name);
+        if (dbc) {
+            dbcCache[name] = dbc;
+        }
+    }
+    dbcLoadCV_.notify_all();
+    return dbc;
+}
+
+void AssetManager::preloadDBCsAsync(std::vector<std::string> names) {
+    waitForDBCPreload();
+    if (!initialized || names.empty()) {
+        return;
+    }
+
+    dbcPreloadPending_.store(true);
+    dbcPreloadThread_ = std::thread([this, names = std::move(names)]() {
+        auto startTime = std::chrono::steady_clock::now();
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> loadedCount{0};
+
+        // Mostly parse/IO bound; leave cores for the main thread and terrain workers
+        unsigned hc = std::thread::hardware_concurrency();
+        unsigned workerCount = std::clamp(hc / 2, 1u, 4u);
+        workerCount = std::min(workerCount, static_cast<unsigned>(names.size()));
+
+        auto work = [&]() {
+            for (size_t i = next.fetch_add(1); i < names.size(); i = next.fetch_add(1)) {
+                if (loadDBC(names[i])) {
+                    loadedCount.fetch_add(1);
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount - 1);
+        for (unsigned i = 1; i < workerCount; i++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& t : workers) {
+            t.join();
+        }
+
+        auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        LOG_INFO("Preloaded ", loadedCount.load(), "/", names.size(), " DBCs on ",
+                 workerCount, " threads in ", elapsedMs, " ms");
+        dbcPreloadPending_.store(false);
+    });
+}
+
+void AssetManager::waitForDBCPreload() {
+    if (dbcPreloadThread_.joinable()) {
+        dbcPreloadThread_.join();
     }
+}
 
+std::shared_ptr<DBCFile> AssetManager::loadDBCUncached(const std::string& name) {
     LOG_DEBUG("Loading DBC: ", name);
 
     std::vector<uint8_t> dbcData;
 
     // Try expansion-specific CSV first (e.g. Data/expansions/wotlk/db/Spell.csv)
     bool loadedFromCSV = false;
+    std::string csvPath;
     if (!expansionDataPath_.empty()) {
         // Derive CSV name from DBC name: "Spell.dbc" -> "Spell.csv"
         std::string baseName = name;
@@ -224,8 +492,15 @@ std::shared_ptr<DBCFile> AssetManager::loadDBC(const std::string& name) {
         if (dot != std::string::npos) {
             baseName = baseName.substr(0, dot);
         }
-        std::string csvPath = expansionDataPath_ + "/db/" + baseName + ".csv";
+        csvPath = expansionDataPath_ + "/db/" + baseName + ".csv";
         if (std::filesystem::exists(csvPath)) {
+            // Compiled blob from an earlier run: mapped, no parsing
+            if (dbcBinaryCache_) {
+                if (auto compiled = dbcBinaryCache_->load(csvPath)) {
+                    LOG_INFO("Loaded DBC: ", name, " (", compiled->getRecordCount(), " records, compiled)");
+                    return compiled;
+                }
+            }
             std::ifstream f(csvPath, std::ios::binary | std::ios::ate);
             if (f) {
                 auto size = f.tellg();
@@ -298,6 +573,7 @@ std::shared_ptr<DBCFile> AssetManager::loadDBC(const std::string& name) {
                     LOG_ERROR("Binary DBC fallback also failed: ", name);
                     return nullptr;
                 }
+                loadedFromCSV = false;
                 LOG_INFO("Binary DBC fallback succeeded: ", name);
             } else {
                 LOG_ERROR("No binary DBC fallback available for: ", name, " — discarding garbled CSV");
@@ -306,13 +582,18 @@ std::shared_ptr<DBCFile> AssetManager::loadDBC(const std::string& name) {
         }
     }
 
-    dbcCache[name] = dbc;
+    // Only tables that passed validation are compiled; garbled CSVs keep
+    // taking the binary fallback path.
+    if (loadedFromCSV && dbcBinaryCache_) {
+        dbcBinaryCache_->store(csvPath, *dbc);
+    }
 
     LOG_INFO("Loaded DBC: ", name, " (", dbc->getRecordCount(), " records)");
     return dbc;
 }
 
 std::shared_ptr<DBCFile> AssetManager::getDBC(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
     auto it = dbcCache.find(name);
     if (it != dbcCache.end()) {
         return it->second;
@@ -325,7 +606,14 @@ bool AssetManager::fileExists(const std::string& path) const {
         return false;
     }
     std::string normalized = normalizePath(path);
-    return manifest_.hasEntry(normalized);
+    return pack_.isLoaded() ? pack_.hasEntry(normalized) : manifest_.hasEntry(normalized);
+}
+
+std::string AssetManager::resolveFilesystemPath(const std::string& path) const {
+    if (!initialized) {
+        return {};
+    }
+    return resolveFile(normalizePath(path));
 }
 
 std::vector<uint8_t> AssetManager::readFile(const std::string& path) const {
@@ -333,6 +621,15 @@ std::vector<uint8_t> AssetManager::readFile(const std::string& path) const {
         return {};
     }
 
+    static auto& cacheHitCount = core::Metrics::getInstance().counter(
+        "wowee_asset_reads_total", "Asset reads by cache outcome", "result=\"hit\"");
+    static auto& cacheMissCount = core::Metrics::getInstance().counter(
+        "wowee_asset_reads_total", "Asset reads by cache outcome", "result=\"miss\"");
+    static auto& readBytes = core::Metrics::getInstance().counter(
+        "wowee_asset_read_bytes_total", "Bytes read from disk for assets");
+    static auto& readLatency = core::Metrics::getInstance().histogram(
+        "wowee_asset_read_seconds", "Asset read latency on cache miss");
+
     std::string normalized = normalizePath(path);
 
     // Check cache first
@@ -342,21 +639,32 @@ std::vector<uint8_t> AssetManager::readFile(const std::string& path) const {
         if (it != fileCache.end()) {
             it->second.lastAccessTime = ++fileCacheAccessCounter;
             fileCacheHits++;
+            cacheHitCount.add();
             return it->second.data;
         }
     }
+    cacheMissCount.add();
 
-    // Read from filesystem (override dir first, then base manifest)
+    // Read from filesystem (override dir first), then the pack or base manifest
+    core::ScopedTimer readTimer(readLatency);
+    std::vector<uint8_t> data;
     std::string fsPath = resolveFile(normalized);
-    if (fsPath.empty()) {
+    if (!fsPath.empty()) {
+        data = LooseFileReader::readFile(fsPath);
+        if (data.empty()) {
+            LOG_WARNING("Manifest entry exists but file unreadable: ", fsPath);
+            return data;
+        }
+    } else if (const auto* packed = pack_.lookup(normalized)) {
+        data = pack_.read(*packed);
+        if (data.empty()) {
+            LOG_WARNING("Pack entry exists but blob unreadable: ", normalized);
+            return data;
+        }
+    } else {
         return {};
     }
-
-    auto data = LooseFileReader::readFile(fsPath);
-    if (data.empty()) {
-        LOG_WARNING("Manifest entry exists but file unreadable: ", fsPath);
-        return data;
-    }
+    readBytes.add(data.size());
 
     // Add to cache if within budget
     size_t fileSize = data.size();
@@ -395,12 +703,14 @@ std::vector<uint8_t> AssetManager::readFileOptional(const std::string& path) con
 }
 
 void AssetManager::clearDBCCache() {
+    waitForDBCPreload();
     std::lock_guard<std::mutex> lock(cacheMutex);
     dbcCache.clear();
     LOG_INFO("Cleared DBC cache");
 }
 
 void AssetManager::clearCache() {
+    waitForDBCPreload();
     std::lock_guard<std::mutex> lock(cacheMutex);
     dbcCache.clear();
     fileCache.clear();
@@ -0,0 +1,549 @@
+#include "pipeline/asset_pack.hpp"
+#include "core/logger.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wowee {
+namespace pipeline {
+
+namespace {
+
+constexpr uint32_t kIndexMagic = 0x58495057;    // "WPIX"
+constexpr uint32_t kCatalogMagic = 0x434B5057;  // "WPKC"
+constexpr uint32_t kPackFormatVersion = 1;
+constexpr uint32_t kSmallBlobAlignment = 16;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t extra;  // Index: store path length; catalog: reserved
+};
+static_assert(sizeof(FileHeader) == 16, "pack header layout changed");
+
+// On-disk form of PackBlob (shared by the catalog and the index)
+struct BlobRecord {
+    uint64_t hash;
+    uint64_t offset;
+    uint32_t storedSize;
+    uint32_t rawSize;
+    uint32_t crc32;
+    uint16_t packId;
+    uint8_t compression;
+    uint8_t reserved;
+};
+static_assert(sizeof(BlobRecord) == 32, "pack blob record layout changed");
+
+BlobRecord toRecord(const PackBlob& b) {
+    BlobRecord r{};
+    r.hash = b.hash;
+    r.offset = b.offset;
+    r.storedSize = b.storedSize;
+    r.rawSize = b.rawSize;
+    r.crc32 = b.crc32;
+    r.packId = b.packId;
+    r.compression = static_cast<uint8_t>(b.compression);
+    return r;
+}
+
+PackBlob fromRecord(const BlobRecord& r) {
+    PackBlob b;
+    b.hash = r.hash;
+    b.offset = r.offset;
+    b.storedSize = r.storedSize;
+    b.rawSize = r.rawSize;
+    b.crc32 = r.crc32;
+    b.packId = r.packId;
+    b.compression = static_cast<PackCompression>(r.compression);
+    return b;
+}
+
+std::string packFilePath(const std::string& storeDir, uint16_t packId) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "pack_%03u.wpak", static_cast<unsigned>(packId));
+    return storeDir + "/" + name;
+}
+
+std::string catalogPath(const std::string& storeDir) {
+    return storeDir + "/catalog.wpc";
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& out) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&out), sizeof(T)));
+}
+
+// Parse an index file; storePath comes back resolved against the index directory
+bool readIndexFile(const std::string& indexPath, std::string& storePath,
+                   std::unordered_map<std::string, AssetPackReader::Entry>& entries) {
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in) return false;
+
+    FileHeader header{};
+    if (!readPod(in, header) || header.magic != kIndexMagic) {
+        LOG_ERROR("Not an asset pack index: ", indexPath);
+        return false;
+    }
+    if (header.version != kPackFormatVersion) {
+        LOG_ERROR("Unsupported asset pack index version ", header.version, ": ", indexPath);
+        return false;
+    }
+
+    std::string relativeStore(header.extra, '\0');
+    if (!in.read(relativeStore.data(), header.extra)) return false;
+    std::filesystem::path store(relativeStore);
+    if (store.is_relative()) {
+        store = std::filesystem::path(indexPath).parent_path() / store;
+    }
+    storePath = store.lexically_normal().string();
+
+    entries.reserve(entries.size() + header.count);
+    std::string key, fsPath;
+    for (uint32_t i = 0; i < header.count; i++) {
+        BlobRecord record{};
+        uint16_t keyLength = 0, fsLength = 0;
+        if (!readPod(in, record) || !readPod(in, keyLength) || !readPod(in, fsLength)) {
+            LOG_ERROR("Truncated asset pack index: ", indexPath);
+            return false;
+        }
+        key.resize(keyLength);
+        fsPath.resize(fsLength);
+        if (!in.read(key.data(), keyLength) || !in.read(fsPath.data(), fsLength)) {
+            LOG_ERROR("Truncated asset pack index: ", indexPath);
+            return false;
+        }
+        AssetPackReader::Entry& entry = entries[key];
+        entry.filesystemPath = fsPath;
+        entry.blob = fromRecord(record);
+    }
+    return true;
+}
+
+#ifndef _WIN32
+struct MappedPack {
+    void* addr = nullptr;
+    size_t size = 0;
+    ~MappedPack() {
+        if (addr) munmap(addr, size);
+    }
+};
+
+std::shared_ptr<const void> mapPack(const std::string& path, const uint8_t*& data, size_t& size) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return nullptr;
+    // Access pattern is scattered (tiles, models and textures from all over the pack)
+    madvise(addr, static_cast<size_t>(st.st_size), MADV_RANDOM);
+
+    auto mapping = std::make_shared<MappedPack>();
+    mapping->addr = addr;
+    mapping->size = static_cast<size_t>(st.st_size);
+    data = static_cast<const uint8_t*>(addr);
+    size = mapping->size;
+    return mapping;
+}
+#endif
+
+} // namespace
+
+uint64_t packContentHash(const uint8_t* data, size_t size) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// ---- AssetPackReader ----
+
+AssetPackReader::~AssetPackReader() {
+    close();
+}
+
+bool AssetPackReader::open(const std::string& indexPath) {
+    close();
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (!readIndexFile(indexPath, storePath_, entries_)) {
+        entries_.clear();
+        return false;
+    }
+
+    uint16_t maxPackId = 0;
+    for (const auto& [key, entry] : entries_) {
+        maxPackId = std::max(maxPackId, entry.blob.packId);
+    }
+
+    packs_.resize(entries_.empty() ? 0 : static_cast<size_t>(maxPackId) + 1);
+    for (size_t i = 0; i < packs_.size(); i++) {
+        PackFile& pack = packs_[i];
+        pack.path = packFilePath(storePath_, static_cast<uint16_t>(i));
+        std::error_code ec;
+        pack.size = static_cast<size_t>(std::filesystem::file_size(pack.path, ec));
+        if (ec) {
+            LOG_ERROR("Asset pack missing: ", pack.path);
+            close();
+            return false;
+        }
+#ifndef _WIN32
+        pack.mapping = mapPack(pack.path, pack.data, pack.size);
+        if (!pack.mapping) {
+            LOG_ERROR("Failed to map asset pack: ", pack.path);
+            close();
+            return false;
+        }
+#endif
+    }
+
+    loaded_ = true;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    LOG_INFO("Loaded asset pack index: ", entries_.size(), " entries, ", packs_.size(),
+             " pack files in ", ms, "ms (store: ", storePath_, ")");
+    return true;
+}
+
+void AssetPackReader::close() {
+    entries_.clear();
+    packs_.clear();
+    storePath_.clear();
+    loaded_ = false;
+}
+
+const AssetPackReader::Entry* AssetPackReader::lookup(const std::string& normalizedWowPath) const {
+    auto it = entries_.find(normalizedWowPath);
+    return it != entries_.end() ? &it->second : nullptr;
+}
+
+bool AssetPackReader::readBlob(const PackBlob& blob, uint8_t* out) const {
+    if (blob.packId >= packs_.size()) return false;
+    const PackFile& pack = packs_[blob.packId];
+    if (blob.offset + blob.storedSize > pack.size) return false;
+#ifndef _WIN32
+    std::memcpy(out, pack.data + blob.offset, blob.storedSize);
+    return true;
+#else
+    // No mmap wrapper on Windows yet: positioned read per blob
+    std::ifstream in(pack.path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(static_cast<std::streamoff>(blob.offset));
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(out), blob.storedSize));
+#endif
+}
+
+std::vector<uint8_t> AssetPackReader::read(const Entry& entry) const {
+    const PackBlob& blob = entry.blob;
+    std::vector<uint8_t> data(blob.rawSize);
+
+    if (blob.compression == PackCompression::NONE) {
+        if (blob.storedSize != blob.rawSize || !readBlob(blob, data.data())) {
+            return {};
+        }
+        return data;
+    }
+
+    if (blob.compression != PackCompression::ZLIB) {
+        LOG_WARNING("Unknown pack compression ", static_cast<int>(blob.compression));
+        return {};
+    }
+
+    uLongf destLength = blob.rawSize;
+#ifndef _WIN32
+    // Inflate straight out of the mapping
+    if (blob.packId >= packs_.size() || blob.offset + blob.storedSize > packs_[blob.packId].size) {
+        return {};
+    }
+    const uint8_t* source = packs_[blob.packId].data + blob.offset;
+#else
+    std::vector<uint8_t> compressed(blob.storedSize);
+    if (!readBlob(blob, compressed.data())) return {};
+    const uint8_t* source = compressed.data();
+#endif
+    if (uncompress(data.data(), &destLength, source, blob.storedSize) != Z_OK ||
+        destLength != blob.rawSize) {
+        LOG_WARNING("Corrupt compressed pack blob at ", blob.packId, ":", blob.offset);
+        return {};
+    }
+    return data;
+}
+
+// ---- AssetPackWriter ----
+
+AssetPackWriter::~AssetPackWriter() {
+    if (packFile_) std::fclose(packFile_);
+}
+
+bool AssetPackWriter::open(const std::string& storeDir, const std::string& indexPath,
+                           const Options& options) {
+    options_ = options;
+    storeDir_ = storeDir;
+    indexPath_ = indexPath;
+
+    std::error_code ec;
+    std::filesystem::create_directories(storeDir_, ec);
+    if (ec) {
+        LOG_ERROR("Cannot create pack store ", storeDir_, ": ", ec.message());
+        return false;
+    }
+
+    if (!loadCatalog()) return false;
+
+    // Keep entries from an earlier run into the same index (partial extractions)
+    if (std::filesystem::exists(indexPath_)) {
+        std::string existingStore;
+        std::unordered_map<std::string, AssetPackReader::Entry> existing;
+        if (readIndexFile(indexPath_, existingStore, existing) &&
+            std::filesystem::equivalent(existingStore, storeDir_, ec)) {
+            entries_ = std::move(existing);
+        }
+    }
+
+    // Append to the highest-numbered pack; start a new one once it is full
+    uint16_t lastPack = 0;
+    while (std::filesystem::exists(packFilePath(storeDir_, static_cast<uint16_t>(lastPack + 1)))) {
+        lastPack++;
+    }
+    return openPackForAppend(lastPack);
+}
+
+bool AssetPackWriter::openPackForAppend(uint16_t packId) {
+    if (packFile_) {
+        std::fclose(packFile_);
+        packFile_ = nullptr;
+    }
+    std::string path = packFilePath(storeDir_, packId);
+    packFile_ = std::fopen(path.c_str(), "ab");
+    if (!packFile_) {
+        LOG_ERROR("Cannot open pack file for writing: ", path);
+        return false;
+    }
+    std::error_code ec;
+    packId_ = packId;
+    packOffset_ = std::filesystem::file_size(path, ec);
+    if (ec) packOffset_ = 0;
+    return true;
+}
+
+bool AssetPackWriter::loadCatalog() {
+    std::ifstream in(catalogPath(storeDir_), std::ios::binary);
+    if (!in) return true;  // New store
+
+    FileHeader header{};
+    if (!readPod(in, header) || header.magic != kCatalogMagic || header.version != kPackFormatVersion) {
+        LOG_ERROR("Pack store catalog unreadable or wrong version: ", catalogPath(storeDir_));
+        return false;
+    }
+    catalog_.reserve(header.count);
+    for (uint32_t i = 0; i < header.count; i++) {
+        BlobRecord record{};
+        if (!readPod(in, record)) {
+            LOG_ERROR("Truncated pack store catalog: ", catalogPath(storeDir_));
+            return false;
+        }
+        PackBlob blob = fromRecord(record);
+        catalog_[BlobKey{blob.hash, blob.rawSize, blob.crc32}] = blob;
+    }
+    return true;
+}
+
+bool AssetPackWriter::appendBlob(const uint8_t* data, uint32_t size, PackBlob& blob) {
+    if (packOffset_ > 0 && packOffset_ + size > options_.maxPackBytes) {
+        if (!openPackForAppend(static_cast<uint16_t>(packId_ + 1))) return false;
+    }
+
+    uint64_t offset = packOffset_;
+    if (size >= PACK_ALIGNMENT) {
+        offset = (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+    } else {
+        offset = (offset + kSmallBlobAlignment - 1) / kSmallBlobAlignment * kSmallBlobAlignment;
+        if (offset % PACK_ALIGNMENT + size > PACK_ALIGNMENT) {
+            offset = (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+        }
+    }
+
+    static const uint8_t zeros[PACK_ALIGNMENT] = {};
+    size_t padding = static_cast<size_t>(offset - packOffset_);
+    if ((padding && std::fwrite(zeros, 1, padding, packFile_) != padding) ||
+        std::fwrite(data, 1, size, packFile_) != size) {
+        LOG_ERROR("Write failed on pack ", packId_);
+        return false;
+    }
+
+    blob.packId = packId_;
+    blob.offset = offset;
+    packOffset_ = offset + size;
+    return true;
+}
+
+bool AssetPackWriter::add(const std::string& normalizedWowPath, const std::string& filesystemPath,
+                          const std::vector<uint8_t>& data, uint32_t crc32) {
+    PackBlob blob;
+    blob.hash = packContentHash(data.data(), data.size());
+    blob.rawSize = static_cast<uint32_t>(data.size());
+    blob.crc32 = crc32;
+    const BlobKey key{blob.hash, blob.rawSize, blob.crc32};
+    stats_.rawBytes += data.size();
+
+    auto record = [&](const PackBlob& stored) {
+        AssetPackReader::Entry& entry = entries_[normalizedWowPath];
+        entry.filesystemPath = filesystemPath;
+        entry.blob = stored;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = catalog_.find(key);
+        if (it != catalog_.end()) {
+            record(it->second);
+            stats_.blobsDeduplicated++;
+            return true;
+        }
+    }
+
+    // Compress outside the lock; keep the result only if it saves >= 1/8
+    std::vector<uint8_t> compressed;
+    if (options_.compression == PackCompression::ZLIB && data.size() >= 256) {
+        uLongf bound = compressBound(static_cast<uLong>(data.size()));
+        compressed.resize(bound);
+        if (compress2(compressed.data(), &bound, data.data(), static_cast<uLong>(data.size()),
+                      options_.compressionLevel) == Z_OK &&
+            bound < data.size() - data.size() / 8) {
+            compressed.resize(bound);
+        } else {
+            compressed.clear();
+        }
+    }
+    const bool useCompressed = !compressed.empty();
+    const uint8_t* bytes = useCompressed ? compressed.data() : data.data();
+    blob.storedSize = static_cast<uint32_t>(useCompressed ? compressed.size() : data.size());
+    blob.compression = useCompressed ? PackCompression::ZLIB : PackCompression::NONE;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Another thread may have stored the same bytes meanwhile
+    auto it = catalog_.find(key);
+    if (it != catalog_.end()) {
+        record(it->second);
+        stats_.blobsDeduplicated++;
+        return true;
+    }
+    if (!appendBlob(bytes, blob.storedSize, blob)) {
+        return false;
+    }
+    catalog_[key] = blob;
+    record(blob);
+    stats_.blobsWritten++;
+    stats_.storedBytes += blob.storedSize;
+    return true;
+}
+
+size_t AssetPackWriter::getEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+bool AssetPackWriter::hasEntry(const std::string& normalizedWowPath, uint32_t crc32) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(normalizedWowPath);
+    return it != entries_.end() && it->second.blob.crc32 == crc32;
+}
+
+bool AssetPackWriter::writeCatalog() const {
+    std::string path = catalogPath(storeDir_);
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        FileHeader header{kCatalogMagic, kPackFormatVersion, static_cast<uint32_t>(catalog_.size()), 0};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& [key, blob] : catalog_) {
+            BlobRecord record = toRecord(blob);
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+        if (!out.good()) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    return !ec;
+}
+
+bool AssetPackWriter::writeIndex() const {
+    // Store path relative to the index so the data directory can be moved
+    std::error_code ec;
+    std::filesystem::path indexDir = std::filesystem::absolute(indexPath_, ec).parent_path();
+    std::filesystem::path store = std::filesystem::absolute(storeDir_, ec);
+    std::string relativeStore = store.lexically_relative(indexDir).generic_string();
+    if (relativeStore.empty()) relativeStore = store.generic_string();
+
+    // Sorted for deterministic output
+    std::vector<const std::pair<const std::string, AssetPackReader::Entry>*> sorted;
+    sorted.reserve(entries_.size());
+    for (const auto& kv : entries_) sorted.push_back(&kv);
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    std::string tmpPath = indexPath_ + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        FileHeader header{kIndexMagic, kPackFormatVersion, static_cast<uint32_t>(sorted.size()),
+                          static_cast<uint32_t>(relativeStore.size())};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(relativeStore.data(), static_cast<std::streamsize>(relativeStore.size()));
+        for (const auto* kv : sorted) {
+            BlobRecord record = toRecord(kv->second.blob);
+            uint16_t keyLength = static_cast<uint16_t>(kv->first.size());
+            uint16_t fsLength = static_cast<uint16_t>(kv->second.filesystemPath.size());
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            out.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+            out.write(reinterpret_cast<const char*>(&fsLength), sizeof(fsLength));
+            out.write(kv->first.data(), keyLength);
+            out.write(kv->second.filesystemPath.data(), fsLength);
+        }
+        if (!out.good()) return false;
+    }
+    std::filesystem::rename(tmpPath, indexPath_, ec);
+    return !ec;
+}
+
+bool AssetPackWriter::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (packFile_) {
+        if (std::fflush(packFile_) != 0) {
+            LOG_ERROR("Flush failed on pack ", packId_);
+            return false;
+        }
+        std::fclose(packFile_);
+        packFile_ = nullptr;
+    }
+    // Catalog before index: an index never references blobs the catalog lost
+    if (!writeCatalog()) {
+        LOG_ERROR("Failed to write pack store catalog in ", storeDir_);
+        return false;
+    }
+    if (!writeIndex()) {
+        LOG_ERROR("Failed to write pack index ", indexPath_);
+        return false;
+    }
+    return true;
+}
+
+} // namespace pipeline
+} // namespace wowee
@@ -173,6 +173,112 @@ BLPImage BLPLoader::loadBLP2(const uint8_t* data, size_t size) {
     return image;
 }
 
+size_t BLPCompressedImage::levelSize(BLPCompression compression, int width, int height) {
+    size_t blockBytes = (compression == BLPCompression::DXT1) ? 8 : 16;
+    size_t blocksX = static_cast<size_t>(std::max(1, (width + 3) / 4));
+    size_t blocksY = static_cast<size_t>(std::max(1, (height + 3) / 4));
+    return blocksX * blocksY * blockBytes;
+}
+
+BLPCompressedImage BLPLoader::loadCompressed(const std::vector<uint8_t>& blpData) {
+    if (blpData.size() < sizeof(BLP2Header) || std::memcmp(blpData.data(), "BLP2", 4) != 0) {
+        return BLPCompressedImage();
+    }
+    const BLP2Header* header = reinterpret_cast<const BLP2Header*>(blpData.data());
+    if (header->compression != 2 || header->width == 0 || header->height == 0) {
+        return BLPCompressedImage();
+    }
+
+    BLPCompressedImage image;
+    image.width = static_cast<int>(header->width);
+    image.height = static_cast<int>(header->height);
+    // Same DXT selection as loadBLP2()
+    if (header->alphaDepth == 0 || header->alphaEncoding == 0) {
+        image.compression = BLPCompression::DXT1;
+    } else if (header->alphaEncoding == 1) {
+        image.compression = BLPCompression::DXT3;
+    } else if (header->alphaEncoding == 7) {
+        image.compression = BLPCompression::DXT5;
+    } else {
+        image.compression = BLPCompression::DXT1;
+    }
+
+    // Levels down to 1x1 (or the first missing/truncated one)
+    int w = image.width, h = image.height;
+    const int maxLevels = header->hasMips ? 16 : 1;
+    for (int level = 0; level < maxLevels; level++) {
+        uint32_t offset = header->mipOffsets[level];
+        size_t needed = BLPCompressedImage::levelSize(image.compression, w, h);
+        if (offset == 0 || header->mipSizes[level] < needed || offset + needed > blpData.size()) {
+            break;
+        }
+        image.levels.emplace_back(blpData.begin() + offset, blpData.begin() + offset + needed);
+        if (w == 1 && h == 1) break;
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    if (image.levels.empty()) {
+        return BLPCompressedImage();
+    }
+
+    image.hasAlpha = hasTransparentTexels(image.levels[0].data(), image.compression,
+                                          image.width, image.height);
+    return image;
+}
+
+bool BLPLoader::hasTransparentTexels(const uint8_t* blocks, BLPCompression compression, int width, int height) {
+    // Reads only the alpha-relevant bits of each block; matches the decoders below
+    int blockWidth = (width + 3) / 4;
+    int blockHeight = (height + 3) / 4;
+    size_t blockBytes = (compression == BLPCompression::DXT1) ? 8 : 16;
+
+    for (int by = 0; by < blockHeight; by++) {
+        for (int bx = 0; bx < blockWidth; bx++) {
+            const uint8_t* block = blocks + (by * blockWidth + bx) * blockBytes;
+            uint8_t alphas[8] = {};
+            uint64_t alphaBits = 0;
+            if (compression == BLPCompression::DXT5) {
+                alphas[0] = block[0];
+                alphas[1] = block[1];
+                if (block[0] > block[1]) {
+                    for (int i = 2; i < 8; i++) {
+                        alphas[i] = static_cast<uint8_t>(((8 - i) * block[0] + (i - 1) * block[1]) / 7);
+                    }
+                } else {
+                    for (int i = 2; i < 6; i++) {
+                        alphas[i] = static_cast<uint8_t>(((6 - i) * block[0] + (i - 1) * block[1]) / 5);
+                    }
+                    alphas[6] = 0;
+                    alphas[7] = 255;
+                }
+                for (int i = 2; i < 8; i++) alphaBits |= static_cast<uint64_t>(block[i]) << ((i - 2) * 8);
+            } else if (compression == BLPCompression::DXT3) {
+                for (int i = 0; i < 8; i++) alphaBits |= static_cast<uint64_t>(block[i]) << (i * 8);
+            }
+            uint16_t c0 = block[0] | (block[1] << 8);
+            uint16_t c1 = block[2] | (block[3] << 8);
+            uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+            for (int py = 0; py < 4; py++) {
+                for (int px = 0; px < 4; px++) {
+                    if (bx * 4 + px >= width || by * 4 + py >= height) continue;
+                    int texel = py * 4 + px;
+                    bool transparent = false;
+                    if (compression == BLPCompression::DXT1) {
+                        transparent = c0 <= c1 && ((indices >> (texel * 2)) & 0x3) == 3;
+                    } else if (compression == BLPCompression::DXT3) {
+                        transparent = ((alphaBits >> (texel * 4)) & 0xF) != 0xF;
+                    } else {
+                        transparent = alphas[(alphaBits >> (texel * 3)) & 0x7] != 255;
+                    }
+                    if (transparent) return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 void BLPLoader::decompressDXT1(const uint8_t* src, uint8_t* dst, int width, int height) {
     // DXT1 decompression (8 bytes per 4x4 block)
     int blockWidth = (width + 3) / 4;
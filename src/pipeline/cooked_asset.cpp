@@ -0,0 +1,957 @@
+#include "pipeline/cooked_asset.hpp"
+#include "pipeline/blp_loader.hpp"
+#include "pipeline/m2_loader.hpp"
+#include "pipeline/wmo_loader.hpp"
+#include "pipeline/terrain_mesh.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wowee {
+namespace pipeline {
+
+namespace {
+
+constexpr uint32_t kCookedMagic = 0x444B4357;  // "WCKD"
+constexpr uint32_t kSectionAlignment = 16;
+
+struct CookedHeader {
+    uint32_t magic;
+    uint32_t kind;
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t sourceSize;
+    uint64_t auxSize;
+    uint32_t sourceCrc32;
+    uint32_t auxCrc32;
+    uint32_t keyLength;
+    uint32_t reserved;
+};
+static_assert(sizeof(CookedHeader) == 48, "cooked header layout changed");
+
+struct CookedSection {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct TextureInfo {
+    int32_t width;
+    int32_t height;
+    int32_t levels;
+    uint32_t compression;   // BLPCompression::DXT1/DXT3/DXT5
+    uint32_t hasAlpha;
+    uint32_t reserved;
+};
+
+// Raw-array members of M2Model must stay memcpy-able
+static_assert(std::is_trivially_copyable_v<M2Vertex>, "M2Vertex must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<M2Sequence>, "M2Sequence must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<M2Batch>, "M2Batch must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<M2Material>, "M2Material must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<M2Attachment>, "M2Attachment must be trivially copyable");
+
+// Changes whenever a struct stored as raw bytes changes size
+constexpr uint32_t kM2LayoutSignature =
+    static_cast<uint32_t>(sizeof(M2Vertex) | (sizeof(M2Batch) << 8) | (sizeof(M2Sequence) << 16)) ^
+    static_cast<uint32_t>((sizeof(M2Material) << 4) | (sizeof(M2Attachment) << 12));
+
+static_assert(std::is_trivially_copyable_v<WMOVertex>, "WMOVertex must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<WMOBatch>, "WMOBatch must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<WMOPortal>, "WMOPortal must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<WMOCollisionGrid::TriBounds>, "TriBounds must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<TerrainVertex>, "TerrainVertex must be trivially copyable");
+
+constexpr uint32_t kWMOLayoutSignature =
+    static_cast<uint32_t>(sizeof(WMOVertex) | (sizeof(WMOBatch) << 8) | (sizeof(WMOPortal) << 16));
+constexpr uint32_t kTerrainLayoutSignature = static_cast<uint32_t>(sizeof(TerrainVertex));
+
+uint64_t fnv1a64(const std::string& s) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+const char* kindDirectory(CookedKind kind) {
+    switch (kind) {
+        case CookedKind::TEXTURE: return "tex";
+        case CookedKind::M2_MODEL: return "m2";
+        case CookedKind::WMO_GROUPS: return "wmo";
+        case CookedKind::TERRAIN_MESH: return "terrain";
+    }
+    return "other";
+}
+
+uint32_t kindVersion(CookedKind kind) {
+    switch (kind) {
+        case CookedKind::TEXTURE: return COOKED_TEXTURE_VERSION;
+        case CookedKind::M2_MODEL: return COOKED_M2_VERSION;
+        case CookedKind::WMO_GROUPS: return COOKED_WMO_VERSION;
+        case CookedKind::TERRAIN_MESH: return COOKED_TERRAIN_VERSION;
+    }
+    return 0;
+}
+
+// ---- Blob file: header, key, section table, aligned sections ----
+
+struct SectionRef {
+    const void* data;
+    size_t size;
+};
+
+bool writeBlob(const std::string& path, CookedKind kind, const std::string& key,
+               const CookedSourceStamp& stamp, const std::vector<SectionRef>& sections) {
+    CookedHeader header{};
+    header.magic = kCookedMagic;
+    header.kind = static_cast<uint32_t>(kind);
+    header.version = kindVersion(kind);
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+    header.sourceSize = stamp.size;
+    header.sourceCrc32 = stamp.crc32;
+    header.auxSize = stamp.auxSize;
+    header.auxCrc32 = stamp.auxCrc32;
+    header.keyLength = static_cast<uint32_t>(key.size());
+
+    auto align = [](uint64_t v) { return (v + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment; };
+    std::vector<CookedSection> table(sections.size());
+    uint64_t offset = align(sizeof(header) + key.size() + sizeof(CookedSection) * sections.size());
+    for (size_t i = 0; i < sections.size(); i++) {
+        table[i].offset = offset;
+        table[i].size = sections[i].size;
+        offset = align(offset + sections[i].size);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    // Unique temp name so parallel cook workers never share a file
+    std::string tmpPath = path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        static const char zeros[kSectionAlignment] = {};
+        uint64_t written = 0;
+        auto put = [&](const void* data, size_t size) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            written += size;
+        };
+        put(&header, sizeof(header));
+        put(key.data(), key.size());
+        put(table.data(), sizeof(CookedSection) * table.size());
+        for (size_t i = 0; i < sections.size(); i++) {
+            put(zeros, static_cast<size_t>(table[i].offset - written));
+            if (sections[i].size) put(sections[i].data, sections[i].size);
+        }
+        if (!out.good()) {
+            out.close();
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+// Read-only view of one blob file
+class BlobView {
+public:
+    bool open(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) return false;
+        addr_ = addr;
+        data_ = static_cast<const uint8_t*>(addr);
+        size_ = static_cast<size_t>(st.st_size);
+#else
+        // No mmap wrapper on Windows yet: one read of the whole blob
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return false;
+        auto size = in.tellg();
+        if (size <= 0) return false;
+        buffer_.resize(static_cast<size_t>(size));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(buffer_.data()), size)) return false;
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+        return true;
+    }
+
+    ~BlobView() {
+#ifndef _WIN32
+        if (addr_) munmap(addr_, size_);
+#endif
+    }
+
+    bool validate(CookedKind kind, const std::string& key, const CookedSourceStamp& stamp) {
+        if (size_ < sizeof(CookedHeader)) return false;
+        std::memcpy(&header_, data_, sizeof(header_));
+        if (header_.magic != kCookedMagic || header_.kind != static_cast<uint32_t>(kind) ||
+            header_.version != kindVersion(kind)) {
+            return false;
+        }
+        CookedSourceStamp stored;
+        stored.size = header_.sourceSize;
+        stored.crc32 = header_.sourceCrc32;
+        stored.auxSize = header_.auxSize;
+        stored.auxCrc32 = header_.auxCrc32;
+        if (!(stored == stamp)) return false;
+
+        size_t tableOffset = sizeof(CookedHeader) + header_.keyLength;
+        size_t tableEnd = tableOffset + sizeof(CookedSection) * header_.sectionCount;
+        if (tableEnd > size_) return false;
+        if (header_.keyLength != key.size() ||
+            std::memcmp(data_ + sizeof(CookedHeader), key.data(), key.size()) != 0) {
+            return false;  // Path hash collision
+        }
+        table_.resize(header_.sectionCount);
+        std::memcpy(table_.data(), data_ + tableOffset, sizeof(CookedSection) * table_.size());
+        for (const auto& s : table_) {
+            if (s.offset > size_ || s.size > size_ - s.offset) return false;
+        }
+        return true;
+    }
+
+    size_t sectionCount() const { return table_.size(); }
+    const uint8_t* section(size_t i) const { return data_ + table_[i].offset; }
+    size_t sectionSize(size_t i) const { return static_cast<size_t>(table_[i].size); }
+
+    template <typename T>
+    bool copySection(size_t i, std::vector<T>& out) const {
+        if (i >= table_.size() || sectionSize(i) % sizeof(T) != 0) return false;
+        out.resize(sectionSize(i) / sizeof(T));
+        if (!out.empty()) std::memcpy(out.data(), section(i), sectionSize(i));
+        return true;
+    }
+
+private:
+    CookedHeader header_{};
+    std::vector<CookedSection> table_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifndef _WIN32
+    void* addr_ = nullptr;
+#else
+    std::vector<uint8_t> buffer_;
+#endif
+};
+
+// ---- M2 metadata stream (everything that is not a flat array) ----
+
+class MetaWriter {
+public:
+    template <typename T>
+    void pod(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* p = reinterpret_cast<const uint8_t*>(&v);
+        buf.insert(buf.end(), p, p + sizeof(T));
+    }
+    template <typename T>
+    void podVector(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        pod(static_cast<uint32_t>(v.size()));
+        const auto* p = reinterpret_cast<const uint8_t*>(v.data());
+        buf.insert(buf.end(), p, p + v.size() * sizeof(T));
+    }
+    void string(const std::string& s) {
+        pod(static_cast<uint32_t>(s.size()));
+        buf.insert(buf.end(), s.begin(), s.end());
+    }
+    void track(const M2AnimationTrack& t) {
+        pod(t.interpolationType);
+        pod(t.globalSequence);
+        pod(static_cast<uint32_t>(t.sequences.size()));
+        for (const auto& keys : t.sequences) {
+            podVector(keys.timestamps);
+            podVector(keys.vec3Values);
+            podVector(keys.quatValues);
+            podVector(keys.floatValues);
+        }
+    }
+    void fblock(const M2FBlock& b) {
+        podVector(b.timestamps);
+        podVector(b.floatValues);
+        podVector(b.vec3Values);
+    }
+
+    std::vector<uint8_t> buf;
+};
+
+class MetaReader {
+public:
+    MetaReader(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+    template <typename T>
+    void pod(T& v) {
+        if (!ok || static_cast<size_t>(end_ - p_) < sizeof(T)) {
+            ok = false;
+            return;
+        }
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+    }
+    uint32_t count(size_t elementSize) {
+        uint32_t n = 0;
+        pod(n);
+        // Every element needs at least elementSize bytes: reject absurd counts
+        if (ok && elementSize && static_cast<size_t>(end_ - p_) / elementSize < n) ok = false;
+        return ok ? n : 0;
+    }
+    template <typename T>
+    void podVector(std::vector<T>& v) {
+        uint32_t n = count(sizeof(T));
+        v.resize(n);
+        if (n) {
+            std::memcpy(v.data(), p_, n * sizeof(T));
+            p_ += n * sizeof(T);
+        }
+    }
+    void string(std::string& s) {
+        uint32_t n = count(1);
+        s.assign(reinterpret_cast<const char*>(p_), n);
+        p_ += n;
+    }
+    void track(M2AnimationTrack& t) {
+        pod(t.interpolationType);
+        pod(t.globalSequence);
+        t.sequences.resize(count(16));
+        for (auto& keys : t.sequences) {
+            podVector(keys.timestamps);
+            podVector(keys.vec3Values);
+            podVector(keys.quatValues);
+            podVector(keys.floatValues);
+        }
+    }
+    void fblock(M2FBlock& b) {
+        podVector(b.timestamps);
+        podVector(b.floatValues);
+        podVector(b.vec3Values);
+    }
+
+    bool ok = true;
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+};
+
+enum M2Section : size_t {
+    M2_META = 0,
+    M2_VERTICES,
+    M2_INDICES,
+    M2_COLLISION_VERTICES,
+    M2_COLLISION_INDICES,
+    M2_COLLISION_NORMALS,
+    M2_SECTION_COUNT
+};
+
+void writeM2Meta(MetaWriter& w, const M2Model& m) {
+    w.pod(kM2LayoutSignature);
+    w.string(m.name);
+    w.pod(m.version);
+    w.pod(m.boundMin);
+    w.pod(m.boundMax);
+    w.pod(m.boundRadius);
+    w.pod(m.globalFlags);
+
+    w.pod(static_cast<uint32_t>(m.bones.size()));
+    for (const auto& b : m.bones) {
+        w.pod(b.keyBoneId);
+        w.pod(b.flags);
+        w.pod(b.parentBone);
+        w.pod(b.submeshId);
+        w.pod(b.pivot);
+        w.track(b.translation);
+        w.track(b.rotation);
+        w.track(b.scale);
+    }
+    w.podVector(m.sequences);
+    w.podVector(m.globalSequenceDurations);
+    w.podVector(m.boneLookupTable);
+    w.podVector(m.batches);
+
+    w.pod(static_cast<uint32_t>(m.textures.size()));
+    for (const auto& t : m.textures) {
+        w.pod(t.type);
+        w.pod(t.flags);
+        w.string(t.filename);
+    }
+    w.podVector(m.textureLookup);
+    w.podVector(m.materials);
+
+    w.pod(static_cast<uint32_t>(m.textureTransforms.size()));
+    for (const auto& t : m.textureTransforms) {
+        w.track(t.translation);
+        w.track(t.rotation);
+        w.track(t.scale);
+    }
+    w.podVector(m.textureTransformLookup);
+    w.podVector(m.textureWeights);
+    w.podVector(m.colorAlphas);
+    w.podVector(m.attachments);
+    w.podVector(m.attachmentLookup);
+
+    w.pod(static_cast<uint32_t>(m.particleEmitters.size()));
+    for (const auto& e : m.particleEmitters) {
+        w.pod(e.particleId);
+        w.pod(e.flags);
+        w.pod(e.position);
+        w.pod(e.bone);
+        w.pod(e.texture);
+        w.pod(e.blendingType);
+        w.pod(e.emitterType);
+        w.pod(e.textureTileRotation);
+        w.pod(e.textureRows);
+        w.pod(e.textureCols);
+        w.track(e.emissionSpeed);
+        w.track(e.speedVariation);
+        w.track(e.verticalRange);
+        w.track(e.horizontalRange);
+        w.track(e.gravity);
+        w.track(e.lifespan);
+        w.track(e.emissionRate);
+        w.track(e.emissionAreaLength);
+        w.track(e.emissionAreaWidth);
+        w.track(e.deceleration);
+        w.fblock(e.particleColor);
+        w.fblock(e.particleAlpha);
+        w.fblock(e.particleScale);
+        w.pod(static_cast<uint8_t>(e.enabled));
+    }
+}
+
+bool readM2Meta(MetaReader& r, M2Model& m) {
+    uint32_t signature = 0;
+    r.pod(signature);
+    if (!r.ok || signature != kM2LayoutSignature) return false;
+    r.string(m.name);
+    r.pod(m.version);
+    r.pod(m.boundMin);
+    r.pod(m.boundMax);
+    r.pod(m.boundRadius);
+    r.pod(m.globalFlags);
+
+    m.bones.resize(r.count(16));
+    for (auto& b : m.bones) {
+        r.pod(b.keyBoneId);
+        r.pod(b.flags);
+        r.pod(b.parentBone);
+        r.pod(b.submeshId);
+        r.pod(b.pivot);
+        r.track(b.translation);
+        r.track(b.rotation);
+        r.track(b.scale);
+    }
+    r.podVector(m.sequences);
+    r.podVector(m.globalSequenceDurations);
+    r.podVector(m.boneLookupTable);
+    r.podVector(m.batches);
+
+    m.textures.resize(r.count(12));
+    for (auto& t : m.textures) {
+        r.pod(t.type);
+        r.pod(t.flags);
+        r.string(t.filename);
+    }
+    r.podVector(m.textureLookup);
+    r.podVector(m.materials);
+
+    m.textureTransforms.resize(r.count(24));
+    for (auto& t : m.textureTransforms) {
+        r.track(t.translation);
+        r.track(t.rotation);
+        r.track(t.scale);
+    }
+    r.podVector(m.textureTransformLookup);
+    r.podVector(m.textureWeights);
+    r.podVector(m.colorAlphas);
+    r.podVector(m.attachments);
+    r.podVector(m.attachmentLookup);
+
+    m.particleEmitters.resize(r.count(64));
+    for (auto& e : m.particleEmitters) {
+        r.pod(e.particleId);
+        r.pod(e.flags);
+        r.pod(e.position);
+        r.pod(e.bone);
+        r.pod(e.texture);
+        r.pod(e.blendingType);
+        r.pod(e.emitterType);
+        r.pod(e.textureTileRotation);
+        r.pod(e.textureRows);
+        r.pod(e.textureCols);
+        r.track(e.emissionSpeed);
+        r.track(e.speedVariation);
+        r.track(e.verticalRange);
+        r.track(e.horizontalRange);
+        r.track(e.gravity);
+        r.track(e.lifespan);
+        r.track(e.emissionRate);
+        r.track(e.emissionAreaLength);
+        r.track(e.emissionAreaWidth);
+        r.track(e.deceleration);
+        r.fblock(e.particleColor);
+        r.fblock(e.particleAlpha);
+        r.fblock(e.particleScale);
+        uint8_t enabled = 1;
+        r.pod(enabled);
+        e.enabled = enabled != 0;
+    }
+    return r.ok;
+}
+
+// ---- WMO groups: per-group metadata + grid in META, geometry concatenated ----
+
+enum WMOSection : size_t {
+    WMO_META = 0,
+    WMO_VERTICES,
+    WMO_INDICES,
+    WMO_SECTION_COUNT
+};
+
+void writeWMOGroupMeta(MetaWriter& w, const WMOGroup& g, const WMOCollisionGrid& grid) {
+    w.pod(g.flags);
+    w.pod(g.boundingBoxMin);
+    w.pod(g.boundingBoxMax);
+    w.pod(g.portalStart);
+    w.pod(g.portalCount);
+    w.pod(g.batchCountA);
+    w.pod(g.batchCountB);
+    w.pod(g.fogIndices);
+    w.pod(g.liquidType);
+    w.pod(g.groupId);
+    w.pod(static_cast<uint32_t>(g.vertices.size()));
+    w.pod(static_cast<uint32_t>(g.indices.size()));
+    w.podVector(g.batches);
+    w.podVector(g.portals);
+    w.podVector(g.portalVertices);
+    w.podVector(g.bspNodes);
+
+    w.pod(g.liquid.xVerts);
+    w.pod(g.liquid.yVerts);
+    w.pod(g.liquid.xTiles);
+    w.pod(g.liquid.yTiles);
+    w.pod(g.liquid.basePosition);
+    w.pod(g.liquid.materialId);
+    w.podVector(g.liquid.heights);
+    w.podVector(g.liquid.flags);
+    w.string(g.name);
+    w.string(g.description);
+
+    w.pod(grid.boundsMin);
+    w.pod(grid.boundsMax);
+    w.pod(grid.origin);
+    w.pod(grid.cellsX);
+    w.pod(grid.cellsY);
+    for (size_t c = 0; c < WMOCollisionGrid::CLASS_COUNT; c++) {
+        w.podVector(grid.cellOffsets[c]);
+        w.podVector(grid.cellTriangles[c]);
+    }
+    w.podVector(grid.triBounds);
+}
+
+bool readWMOGroupMeta(MetaReader& r, WMOGroup& g, uint32_t& vertexCount, uint32_t& indexCount) {
+    r.pod(g.flags);
+    r.pod(g.boundingBoxMin);
+    r.pod(g.boundingBoxMax);
+    r.pod(g.portalStart);
+    r.pod(g.portalCount);
+    r.pod(g.batchCountA);
+    r.pod(g.batchCountB);
+    r.pod(g.fogIndices);
+    r.pod(g.liquidType);
+    r.pod(g.groupId);
+    r.pod(vertexCount);
+    r.pod(indexCount);
+    r.podVector(g.batches);
+    r.podVector(g.portals);
+    r.podVector(g.portalVertices);
+    r.podVector(g.bspNodes);
+
+    r.pod(g.liquid.xVerts);
+    r.pod(g.liquid.yVerts);
+    r.pod(g.liquid.xTiles);
+    r.pod(g.liquid.yTiles);
+    r.pod(g.liquid.basePosition);
+    r.pod(g.liquid.materialId);
+    r.podVector(g.liquid.heights);
+    r.podVector(g.liquid.flags);
+    r.string(g.name);
+    r.string(g.description);
+
+    auto& grid = g.collisionGrid;
+    r.pod(grid.boundsMin);
+    r.pod(grid.boundsMax);
+    r.pod(grid.origin);
+    r.pod(grid.cellsX);
+    r.pod(grid.cellsY);
+    for (size_t c = 0; c < WMOCollisionGrid::CLASS_COUNT; c++) {
+        r.podVector(grid.cellOffsets[c]);
+        r.podVector(grid.cellTriangles[c]);
+    }
+    r.podVector(grid.triBounds);
+    if (!r.ok) return false;
+
+    // query() indexes these without checks
+    if (grid.cellsX < 0 || grid.cellsY < 0) return false;
+    if (!grid.isEmpty()) {
+        size_t offsetCount = static_cast<size_t>(grid.cellsX) * grid.cellsY + 1;
+        for (size_t c = 0; c < WMOCollisionGrid::CLASS_COUNT; c++) {
+            if (grid.cellOffsets[c].size() != offsetCount ||
+                grid.cellOffsets[c].back() != grid.cellTriangles[c].size()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ---- Terrain mesh: per-chunk metadata in META, geometry concatenated ----
+
+enum TerrainSection : size_t {
+    TERRAIN_META = 0,
+    TERRAIN_VERTICES,
+    TERRAIN_INDICES,
+    TERRAIN_SECTION_COUNT
+};
+
+void writeTerrainMeta(MetaWriter& w, const TerrainMesh& mesh) {
+    w.pod(kTerrainLayoutSignature);
+    w.pod(static_cast<int32_t>(mesh.validChunkCount));
+    w.pod(static_cast<uint32_t>(mesh.textures.size()));
+    for (const auto& t : mesh.textures) w.string(t);
+    for (const auto& chunk : mesh.chunks) {
+        w.pod(static_cast<uint32_t>(chunk.vertices.size()));
+        w.pod(static_cast<uint32_t>(chunk.indices.size()));
+        w.pod(chunk.worldX);
+        w.pod(chunk.worldY);
+        w.pod(chunk.worldZ);
+        w.pod(static_cast<int32_t>(chunk.chunkX));
+        w.pod(static_cast<int32_t>(chunk.chunkY));
+        w.pod(static_cast<uint32_t>(chunk.layers.size()));
+        for (const auto& layer : chunk.layers) {
+            w.pod(layer.textureId);
+            w.pod(layer.flags);
+            w.podVector(layer.alphaData);
+        }
+    }
+}
+
+} // namespace
+
+CookedAssetStore::CookedAssetStore(std::string directory)
+    : directory_(std::move(directory)) {
+    std::error_code ec;
+    available_ = !directory_.empty() && std::filesystem::is_directory(directory_, ec);
+}
+
+std::string CookedAssetStore::blobPath(CookedKind kind, const std::string& normalizedPath) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.wck",
+                  static_cast<unsigned long long>(fnv1a64(normalizedPath)));
+    return directory_ + "/" + kindDirectory(kind) + "/" + name;
+}
+
+bool CookedAssetStore::isFresh(CookedKind kind, const std::string& normalizedPath,
+                               const CookedSourceStamp& stamp) const {
+    BlobView blob;
+    return blob.open(blobPath(kind, normalizedPath)) && blob.validate(kind, normalizedPath, stamp);
+}
+
+bool CookedAssetStore::loadTexture(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                                   BLPCompressedImage& image) const {
+    if (!available_) return false;
+    BlobView blob;
+    if (!blob.open(blobPath(CookedKind::TEXTURE, normalizedPath)) ||
+        !blob.validate(CookedKind::TEXTURE, normalizedPath, stamp) ||
+        blob.sectionCount() < 2 || blob.sectionSize(0) != sizeof(TextureInfo)) {
+        return false;
+    }
+    TextureInfo info{};
+    std::memcpy(&info, blob.section(0), sizeof(info));
+    if (info.width <= 0 || info.height <= 0 || info.levels < 1 ||
+        blob.sectionCount() != static_cast<size_t>(info.levels) + 1) {
+        return false;
+    }
+
+    BLPCompressedImage result;
+    result.width = info.width;
+    result.height = info.height;
+    result.compression = static_cast<BLPCompression>(info.compression);
+    result.hasAlpha = info.hasAlpha != 0;
+    result.levels.resize(static_cast<size_t>(info.levels));
+    int w = info.width, h = info.height;
+    for (size_t i = 0; i < result.levels.size(); i++) {
+        // Each level must be exactly the size glCompressedTexImage2D expects
+        if (blob.sectionSize(i + 1) != BLPCompressedImage::levelSize(result.compression, w, h) ||
+            !blob.copySection(i + 1, result.levels[i])) {
+            return false;
+        }
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    if (!result.isValid()) return false;
+    image = std::move(result);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CookedAssetStore::storeTexture(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                                    const BLPCompressedImage& image) const {
+    if (!image.isValid()) return false;
+
+    TextureInfo info{};
+    info.width = image.width;
+    info.height = image.height;
+    info.levels = static_cast<int32_t>(image.levels.size());
+    info.compression = static_cast<uint32_t>(image.compression);
+    info.hasAlpha = image.hasAlpha ? 1u : 0u;
+
+    std::vector<SectionRef> sections;
+    sections.push_back({&info, sizeof(info)});
+    for (const auto& level : image.levels) {
+        sections.push_back({level.data(), level.size()});
+    }
+    return writeBlob(blobPath(CookedKind::TEXTURE, normalizedPath), CookedKind::TEXTURE,
+                     normalizedPath, stamp, sections);
+}
+
+bool CookedAssetStore::loadM2(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                              M2Model& model) const {
+    if (!available_) return false;
+    BlobView blob;
+    if (!blob.open(blobPath(CookedKind::M2_MODEL, normalizedPath)) ||
+        !blob.validate(CookedKind::M2_MODEL, normalizedPath, stamp) ||
+        blob.sectionCount() != M2_SECTION_COUNT) {
+        return false;
+    }
+
+    M2Model result;
+    MetaReader meta(blob.section(M2_META), blob.sectionSize(M2_META));
+    if (!readM2Meta(meta, result) ||
+        !blob.copySection(M2_VERTICES, result.vertices) ||
+        !blob.copySection(M2_INDICES, result.indices) ||
+        !blob.copySection(M2_COLLISION_VERTICES, result.collisionVertices) ||
+        !blob.copySection(M2_COLLISION_INDICES, result.collisionIndices) ||
+        !blob.copySection(M2_COLLISION_NORMALS, result.collisionNormals)) {
+        LOG_WARNING("Cooked M2 unreadable, ignoring: ", normalizedPath);
+        return false;
+    }
+    model = std::move(result);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CookedAssetStore::storeM2(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                               const M2Model& model) const {
+    if (!model.isValid()) return false;
+    MetaWriter meta;
+    writeM2Meta(meta, model);
+
+    std::vector<SectionRef> sections(M2_SECTION_COUNT);
+    sections[M2_META] = {meta.buf.data(), meta.buf.size()};
+    sections[M2_VERTICES] = {model.vertices.data(), model.vertices.size() * sizeof(M2Vertex)};
+    sections[M2_INDICES] = {model.indices.data(), model.indices.size() * sizeof(uint16_t)};
+    sections[M2_COLLISION_VERTICES] = {model.collisionVertices.data(),
+                                       model.collisionVertices.size() * sizeof(glm::vec3)};
+    sections[M2_COLLISION_INDICES] = {model.collisionIndices.data(),
+                                      model.collisionIndices.size() * sizeof(uint16_t)};
+    sections[M2_COLLISION_NORMALS] = {model.collisionNormals.data(),
+                                      model.collisionNormals.size() * sizeof(glm::vec4)};
+    return writeBlob(blobPath(CookedKind::M2_MODEL, normalizedPath), CookedKind::M2_MODEL,
+                     normalizedPath, stamp, sections);
+}
+
+bool CookedAssetStore::loadWMOGroups(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                                     WMOModel& model) const {
+    if (!available_) return false;
+    BlobView blob;
+    if (!blob.open(blobPath(CookedKind::WMO_GROUPS, normalizedPath)) ||
+        !blob.validate(CookedKind::WMO_GROUPS, normalizedPath, stamp) ||
+        blob.sectionCount() != WMO_SECTION_COUNT ||
+        blob.sectionSize(WMO_VERTICES) % sizeof(WMOVertex) != 0 ||
+        blob.sectionSize(WMO_INDICES) % sizeof(uint16_t) != 0) {
+        return false;
+    }
+
+    MetaReader meta(blob.section(WMO_META), blob.sectionSize(WMO_META));
+    uint32_t signature = 0, groupCount = 0;
+    meta.pod(signature);
+    meta.pod(groupCount);
+    if (!meta.ok || signature != kWMOLayoutSignature || groupCount != model.groups.size()) {
+        return false;
+    }
+
+    std::vector<WMOGroup> groups(groupCount);
+    const uint8_t* vertexData = blob.section(WMO_VERTICES);
+    const uint8_t* indexData = blob.section(WMO_INDICES);
+    size_t vertexLeft = blob.sectionSize(WMO_VERTICES) / sizeof(WMOVertex);
+    size_t indexLeft = blob.sectionSize(WMO_INDICES) / sizeof(uint16_t);
+    for (auto& group : groups) {
+        uint32_t vertexCount = 0, indexCount = 0;
+        if (!readWMOGroupMeta(meta, group, vertexCount, indexCount) ||
+            vertexCount > vertexLeft || indexCount > indexLeft) {
+            LOG_WARNING("Cooked WMO groups unreadable, ignoring: ", normalizedPath);
+            return false;
+        }
+        group.vertices.resize(vertexCount);
+        group.indices.resize(indexCount);
+        if (vertexCount) std::memcpy(group.vertices.data(), vertexData, vertexCount * sizeof(WMOVertex));
+        if (indexCount) std::memcpy(group.indices.data(), indexData, indexCount * sizeof(uint16_t));
+        vertexData += vertexCount * sizeof(WMOVertex);
+        indexData += indexCount * sizeof(uint16_t);
+        vertexLeft -= vertexCount;
+        indexLeft -= indexCount;
+    }
+    model.groups = std::move(groups);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CookedAssetStore::storeWMOGroups(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                                      const WMOModel& model) const {
+    if (!model.isValid()) return false;
+    MetaWriter meta;
+    meta.pod(kWMOLayoutSignature);
+    meta.pod(static_cast<uint32_t>(model.groups.size()));
+
+    std::vector<WMOVertex> vertices;
+    std::vector<uint16_t> indices;
+    std::vector<glm::vec3> positions;
+    for (const auto& group : model.groups) {
+        WMOCollisionGrid built;
+        const WMOCollisionGrid* grid = &group.collisionGrid;
+        if (grid->isEmpty()) {
+            // Same input as WMORenderer::createGroupResources
+            positions.clear();
+            positions.reserve(group.vertices.size());
+            for (const auto& v : group.vertices) positions.push_back(v.position);
+            built.build(positions, group.indices);
+            grid = &built;
+        }
+        writeWMOGroupMeta(meta, group, *grid);
+        vertices.insert(vertices.end(), group.vertices.begin(), group.vertices.end());
+        indices.insert(indices.end(), group.indices.begin(), group.indices.end());
+    }
+
+    std::vector<SectionRef> sections(WMO_SECTION_COUNT);
+    sections[WMO_META] = {meta.buf.data(), meta.buf.size()};
+    sections[WMO_VERTICES] = {vertices.data(), vertices.size() * sizeof(WMOVertex)};
+    sections[WMO_INDICES] = {indices.data(), indices.size() * sizeof(uint16_t)};
+    return writeBlob(blobPath(CookedKind::WMO_GROUPS, normalizedPath), CookedKind::WMO_GROUPS,
+                     normalizedPath, stamp, sections);
+}
+
+bool CookedAssetStore::loadTerrainMesh(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                                       TerrainMesh& mesh) const {
+    if (!available_) return false;
+    BlobView blob;
+    if (!blob.open(blobPath(CookedKind::TERRAIN_MESH, normalizedPath)) ||
+        !blob.validate(CookedKind::TERRAIN_MESH, normalizedPath, stamp) ||
+        blob.sectionCount() != TERRAIN_SECTION_COUNT ||
+        blob.sectionSize(TERRAIN_VERTICES) % sizeof(TerrainVertex) != 0 ||
+        blob.sectionSize(TERRAIN_INDICES) % sizeof(TerrainIndex) != 0) {
+        return false;
+    }
+
+    MetaReader r(blob.section(TERRAIN_META), blob.sectionSize(TERRAIN_META));
+    uint32_t signature = 0;
+    int32_t validChunks = 0;
+    r.pod(signature);
+    r.pod(validChunks);
+    if (!r.ok || signature != kTerrainLayoutSignature) return false;
+
+    TerrainMesh result;
+    result.validChunkCount = validChunks;
+    result.textures.resize(r.count(4));
+    for (auto& t : result.textures) r.string(t);
+
+    const uint8_t* vertexData = blob.section(TERRAIN_VERTICES);
+    const uint8_t* indexData = blob.section(TERRAIN_INDICES);
+    size_t vertexLeft = blob.sectionSize(TERRAIN_VERTICES) / sizeof(TerrainVertex);
+    size_t indexLeft = blob.sectionSize(TERRAIN_INDICES) / sizeof(TerrainIndex);
+    for (auto& chunk : result.chunks) {
+        uint32_t vertexCount = 0, indexCount = 0;
+        int32_t chunkX = 0, chunkY = 0;
+        r.pod(vertexCount);
+        r.pod(indexCount);
+        r.pod(chunk.worldX);
+        r.pod(chunk.worldY);
+        r.pod(chunk.worldZ);
+        r.pod(chunkX);
+        r.pod(chunkY);
+        chunk.chunkX = chunkX;
+        chunk.chunkY = chunkY;
+        chunk.layers.resize(r.count(12));
+        for (auto& layer : chunk.layers) {
+            r.pod(layer.textureId);
+            r.pod(layer.flags);
+            r.podVector(layer.alphaData);
+        }
+        if (!r.ok || vertexCount > vertexLeft || indexCount > indexLeft) {
+            LOG_WARNING("Cooked terrain mesh unreadable, ignoring: ", normalizedPath);
+            return false;
+        }
+        chunk.vertices.resize(vertexCount);
+        chunk.indices.resize(indexCount);
+        if (vertexCount) std::memcpy(chunk.vertices.data(), vertexData, vertexCount * sizeof(TerrainVertex));
+        if (indexCount) std::memcpy(chunk.indices.data(), indexData, indexCount * sizeof(TerrainIndex));
+        vertexData += vertexCount * sizeof(TerrainVertex);
+        indexData += indexCount * sizeof(TerrainIndex);
+        vertexLeft -= vertexCount;
+        indexLeft -= indexCount;
+    }
+    mesh = std::move(result);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CookedAssetStore::storeTerrainMesh(const std::string& normalizedPath, const CookedSourceStamp& stamp,
+                                        const TerrainMesh& mesh) const {
+    if (mesh.validChunkCount == 0) return false;
+    MetaWriter meta;
+    writeTerrainMeta(meta, mesh);
+
+    std::vector<TerrainVertex> vertices;
+    std::vector<TerrainIndex> indices;
+    for (const auto& chunk : mesh.chunks) {
+        vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        indices.insert(indices.end(), chunk.indices.begin(), chunk.indices.end());
+    }
+
+    std::vector<SectionRef> sections(TERRAIN_SECTION_COUNT);
+    sections[TERRAIN_META] = {meta.buf.data(), meta.buf.size()};
+    sections[TERRAIN_VERTICES] = {vertices.data(), vertices.size() * sizeof(TerrainVertex)};
+    sections[TERRAIN_INDICES] = {indices.data(), indices.size() * sizeof(TerrainIndex)};
+    return writeBlob(blobPath(CookedKind::TERRAIN_MESH, normalizedPath), CookedKind::TERRAIN_MESH,
+                     normalizedPath, stamp, sections);
+}
+
+} // namespace pipeline
+} // namespace wowee
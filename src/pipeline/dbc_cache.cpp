@@ -0,0 +1,222 @@
+#include "pipeline/dbc_cache.hpp"
+#include "pipeline/dbc_loader.hpp"
+#include "core/logger.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wowee {
+namespace pipeline {
+
+namespace {
+
+constexpr uint32_t kDBCCacheMagic = 0x43434457;  // "WDCC"
+// Bump when DBCFile::loadCSV semantics change so old blobs are recompiled
+constexpr uint32_t kDBCCacheVersion = 1;
+constexpr uint32_t kWDBCAlignment = 16;
+
+// Fixed-size file header; followed by the key, padding, then the WDBC image
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint32_t keyLength;
+    uint32_t wdbcOffset;
+    uint64_t wdbcSize;
+};
+static_assert(sizeof(CacheHeader) == 40, "DBC cache header layout changed");
+
+uint64_t fnv1a64(const std::string& s) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+#ifndef _WIN32
+// Read-only mapping released when the last DBCFile using it goes away
+struct MappedFile {
+    void* addr = nullptr;
+    size_t size = 0;
+    ~MappedFile() {
+        if (addr) munmap(addr, size);
+    }
+};
+
+std::shared_ptr<const void> mapFile(const std::string& path, const uint8_t*& data, size_t& size) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return nullptr;
+
+    auto mapping = std::make_shared<MappedFile>();
+    mapping->addr = addr;
+    mapping->size = static_cast<size_t>(st.st_size);
+    data = static_cast<const uint8_t*>(addr);
+    size = mapping->size;
+    return mapping;
+}
+#else
+// No mmap wrapper on Windows yet: one read into a shared buffer still skips parsing
+std::shared_ptr<const void> mapFile(const std::string& path, const uint8_t*& data, size_t& size) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return nullptr;
+    auto fileSize = file.tellg();
+    if (fileSize <= 0) return nullptr;
+    auto buffer = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(fileSize));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer->data()), fileSize)) return nullptr;
+    data = buffer->data();
+    size = buffer->size();
+    return buffer;
+}
+#endif
+
+} // namespace
+
+DBCBinaryCache::DBCBinaryCache() {
+    if (const char* env = std::getenv("WOWEE_DBC_CACHE_DIR")) {
+        directory_ = env;  // Empty value disables the cache
+    } else if (const char* home = std::getenv("HOME")) {
+        directory_ = std::string(home) + "/.local/share/wowee/dbc_cache";
+    } else {
+        directory_ = "./dbc_cache";
+    }
+    if (directory_.empty()) {
+        LOG_INFO("DBC binary cache disabled");
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        LOG_WARNING("DBC cache directory unavailable (", directory_, "): ", ec.message());
+        directory_.clear();
+        return;
+    }
+    LOG_INFO("DBC binary cache at ", directory_);
+}
+
+bool DBCBinaryCache::stampSource(const std::string& csvPath, SourceStamp& out) const {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(csvPath, ec);
+    out.key = ec ? csvPath : canonical.string();
+    out.size = std::filesystem::file_size(csvPath, ec);
+    if (ec) return false;
+    auto mtime = std::filesystem::last_write_time(csvPath, ec);
+    if (ec) return false;
+    out.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+std::string DBCBinaryCache::cachePathFor(const std::string& key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.wdbc", static_cast<unsigned long long>(fnv1a64(key)));
+    return directory_ + "/" + name;
+}
+
+std::shared_ptr<DBCFile> DBCBinaryCache::load(const std::string& csvPath) const {
+    if (directory_.empty()) return nullptr;
+
+    SourceStamp stamp;
+    if (!stampSource(csvPath, stamp)) return nullptr;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    auto storage = mapFile(cachePathFor(stamp.key), data, size);
+    if (!storage) return nullptr;
+
+    if (size < sizeof(CacheHeader)) return nullptr;
+    CacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kDBCCacheMagic || header.version != kDBCCacheVersion ||
+        header.sourceSize != stamp.size || header.sourceMtime != stamp.mtime ||
+        header.keyLength != stamp.key.size()) {
+        return nullptr;  // Stale: CSV edited, parser changed, or different file
+    }
+    if (sizeof(CacheHeader) + header.keyLength > size ||
+        std::memcmp(data + sizeof(CacheHeader), stamp.key.data(), header.keyLength) != 0) {
+        return nullptr;  // Hash collision
+    }
+    if (header.wdbcOffset % kWDBCAlignment != 0 || header.wdbcOffset > size ||
+        header.wdbcSize > size - header.wdbcOffset) {
+        return nullptr;
+    }
+
+    auto dbc = std::make_shared<DBCFile>();
+    if (!dbc->loadView(data + header.wdbcOffset, static_cast<size_t>(header.wdbcSize), std::move(storage))) {
+        LOG_WARNING("Corrupt DBC cache entry for ", csvPath);
+        return nullptr;
+    }
+    return dbc;
+}
+
+bool DBCBinaryCache::store(const std::string& csvPath, const DBCFile& dbc) const {
+    if (directory_.empty() || !dbc.isLoaded()) return false;
+
+    SourceStamp stamp;
+    if (!stampSource(csvPath, stamp)) return false;
+
+    const std::vector<uint8_t> wdbc = dbc.toWDBC();
+    CacheHeader header{};
+    header.magic = kDBCCacheMagic;
+    header.version = kDBCCacheVersion;
+    header.sourceSize = stamp.size;
+    header.sourceMtime = stamp.mtime;
+    header.keyLength = static_cast<uint32_t>(stamp.key.size());
+    header.wdbcOffset = static_cast<uint32_t>(
+        (sizeof(CacheHeader) + stamp.key.size() + kWDBCAlignment - 1) / kWDBCAlignment * kWDBCAlignment);
+    header.wdbcSize = wdbc.size();
+
+    const std::string path = cachePathFor(stamp.key);
+    // Write to a per-thread temp file and rename so concurrent loaders never
+    // map a partial entry.
+    const std::string tmpPath = path + ".tmp" +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        const size_t padding = header.wdbcOffset - sizeof(CacheHeader) - stamp.key.size();
+        const char zeros[kWDBCAlignment] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(stamp.key.data(), static_cast<std::streamsize>(stamp.key.size()));
+        file.write(zeros, static_cast<std::streamsize>(padding));
+        file.write(reinterpret_cast<const char*>(wdbc.data()), static_cast<std::streamsize>(wdbc.size()));
+        if (!file) {
+            file.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    LOG_DEBUG("Compiled DBC cache: ", csvPath, " -> ", path, " (", wdbc.size(), " bytes)");
+    return true;
+}
+
+} // namespace pipeline
+} // namespace wowee
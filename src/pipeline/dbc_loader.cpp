@@ -1,16 +1,20 @@
 #include "pipeline/dbc_loader.hpp"
 #include "core/logger.hpp"
+#include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <climits>
+#include <cstdint>
 #include <cstring>
 #include <set>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 namespace wowee {
 namespace pipeline {
 
 namespace {
-std::string trimAscii(std::string s) {
+std::string_view trimAscii(std::string_view s) {
     size_t b = 0;
     while (b < s.size() && std::isspace(static_cast<unsigned char>(s[b]))) {
         ++b;
@@ -21,6 +25,39 @@ std::string trimAscii(std::string s) {
     }
     return s.substr(b, e - b);
 }
+
+const char* findLineEnd(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl : end;
+}
+
+// Line contents without the newline or a trailing '\r' (CRLF exports)
+std::string_view trimLineEnd(const char* begin, const char* lineEnd) {
+    if (lineEnd > begin && lineEnd[-1] == '\r') --lineEnd;
+    return std::string_view(begin, static_cast<size_t>(lineEnd - begin));
+}
+
+uint32_t hashId(uint32_t id) {
+    return (id * 0x9E3779B1u) ^ (id >> 16);
+}
+
+// Numeric CSV token with std::stoul semantics as used by the previous
+// parser: leading whitespace and sign accepted, trailing junk ignored,
+// negative values wrap, non-numeric or out-of-range tokens become 0.
+uint32_t parseUInt(const char* p, const char* end) {
+    while (p < end && std::isspace(static_cast<unsigned char>(*p))) ++p;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc() || ptr == p) {
+        return 0;
+    }
+    return static_cast<uint32_t>(negative ? (0 - value) : value);
+}
 } // namespace
 
 DBCFile::DBCFile() = default;
@@ -37,32 +74,78 @@ bool DBCFile::load(const std::vector<uint8_t>& dbcData) {
         return loadCSV(dbcData);
     }
 
-    if (dbcData.size() < sizeof(DBCHeader)) {
+    if (!readHeader(dbcData.data(), dbcData.size())) {
+        return false;
+    }
+
+    // Copy record data
+    const uint8_t* recordStart = dbcData.data() + sizeof(DBCHeader);
+    uint32_t totalRecordSize = recordCount * recordSize;
+    recordData.resize(totalRecordSize);
+    std::memcpy(recordData.data(), recordStart, totalRecordSize);
+
+    // Copy string block
+    const uint8_t* stringStart = recordStart + totalRecordSize;
+    stringBlock.resize(stringBlockSize);
+    if (stringBlockSize > 0) {
+        std::memcpy(stringBlock.data(), stringStart, stringBlockSize);
+    }
+
+    viewStorage_.reset();
+    loaded = true;
+    resetIdIndex();
+
+    return true;
+}
+
+bool DBCFile::loadView(const uint8_t* data, size_t size, std::shared_ptr<const void> storage) {
+    if (!data || !storage || !readHeader(data, size)) {
+        return false;
+    }
+
+    recordData.clear();
+    recordData.shrink_to_fit();
+    stringBlock.clear();
+    stringBlock.shrink_to_fit();
+    viewStorage_ = std::move(storage);
+    viewRecords_ = data + sizeof(DBCHeader);
+    viewStrings_ = viewRecords_ + static_cast<size_t>(recordCount) * recordSize;
+
+    loaded = true;
+    resetIdIndex();
+
+    return true;
+}
+
+bool DBCFile::readHeader(const uint8_t* data, size_t size) {
+    if (size < sizeof(DBCHeader)) {
         LOG_ERROR("DBC data too small for header");
         return false;
     }
 
     // Read header
-    const DBCHeader* header = reinterpret_cast<const DBCHeader*>(dbcData.data());
+    DBCHeader header;
+    std::memcpy(&header, data, sizeof(DBCHeader));
 
     // Verify magic
-    if (std::memcmp(header->magic, "WDBC", 4) != 0) {
-        LOG_ERROR("Invalid DBC magic: ", std::string(header->magic, 4));
+    if (std::memcmp(header.magic, "WDBC", 4) != 0) {
+        LOG_ERROR("Invalid DBC magic: ", std::string(header.magic, 4));
         return false;
     }
 
-    recordCount = header->recordCount;
-    fieldCount = header->fieldCount;
-    recordSize = header->recordSize;
-    stringBlockSize = header->stringBlockSize;
-
     // Validate sizes
-    uint32_t expectedSize = sizeof(DBCHeader) + (recordCount * recordSize) + stringBlockSize;
-    if (dbcData.size() < expectedSize) {
-        LOG_ERROR("DBC file truncated: expected ", expectedSize, " bytes, got ", dbcData.size());
+    uint64_t expectedSize = sizeof(DBCHeader) +
+        static_cast<uint64_t>(header.recordCount) * header.recordSize + header.stringBlockSize;
+    if (size < expectedSize) {
+        LOG_ERROR("DBC file truncated: expected ", expectedSize, " bytes, got ", size);
         return false;
     }
 
+    recordCount = header.recordCount;
+    fieldCount = header.fieldCount;
+    recordSize = header.recordSize;
+    stringBlockSize = header.stringBlockSize;
+
     // Validate record size matches field count
     if (recordSize != fieldCount * 4) {
         LOG_WARNING("DBC record size mismatch: recordSize=", recordSize,
@@ -72,25 +155,32 @@ bool DBCFile::load(const std::vector<uint8_t>& dbcData) {
     LOG_DEBUG("Loading DBC: ", recordCount, " records, ",
               fieldCount, " fields, ", recordSize, " bytes/record, ",
               stringBlockSize, " string bytes");
+    return true;
+}
 
-    // Copy record data
-    const uint8_t* recordStart = dbcData.data() + sizeof(DBCHeader);
-    uint32_t totalRecordSize = recordCount * recordSize;
-    recordData.resize(totalRecordSize);
-    std::memcpy(recordData.data(), recordStart, totalRecordSize);
+std::vector<uint8_t> DBCFile::toWDBC() const {
+    std::vector<uint8_t> out;
+    if (!loaded) {
+        return out;
+    }
 
-    // Copy string block
-    const uint8_t* stringStart = recordStart + totalRecordSize;
-    stringBlock.resize(stringBlockSize);
+    DBCHeader header;
+    std::memcpy(header.magic, "WDBC", 4);
+    header.recordCount = recordCount;
+    header.fieldCount = fieldCount;
+    header.recordSize = recordSize;
+    header.stringBlockSize = stringBlockSize;
+
+    const size_t totalRecordSize = static_cast<size_t>(recordCount) * recordSize;
+    out.resize(sizeof(DBCHeader) + totalRecordSize + stringBlockSize);
+    std::memcpy(out.data(), &header, sizeof(DBCHeader));
+    if (totalRecordSize > 0) {
+        std::memcpy(out.data() + sizeof(DBCHeader), recordBase(), totalRecordSize);
+    }
     if (stringBlockSize > 0) {
-        std::memcpy(stringBlock.data(), stringStart, stringBlockSize);
+        std::memcpy(out.data() + sizeof(DBCHeader) + totalRecordSize, stringBase(), stringBlockSize);
     }
-
-    loaded = true;
-    idCacheBuilt = false;
-    idToIndexCache.clear();
-
-    return true;
+    return out;
 }
 
 const uint8_t* DBCFile::getRecord(uint32_t index) const {
@@ -98,7 +188,7 @@ const uint8_t* DBCFile::getRecord(uint32_t index) const {
         return nullptr;
     }
 
-    return recordData.data() + (index * recordSize);
+    return recordBase() + (static_cast<size_t>(index) * recordSize);
 }
 
 uint32_t DBCFile::getUInt32(uint32_t recordIndex, uint32_t fieldIndex) const {
@@ -111,8 +201,9 @@ uint32_t DBCFile::getUInt32(uint32_t recordIndex, uint32_t fieldIndex) const {
         return 0;
     }
 
-    const uint32_t* field = reinterpret_cast<const uint32_t*>(record + (fieldIndex * 4));
-    return *field;
+    uint32_t value;
+    std::memcpy(&value, record + (fieldIndex * 4), sizeof(value));
+    return value;
 }
 
 int32_t DBCFile::getInt32(uint32_t recordIndex, uint32_t fieldIndex) const {
@@ -129,8 +220,9 @@ float DBCFile::getFloat(uint32_t recordIndex, uint32_t fieldIndex) const {
         return 0.0f;
     }
 
-    const float* field = reinterpret_cast<const float*>(record + (fieldIndex * 4));
-    return *field;
+    float value;
+    std::memcpy(&value, record + (fieldIndex * 4), sizeof(value));
+    return value;
 }
 
 std::string DBCFile::getString(uint32_t recordIndex, uint32_t fieldIndex) const {
@@ -139,21 +231,25 @@ std::string DBCFile::getString(uint32_t recordIndex, uint32_t fieldIndex) const
 }
 
 std::string DBCFile::getStringByOffset(uint32_t offset) const {
-    if (!loaded || offset >= stringBlockSize) {
-        return "";
-    }
+    return std::string(getStringViewByOffset(offset));
+}
 
-    // Find null terminator
-    const char* str = reinterpret_cast<const char*>(stringBlock.data() + offset);
-    const char* end = reinterpret_cast<const char*>(stringBlock.data() + stringBlockSize);
+std::string_view DBCFile::getStringView(uint32_t recordIndex, uint32_t fieldIndex) const {
+    uint32_t offset = getUInt32(recordIndex, fieldIndex);
+    return getStringViewByOffset(offset);
+}
 
-    // Find string length (up to null terminator or end of block)
-    size_t length = 0;
-    while (str + length < end && str[length] != '\0') {
-        length++;
+std::string_view DBCFile::getStringViewByOffset(uint32_t offset) const {
+    if (!loaded || offset >= stringBlockSize) {
+        return {};
     }
 
-    return std::string(str, length);
+    // Find null terminator (up to the end of the block)
+    const char* str = reinterpret_cast<const char*>(stringBase() + offset);
+    const void* nul = std::memchr(str, '\0', stringBlockSize - offset);
+    size_t length = nul ? static_cast<size_t>(static_cast<const char*>(nul) - str)
+                        : stringBlockSize - offset;
+    return std::string_view(str, length);
 }
 
 int32_t DBCFile::findRecordById(uint32_t id) const {
@@ -161,53 +257,101 @@ int32_t DBCFile::findRecordById(uint32_t id) const {
         return -1;
     }
 
-    // Build ID cache if not already built
-    if (!idCacheBuilt) {
-        buildIdCache();
+    // Build ID index if not already built
+    if (!idIndexBuilt_) {
+        buildIdIndex();
     }
 
-    auto it = idToIndexCache.find(id);
-    if (it != idToIndexCache.end()) {
-        return static_cast<int32_t>(it->second);
+    if (idIndexDense_) {
+        uint32_t slot = id - idBase_;
+        if (id < idBase_ || slot >= idIndex_.size() || idIndex_[slot] == 0) {
+            return -1;
+        }
+        return static_cast<int32_t>(idIndex_[slot] - 1);
     }
 
-    return -1;
+    for (uint32_t slot = hashId(id) & idHashMask_;; slot = (slot + 1) & idHashMask_) {
+        if (idIndex_[slot] == 0) return -1;
+        if (idHashKeys_[slot] == id) return static_cast<int32_t>(idIndex_[slot] - 1);
+    }
 }
 
-void DBCFile::buildIdCache() const {
-    idToIndexCache.clear();
+void DBCFile::buildIdIndex() const {
+    idIndex_.clear();
+    idHashKeys_.clear();
+    idBase_ = 0;
+    idHashMask_ = 0;
+    idIndexDense_ = true;
+
+    if (recordCount > 0) {
+        uint32_t minId = UINT32_MAX;
+        uint32_t maxId = 0;
+        for (uint32_t i = 0; i < recordCount; i++) {
+            uint32_t id = getUInt32(i, 0);  // Assume first field is ID
+            minId = std::min(minId, id);
+            maxId = std::max(maxId, id);
+        }
 
-    for (uint32_t i = 0; i < recordCount; i++) {
-        uint32_t id = getUInt32(i, 0);  // Assume first field is ID
-        idToIndexCache[id] = i;
+        // Dense when the ID range costs at most ~4 slots per record
+        const uint64_t span = static_cast<uint64_t>(maxId) - minId + 1;
+        idIndexDense_ = span <= std::max<uint64_t>(static_cast<uint64_t>(recordCount) * 4, 1024);
+        if (idIndexDense_) {
+            idBase_ = minId;
+            idIndex_.assign(static_cast<size_t>(span), 0);
+            for (uint32_t i = 0; i < recordCount; i++) {
+                idIndex_[getUInt32(i, 0) - minId] = i + 1;
+            }
+        } else {
+            // Power-of-two table at <= 50% load
+            uint32_t capacity = 16;
+            while (capacity < recordCount * 2) capacity <<= 1;
+            idHashMask_ = capacity - 1;
+            idIndex_.assign(capacity, 0);
+            idHashKeys_.assign(capacity, 0);
+            for (uint32_t i = 0; i < recordCount; i++) {
+                uint32_t id = getUInt32(i, 0);
+                uint32_t slot = hashId(id) & idHashMask_;
+                while (idIndex_[slot] != 0 && idHashKeys_[slot] != id) {
+                    slot = (slot + 1) & idHashMask_;
+                }
+                idHashKeys_[slot] = id;
+                idIndex_[slot] = i + 1;
+            }
+        }
     }
 
-    idCacheBuilt = true;
-    LOG_DEBUG("Built DBC ID cache with ", idToIndexCache.size(), " entries");
+    idIndexBuilt_ = true;
+    LOG_DEBUG("Built DBC ID index (", idIndexDense_ ? "dense" : "hashed", ", ",
+              idIndex_.size(), " slots) for ", recordCount, " records");
+}
+
+void DBCFile::resetIdIndex() {
+    idIndex_.clear();
+    idHashKeys_.clear();
+    idIndexBuilt_ = false;
 }
 
 bool DBCFile::loadCSV(const std::vector<uint8_t>& csvData) {
-    std::string text(reinterpret_cast<const char*>(csvData.data()), csvData.size());
-    std::istringstream stream(text);
-    std::string line;
+    const char* cur = reinterpret_cast<const char*>(csvData.data());
+    const char* const bufEnd = cur + csvData.size();
 
     // --- Parse metadata line: # fields=N strings=I,J,K ---
-    if (!std::getline(stream, line) || line.empty() || line[0] != '#') {
+    const char* lineEnd = findLineEnd(cur, bufEnd);
+    std::string_view line = trimLineEnd(cur, lineEnd);
+    if (line.empty() || line[0] != '#') {
         LOG_ERROR("CSV DBC: missing metadata line");
         return false;
     }
+    cur = (lineEnd < bufEnd) ? lineEnd + 1 : bufEnd;
 
     fieldCount = 0;
     std::set<uint32_t> stringCols;
 
     // Parse "fields=N"
     auto fieldsPos = line.find("fields=");
-    if (fieldsPos != std::string::npos) {
-        try {
-            fieldCount = static_cast<uint32_t>(std::stoul(line.substr(fieldsPos + 7)));
-        } catch (...) {
-            fieldCount = 0;
-        }
+    if (fieldsPos != std::string_view::npos) {
+        const char* p = line.data() + fieldsPos + 7;
+        fieldCount = parseUInt(p, line.data() + line.size());
     }
     if (fieldCount == 0) {
         LOG_ERROR("CSV DBC: invalid field count");
@@ -216,18 +360,23 @@ bool DBCFile::loadCSV(const std::vector<uint8_t>& csvData) {
 
     // Parse "strings=I,J,K"
     auto stringsPos = line.find("strings=");
-    if (stringsPos != std::string::npos) {
-        std::istringstream ss(line.substr(stringsPos + 8));
-        std::string tok;
-        while (std::getline(ss, tok, ',')) {
-            tok = trimAscii(tok);
+    if (stringsPos != std::string_view::npos) {
+        std::string_view list = line.substr(stringsPos + 8);
+        list = list.substr(0, list.find(' '));
+        while (!list.empty()) {
+            size_t comma = list.find(',');
+            std::string_view tok = trimAscii(list.substr(0, comma));
             if (!tok.empty()) {
-                try {
-                    stringCols.insert(static_cast<uint32_t>(std::stoul(tok)));
-                } catch (...) {
+                uint32_t col = 0;
+                auto [ptr, ec] = std::from_chars(tok.data(), tok.data() + tok.size(), col);
+                if (ec == std::errc() && ptr != tok.data()) {
+                    stringCols.insert(col);
+                } else {
                     LOG_WARNING("CSV DBC: invalid string column index token: '", tok, "'");
                 }
             }
+            if (comma == std::string_view::npos) break;
+            list.remove_prefix(comma + 1);
         }
     }
 
@@ -239,91 +388,93 @@ bool DBCFile::loadCSV(const std::vector<uint8_t>& csvData) {
 
     recordSize = fieldCount * 4;
 
+    // Flat per-column lookup instead of a set probe per token
+    std::vector<uint8_t> isStringCol(fieldCount, 0);
+    for (uint32_t col : stringCols) {
+        if (col < fieldCount) isStringCol[col] = 1;
+    }
+
     // --- Build string block with initial null byte ---
     stringBlock.clear();
     stringBlock.push_back(0); // offset 0 = empty string
 
-    // --- Parse data rows ---
-    struct RowData {
-        std::vector<uint32_t> fields;
-    };
-    std::vector<RowData> rows;
-
-    while (std::getline(stream, line)) {
-        if (line.empty()) continue;
+    // Row count estimate from line count keeps recordData to one allocation
+    size_t lineEstimate = static_cast<size_t>(std::count(cur, bufEnd, '\n')) + 1;
+    recordData.clear();
+    recordData.reserve(lineEstimate * recordSize);
+    recordCount = 0;
+
+    // --- Parse data rows (binary layout identical to WDBC) ---
+    // Rows end at a newline outside quotes; dbc_to_csv writes strings
+    // verbatim, so quoted fields may contain newlines (e.g. Map descriptions).
+    const char* pos = cur;
+    while (pos < bufEnd) {
+        // Skip blank lines (including bare CR from CRLF exports)
+        if (*pos == '\n' || (*pos == '\r' && (pos + 1 == bufEnd || pos[1] == '\n'))) {
+            pos++;
+            continue;
+        }
 
-        RowData row;
-        row.fields.resize(fieldCount, 0);
+        const size_t rowOffset = recordData.size();
+        recordData.resize(rowOffset + recordSize, 0);
 
         uint32_t col = 0;
-        size_t pos = 0;
-
-        while (col < fieldCount && pos < line.size()) {
-            if (stringCols.count(col) && pos < line.size() && line[pos] == '"') {
-                // Quoted string field
+        while (col < fieldCount && pos < bufEnd && *pos != '\n') {
+            uint32_t value = 0;
+            if (*pos == '"') {
+                // Quoted field, copied straight into the string block. Quoted
+                // text in a numeric column (garbled export) is scanned the same
+                // way so embedded commas/newlines don't shift the row, then dropped.
                 pos++; // skip opening quote
-                std::string str;
-                while (pos < line.size()) {
-                    if (line[pos] == '"') {
-                        if (pos + 1 < line.size() && line[pos + 1] == '"') {
-                            str += '"'; // escaped quote
-                            pos += 2;
-                        } else {
-                            pos++; // closing quote
-                            break;
-                        }
+                const size_t strStart = stringBlock.size();
+                while (pos < bufEnd) {
+                    const char* quote = static_cast<const char*>(std::memchr(pos, '"', bufEnd - pos));
+                    const char* runEnd = quote ? quote : bufEnd;
+                    stringBlock.insert(stringBlock.end(), pos, runEnd);
+                    pos = runEnd;
+                    if (!quote) break;
+                    if (pos + 1 < bufEnd && pos[1] == '"') {
+                        stringBlock.push_back('"'); // escaped quote
+                        pos += 2;
                     } else {
-                        str += line[pos++];
+                        pos++; // closing quote
+                        break;
                     }
                 }
                 // Skip comma after closing quote
-                if (pos < line.size() && line[pos] == ',') pos++;
+                if (pos < bufEnd && *pos == ',') pos++;
 
-                // Store string in string block
-                if (str.empty()) {
-                    row.fields[col] = 0; // points to empty string at offset 0
+                if (!isStringCol[col]) {
+                    stringBlock.resize(strStart);
+                    value = 0;
+                } else if (stringBlock.size() == strStart) {
+                    value = 0; // points to empty string at offset 0
                 } else {
-                    uint32_t offset = static_cast<uint32_t>(stringBlock.size());
-                    stringBlock.insert(stringBlock.end(), str.begin(), str.end());
+                    value = static_cast<uint32_t>(strStart);
                     stringBlock.push_back(0); // null terminator
-                    row.fields[col] = offset;
                 }
             } else {
                 // Numeric field — read until comma or end of line
-                size_t end = line.find(',', pos);
-                if (end == std::string::npos) end = line.size();
-                std::string tok = line.substr(pos, end - pos);
-                if (!tok.empty()) {
-                    try {
-                        row.fields[col] = static_cast<uint32_t>(std::stoul(tok));
-                    } catch (...) {
-                        row.fields[col] = 0; // non-numeric value in numeric field
-                    }
-                }
-                pos = (end < line.size()) ? end + 1 : line.size();
+                const char* tokEnd = pos;
+                while (tokEnd < bufEnd && *tokEnd != ',' && *tokEnd != '\n') ++tokEnd;
+                value = parseUInt(pos, tokEnd);
+                pos = (tokEnd < bufEnd && *tokEnd == ',') ? tokEnd + 1 : tokEnd;
             }
+            std::memcpy(recordData.data() + rowOffset + col * 4, &value, 4);
             col++;
         }
+        recordCount++;
 
-        rows.push_back(std::move(row));
+        // Ignore surplus columns; continue after the row's newline
+        pos = findLineEnd(pos, bufEnd);
+        if (pos < bufEnd) pos++;
     }
 
-    // --- Build record data (binary layout identical to WDBC) ---
-    recordCount = static_cast<uint32_t>(rows.size());
     stringBlockSize = static_cast<uint32_t>(stringBlock.size());
-
-    recordData.resize(static_cast<size_t>(recordCount) * recordSize);
-    for (uint32_t i = 0; i < recordCount; ++i) {
-        uint8_t* dst = recordData.data() + static_cast<size_t>(i) * recordSize;
-        for (uint32_t f = 0; f < fieldCount; ++f) {
-            uint32_t val = rows[i].fields[f];
-            std::memcpy(dst + f * 4, &val, 4);
-        }
-    }
+    viewStorage_.reset();
 
     loaded = true;
-    idCacheBuilt = false;
-    idToIndexCache.clear();
+    resetIdIndex();
 
     LOG_DEBUG("Loaded CSV DBC: ", recordCount, " records, ",
               fieldCount, " fields, ", stringCols.size(), " string cols, ",
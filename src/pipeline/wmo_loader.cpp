@@ -1,5 +1,9 @@
 #include "pipeline/wmo_loader.hpp"
 #include "core/logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <glm/gtc/quaternion.hpp>
 
@@ -642,5 +646,154 @@ bool WMOLoader::loadGroup(const std::vector<uint8_t>& groupData,
     return !group.vertices.empty() && !group.indices.empty();
 }
 
+std::string WMOLoader::groupPath(const std::string& rootPath, uint32_t groupIndex) {
+    std::string basePath = rootPath;
+    if (basePath.size() > 4) {
+        std::string ext = basePath.substr(basePath.size() - 4);
+        for (char& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (ext == ".wmo") basePath.resize(basePath.size() - 4);
+    }
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), "_%03u.wmo", groupIndex);
+    return basePath + suffix;
+}
+
+// ---- Per-group 2D collision grid ----
+
+void WMOCollisionGrid::build(const std::vector<glm::vec3>& vertices, const std::vector<uint16_t>& indices) {
+    *this = WMOCollisionGrid();
+    if (vertices.empty()) return;
+
+    boundsMin = vertices[0];
+    boundsMax = vertices[0];
+    for (const auto& v : vertices) {
+        boundsMin = glm::min(boundsMin, v);
+        boundsMax = glm::max(boundsMax, v);
+    }
+    if (indices.size() < 3) return;
+
+    origin = glm::vec2(boundsMin.x, boundsMin.y);
+    float extentX = boundsMax.x - boundsMin.x;
+    float extentY = boundsMax.y - boundsMin.y;
+
+    cellsX = std::max(1, static_cast<int>(std::ceil(extentX / CELL_SIZE)));
+    cellsY = std::max(1, static_cast<int>(std::ceil(extentY / CELL_SIZE)));
+
+    // Cap grid size to avoid excessive memory for huge groups
+    if (cellsX > 64) cellsX = 64;
+    if (cellsY > 64) cellsY = 64;
+
+    const size_t totalCells = static_cast<size_t>(cellsX) * cellsY;
+    const size_t numTriangles = indices.size() / 3;
+    triBounds.resize(numTriangles);
+
+    float invCellW = cellsX / std::max(0.01f, extentX);
+    float invCellH = cellsY / std::max(0.01f, extentY);
+
+    // Cell range and classes of every triangle; binned in two passes below
+    struct TriCells { int minX, minY, maxX, maxY; bool floor, wall; };
+    std::vector<TriCells> triCells(numTriangles);
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec3& v0 = vertices[indices[i]];
+        const glm::vec3& v1 = vertices[indices[i + 1]];
+        const glm::vec3& v2 = vertices[indices[i + 2]];
+
+        // Triangle XY bounding box
+        float triMinX = std::min({v0.x, v1.x, v2.x});
+        float triMinY = std::min({v0.y, v1.y, v2.y});
+        float triMaxX = std::max({v0.x, v1.x, v2.x});
+        float triMaxY = std::max({v0.y, v1.y, v2.y});
+
+        // Per-triangle Z bounds
+        triBounds[i / 3] = { std::min({v0.z, v1.z, v2.z}), std::max({v0.z, v1.z, v2.z}) };
+
+        // Classify floor vs wall by normal.
+        // Wall threshold matches MAX_WALK_SLOPE_DOT (cos 50° ≈ 0.6428) so that
+        // surfaces too steep to walk on are always tested for wall collision.
+        glm::vec3 normal = glm::cross(v1 - v0, v2 - v0);
+        float normalLen = glm::length(normal);
+        float absNz = (normalLen > 0.001f) ? std::abs(normal.z / normalLen) : 0.0f;
+
+        TriCells& tc = triCells[i / 3];
+        tc.floor = (absNz >= 0.35f);  // ~70° max slope (relaxed for steep stairs)
+        tc.wall = (absNz < 0.65f);    // Matches walkable slope threshold
+        tc.minX = std::max(0, static_cast<int>((triMinX - origin.x) * invCellW));
+        tc.minY = std::max(0, static_cast<int>((triMinY - origin.y) * invCellH));
+        tc.maxX = std::min(cellsX - 1, static_cast<int>((triMaxX - origin.x) * invCellW));
+        tc.maxY = std::min(cellsY - 1, static_cast<int>((triMaxY - origin.y) * invCellH));
+    }
+
+    auto forEachCell = [&](auto&& fn) {
+        for (size_t t = 0; t < numTriangles; t++) {
+            const TriCells& tc = triCells[t];
+            for (int cy = tc.minY; cy <= tc.maxY; ++cy) {
+                for (int cx = tc.minX; cx <= tc.maxX; ++cx) {
+                    fn(t, static_cast<size_t>(cy) * cellsX + cx, tc);
+                }
+            }
+        }
+    };
+
+    // Pass 1: count per cell, then prefix-sum into offsets
+    for (size_t c = 0; c < CLASS_COUNT; c++) cellOffsets[c].assign(totalCells + 1, 0);
+    forEachCell([&](size_t, size_t cell, const TriCells& tc) {
+        cellOffsets[ALL][cell + 1]++;
+        if (tc.floor) cellOffsets[FLOOR][cell + 1]++;
+        if (tc.wall) cellOffsets[WALL][cell + 1]++;
+    });
+    for (size_t c = 0; c < CLASS_COUNT; c++) {
+        for (size_t cell = 0; cell < totalCells; cell++) {
+            cellOffsets[c][cell + 1] += cellOffsets[c][cell];
+        }
+        cellTriangles[c].resize(cellOffsets[c][totalCells]);
+    }
+
+    // Pass 2: fill in triangle order, so each cell lists its triangles ascending
+    std::vector<uint32_t> cursor[CLASS_COUNT];
+    for (size_t c = 0; c < CLASS_COUNT; c++) {
+        cursor[c].assign(cellOffsets[c].begin(), cellOffsets[c].end() - 1);
+    }
+    forEachCell([&](size_t t, size_t cell, const TriCells& tc) {
+        const uint32_t triStart = static_cast<uint32_t>(t * 3);
+        cellTriangles[ALL][cursor[ALL][cell]++] = triStart;
+        if (tc.floor) cellTriangles[FLOOR][cursor[FLOOR][cell]++] = triStart;
+        if (tc.wall) cellTriangles[WALL][cursor[WALL][cell]++] = triStart;
+    });
+}
+
+void WMOCollisionGrid::query(TriangleClass triangleClass, float minX, float minY, float maxX, float maxY,
+                             std::vector<uint32_t>& out) const {
+    out.clear();
+    if (isEmpty() || cellOffsets[triangleClass].empty()) return;
+
+    float extentX = boundsMax.x - boundsMin.x;
+    float extentY = boundsMax.y - boundsMin.y;
+    float invCellW = cellsX / std::max(0.01f, extentX);
+    float invCellH = cellsY / std::max(0.01f, extentY);
+
+    int cellMinX = std::max(0, static_cast<int>((minX - origin.x) * invCellW));
+    int cellMinY = std::max(0, static_cast<int>((minY - origin.y) * invCellH));
+    int cellMaxX = std::min(cellsX - 1, static_cast<int>((maxX - origin.x) * invCellW));
+    int cellMaxY = std::min(cellsY - 1, static_cast<int>((maxY - origin.y) * invCellH));
+
+    if (cellMinX > cellMaxX || cellMinY > cellMaxY) return;
+
+    const auto& offsets = cellOffsets[triangleClass];
+    const auto& triangles = cellTriangles[triangleClass];
+    for (int cy = cellMinY; cy <= cellMaxY; ++cy) {
+        for (int cx = cellMinX; cx <= cellMaxX; ++cx) {
+            size_t cell = static_cast<size_t>(cy) * cellsX + cx;
+            out.insert(out.end(), triangles.begin() + offsets[cell], triangles.begin() + offsets[cell + 1]);
+        }
+    }
+
+    // Remove duplicates (triangles spanning multiple cells)
+    if (cellMinX != cellMaxX || cellMinY != cellMaxY) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
 } // namespace pipeline
 } // namespace wowee
@@ -0,0 +1,268 @@
+#include "rendering/animation_evaluator.hpp"
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace wowee {
+namespace rendering {
+
+namespace {
+
+// SoA scratch for one skeleton evaluation. Grows to the largest skeleton seen
+// on each thread and is reused afterwards (no per-frame allocation).
+struct PoseScratch {
+    std::vector<float> tx, ty, tz;
+    std::vector<float> qx, qy, qz, qw;
+    std::vector<float> sx, sy, sz;
+    std::vector<float> px, py, pz;
+    std::vector<float> local[12];
+
+    void resize(size_t n) {
+        if (tx.size() >= n) return;
+        for (auto* v : {&tx, &ty, &tz, &qx, &qy, &qz, &qw, &sx, &sy, &sz, &px, &py, &pz}) {
+            v->resize(n);
+        }
+        for (auto& v : local) v.resize(n);
+    }
+};
+
+thread_local PoseScratch tScratch;
+
+// Resolve sequence index and time for a track, handling global sequences.
+void resolveTrackTime(const pipeline::M2AnimationTrack& track,
+                      int seqIdx, float time, const BoneEvalOptions& options,
+                      int& outSeqIdx, float& outTime) {
+    const auto* gsd = options.globalSequenceDurations;
+    if (gsd && track.globalSequence >= 0 &&
+        static_cast<size_t>(track.globalSequence) < gsd->size()) {
+        // Global sequence: always use sub-array 0, wrap time at global duration
+        outSeqIdx = 0;
+        float dur = static_cast<float>((*gsd)[track.globalSequence]);
+        outTime = (dur > 0.0f) ? std::fmod(time, dur) : 0.0f;
+    } else {
+        outSeqIdx = seqIdx;
+        outTime = time;
+    }
+}
+
+glm::vec3 sampleVec3(const pipeline::M2AnimationTrack& track, int seqIdx, float time,
+                     const glm::vec3& def, const BoneEvalOptions& options, uint32_t& hint) {
+    if (!track.hasData()) return def;
+    int si; float t;
+    resolveTrackTime(track, seqIdx, time, options, si, t);
+    if (si < 0 || si >= static_cast<int>(track.sequences.size())) return def;
+    const auto& keys = track.sequences[si];
+    if (keys.timestamps.empty() || keys.vec3Values.empty()) return def;
+    auto safe = [&](const glm::vec3& v) -> glm::vec3 {
+        if (std::isnan(v.x) || std::isnan(v.y) || std::isnan(v.z)) return def;
+        return v;
+    };
+    if (keys.vec3Values.size() == 1) return safe(keys.vec3Values[0]);
+    int idx = findKeyframeIndexCached(keys.timestamps, t, hint);
+    if (idx < 0) return def;
+    size_t i0 = static_cast<size_t>(idx);
+    size_t i1 = std::min(i0 + 1, keys.vec3Values.size() - 1);
+    if (i0 >= i1) return safe(keys.vec3Values[i1]);
+    float t0 = static_cast<float>(keys.timestamps[i0]);
+    float t1 = static_cast<float>(keys.timestamps[i1]);
+    float dur = t1 - t0;
+    float frac = (dur > 0.0f) ? glm::clamp((t - t0) / dur, 0.0f, 1.0f) : 0.0f;
+    return safe(glm::mix(keys.vec3Values[i0], keys.vec3Values[i1], frac));
+}
+
+glm::quat sampleQuat(const pipeline::M2AnimationTrack& track, int seqIdx, float time,
+                     const BoneEvalOptions& options, uint32_t& hint) {
+    glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
+    if (!track.hasData()) return identity;
+    int si; float t;
+    resolveTrackTime(track, seqIdx, time, options, si, t);
+    if (si < 0 || si >= static_cast<int>(track.sequences.size())) return identity;
+    const auto& keys = track.sequences[si];
+    if (keys.timestamps.empty() || keys.quatValues.empty()) return identity;
+    auto safe = [&](const glm::quat& q) -> glm::quat {
+        float len = glm::length(q);
+        if (len < 0.001f || std::isnan(len)) return identity;
+        return q;
+    };
+    if (keys.quatValues.size() == 1) return safe(keys.quatValues[0]);
+    int idx = findKeyframeIndexCached(keys.timestamps, t, hint);
+    if (idx < 0) return identity;
+    size_t i0 = static_cast<size_t>(idx);
+    size_t i1 = std::min(i0 + 1, keys.quatValues.size() - 1);
+    if (i0 >= i1) return safe(keys.quatValues[i1]);
+    float t0 = static_cast<float>(keys.timestamps[i0]);
+    float t1 = static_cast<float>(keys.timestamps[i1]);
+    float dur = t1 - t0;
+    float frac = (dur > 0.0f) ? glm::clamp((t - t0) / dur, 0.0f, 1.0f) : 0.0f;
+    return glm::slerp(safe(keys.quatValues[i0]), safe(keys.quatValues[i1]), frac);
+}
+
+// Passes 1 and 2: sample keyframes and compose local 3x4 transforms into
+// tScratch.local (row-major element k of bone i lives in local[k][i]).
+void buildLocalTransforms(const std::vector<pipeline::M2Bone>& bones, size_t n,
+                          int seqIdx, float timeMs, const BoneEvalOptions& options,
+                          AnimationCursor& cursor) {
+    PoseScratch& s = tScratch;
+    s.resize(n);
+    if (cursor.keyIndex.size() != n * 3) {
+        cursor.keyIndex.assign(n * 3, 0);
+    }
+    uint32_t* hints = cursor.keyIndex.data();
+
+    for (size_t i = 0; i < n; i++) {
+        const auto& bone = bones[i];
+        glm::vec3 t = sampleVec3(bone.translation, seqIdx, timeMs, glm::vec3(0.0f), options, hints[i * 3 + 0]);
+        glm::quat r = sampleQuat(bone.rotation, seqIdx, timeMs, options, hints[i * 3 + 1]);
+        glm::vec3 sc = sampleVec3(bone.scale, seqIdx, timeMs, glm::vec3(1.0f), options, hints[i * 3 + 2]);
+        s.tx[i] = t.x;  s.ty[i] = t.y;  s.tz[i] = t.z;
+        s.qx[i] = r.x;  s.qy[i] = r.y;  s.qz[i] = r.z;  s.qw[i] = r.w;
+        s.sx[i] = sc.x; s.sy[i] = sc.y; s.sz[i] = sc.z;
+        s.px[i] = bone.pivot.x; s.py[i] = bone.pivot.y; s.pz[i] = bone.pivot.z;
+    }
+
+    if (options.fixDegenerateScale) {
+        for (size_t i = 0; i < n; i++) {
+            s.sx[i] = (s.sx[i] < 0.001f) ? 1.0f : s.sx[i];
+            s.sy[i] = (s.sy[i] < 0.001f) ? 1.0f : s.sy[i];
+            s.sz[i] = (s.sz[i] < 0.001f) ? 1.0f : s.sz[i];
+        }
+    }
+
+    // local = T(pivot) * T(trans) * R * S * T(-pivot)
+    //       = [R*S | pivot + trans - R*S*pivot]
+    float* __restrict l0 = s.local[0].data();
+    float* __restrict l1 = s.local[1].data();
+    float* __restrict l2 = s.local[2].data();
+    float* __restrict l3 = s.local[3].data();
+    float* __restrict l4 = s.local[4].data();
+    float* __restrict l5 = s.local[5].data();
+    float* __restrict l6 = s.local[6].data();
+    float* __restrict l7 = s.local[7].data();
+    float* __restrict l8 = s.local[8].data();
+    float* __restrict l9 = s.local[9].data();
+    float* __restrict l10 = s.local[10].data();
+    float* __restrict l11 = s.local[11].data();
+    const float* __restrict qx = s.qx.data();
+    const float* __restrict qy = s.qy.data();
+    const float* __restrict qz = s.qz.data();
+    const float* __restrict qw = s.qw.data();
+    for (size_t i = 0; i < n; i++) {
+        float x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+
+        // Same rotation matrix as glm::toMat4 (no renormalization)
+        float r00 = 1.0f - 2.0f * (yy + zz), r01 = 2.0f * (xy - wz),        r02 = 2.0f * (xz + wy);
+        float r10 = 2.0f * (xy + wz),        r11 = 1.0f - 2.0f * (xx + zz), r12 = 2.0f * (yz - wx);
+        float r20 = 2.0f * (xz - wy),        r21 = 2.0f * (yz + wx),        r22 = 1.0f - 2.0f * (xx + yy);
+
+        float sx = s.sx[i], sy = s.sy[i], sz = s.sz[i];
+        float a00 = r00 * sx, a01 = r01 * sy, a02 = r02 * sz;
+        float a10 = r10 * sx, a11 = r11 * sy, a12 = r12 * sz;
+        float a20 = r20 * sx, a21 = r21 * sy, a22 = r22 * sz;
+
+        float px = s.px[i], py = s.py[i], pz = s.pz[i];
+        l0[i] = a00; l1[i] = a01; l2[i]  = a02; l3[i]  = px + s.tx[i] - (a00 * px + a01 * py + a02 * pz);
+        l4[i] = a10; l5[i] = a11; l6[i]  = a12; l7[i]  = py + s.ty[i] - (a10 * px + a11 * py + a12 * pz);
+        l8[i] = a20; l9[i] = a21; l10[i] = a22; l11[i] = pz + s.tz[i] - (a20 * px + a21 * py + a22 * pz);
+    }
+}
+
+// Parent accessors so pass 3 can run directly on either output format.
+inline float parentAt(const glm::mat4& p, int row, int col) { return p[col][row]; }
+inline float parentAt(const BoneMatrix3x4& p, int row, int col) { return p.m[row * 4 + col]; }
+
+inline void storeWorld(glm::mat4& out, const float w[12]) {
+    out[0] = glm::vec4(w[0], w[4], w[8],  0.0f);
+    out[1] = glm::vec4(w[1], w[5], w[9],  0.0f);
+    out[2] = glm::vec4(w[2], w[6], w[10], 0.0f);
+    out[3] = glm::vec4(w[3], w[7], w[11], 1.0f);
+}
+inline void storeWorld(BoneMatrix3x4& out, const float w[12]) {
+    std::copy(w, w + 12, out.m);
+}
+
+// Pass 3: parent concatenation. Parents with an index >= the child read the
+// previous frame's matrix, matching the original in-place evaluation.
+template <typename MatT>
+void concatenateHierarchy(const std::vector<pipeline::M2Bone>& bones, size_t n,
+                          std::vector<MatT>& out) {
+    const PoseScratch& s = tScratch;
+    float l[12];
+    float w[12];
+    for (size_t i = 0; i < n; i++) {
+        for (int k = 0; k < 12; k++) l[k] = s.local[k][i];
+        int parent = bones[i].parentBone;
+        if (parent >= 0 && static_cast<size_t>(parent) < n) {
+            const MatT& p = out[parent];
+            for (int r = 0; r < 3; r++) {
+                float p0 = parentAt(p, r, 0), p1 = parentAt(p, r, 1);
+                float p2 = parentAt(p, r, 2), p3 = parentAt(p, r, 3);
+                w[r * 4 + 0] = p0 * l[0] + p1 * l[4] + p2 * l[8];
+                w[r * 4 + 1] = p0 * l[1] + p1 * l[5] + p2 * l[9];
+                w[r * 4 + 2] = p0 * l[2] + p1 * l[6] + p2 * l[10];
+                w[r * 4 + 3] = p0 * l[3] + p1 * l[7] + p2 * l[11] + p3;
+            }
+            storeWorld(out[i], w);
+        } else {
+            storeWorld(out[i], l);
+        }
+    }
+}
+
+} // namespace
+
+int findKeyframeIndexCached(const std::vector<uint32_t>& timestamps, float time, uint32_t& hint) {
+    const size_t count = timestamps.size();
+    if (count == 0) return -1;
+    if (count == 1) return 0;
+    const size_t last = count - 2;
+
+    // Bracket i is what a linear scan returns: the first i with time < ts[i+1],
+    // clamped to the final bracket.
+    auto fits = [&](size_t i) {
+        return (i == 0 || time >= static_cast<float>(timestamps[i])) &&
+               (i == last || time < static_cast<float>(timestamps[i + 1]));
+    };
+
+    size_t h = hint;
+    if (h <= last) {
+        if (fits(h)) return static_cast<int>(h);
+        if (h < last && fits(h + 1)) {
+            hint = static_cast<uint32_t>(h + 1);
+            return static_cast<int>(h + 1);
+        }
+    }
+
+    // Loop wrap or seek: binary search for the first key after time.
+    auto it = std::upper_bound(timestamps.begin() + 1, timestamps.end(), time,
+        [](float t, uint32_t key) { return t < static_cast<float>(key); });
+    size_t idx = (it == timestamps.end()) ? last
+                                          : static_cast<size_t>(it - timestamps.begin()) - 1;
+    hint = static_cast<uint32_t>(idx);
+    return static_cast<int>(idx);
+}
+
+void evaluateBonePalette(const std::vector<pipeline::M2Bone>& bones, size_t numBones,
+                         int seqIdx, float timeMs, const BoneEvalOptions& options,
+                         AnimationCursor& cursor, std::vector<glm::mat4>& outMatrices) {
+    numBones = std::min(numBones, bones.size());
+    outMatrices.resize(numBones, glm::mat4(1.0f));
+    if (numBones == 0) return;
+    buildLocalTransforms(bones, numBones, seqIdx, timeMs, options, cursor);
+    concatenateHierarchy(bones, numBones, outMatrices);
+}
+
+void evaluateBonePalette3x4(const std::vector<pipeline::M2Bone>& bones, size_t numBones,
+                            int seqIdx, float timeMs, const BoneEvalOptions& options,
+                            AnimationCursor& cursor, std::vector<BoneMatrix3x4>& outMatrices) {
+    numBones = std::min(numBones, bones.size());
+    outMatrices.resize(numBones, BoneMatrix3x4{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0}});
+    if (numBones == 0) return;
+    buildLocalTransforms(bones, numBones, seqIdx, timeMs, options, cursor);
+    concatenateHierarchy(bones, numBones, outMatrices);
+}
+
+} // namespace rendering
+} // namespace wowee
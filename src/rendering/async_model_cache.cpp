@@ -0,0 +1,191 @@
+#include "rendering/async_model_cache.hpp"
+#include "pipeline/asset_manager.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+namespace wowee {
+namespace rendering {
+
+struct ModelHandle::State {
+    std::string key;
+    uint32_t flags = 0;
+    std::atomic<bool> ready{false};
+    CachedModel model;
+};
+
+bool ModelHandle::isReady() const {
+    return state_ && state_->ready.load(std::memory_order_acquire);
+}
+
+const CachedModel* ModelHandle::get() const {
+    return isReady() ? &state_->model : nullptr;
+}
+
+AsyncModelCache::AsyncModelCache(pipeline::AssetManager* assetManager)
+    : assetManager_(assetManager) {
+    // Requests come in bursts (zone-in, transport arrival) of a few dozen
+    // files; two workers keep them off the main thread without competing
+    // with terrain streaming for cores.
+    unsigned hc = std::thread::hardware_concurrency();
+    unsigned workerCount = std::clamp(hc / 4, 1u, 2u);
+    workerRunning_.store(true);
+    workerThreads_.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; i++) {
+        workerThreads_.emplace_back(&AsyncModelCache::workerLoop, this);
+    }
+    LOG_INFO("Async model cache: ", workerCount, " workers");
+}
+
+AsyncModelCache::~AsyncModelCache() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        workerRunning_.store(false);
+        jobQueue_.clear();
+    }
+    queueCV_.notify_all();
+    for (auto& t : workerThreads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+ModelHandle AsyncModelCache::requestModel(const std::string& path, uint32_t flags) {
+    std::string key = path;
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) {
+        return static_cast<char>(c == '/' ? '\\' : std::tolower(c));
+    });
+    key += '|';
+    key += std::to_string(flags);
+
+    ModelHandle handle;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            handle.state_ = it->second.lock();
+            if (handle.state_) return handle;
+        }
+
+        // Drop entries whose handles are all gone now and then
+        if (++requestsSinceSweep_ >= 256) {
+            requestsSinceSweep_ = 0;
+            for (auto e = entries_.begin(); e != entries_.end();) {
+                e = e->second.expired() ? entries_.erase(e) : std::next(e);
+            }
+        }
+
+        auto state = std::make_shared<ModelHandle::State>();
+        state->key = key;
+        state->flags = flags;
+        state->model.path = path;
+        std::string lower = key.substr(0, key.rfind('|'));
+        state->model.isWmo = lower.size() >= 4 && lower.compare(lower.size() - 4, 4, ".wmo") == 0;
+
+        entries_[key] = state;
+        jobQueue_.push_back(state);
+        pending_.fetch_add(1);
+        handle.state_ = std::move(state);
+    }
+    queueCV_.notify_one();
+    return handle;
+}
+
+void AsyncModelCache::workerLoop() {
+    while (true) {
+        std::shared_ptr<ModelHandle::State> state;
+        bool abandoned = false;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCV_.wait(lock, [this]() {
+                return !jobQueue_.empty() || !workerRunning_.load();
+            });
+            if (!workerRunning_.load()) {
+                break;
+            }
+            state = std::move(jobQueue_.front());
+            jobQueue_.pop_front();
+            // Only the queue referenced it: every requester gave up (e.g. despawned).
+            // Unlist it under the lock so a new request can't pick up the empty result.
+            abandoned = state.use_count() == 1;
+            if (abandoned) entries_.erase(state->key);
+        }
+
+        if (!abandoned) {
+            if (state->model.isWmo) {
+                loadWMO(*state);
+            } else {
+                loadM2(*state);
+            }
+        }
+        state->ready.store(true, std::memory_order_release);
+        pending_.fetch_sub(1);
+    }
+}
+
+void AsyncModelCache::loadM2(ModelHandle::State& state) {
+    CachedModel& out = state.model;
+    const std::string& m2Path = out.path;
+
+    // Model + skin; comes from the cooked blob when fresh
+    out.m2 = assetManager_->loadM2Model(m2Path);
+    if (out.m2.vertices.empty()) {
+        LOG_WARNING("Async model load: failed to load M2 ", m2Path);
+        return;
+    }
+
+    if (state.flags & LOAD_BASE_ANIMS) {
+        // loadAnimFile() resolves tracks against the raw M2; read it only
+        // once an external .anim actually exists
+        std::vector<uint8_t> m2Data;
+        std::string basePath = m2Path.substr(0, m2Path.size() - 3);
+        for (uint32_t si = 0; si < out.m2.sequences.size(); si++) {
+            if (out.m2.sequences[si].flags & 0x20) continue;
+            uint32_t animId = out.m2.sequences[si].id;
+            // Only stand(0), walk(4), run(5)
+            if (animId != 0 && animId != 4 && animId != 5) continue;
+            char animFileName[256];
+            snprintf(animFileName, sizeof(animFileName), "%s%04u-%02u.anim",
+                     basePath.c_str(), animId, out.m2.sequences[si].variationIndex);
+            auto animData = assetManager_->readFileOptional(animFileName);
+            if (animData.empty()) continue;
+            if (m2Data.empty()) {
+                m2Data = assetManager_->readFile(m2Path);
+                if (m2Data.empty()) break;
+            }
+            pipeline::M2Loader::loadAnimFile(m2Data, animData, si, out.m2);
+        }
+    }
+
+    out.valid = true;
+}
+
+void AsyncModelCache::loadWMO(ModelHandle::State& state) {
+    CachedModel& out = state.model;
+    const std::string& modelPath = out.path;
+
+    if (!assetManager_->fileExists(modelPath)) {
+        LOG_WARNING("Async model load: failed to read WMO ", modelPath);
+        return;
+    }
+
+    // Root + every group file; groups come from the cooked blob when fresh
+    out.wmo = assetManager_->loadWMOModel(modelPath);
+    int loadedGroups = 0;
+    for (uint32_t gi = 0; gi < out.wmo.groups.size(); gi++) {
+        if (!out.wmo.groups[gi].vertices.empty()) {
+            loadedGroups++;
+        } else {
+            LOG_WARNING("  Failed to load WMO group ", gi, " for: ", modelPath);
+        }
+    }
+
+    if (loadedGroups > 0 || out.wmo.nGroups == 0) {
+        out.valid = true;
+    } else {
+        LOG_WARNING("Async model load: no WMO groups loaded for ", modelPath);
+    }
+}
+
+} // namespace rendering
+} // namespace wowee
@@ -4,10 +4,11 @@
  * Handles:
  *  - Uploading M2 vertex/index data to OpenGL VAO/VBO/EBO
  *  - Per-frame bone matrix computation (hierarchical, with keyframe interpolation)
- *  - GPU vertex skinning via a bone-matrix uniform array in the vertex shader
+ *  - GPU vertex skinning from a bone palette texture buffer, with instanced draws
  *  - Per-batch texture binding through the M2 texture-lookup indirection
  *  - Geoset filtering (activeGeosets) to show/hide body part groups
- *  - CPU texture compositing for character skins (base skin + underwear overlays)
+ *  - Character skin compositing (base skin + underwear/equipment overlays) on
+ *    worker threads via CharacterSkinCompositor, with a persistent disk cache
  *
  * The character texture compositing uses the WoW CharComponentTextureSections
  * layout, placing region overlays (pelvis, torso, etc.) at their correct pixel
@@ -16,7 +17,9 @@
  */
 #include "rendering/character_renderer.hpp"
 #include "rendering/shader.hpp"
+#include "rendering/character_skin_compositor.hpp"
 #include "rendering/texture.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "rendering/camera.hpp"
 #include "pipeline/asset_manager.hpp"
 #include "pipeline/blp_loader.hpp"
@@ -76,22 +79,45 @@ bool CharacterRenderer::initialize() {
         layout (location = 3) in vec3 aNormal;
         layout (location = 4) in vec2 aTexCoord;
 
-        uniform mat4 uModel;
         uniform mat4 uView;
         uniform mat4 uProjection;
-        uniform mat4 uBones[240];
+        uniform samplerBuffer uBonePalette;   // 3 texels (3x4 rows) per bone
+        uniform samplerBuffer uInstanceData;  // 5 texels per instance record
+        uniform int uInstanceSlots[64];
 
         out vec3 FragPos;
         out vec3 Normal;
         out vec2 TexCoord;
+        flat out float vOpacity;
+
+        mat4 fetchBone(int base, int count, int bone) {
+            int t = base + min(bone, count - 1) * 3;
+            vec4 r0 = texelFetch(uBonePalette, t);
+            vec4 r1 = texelFetch(uBonePalette, t + 1);
+            vec4 r2 = texelFetch(uBonePalette, t + 2);
+            return mat4(r0.x, r1.x, r2.x, 0.0,
+                        r0.y, r1.y, r2.y, 0.0,
+                        r0.z, r1.z, r2.z, 0.0,
+                        r0.w, r1.w, r2.w, 1.0);
+        }
 
         void main() {
+            int rec = uInstanceSlots[gl_InstanceID] * 5;
+            mat4 uModel = mat4(texelFetch(uInstanceData, rec),
+                               texelFetch(uInstanceData, rec + 1),
+                               texelFetch(uInstanceData, rec + 2),
+                               texelFetch(uInstanceData, rec + 3));
+            vec4 params = texelFetch(uInstanceData, rec + 4);
+            int paletteBase = int(params.x);
+            int boneCount = int(params.y);
+            vOpacity = params.z;
+
             // Skinning: blend bone transformations
             mat4 boneTransform = mat4(0.0);
-            boneTransform += uBones[aBoneIndices.x] * aBoneWeights.x;
-            boneTransform += uBones[aBoneIndices.y] * aBoneWeights.y;
-            boneTransform += uBones[aBoneIndices.z] * aBoneWeights.z;
-            boneTransform += uBones[aBoneIndices.w] * aBoneWeights.w;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.x) * aBoneWeights.x;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.y) * aBoneWeights.y;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.z) * aBoneWeights.z;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.w) * aBoneWeights.w;
 
             // Transform position and normal
             vec4 skinnedPos = boneTransform * vec4(aPos, 1.0);
@@ -112,6 +138,7 @@ bool CharacterRenderer::initialize() {
         in vec3 FragPos;
         in vec3 Normal;
         in vec2 TexCoord;
+        flat in float vOpacity;
 
         uniform sampler2D uTexture0;
         uniform vec3 uLightDir;
@@ -127,7 +154,6 @@ bool CharacterRenderer::initialize() {
         uniform mat4 uLightSpaceMatrix;
         uniform int uShadowEnabled;
         uniform float uShadowStrength;
-        uniform float uOpacity;
 
         out vec4 FragColor;
 
@@ -181,15 +207,14 @@ bool CharacterRenderer::initialize() {
             result = mix(uFogColor, result, fogFactor);
 
             // Apply opacity (for fade-in effects)
-            FragColor = vec4(result, uOpacity);
+            FragColor = vec4(result, vOpacity);
         }
     )";
 
-    // Log GPU uniform limit
-    GLint maxComponents = 0;
-    glGetIntegerv(GL_MAX_VERTEX_UNIFORM_COMPONENTS, &maxComponents);
-    core::Logger::getInstance().info("GPU max vertex uniform components: ", maxComponents,
-                                     " (supports ~", maxComponents / 16, " mat4)");
+    // Bone palettes and instance records are fetched from texture buffers
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTextureBufferTexels_);
+    core::Logger::getInstance().info("GPU max texture buffer size: ", maxTextureBufferTexels_,
+                                     " texels (~", maxTextureBufferTexels_ / 3, " palette bones)");
 
     characterShader = std::make_unique<Shader>();
     if (!characterShader->loadFromSource(vertexSrc, fragmentSrc)) {
@@ -205,17 +230,38 @@ bool CharacterRenderer::initialize() {
         layout (location = 4) in vec2 aTexCoord;
 
         uniform mat4 uLightSpaceMatrix;
-        uniform mat4 uModel;
-        uniform mat4 uBones[240];
+        uniform samplerBuffer uBonePalette;
+        uniform samplerBuffer uInstanceData;
+        uniform int uInstanceSlots[64];
 
         out vec2 vTexCoord;
 
+        mat4 fetchBone(int base, int count, int bone) {
+            int t = base + min(bone, count - 1) * 3;
+            vec4 r0 = texelFetch(uBonePalette, t);
+            vec4 r1 = texelFetch(uBonePalette, t + 1);
+            vec4 r2 = texelFetch(uBonePalette, t + 2);
+            return mat4(r0.x, r1.x, r2.x, 0.0,
+                        r0.y, r1.y, r2.y, 0.0,
+                        r0.z, r1.z, r2.z, 0.0,
+                        r0.w, r1.w, r2.w, 1.0);
+        }
+
         void main() {
+            int rec = uInstanceSlots[gl_InstanceID] * 5;
+            mat4 uModel = mat4(texelFetch(uInstanceData, rec),
+                               texelFetch(uInstanceData, rec + 1),
+                               texelFetch(uInstanceData, rec + 2),
+                               texelFetch(uInstanceData, rec + 3));
+            vec4 params = texelFetch(uInstanceData, rec + 4);
+            int paletteBase = int(params.x);
+            int boneCount = int(params.y);
+
             mat4 boneTransform = mat4(0.0);
-            boneTransform += uBones[aBoneIndices.x] * aBoneWeights.x;
-            boneTransform += uBones[aBoneIndices.y] * aBoneWeights.y;
-            boneTransform += uBones[aBoneIndices.z] * aBoneWeights.z;
-            boneTransform += uBones[aBoneIndices.w] * aBoneWeights.w;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.x) * aBoneWeights.x;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.y) * aBoneWeights.y;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.z) * aBoneWeights.z;
+            boneTransform += fetchBone(paletteBase, boneCount, aBoneIndices.w) * aBoneWeights.w;
             vec4 skinnedPos = boneTransform * vec4(aPos, 1.0);
             vTexCoord = aTexCoord;
             gl_Position = uLightSpaceMatrix * uModel * skinnedPos;
@@ -273,6 +319,26 @@ bool CharacterRenderer::initialize() {
         return false;
     }
 
+    mainSlotsLoc_ = glGetUniformLocation(characterShader->getProgram(), "uInstanceSlots[0]");
+    shadowSlotsLoc_ = glGetUniformLocation(shadowCasterProgram, "uInstanceSlots[0]");
+
+    // Per-frame texture buffers for bone palettes and instance records
+    glGenBuffers(1, &paletteBuffer_);
+    glGenTextures(1, &paletteTexture_);
+    glBindBuffer(GL_TEXTURE_BUFFER, paletteBuffer_);
+    glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, paletteTexture_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, paletteBuffer_);
+
+    glGenBuffers(1, &instanceDataBuffer_);
+    glGenTextures(1, &instanceDataTexture_);
+    glBindBuffer(GL_TEXTURE_BUFFER, instanceDataBuffer_);
+    glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, instanceDataTexture_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, instanceDataBuffer_);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
     // Create 1x1 white fallback texture
     uint8_t white[] = { 255, 255, 255, 255 };
     glGenTextures(1, &whiteTexture);
@@ -290,6 +356,12 @@ bool CharacterRenderer::initialize() {
 }
 
 void CharacterRenderer::shutdown() {
+    // Stop compositing workers before tearing down GL state
+    skinCompositor_.reset();
+    pendingSkinComposites_.clear();
+    latestSkinTicket_.clear();
+    finishedComposites_.clear();
+
     // Clean up GPU resources
     for (auto& pair : models) {
         auto& gpuModel = pair.second;
@@ -328,6 +400,10 @@ void CharacterRenderer::shutdown() {
         glDeleteProgram(shadowCasterProgram);
         shadowCasterProgram = 0;
     }
+    if (paletteTexture_) { glDeleteTextures(1, &paletteTexture_); paletteTexture_ = 0; }
+    if (paletteBuffer_) { glDeleteBuffers(1, &paletteBuffer_); paletteBuffer_ = 0; }
+    if (instanceDataTexture_) { glDeleteTextures(1, &instanceDataTexture_); instanceDataTexture_ = 0; }
+    if (instanceDataBuffer_) { glDeleteBuffers(1, &instanceDataBuffer_); instanceDataBuffer_ = 0; }
 }
 
 GLuint CharacterRenderer::loadTexture(const std::string& path) {
@@ -373,8 +449,7 @@ GLuint CharacterRenderer::loadTexture(const std::string& path) {
     GLuint texId;
     glGenTextures(1, &texId);
     glBindTexture(GL_TEXTURE_2D, texId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, blpImage.width, blpImage.height,
-                 0, GL_RGBA, GL_UNSIGNED_BYTE, blpImage.data.data());
+    uploadTexImage2D(0, GL_RGBA, blpImage.width, blpImage.height, GL_RGBA, blpImage.data.data());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -399,229 +474,11 @@ GLuint CharacterRenderer::loadTexture(const std::string& path) {
     return texId;
 }
 
-// Alpha-blend overlay onto composite at (dstX, dstY)
-static void blitOverlay(std::vector<uint8_t>& composite, int compW, int compH,
-                         const pipeline::BLPImage& overlay, int dstX, int dstY) {
-    for (int sy = 0; sy < overlay.height; sy++) {
-        int dy = dstY + sy;
-        if (dy < 0 || dy >= compH) continue;
-        for (int sx = 0; sx < overlay.width; sx++) {
-            int dx = dstX + sx;
-            if (dx < 0 || dx >= compW) continue;
-
-            size_t srcIdx = (static_cast<size_t>(sy) * overlay.width + sx) * 4;
-            size_t dstIdx = (static_cast<size_t>(dy) * compW + dx) * 4;
-
-            uint8_t srcA = overlay.data[srcIdx + 3];
-            if (srcA == 0) continue;
-
-            if (srcA == 255) {
-                composite[dstIdx + 0] = overlay.data[srcIdx + 0];
-                composite[dstIdx + 1] = overlay.data[srcIdx + 1];
-                composite[dstIdx + 2] = overlay.data[srcIdx + 2];
-                composite[dstIdx + 3] = 255;
-            } else {
-                float alpha = srcA / 255.0f;
-                float invAlpha = 1.0f - alpha;
-                composite[dstIdx + 0] = static_cast<uint8_t>(overlay.data[srcIdx + 0] * alpha + composite[dstIdx + 0] * invAlpha);
-                composite[dstIdx + 1] = static_cast<uint8_t>(overlay.data[srcIdx + 1] * alpha + composite[dstIdx + 1] * invAlpha);
-                composite[dstIdx + 2] = static_cast<uint8_t>(overlay.data[srcIdx + 2] * alpha + composite[dstIdx + 2] * invAlpha);
-                composite[dstIdx + 3] = std::max(composite[dstIdx + 3], srcA);
-            }
-        }
-    }
-}
-
-// Nearest-neighbor NxN scale blit of overlay onto composite at (dstX, dstY)
-static void blitOverlayScaledN(std::vector<uint8_t>& composite, int compW, int compH,
-                                const pipeline::BLPImage& overlay, int dstX, int dstY, int scale) {
-    if (scale < 1) scale = 1;
-    for (int sy = 0; sy < overlay.height; sy++) {
-        for (int sx = 0; sx < overlay.width; sx++) {
-            size_t srcIdx = (static_cast<size_t>(sy) * overlay.width + sx) * 4;
-            uint8_t srcA = overlay.data[srcIdx + 3];
-            if (srcA == 0) continue;
-
-            // Write to scale×scale block of destination pixels
-            for (int dy2 = 0; dy2 < scale; dy2++) {
-                int dy = dstY + sy * scale + dy2;
-                if (dy < 0 || dy >= compH) continue;
-                for (int dx2 = 0; dx2 < scale; dx2++) {
-                    int dx = dstX + sx * scale + dx2;
-                    if (dx < 0 || dx >= compW) continue;
-
-                    size_t dstIdx = (static_cast<size_t>(dy) * compW + dx) * 4;
-                    if (srcA == 255) {
-                        composite[dstIdx + 0] = overlay.data[srcIdx + 0];
-                        composite[dstIdx + 1] = overlay.data[srcIdx + 1];
-                        composite[dstIdx + 2] = overlay.data[srcIdx + 2];
-                        composite[dstIdx + 3] = 255;
-                    } else {
-                        float alpha = srcA / 255.0f;
-                        float invAlpha = 1.0f - alpha;
-                        composite[dstIdx + 0] = static_cast<uint8_t>(overlay.data[srcIdx + 0] * alpha + composite[dstIdx + 0] * invAlpha);
-                        composite[dstIdx + 1] = static_cast<uint8_t>(overlay.data[srcIdx + 1] * alpha + composite[dstIdx + 1] * invAlpha);
-                        composite[dstIdx + 2] = static_cast<uint8_t>(overlay.data[srcIdx + 2] * alpha + composite[dstIdx + 2] * invAlpha);
-                        composite[dstIdx + 3] = std::max(composite[dstIdx + 3], srcA);
-                    }
-                }
-            }
-        }
-    }
-}
-
-// Legacy 2x wrapper
-static void blitOverlayScaled2x(std::vector<uint8_t>& composite, int compW, int compH,
-                                 const pipeline::BLPImage& overlay, int dstX, int dstY) {
-    blitOverlayScaledN(composite, compW, compH, overlay, dstX, dstY, 2);
-}
-
-GLuint CharacterRenderer::compositeTextures(const std::vector<std::string>& layerPaths) {
-    if (layerPaths.empty() || !assetManager || !assetManager->isInitialized()) {
-        return whiteTexture;
-    }
-
-    // Load base layer
-    auto base = assetManager->loadTexture(layerPaths[0]);
-    if (!base.isValid()) {
-        core::Logger::getInstance().warning("Composite: failed to load base layer: ", layerPaths[0]);
-        return whiteTexture;
-    }
-
-    // Copy base pixel data as our working buffer
-    std::vector<uint8_t> composite = base.data;
-    int width = base.width;
-    int height = base.height;
-
-    core::Logger::getInstance().info("Composite: base layer ", width, "x", height, " from ", layerPaths[0]);
-
-    // WoW character texture atlas regions (from WoW Model Viewer / CharComponentTextureSections)
-    // Coordinates at 256x256 base resolution:
-    // Region          X    Y    W    H
-    // Base            0    0    256  256
-    // Arm Upper       0    0    128  64
-    // Arm Lower       0    64   128  64
-    // Hand            0    128  128  32
-    // Face Upper      0    160  128  32
-    // Face Lower      0    192  128  64
-    // Torso Upper     128  0    128  64
-    // Torso Lower     128  64   128  32
-    // Pelvis Upper    128  96   128  64
-    // Pelvis Lower    128  160  128  64
-    // Foot            128  224  128  32
-
-    // Scale factor: base texture may be larger than the 256x256 reference atlas
-    int coordScale = width / 256;
-    if (coordScale < 1) coordScale = 1;
-
-    // Atlas region sizes at 256x256 base (w, h) for known regions
-    struct AtlasRegion { int x, y, w, h; };
-    static const AtlasRegion faceLowerRegion256 = {0, 192, 128, 64};
-    static const AtlasRegion faceUpperRegion256 = {0, 160, 128, 32};
-
-    // Alpha-blend each overlay onto the composite
-    for (size_t layer = 1; layer < layerPaths.size(); layer++) {
-        if (layerPaths[layer].empty()) continue;
-
-        auto overlay = assetManager->loadTexture(layerPaths[layer]);
-        if (!overlay.isValid()) {
-            core::Logger::getInstance().warning("Composite: FAILED to load overlay: ", layerPaths[layer]);
-            continue;
-        }
-
-        core::Logger::getInstance().info("Composite: overlay ", layerPaths[layer],
-            " (", overlay.width, "x", overlay.height, ")");
-
-        if (overlay.width == width && overlay.height == height) {
-            // Same size: full alpha-blend
-            blitOverlay(composite, width, height, overlay, 0, 0);
-        } else {
-            // Determine region by filename keywords
-            // Coordinates scale with base texture size (256x256 is reference)
-            int dstX = 0, dstY = 0;
-            int expectedW256 = 0, expectedH256 = 0; // Expected size at 256-base
-            std::string pathLower = layerPaths[layer];
-            for (auto& c : pathLower) c = std::tolower(c);
-
-            if (pathLower.find("faceupper") != std::string::npos) {
-                dstX = faceUpperRegion256.x; dstY = faceUpperRegion256.y;
-                expectedW256 = faceUpperRegion256.w; expectedH256 = faceUpperRegion256.h;
-            } else if (pathLower.find("facelower") != std::string::npos) {
-                dstX = faceLowerRegion256.x; dstY = faceLowerRegion256.y;
-                expectedW256 = faceLowerRegion256.w; expectedH256 = faceLowerRegion256.h;
-            } else if (pathLower.find("pelvis") != std::string::npos) {
-                dstX = 128; dstY = 96;
-                expectedW256 = 128; expectedH256 = 64;
-            } else if (pathLower.find("torso") != std::string::npos) {
-                dstX = 128; dstY = 0;
-                expectedW256 = 128; expectedH256 = 64;
-            } else if (pathLower.find("armupper") != std::string::npos) {
-                dstX = 0; dstY = 0;
-                expectedW256 = 128; expectedH256 = 64;
-            } else if (pathLower.find("armlower") != std::string::npos) {
-                dstX = 0; dstY = 64;
-                expectedW256 = 128; expectedH256 = 64;
-            } else if (pathLower.find("hand") != std::string::npos) {
-                dstX = 0; dstY = 128;
-                expectedW256 = 128; expectedH256 = 32;
-            } else if (pathLower.find("foot") != std::string::npos || pathLower.find("feet") != std::string::npos) {
-                dstX = 128; dstY = 224;
-                expectedW256 = 128; expectedH256 = 32;
-            } else if (pathLower.find("legupper") != std::string::npos || pathLower.find("leg") != std::string::npos) {
-                dstX = 128; dstY = 160;
-                expectedW256 = 128; expectedH256 = 64;
-            } else {
-                // Unknown — center placement as fallback
-                dstX = (width - overlay.width) / 2;
-                dstY = (height - overlay.height) / 2;
-                core::Logger::getInstance().info("Composite: UNKNOWN region for '",
-                    layerPaths[layer], "', centering at (", dstX, ",", dstY, ")");
-                blitOverlay(composite, width, height, overlay, dstX, dstY);
-                continue;
-            }
-
-            // Scale coordinates from 256-base to actual canvas
-            dstX *= coordScale;
-            dstY *= coordScale;
-
-            // If overlay is 256-base sized but canvas is larger, scale the overlay up
-            int expectedW = expectedW256 * coordScale;
-            int expectedH = expectedH256 * coordScale;
-            bool needsScale = (coordScale > 1 &&
-                               overlay.width == expectedW256 && overlay.height == expectedH256);
-
-            core::Logger::getInstance().info("Composite: placing '", layerPaths[layer],
-                "' (", overlay.width, "x", overlay.height,
-                ") at (", dstX, ",", dstY, ") on ", width, "x", height,
-                " expected=", expectedW, "x", expectedH,
-                needsScale ? " [SCALING]" : "");
-
-            if (needsScale) {
-                blitOverlayScaledN(composite, width, height, overlay, dstX, dstY, coordScale);
-            } else {
-                blitOverlay(composite, width, height, overlay, dstX, dstY);
-            }
-        }
-    }
-
-    // Debug: dump composite to /tmp for visual inspection
-    {
-        std::string dumpPath = "/tmp/wowee_composite_debug_" +
-            std::to_string(width) + "x" + std::to_string(height) + ".raw";
-        std::ofstream dump(dumpPath, std::ios::binary);
-        if (dump) {
-            dump.write(reinterpret_cast<const char*>(composite.data()),
-                       static_cast<std::streamsize>(composite.size()));
-            core::Logger::getInstance().info("Composite debug dump: ", dumpPath,
-                " (", width, "x", height, ", ", composite.size(), " bytes)");
-        }
-    }
-
-    // Upload composite to GPU
+GLuint CharacterRenderer::uploadCompositeTexture(const pipeline::BLPImage& image) {
     GLuint texId;
     glGenTextures(1, &texId);
     glBindTexture(GL_TEXTURE_2D, texId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, composite.data());
+    uploadTexImage2D(0, GL_RGBA, image.width, image.height, GL_RGBA, image.data.data());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -629,11 +486,31 @@ GLuint CharacterRenderer::compositeTextures(const std::vector<std::string>& laye
     glGenerateMipmap(GL_TEXTURE_2D);
     applyAnisotropicFiltering();
     glBindTexture(GL_TEXTURE_2D, 0);
-
-    core::Logger::getInstance().info("Composite texture created: ", width, "x", height, " from ", layerPaths.size(), " layers");
     return texId;
 }
 
+CharacterSkinCompositor* CharacterRenderer::skinCompositor() {
+    if (!skinCompositor_ && assetManager && assetManager->isInitialized()) {
+        skinCompositor_ = std::make_unique<CharacterSkinCompositor>(assetManager);
+    }
+    return skinCompositor_.get();
+}
+
+GLuint CharacterRenderer::compositeTextures(const std::vector<std::string>& layerPaths) {
+    if (layerPaths.empty() || !skinCompositor()) {
+        return whiteTexture;
+    }
+
+    SkinCompositeRequest request;
+    request.basePath = layerPaths[0];
+    request.baseLayers.assign(layerPaths.begin() + 1, layerPaths.end());
+    auto image = skinCompositor_->compose(request);
+    if (!image.isValid()) {
+        return whiteTexture;
+    }
+    return uploadCompositeTexture(image);
+}
+
 void CharacterRenderer::clearCompositeCache() {
     // Just clear the lookup map so next compositeWithRegions() creates fresh textures.
     // Don't delete GPU textures — they may still be referenced by models or instances.
@@ -644,203 +521,94 @@ void CharacterRenderer::clearCompositeCache() {
 GLuint CharacterRenderer::compositeWithRegions(const std::string& basePath,
                                                 const std::vector<std::string>& baseLayers,
                                                 const std::vector<std::pair<int, std::string>>& regionLayers) {
-    // Build cache key from all inputs to avoid redundant compositing
-    std::string cacheKey = basePath;
-    for (const auto& bl : baseLayers) { cacheKey += '|'; cacheKey += bl; }
-    cacheKey += '#';
-    for (const auto& rl : regionLayers) {
-        cacheKey += std::to_string(rl.first);
-        cacheKey += ':';
-        cacheKey += rl.second;
-        cacheKey += ',';
-    }
+    SkinCompositeRequest request;
+    request.basePath = basePath;
+    request.baseLayers = baseLayers;
+    request.regionLayers = regionLayers;
+    request.regionMode = true;
+
+    // Avoid redundant compositing: in-memory GL textures first, then the disk cache
+    std::string cacheKey = request.cacheKey();
     auto cacheIt = compositeCache_.find(cacheKey);
     if (cacheIt != compositeCache_.end() && cacheIt->second != 0) {
         return cacheIt->second;
     }
-
-    // Region index → pixel coordinates on the 256x256 base atlas
-    // These are scaled up by (width/256, height/256) for larger textures (512x512, 1024x1024)
-    static const int regionCoords256[][2] = {
-        {   0,   0 },  // 0 = ArmUpper
-        {   0,  64 },  // 1 = ArmLower
-        {   0, 128 },  // 2 = Hand
-        { 128,   0 },  // 3 = TorsoUpper
-        { 128,  64 },  // 4 = TorsoLower
-        { 128,  96 },  // 5 = LegUpper
-        { 128, 160 },  // 6 = LegLower
-        { 128, 224 },  // 7 = Foot
-    };
-
-    // First, build base skin + underwear using existing compositeTextures
-    std::vector<std::string> layers;
-    layers.push_back(basePath);
-    for (const auto& ul : baseLayers) {
-        layers.push_back(ul);
-    }
-    // Load base composite into CPU buffer
-    if (!assetManager || !assetManager->isInitialized()) {
+    if (!skinCompositor()) {
         return whiteTexture;
     }
 
-    auto base = assetManager->loadTexture(basePath);
-    if (!base.isValid()) {
+    auto image = skinCompositor_->compose(request);
+    if (!image.isValid()) {
         return whiteTexture;
     }
+    GLuint texId = uploadCompositeTexture(image);
+    compositeCache_[cacheKey] = texId;
+    return texId;
+}
 
-    std::vector<uint8_t> composite;
-    int width = base.width;
-    int height = base.height;
-
-
-
-    // If base texture is 256x256 (e.g., baked NPC texture), upscale to 512x512
-    // so equipment regions can be composited at correct coordinates
-    if (width == 256 && height == 256 && !regionLayers.empty()) {
-        width = 512;
-        height = 512;
-        composite.resize(width * height * 4);
-        // Simple 2x nearest-neighbor upscale
-        for (int y = 0; y < 512; y++) {
-            for (int x = 0; x < 512; x++) {
-                int srcX = x / 2;
-                int srcY = y / 2;
-                int srcIdx = (srcY * 256 + srcX) * 4;
-                int dstIdx = (y * 512 + x) * 4;
-                composite[dstIdx + 0] = base.data[srcIdx + 0];
-                composite[dstIdx + 1] = base.data[srcIdx + 1];
-                composite[dstIdx + 2] = base.data[srcIdx + 2];
-                composite[dstIdx + 3] = base.data[srcIdx + 3];
-            }
-        }
-        core::Logger::getInstance().debug("compositeWithRegions: upscaled 256x256 to 512x512");
-    } else {
-        composite = base.data;
+void CharacterRenderer::requestCompositeWithRegions(uint32_t instanceId, uint16_t textureSlot,
+                                                    const std::string& basePath,
+                                                    const std::vector<std::string>& baseLayers,
+                                                    const std::vector<std::pair<int, std::string>>& regionLayers) {
+    SkinCompositeRequest request;
+    request.basePath = basePath;
+    request.baseLayers = baseLayers;
+    request.regionLayers = regionLayers;
+    request.regionMode = true;
+
+    const uint64_t target = (static_cast<uint64_t>(instanceId) << 16) | textureSlot;
+    auto cacheIt = compositeCache_.find(request.cacheKey());
+    if (cacheIt != compositeCache_.end() && cacheIt->second != 0) {
+        latestSkinTicket_.erase(target);  // Supersede any in-flight request
+        setTextureSlotOverride(instanceId, textureSlot, cacheIt->second);
+        return;
     }
-
-    // Blend face + underwear overlays
-    // If we upscaled from 256→512, scale coords and texels with blitOverlayScaled2x.
-    // For native 512/1024 textures, face overlays are full atlas size (hit width==width branch).
-    bool upscaled = (base.width == 256 && base.height == 256 && width == 512);
-    for (const auto& ul : baseLayers) {
-        if (ul.empty()) continue;
-        auto overlay = assetManager->loadTexture(ul);
-        if (!overlay.isValid()) continue;
-
-        if (overlay.width == width && overlay.height == height) {
-            blitOverlay(composite, width, height, overlay, 0, 0);
-        } else {
-            // WoW 256-scale atlas coordinates (from CharComponentTextureSections)
-            int dstX = 0, dstY = 0;
-            std::string pathLower = ul;
-            for (auto& c : pathLower) c = std::tolower(c);
-
-            // Scale factor from 256-base coordinates to actual canvas size
-            int coordScale = width / 256;
-            if (coordScale < 1) coordScale = 1;
-            bool useScale = true;
-
-            if (pathLower.find("faceupper") != std::string::npos) {
-                dstX = 0; dstY = 160;
-            } else if (pathLower.find("facelower") != std::string::npos) {
-                dstX = 0; dstY = 192;
-            } else if (pathLower.find("pelvis") != std::string::npos) {
-                dstX = 128; dstY = 96;
-            } else if (pathLower.find("torso") != std::string::npos) {
-                dstX = 128; dstY = 0;
-            } else if (pathLower.find("armupper") != std::string::npos) {
-                dstX = 0; dstY = 0;
-            } else if (pathLower.find("armlower") != std::string::npos) {
-                dstX = 0; dstY = 64;
-            } else if (pathLower.find("hand") != std::string::npos) {
-                dstX = 0; dstY = 128;
-            } else if (pathLower.find("foot") != std::string::npos || pathLower.find("feet") != std::string::npos) {
-                dstX = 128; dstY = 224;
-            } else if (pathLower.find("legupper") != std::string::npos || pathLower.find("leg") != std::string::npos) {
-                dstX = 128; dstY = 160;
-            } else {
-                // Fallback: center overlay on canvas (already in canvas coords)
-                dstX = (width - overlay.width) / 2;
-                dstY = (height - overlay.height) / 2;
-                useScale = false;
-            }
-
-            if (useScale) {
-                dstX *= coordScale;
-                dstY *= coordScale;
-            }
-
-            if (upscaled) {
-                // Overlay is 256-base sized, needs 2x texel scaling for 512 canvas
-                blitOverlayScaled2x(composite, width, height, overlay, dstX, dstY);
-            } else {
-                blitOverlay(composite, width, height, overlay, dstX, dstY);
-            }
-        }
+    if (!skinCompositor()) {
+        return;
     }
 
-    // Expected region sizes on the 256x256 base atlas (scaled like coords)
-    static const int regionSizes256[][2] = {
-        { 128,  64 },  // 0 = ArmUpper
-        { 128,  64 },  // 1 = ArmLower
-        { 128,  32 },  // 2 = Hand
-        { 128,  64 },  // 3 = TorsoUpper
-        { 128,  32 },  // 4 = TorsoLower
-        { 128,  64 },  // 5 = LegUpper
-        { 128,  64 },  // 6 = LegLower
-        { 128,  32 },  // 7 = Foot
-    };
+    auto ticket = skinCompositor_->submit(std::move(request));
+    pendingSkinComposites_[ticket] = target;
+    latestSkinTicket_[target] = ticket;
+}
 
-    // Scale factor from 256-base to actual texture size
-    int scaleX = width / 256;
-    int scaleY = height / 256;
-    if (scaleX < 1) scaleX = 1;
-    if (scaleY < 1) scaleY = 1;
+void CharacterRenderer::processFinishedComposites() {
+    if (!skinCompositor_) return;
+    skinCompositor_->collectFinished(finishedComposites_);
 
-    // Now blit equipment region textures at explicit coordinates
-    for (const auto& rl : regionLayers) {
-        int regionIdx = rl.first;
-        if (regionIdx < 0 || regionIdx >= 8) continue;
+    // Spread GPU uploads across frames when a crowd finishes at once
+    size_t processed = 0;
+    while (processed < finishedComposites_.size() && processed < MAX_COMPOSITE_UPLOADS_PER_FRAME) {
+        auto& result = finishedComposites_[processed++];
 
-        auto overlay = assetManager->loadTexture(rl.second);
-        if (!overlay.isValid()) {
-            core::Logger::getInstance().warning("compositeWithRegions: failed to load ", rl.second);
-            continue;
+        uint64_t target = 0;
+        auto pendingIt = pendingSkinComposites_.find(result.ticket);
+        if (pendingIt != pendingSkinComposites_.end()) {
+            target = pendingIt->second;
+            pendingSkinComposites_.erase(pendingIt);
         }
+        auto latestIt = latestSkinTicket_.find(target);
+        bool current = (latestIt != latestSkinTicket_.end() && latestIt->second == result.ticket);
+        if (current) {
+            latestSkinTicket_.erase(latestIt);
+        }
+        if (!result.image.isValid()) continue;
 
-        int dstX = regionCoords256[regionIdx][0] * scaleX;
-        int dstY = regionCoords256[regionIdx][1] * scaleY;
-
-        // Expected full-resolution size for this region at current atlas scale
-        int expectedW = regionSizes256[regionIdx][0] * scaleX;
-        int expectedH = regionSizes256[regionIdx][1] * scaleY;
-        if (overlay.width * 2 == expectedW && overlay.height * 2 == expectedH) {
-            blitOverlayScaled2x(composite, width, height, overlay, dstX, dstY);
+        GLuint texId = 0;
+        auto cacheIt = compositeCache_.find(result.key);
+        if (cacheIt != compositeCache_.end() && cacheIt->second != 0) {
+            texId = cacheIt->second;
         } else {
-            blitOverlay(composite, width, height, overlay, dstX, dstY);
+            texId = uploadCompositeTexture(result.image);
+            compositeCache_[result.key] = texId;
+        }
+        if (current) {
+            setTextureSlotOverride(static_cast<uint32_t>(target >> 16),
+                                   static_cast<uint16_t>(target & 0xFFFF), texId);
         }
-
-        core::Logger::getInstance().debug("compositeWithRegions: region ", regionIdx,
-            " at (", dstX, ",", dstY, ") ", overlay.width, "x", overlay.height, " from ", rl.second);
     }
-
-    // Upload to GPU
-    GLuint texId;
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, composite.data());
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    applyAnisotropicFiltering();
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    core::Logger::getInstance().debug("compositeWithRegions: created ", width, "x", height,
-        " texture with ", regionLayers.size(), " equipment regions");
-    compositeCache_[cacheKey] = texId;
-    return texId;
+    finishedComposites_.erase(finishedComposites_.begin(),
+                              finishedComposites_.begin() + static_cast<std::ptrdiff_t>(processed));
 }
 
 void CharacterRenderer::setModelTexture(uint32_t modelId, uint32_t textureSlot, GLuint textureId) {
@@ -927,8 +695,8 @@ void CharacterRenderer::setupModelBuffers(M2ModelGPU& gpuModel) {
 
     // Interleaved vertex data
     glBindBuffer(GL_ARRAY_BUFFER, gpuModel.vbo);
-    glBufferData(GL_ARRAY_BUFFER, model.vertices.size() * sizeof(pipeline::M2Vertex),
-                model.vertices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ARRAY_BUFFER, model.vertices.size() * sizeof(pipeline::M2Vertex),
+                    model.vertices.data(), GL_STATIC_DRAW);
 
     // Position
     glEnableVertexAttribArray(0);
@@ -957,8 +725,8 @@ void CharacterRenderer::setupModelBuffers(M2ModelGPU& gpuModel) {
 
     // Index buffer
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuModel.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, model.indices.size() * sizeof(uint16_t),
-                model.indices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, model.indices.size() * sizeof(uint16_t),
+                    model.indices.data(), GL_STATIC_DRAW);
 
     glBindVertexArray(0);
 }
@@ -1001,6 +769,7 @@ uint32_t CharacterRenderer::createInstance(uint32_t modelId, const glm::vec3& po
     instance.boneMatrices.resize(std::max(static_cast<size_t>(1), model.bones.size()), glm::mat4(1.0f));
 
     instances[instance.id] = instance;
+    paletteDirty_ = true;
     return instance.id;
 }
 
@@ -1054,6 +823,10 @@ void CharacterRenderer::playAnimation(uint32_t instanceId, uint32_t animationId,
 void CharacterRenderer::update(float deltaTime, const glm::vec3& cameraPos) {
     // Distance culling for animation updates (150 unit radius)
     const float animUpdateRadiusSq = 150.0f * 150.0f;
+    paletteDirty_ = true;
+
+    // Apply skins composited on worker threads since the last frame
+    processFinishedComposites();
 
     // Update fade-in opacity
     for (auto& [id, inst] : instances) {
@@ -1184,88 +957,6 @@ void CharacterRenderer::updateAnimation(CharacterInstance& instance, float delta
     calculateBoneMatrices(instance);
 }
 
-// --- Keyframe interpolation helpers ---
-
-int CharacterRenderer::findKeyframeIndex(const std::vector<uint32_t>& timestamps, float time) {
-    if (timestamps.empty()) return -1;
-    if (timestamps.size() == 1) return 0;
-
-    // Binary search for the keyframe bracket
-    for (size_t i = 0; i < timestamps.size() - 1; i++) {
-        if (time < static_cast<float>(timestamps[i + 1])) {
-            return static_cast<int>(i);
-        }
-    }
-    return static_cast<int>(timestamps.size() - 2);
-}
-
-glm::vec3 CharacterRenderer::interpolateVec3(const pipeline::M2AnimationTrack& track,
-                                              int seqIdx, float time, const glm::vec3& defaultVal) {
-    if (!track.hasData()) return defaultVal;
-    if (seqIdx < 0 || seqIdx >= static_cast<int>(track.sequences.size())) return defaultVal;
-
-    const auto& keys = track.sequences[seqIdx];
-    if (keys.timestamps.empty() || keys.vec3Values.empty()) return defaultVal;
-
-    auto safeVec3 = [&](const glm::vec3& v) -> glm::vec3 {
-        if (std::isnan(v.x) || std::isnan(v.y) || std::isnan(v.z)) return defaultVal;
-        return v;
-    };
-
-    if (keys.vec3Values.size() == 1) return safeVec3(keys.vec3Values[0]);
-
-    int idx = findKeyframeIndex(keys.timestamps, time);
-    if (idx < 0) return defaultVal;
-
-    size_t i0 = static_cast<size_t>(idx);
-    size_t i1 = std::min(i0 + 1, keys.vec3Values.size() - 1);
-
-    if (i0 == i1) return safeVec3(keys.vec3Values[i0]);
-
-    float t0 = static_cast<float>(keys.timestamps[i0]);
-    float t1 = static_cast<float>(keys.timestamps[i1]);
-    float duration = t1 - t0;
-    float t = (duration > 0.0f) ? glm::clamp((time - t0) / duration, 0.0f, 1.0f) : 0.0f;
-
-    return safeVec3(glm::mix(keys.vec3Values[i0], keys.vec3Values[i1], t));
-}
-
-glm::quat CharacterRenderer::interpolateQuat(const pipeline::M2AnimationTrack& track,
-                                              int seqIdx, float time) {
-    glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
-    if (!track.hasData()) return identity;
-    if (seqIdx < 0 || seqIdx >= static_cast<int>(track.sequences.size())) return identity;
-
-    const auto& keys = track.sequences[seqIdx];
-    if (keys.timestamps.empty() || keys.quatValues.empty()) return identity;
-
-    auto safeQuat = [&](const glm::quat& q) -> glm::quat {
-        float len = glm::length(q);
-        if (len < 0.001f || std::isnan(len)) return identity;
-        return q;
-    };
-
-    if (keys.quatValues.size() == 1) return safeQuat(keys.quatValues[0]);
-
-    int idx = findKeyframeIndex(keys.timestamps, time);
-    if (idx < 0) return identity;
-
-    size_t i0 = static_cast<size_t>(idx);
-    size_t i1 = std::min(i0 + 1, keys.quatValues.size() - 1);
-
-    if (i0 == i1) return safeQuat(keys.quatValues[i0]);
-
-    glm::quat q0 = safeQuat(keys.quatValues[i0]);
-    glm::quat q1 = safeQuat(keys.quatValues[i1]);
-
-    float t0 = static_cast<float>(keys.timestamps[i0]);
-    float t1 = static_cast<float>(keys.timestamps[i1]);
-    float duration = t1 - t0;
-    float t = (duration > 0.0f) ? glm::clamp((time - t0) / duration, 0.0f, 1.0f) : 0.0f;
-
-    return glm::slerp(q0, q1, t);
-}
-
 // --- Bone transform calculation ---
 
 void CharacterRenderer::calculateBoneMatrices(CharacterInstance& instance) {
@@ -1275,38 +966,14 @@ void CharacterRenderer::calculateBoneMatrices(CharacterInstance& instance) {
         return;
     }
 
-    size_t numBones = model.bones.size();
-    instance.boneMatrices.resize(numBones);
+    // Local transform includes pivot bracket: T(pivot)*T*R*S*T(-pivot)
+    // At rest this is identity, so no separate bind pose is needed.
+    // Character tracks are sampled per sequence (global sequences not applied).
+    BoneEvalOptions options;
+    evaluateBonePalette(model.bones, model.bones.size(), instance.currentSequenceIndex,
+                        instance.animationTime, options, instance.animCursor, instance.boneMatrices);
 
     static bool dumpedOnce = false;
-
-    for (size_t i = 0; i < numBones; i++) {
-        const auto& bone = model.bones[i];
-
-        // Local transform includes pivot bracket: T(pivot)*T*R*S*T(-pivot)
-        // At rest this is identity, so no separate bind pose is needed
-        glm::mat4 localTransform = getBoneTransform(bone, instance.animationTime, instance.currentSequenceIndex);
-
-        // Debug: dump first frame bone data
-        if (!dumpedOnce && i < 5) {
-            glm::vec3 t = interpolateVec3(bone.translation, instance.currentSequenceIndex, instance.animationTime, glm::vec3(0.0f));
-            glm::quat r = interpolateQuat(bone.rotation, instance.currentSequenceIndex, instance.animationTime);
-            glm::vec3 s = interpolateVec3(bone.scale, instance.currentSequenceIndex, instance.animationTime, glm::vec3(1.0f));
-            core::Logger::getInstance().info("Bone ", i, " parent=", bone.parentBone,
-                " pivot=(", bone.pivot.x, ",", bone.pivot.y, ",", bone.pivot.z, ")",
-                " t=(", t.x, ",", t.y, ",", t.z, ")",
-                " r=(", r.w, ",", r.x, ",", r.y, ",", r.z, ")",
-                " s=(", s.x, ",", s.y, ",", s.z, ")",
-                " seqIdx=", instance.currentSequenceIndex);
-        }
-
-        // Compose with parent
-        if (bone.parentBone >= 0 && static_cast<size_t>(bone.parentBone) < numBones) {
-            instance.boneMatrices[i] = instance.boneMatrices[bone.parentBone] * localTransform;
-        } else {
-            instance.boneMatrices[i] = localTransform;
-        }
-    }
     if (!dumpedOnce) {
         dumpedOnce = true;
         // Dump final matrix for bone 0
@@ -1315,22 +982,6 @@ void CharacterRenderer::calculateBoneMatrices(CharacterInstance& instance) {
     }
 }
 
-glm::mat4 CharacterRenderer::getBoneTransform(const pipeline::M2Bone& bone, float time, int sequenceIndex) {
-    glm::vec3 translation = interpolateVec3(bone.translation, sequenceIndex, time, glm::vec3(0.0f));
-    glm::quat rotation = interpolateQuat(bone.rotation, sequenceIndex, time);
-    glm::vec3 scale = interpolateVec3(bone.scale, sequenceIndex, time, glm::vec3(1.0f));
-
-    // M2 bone transform: T(pivot) * T(trans) * R(rot) * S(scale) * T(-pivot)
-    // At rest (no animation): T(pivot) * I * I * I * T(-pivot) = identity
-    glm::mat4 transform = glm::translate(glm::mat4(1.0f), bone.pivot);
-    transform = glm::translate(transform, translation);
-    transform *= glm::toMat4(rotation);
-    transform = glm::scale(transform, scale);
-    transform = glm::translate(transform, -bone.pivot);
-
-    return transform;
-}
-
 // --- Rendering ---
 
 void CharacterRenderer::render(const Camera& camera, const glm::mat4& view, const glm::mat4& projection) {
@@ -1365,6 +1016,14 @@ void CharacterRenderer::render(const Camera& camera, const glm::mat4& view, cons
         glBindTexture(GL_TEXTURE_2D, shadowDepthTex);
         characterShader->setUniform("uShadowMap", 7);
     }
+    characterShader->setUniform("uBonePalette", 5);
+    characterShader->setUniform("uInstanceData", 6);
+
+    // Upload bone palettes + instance records, then group instances that
+    // resolve to identical draws so they render with one instanced call.
+    uploadFrameData();
+    drawGroupCount_ = 0;
+    drawGroupIndex_.clear();
 
     for (const auto& pair : instances) {
         const auto& instance = pair.second;
@@ -1372,26 +1031,12 @@ void CharacterRenderer::render(const Camera& camera, const glm::mat4& view, cons
         // Skip invisible instances (e.g., player in first-person mode)
         if (!instance.visible) continue;
 
-        const auto& gpuModel = models[instance.modelId];
-
         // Skip fully transparent instances
         if (instance.opacity <= 0.0f) continue;
+        if (instance.frameSlot < 0) continue;
 
-        // Set model matrix (use override for weapon instances)
-        glm::mat4 modelMat = instance.hasOverrideModelMatrix
-            ? instance.overrideModelMatrix
-            : getModelMatrix(instance);
-        characterShader->setUniform("uModel", modelMat);
-        characterShader->setUniform("uOpacity", instance.opacity);
-
-        // Set bone matrices (upload all at once for performance)
-        int numBones = std::min(static_cast<int>(instance.boneMatrices.size()), MAX_BONES);
-        if (numBones > 0) {
-            characterShader->setUniformMatrixArray("uBones[0]", instance.boneMatrices.data(), numBones);
-        }
-
-        // Bind VAO and draw
-        glBindVertexArray(gpuModel.vao);
+        const auto& gpuModel = models[instance.modelId];
+        drawScratch_.clear();
 
 	        if (!gpuModel.data.batches.empty()) {
 	            bool applyGeosetFilter = !instance.activeGeosets.empty();
@@ -1564,26 +1209,20 @@ void CharacterRenderer::render(const Camera& camera, const glm::mat4& view, cons
                     }
                 }
 
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texId);
-
-                glDrawElements(GL_TRIANGLES,
-                               batch.indexCount,
-                               GL_UNSIGNED_SHORT,
-                               (void*)(batch.indexStart * sizeof(uint16_t)));
+                uint32_t batchIndex = static_cast<uint32_t>(&batch - gpuModel.data.batches.data());
+                drawScratch_.emplace_back(batchIndex, texId);
             }
         } else {
             // Draw entire model with first texture
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, !gpuModel.textureIds.empty() ? gpuModel.textureIds[0] : whiteTexture);
-
-            glDrawElements(GL_TRIANGLES,
-                          static_cast<GLsizei>(gpuModel.data.indices.size()),
-                          GL_UNSIGNED_SHORT,
-                          0);
+            drawScratch_.emplace_back(WHOLE_MODEL_DRAW,
+                !gpuModel.textureIds.empty() ? gpuModel.textureIds[0] : whiteTexture);
         }
+
+        addToDrawGroup(instance.modelId, drawScratch_, instance.frameSlot);
     }
 
+    drawGroups(mainSlotsLoc_, -1);
+
     glBindVertexArray(0);
     glDisable(GL_BLEND);
     glEnable(GL_CULL_FACE);  // Restore culling for other renderers
@@ -1597,11 +1236,11 @@ void CharacterRenderer::renderShadow(const glm::mat4& lightSpaceMatrix) {
     glUseProgram(shadowCasterProgram);
 
     GLint lightSpaceLoc = glGetUniformLocation(shadowCasterProgram, "uLightSpaceMatrix");
-    GLint modelLoc = glGetUniformLocation(shadowCasterProgram, "uModel");
     GLint texLoc = glGetUniformLocation(shadowCasterProgram, "uTexture");
     GLint alphaTestLoc = glGetUniformLocation(shadowCasterProgram, "uAlphaTest");
-    GLint bonesLoc = glGetUniformLocation(shadowCasterProgram, "uBones[0]");
-    if (lightSpaceLoc < 0 || modelLoc < 0) {
+    GLint paletteLoc = glGetUniformLocation(shadowCasterProgram, "uBonePalette");
+    GLint instanceDataLoc = glGetUniformLocation(shadowCasterProgram, "uInstanceData");
+    if (lightSpaceLoc < 0 || shadowSlotsLoc_ < 0) {
         return;
     }
 
@@ -1610,24 +1249,19 @@ void CharacterRenderer::renderShadow(const glm::mat4& lightSpaceMatrix) {
     glCullFace(GL_FRONT);
 
     if (texLoc >= 0) glUniform1i(texLoc, 0);
-    glActiveTexture(GL_TEXTURE0);
+    if (paletteLoc >= 0) glUniform1i(paletteLoc, 5);
+    if (instanceDataLoc >= 0) glUniform1i(instanceDataLoc, 6);
+
+    uploadFrameData();
+    drawGroupCount_ = 0;
+    drawGroupIndex_.clear();
 
     for (const auto& [_, instance] : instances) {
         auto modelIt = models.find(instance.modelId);
         if (modelIt == models.end()) continue;
         const auto& gpuModel = modelIt->second;
-
-        glm::mat4 modelMat = instance.hasOverrideModelMatrix
-            ? instance.overrideModelMatrix
-            : getModelMatrix(instance);
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &modelMat[0][0]);
-
-        if (!instance.boneMatrices.empty() && bonesLoc >= 0) {
-            int numBones = std::min(static_cast<int>(instance.boneMatrices.size()), MAX_BONES);
-            glUniformMatrix4fv(bonesLoc, numBones, GL_FALSE, &instance.boneMatrices[0][0][0]);
-        }
-
-        glBindVertexArray(gpuModel.vao);
+        if (instance.frameSlot < 0) continue;
+        drawScratch_.clear();
 
         if (!gpuModel.data.batches.empty()) {
             for (const auto& batch : gpuModel.data.batches) {
@@ -1643,29 +1277,157 @@ void CharacterRenderer::renderShadow(const glm::mat4& lightSpaceMatrix) {
                     }
                 }
 
-                bool alphaCutout = (texId != 0 && texId != whiteTexture);
-                if (alphaTestLoc >= 0) glUniform1i(alphaTestLoc, alphaCutout ? 1 : 0);
-                glBindTexture(GL_TEXTURE_2D, texId ? texId : whiteTexture);
-
-                glDrawElements(GL_TRIANGLES,
-                               batch.indexCount,
-                               GL_UNSIGNED_SHORT,
-                               (void*)(batch.indexStart * sizeof(uint16_t)));
+                uint32_t batchIndex = static_cast<uint32_t>(&batch - gpuModel.data.batches.data());
+                drawScratch_.emplace_back(batchIndex, texId ? texId : whiteTexture);
             }
         } else {
-            if (alphaTestLoc >= 0) glUniform1i(alphaTestLoc, 0);
-            glBindTexture(GL_TEXTURE_2D, whiteTexture);
-            glDrawElements(GL_TRIANGLES,
-                           static_cast<GLsizei>(gpuModel.data.indices.size()),
-                           GL_UNSIGNED_SHORT,
-                           0);
+            drawScratch_.emplace_back(WHOLE_MODEL_DRAW, whiteTexture);
         }
+
+        addToDrawGroup(instance.modelId, drawScratch_, instance.frameSlot);
     }
 
+    // Shadow casters alpha-test against any real (non-fallback) texture
+    drawGroups(shadowSlotsLoc_, alphaTestLoc);
+
     glBindVertexArray(0);
     glCullFace(GL_BACK);
 }
 
+void CharacterRenderer::uploadFrameData() {
+    // Bone palettes only change in update()/createInstance(); instance records
+    // (transforms, opacity) are cheap and rebuilt on every pass.
+    if (paletteDirty_) {
+        paletteData_.clear();
+        for (auto& [id, inst] : instances) {
+            int numBones = std::min(static_cast<int>(inst.boneMatrices.size()), MAX_BONES);
+            size_t needed = paletteData_.size() + static_cast<size_t>(numBones) * 3;
+            if (numBones == 0 || needed > static_cast<size_t>(maxTextureBufferTexels_)) {
+                static bool warnedFull = false;
+                if (numBones > 0 && !warnedFull) {
+                    warnedFull = true;
+                    LOG_WARNING("Character bone palette exceeds texture buffer limit (",
+                                maxTextureBufferTexels_, " texels); skipping instances");
+                }
+                inst.paletteBase = -1;
+                continue;
+            }
+            inst.paletteBase = static_cast<int32_t>(paletteData_.size());
+            for (int b = 0; b < numBones; b++) {
+                const glm::mat4& m = inst.boneMatrices[b];
+                paletteData_.emplace_back(m[0][0], m[1][0], m[2][0], m[3][0]);
+                paletteData_.emplace_back(m[0][1], m[1][1], m[2][1], m[3][1]);
+                paletteData_.emplace_back(m[0][2], m[1][2], m[2][2], m[3][2]);
+            }
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, paletteBuffer_);
+        glBufferData(GL_TEXTURE_BUFFER, paletteData_.size() * sizeof(glm::vec4),
+                     paletteData_.data(), GL_STREAM_DRAW);
+        paletteDirty_ = false;
+    }
+
+    instanceData_.clear();
+    const size_t maxRecords = static_cast<size_t>(maxTextureBufferTexels_) / INSTANCE_RECORD_TEXELS;
+    for (auto& [id, inst] : instances) {
+        size_t record = instanceData_.size() / INSTANCE_RECORD_TEXELS;
+        if (inst.paletteBase < 0 || record >= maxRecords) {
+            inst.frameSlot = -1;
+            continue;
+        }
+        inst.frameSlot = static_cast<int32_t>(record);
+        glm::mat4 modelMat = inst.hasOverrideModelMatrix ? inst.overrideModelMatrix : getModelMatrix(inst);
+        instanceData_.push_back(modelMat[0]);
+        instanceData_.push_back(modelMat[1]);
+        instanceData_.push_back(modelMat[2]);
+        instanceData_.push_back(modelMat[3]);
+        int numBones = std::min(static_cast<int>(inst.boneMatrices.size()), MAX_BONES);
+        instanceData_.emplace_back(static_cast<float>(inst.paletteBase), static_cast<float>(numBones),
+                                   inst.opacity, 0.0f);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, instanceDataBuffer_);
+    glBufferData(GL_TEXTURE_BUFFER, instanceData_.size() * sizeof(glm::vec4),
+                 instanceData_.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void CharacterRenderer::addToDrawGroup(uint32_t modelId,
+                                       const std::vector<std::pair<uint32_t, GLuint>>& draws,
+                                       GLint slot) {
+    // FNV-1a over the model and resolved (batch, texture) list
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](uint64_t v) { h ^= v; h *= 1099511628211ull; };
+    mix(modelId);
+    for (const auto& [batchIndex, texId] : draws) {
+        mix(batchIndex);
+        mix(texId);
+    }
+
+    auto& candidates = drawGroupIndex_[h];
+    for (size_t gi : candidates) {
+        DrawGroup& group = drawGroups_[gi];
+        if (group.modelId == modelId && group.draws == draws) {
+            group.slots.push_back(slot);
+            return;
+        }
+    }
+
+    if (drawGroupCount_ == drawGroups_.size()) {
+        drawGroups_.emplace_back();
+    }
+    DrawGroup& group = drawGroups_[drawGroupCount_];
+    group.modelId = modelId;
+    group.draws = draws;
+    group.slots.clear();
+    group.slots.push_back(slot);
+    candidates.push_back(drawGroupCount_++);
+}
+
+void CharacterRenderer::drawGroups(GLint slotsLoc, GLint alphaTestLoc) {
+    glActiveTexture(GL_TEXTURE5);
+    glBindTexture(GL_TEXTURE_BUFFER, paletteTexture_);
+    glActiveTexture(GL_TEXTURE6);
+    glBindTexture(GL_TEXTURE_BUFFER, instanceDataTexture_);
+    glActiveTexture(GL_TEXTURE0);
+
+    uint32_t drawCalls = 0;
+    for (size_t g = 0; g < drawGroupCount_; g++) {
+        const DrawGroup& group = drawGroups_[g];
+        auto modelIt = models.find(group.modelId);
+        if (modelIt == models.end()) continue;
+        const auto& gpuModel = modelIt->second;
+        glBindVertexArray(gpuModel.vao);
+
+        for (size_t first = 0; first < group.slots.size(); first += MAX_INSTANCES_PER_DRAW) {
+            GLsizei count = static_cast<GLsizei>(
+                std::min(group.slots.size() - first, static_cast<size_t>(MAX_INSTANCES_PER_DRAW)));
+            glUniform1iv(slotsLoc, count, group.slots.data() + first);
+
+            for (const auto& [batchIndex, texId] : group.draws) {
+                if (alphaTestLoc >= 0) {
+                    glUniform1i(alphaTestLoc, (texId != 0 && texId != whiteTexture) ? 1 : 0);
+                }
+                glBindTexture(GL_TEXTURE_2D, texId);
+                if (batchIndex == WHOLE_MODEL_DRAW) {
+                    glDrawElementsInstanced(GL_TRIANGLES,
+                                            static_cast<GLsizei>(gpuModel.data.indices.size()),
+                                            GL_UNSIGNED_SHORT, 0, count);
+                } else {
+                    const auto& batch = gpuModel.data.batches[batchIndex];
+                    glDrawElementsInstanced(GL_TRIANGLES,
+                                            batch.indexCount,
+                                            GL_UNSIGNED_SHORT,
+                                            (void*)(batch.indexStart * sizeof(uint16_t)),
+                                            count);
+                }
+                drawCalls++;
+            }
+        }
+    }
+
+    lastDrawCallCount_ = drawCalls;
+    lastDrawGroupCount_ = static_cast<uint32_t>(drawGroupCount_);
+}
+
 glm::mat4 CharacterRenderer::getModelMatrix(const CharacterInstance& instance) const {
     glm::mat4 model = glm::mat4(1.0f);
 
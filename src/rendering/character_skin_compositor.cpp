@@ -0,0 +1,715 @@
+/**
+ * CharacterSkinCompositor — worker-thread character skin compositing with a
+ * persistent content-addressed cache
+ *
+ * The blending code follows the WoW CharComponentTextureSections layout
+ * (see CharacterRenderer). Cache files live in
+ * $WOWEE_SKIN_CACHE_DIR or ~/.local/share/wowee/skin_cache and are named by a
+ * 64-bit FNV-1a hash of the layer list plus the layers' source identity
+ * (AssetManager::getSourceIdentity); the full key is stored in the file
+ * header and compared on load so hash collisions fall back to compositing.
+ * Hits refresh the file's mtime, which eviction uses as the access time
+ * (atime is unreliable on noatime/relatime mounts).
+ */
+#include "rendering/character_skin_compositor.hpp"
+#include "pipeline/asset_manager.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+namespace wowee {
+namespace rendering {
+
+namespace {
+
+constexpr uint32_t kSkinCacheMagic = 0x4E4B5357;  // "WSKN"
+constexpr uint32_t kSkinCacheVersion = 2;
+
+pipeline::BLPImage makeImage(int width, int height, std::vector<uint8_t>&& pixels) {
+    pipeline::BLPImage image;
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.compression = pipeline::BLPCompression::ARGB8888;
+    image.data = std::move(pixels);
+    return image;
+}
+
+uint64_t fnv1a64(const std::string& s) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Alpha-blend overlay onto composite at (dstX, dstY)
+void blitOverlay(std::vector<uint8_t>& composite, int compW, int compH,
+                         const pipeline::BLPImage& overlay, int dstX, int dstY) {
+    for (int sy = 0; sy < overlay.height; sy++) {
+        int dy = dstY + sy;
+        if (dy < 0 || dy >= compH) continue;
+        for (int sx = 0; sx < overlay.width; sx++) {
+            int dx = dstX + sx;
+            if (dx < 0 || dx >= compW) continue;
+
+            size_t srcIdx = (static_cast<size_t>(sy) * overlay.width + sx) * 4;
+            size_t dstIdx = (static_cast<size_t>(dy) * compW + dx) * 4;
+
+            uint8_t srcA = overlay.data[srcIdx + 3];
+            if (srcA == 0) continue;
+
+            if (srcA == 255) {
+                composite[dstIdx + 0] = overlay.data[srcIdx + 0];
+                composite[dstIdx + 1] = overlay.data[srcIdx + 1];
+                composite[dstIdx + 2] = overlay.data[srcIdx + 2];
+                composite[dstIdx + 3] = 255;
+            } else {
+                float alpha = srcA / 255.0f;
+                float invAlpha = 1.0f - alpha;
+                composite[dstIdx + 0] = static_cast<uint8_t>(overlay.data[srcIdx + 0] * alpha + composite[dstIdx + 0] * invAlpha);
+                composite[dstIdx + 1] = static_cast<uint8_t>(overlay.data[srcIdx + 1] * alpha + composite[dstIdx + 1] * invAlpha);
+                composite[dstIdx + 2] = static_cast<uint8_t>(overlay.data[srcIdx + 2] * alpha + composite[dstIdx + 2] * invAlpha);
+                composite[dstIdx + 3] = std::max(composite[dstIdx + 3], srcA);
+            }
+        }
+    }
+}
+
+// Nearest-neighbor NxN scale blit of overlay onto composite at (dstX, dstY)
+void blitOverlayScaledN(std::vector<uint8_t>& composite, int compW, int compH,
+                                const pipeline::BLPImage& overlay, int dstX, int dstY, int scale) {
+    if (scale < 1) scale = 1;
+    for (int sy = 0; sy < overlay.height; sy++) {
+        for (int sx = 0; sx < overlay.width; sx++) {
+            size_t srcIdx = (static_cast<size_t>(sy) * overlay.width + sx) * 4;
+            uint8_t srcA = overlay.data[srcIdx + 3];
+            if (srcA == 0) continue;
+
+            // Write to scale×scale block of destination pixels
+            for (int dy2 = 0; dy2 < scale; dy2++) {
+                int dy = dstY + sy * scale + dy2;
+                if (dy < 0 || dy >= compH) continue;
+                for (int dx2 = 0; dx2 < scale; dx2++) {
+                    int dx = dstX + sx * scale + dx2;
+                    if (dx < 0 || dx >= compW) continue;
+
+                    size_t dstIdx = (static_cast<size_t>(dy) * compW + dx) * 4;
+                    if (srcA == 255) {
+                        composite[dstIdx + 0] = overlay.data[srcIdx + 0];
+                        composite[dstIdx + 1] = overlay.data[srcIdx + 1];
+                        composite[dstIdx + 2] = overlay.data[srcIdx + 2];
+                        composite[dstIdx + 3] = 255;
+                    } else {
+                        float alpha = srcA / 255.0f;
+                        float invAlpha = 1.0f - alpha;
+                        composite[dstIdx + 0] = static_cast<uint8_t>(overlay.data[srcIdx + 0] * alpha + composite[dstIdx + 0] * invAlpha);
+                        composite[dstIdx + 1] = static_cast<uint8_t>(overlay.data[srcIdx + 1] * alpha + composite[dstIdx + 1] * invAlpha);
+                        composite[dstIdx + 2] = static_cast<uint8_t>(overlay.data[srcIdx + 2] * alpha + composite[dstIdx + 2] * invAlpha);
+                        composite[dstIdx + 3] = std::max(composite[dstIdx + 3], srcA);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Legacy 2x wrapper
+void blitOverlayScaled2x(std::vector<uint8_t>& composite, int compW, int compH,
+                                 const pipeline::BLPImage& overlay, int dstX, int dstY) {
+    blitOverlayScaledN(composite, compW, compH, overlay, dstX, dstY, 2);
+}
+
+pipeline::BLPImage composeLayers(pipeline::AssetManager* assetManager,
+                                 const std::vector<std::string>& layerPaths) {
+    if (layerPaths.empty() || !assetManager || !assetManager->isInitialized()) {
+        return {};
+    }
+
+    // Load base layer
+    auto base = assetManager->loadTexture(layerPaths[0]);
+    if (!base.isValid()) {
+        core::Logger::getInstance().warning("Composite: failed to load base layer: ", layerPaths[0]);
+        return {};
+    }
+
+    // Copy base pixel data as our working buffer
+    std::vector<uint8_t> composite = base.data;
+    int width = base.width;
+    int height = base.height;
+
+    core::Logger::getInstance().info("Composite: base layer ", width, "x", height, " from ", layerPaths[0]);
+
+    // WoW character texture atlas regions (from WoW Model Viewer / CharComponentTextureSections)
+    // Coordinates at 256x256 base resolution:
+    // Region          X    Y    W    H
+    // Base            0    0    256  256
+    // Arm Upper       0    0    128  64
+    // Arm Lower       0    64   128  64
+    // Hand            0    128  128  32
+    // Face Upper      0    160  128  32
+    // Face Lower      0    192  128  64
+    // Torso Upper     128  0    128  64
+    // Torso Lower     128  64   128  32
+    // Pelvis Upper    128  96   128  64
+    // Pelvis Lower    128  160  128  64
+    // Foot            128  224  128  32
+
+    // Scale factor: base texture may be larger than the 256x256 reference atlas
+    int coordScale = width / 256;
+    if (coordScale < 1) coordScale = 1;
+
+    // Atlas region sizes at 256x256 base (w, h) for known regions
+    struct AtlasRegion { int x, y, w, h; };
+    static const AtlasRegion faceLowerRegion256 = {0, 192, 128, 64};
+    static const AtlasRegion faceUpperRegion256 = {0, 160, 128, 32};
+
+    // Alpha-blend each overlay onto the composite
+    for (size_t layer = 1; layer < layerPaths.size(); layer++) {
+        if (layerPaths[layer].empty()) continue;
+
+        auto overlay = assetManager->loadTexture(layerPaths[layer]);
+        if (!overlay.isValid()) {
+            core::Logger::getInstance().warning("Composite: FAILED to load overlay: ", layerPaths[layer]);
+            continue;
+        }
+
+        core::Logger::getInstance().info("Composite: overlay ", layerPaths[layer],
+            " (", overlay.width, "x", overlay.height, ")");
+
+        if (overlay.width == width && overlay.height == height) {
+            // Same size: full alpha-blend
+            blitOverlay(composite, width, height, overlay, 0, 0);
+        } else {
+            // Determine region by filename keywords
+            // Coordinates scale with base texture size (256x256 is reference)
+            int dstX = 0, dstY = 0;
+            int expectedW256 = 0, expectedH256 = 0; // Expected size at 256-base
+            std::string pathLower = layerPaths[layer];
+            for (auto& c : pathLower) c = std::tolower(c);
+
+            if (pathLower.find("faceupper") != std::string::npos) {
+                dstX = faceUpperRegion256.x; dstY = faceUpperRegion256.y;
+                expectedW256 = faceUpperRegion256.w; expectedH256 = faceUpperRegion256.h;
+            } else if (pathLower.find("facelower") != std::string::npos) {
+                dstX = faceLowerRegion256.x; dstY = faceLowerRegion256.y;
+                expectedW256 = faceLowerRegion256.w; expectedH256 = faceLowerRegion256.h;
+            } else if (pathLower.find("pelvis") != std::string::npos) {
+                dstX = 128; dstY = 96;
+                expectedW256 = 128; expectedH256 = 64;
+            } else if (pathLower.find("torso") != std::string::npos) {
+                dstX = 128; dstY = 0;
+                expectedW256 = 128; expectedH256 = 64;
+            } else if (pathLower.find("armupper") != std::string::npos) {
+                dstX = 0; dstY = 0;
+                expectedW256 = 128; expectedH256 = 64;
+            } else if (pathLower.find("armlower") != std::string::npos) {
+                dstX = 0; dstY = 64;
+                expectedW256 = 128; expectedH256 = 64;
+            } else if (pathLower.find("hand") != std::string::npos) {
+                dstX = 0; dstY = 128;
+                expectedW256 = 128; expectedH256 = 32;
+            } else if (pathLower.find("foot") != std::string::npos || pathLower.find("feet") != std::string::npos) {
+                dstX = 128; dstY = 224;
+                expectedW256 = 128; expectedH256 = 32;
+            } else if (pathLower.find("legupper") != std::string::npos || pathLower.find("leg") != std::string::npos) {
+                dstX = 128; dstY = 160;
+                expectedW256 = 128; expectedH256 = 64;
+            } else {
+                // Unknown — center placement as fallback
+                dstX = (width - overlay.width) / 2;
+                dstY = (height - overlay.height) / 2;
+                core::Logger::getInstance().info("Composite: UNKNOWN region for '",
+                    layerPaths[layer], "', centering at (", dstX, ",", dstY, ")");
+                blitOverlay(composite, width, height, overlay, dstX, dstY);
+                continue;
+            }
+
+            // Scale coordinates from 256-base to actual canvas
+            dstX *= coordScale;
+            dstY *= coordScale;
+
+            // If overlay is 256-base sized but canvas is larger, scale the overlay up
+            int expectedW = expectedW256 * coordScale;
+            int expectedH = expectedH256 * coordScale;
+            bool needsScale = (coordScale > 1 &&
+                               overlay.width == expectedW256 && overlay.height == expectedH256);
+
+            core::Logger::getInstance().info("Composite: placing '", layerPaths[layer],
+                "' (", overlay.width, "x", overlay.height,
+                ") at (", dstX, ",", dstY, ") on ", width, "x", height,
+                " expected=", expectedW, "x", expectedH,
+                needsScale ? " [SCALING]" : "");
+
+            if (needsScale) {
+                blitOverlayScaledN(composite, width, height, overlay, dstX, dstY, coordScale);
+            } else {
+                blitOverlay(composite, width, height, overlay, dstX, dstY);
+            }
+        }
+    }
+
+    // Debug: dump composite to /tmp for visual inspection
+    if (std::getenv("WOWEE_DUMP_COMPOSITE")) {
+        std::string dumpPath = "/tmp/wowee_composite_debug_" +
+            std::to_string(width) + "x" + std::to_string(height) + ".raw";
+        std::ofstream dump(dumpPath, std::ios::binary);
+        if (dump) {
+            dump.write(reinterpret_cast<const char*>(composite.data()),
+                       static_cast<std::streamsize>(composite.size()));
+            core::Logger::getInstance().info("Composite debug dump: ", dumpPath,
+                " (", width, "x", height, ", ", composite.size(), " bytes)");
+        }
+    }
+
+    core::Logger::getInstance().info("Composite texture created: ", width, "x", height, " from ", layerPaths.size(), " layers");
+    return makeImage(width, height, std::move(composite));
+}
+
+pipeline::BLPImage composeRegions(pipeline::AssetManager* assetManager,
+                                  const std::string& basePath,
+                                  const std::vector<std::string>& baseLayers,
+                                  const std::vector<std::pair<int, std::string>>& regionLayers) {
+    // Region index → pixel coordinates on the 256x256 base atlas
+    // These are scaled up by (width/256, height/256) for larger textures (512x512, 1024x1024)
+    static const int regionCoords256[][2] = {
+        {   0,   0 },  // 0 = ArmUpper
+        {   0,  64 },  // 1 = ArmLower
+        {   0, 128 },  // 2 = Hand
+        { 128,   0 },  // 3 = TorsoUpper
+        { 128,  64 },  // 4 = TorsoLower
+        { 128,  96 },  // 5 = LegUpper
+        { 128, 160 },  // 6 = LegLower
+        { 128, 224 },  // 7 = Foot
+    };
+
+    // Load base composite into CPU buffer
+    if (!assetManager || !assetManager->isInitialized()) {
+        return {};
+    }
+
+    auto base = assetManager->loadTexture(basePath);
+    if (!base.isValid()) {
+        return {};
+    }
+
+    std::vector<uint8_t> composite;
+    int width = base.width;
+    int height = base.height;
+
+
+
+    // If base texture is 256x256 (e.g., baked NPC texture), upscale to 512x512
+    // so equipment regions can be composited at correct coordinates
+    if (width == 256 && height == 256 && !regionLayers.empty()) {
+        width = 512;
+        height = 512;
+        composite.resize(width * height * 4);
+        // Simple 2x nearest-neighbor upscale
+        for (int y = 0; y < 512; y++) {
+            for (int x = 0; x < 512; x++) {
+                int srcX = x / 2;
+                int srcY = y / 2;
+                int srcIdx = (srcY * 256 + srcX) * 4;
+                int dstIdx = (y * 512 + x) * 4;
+                composite[dstIdx + 0] = base.data[srcIdx + 0];
+                composite[dstIdx + 1] = base.data[srcIdx + 1];
+                composite[dstIdx + 2] = base.data[srcIdx + 2];
+                composite[dstIdx + 3] = base.data[srcIdx + 3];
+            }
+        }
+        core::Logger::getInstance().debug("compositeWithRegions: upscaled 256x256 to 512x512");
+    } else {
+        composite = base.data;
+    }
+
+    // Blend face + underwear overlays
+    // If we upscaled from 256→512, scale coords and texels with blitOverlayScaled2x.
+    // For native 512/1024 textures, face overlays are full atlas size (hit width==width branch).
+    bool upscaled = (base.width == 256 && base.height == 256 && width == 512);
+    for (const auto& ul : baseLayers) {
+        if (ul.empty()) continue;
+        auto overlay = assetManager->loadTexture(ul);
+        if (!overlay.isValid()) continue;
+
+        if (overlay.width == width && overlay.height == height) {
+            blitOverlay(composite, width, height, overlay, 0, 0);
+        } else {
+            // WoW 256-scale atlas coordinates (from CharComponentTextureSections)
+            int dstX = 0, dstY = 0;
+            std::string pathLower = ul;
+            for (auto& c : pathLower) c = std::tolower(c);
+
+            // Scale factor from 256-base coordinates to actual canvas size
+            int coordScale = width / 256;
+            if (coordScale < 1) coordScale = 1;
+            bool useScale = true;
+
+            if (pathLower.find("faceupper") != std::string::npos) {
+                dstX = 0; dstY = 160;
+            } else if (pathLower.find("facelower") != std::string::npos) {
+                dstX = 0; dstY = 192;
+            } else if (pathLower.find("pelvis") != std::string::npos) {
+                dstX = 128; dstY = 96;
+            } else if (pathLower.find("torso") != std::string::npos) {
+                dstX = 128; dstY = 0;
+            } else if (pathLower.find("armupper") != std::string::npos) {
+                dstX = 0; dstY = 0;
+            } else if (pathLower.find("armlower") != std::string::npos) {
+                dstX = 0; dstY = 64;
+            } else if (pathLower.find("hand") != std::string::npos) {
+                dstX = 0; dstY = 128;
+            } else if (pathLower.find("foot") != std::string::npos || pathLower.find("feet") != std::string::npos) {
+                dstX = 128; dstY = 224;
+            } else if (pathLower.find("legupper") != std::string::npos || pathLower.find("leg") != std::string::npos) {
+                dstX = 128; dstY = 160;
+            } else {
+                // Fallback: center overlay on canvas (already in canvas coords)
+                dstX = (width - overlay.width) / 2;
+                dstY = (height - overlay.height) / 2;
+                useScale = false;
+            }
+
+            if (useScale) {
+                dstX *= coordScale;
+                dstY *= coordScale;
+            }
+
+            if (upscaled) {
+                // Overlay is 256-base sized, needs 2x texel scaling for 512 canvas
+                blitOverlayScaled2x(composite, width, height, overlay, dstX, dstY);
+            } else {
+                blitOverlay(composite, width, height, overlay, dstX, dstY);
+            }
+        }
+    }
+
+    // Expected region sizes on the 256x256 base atlas (scaled like coords)
+    static const int regionSizes256[][2] = {
+        { 128,  64 },  // 0 = ArmUpper
+        { 128,  64 },  // 1 = ArmLower
+        { 128,  32 },  // 2 = Hand
+        { 128,  64 },  // 3 = TorsoUpper
+        { 128,  32 },  // 4 = TorsoLower
+        { 128,  64 },  // 5 = LegUpper
+        { 128,  64 },  // 6 = LegLower
+        { 128,  32 },  // 7 = Foot
+    };
+
+    // Scale factor from 256-base to actual texture size
+    int scaleX = width / 256;
+    int scaleY = height / 256;
+    if (scaleX < 1) scaleX = 1;
+    if (scaleY < 1) scaleY = 1;
+
+    // Now blit equipment region textures at explicit coordinates
+    for (const auto& rl : regionLayers) {
+        int regionIdx = rl.first;
+        if (regionIdx < 0 || regionIdx >= 8) continue;
+
+        auto overlay = assetManager->loadTexture(rl.second);
+        if (!overlay.isValid()) {
+            core::Logger::getInstance().warning("compositeWithRegions: failed to load ", rl.second);
+            continue;
+        }
+
+        int dstX = regionCoords256[regionIdx][0] * scaleX;
+        int dstY = regionCoords256[regionIdx][1] * scaleY;
+
+        // Expected full-resolution size for this region at current atlas scale
+        int expectedW = regionSizes256[regionIdx][0] * scaleX;
+        int expectedH = regionSizes256[regionIdx][1] * scaleY;
+        if (overlay.width * 2 == expectedW && overlay.height * 2 == expectedH) {
+            blitOverlayScaled2x(composite, width, height, overlay, dstX, dstY);
+        } else {
+            blitOverlay(composite, width, height, overlay, dstX, dstY);
+        }
+
+        core::Logger::getInstance().debug("compositeWithRegions: region ", regionIdx,
+            " at (", dstX, ",", dstY, ") ", overlay.width, "x", overlay.height, " from ", rl.second);
+    }
+
+    core::Logger::getInstance().debug("compositeWithRegions: created ", width, "x", height,
+        " texture with ", regionLayers.size(), " equipment regions");
+    return makeImage(width, height, std::move(composite));
+}
+
+} // namespace
+
+std::string SkinCompositeRequest::cacheKey() const {
+    std::string key = regionMode ? "R:" : "L:";
+    key += basePath;
+    for (const auto& bl : baseLayers) { key += '|'; key += bl; }
+    key += '#';
+    for (const auto& rl : regionLayers) {
+        key += std::to_string(rl.first);
+        key += ':';
+        key += rl.second;
+        key += ',';
+    }
+    return key;
+}
+
+CharacterSkinCompositor::CharacterSkinCompositor(pipeline::AssetManager* assetManager)
+    : assetManager_(assetManager) {
+    if (const char* env = std::getenv("WOWEE_SKIN_CACHE_DIR")) {
+        cacheDirectory_ = env;
+    } else if (const char* home = std::getenv("HOME")) {
+        cacheDirectory_ = std::string(home) + "/.local/share/wowee/skin_cache";
+    } else {
+        cacheDirectory_ = "./skin_cache";
+    }
+    if (const char* env = std::getenv("WOWEE_SKIN_CACHE_MB")) {
+        diskBudgetBytes_ = std::strtoull(env, nullptr, 10) * 1024 * 1024;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory_, ec);
+    if (ec) {
+        LOG_WARNING("Skin cache directory unavailable (", cacheDirectory_, "): ", ec.message());
+        cacheDirectory_.clear();
+    }
+    enforceDiskBudget();
+
+    // Compositing is I/O + blit bound and bursts on crowded zone-in; a couple
+    // of workers keeps up without competing with terrain streaming.
+    unsigned hc = std::thread::hardware_concurrency();
+    unsigned workerCount = std::clamp(hc / 4, 1u, 3u);
+    workerRunning_.store(true);
+    workerThreads_.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; i++) {
+        workerThreads_.emplace_back(&CharacterSkinCompositor::workerLoop, this);
+    }
+    LOG_INFO("Skin compositor: ", workerCount, " workers, cache at ",
+             cacheDirectory_.empty() ? "<disabled>" : cacheDirectory_);
+}
+
+CharacterSkinCompositor::~CharacterSkinCompositor() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        workerRunning_.store(false);
+        jobQueue_.clear();
+    }
+    queueCV_.notify_all();
+    for (auto& t : workerThreads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+pipeline::BLPImage CharacterSkinCompositor::compose(const SkinCompositeRequest& request) {
+    const std::string key = diskKey(request);
+    pipeline::BLPImage image;
+    if (loadFromDisk(key, image)) {
+        return image;
+    }
+    image = composeUncached(request);
+    if (image.isValid()) {
+        storeToDisk(key, image);
+    }
+    return image;
+}
+
+CharacterSkinCompositor::Ticket CharacterSkinCompositor::submit(SkinCompositeRequest request) {
+    Ticket ticket;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        ticket = nextTicket_++;
+        jobQueue_.push_back({ticket, std::move(request)});
+        pending_.fetch_add(1);
+    }
+    queueCV_.notify_one();
+    return ticket;
+}
+
+void CharacterSkinCompositor::collectFinished(std::vector<Result>& out) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (finished_.empty()) return;
+    for (auto& r : finished_) {
+        out.push_back(std::move(r));
+    }
+    finished_.clear();
+}
+
+void CharacterSkinCompositor::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCV_.wait(lock, [this]() {
+                return !jobQueue_.empty() || !workerRunning_.load();
+            });
+            if (!workerRunning_.load()) {
+                break;
+            }
+            job = std::move(jobQueue_.front());
+            jobQueue_.pop_front();
+        }
+
+        Result result;
+        result.ticket = job.ticket;
+        result.key = job.request.cacheKey();
+        result.image = compose(job.request);
+
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        finished_.push_back(std::move(result));
+        pending_.fetch_sub(1);
+    }
+}
+
+pipeline::BLPImage CharacterSkinCompositor::composeUncached(const SkinCompositeRequest& request) {
+    if (!assetManager_ || !assetManager_->isInitialized()) {
+        return {};
+    }
+    if (request.regionMode) {
+        return composeRegions(assetManager_, request.basePath, request.baseLayers, request.regionLayers);
+    }
+    std::vector<std::string> layerPaths;
+    layerPaths.reserve(request.baseLayers.size() + 1);
+    layerPaths.push_back(request.basePath);
+    layerPaths.insert(layerPaths.end(), request.baseLayers.begin(), request.baseLayers.end());
+    return composeLayers(assetManager_, layerPaths);
+}
+
+std::string CharacterSkinCompositor::diskKey(const SkinCompositeRequest& request) const {
+    std::string key = request.cacheKey();
+    if (!assetManager_) return key;
+
+    key += '@';
+    key += assetManager_->getExpansionDataPath();
+    auto addIdentity = [&](const std::string& layerPath) {
+        key += '|';
+        key += assetManager_->getSourceIdentity(layerPath);
+    };
+    addIdentity(request.basePath);
+    for (const auto& bl : request.baseLayers) addIdentity(bl);
+    for (const auto& rl : request.regionLayers) addIdentity(rl.second);
+    return key;
+}
+
+std::string CharacterSkinCompositor::cachePathForKey(const std::string& key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.skin", static_cast<unsigned long long>(fnv1a64(key)));
+    return cacheDirectory_ + "/" + name;
+}
+
+bool CharacterSkinCompositor::loadFromDisk(const std::string& key, pipeline::BLPImage& out) const {
+    if (cacheDirectory_.empty()) return false;
+    const std::string path = cachePathForKey(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    uint32_t header[3] = {};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || header[0] != kSkinCacheMagic || header[1] != kSkinCacheVersion || header[2] != key.size()) {
+        return false;
+    }
+    std::string storedKey(header[2], '\0');
+    file.read(storedKey.data(), static_cast<std::streamsize>(storedKey.size()));
+    if (!file || storedKey != key) {
+        return false;  // Hash collision or stale file
+    }
+
+    uint32_t dims[2] = {};
+    file.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    if (!file || dims[0] == 0 || dims[1] == 0 || dims[0] > 4096 || dims[1] > 4096) {
+        return false;
+    }
+    std::vector<uint8_t> pixels(static_cast<size_t>(dims[0]) * dims[1] * 4);
+    file.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+    if (!file) {
+        return false;
+    }
+    out = makeImage(static_cast<int>(dims[0]), static_cast<int>(dims[1]), std::move(pixels));
+
+    // Mark as recently used for eviction
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void CharacterSkinCompositor::storeToDisk(const std::string& key, const pipeline::BLPImage& image) {
+    if (cacheDirectory_.empty()) return;
+    const std::string path = cachePathForKey(key);
+    // Write to a per-thread temp file and rename so concurrent workers and
+    // readers never observe a partial entry.
+    const std::string tmpPath = path + ".tmp" +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        const uint32_t header[3] = {kSkinCacheMagic, kSkinCacheVersion, static_cast<uint32_t>(key.size())};
+        const uint32_t dims[2] = {static_cast<uint32_t>(image.width), static_cast<uint32_t>(image.height)};
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(key.data(), static_cast<std::streamsize>(key.size()));
+        file.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+        file.write(reinterpret_cast<const char*>(image.data.data()), static_cast<std::streamsize>(image.data.size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+
+    const uint64_t entryBytes = 5 * sizeof(uint32_t) + key.size() + image.data.size();
+    if (diskBytes_.fetch_add(entryBytes) + entryBytes > diskBudgetBytes_) {
+        enforceDiskBudget();
+    }
+}
+
+void CharacterSkinCompositor::enforceDiskBudget() {
+    if (cacheDirectory_.empty()) return;
+    std::lock_guard<std::mutex> lock(diskMutex_);
+
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUse;
+        uint64_t bytes;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (const auto& de : std::filesystem::directory_iterator(cacheDirectory_, ec)) {
+        if (de.path().extension() != ".skin") continue;
+        std::error_code entryEc;
+        uint64_t bytes = de.file_size(entryEc);
+        auto lastUse = de.last_write_time(entryEc);
+        if (entryEc) continue;
+        entries.push_back({de.path(), lastUse, bytes});
+        total += bytes;
+    }
+
+    size_t evicted = 0;
+    if (total > diskBudgetBytes_) {
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.lastUse < b.lastUse;
+        });
+        for (const auto& e : entries) {
+            if (total <= diskBudgetBytes_) break;
+            if (std::filesystem::remove(e.path, ec)) {
+                total -= e.bytes;
+                evicted++;
+            }
+        }
+    }
+    diskBytes_.store(total);
+    if (evicted > 0) {
+        LOG_INFO("Skin cache: evicted ", evicted, " entries, ", total / (1024 * 1024), " MB of ",
+                 diskBudgetBytes_ / (1024 * 1024), " MB in use");
+    }
+}
+
+} // namespace rendering
+} // namespace wowee
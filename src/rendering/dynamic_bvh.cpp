@@ -0,0 +1,511 @@
+#include "rendering/dynamic_bvh.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace wowee {
+namespace rendering {
+
+namespace {
+
+float surfaceArea(const glm::vec3& mn, const glm::vec3& mx) {
+    glm::vec3 d = mx - mn;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+float unionArea(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax) {
+    return surfaceArea(glm::min(aMin, bMin), glm::max(aMax, bMax));
+}
+
+bool contains(const glm::vec3& outerMin, const glm::vec3& outerMax,
+              const glm::vec3& innerMin, const glm::vec3& innerMax) {
+    return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+           innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+}
+
+// LIFO of node indices. The inline part covers any tree the balancing
+// produces in practice (height ~1.44 log2 n); deeper trees spill to the heap.
+class TraversalStack {
+public:
+    void push(int32_t node) {
+        if (count_ < kInline && overflow_.empty()) {
+            inline_[count_++] = node;
+        } else {
+            overflow_.push_back(node);
+        }
+    }
+    int32_t pop() {
+        if (!overflow_.empty()) {
+            int32_t node = overflow_.back();
+            overflow_.pop_back();
+            return node;
+        }
+        return inline_[--count_];
+    }
+    bool empty() const { return count_ == 0 && overflow_.empty(); }
+
+private:
+    static constexpr int kInline = 128;
+    int32_t inline_[kInline];
+    int count_ = 0;
+    std::vector<int32_t> overflow_;
+};
+
+} // namespace
+
+DynamicBVH::DynamicBVH(float margin) : margin_(margin) {}
+
+int32_t DynamicBVH::heightOf(int32_t ref) const {
+    if (ref == NULL_NODE) return 0;
+    return isLeafRef(ref) ? 0 : nodes_[ref].height;
+}
+
+int32_t DynamicBVH::parentOf(int32_t ref) const {
+    return isLeafRef(ref) ? leaves_[leafIndex(ref)].parent : nodes_[ref].parent;
+}
+
+void DynamicBVH::setParent(int32_t ref, int32_t parent) {
+    if (isLeafRef(ref)) {
+        leaves_[leafIndex(ref)].parent = parent;
+    } else {
+        nodes_[ref].parent = parent;
+    }
+}
+
+void DynamicBVH::setSlot(int32_t node, int slot, int32_t ref, const glm::vec3& mn, const glm::vec3& mx) {
+    Node& n = nodes_[node];
+    n.child[slot] = ref;
+    n.minX[slot] = mn.x;
+    n.minY[slot] = mn.y;
+    n.minZ[slot] = mn.z;
+    n.maxX[slot] = mx.x;
+    n.maxY[slot] = mx.y;
+    n.maxZ[slot] = mx.z;
+}
+
+void DynamicBVH::slotBounds(const Node& n, int slot, glm::vec3& mn, glm::vec3& mx) const {
+    mn = glm::vec3(n.minX[slot], n.minY[slot], n.minZ[slot]);
+    mx = glm::vec3(n.maxX[slot], n.maxY[slot], n.maxZ[slot]);
+}
+
+void DynamicBVH::nodeBounds(const Node& n, glm::vec3& mn, glm::vec3& mx) const {
+    mn = glm::vec3(std::min(n.minX[0], n.minX[1]), std::min(n.minY[0], n.minY[1]), std::min(n.minZ[0], n.minZ[1]));
+    mx = glm::vec3(std::max(n.maxX[0], n.maxX[1]), std::max(n.maxY[0], n.maxY[1]), std::max(n.maxZ[0], n.maxZ[1]));
+}
+
+int32_t DynamicBVH::allocateNode() {
+    if (freeNodes_ == NULL_NODE) {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+    int32_t node = freeNodes_;
+    freeNodes_ = nodes_[node].parent;
+    nodes_[node] = Node{};
+    return node;
+}
+
+void DynamicBVH::freeNode(int32_t node) {
+    nodes_[node].parent = freeNodes_;
+    nodes_[node].height = -1;
+    freeNodes_ = node;
+}
+
+int32_t DynamicBVH::insert(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint32_t userData) {
+    int32_t leaf;
+    if (freeLeaves_ != NULL_NODE) {
+        leaf = freeLeaves_;
+        freeLeaves_ = leaves_[leaf].parent;
+    } else {
+        leaves_.emplace_back();
+        leaf = static_cast<int32_t>(leaves_.size() - 1);
+    }
+    Leaf& l = leaves_[leaf];
+    l.boundsMin = boundsMin - glm::vec3(margin_);
+    l.boundsMax = boundsMax + glm::vec3(margin_);
+    l.parent = NULL_NODE;
+    l.userData = userData;
+    l.alive = true;
+    insertLeaf(leaf);
+    leafCount_++;
+    insertsSinceBuild_++;
+    return leaf;
+}
+
+void DynamicBVH::remove(int32_t proxy) {
+    if (proxy < 0 || proxy >= static_cast<int32_t>(leaves_.size()) || !leaves_[proxy].alive) return;
+    removeLeaf(proxy);
+    leaves_[proxy].alive = false;
+    leaves_[proxy].parent = freeLeaves_;
+    freeLeaves_ = proxy;
+    leafCount_--;
+}
+
+bool DynamicBVH::update(int32_t proxy, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    if (proxy < 0 || proxy >= static_cast<int32_t>(leaves_.size()) || !leaves_[proxy].alive) return false;
+    Leaf& l = leaves_[proxy];
+    if (contains(l.boundsMin, l.boundsMax, boundsMin, boundsMax)) {
+        // Still inside; only reinsert if the fat box has become much looser
+        // than a fresh one (the instance shrank or was scaled down).
+        glm::vec3 slack = glm::vec3(4.0f * margin_);
+        if (contains(boundsMin - slack, boundsMax + slack, l.boundsMin, l.boundsMax)) {
+            return false;
+        }
+    }
+
+    removeLeaf(proxy);
+    l.boundsMin = boundsMin - glm::vec3(margin_);
+    l.boundsMax = boundsMax + glm::vec3(margin_);
+    insertLeaf(proxy);
+    insertsSinceBuild_++;
+    return true;
+}
+
+void DynamicBVH::clear() {
+    nodes_.clear();
+    leaves_.clear();
+    root_ = NULL_NODE;
+    freeNodes_ = NULL_NODE;
+    freeLeaves_ = NULL_NODE;
+    leafCount_ = 0;
+    insertsSinceBuild_ = 0;
+}
+
+void DynamicBVH::rebuild() {
+    buildItems_.clear();
+    buildItems_.reserve(leafCount_);
+    for (size_t i = 0; i < leaves_.size(); i++) {
+        const Leaf& l = leaves_[i];
+        if (!l.alive) continue;
+        buildItems_.push_back({l.boundsMin, l.boundsMax, (l.boundsMin + l.boundsMax) * 0.5f,
+                               leafRef(static_cast<int32_t>(i))});
+    }
+    nodes_.clear();
+    nodes_.reserve(buildItems_.empty() ? 0 : buildItems_.size() - 1);
+    freeNodes_ = NULL_NODE;
+    root_ = NULL_NODE;
+    insertsSinceBuild_ = 0;
+    if (buildItems_.empty()) return;
+
+    glm::vec3 mn, mx;
+    root_ = buildRange(0, buildItems_.size(), 0, mn, mx);
+    setParent(root_, NULL_NODE);
+}
+
+bool DynamicBVH::rebuildIfStale() {
+    if (insertsSinceBuild_ < 64 || insertsSinceBuild_ * 4 < leafCount_) return false;
+    rebuild();
+    return true;
+}
+
+int32_t DynamicBVH::buildRange(size_t begin, size_t end, int depth, glm::vec3& outMin, glm::vec3& outMax) {
+    if (end - begin == 1) {
+        outMin = buildItems_[begin].boundsMin;
+        outMax = buildItems_[begin].boundsMax;
+        return buildItems_[begin].ref;
+    }
+
+    auto first = buildItems_.begin() + static_cast<ptrdiff_t>(begin);
+    auto last = buildItems_.begin() + static_cast<ptrdiff_t>(end);
+    glm::vec3 cMin = first->centroid, cMax = first->centroid;
+    for (auto it = first + 1; it != last; ++it) {
+        cMin = glm::min(cMin, it->centroid);
+        cMax = glm::max(cMax, it->centroid);
+    }
+    glm::vec3 extent = cMax - cMin;
+    int axis = (extent.x > extent.y) ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+    // Binned SAH split along the widest centroid axis; median split for
+    // small ranges, when the bins cannot separate the range, or when the
+    // recursion is getting deep.
+    size_t mid = begin;
+    constexpr int kBins = 16;
+    constexpr size_t kMinSahItems = 16;
+    if (end - begin > kMinSahItems && extent[axis] > 0.0f && depth < 48) {
+        struct Bin {
+            glm::vec3 mn = glm::vec3(1e30f);
+            glm::vec3 mx = glm::vec3(-1e30f);
+            uint32_t count = 0;
+        };
+        Bin bins[kBins];
+        const float scale = kBins / extent[axis];
+        auto binOf = [&](const BuildItem& item) {
+            int b = static_cast<int>((item.centroid[axis] - cMin[axis]) * scale);
+            return std::min(b, kBins - 1);
+        };
+        for (auto it = first; it != last; ++it) {
+            Bin& b = bins[binOf(*it)];
+            b.mn = glm::min(b.mn, it->boundsMin);
+            b.mx = glm::max(b.mx, it->boundsMax);
+            b.count++;
+        }
+
+        float rightArea[kBins];
+        uint32_t rightCount[kBins];
+        glm::vec3 mn(1e30f), mx(-1e30f);
+        uint32_t count = 0;
+        for (int b = kBins - 1; b > 0; b--) {
+            mn = glm::min(mn, bins[b].mn);
+            mx = glm::max(mx, bins[b].mx);
+            count += bins[b].count;
+            rightArea[b] = count ? surfaceArea(mn, mx) : 0.0f;
+            rightCount[b] = count;
+        }
+        float bestCost = 1e30f;
+        int bestSplit = -1;
+        mn = glm::vec3(1e30f);
+        mx = glm::vec3(-1e30f);
+        count = 0;
+        for (int b = 0; b < kBins - 1; b++) {
+            mn = glm::min(mn, bins[b].mn);
+            mx = glm::max(mx, bins[b].mx);
+            count += bins[b].count;
+            if (count == 0 || rightCount[b + 1] == 0) continue;
+            float cost = surfaceArea(mn, mx) * count + rightArea[b + 1] * rightCount[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+        if (bestSplit >= 0) {
+            auto it = std::partition(first, last, [&](const BuildItem& item) { return binOf(item) <= bestSplit; });
+            mid = static_cast<size_t>(it - buildItems_.begin());
+        }
+    }
+    if (mid == begin || mid == end) {
+        mid = begin + (end - begin) / 2;
+        std::nth_element(first, buildItems_.begin() + static_cast<ptrdiff_t>(mid), last,
+                         [axis](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+    }
+
+    // Allocate before recursing so nodes come out in depth-first order
+    const int32_t node = allocateNode();
+    glm::vec3 leftMin, leftMax, rightMin, rightMax;
+    const int32_t left = buildRange(begin, mid, depth + 1, leftMin, leftMax);
+    const int32_t right = buildRange(mid, end, depth + 1, rightMin, rightMax);
+    setSlot(node, 0, left, leftMin, leftMax);
+    setSlot(node, 1, right, rightMin, rightMax);
+    setParent(left, node);
+    setParent(right, node);
+    nodes_[node].height = 1 + std::max(heightOf(left), heightOf(right));
+    outMin = glm::min(leftMin, rightMin);
+    outMax = glm::max(leftMax, rightMax);
+    return node;
+}
+
+void DynamicBVH::insertLeaf(int32_t leaf) {
+    const int32_t ref = leafRef(leaf);
+    const glm::vec3 leafMin = leaves_[leaf].boundsMin;
+    const glm::vec3 leafMax = leaves_[leaf].boundsMax;
+    if (root_ == NULL_NODE) {
+        root_ = ref;
+        leaves_[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Walk down choosing the child whose enlargement costs least, stopping
+    // where pairing with the current node is cheaper than descending. A
+    // node's own box lives in its parent's slot, so carry it along.
+    int32_t index = root_;
+    glm::vec3 curMin, curMax;
+    if (isLeafRef(index)) {
+        curMin = leaves_[leafIndex(index)].boundsMin;
+        curMax = leaves_[leafIndex(index)].boundsMax;
+    } else {
+        nodeBounds(nodes_[index], curMin, curMax);
+    }
+    while (!isLeafRef(index)) {
+        const Node& node = nodes_[index];
+        float area = surfaceArea(curMin, curMax);
+        float combinedArea = unionArea(curMin, curMax, leafMin, leafMax);
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCost[2];
+        glm::vec3 childMin[2], childMax[2];
+        for (int k = 0; k < 2; k++) {
+            slotBounds(node, k, childMin[k], childMax[k]);
+            float grown = unionArea(childMin[k], childMax[k], leafMin, leafMax);
+            childCost[k] = isLeafRef(node.child[k])
+                ? grown + inheritanceCost
+                : grown - surfaceArea(childMin[k], childMax[k]) + inheritanceCost;
+        }
+
+        if (cost < childCost[0] && cost < childCost[1]) break;
+        int k = (childCost[0] < childCost[1]) ? 0 : 1;
+        index = node.child[k];
+        curMin = childMin[k];
+        curMax = childMax[k];
+    }
+
+    const int32_t sibling = index;
+    const int32_t oldParent = parentOf(sibling);
+    const int32_t newParent = allocateNode();
+    nodes_[newParent].parent = oldParent;
+    nodes_[newParent].height = heightOf(sibling) + 1;
+    setSlot(newParent, 0, sibling, curMin, curMax);
+    setSlot(newParent, 1, ref, leafMin, leafMax);
+    setParent(sibling, newParent);
+    setParent(ref, newParent);
+
+    if (oldParent != NULL_NODE) {
+        Node& p = nodes_[oldParent];
+        p.child[p.child[0] == sibling ? 0 : 1] = newParent;
+    } else {
+        root_ = newParent;
+    }
+
+    refitUpwards(newParent);
+}
+
+void DynamicBVH::removeLeaf(int32_t leaf) {
+    const int32_t ref = leafRef(leaf);
+    if (root_ == ref) {
+        root_ = NULL_NODE;
+        return;
+    }
+
+    const int32_t parent = leaves_[leaf].parent;
+    const Node& p = nodes_[parent];
+    const int keepSlot = (p.child[0] == ref) ? 1 : 0;
+    const int32_t sibling = p.child[keepSlot];
+    const int32_t grandParent = p.parent;
+
+    if (grandParent != NULL_NODE) {
+        glm::vec3 mn, mx;
+        slotBounds(p, keepSlot, mn, mx);
+        Node& g = nodes_[grandParent];
+        setSlot(grandParent, g.child[0] == parent ? 0 : 1, sibling, mn, mx);
+        setParent(sibling, grandParent);
+        freeNode(parent);
+        refitUpwards(grandParent);
+    } else {
+        root_ = sibling;
+        setParent(sibling, NULL_NODE);
+        freeNode(parent);
+    }
+}
+
+void DynamicBVH::refitUpwards(int32_t index) {
+    while (index != NULL_NODE) {
+        index = balance(index);
+        Node& n = nodes_[index];
+        n.height = 1 + std::max(heightOf(n.child[0]), heightOf(n.child[1]));
+        const int32_t parent = n.parent;
+        if (parent != NULL_NODE) {
+            glm::vec3 mn, mx;
+            nodeBounds(n, mn, mx);
+            setSlot(parent, nodes_[parent].child[0] == index ? 0 : 1, index, mn, mx);
+        }
+        index = parent;
+    }
+}
+
+int32_t DynamicBVH::balance(int32_t iA) {
+    Node& A = nodes_[iA];
+    if (A.height < 2) return iA;
+
+    const int32_t diff = heightOf(A.child[1]) - heightOf(A.child[0]);
+    if (diff >= -1 && diff <= 1) return iA;
+
+    // Rotate the taller child up into A's place. It keeps its taller child
+    // and hands the shorter one to A, in the slot it vacated.
+    const int upSlot = (diff > 1) ? 1 : 0;
+    const int otherSlot = 1 - upSlot;
+    const int32_t iUp = A.child[upSlot];
+    Node& up = nodes_[iUp];
+
+    const int keepSlot = (heightOf(up.child[0]) > heightOf(up.child[1])) ? 0 : 1;
+    const int giveSlot = 1 - keepSlot;
+    const int32_t keep = up.child[keepSlot];
+    const int32_t give = up.child[giveSlot];
+    glm::vec3 keepMin, keepMax, giveMin, giveMax;
+    slotBounds(up, keepSlot, keepMin, keepMax);
+    slotBounds(up, giveSlot, giveMin, giveMax);
+
+    up.parent = A.parent;
+    A.parent = iUp;
+    if (up.parent != NULL_NODE) {
+        Node& p = nodes_[up.parent];
+        p.child[p.child[0] == iA ? 0 : 1] = iUp;
+    } else {
+        root_ = iUp;
+    }
+
+    setSlot(iA, upSlot, give, giveMin, giveMax);
+    setParent(give, iA);
+    A.height = 1 + std::max(heightOf(A.child[otherSlot]), heightOf(give));
+
+    glm::vec3 aMin, aMax;
+    nodeBounds(A, aMin, aMax);
+    setSlot(iUp, 0, iA, aMin, aMax);
+    setSlot(iUp, 1, keep, keepMin, keepMax);
+    up.height = 1 + std::max(A.height, heightOf(keep));
+    return iUp;
+}
+
+template <typename Overlap>
+void DynamicBVH::query(const Overlap& overlaps, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (root_ == NULL_NODE) return;
+    if (isLeafRef(root_)) {
+        const Leaf& l = leaves_[leafIndex(root_)];
+        if (overlaps(l.boundsMin.x, l.boundsMin.y, l.boundsMin.z, l.boundsMax.x, l.boundsMax.y, l.boundsMax.z)) {
+            out.push_back(l.userData);
+        }
+        return;
+    }
+
+    TraversalStack stack;
+    stack.push(root_);
+    while (!stack.empty()) {
+        const Node& n = nodes_[stack.pop()];
+        for (int k = 0; k < 2; k++) {
+            if (!overlaps(n.minX[k], n.minY[k], n.minZ[k], n.maxX[k], n.maxY[k], n.maxZ[k])) continue;
+            const int32_t child = n.child[k];
+            if (isLeafRef(child)) {
+                out.push_back(leaves_[leafIndex(child)].userData);
+            } else {
+                stack.push(child);
+            }
+        }
+    }
+}
+
+void DynamicBVH::queryAABB(const glm::vec3& queryMin, const glm::vec3& queryMax,
+                           std::vector<uint32_t>& out) const {
+    query([&](float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+        return minX <= queryMax.x && maxX >= queryMin.x &&
+               minY <= queryMax.y && maxY >= queryMin.y &&
+               minZ <= queryMax.z && maxZ >= queryMin.z;
+    }, out);
+}
+
+void DynamicBVH::querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const {
+    const float radiusSq = radius * radius;
+    query([&](float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+        float dx = std::max(std::max(minX - center.x, center.x - maxX), 0.0f);
+        float dy = std::max(std::max(minY - center.y, center.y - maxY), 0.0f);
+        float dz = std::max(std::max(minZ - center.z, center.z - maxZ), 0.0f);
+        return dx * dx + dy * dy + dz * dz <= radiusSq;
+    }, out);
+}
+
+void DynamicBVH::queryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                          std::vector<uint32_t>& out) const {
+    // Slab test. Zero direction components get a huge finite reciprocal so
+    // (bound - origin) * inv never produces 0 * inf.
+    glm::vec3 inv;
+    for (int i = 0; i < 3; i++) {
+        inv[i] = (direction[i] != 0.0f) ? 1.0f / direction[i] : std::copysign(1e30f, direction[i]);
+    }
+    query([&](float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+        float tx0 = (minX - origin.x) * inv.x, tx1 = (maxX - origin.x) * inv.x;
+        float ty0 = (minY - origin.y) * inv.y, ty1 = (maxY - origin.y) * inv.y;
+        float tz0 = (minZ - origin.z) * inv.z, tz1 = (maxZ - origin.z) * inv.z;
+        float enter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+        float exit = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+        return enter <= exit;
+    }, out);
+}
+
+} // namespace rendering
+} // namespace wowee
@@ -0,0 +1,314 @@
+#include "rendering/frame_graph.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace wowee {
+namespace rendering {
+
+FrameGraph::FrameGraph() = default;
+
+FrameGraph::~FrameGraph() {
+    shutdown();
+}
+
+void FrameGraph::beginFrame() {
+    // Return last frame's transients to the pool
+    for (auto& pooled : texturePool_) {
+        pooled.inUse = false;
+    }
+    resources_.clear();
+    passes_.clear();
+    transientCount_ = 0;
+    compiled_ = false;
+    frameIndex_++;
+}
+
+FrameGraph::ResourceId FrameGraph::importResource(const std::string& name, GLuint texture) {
+    Resource res;
+    res.name = name;
+    res.texture = texture;
+    resources_.push_back(std::move(res));
+    return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+FrameGraph::ResourceId FrameGraph::createTexture(const std::string& name, const TextureDesc& desc) {
+    Resource res;
+    res.name = name;
+    res.transient = true;
+    res.desc = desc;
+    resources_.push_back(std::move(res));
+    transientCount_++;
+    return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+void FrameGraph::addPass(const std::string& name,
+                         std::vector<ResourceId> reads,
+                         std::vector<ResourceId> writes,
+                         std::function<void()> execute,
+                         uint64_t inputVersion) {
+    Pass pass;
+    pass.name = name;
+    pass.reads = std::move(reads);
+    pass.writes = std::move(writes);
+    pass.execute = std::move(execute);
+    pass.inputVersion = inputVersion;
+    passes_.push_back(std::move(pass));
+}
+
+void FrameGraph::markOutput(ResourceId resource) {
+    if (resource < resources_.size()) {
+        resources_[resource].output = true;
+    }
+}
+
+void FrameGraph::compile() {
+    // Reference counts: passes by their writes, resources by their readers
+    for (auto& res : resources_) {
+        res.refCount = res.output ? 1 : 0;
+    }
+    for (auto& pass : passes_) {
+        pass.refCount = static_cast<int>(pass.writes.size());
+        pass.culled = false;
+        for (ResourceId r : pass.reads) {
+            if (r < resources_.size()) resources_[r].refCount++;
+        }
+    }
+
+    // Flood-fill from unreferenced resources back through their producers
+    std::vector<ResourceId> unreferenced;
+    for (ResourceId r = 0; r < resources_.size(); r++) {
+        if (resources_[r].refCount == 0) unreferenced.push_back(r);
+    }
+    while (!unreferenced.empty()) {
+        ResourceId r = unreferenced.back();
+        unreferenced.pop_back();
+        for (auto& pass : passes_) {
+            if (pass.culled) continue;
+            bool writes = false;
+            for (ResourceId w : pass.writes) {
+                if (w == r) { writes = true; break; }
+            }
+            if (!writes || --pass.refCount > 0) continue;
+            pass.culled = true;
+            for (ResourceId read : pass.reads) {
+                if (read < resources_.size() && --resources_[read].refCount == 0) {
+                    unreferenced.push_back(read);
+                }
+            }
+        }
+    }
+    // Passes without declared writes have no observable effect
+    for (auto& pass : passes_) {
+        if (pass.writes.empty()) pass.culled = true;
+    }
+
+    // Skip versioned passes whose inputs are unchanged. Their outputs must
+    // persist between frames (imported) and have no other writer, and every
+    // resource they read must itself be unchanged (produced only by skipped
+    // passes), so walking in declaration order propagates changes downstream.
+    std::vector<bool> changed(resources_.size(), false);
+    for (auto& pass : passes_) {
+        pass.skipped = false;
+        if (pass.culled) continue;
+        bool canSkip = pass.inputVersion != 0;
+        if (canSkip) {
+            auto it = executedVersions_.find(pass.name);
+            canSkip = it != executedVersions_.end() && it->second == pass.inputVersion;
+        }
+        for (ResourceId r : pass.reads) {
+            if (!canSkip) break;
+            if (r < resources_.size() && (changed[r] || resources_[r].transient)) canSkip = false;
+        }
+        for (ResourceId w : pass.writes) {
+            if (!canSkip) break;
+            if (w >= resources_.size() || resources_[w].transient) { canSkip = false; break; }
+            for (const auto& other : passes_) {
+                if (&other == &pass || other.culled) continue;
+                if (std::find(other.writes.begin(), other.writes.end(), w) != other.writes.end()) {
+                    canSkip = false;
+                    break;
+                }
+            }
+        }
+        pass.skipped = canSkip;
+        if (!canSkip) {
+            for (ResourceId w : pass.writes) {
+                if (w < resources_.size()) changed[w] = true;
+            }
+        }
+    }
+
+    // Transient lifetimes over surviving passes
+    for (int p = 0; p < static_cast<int>(passes_.size()); p++) {
+        const Pass& pass = passes_[p];
+        if (pass.culled) continue;
+        auto touch = [&](ResourceId r) {
+            if (r >= resources_.size()) return;
+            Resource& res = resources_[r];
+            if (res.firstPass < 0) res.firstPass = p;
+            res.lastPass = p;
+        };
+        for (ResourceId r : pass.reads) touch(r);
+        for (ResourceId r : pass.writes) touch(r);
+    }
+
+    // Walk passes in order, acquiring transients at first use and returning
+    // them to the pool after last use so later transients can alias them.
+    for (int p = 0; p < static_cast<int>(passes_.size()); p++) {
+        if (passes_[p].culled) continue;
+        for (auto& res : resources_) {
+            if (res.transient && res.firstPass == p) {
+                res.physical = acquirePooledTexture(res.desc);
+                res.texture = texturePool_[res.physical].texture;
+            }
+        }
+        for (auto& res : resources_) {
+            if (res.transient && res.lastPass == p && res.physical >= 0) {
+                texturePool_[res.physical].inUse = false;
+            }
+        }
+    }
+
+    // Evict pooled textures that no longer match any declared transient
+    for (size_t i = 0; i < texturePool_.size();) {
+        auto& pooled = texturePool_[i];
+        if (frameIndex_ - pooled.lastUsedFrame > POOL_EVICT_FRAMES) {
+            glDeleteTextures(1, &pooled.texture);
+            // Swap-remove; fix up the resource that referenced the moved slot
+            size_t last = texturePool_.size() - 1;
+            if (i != last) {
+                texturePool_[i] = texturePool_[last];
+                for (auto& res : resources_) {
+                    if (res.physical == static_cast<int>(last)) res.physical = static_cast<int>(i);
+                }
+            }
+            texturePool_.pop_back();
+            continue;
+        }
+        i++;
+    }
+
+    compiled_ = true;
+}
+
+int FrameGraph::acquirePooledTexture(const TextureDesc& desc) {
+    for (size_t i = 0; i < texturePool_.size(); i++) {
+        auto& pooled = texturePool_[i];
+        if (!pooled.inUse && pooled.desc == desc) {
+            pooled.inUse = true;
+            pooled.lastUsedFrame = frameIndex_;
+            return static_cast<int>(i);
+        }
+    }
+
+    PooledTexture pooled;
+    pooled.desc = desc;
+    pooled.inUse = true;
+    pooled.lastUsedFrame = frameIndex_;
+    glGenTextures(1, &pooled.texture);
+    glBindTexture(GL_TEXTURE_2D, pooled.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, desc.internalFormat, desc.width, desc.height, 0,
+                 desc.format, desc.type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    texturePool_.push_back(pooled);
+    LOG_DEBUG("FrameGraph: allocated transient texture ", desc.width, "x", desc.height,
+              " (pool size ", texturePool_.size(), ")");
+    return static_cast<int>(texturePool_.size() - 1);
+}
+
+FrameGraph::PassTimer& FrameGraph::timerFor(const std::string& name) {
+    auto it = timers_.find(name);
+    if (it != timers_.end()) return it->second;
+    PassTimer& timer = timers_[name];
+    glGenQueries(QUERY_LATENCY, timer.queries);
+    return timer;
+}
+
+void FrameGraph::execute() {
+    if (!compiled_) compile();
+
+    const int slot = static_cast<int>(frameIndex_ % QUERY_LATENCY);
+    passTimings_.clear();
+    passTimings_.reserve(passes_.size());
+    totalGpuMs_ = 0.0;
+
+    for (auto& pass : passes_) {
+        PassTiming timing;
+        timing.name = pass.name;
+        timing.culled = pass.culled;
+        timing.skipped = pass.skipped;
+        if (pass.culled || pass.skipped) {
+            passTimings_.push_back(std::move(timing));
+            continue;
+        }
+
+        PassTimer& timer = timerFor(pass.name);
+        // Collect the result issued QUERY_LATENCY frames ago before reusing the query
+        if (timer.pending[slot]) {
+            GLint available = 0;
+            glGetQueryObjectiv(timer.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(timer.queries[slot], GL_QUERY_RESULT, &ns);
+                timer.gpuMs = static_cast<double>(ns) / 1.0e6;
+            }
+            timer.pending[slot] = false;
+        }
+
+        auto cpuStart = std::chrono::steady_clock::now();
+        glBeginQuery(GL_TIME_ELAPSED, timer.queries[slot]);
+        pass.execute();
+        glEndQuery(GL_TIME_ELAPSED);
+        if (pass.inputVersion != 0) {
+            executedVersions_[pass.name] = pass.inputVersion;
+        } else {
+            executedVersions_.erase(pass.name);
+        }
+        timer.pending[slot] = true;
+        auto cpuEnd = std::chrono::steady_clock::now();
+
+        timing.cpuMs = std::chrono::duration<double, std::milli>(cpuEnd - cpuStart).count();
+        timing.gpuMs = timer.gpuMs;
+        totalGpuMs_ += timer.gpuMs;
+        passTimings_.push_back(std::move(timing));
+    }
+}
+
+GLuint FrameGraph::getTexture(ResourceId resource) const {
+    if (resource >= resources_.size()) return 0;
+    return resources_[resource].texture;
+}
+
+void FrameGraph::releaseTransients() {
+    for (auto& pooled : texturePool_) {
+        if (pooled.texture) glDeleteTextures(1, &pooled.texture);
+    }
+    texturePool_.clear();
+    for (auto& res : resources_) {
+        if (res.transient) {
+            res.physical = -1;
+            res.texture = 0;
+        }
+    }
+    compiled_ = false;
+}
+
+void FrameGraph::shutdown() {
+    releaseTransients();
+    for (auto& [name, timer] : timers_) {
+        glDeleteQueries(QUERY_LATENCY, timer.queries);
+    }
+    timers_.clear();
+    executedVersions_.clear();
+    resources_.clear();
+    passes_.clear();
+    passTimings_.clear();
+}
+
+} // namespace rendering
+} // namespace wowee
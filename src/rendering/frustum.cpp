@@ -1,9 +1,179 @@
 #include "rendering/frustum.hpp"
 #include <algorithm>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define WOWEE_FRUSTUM_SSE 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define WOWEE_FRUSTUM_AVX2 1
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
 namespace wowee {
 namespace rendering {
 
+namespace {
+
+// Inputs shared by the scalar and SIMD sphere kernels
+struct SphereBatch {
+    const float* x;
+    const float* y;
+    const float* z;
+    const float* radius;
+    const float* rangeScale;
+    glm::vec3 eye;
+    float rangeSq;
+    float rangeCapSq;
+    uint32_t* outIndices;
+    float* outDistSq;
+};
+
+// Same arithmetic order as intersectsSphere() and the SIMD kernels, so all
+// paths keep exactly the same spheres
+size_t cullSpheresScalar(const std::array<Plane, 6>& planes, const SphereBatch& b,
+                         size_t begin, size_t end, size_t kept) {
+    for (size_t i = begin; i < end; i++) {
+        float dx = b.x[i] - b.eye.x;
+        float dy = b.y[i] - b.eye.y;
+        float dz = b.z[i] - b.eye.z;
+        float distSq = dx * dx + dy * dy + dz * dz;
+        if (!(distSq <= std::min(b.rangeScale[i] * b.rangeSq, b.rangeCapSq))) continue;
+
+        bool visible = true;
+        for (const auto& plane : planes) {
+            float d = plane.normal.x * b.x[i] + plane.normal.y * b.y[i] + plane.normal.z * b.z[i] +
+                      plane.distance;
+            if (d < -b.radius[i]) {
+                visible = false;
+                break;
+            }
+        }
+        if (!visible) continue;
+        b.outIndices[kept] = static_cast<uint32_t>(i);
+        b.outDistSq[kept] = distSq;
+        kept++;
+    }
+    return kept;
+}
+
+#if defined(WOWEE_FRUSTUM_SSE)
+inline int lowestSetBit(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+size_t cullSpheresSSE(const std::array<Plane, 6>& planes, const SphereBatch& b, size_t count) {
+    const __m128 ex = _mm_set1_ps(b.eye.x);
+    const __m128 ey = _mm_set1_ps(b.eye.y);
+    const __m128 ez = _mm_set1_ps(b.eye.z);
+    const __m128 rangeSq = _mm_set1_ps(b.rangeSq);
+    const __m128 rangeCapSq = _mm_set1_ps(b.rangeCapSq);
+    __m128 nx[6], ny[6], nz[6], nd[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = _mm_set1_ps(planes[p].normal.x);
+        ny[p] = _mm_set1_ps(planes[p].normal.y);
+        nz[p] = _mm_set1_ps(planes[p].normal.z);
+        nd[p] = _mm_set1_ps(planes[p].distance);
+    }
+
+    size_t kept = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(b.x + i);
+        __m128 y = _mm_loadu_ps(b.y + i);
+        __m128 z = _mm_loadu_ps(b.z + i);
+        __m128 dx = _mm_sub_ps(x, ex);
+        __m128 dy = _mm_sub_ps(y, ey);
+        __m128 dz = _mm_sub_ps(z, ez);
+        __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 limit = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(b.rangeScale + i), rangeSq), rangeCapSq);
+        __m128 visible = _mm_cmple_ps(distSq, limit);
+
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(b.radius + i));
+        for (int p = 0; p < 6; p++) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], x), _mm_mul_ps(ny[p], y)),
+                                             _mm_mul_ps(nz[p], z)), nd[p]);
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(d, negRadius));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(visible));
+        if (!mask) continue;
+        alignas(16) float dist[4];
+        _mm_store_ps(dist, distSq);
+        while (mask) {
+            int lane = lowestSetBit(mask);
+            b.outIndices[kept] = static_cast<uint32_t>(i + lane);
+            b.outDistSq[kept] = dist[lane];
+            kept++;
+            mask &= mask - 1;
+        }
+    }
+    return cullSpheresScalar(planes, b, i, count, kept);
+}
+#endif
+
+#if defined(WOWEE_FRUSTUM_AVX2)
+__attribute__((target("avx2")))
+size_t cullSpheresAVX2(const std::array<Plane, 6>& planes, const SphereBatch& b, size_t count) {
+    const __m256 ex = _mm256_set1_ps(b.eye.x);
+    const __m256 ey = _mm256_set1_ps(b.eye.y);
+    const __m256 ez = _mm256_set1_ps(b.eye.z);
+    const __m256 rangeSq = _mm256_set1_ps(b.rangeSq);
+    const __m256 rangeCapSq = _mm256_set1_ps(b.rangeCapSq);
+    __m256 nx[6], ny[6], nz[6], nd[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = _mm256_set1_ps(planes[p].normal.x);
+        ny[p] = _mm256_set1_ps(planes[p].normal.y);
+        nz[p] = _mm256_set1_ps(planes[p].normal.z);
+        nd[p] = _mm256_set1_ps(planes[p].distance);
+    }
+
+    size_t kept = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(b.x + i);
+        __m256 y = _mm256_loadu_ps(b.y + i);
+        __m256 z = _mm256_loadu_ps(b.z + i);
+        __m256 dx = _mm256_sub_ps(x, ex);
+        __m256 dy = _mm256_sub_ps(y, ey);
+        __m256 dz = _mm256_sub_ps(z, ez);
+        __m256 distSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                      _mm256_mul_ps(dz, dz));
+        __m256 limit = _mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(b.rangeScale + i), rangeSq), rangeCapSq);
+        __m256 visible = _mm256_cmp_ps(distSq, limit, _CMP_LE_OQ);
+
+        __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(b.radius + i));
+        for (int p = 0; p < 6; p++) {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[p], x), _mm256_mul_ps(ny[p], y)),
+                                                   _mm256_mul_ps(nz[p], z)), nd[p]);
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(d, negRadius, _CMP_GE_OQ));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(visible));
+        if (!mask) continue;
+        alignas(32) float dist[8];
+        _mm256_store_ps(dist, distSq);
+        while (mask) {
+            int lane = lowestSetBit(mask);
+            b.outIndices[kept] = static_cast<uint32_t>(i + lane);
+            b.outDistSq[kept] = dist[lane];
+            kept++;
+            mask &= mask - 1;
+        }
+    }
+    return cullSpheresScalar(planes, b, i, count, kept);
+}
+#endif
+
+} // namespace
+
 void Frustum::extractFromMatrix(const glm::mat4& vp) {
     // Extract planes from view-projection matrix
     // Based on Gribb & Hartmann method (Fast Extraction of Viewing Frustum Planes)
@@ -102,5 +272,24 @@ bool Frustum::intersectsAABB(const glm::vec3& min, const glm::vec3& max) const {
     return true;
 }
 
+size_t Frustum::cullSpheres(const float* centerX, const float* centerY, const float* centerZ,
+                            const float* radius, const float* rangeScale, size_t count,
+                            const glm::vec3& eye, float rangeSq, float rangeCapSq,
+                            uint32_t* outIndices, float* outDistSq) const {
+    SphereBatch batch{centerX, centerY, centerZ, radius, rangeScale, eye, rangeSq, rangeCapSq,
+                      outIndices, outDistSq};
+#if defined(WOWEE_FRUSTUM_AVX2)
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        return cullSpheresAVX2(planes, batch, count);
+    }
+#endif
+#if defined(WOWEE_FRUSTUM_SSE)
+    return cullSpheresSSE(planes, batch, count);
+#else
+    return cullSpheresScalar(planes, batch, 0, count, 0);
+#endif
+}
+
 } // namespace rendering
 } // namespace wowee
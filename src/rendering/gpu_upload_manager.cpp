@@ -0,0 +1,265 @@
+#include "rendering/gpu_upload_manager.hpp"
+#include "core/logger.hpp"
+#include "core/metrics.hpp"
+#include <cstring>
+
+namespace wowee {
+namespace rendering {
+
+namespace {
+
+// Small uploads aren't worth a copy command; neither are ones that would
+// monopolize the ring.
+constexpr size_t MIN_STAGED_BYTES = 4096;
+constexpr size_t RING_ALIGNMENT = 256;
+
+size_t alignUp(size_t v, size_t a) {
+    return (v + a - 1) & ~(a - 1);
+}
+
+size_t bytesPerPixel(GLenum format) {
+    switch (format) {
+        case GL_RGBA:
+        case GL_BGRA: return 4;
+        case GL_RGB:
+        case GL_BGR: return 3;
+        case GL_RG: return 2;
+        case GL_RED: return 1;
+        default: return 0;
+    }
+}
+
+} // namespace
+
+GpuUploadManager& GpuUploadManager::getInstance() {
+    static GpuUploadManager instance;
+    return instance;
+}
+
+bool GpuUploadManager::initialize(size_t ringBytes) {
+    if (ringBuffer_) return true;
+
+    if (!GLEW_ARB_buffer_storage) {
+        LOG_INFO("GPU uploads: ARB_buffer_storage unavailable, uploading directly");
+        return true;
+    }
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &ringBuffer_);
+    glBindBuffer(GL_COPY_READ_BUFFER, ringBuffer_);
+    glBufferStorage(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(ringBytes), nullptr, flags);
+    ringPtr_ = static_cast<uint8_t*>(
+        glMapBufferRange(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(ringBytes), flags));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    if (!ringPtr_) {
+        LOG_WARNING("GPU uploads: failed to map staging ring, uploading directly");
+        glDeleteBuffers(1, &ringBuffer_);
+        ringBuffer_ = 0;
+        return true;
+    }
+
+    ringSize_ = ringBytes;
+    head_ = 0;
+    used_ = 0;
+    currentRegion_ = 0;
+    LOG_INFO("GPU uploads: ", ringBytes / (1024 * 1024), " MB persistent staging ring");
+    return true;
+}
+
+void GpuUploadManager::shutdown() {
+    for (auto& region : regions_) {
+        if (region.fence) glDeleteSync(region.fence);
+    }
+    regions_.clear();
+
+    if (ringBuffer_) {
+        glBindBuffer(GL_COPY_READ_BUFFER, ringBuffer_);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &ringBuffer_);
+        ringBuffer_ = 0;
+    }
+    ringPtr_ = nullptr;
+    ringSize_ = 0;
+    head_ = used_ = currentRegion_ = 0;
+}
+
+void GpuUploadManager::endFrame() {
+    static auto& frameBytesGauge = core::Metrics::getInstance().gauge(
+        "wowee_gpu_upload_frame_bytes", "Bytes uploaded to the GPU in the last frame");
+    static auto& frameMsGauge = core::Metrics::getInstance().gauge(
+        "wowee_gpu_upload_frame_ms", "Main-thread time spent in GPU uploads in the last frame");
+    frameBytesGauge.set(static_cast<double>(frameBytes_));
+    frameMsGauge.set(frameUploadMs_);
+
+    if (currentRegion_ > 0) fenceCurrentRegion();
+    reclaim();
+
+    frameBytes_ = 0;
+    frameUploadMs_ = 0.0f;
+    frameUploads_ = 0;
+}
+
+bool GpuUploadManager::hasBudget(UploadPriority priority) const {
+    if (frameUploads_ == 0) return true;
+    const float scale = (priority == UploadPriority::HIGH) ? 2.0f : 1.0f;
+    return frameBytes_ < static_cast<size_t>(budgetBytes_ * scale) &&
+           frameUploadMs_ < budgetMs_ * scale;
+}
+
+void GpuUploadManager::bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) {
+    if (!data || bytes == 0) {
+        glBufferData(target, static_cast<GLsizeiptr>(bytes), data, usage);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t offset = 0;
+    if (bytes >= MIN_STAGED_BYTES && allocate(bytes, offset)) {
+        glBufferData(target, static_cast<GLsizeiptr>(bytes), nullptr, usage);
+        std::memcpy(ringPtr_ + offset, data, bytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, ringBuffer_);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, target, static_cast<GLintptr>(offset), 0,
+                            static_cast<GLsizeiptr>(bytes));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    } else {
+        glBufferData(target, static_cast<GLsizeiptr>(bytes), data, usage);
+    }
+    account(bytes, start);
+}
+
+void GpuUploadManager::texImage2D(GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                  GLenum format, const void* pixels) {
+    const size_t bpp = bytesPerPixel(format);
+    if (!pixels || bpp == 0 || width <= 0 || height <= 0) {
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    // Copy exactly what GL will read: rows padded to the current unpack
+    // alignment, except the last one. Custom row lengths go direct.
+    GLint alignment = 4, rowLength = 0;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+    const size_t packedRow = static_cast<size_t>(width) * bpp;
+    const size_t rowStride = alignUp(packedRow, static_cast<size_t>(alignment > 0 ? alignment : 1));
+    const size_t bytes = rowStride * static_cast<size_t>(height - 1) + packedRow;
+    size_t offset = 0;
+    if (rowLength == 0 && bytes >= MIN_STAGED_BYTES && allocate(bytes, offset)) {
+        std::memcpy(ringPtr_ + offset, pixels, bytes);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ringBuffer_);
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE,
+                     reinterpret_cast<const void*>(offset));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    }
+    account(bytes, start);
+}
+
+void GpuUploadManager::compressedTexImage2D(GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                            GLsizei imageSize, const void* data) {
+    if (!data || imageSize <= 0) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, imageSize, data);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    // Compressed blocks are tightly packed: imageSize is exactly what GL reads
+    const size_t bytes = static_cast<size_t>(imageSize);
+    size_t offset = 0;
+    if (bytes >= MIN_STAGED_BYTES && allocate(bytes, offset)) {
+        std::memcpy(ringPtr_ + offset, data, bytes);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ringBuffer_);
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, imageSize,
+                               reinterpret_cast<const void*>(offset));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, imageSize, data);
+    }
+    account(bytes, start);
+}
+
+bool GpuUploadManager::allocate(size_t bytes, size_t& offset) {
+    if (!ringPtr_) return false;
+
+    const size_t size = alignUp(bytes, RING_ALIGNMENT);
+    if (size > ringSize_ / 4) return false;
+
+    // Regions are released oldest first, so free space is always the
+    // contiguous span after head_; skipping the tail end to wrap holds it
+    // until the current region is fenced and retired.
+    auto fits = [&]() {
+        size_t padding = (head_ + size > ringSize_) ? ringSize_ - head_ : 0;
+        return used_ + padding + size <= ringSize_;
+    };
+    if (!fits()) {
+        reclaim();
+        if (!fits()) return false;
+    }
+
+    if (head_ + size > ringSize_) {
+        size_t padding = ringSize_ - head_;
+        used_ += padding;
+        currentRegion_ += padding;
+        head_ = 0;
+    }
+    offset = head_;
+    head_ += size;
+    used_ += size;
+    currentRegion_ += size;
+
+    // Loading screens upload many tiles without ending a frame; fence as we
+    // go so the ring recycles there too.
+    if (currentRegion_ >= ringSize_ / 4) fenceCurrentRegion();
+    return true;
+}
+
+void GpuUploadManager::fenceCurrentRegion() {
+    Region region;
+    region.bytes = currentRegion_;
+    region.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    regions_.push_back(region);
+    currentRegion_ = 0;
+}
+
+void GpuUploadManager::reclaim() {
+    while (!regions_.empty()) {
+        Region& region = regions_.front();
+        if (region.fence) {
+            GLenum status = glClientWaitSync(region.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+            glDeleteSync(region.fence);
+        }
+        used_ -= region.bytes;
+        regions_.pop_front();
+    }
+}
+
+void GpuUploadManager::account(size_t bytes, std::chrono::steady_clock::time_point start) {
+    static auto& uploadBytes = core::Metrics::getInstance().counter(
+        "wowee_gpu_upload_bytes_total", "Bytes of geometry and texture data uploaded to the GPU");
+    uploadBytes.add(bytes);
+    frameBytes_ += bytes;
+    frameUploadMs_ += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    frameUploads_++;
+}
+
+void uploadBufferData(GLenum target, size_t bytes, const void* data, GLenum usage) {
+    GpuUploadManager::getInstance().bufferData(target, bytes, data, usage);
+}
+
+void uploadTexImage2D(GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                      GLenum format, const void* pixels) {
+    GpuUploadManager::getInstance().texImage2D(level, internalFormat, width, height, format, pixels);
+}
+
+void uploadCompressedTexImage2D(GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                GLsizei imageSize, const void* data) {
+    GpuUploadManager::getInstance().compressedTexImage2D(level, internalFormat, width, height, imageSize, data);
+}
+
+} // namespace rendering
+} // namespace wowee
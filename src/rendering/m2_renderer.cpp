@@ -1,11 +1,13 @@
 #include "rendering/m2_renderer.hpp"
 #include "rendering/texture.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/camera.hpp"
 #include "rendering/frustum.hpp"
 #include "pipeline/asset_manager.hpp"
 #include "pipeline/blp_loader.hpp"
 #include "core/logger.hpp"
+#include "core/metrics.hpp"
 #include <chrono>
 #include <cctype>
 #include <glm/gtc/matrix_transform.hpp>
@@ -27,6 +29,23 @@ namespace {
 static constexpr uint32_t kParticleFlagRandomized = 0x40;
 static constexpr uint32_t kParticleFlagTiled = 0x80;
 
+// Animation LOD: projected-size thresholds (world radius / distance) for LOD
+// 1..3 and the pose time quantum sampled at each level. LOD 0 is evaluated
+// per instance every frame.
+static constexpr float kAnimLodScreenSize[3] = {0.06f, 0.025f, 0.01f};
+static constexpr float kAnimLodQuantumMs[4] = {0.0f, 33.0f, 66.0f, 133.0f};
+static constexpr uint8_t kAnimLodMax = 3;
+
+uint8_t selectAnimLod(float worldRadius, float distSq) {
+    if (worldRadius <= 0.0f) return 0;
+    float dist = std::sqrt(distSq);
+    if (dist <= worldRadius) return 0;
+    float screenSize = worldRadius / dist;
+    uint8_t lod = 0;
+    while (lod < kAnimLodMax && screenSize < kAnimLodScreenSize[lod]) lod++;
+    return lod;
+}
+
 void getTightCollisionBounds(const M2ModelGPU& model, glm::vec3& outMin, glm::vec3& outMax) {
     glm::vec3 center = (model.boundMin + model.boundMax) * 0.5f;
     glm::vec3 half = (model.boundMax - model.boundMin) * 0.5f;
@@ -655,8 +674,12 @@ void M2Renderer::shutdown() {
     }
     models.clear();
     instances.clear();
-    spatialGrid.clear();
+    collisionTree_.clear();
+    shadowCasterVersion_++;
     instanceIndexById.clear();
+    cullCells_.clear();
+    cullCellIndex_.clear();
+    cullSlots_.clear();
 
     // Delete cached textures
     for (auto& [path, entry] : textureCache) {
@@ -1053,14 +1076,14 @@ bool M2Renderer::loadModel(const pipeline::M2Model& model, uint32_t modelId) {
 
     glGenBuffers(1, &gpuModel.vbo);
     glBindBuffer(GL_ARRAY_BUFFER, gpuModel.vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float),
-                 vertexData.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float),
+                     vertexData.data(), GL_STATIC_DRAW);
 
     // Create EBO
     glGenBuffers(1, &gpuModel.ebo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuModel.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, model.indices.size() * sizeof(uint16_t),
-                 model.indices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, model.indices.size() * sizeof(uint16_t),
+                     model.indices.data(), GL_STATIC_DRAW);
 
     // Set up vertex attributes
     const size_t stride = floatsPerVertex * sizeof(float);
@@ -1290,15 +1313,10 @@ uint32_t M2Renderer::createInstance(uint32_t modelId, const glm::vec3& position,
     instances.push_back(instance);
     size_t idx = instances.size() - 1;
     instanceIndexById[instance.id] = idx;
-    GridCell minCell = toCell(instance.worldBoundsMin);
-    GridCell maxCell = toCell(instance.worldBoundsMax);
-    for (int z = minCell.z; z <= maxCell.z; z++) {
-        for (int y = minCell.y; y <= maxCell.y; y++) {
-            for (int x = minCell.x; x <= maxCell.x; x++) {
-                spatialGrid[GridCell{x, y, z}].push_back(instance.id);
-            }
-        }
-    }
+    cullInsert(static_cast<uint32_t>(idx));
+    instances[idx].bvhProxy = collisionTree_.insert(instance.worldBoundsMin, instance.worldBoundsMax,
+                                                    static_cast<uint32_t>(idx));
+    shadowCasterVersion_++;
 
     return instance.id;
 }
@@ -1346,15 +1364,10 @@ uint32_t M2Renderer::createInstanceWithMatrix(uint32_t modelId, const glm::mat4&
     instances.push_back(instance);
     size_t idx = instances.size() - 1;
     instanceIndexById[instance.id] = idx;
-    GridCell minCell = toCell(instance.worldBoundsMin);
-    GridCell maxCell = toCell(instance.worldBoundsMax);
-    for (int z = minCell.z; z <= maxCell.z; z++) {
-        for (int y = minCell.y; y <= maxCell.y; y++) {
-            for (int x = minCell.x; x <= maxCell.x; x++) {
-                spatialGrid[GridCell{x, y, z}].push_back(instance.id);
-            }
-        }
-    }
+    cullInsert(static_cast<uint32_t>(idx));
+    instances[idx].bvhProxy = collisionTree_.insert(instance.worldBoundsMin, instance.worldBoundsMax,
+                                                    static_cast<uint32_t>(idx));
+    shadowCasterVersion_++;
 
     return instance.id;
 }
@@ -1415,69 +1428,99 @@ static glm::vec3 interpVec3(const pipeline::M2AnimationTrack& track,
     return safe(glm::mix(keys.vec3Values[i0], keys.vec3Values[i1], frac));
 }
 
-static glm::quat interpQuat(const pipeline::M2AnimationTrack& track,
-                              int seqIdx, float time,
-                              const std::vector<uint32_t>& globalSeqDurations) {
-    glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
-    if (!track.hasData()) return identity;
-    int si; float t;
-    resolveTrackTime(track, seqIdx, time, globalSeqDurations, si, t);
-    if (si < 0 || si >= static_cast<int>(track.sequences.size())) return identity;
-    const auto& keys = track.sequences[si];
-    if (keys.timestamps.empty() || keys.quatValues.empty()) return identity;
-    auto safe = [&](const glm::quat& q) -> glm::quat {
-        float len = glm::length(q);
-        if (len < 0.001f || std::isnan(len)) return identity;
-        return q;
-    };
-    if (keys.quatValues.size() == 1) return safe(keys.quatValues[0]);
-    int idx = findKeyframeIndex(keys.timestamps, t);
-    if (idx < 0) return identity;
-    size_t i0 = static_cast<size_t>(idx);
-    size_t i1 = std::min(i0 + 1, keys.quatValues.size() - 1);
-    if (i0 == i1) return safe(keys.quatValues[i0]);
-    float t0 = static_cast<float>(keys.timestamps[i0]);
-    float t1 = static_cast<float>(keys.timestamps[i1]);
-    float dur = t1 - t0;
-    float frac = (dur > 0.0f) ? glm::clamp((t - t0) / dur, 0.0f, 1.0f) : 0.0f;
-    return glm::slerp(safe(keys.quatValues[i0]), safe(keys.quatValues[i1]), frac);
-}
-
 static void computeBoneMatrices(const M2ModelGPU& model, M2Instance& instance) {
     size_t numBones = std::min(model.bones.size(), size_t(128));
     if (numBones == 0) return;
-    instance.boneMatrices.resize(numBones);
-    const auto& gsd = model.globalSequenceDurations;
-
-    for (size_t i = 0; i < numBones; i++) {
-        const auto& bone = model.bones[i];
-        glm::vec3 trans = interpVec3(bone.translation, instance.currentSequenceIndex, instance.animTime, glm::vec3(0.0f), gsd);
-        glm::quat rot = interpQuat(bone.rotation, instance.currentSequenceIndex, instance.animTime, gsd);
-        glm::vec3 scl = interpVec3(bone.scale, instance.currentSequenceIndex, instance.animTime, glm::vec3(1.0f), gsd);
-
-        // Sanity check scale to avoid degenerate matrices
-        if (scl.x < 0.001f) scl.x = 1.0f;
-        if (scl.y < 0.001f) scl.y = 1.0f;
-        if (scl.z < 0.001f) scl.z = 1.0f;
-
-        glm::mat4 local = glm::translate(glm::mat4(1.0f), bone.pivot);
-        local = glm::translate(local, trans);
-        local *= glm::toMat4(rot);
-        local = glm::scale(local, scl);
-        local = glm::translate(local, -bone.pivot);
-
-        if (bone.parentBone >= 0 && static_cast<size_t>(bone.parentBone) < numBones) {
-            instance.boneMatrices[i] = instance.boneMatrices[bone.parentBone] * local;
+    BoneEvalOptions options;
+    options.globalSequenceDurations = &model.globalSequenceDurations;
+    options.fixDegenerateScale = true;  // Sanity check scale to avoid degenerate matrices
+    evaluateBonePalette(model.bones, numBones, instance.currentSequenceIndex, instance.animTime,
+                        options, instance.animCursor, instance.boneMatrices);
+}
+
+template <typename Fn>
+void M2Renderer::runAnimJobs(size_t count, Fn&& job) {
+    if (count == 0) return;
+    if (count < 6 || numAnimThreads_ <= 1) {
+        // Sequential — not enough work to justify thread overhead
+        for (size_t j = 0; j < count; ++j) job(j);
+        return;
+    }
+
+    // Parallel — dispatch across worker threads
+    const size_t numThreads = std::min(static_cast<size_t>(numAnimThreads_), count);
+    const size_t chunkSize = count / numThreads;
+    const size_t remainder = count % numThreads;
+
+    // Reuse persistent futures vector to avoid allocation
+    animFutures_.clear();
+    if (animFutures_.capacity() < numThreads) {
+        animFutures_.reserve(numThreads);
+    }
+
+    size_t start = 0;
+    for (size_t t = 0; t < numThreads; ++t) {
+        size_t end = start + chunkSize + (t < remainder ? 1 : 0);
+        animFutures_.push_back(std::async(std::launch::async,
+            [&job, start, end]() {
+                for (size_t j = start; j < end; ++j) job(j);
+            }));
+        start = end;
+    }
+
+    for (auto& f : animFutures_) {
+        f.get();
+    }
+}
+
+uint32_t M2Renderer::acquireSharedPose(uint32_t modelId, int32_t sequence, uint32_t lod,
+                                       uint32_t bucket, float timeMs) {
+    SharedPoseKey key{modelId, sequence, lod, bucket};
+    auto it = sharedPoseIndex_.find(key);
+    if (it != sharedPoseIndex_.end()) {
+        sharedPoses_[it->second].lastUsedFrame = animFrameCounter_;
+        return it->second;
+    }
+
+    uint32_t slot;
+    if (!freeSharedPoseSlots_.empty()) {
+        slot = freeSharedPoseSlots_.back();
+        freeSharedPoseSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(sharedPoses_.size());
+        sharedPoses_.emplace_back();
+    }
+    SharedPose& pose = sharedPoses_[slot];
+    if (pose.modelId != modelId) {
+        pose.cursor.reset();
+    }
+    pose.modelId = modelId;
+    pose.sequence = sequence;
+    pose.timeMs = timeMs;
+    pose.lastUsedFrame = animFrameCounter_;
+    sharedPoseIndex_.emplace(key, slot);
+    poseEvalSlots_.push_back(slot);
+    return slot;
+}
+
+void M2Renderer::releaseStaleSharedPoses() {
+    // Poses not referenced this frame have no instance pointing at them
+    // (culled instances detach in update), so their slots can be recycled.
+    for (auto it = sharedPoseIndex_.begin(); it != sharedPoseIndex_.end(); ) {
+        SharedPose& pose = sharedPoses_[it->second];
+        if (pose.lastUsedFrame != animFrameCounter_) {
+            freeSharedPoseSlots_.push_back(it->second);
+            it = sharedPoseIndex_.erase(it);
         } else {
-            instance.boneMatrices[i] = local;
+            ++it;
         }
     }
 }
 
 void M2Renderer::update(float deltaTime, const glm::vec3& cameraPos, const glm::mat4& viewProjection) {
-    if (spatialIndexDirty_) {
-        rebuildSpatialIndex();
-    }
+    // Tile streaming inserts instances one at a time; re-bulk-build the
+    // collision tree once enough of it was grown incrementally.
+    collisionTree_.rebuildIfStale();
 
     float dtMs = deltaTime * 1000.0f;
 
@@ -1561,6 +1604,10 @@ void M2Renderer::update(float deltaTime, const glm::vec3& cameraPos, const glm::
     if (boneWorkIndices_.capacity() < instances.size()) {
         boneWorkIndices_.reserve(instances.size());
     }
+    poseEvalSlots_.clear();
+    poseBlendWork_.clear();
+    animFrameCounter_++;
+    uint32_t lodInstanceCount = 0;
 
     for (size_t idx = 0; idx < instances.size(); ++idx) {
         auto& instance = instances[idx];
@@ -1642,59 +1689,83 @@ void M2Renderer::update(float deltaTime, const glm::vec3& cameraPos, const glm::
         if (model.disableAnimation) {
             effectiveMaxDistSq *= 2.6f;
         }
-        if (distSq > effectiveMaxDistSq) continue;
         float paddedRadius = std::max(cullRadius * 1.5f, cullRadius + 3.0f);
-        if (cullRadius > 0.0f && !updateFrustum.intersectsSphere(instance.position, paddedRadius)) continue;
-
-        boneWorkIndices_.push_back(idx);
-    }
-
-    // Phase 2: Compute bone matrices (expensive, parallel if enough work)
-    const size_t animCount = boneWorkIndices_.size();
-    if (animCount > 0) {
-        if (animCount < 6 || numAnimThreads_ <= 1) {
-            // Sequential — not enough work to justify thread overhead
-            for (size_t i : boneWorkIndices_) {
-                if (i >= instances.size()) continue;
-                auto& inst = instances[i];
-                auto mdlIt = models.find(inst.modelId);
-                if (mdlIt == models.end()) continue;
-                computeBoneMatrices(mdlIt->second, inst);
-            }
-        } else {
-            // Parallel — dispatch across worker threads
-            const size_t numThreads = std::min(static_cast<size_t>(numAnimThreads_), animCount);
-            const size_t chunkSize = animCount / numThreads;
-            const size_t remainder = animCount % numThreads;
-
-            // Reuse persistent futures vector to avoid allocation
-            animFutures_.clear();
-            if (animFutures_.capacity() < numThreads) {
-                animFutures_.reserve(numThreads);
+        if (distSq > effectiveMaxDistSq ||
+            (cullRadius > 0.0f && !updateFrustum.intersectsSphere(instance.position, paddedRadius))) {
+            // Keep the last shared pose as this instance's own palette; the
+            // shared slot may be recycled while the instance is culled.
+            if (instance.sharedPoseSlot >= 0) {
+                instance.boneMatrices = sharedPoses_[instance.sharedPoseSlot].bones;
+                instance.sharedPoseSlot = -1;
             }
+            continue;
+        }
 
-            size_t start = 0;
-            for (size_t t = 0; t < numThreads; ++t) {
-                size_t end = start + chunkSize + (t < remainder ? 1 : 0);
-                animFutures_.push_back(std::async(std::launch::async,
-                    [this, start, end]() {
-                        for (size_t j = start; j < end; ++j) {
-                            size_t idx = boneWorkIndices_[j];
-                            if (idx >= instances.size()) continue;
-                            auto& inst = instances[idx];
-                            auto mdlIt = models.find(inst.modelId);
-                            if (mdlIt == models.end()) continue;
-                            computeBoneMatrices(mdlIt->second, inst);
-                        }
-                    }));
-                start = end;
-            }
+        instance.animLodLevel = selectAnimLod(worldRadius, distSq);
+        if (instance.animLodLevel == 0) {
+            instance.sharedPoseSlot = -1;
+            boneWorkIndices_.push_back(idx);
+            continue;
+        }
 
-            for (auto& f : animFutures_) {
-                f.get();
-            }
+        // Reduced-rate LOD: sample shared poses at quantized times.
+        lodInstanceCount++;
+        const uint32_t lod = instance.animLodLevel;
+        const float quantum = kAnimLodQuantumMs[lod];
+        const uint32_t bucket = static_cast<uint32_t>(std::max(0.0f, instance.animTime) / quantum);
+        const float bucketStart = static_cast<float>(bucket) * quantum;
+        uint32_t slotA = acquireSharedPose(instance.modelId, instance.currentSequenceIndex,
+                                           lod, bucket, bucketStart);
+        if (lod == kAnimLodMax) {
+            instance.sharedPoseSlot = static_cast<int32_t>(slotA);
+            continue;
         }
-    }
+        uint32_t slotB = acquireSharedPose(instance.modelId, instance.currentSequenceIndex,
+                                           lod, bucket + 1, bucketStart + quantum);
+        float blend = glm::clamp((instance.animTime - bucketStart) / quantum, 0.0f, 1.0f);
+        instance.sharedPoseSlot = -1;
+        poseBlendWork_.push_back({idx, slotA, slotB, blend});
+    }
+
+    // Phase 2: Compute bone matrices (expensive, parallel if enough work).
+    // Full-rate instances and newly referenced shared poses are independent.
+    runAnimJobs(boneWorkIndices_.size(), [this](size_t j) {
+        size_t idx = boneWorkIndices_[j];
+        if (idx >= instances.size()) return;
+        auto& inst = instances[idx];
+        auto mdlIt = models.find(inst.modelId);
+        if (mdlIt == models.end()) return;
+        computeBoneMatrices(mdlIt->second, inst);
+    });
+    runAnimJobs(poseEvalSlots_.size(), [this](size_t j) {
+        SharedPose& pose = sharedPoses_[poseEvalSlots_[j]];
+        auto mdlIt = models.find(pose.modelId);
+        if (mdlIt == models.end()) return;
+        const M2ModelGPU& model = mdlIt->second;
+        BoneEvalOptions options;
+        options.globalSequenceDurations = &model.globalSequenceDurations;
+        options.fixDegenerateScale = true;
+        evaluateBonePalette(model.bones, std::min(model.bones.size(), size_t(128)),
+                            pose.sequence, pose.timeMs, options, pose.cursor, pose.bones);
+    });
+    // LOD 1-2: interpolate between the two bracketing shared poses.
+    runAnimJobs(poseBlendWork_.size(), [this](size_t j) {
+        const PoseBlendWork& w = poseBlendWork_[j];
+        const auto& a = sharedPoses_[w.slotA].bones;
+        const auto& b = sharedPoses_[w.slotB].bones;
+        auto& out = instances[w.instanceIndex].boneMatrices;
+        size_t n = std::min(a.size(), b.size());
+        out.resize(n);
+        const float wa = 1.0f - w.blend;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = a[i] * wa + b[i] * w.blend;
+        }
+    });
+    releaseStaleSharedPoses();
+
+    lastAnimEvaluatedCount_ = static_cast<uint32_t>(boneWorkIndices_.size() + poseEvalSlots_.size());
+    lastAnimSharedPoseCount_ = static_cast<uint32_t>(sharedPoseIndex_.size());
+    lastAnimLodInstanceCount_ = lodInstanceCount;
 
     // Phase 3: Particle update (sequential — uses RNG, not thread-safe)
     // Run for ALL nearby instances with particle emitters, not just those in
@@ -1783,37 +1854,33 @@ void M2Renderer::render(const Camera& camera, const glm::mat4& view, const glm::
     // Early distance rejection: max possible render distance (tight but safe upper bound)
     const float maxPossibleDistSq = maxRenderDistance * maxRenderDistance * 4.0f;  // 2x safety margin (reduced from 4x)
 
-    for (uint32_t i = 0; i < static_cast<uint32_t>(instances.size()); ++i) {
-        const auto& instance = instances[i];
-
-        // Fast early rejection: skip instances that are definitely too far
-        glm::vec3 toCam = instance.position - camPos;
-        float distSq = glm::dot(toCam, toCam);
-        if (distSq > maxPossibleDistSq) continue;  // Early out before model lookup
-
-        auto it = models.find(instance.modelId);
-        if (it == models.end()) continue;
-        const M2ModelGPU& model = it->second;
-        if (!model.isValid() || model.isSmoke || model.isInvisibleTrap) continue;
-        float worldRadius = model.boundRadius * instance.scale;
-        float cullRadius = worldRadius;
-        if (model.disableAnimation) {
-            cullRadius = std::max(cullRadius, 3.0f);
-        }
-        float effectiveMaxDistSq = maxRenderDistanceSq * std::max(1.0f, cullRadius / 12.0f);
-        if (model.disableAnimation) {
-            effectiveMaxDistSq *= 2.6f;
+    // Cell-level rejection first (range to the cell bounds, then frustum),
+    // then the cell's packed instance bounds are tested in SIMD batches
+    for (const CullCell& cell : cullCells_) {
+        const size_t count = cell.instanceIndex.size();
+        if (count == 0) continue;
+        const float cellRangeSq = std::min(cell.maxRangeScale * maxRenderDistanceSq, maxPossibleDistSq);
+        const glm::vec3 nearest(std::clamp(camPos.x, cell.boundsMin.x, cell.boundsMax.x),
+                                std::clamp(camPos.y, cell.boundsMin.y, cell.boundsMax.y),
+                                std::clamp(camPos.z, cell.boundsMin.z, cell.boundsMax.z));
+        const glm::vec3 toCell = nearest - camPos;
+        if (glm::dot(toCell, toCell) > cellRangeSq) continue;
+        if (!frustum.intersectsAABB(cell.boundsMin, cell.boundsMax)) continue;
+
+        if (cullKeptScratch_.size() < count) {
+            cullKeptScratch_.resize(count);
+            cullDistScratch_.resize(count);
+        }
+        const size_t kept = frustum.cullSpheres(cell.centerX.data(), cell.centerY.data(), cell.centerZ.data(),
+                                                cell.radius.data(), cell.rangeScale.data(), count,
+                                                camPos, maxRenderDistanceSq, maxPossibleDistSq,
+                                                cullKeptScratch_.data(), cullDistScratch_.data());
+        for (size_t k = 0; k < kept; k++) {
+            const uint32_t slot = cullKeptScratch_[k];
+            const uint32_t index = cell.instanceIndex[slot];
+            sortedVisible_.push_back({index, instances[index].modelId, cullDistScratch_[k],
+                                      maxRenderDistanceSq * cell.rangeScale[slot]});
         }
-        // Removed aggressive small-object distance caps to prevent city pop-out
-        // Small props (barrels, lanterns, etc.) now use same distance as larger objects
-        if (distSq > effectiveMaxDistSq) continue;
-
-        // Frustum cull with moderate padding to prevent edge pop-out during camera rotation
-        // Reduced from 2.5x to 1.5x for better performance
-        float paddedRadius = std::max(cullRadius * 1.5f, cullRadius + 3.0f);
-        if (cullRadius > 0.0f && !frustum.intersectsSphere(instance.position, paddedRadius)) continue;
-
-        sortedVisible_.push_back({i, instance.modelId, distSq, effectiveMaxDistSq});
     }
 
     // Sort by modelId to minimize VAO rebinds (using stable_sort for better cache behavior)
@@ -1894,14 +1961,15 @@ void M2Renderer::render(const Camera& camera, const glm::mat4& view, const glm::
         }
 
         // Upload bone matrices if model has skeletal animation
-        bool useBones = model.hasAnimation && !model.disableAnimation && !instance.boneMatrices.empty();
+        const auto& palette = bonePalette(instance);
+        bool useBones = model.hasAnimation && !model.disableAnimation && !palette.empty();
         if (useBones != lastUseBones) {
             shader->setUniform("uUseBones", useBones);
             lastUseBones = useBones;
         }
         if (useBones) {
-            int numBones = std::min(static_cast<int>(instance.boneMatrices.size()), 128);
-            shader->setUniformMatrixArray("uBones[0]", instance.boneMatrices.data(), numBones);
+            int numBones = std::min(static_cast<int>(palette.size()), 128);
+            shader->setUniformMatrixArray("uBones[0]", palette.data(), numBones);
             boneMatrixUploads++;
         }
 
@@ -2147,6 +2215,19 @@ void M2Renderer::render(const Camera& camera, const glm::mat4& view, const glm::
     double totalMs = std::chrono::duration<double, std::milli>(renderEndTime - renderStartTime).count();
     double drawLoopMs = std::chrono::duration<double, std::milli>(renderEndTime - cullingSortTime).count();
 
+    static auto& cullHist = core::Metrics::getInstance().histogram(
+        "wowee_cull_seconds", "Visibility culling + sort time per pass", "renderer=\"m2\"");
+    static auto& drawHist = core::Metrics::getInstance().histogram(
+        "wowee_draw_submit_seconds", "Draw submission time per pass", "renderer=\"m2\"");
+    static auto& drawCalls = core::Metrics::getInstance().counter(
+        "wowee_draw_calls_total", "Draw calls issued", "renderer=\"m2\"");
+    static auto& visibleGauge = core::Metrics::getInstance().gauge(
+        "wowee_visible_instances", "Instances that passed culling last frame", "renderer=\"m2\"");
+    cullHist.observe(cullingSortMs / 1000.0);
+    drawHist.observe(drawLoopMs / 1000.0);
+    drawCalls.add(lastDrawCallCount);
+    visibleGauge.set(static_cast<double>(sortedVisible_.size()));
+
     // Log detailed timing every 120 frames (~2 seconds at 60fps)
     static int frameCounter = 0;
     if (++frameCounter >= 120) {
@@ -2303,8 +2384,9 @@ void M2Renderer::emitParticles(M2Instance& inst, const M2ModelGPU& gpu, float dt
             // Position: emitter position transformed by bone matrix
             glm::vec3 localPos = em.position;
             glm::mat4 boneXform = glm::mat4(1.0f);
-            if (em.bone < inst.boneMatrices.size()) {
-                boneXform = inst.boneMatrices[em.bone];
+            const auto& palette = bonePalette(inst);
+            if (em.bone < palette.size()) {
+                boneXform = palette[em.bone];
             }
             glm::vec3 worldPos = glm::vec3(inst.modelMatrix * boneXform * glm::vec4(localPos, 1.0f));
             p.position = worldPos;
@@ -2624,7 +2706,9 @@ void M2Renderer::setInstancePosition(uint32_t instanceId, const glm::vec3& posit
         getTightCollisionBounds(modelIt->second, localMin, localMax);
         transformAABB(inst.modelMatrix, localMin, localMax, inst.worldBoundsMin, inst.worldBoundsMax);
     }
-    spatialIndexDirty_ = true;
+    cullUpdate(static_cast<uint32_t>(idxIt->second));
+    collisionTree_.update(inst.bvhProxy, inst.worldBoundsMin, inst.worldBoundsMax);
+    shadowCasterVersion_++;
 }
 
 void M2Renderer::setInstanceTransform(uint32_t instanceId, const glm::mat4& transform) {
@@ -2646,14 +2730,19 @@ void M2Renderer::setInstanceTransform(uint32_t instanceId, const glm::mat4& tran
         getTightCollisionBounds(modelIt->second, localMin, localMax);
         transformAABB(inst.modelMatrix, localMin, localMax, inst.worldBoundsMin, inst.worldBoundsMax);
     }
-    spatialIndexDirty_ = true;
+    cullUpdate(static_cast<uint32_t>(idxIt->second));
+    collisionTree_.update(inst.bvhProxy, inst.worldBoundsMin, inst.worldBoundsMax);
+    shadowCasterVersion_++;
 }
 
 void M2Renderer::removeInstance(uint32_t instanceId) {
     for (auto it = instances.begin(); it != instances.end(); ++it) {
         if (it->id == instanceId) {
+            collisionTree_.remove(it->bvhProxy);
             instances.erase(it);
-            rebuildSpatialIndex();
+            rebuildInstanceIndex();
+            rebuildCullCells();
+            shadowCasterVersion_++;
             return;
         }
     }
@@ -2667,13 +2756,17 @@ void M2Renderer::removeInstances(const std::vector<uint32_t>& instanceIds) {
     std::unordered_set<uint32_t> toRemove(instanceIds.begin(), instanceIds.end());
     const size_t oldSize = instances.size();
     instances.erase(std::remove_if(instances.begin(), instances.end(),
-                   [&toRemove](const M2Instance& inst) {
-                       return toRemove.find(inst.id) != toRemove.end();
+                   [this, &toRemove](const M2Instance& inst) {
+                       if (toRemove.find(inst.id) == toRemove.end()) return false;
+                       collisionTree_.remove(inst.bvhProxy);
+                       return true;
                    }),
                    instances.end());
 
     if (instances.size() != oldSize) {
-        rebuildSpatialIndex();
+        rebuildInstanceIndex();
+        rebuildCullCells();
+        shadowCasterVersion_++;
     }
 }
 
@@ -2685,10 +2778,17 @@ void M2Renderer::clear() {
     }
     models.clear();
     instances.clear();
-    spatialGrid.clear();
+    collisionTree_.clear();
+    shadowCasterVersion_++;
     instanceIndexById.clear();
+    cullCells_.clear();
+    cullCellIndex_.clear();
+    cullSlots_.clear();
     smokeParticles.clear();
     smokeEmitAccum = 0.0f;
+    sharedPoseIndex_.clear();
+    sharedPoses_.clear();
+    freeSharedPoseSlots_.clear();
 }
 
 void M2Renderer::setCollisionFocus(const glm::vec3& worldPos, float radius) {
@@ -2715,61 +2815,122 @@ M2Renderer::GridCell M2Renderer::toCell(const glm::vec3& p) const {
     };
 }
 
-void M2Renderer::rebuildSpatialIndex() {
-    spatialGrid.clear();
+void M2Renderer::rebuildInstanceIndex() {
     instanceIndexById.clear();
     instanceIndexById.reserve(instances.size());
 
     for (size_t i = 0; i < instances.size(); i++) {
         const auto& inst = instances[i];
         instanceIndexById[inst.id] = i;
-
-        GridCell minCell = toCell(inst.worldBoundsMin);
-        GridCell maxCell = toCell(inst.worldBoundsMax);
-        for (int z = minCell.z; z <= maxCell.z; z++) {
-            for (int y = minCell.y; y <= maxCell.y; y++) {
-                for (int x = minCell.x; x <= maxCell.x; x++) {
-                    spatialGrid[GridCell{x, y, z}].push_back(inst.id);
-                }
-            }
-        }
+        collisionTree_.setUserData(inst.bvhProxy, static_cast<uint32_t>(i));
     }
-    spatialIndexDirty_ = false;
 }
 
-void M2Renderer::gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax,
-                                  std::vector<size_t>& outIndices) const {
-    outIndices.clear();
-    candidateIdScratch.clear();
-
-    GridCell minCell = toCell(queryMin);
-    GridCell maxCell = toCell(queryMax);
-    for (int z = minCell.z; z <= maxCell.z; z++) {
-        for (int y = minCell.y; y <= maxCell.y; y++) {
-            for (int x = minCell.x; x <= maxCell.x; x++) {
-                auto it = spatialGrid.find(GridCell{x, y, z});
-                if (it == spatialGrid.end()) continue;
-                for (uint32_t id : it->second) {
-                    if (!candidateIdScratch.insert(id).second) continue;
-                    auto idxIt = instanceIndexById.find(id);
-                    if (idxIt != instanceIndexById.end()) {
-                        outIndices.push_back(idxIt->second);
-                    }
-                }
-            }
-        }
+void M2Renderer::computeCullBounds(const M2Instance& inst, float& paddedRadius, float& rangeScale) const {
+    auto it = models.find(inst.modelId);
+    if (it == models.end() || !it->second.isValid() || it->second.isSmoke || it->second.isInvisibleTrap) {
+        paddedRadius = 0.0f;
+        rangeScale = -1.0f;
+        return;
+    }
+    const M2ModelGPU& model = it->second;
+    float cullRadius = model.boundRadius * inst.scale;
+    if (model.disableAnimation) {
+        cullRadius = std::max(cullRadius, 3.0f);
+    }
+    // Large props stay visible further out; foliage/chests further still
+    rangeScale = std::max(1.0f, cullRadius / 12.0f);
+    if (model.disableAnimation) {
+        rangeScale *= 2.6f;
     }
+    // Moderate padding prevents edge pop-out during camera rotation;
+    // zero-radius models skip the frustum test entirely
+    paddedRadius = cullRadius > 0.0f ? std::max(cullRadius * 1.5f, cullRadius + 3.0f)
+                                     : std::numeric_limits<float>::infinity();
+}
 
-    // Safety fallback to preserve collision correctness if the spatial index
-    // misses candidates (e.g. during streaming churn).
-    if (outIndices.empty() && !instances.empty()) {
-        outIndices.reserve(instances.size());
-        for (size_t i = 0; i < instances.size(); i++) {
-            outIndices.push_back(i);
-        }
+void M2Renderer::cullInsert(uint32_t instanceIndex) {
+    const M2Instance& inst = instances[instanceIndex];
+    float paddedRadius, rangeScale;
+    computeCullBounds(inst, paddedRadius, rangeScale);
+
+    GridCell key = toCell(inst.position);
+    auto [it, inserted] = cullCellIndex_.try_emplace(key, static_cast<uint32_t>(cullCells_.size()));
+    if (inserted) {
+        cullCells_.emplace_back();
+        cullCells_.back().key = key;
+    }
+    CullCell& cell = cullCells_[it->second];
+    if (cell.instanceIndex.empty()) {
+        cell.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+        cell.boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+        cell.maxRangeScale = -1.0f;
+    }
+    if (rangeScale >= 0.0f) {
+        const glm::vec3 extent(paddedRadius);
+        cell.boundsMin = glm::min(cell.boundsMin, inst.position - extent);
+        cell.boundsMax = glm::max(cell.boundsMax, inst.position + extent);
+        cell.maxRangeScale = std::max(cell.maxRangeScale, rangeScale);
+    }
+
+    if (cullSlots_.size() <= instanceIndex) {
+        cullSlots_.resize(instanceIndex + 1);
+    }
+    cullSlots_[instanceIndex] = {it->second, static_cast<uint32_t>(cell.instanceIndex.size())};
+    cell.centerX.push_back(inst.position.x);
+    cell.centerY.push_back(inst.position.y);
+    cell.centerZ.push_back(inst.position.z);
+    cell.radius.push_back(paddedRadius);
+    cell.rangeScale.push_back(rangeScale);
+    cell.instanceIndex.push_back(instanceIndex);
+}
+
+void M2Renderer::cullErase(uint32_t instanceIndex) {
+    if (instanceIndex >= cullSlots_.size() || cullSlots_[instanceIndex].cell == UINT32_MAX) return;
+    const CullSlot slot = cullSlots_[instanceIndex];
+    CullCell& cell = cullCells_[slot.cell];
+
+    // Swap-remove; cell bounds stay conservative until the next rebuild
+    const uint32_t last = static_cast<uint32_t>(cell.instanceIndex.size() - 1);
+    if (slot.slot != last) {
+        cell.centerX[slot.slot] = cell.centerX[last];
+        cell.centerY[slot.slot] = cell.centerY[last];
+        cell.centerZ[slot.slot] = cell.centerZ[last];
+        cell.radius[slot.slot] = cell.radius[last];
+        cell.rangeScale[slot.slot] = cell.rangeScale[last];
+        cell.instanceIndex[slot.slot] = cell.instanceIndex[last];
+        cullSlots_[cell.instanceIndex[slot.slot]].slot = slot.slot;
+    }
+    cell.centerX.pop_back();
+    cell.centerY.pop_back();
+    cell.centerZ.pop_back();
+    cell.radius.pop_back();
+    cell.rangeScale.pop_back();
+    cell.instanceIndex.pop_back();
+    cullSlots_[instanceIndex].cell = UINT32_MAX;
+}
+
+void M2Renderer::cullUpdate(uint32_t instanceIndex) {
+    cullErase(instanceIndex);
+    cullInsert(instanceIndex);
+}
+
+void M2Renderer::rebuildCullCells() {
+    cullCells_.clear();
+    cullCellIndex_.clear();
+    cullSlots_.assign(instances.size(), CullSlot{});
+    for (uint32_t i = 0; i < static_cast<uint32_t>(instances.size()); i++) {
+        cullInsert(i);
     }
 }
 
+void M2Renderer::gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax,
+                                  std::vector<uint32_t>& outIndices) const {
+    // The tree is refit on every move/remove, so unlike the old hash grid it
+    // cannot drift from `instances` and needs no scan-everything fallback.
+    collisionTree_.queryAABB(queryMin, queryMax, outIndices);
+}
+
 void M2Renderer::cleanupUnusedModels() {
     // Build set of model IDs that are still referenced by instances
     std::unordered_set<uint32_t> usedModelIds;
@@ -2817,52 +2978,70 @@ GLuint M2Renderer::loadTexture(const std::string& path, uint32_t texFlags) {
         return it->second.id;
     }
 
-    // Load BLP texture
-    pipeline::BLPImage blp = assetManager->loadTexture(key);
-    if (!blp.isValid()) {
-        LOG_WARNING("M2: Failed to load texture: ", path);
-        // Don't cache failures — transient StormLib thread contention can
-        // cause reads to fail; next loadModel call will retry.
-        return whiteTexture;
+    // Cooked DXT mip chain when available, else decode the BLP to RGBA8
+    pipeline::BLPCompressedImage dxt;
+    if (compressedTexturesSupported()) {
+        dxt = assetManager->loadCompressedTexture(key);
     }
-
-    // Track whether the texture actually uses alpha (any pixel with alpha < 255).
+    pipeline::BLPImage blp;
     bool hasAlpha = false;
-    for (size_t i = 3; i < blp.data.size(); i += 4) {
-        if (blp.data[i] != 255) {
-            hasAlpha = true;
-            break;
+    if (dxt.isValid()) {
+        hasAlpha = dxt.hasAlpha;  // Found by the cook from the DXT blocks
+    } else {
+        blp = assetManager->loadTexture(key);
+        if (!blp.isValid()) {
+            LOG_WARNING("M2: Failed to load texture: ", path);
+            // Don't cache failures — transient StormLib thread contention can
+            // cause reads to fail; next loadModel call will retry.
+            return whiteTexture;
+        }
+
+        // Track whether the texture actually uses alpha (any pixel with alpha < 255).
+        for (size_t i = 3; i < blp.data.size(); i += 4) {
+            if (blp.data[i] != 255) {
+                hasAlpha = true;
+                break;
+            }
         }
     }
+    const int width = dxt.isValid() ? dxt.width : blp.width;
+    const int height = dxt.isValid() ? dxt.height : blp.height;
 
     GLuint textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-                 blp.width, blp.height, 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, blp.data.data());
+    size_t approxBytes = 0;
+    if (dxt.isValid()) {
+        uploadCompressedTexture(dxt);
+        for (const auto& level : dxt.levels) approxBytes += level.size();
+    } else {
+        uploadTexImage2D(0, GL_RGBA, blp.width, blp.height, GL_RGBA, blp.data.data());
+        size_t base = static_cast<size_t>(blp.width) * static_cast<size_t>(blp.height) * 4ull;
+        approxBytes = base + (base / 3);
+    }
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     // M2Texture flags: bit 0 = WrapS (1=repeat, 0=clamp), bit 1 = WrapT
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (texFlags & 0x1) ? GL_REPEAT : GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (texFlags & 0x2) ? GL_REPEAT : GL_CLAMP_TO_EDGE);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    if (!dxt.isValid()) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     applyAnisotropicFiltering();
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
     TextureCacheEntry e;
     e.id = textureID;
-    size_t base = static_cast<size_t>(blp.width) * static_cast<size_t>(blp.height) * 4ull;
-    e.approxBytes = base + (base / 3);
+    e.approxBytes = approxBytes;
     e.hasAlpha = hasAlpha;
     e.lastUse = ++textureCacheCounter_;
     textureCacheBytes_ += e.approxBytes;
     textureCache[key] = e;
     textureHasAlphaById_[textureID] = hasAlpha;
-    LOG_DEBUG("M2: Loaded texture: ", path, " (", blp.width, "x", blp.height, ")");
+    LOG_DEBUG("M2: Loaded texture: ", path, " (", width, "x", height, ")");
 
     return textureID;
 }
@@ -3269,10 +3448,7 @@ float M2Renderer::raycastBoundingBoxes(const glm::vec3& origin, const glm::vec3&
     QueryTimer timer(&queryTimeMs, &queryCallCount);
     float closestHit = maxDistance;
 
-    glm::vec3 rayEnd = origin + direction * maxDistance;
-    glm::vec3 queryMin = glm::min(origin, rayEnd) - glm::vec3(1.0f);
-    glm::vec3 queryMax = glm::max(origin, rayEnd) + glm::vec3(1.0f);
-    gatherCandidates(queryMin, queryMax, candidateScratch);
+    collisionTree_.queryRay(origin, direction, maxDistance, candidateScratch);
 
     for (size_t idx : candidateScratch) {
         const auto& instance = instances[idx];
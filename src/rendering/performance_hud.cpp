@@ -1,5 +1,6 @@
 #include "rendering/performance_hud.hpp"
 #include "rendering/renderer.hpp"
+#include "rendering/frame_graph.hpp"
 #include "rendering/terrain_renderer.hpp"
 #include "rendering/terrain_manager.hpp"
 #include "rendering/water_renderer.hpp"
@@ -13,6 +14,7 @@
 #include "rendering/wmo_renderer.hpp"
 #include "rendering/m2_renderer.hpp"
 #include "rendering/camera.hpp"
+#include "core/metrics.hpp"
 #include <imgui.h>
 #include <algorithm>
 #include <sstream>
@@ -175,6 +177,30 @@ void PerformanceHUD::render(const Renderer* renderer, const Camera* camera) {
                             m2Renderer->getQueryTimeMs(), m2Renderer->getQueryCallCount());
             }
         }
+        if (m2Renderer) {
+            ImGui::Text("M2 anim: %u evals (%u shared poses, %u LOD instances)",
+                        m2Renderer->getAnimEvaluatedInstanceCount(),
+                        m2Renderer->getAnimSharedPoseCount(),
+                        m2Renderer->getAnimLodInstanceCount());
+        }
+
+        if (const auto* frameGraph = renderer->getFrameGraph()) {
+            ImGui::Spacing();
+            ImGui::TextColored(ImVec4(0.9f, 0.8f, 0.6f, 1.0f), "PASSES (CPU / GPU ms)");
+            for (const auto& pass : frameGraph->getPassTimings()) {
+                if (pass.culled) {
+                    ImGui::TextDisabled("  %-12s culled", pass.name.c_str());
+                } else if (pass.skipped) {
+                    ImGui::TextDisabled("  %-12s cached", pass.name.c_str());
+                } else {
+                    ImGui::Text("  %-12s %6.2f / %6.2f", pass.name.c_str(), pass.cpuMs, pass.gpuMs);
+                }
+            }
+            ImGui::Text("  GPU total: %.2f ms (%zu transient targets, %zu pooled)",
+                        frameGraph->getTotalGpuMs(),
+                        frameGraph->getTransientResourceCount(),
+                        frameGraph->getTransientTextureCount());
+        }
 
         // Frame time graph
         if (!frameTimeHistory.empty()) {
@@ -354,6 +380,8 @@ void PerformanceHUD::render(const Renderer* renderer, const Camera* camera) {
             ImGui::Separator();
 
             ImGui::Text("Instances: %zu", charRenderer->getInstanceCount());
+            ImGui::Text("Draw calls: %u (%u instanced groups)",
+                        charRenderer->getDrawCallCount(), charRenderer->getDrawGroupCount());
 
             ImGui::Spacing();
         }
@@ -394,6 +422,23 @@ void PerformanceHUD::render(const Renderer* renderer, const Camera* camera) {
         }
     }
 
+    // Latency histograms from the metrics registry
+    if (showMetrics) {
+        auto histograms = core::Metrics::getInstance().histogramSnapshots();
+        if (!histograms.empty()) {
+            ImGui::TextColored(ImVec4(0.6f, 0.9f, 0.9f, 1.0f), "METRICS (ms p50/p95/p99)");
+            ImGui::Separator();
+            for (const auto& [name, snap] : histograms) {
+                if (snap.count == 0) continue;
+                std::string label = name.rfind("wowee_", 0) == 0 ? name.substr(6) : name;
+                ImGui::Text("%s: %.2f / %.2f / %.2f", label.c_str(),
+                            snap.quantile(0.50) * 1000.0, snap.quantile(0.95) * 1000.0,
+                            snap.quantile(0.99) * 1000.0);
+            }
+            ImGui::Spacing();
+        }
+    }
+
     // Camera info
     if (showCamera && camera) {
         ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "CAMERA");
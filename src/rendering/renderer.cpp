@@ -22,6 +22,8 @@
 #include "rendering/minimap.hpp"
 #include "rendering/quest_marker_renderer.hpp"
 #include "rendering/shader.hpp"
+#include "rendering/frame_graph.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "game/game_handler.hpp"
 #include "pipeline/m2_loader.hpp"
 #include <algorithm>
@@ -265,6 +267,9 @@ bool Renderer::initialize(core::Window* win) {
     // Create scene
     scene = std::make_unique<Scene>();
 
+    // Shared staging ring for geometry/texture uploads
+    GpuUploadManager::getInstance().initialize();
+
     // Create performance HUD
     performanceHUD = std::make_unique<PerformanceHUD>();
     performanceHUD->setPosition(PerformanceHUD::Position::TOP_LEFT);
@@ -436,6 +441,7 @@ bool Renderer::initialize(core::Window* win) {
     }
 
     // Initialize post-process FBO pipeline
+    frameGraph = std::make_unique<FrameGraph>();
     initPostProcess(window->getWidth(), window->getHeight());
 
     // Initialize shadow map
@@ -537,6 +543,8 @@ void Renderer::shutdown() {
     // Cleanup shadow map resources
     if (shadowFBO) { glDeleteFramebuffers(1, &shadowFBO); shadowFBO = 0; }
     if (shadowDepthTex) { glDeleteTextures(1, &shadowDepthTex); shadowDepthTex = 0; }
+    if (staticShadowFBO) { glDeleteFramebuffers(1, &staticShadowFBO); staticShadowFBO = 0; }
+    if (staticShadowDepthTex) { glDeleteTextures(1, &staticShadowDepthTex); staticShadowDepthTex = 0; }
     if (shadowShaderProgram) { glDeleteProgram(shadowShaderProgram); shadowShaderProgram = 0; }
 
     shutdownPostProcess();
@@ -548,6 +556,8 @@ void Renderer::shutdown() {
     cameraController.reset();
     camera.reset();
 
+    GpuUploadManager::getInstance().shutdown();
+
     LOG_INFO("Renderer shutdown");
 }
 
@@ -566,7 +576,7 @@ void Renderer::beginFrame() {
 }
 
 void Renderer::endFrame() {
-    // Nothing needed here for now
+    GpuUploadManager::getInstance().endFrame();
 }
 
 void Renderer::setCharacterFollow(uint32_t instanceId) {
@@ -2449,23 +2459,6 @@ void Renderer::renderWorld(game::World* world, game::GameHandler* gameHandler) {
     lastWMORenderMs = 0.0;
     lastM2RenderMs = 0.0;
 
-    // Shadow pass (before main scene)
-    if (shadowsEnabled && shadowFBO && shadowShaderProgram && terrainLoaded) {
-        renderShadowPass();
-    } else {
-        // Clear shadow maps when disabled
-        if (terrainRenderer) terrainRenderer->clearShadowMap();
-        if (wmoRenderer) wmoRenderer->clearShadowMap();
-        if (m2Renderer) m2Renderer->clearShadowMap();
-        if (characterRenderer) characterRenderer->clearShadowMap();
-    }
-
-    // Bind HDR scene framebuffer for world rendering
-    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
-    glViewport(0, 0, fbWidth, fbHeight);
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
     (void)world;  // Unused for now
 
     // Get time of day for sky-related rendering
@@ -2473,72 +2466,13 @@ void Renderer::renderWorld(game::World* world, game::GameHandler* gameHandler) {
     bool underwater = false;
     bool canalUnderwater = false;
 
-    // Render sky system (unified coordinator for skybox, stars, celestial, clouds, lens flare)
-    if (skySystem && camera) {
-        // Populate SkyParams from lighting manager
-        rendering::SkyParams skyParams;
-        skyParams.timeOfDay = timeOfDay;
-        skyParams.gameTime = gameHandler ? gameHandler->getGameTime() : -1.0f;
-
-        if (lightingManager) {
-            const auto& lighting = lightingManager->getLightingParams();
-            skyParams.directionalDir = lighting.directionalDir;
-            skyParams.sunColor = lighting.diffuseColor;
-            skyParams.skyTopColor = lighting.skyTopColor;
-            skyParams.skyMiddleColor = lighting.skyMiddleColor;
-            skyParams.skyBand1Color = lighting.skyBand1Color;
-            skyParams.skyBand2Color = lighting.skyBand2Color;
-            skyParams.cloudDensity = lighting.cloudDensity;
-            skyParams.fogDensity = lighting.fogDensity;
-            skyParams.horizonGlow = lighting.horizonGlow;
-        }
-
-        // TODO: Set skyboxModelId from LightSkybox.dbc (future)
-        skyParams.skyboxModelId = 0;
-        skyParams.skyboxHasStars = false;  // Gradient skybox has no baked stars
-
-        skySystem->render(*camera, skyParams);
-    } else {
-        // Fallback: render individual components (backwards compatibility)
-        if (skybox && camera) {
-            skybox->render(*camera, timeOfDay);
-        }
-
-        // Get lighting parameters for celestial rendering
-        const glm::vec3* sunDir = nullptr;
-        const glm::vec3* sunColor = nullptr;
-        float cloudDensity = 0.0f;
-        float fogDensity = 0.0f;
-        if (lightingManager) {
-            const auto& lighting = lightingManager->getLightingParams();
-            sunDir = &lighting.directionalDir;
-            sunColor = &lighting.diffuseColor;
-            cloudDensity = lighting.cloudDensity;
-            fogDensity = lighting.fogDensity;
-        }
-
-        if (starField && camera) {
-            starField->render(*camera, timeOfDay, cloudDensity, fogDensity);
-        }
-
-        if (celestial && camera) {
-            celestial->render(*camera, timeOfDay, sunDir, sunColor);
-        }
-
-        if (clouds && camera) {
-            clouds->render(*camera, timeOfDay);
-        }
-
-        if (lensFlare && camera && celestial) {
-            glm::vec3 sunPosition;
-            if (sunDir) {
-                const float sunDistance = 800.0f;
-                sunPosition = -*sunDir * sunDistance;
-            } else {
-                sunPosition = celestial->getSunPosition(timeOfDay);
-            }
-            lensFlare->render(*camera, sunPosition, timeOfDay);
-        }
+    const bool shadowPassEnabled = shadowsEnabled && shadowFBO && shadowShaderProgram && terrainLoaded;
+    if (!shadowPassEnabled) {
+        // Clear shadow maps when disabled
+        if (terrainRenderer) terrainRenderer->clearShadowMap();
+        if (wmoRenderer) wmoRenderer->clearShadowMap();
+        if (m2Renderer) m2Renderer->clearShadowMap();
+        if (characterRenderer) characterRenderer->clearShadowMap();
     }
 
     // Apply lighting and fog to all renderers
@@ -2573,174 +2507,319 @@ void Renderer::renderWorld(game::World* world, game::GameHandler* gameHandler) {
         if (characterRenderer) characterRenderer->setFog(horizonColor, 100.0f, 600.0f);
     }
 
-    // Render terrain if loaded and enabled
-    if (terrainEnabled && terrainLoaded && terrainRenderer && camera) {
-        // Check if camera/character is underwater for fog override
-        if (cameraController && cameraController->isSwimming() && waterRenderer && camera) {
-            glm::vec3 camPos = camera->getPosition();
-            auto waterH = waterRenderer->getWaterHeightAt(camPos.x, camPos.y);
-            constexpr float MAX_UNDERWATER_DEPTH = 12.0f;
-            // Require camera to be meaningfully below the surface before
-            // underwater fog/tint kicks in (avoids "wrong plane" near surface).
-            constexpr float UNDERWATER_ENTER_EPS = 1.10f;
-            if (waterH &&
-                camPos.z < (*waterH - UNDERWATER_ENTER_EPS) &&
-                (*waterH - camPos.z) <= MAX_UNDERWATER_DEPTH) {
-                underwater = true;
+    // Compute view/projection once for all sub-renderers
+    const glm::mat4& view = camera ? camera->getViewMatrix() : glm::mat4(1.0f);
+    const glm::mat4& projection = camera ? camera->getProjectionMatrix() : glm::mat4(1.0f);
+
+    // ── Frame graph: declare resources and passes (executed in this order) ──
+    FrameGraph& graph = *frameGraph;
+    graph.beginFrame();
+
+    const auto staticShadowMap = graph.importResource("StaticShadowMap", staticShadowDepthTex);
+    const auto shadowMap = graph.importResource("ShadowMap", shadowDepthTex);
+    const auto sceneColor = graph.importResource("SceneColor");   // MSAA renderbuffer on sceneFBO
+    const auto sceneDepth = graph.importResource("SceneDepth");
+    const auto backbuffer = graph.importResource("Backbuffer");
+    FrameGraph::TextureDesc hdrDesc;
+    hdrDesc.width = fbWidth;
+    hdrDesc.height = fbHeight;
+    hdrDesc.internalFormat = GL_RGBA16F;
+    hdrDesc.format = GL_RGBA;
+    hdrDesc.type = GL_FLOAT;
+    hdrDesc.filter = GL_LINEAR;
+    FrameGraph::TextureDesc depthDesc = hdrDesc;
+    depthDesc.internalFormat = GL_DEPTH_COMPONENT24;
+    depthDesc.format = GL_DEPTH_COMPONENT;
+    depthDesc.filter = GL_NEAREST;
+    const auto hdrColor = graph.createTexture("HDRColor", hdrDesc);
+    const auto resolvedDepth = graph.createTexture("ResolvedDepth", depthDesc);
+    graph.markOutput(backbuffer);
+
+    // Shadow passes (before main scene). Terrain, WMOs and M2s are static
+    // shadow casters: their depth is only re-rendered when the light matrix
+    // (recentred in steps, texel-snapped) or any caster set changes.
+    if (shadowPassEnabled) {
+        lightSpaceMatrix = computeLightSpaceMatrix();
+        uint64_t staticVersion = 1469598103934665603ull;
+        auto mix = [&staticVersion](const void* data, size_t bytes) {
+            const auto* p = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < bytes; i++) {
+                staticVersion ^= p[i];
+                staticVersion *= 1099511628211ull;
             }
-        }
+        };
+        const uint64_t casterVersions[3] = {
+            terrainRenderer ? terrainRenderer->getShadowCasterVersion() : 0,
+            wmoRenderer ? wmoRenderer->getShadowCasterVersion() : 0,
+            m2Renderer ? m2Renderer->getShadowCasterVersion() : 0,
+        };
+        mix(&lightSpaceMatrix[0][0], sizeof(lightSpaceMatrix));
+        mix(casterVersions, sizeof(casterVersions));
+        if (staticVersion == 0) staticVersion = 1;
 
-        if (underwater) {
-            glm::vec3 camPos = camera->getPosition();
-            std::optional<uint16_t> liquidType = waterRenderer ? waterRenderer->getWaterTypeAt(camPos.x, camPos.y) : std::nullopt;
-            if (!liquidType && cameraController) {
-                const glm::vec3* followTarget = cameraController->getFollowTarget();
-                if (followTarget && waterRenderer) {
-                    liquidType = waterRenderer->getWaterTypeAt(followTarget->x, followTarget->y);
-                }
+        graph.addPass("ShadowStatic", {}, {staticShadowMap}, [this]() {
+            renderStaticShadowCasters();
+        }, staticVersion);
+        graph.addPass("Shadow", {staticShadowMap}, {shadowMap}, [this]() {
+            renderShadowPass();
+        });
+    }
+
+    // Render sky system (unified coordinator for skybox, stars, celestial, clouds, lens flare)
+    graph.addPass("Sky", {}, {sceneColor, sceneDepth}, [&]() {
+        // Bind HDR scene framebuffer for world rendering
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+        glViewport(0, 0, fbWidth, fbHeight);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        if (skySystem && camera) {
+            // Populate SkyParams from lighting manager
+            rendering::SkyParams skyParams;
+            skyParams.timeOfDay = timeOfDay;
+            skyParams.gameTime = gameHandler ? gameHandler->getGameTime() : -1.0f;
+
+            if (lightingManager) {
+                const auto& lighting = lightingManager->getLightingParams();
+                skyParams.directionalDir = lighting.directionalDir;
+                skyParams.sunColor = lighting.diffuseColor;
+                skyParams.skyTopColor = lighting.skyTopColor;
+                skyParams.skyMiddleColor = lighting.skyMiddleColor;
+                skyParams.skyBand1Color = lighting.skyBand1Color;
+                skyParams.skyBand2Color = lighting.skyBand2Color;
+                skyParams.cloudDensity = lighting.cloudDensity;
+                skyParams.fogDensity = lighting.fogDensity;
+                skyParams.horizonGlow = lighting.horizonGlow;
+            }
+
+            // TODO: Set skyboxModelId from LightSkybox.dbc (future)
+            skyParams.skyboxModelId = 0;
+            skyParams.skyboxHasStars = false;  // Gradient skybox has no baked stars
+
+            skySystem->render(*camera, skyParams);
+        } else {
+            // Fallback: render individual components (backwards compatibility)
+            if (skybox && camera) {
+                skybox->render(*camera, timeOfDay);
+            }
+
+            // Get lighting parameters for celestial rendering
+            const glm::vec3* sunDir = nullptr;
+            const glm::vec3* sunColor = nullptr;
+            float cloudDensity = 0.0f;
+            float fogDensity = 0.0f;
+            if (lightingManager) {
+                const auto& lighting = lightingManager->getLightingParams();
+                sunDir = &lighting.directionalDir;
+                sunColor = &lighting.diffuseColor;
+                cloudDensity = lighting.cloudDensity;
+                fogDensity = lighting.fogDensity;
+            }
+
+            if (starField && camera) {
+                starField->render(*camera, timeOfDay, cloudDensity, fogDensity);
             }
-            canalUnderwater = liquidType && (*liquidType == 5 || *liquidType == 13 || *liquidType == 17);
-        }
 
-        // Apply lighting from lighting manager
-        if (lightingManager) {
-            const auto& lighting = lightingManager->getLightingParams();
+            if (celestial && camera) {
+                celestial->render(*camera, timeOfDay, sunDir, sunColor);
+            }
 
-            // Set lighting (direction, color, ambient)
-            float lightDir[3] = {lighting.directionalDir.x, lighting.directionalDir.y, lighting.directionalDir.z};
-            float lightColor[3] = {lighting.diffuseColor.r, lighting.diffuseColor.g, lighting.diffuseColor.b};
-            float ambientColor[3] = {lighting.ambientColor.r, lighting.ambientColor.g, lighting.ambientColor.b};
-            terrainRenderer->setLighting(lightDir, lightColor, ambientColor);
+            if (clouds && camera) {
+                clouds->render(*camera, timeOfDay);
+            }
 
-            // Set fog
-            float fogColor[3] = {lighting.fogColor.r, lighting.fogColor.g, lighting.fogColor.b};
-            terrainRenderer->setFog(fogColor, lighting.fogStart, lighting.fogEnd);
-        } else if (skybox) {
-            // Fallback to skybox-based fog if no lighting manager
-            glm::vec3 horizonColor = skybox->getHorizonColor(timeOfDay);
-            float fogColorArray[3] = {horizonColor.r, horizonColor.g, horizonColor.b};
-            terrainRenderer->setFog(fogColorArray, 400.0f, 1200.0f);
+            if (lensFlare && camera && celestial) {
+                glm::vec3 sunPosition;
+                if (sunDir) {
+                    const float sunDistance = 800.0f;
+                    sunPosition = -*sunDir * sunDistance;
+                } else {
+                    sunPosition = celestial->getSunPosition(timeOfDay);
+                }
+                lensFlare->render(*camera, sunPosition, timeOfDay);
+            }
         }
+    });
 
-        auto terrainStart = std::chrono::steady_clock::now();
-        terrainRenderer->render(*camera);
-        auto terrainEnd = std::chrono::steady_clock::now();
-        lastTerrainRenderMs = std::chrono::duration<double, std::milli>(terrainEnd - terrainStart).count();
+    // Render terrain if loaded and enabled
+    if (terrainEnabled && terrainLoaded && terrainRenderer && camera) {
+        graph.addPass("Terrain", {shadowMap}, {sceneColor, sceneDepth}, [&]() {
+            // Check if camera/character is underwater for fog override
+            if (cameraController && cameraController->isSwimming() && waterRenderer && camera) {
+                glm::vec3 camPos = camera->getPosition();
+                auto waterH = waterRenderer->getWaterHeightAt(camPos.x, camPos.y);
+                constexpr float MAX_UNDERWATER_DEPTH = 12.0f;
+                // Require camera to be meaningfully below the surface before
+                // underwater fog/tint kicks in (avoids "wrong plane" near surface).
+                constexpr float UNDERWATER_ENTER_EPS = 1.10f;
+                if (waterH &&
+                    camPos.z < (*waterH - UNDERWATER_ENTER_EPS) &&
+                    (*waterH - camPos.z) <= MAX_UNDERWATER_DEPTH) {
+                    underwater = true;
+                }
+            }
 
-    }
+            if (underwater) {
+                glm::vec3 camPos = camera->getPosition();
+                std::optional<uint16_t> liquidType = waterRenderer ? waterRenderer->getWaterTypeAt(camPos.x, camPos.y) : std::nullopt;
+                if (!liquidType && cameraController) {
+                    const glm::vec3* followTarget = cameraController->getFollowTarget();
+                    if (followTarget && waterRenderer) {
+                        liquidType = waterRenderer->getWaterTypeAt(followTarget->x, followTarget->y);
+                    }
+                }
+                canalUnderwater = liquidType && (*liquidType == 5 || *liquidType == 13 || *liquidType == 17);
+            }
 
-    // Render weather particles (after terrain/water, before characters)
-    if (weather && camera) {
-        weather->render(*camera);
-    }
+            // Apply lighting from lighting manager
+            if (lightingManager) {
+                const auto& lighting = lightingManager->getLightingParams();
 
-    // Render swim effects (ripples and bubbles)
-    if (swimEffects && camera) {
-        swimEffects->render(*camera);
-    }
+                // Set lighting (direction, color, ambient)
+                float lightDir[3] = {lighting.directionalDir.x, lighting.directionalDir.y, lighting.directionalDir.z};
+                float lightColor[3] = {lighting.diffuseColor.r, lighting.diffuseColor.g, lighting.diffuseColor.b};
+                float ambientColor[3] = {lighting.ambientColor.r, lighting.ambientColor.g, lighting.ambientColor.b};
+                terrainRenderer->setLighting(lightDir, lightColor, ambientColor);
 
-    // Render mount dust effects
-    if (mountDust && camera) {
-        mountDust->render(*camera);
-    }
+                // Set fog
+                float fogColor[3] = {lighting.fogColor.r, lighting.fogColor.g, lighting.fogColor.b};
+                terrainRenderer->setFog(fogColor, lighting.fogStart, lighting.fogEnd);
+            } else if (skybox) {
+                // Fallback to skybox-based fog if no lighting manager
+                glm::vec3 horizonColor = skybox->getHorizonColor(timeOfDay);
+                float fogColorArray[3] = {horizonColor.r, horizonColor.g, horizonColor.b};
+                terrainRenderer->setFog(fogColorArray, 400.0f, 1200.0f);
+            }
 
-    // Compute view/projection once for all sub-renderers
-    const glm::mat4& view = camera ? camera->getViewMatrix() : glm::mat4(1.0f);
-    const glm::mat4& projection = camera ? camera->getProjectionMatrix() : glm::mat4(1.0f);
+            auto terrainStart = std::chrono::steady_clock::now();
+            terrainRenderer->render(*camera);
+            auto terrainEnd = std::chrono::steady_clock::now();
+            lastTerrainRenderMs = std::chrono::duration<double, std::milli>(terrainEnd - terrainStart).count();
+        });
+    }
 
-    // Render characters (after weather)
-    if (characterRenderer && camera) {
-        characterRenderer->render(*camera, view, projection);
+    // Render weather particles, swim effects and mount dust (after terrain/water, before characters)
+    if (camera && (weather || swimEffects || mountDust)) {
+        graph.addPass("Effects", {sceneDepth}, {sceneColor}, [&]() {
+            if (weather) weather->render(*camera);
+            if (swimEffects) swimEffects->render(*camera);
+            if (mountDust) mountDust->render(*camera);
+        });
     }
 
-    // Render selection circle under targeted creature
-    renderSelectionCircle(view, projection);
+    // Render characters (after weather) and the selection circle under the target
+    graph.addPass("Characters", {shadowMap}, {sceneColor, sceneDepth}, [&]() {
+        if (characterRenderer && camera) {
+            characterRenderer->render(*camera, view, projection);
+        }
+        renderSelectionCircle(view, projection);
+    });
 
     // Render WMO buildings (after characters, before UI)
     if (wmoRenderer && camera) {
-        auto wmoStart = std::chrono::steady_clock::now();
-        wmoRenderer->render(*camera, view, projection);
-        auto wmoEnd = std::chrono::steady_clock::now();
-        lastWMORenderMs = std::chrono::duration<double, std::milli>(wmoEnd - wmoStart).count();
+        graph.addPass("WMO", {shadowMap}, {sceneColor, sceneDepth}, [&]() {
+            auto wmoStart = std::chrono::steady_clock::now();
+            wmoRenderer->render(*camera, view, projection);
+            auto wmoEnd = std::chrono::steady_clock::now();
+            lastWMORenderMs = std::chrono::duration<double, std::milli>(wmoEnd - wmoStart).count();
+        });
     }
 
     // Render M2 doodads (trees, rocks, etc.)
     if (m2Renderer && camera) {
-        // Dim M2 lighting when player is inside a WMO
-        if (cameraController) {
-            m2Renderer->setInsideInterior(cameraController->isInsideWMO());
-            m2Renderer->setOnTaxi(cameraController->isOnTaxi());
-        }
-        auto m2Start = std::chrono::steady_clock::now();
-        m2Renderer->render(*camera, view, projection);
-        m2Renderer->renderSmokeParticles(*camera, view, projection);
-        m2Renderer->renderM2Particles(view, projection);
-        auto m2End = std::chrono::steady_clock::now();
-        lastM2RenderMs = std::chrono::duration<double, std::milli>(m2End - m2Start).count();
+        graph.addPass("M2", {shadowMap}, {sceneColor, sceneDepth}, [&]() {
+            // Dim M2 lighting when player is inside a WMO
+            if (cameraController) {
+                m2Renderer->setInsideInterior(cameraController->isInsideWMO());
+                m2Renderer->setOnTaxi(cameraController->isOnTaxi());
+            }
+            auto m2Start = std::chrono::steady_clock::now();
+            m2Renderer->render(*camera, view, projection);
+            m2Renderer->renderSmokeParticles(*camera, view, projection);
+            m2Renderer->renderM2Particles(view, projection);
+            auto m2End = std::chrono::steady_clock::now();
+            lastM2RenderMs = std::chrono::duration<double, std::milli>(m2End - m2Start).count();
+        });
     }
 
     // Render water after opaque terrain/WMO/M2 so transparent surfaces remain visible.
     if (waterRenderer && camera) {
-        static float time = 0.0f;
-        time += 0.016f;  // Approximate frame time
-        waterRenderer->render(*camera, time);
-    }
-
-    // Render quest markers (billboards above NPCs)
-    if (questMarkerRenderer && camera) {
-        questMarkerRenderer->render(*camera);
-    }
+        graph.addPass("Water", {sceneDepth}, {sceneColor}, [&]() {
+            static float time = 0.0f;
+            time += 0.016f;  // Approximate frame time
+            waterRenderer->render(*camera, time);
+        });
+    }
+
+    // Render quest markers (billboards above NPCs) and the underwater tint
+    graph.addPass("Overlays", {sceneDepth}, {sceneColor}, [&]() {
+        if (questMarkerRenderer && camera) {
+            questMarkerRenderer->render(*camera);
+        }
+
+        // Full-screen underwater tint so WMO/M2/characters also feel submerged.
+        if (false && underwater && underwaterOverlayShader && underwaterOverlayVAO) {
+            glDisable(GL_DEPTH_TEST);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            underwaterOverlayShader->use();
+            if (canalUnderwater) {
+                underwaterOverlayShader->setUniform("uTint", glm::vec4(0.01f, 0.05f, 0.11f, 0.50f));
+            } else {
+                underwaterOverlayShader->setUniform("uTint", glm::vec4(0.02f, 0.08f, 0.15f, 0.30f));
+            }
+            glBindVertexArray(underwaterOverlayVAO);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            glBindVertexArray(0);
+            glDisable(GL_BLEND);
+            glEnable(GL_DEPTH_TEST);
+        }
+    });
+
+    // --- Resolve MSAA → non-MSAA transient textures ---
+    graph.addPass("Resolve", {sceneColor, sceneDepth}, {hdrColor, resolvedDepth}, [&]() {
+        glBindFramebuffer(GL_FRAMEBUFFER, resolveFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, graph.getTexture(hdrColor), 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, graph.getTexture(resolvedDepth), 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFBO);
+        glBlitFramebuffer(0, 0, fbWidth, fbHeight, 0, 0, fbWidth, fbHeight,
+                          GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    });
 
-    // Full-screen underwater tint so WMO/M2/characters also feel submerged.
-    if (false && underwater && underwaterOverlayShader && underwaterOverlayVAO) {
+    // --- Post-process: tonemap via fullscreen quad ---
+    graph.addPass("PostProcess", {hdrColor}, {backbuffer}, [&]() {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, window->getWidth(), window->getHeight());
         glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        underwaterOverlayShader->use();
-        if (canalUnderwater) {
-            underwaterOverlayShader->setUniform("uTint", glm::vec4(0.01f, 0.05f, 0.11f, 0.50f));
-        } else {
-            underwaterOverlayShader->setUniform("uTint", glm::vec4(0.02f, 0.08f, 0.15f, 0.30f));
-        }
-        glBindVertexArray(underwaterOverlayVAO);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        glBindVertexArray(0);
-        glDisable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-    }
-
-    // --- Resolve MSAA → non-MSAA texture ---
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFBO);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFBO);
-    glBlitFramebuffer(0, 0, fbWidth, fbHeight, 0, 0, fbWidth, fbHeight,
-                      GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glClear(GL_COLOR_BUFFER_BIT);
 
-    // --- Post-process: tonemap via fullscreen quad ---
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, window->getWidth(), window->getHeight());
-    glDisable(GL_DEPTH_TEST);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    if (postProcessShader && screenQuadVAO) {
-        postProcessShader->use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, resolveColorTex);
-        postProcessShader->setUniform("uScene", 0);
-        glBindVertexArray(screenQuadVAO);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        glBindVertexArray(0);
-        postProcessShader->unuse();
-    }
+        if (postProcessShader && screenQuadVAO) {
+            postProcessShader->use();
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, graph.getTexture(hdrColor));
+            postProcessShader->setUniform("uScene", 0);
+            glBindVertexArray(screenQuadVAO);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            glBindVertexArray(0);
+            postProcessShader->unuse();
+        }
+    });
 
     // Render minimap overlay (after post-process so it's not overwritten)
     if (minimap && camera && window) {
-        glm::vec3 minimapCenter = camera->getPosition();
-        if (cameraController && cameraController->isThirdPerson()) {
-            minimapCenter = characterPosition;
-        }
-        minimap->render(*camera, minimapCenter, window->getWidth(), window->getHeight());
+        graph.addPass("Minimap", {backbuffer}, {backbuffer}, [&]() {
+            glm::vec3 minimapCenter = camera->getPosition();
+            if (cameraController && cameraController->isThirdPerson()) {
+                minimapCenter = characterPosition;
+            }
+            minimap->render(*camera, minimapCenter, window->getWidth(), window->getHeight());
+        });
     }
 
+    graph.compile();
+    graph.execute();
+
     glEnable(GL_DEPTH_TEST);
 
     auto renderEnd = std::chrono::steady_clock::now();
@@ -2775,30 +2854,8 @@ void Renderer::initPostProcess(int w, int h) {
     }
 
     // --- Resolve FBO (non-MSAA, for post-process sampling) ---
-    glGenTextures(1, &resolveColorTex);
-    glBindTexture(GL_TEXTURE_2D, resolveColorTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glGenTextures(1, &resolveDepthTex);
-    glBindTexture(GL_TEXTURE_2D, resolveDepthTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
+    // Color/depth attachments are frame graph transients, attached by the Resolve pass.
     glGenFramebuffers(1, &resolveFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, resolveFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, resolveColorTex, 0);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, resolveDepthTex, 0);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        LOG_ERROR("Resolve FBO incomplete!");
-    }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // --- Fullscreen quad (triangle strip, pos + UV) ---
@@ -2865,11 +2922,8 @@ void Renderer::resizePostProcess(int w, int h) {
     glBindRenderbuffer(GL_RENDERBUFFER, sceneDepthRBO);
     glRenderbufferStorageMultisample(GL_RENDERBUFFER, SAMPLES, GL_DEPTH_COMPONENT24, w, h);
 
-    // Resize resolve textures
-    glBindTexture(GL_TEXTURE_2D, resolveColorTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glBindTexture(GL_TEXTURE_2D, resolveDepthTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    // Resolve targets are reallocated at the new size by the frame graph
+    if (frameGraph) frameGraph->releaseTransients();
 
     LOG_INFO("Post-process FBO resized (", w, "x", h, ")");
 }
@@ -2891,13 +2945,8 @@ void Renderer::shutdownPostProcess() {
         glDeleteFramebuffers(1, &resolveFBO);
         resolveFBO = 0;
     }
-    if (resolveColorTex) {
-        glDeleteTextures(1, &resolveColorTex);
-        resolveColorTex = 0;
-    }
-    if (resolveDepthTex) {
-        glDeleteTextures(1, &resolveDepthTex);
-        resolveDepthTex = 0;
+    if (frameGraph) {
+        frameGraph->shutdown();
     }
     if (screenQuadVAO) {
         glDeleteVertexArrays(1, &screenQuadVAO);
@@ -3245,6 +3294,26 @@ void Renderer::initShadowMap() {
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         LOG_ERROR("Shadow FBO incomplete!");
     }
+
+    // Static caster depth, copied into the shadow map each frame before characters
+    glGenTextures(1, &staticShadowDepthTex);
+    glBindTexture(GL_TEXTURE_2D, staticShadowDepthTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24,
+                 SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, 0,
+                 GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &staticShadowFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, staticShadowFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, staticShadowDepthTex, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Static shadow FBO incomplete!");
+    }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     LOG_INFO("Shadow map initialized (", SHADOW_MAP_SIZE, "x", SHADOW_MAP_SIZE, ")");
@@ -3407,17 +3476,14 @@ glm::mat4 Renderer::computeLightSpaceMatrix() {
     return lightProj * lightView;
 }
 
-void Renderer::renderShadowPass() {
+void Renderer::renderStaticShadowCasters() {
     constexpr float kShadowHalfExtent = 180.0f;
     constexpr float kShadowLightDistance = 280.0f;
     constexpr float kShadowNearPlane = 1.0f;
     constexpr float kShadowFarPlane = 600.0f;
 
-    // Compute light space matrix
-    lightSpaceMatrix = computeLightSpaceMatrix();
-
-    // Bind shadow FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, shadowFBO);
+    // lightSpaceMatrix was computed for this frame in renderWorld()
+    glBindFramebuffer(GL_FRAMEBUFFER, staticShadowFBO);
     glViewport(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
     glClear(GL_DEPTH_BUFFER_BIT);
 
@@ -3479,21 +3545,31 @@ void Renderer::renderShadowPass() {
         m2Renderer->renderShadow(shadowShaderProgram);
     }
 
-    // Render characters into shadow map
+    // Restore state
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glCullFace(GL_BACK);
+    glViewport(0, 0, fbWidth, fbHeight);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void Renderer::renderShadowPass() {
+    // Start from the cached static casters
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, staticShadowFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, shadowFBO);
+    glBlitFramebuffer(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, 0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE,
+                      GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, shadowFBO);
+    glViewport(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+
+    // Render characters into shadow map (animated, so every frame)
     if (characterRenderer) {
         // Character shadows need less caster bias to avoid "floating" away from feet.
-        glDisable(GL_POLYGON_OFFSET_FILL);
+        glEnable(GL_CULL_FACE);
         glCullFace(GL_BACK);
         characterRenderer->renderShadow(lightSpaceMatrix);
-        glCullFace(GL_FRONT);
-        glEnable(GL_POLYGON_OFFSET_FILL);
-        glPolygonOffset(2.0f, 4.0f);
+        glCullFace(GL_BACK);
     }
 
-    // Restore state
-    glDisable(GL_POLYGON_OFFSET_FILL);
-    glCullFace(GL_BACK);
-
     // Restore main viewport
     glViewport(0, 0, fbWidth, fbHeight);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
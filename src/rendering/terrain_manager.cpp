@@ -4,9 +4,11 @@
 #include "rendering/m2_renderer.hpp"
 #include "rendering/wmo_renderer.hpp"
 #include "rendering/camera.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "audio/ambient_sound_manager.hpp"
 #include "core/coordinates.hpp"
 #include "core/memory_monitor.hpp"
+#include "core/metrics.hpp"
 #include "pipeline/asset_manager.hpp"
 #include "pipeline/adt_loader.hpp"
 #include "pipeline/m2_loader.hpp"
@@ -16,9 +18,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/euler_angles.hpp>
+#include <algorithm>
 #include <cmath>
 #include <cctype>
 #include <functional>
+#include <limits>
 #include <unordered_set>
 
 namespace wowee {
@@ -231,11 +235,18 @@ bool TerrainManager::enqueueTile(int x, int y) {
 }
 
 std::shared_ptr<PendingTile> TerrainManager::prepareTile(int x, int y) {
+    static auto& tileCacheHits = core::Metrics::getInstance().counter(
+        "wowee_terrain_tile_cache_total", "Tile prepares by in-RAM tile cache outcome", "result=\"hit\"");
+    static auto& tileCacheMisses = core::Metrics::getInstance().counter(
+        "wowee_terrain_tile_cache_total", "Tile prepares by in-RAM tile cache outcome", "result=\"miss\"");
+
     TileCoord coord = {x, y};
     if (auto cached = getCachedTile(coord)) {
         LOG_DEBUG("Using cached tile [", x, ",", y, "]");
+        tileCacheHits.add();
         return cached;
     }
+    tileCacheMisses.add();
 
     LOG_DEBUG("Preparing tile [", x, ",", y, "] (CPU work)");
 
@@ -259,8 +270,11 @@ std::shared_ptr<PendingTile> TerrainManager::prepareTile(int x, int y) {
     terrain.coord.x = x;
     terrain.coord.y = y;
 
-    // Generate mesh
-    pipeline::TerrainMesh mesh = pipeline::TerrainMeshGenerator::generate(terrain);
+    // Generate mesh (asset_cook stores the generator output per ADT)
+    pipeline::TerrainMesh mesh;
+    if (!assetManager->loadCookedTerrainMesh(adtPath, mesh)) {
+        mesh = pipeline::TerrainMeshGenerator::generate(terrain);
+    }
     if (mesh.validChunkCount == 0) {
         LOG_ERROR("Failed to generate terrain mesh: ", adtPath);
         return nullptr;
@@ -299,16 +313,13 @@ std::shared_ptr<PendingTile> TerrainManager::prepareTile(int x, int y) {
 
             // Parse model if not already done for this tile
             if (preparedModelIds.find(modelId) == preparedModelIds.end()) {
-                std::vector<uint8_t> m2Data = assetManager->readFile(m2Path);
-                if (!m2Data.empty()) {
-                    pipeline::M2Model m2Model = pipeline::M2Loader::load(m2Data);
+                if (assetManager->fileExists(m2Path)) {
+                    // Cooked blob when present, else parse + apply 00.skin
+                    pipeline::M2Model m2Model = assetManager->loadM2Model(m2Path);
 
-                    // Try to load skin file (only for WotLK M2s - vanilla has embedded skin)
+                    // Skin file only exists for WotLK M2s - vanilla has embedded skin
                     std::string skinPath = m2Path.substr(0, m2Path.size() - 3) + "00.skin";
-                    std::vector<uint8_t> skinData = assetManager->readFile(skinPath);
-                    if (!skinData.empty() && m2Model.version >= 264) {
-                        pipeline::M2Loader::loadSkin(skinData, m2Model);
-                    } else if (skinData.empty() && m2Model.version >= 264) {
+                    if (m2Model.version >= 264 && !assetManager->fileExists(skinPath)) {
                         skippedSkinNotFound++;
                         LOG_WARNING("M2 skin not found: ", skinPath);
                     }
@@ -366,40 +377,8 @@ std::shared_ptr<PendingTile> TerrainManager::prepareTile(int x, int y) {
             if (placement.nameId >= pending->terrain.wmoNames.size()) continue;
 
             const std::string& wmoPath = pending->terrain.wmoNames[placement.nameId];
-            std::vector<uint8_t> wmoData = assetManager->readFile(wmoPath);
-            if (wmoData.empty()) continue;
-
-            pipeline::WMOModel wmoModel = pipeline::WMOLoader::load(wmoData);
-            if (wmoModel.nGroups > 0) {
-                std::string basePath = wmoPath;
-                std::string extension;
-                if (basePath.size() > 4) {
-                    extension = basePath.substr(basePath.size() - 4);
-                    std::string extLower = extension;
-                    for (char& c : extLower) c = std::tolower(c);
-                    if (extLower == ".wmo") {
-                        basePath = basePath.substr(0, basePath.size() - 4);
-                    }
-                }
-
-                for (uint32_t gi = 0; gi < wmoModel.nGroups; gi++) {
-                    char groupSuffix[16];
-                    snprintf(groupSuffix, sizeof(groupSuffix), "_%03u%s", gi, extension.c_str());
-                    std::string groupPath = basePath + groupSuffix;
-                    std::vector<uint8_t> groupData = assetManager->readFile(groupPath);
-                    if (groupData.empty()) {
-                        snprintf(groupSuffix, sizeof(groupSuffix), "_%03u.wmo", gi);
-                        groupData = assetManager->readFile(basePath + groupSuffix);
-                    }
-                    if (groupData.empty()) {
-                        snprintf(groupSuffix, sizeof(groupSuffix), "_%03u.WMO", gi);
-                        groupData = assetManager->readFile(basePath + groupSuffix);
-                    }
-                    if (!groupData.empty()) {
-                        pipeline::WMOLoader::loadGroup(groupData, wmoModel, gi);
-                    }
-                }
-            }
+            // Cooked groups (with collision grids) when present, else parse every group file
+            pipeline::WMOModel wmoModel = assetManager->loadWMOModel(wmoPath);
 
             if (!wmoModel.groups.empty()) {
                 glm::vec3 pos = core::coords::adtToWorld(placement.position[0],
@@ -441,15 +420,7 @@ std::shared_ptr<PendingTile> TerrainManager::prepareTile(int x, int y) {
                         }
 
                         uint32_t doodadModelId = static_cast<uint32_t>(std::hash<std::string>{}(m2Path));
-                        std::vector<uint8_t> m2Data = assetManager->readFile(m2Path);
-                        if (m2Data.empty()) continue;
-
-                        pipeline::M2Model m2Model = pipeline::M2Loader::load(m2Data);
-                        std::string skinPath = m2Path.substr(0, m2Path.size() - 3) + "00.skin";
-                        std::vector<uint8_t> skinData = assetManager->readFile(skinPath);
-                        if (!skinData.empty() && m2Model.version >= 264) {
-                            pipeline::M2Loader::loadSkin(skinData, m2Model);
-                        }
+                        pipeline::M2Model m2Model = assetManager->loadM2Model(m2Path);
                         if (!m2Model.isValid()) continue;
 
                         // Build doodad's local transform (WoW coordinates)
@@ -761,7 +732,7 @@ void TerrainManager::finalizeTile(const std::shared_ptr<PendingTile>& pending) {
         for (const auto& emitter : pending->ambientEmitters) {
             // Cast uint32_t type to AmbientSoundManager::AmbientType enum
             auto type = static_cast<audio::AmbientSoundManager::AmbientType>(emitter.type);
-            ambientSoundManager->addEmitter(emitter.position, type);
+            ambientSoundManager->addTileEmitter(x, y, emitter.position, type);
         }
     }
 
@@ -809,11 +780,17 @@ void TerrainManager::workerLoop() {
         }
 
         if (hasWork) {
-            auto pending = prepareTile(coord.x, coord.y);
+            static auto& prepareHist = core::Metrics::getInstance().histogram(
+                "wowee_terrain_tile_prepare_seconds", "Worker-side tile parse/prepare time");
+            std::shared_ptr<PendingTile> pending;
+            {
+                core::ScopedTimer timer(prepareHist);
+                pending = prepareTile(coord.x, coord.y);
+            }
 
             std::lock_guard<std::mutex> lock(queueMutex);
             if (pending) {
-                readyQueue.push(pending);
+                readyQueue.push_back(pending);
             } else {
                 // Mark as failed so we don't re-enqueue
                 // We'll set failedTiles on the main thread in processReadyTiles
@@ -833,6 +810,16 @@ void TerrainManager::processReadyTiles() {
     auto startTime = std::chrono::high_resolution_clock::now();
     int processed = 0;
 
+    static auto& loadedGauge = core::Metrics::getInstance().gauge(
+        "wowee_terrain_loaded_tiles", "Terrain tiles resident on the GPU");
+    static auto& readyGauge = core::Metrics::getInstance().gauge(
+        "wowee_terrain_ready_queue", "Prepared tiles waiting for main-thread finalize");
+    loadedGauge.set(static_cast<double>(loadedTiles.size()));
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        readyGauge.set(static_cast<double>(readyQueue.size()));
+    }
+
     while (true) {
         std::shared_ptr<PendingTile> pending;
 
@@ -841,8 +828,24 @@ void TerrainManager::processReadyTiles() {
             if (readyQueue.empty()) {
                 break;
             }
-            pending = readyQueue.front();
-            readyQueue.pop();
+            // Nearest tile first; the camera's own ring may overrun the
+            // shared upload budget so the ground under the player never waits.
+            auto nearest = readyQueue.begin();
+            int nearestDist = std::numeric_limits<int>::max();
+            for (auto it = readyQueue.begin(); it != readyQueue.end(); ++it) {
+                int dist = std::max(std::abs((*it)->coord.x - currentTile.x),
+                                    std::abs((*it)->coord.y - currentTile.y));
+                if (dist < nearestDist) {
+                    nearestDist = dist;
+                    nearest = it;
+                }
+            }
+            auto priority = nearestDist <= 1 ? UploadPriority::HIGH : UploadPriority::NORMAL;
+            if (!GpuUploadManager::getInstance().hasBudget(priority)) {
+                break;
+            }
+            pending = *nearest;
+            readyQueue.erase(nearest);
         }
 
         if (pending) {
@@ -853,6 +856,9 @@ void TerrainManager::processReadyTiles() {
 
             auto tileEnd = std::chrono::high_resolution_clock::now();
             float tileTimeMs = std::chrono::duration<float, std::milli>(tileEnd - tileStart).count();
+            static auto& finalizeHist = core::Metrics::getInstance().histogram(
+                "wowee_terrain_tile_finalize_seconds", "Main-thread tile finalize (GPU upload) time");
+            finalizeHist.observe(tileTimeMs / 1000.0f);
 
             {
                 std::lock_guard<std::mutex> lock(queueMutex);
@@ -875,7 +881,8 @@ void TerrainManager::processReadyTiles() {
 void TerrainManager::processM2UploadQueue() {
     // Upload up to MAX_M2_UPLOADS_PER_FRAME models per frame
     int uploaded = 0;
-    while (!m2UploadQueue_.empty() && uploaded < MAX_M2_UPLOADS_PER_FRAME) {
+    while (!m2UploadQueue_.empty() && uploaded < MAX_M2_UPLOADS_PER_FRAME &&
+           GpuUploadManager::getInstance().hasBudget()) {
         auto& upload = m2UploadQueue_.front();
         if (m2Renderer) {
             m2Renderer->loadModel(upload.model, upload.modelId);
@@ -896,7 +903,7 @@ void TerrainManager::processAllReadyTiles() {
             std::lock_guard<std::mutex> lock(queueMutex);
             if (readyQueue.empty()) break;
             pending = readyQueue.front();
-            readyQueue.pop();
+            readyQueue.pop_front();
         }
         if (pending) {
             TileCoord coord = pending->coord;
@@ -1047,6 +1054,11 @@ void TerrainManager::unloadTile(int x, int y) {
         waterRenderer->removeTile(x, y);
     }
 
+    // Remove ambient sound emitters registered by this tile
+    if (ambientSoundManager) {
+        ambientSoundManager->removeTileEmitters(x, y);
+    }
+
     loadedTiles.erase(it);
 }
 
@@ -1067,13 +1079,16 @@ void TerrainManager::unloadAll() {
     {
         std::lock_guard<std::mutex> lock(queueMutex);
         while (!loadQueue.empty()) loadQueue.pop_front();
-        while (!readyQueue.empty()) readyQueue.pop();
+        readyQueue.clear();
     }
     pendingTiles.clear();
     placedDoodadIds.clear();
 
     LOG_INFO("Unloading all terrain tiles");
     loadedTiles.clear();
+    if (ambientSoundManager) {
+        ambientSoundManager->clearEmitters();
+    }
     failedTiles.clear();
 
     // Reset tile tracking so streaming re-triggers at the new location
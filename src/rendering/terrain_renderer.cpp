@@ -1,5 +1,6 @@
 #include "rendering/terrain_renderer.hpp"
 #include "rendering/texture.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "rendering/frustum.hpp"
 #include "pipeline/asset_manager.hpp"
 #include "pipeline/blp_loader.hpp"
@@ -151,6 +152,7 @@ bool TerrainRenderer::loadTerrain(const pipeline::TerrainMesh& mesh,
             gpuChunk.tileX = tileX;
             gpuChunk.tileY = tileY;
             chunks.push_back(gpuChunk);
+            shadowCasterVersion_++;
         }
     }
 
@@ -185,18 +187,18 @@ TerrainChunkGPU TerrainRenderer::uploadChunk(const pipeline::ChunkMesh& chunk) {
     // Create VBO
     glGenBuffers(1, &gpuChunk.vbo);
     glBindBuffer(GL_ARRAY_BUFFER, gpuChunk.vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 chunk.vertices.size() * sizeof(pipeline::TerrainVertex),
-                 chunk.vertices.data(),
-                 GL_STATIC_DRAW);
+    uploadBufferData(GL_ARRAY_BUFFER,
+                     chunk.vertices.size() * sizeof(pipeline::TerrainVertex),
+                     chunk.vertices.data(),
+                     GL_STATIC_DRAW);
 
     // Create IBO
     glGenBuffers(1, &gpuChunk.ibo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuChunk.ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 chunk.indices.size() * sizeof(pipeline::TerrainIndex),
-                 chunk.indices.data(),
-                 GL_STATIC_DRAW);
+    uploadBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                     chunk.indices.size() * sizeof(pipeline::TerrainIndex),
+                     chunk.indices.data(),
+                     GL_STATIC_DRAW);
 
     // Set up vertex attributes
     // Location 0: Position (vec3)
@@ -259,9 +261,7 @@ GLuint TerrainRenderer::loadTexture(const std::string& path) {
     glBindTexture(GL_TEXTURE_2D, textureID);
 
     // Upload texture data (BLP loader outputs RGBA8)
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-                 blp.width, blp.height, 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, blp.data.data());
+    uploadTexImage2D(0, GL_RGBA, blp.width, blp.height, GL_RGBA, blp.data.data());
 
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -309,9 +309,7 @@ void TerrainRenderer::uploadPreloadedTextures(const std::unordered_map<std::stri
         GLuint textureID;
         glGenTextures(1, &textureID);
         glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-                     blp.width, blp.height, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, blp.data.data());
+        uploadTexImage2D(0, GL_RGBA, blp.width, blp.height, GL_RGBA, blp.data.data());
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -355,9 +353,7 @@ GLuint TerrainRenderer::createAlphaTexture(const std::vector<uint8_t>& alphaData
     int width = 64;
     int height = 64;
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,
-                 width, height, 0,
-                 GL_RED, GL_UNSIGNED_BYTE, src);
+    uploadTexImage2D(0, GL_RED, width, height, GL_RED, src);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -585,6 +581,7 @@ void TerrainRenderer::removeTile(int tileX, int tileY) {
         }
     }
     if (removed > 0) {
+        shadowCasterVersion_++;
         LOG_DEBUG("Removed ", removed, " terrain chunks for tile [", tileX, ",", tileY, "]");
     }
 }
@@ -604,6 +601,7 @@ void TerrainRenderer::clear() {
 
     chunks.clear();
     renderedChunks = 0;
+    shadowCasterVersion_++;
 }
 
 void TerrainRenderer::setLighting(const float lightDirIn[3], const float lightColorIn[3],
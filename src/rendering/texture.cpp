@@ -1,4 +1,6 @@
 #include "rendering/texture.hpp"
+#include "rendering/gpu_upload_manager.hpp"
+#include "pipeline/blp_loader.hpp"
 #include "core/logger.hpp"
 
 // Stub implementation - would use stb_image or similar
@@ -25,7 +27,7 @@ bool Texture::loadFromMemory(const unsigned char* data, int w, int h, int channe
     glBindTexture(GL_TEXTURE_2D, textureID);
 
     GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    uploadTexImage2D(0, format, width, height, format, data);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -48,6 +50,34 @@ void Texture::unbind() const {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+bool compressedTexturesSupported() {
+    return GLEW_EXT_texture_compression_s3tc;
+}
+
+bool uploadCompressedTexture(const pipeline::BLPCompressedImage& image) {
+    if (!compressedTexturesSupported() || !image.isValid()) {
+        return false;
+    }
+    GLenum internalFormat;
+    switch (image.compression) {
+        case pipeline::BLPCompression::DXT1: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+        case pipeline::BLPCompression::DXT3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
+        case pipeline::BLPCompression::DXT5: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+        default: return false;
+    }
+    int w = image.width, h = image.height;
+    GLint level = 0;
+    for (const auto& blocks : image.levels) {
+        uploadCompressedTexImage2D(level, internalFormat, w, h, static_cast<GLsizei>(blocks.size()),
+                                   blocks.data());
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+        level++;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+    return true;
+}
+
 void applyAnisotropicFiltering() {
     static float maxAniso = -1.0f;
     if (maxAniso < 0.0f) {
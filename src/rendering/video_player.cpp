@@ -1,6 +1,8 @@
 #include "rendering/video_player.hpp"
+#include "rendering/shader.hpp"
 #include "core/logger.hpp"
 #include <GL/glew.h>
+#include <algorithm>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -12,6 +14,58 @@ extern "C" {
 namespace wowee {
 namespace rendering {
 
+namespace {
+
+// Fullscreen triangle from gl_VertexID; TexCoord row 0 is the first image row,
+// matching how the texture was laid out when frames were uploaded as RGB.
+const char* kYuvVertSrc = R"(
+    #version 330 core
+    out vec2 TexCoord;
+
+    void main() {
+        vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        TexCoord = pos;
+        gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+    }
+)";
+
+const char* kYuvFragSrc = R"(
+    #version 330 core
+    in vec2 TexCoord;
+
+    uniform sampler2D uPlaneY;
+    uniform sampler2D uPlaneU;
+    uniform sampler2D uPlaneV;
+    uniform int uFullRange;
+    uniform int uBt709;
+
+    out vec4 FragColor;
+
+    void main() {
+        float y = texture(uPlaneY, TexCoord).r;
+        float u = texture(uPlaneU, TexCoord).r - 128.0 / 255.0;
+        float v = texture(uPlaneV, TexCoord).r - 128.0 / 255.0;
+        if (uFullRange == 0) {
+            y = (y - 16.0 / 255.0) * (255.0 / 219.0);
+            u *= 255.0 / 224.0;
+            v *= 255.0 / 224.0;
+        }
+        vec3 rgb;
+        if (uBt709 != 0) {
+            rgb = vec3(y + 1.5748 * v, y - 0.1873 * u - 0.4681 * v, y + 1.8556 * u);
+        } else {
+            rgb = vec3(y + 1.402 * v, y - 0.344136 * u - 0.714136 * v, y + 1.772 * u);
+        }
+        FragColor = vec4(clamp(rgb, 0.0, 1.0), 1.0);
+    }
+)";
+
+bool isPlanar420(int format) {
+    return format == AV_PIX_FMT_YUV420P || format == AV_PIX_FMT_YUVJ420P;
+}
+
+} // namespace
+
 VideoPlayer::VideoPlayer() = default;
 
 VideoPlayer::~VideoPlayer() {
@@ -72,11 +126,9 @@ bool VideoPlayer::open(const std::string& path) {
     }
 
     AVFrame* f = av_frame_alloc();
-    AVFrame* rgb = av_frame_alloc();
     AVPacket* pkt = av_packet_alloc();
-    if (!f || !rgb || !pkt) {
+    if (!f || !pkt) {
         if (pkt) av_packet_free(&pkt);
-        if (rgb) av_frame_free(&rgb);
         if (f) av_frame_free(&f);
         avcodec_free_context(&ctx);
         avformat_close_input(&fmt);
@@ -87,29 +139,21 @@ bool VideoPlayer::open(const std::string& path) {
     height = ctx->height;
     if (width <= 0 || height <= 0) {
         av_packet_free(&pkt);
-        av_frame_free(&rgb);
         av_frame_free(&f);
         avcodec_free_context(&ctx);
         avformat_close_input(&fmt);
         return false;
     }
+    chromaWidth = (width + 1) / 2;
+    chromaHeight = (height + 1) / 2;
+    frameBytes = static_cast<size_t>(width) * height + 2 * static_cast<size_t>(chromaWidth) * chromaHeight;
+    slotStride = (frameBytes + 255) & ~static_cast<size_t>(255);
 
-    int bufferSize = av_image_get_buffer_size(AV_PIX_FMT_RGB24, width, height, 1);
-    rgbBuffer.resize(static_cast<size_t>(bufferSize));
-    av_image_fill_arrays(rgb->data, rgb->linesize,
-                         rgbBuffer.data(), AV_PIX_FMT_RGB24, width, height, 1);
-
-    SwsContext* sws = sws_getContext(width, height, ctx->pix_fmt,
-                                     width, height, AV_PIX_FMT_RGB24,
-                                     SWS_BILINEAR, nullptr, nullptr, nullptr);
-    if (!sws) {
-        av_packet_free(&pkt);
-        av_frame_free(&rgb);
-        av_frame_free(&f);
-        avcodec_free_context(&ctx);
-        avformat_close_input(&fmt);
-        return false;
-    }
+    // Frames in other layouts are converted to YUV 4:2:0 by swscale on the
+    // decode thread, which leaves them in limited range.
+    fullRange = isPlanar420(ctx->pix_fmt) &&
+                (ctx->pix_fmt == AV_PIX_FMT_YUVJ420P || ctx->color_range == AVCOL_RANGE_JPEG);
+    bt709 = ctx->colorspace == AVCOL_SPC_BT709;
 
     AVRational fr = fmt->streams[streamIndex]->avg_frame_rate;
     if (fr.num <= 0 || fr.den <= 0) {
@@ -119,35 +163,43 @@ bool VideoPlayer::open(const std::string& path) {
     if (fps <= 0.0) fps = 30.0;
     frameTime = 1.0 / fps;
     accumulator = 0.0;
-    eof = false;
 
     formatCtx = fmt;
     codecCtx = ctx;
     frame = f;
-    rgbFrame = rgb;
     packet = pkt;
-    swsCtx = sws;
     videoStreamIndex = streamIndex;
 
+    if (!createGpuResources()) {
+        LOG_WARNING("VideoPlayer: failed to create GPU resources for ", path);
+        close();
+        return false;
+    }
+
     textureReady = false;
+    stopDecode = false;
+    decodeThread = std::thread(&VideoPlayer::decodeLoop, this);
     return true;
 }
 
 void VideoPlayer::close() {
-    if (textureId) {
-        glDeleteTextures(1, &textureId);
-        textureId = 0;
+    if (decodeThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(slotMutex);
+            stopDecode = true;
+        }
+        slotCv.notify_all();
+        decodeThread.join();
     }
+    readyQueue.clear();
+
+    destroyGpuResources();
     textureReady = false;
 
     if (packet) {
         av_packet_free(reinterpret_cast<AVPacket**>(&packet));
         packet = nullptr;
     }
-    if (rgbFrame) {
-        av_frame_free(reinterpret_cast<AVFrame**>(&rgbFrame));
-        rgbFrame = nullptr;
-    }
     if (frame) {
         av_frame_free(reinterpret_cast<AVFrame**>(&frame));
         frame = nullptr;
@@ -167,85 +219,359 @@ void VideoPlayer::close() {
     videoStreamIndex = -1;
     width = 0;
     height = 0;
-    rgbBuffer.clear();
+    chromaWidth = 0;
+    chromaHeight = 0;
+    frameBytes = 0;
+    slotStride = 0;
 }
 
-void VideoPlayer::update(float deltaTime) {
-    if (!formatCtx || !codecCtx) return;
-    accumulator += deltaTime;
-    while (accumulator >= frameTime) {
-        if (!decodeNextFrame()) break;
-        accumulator -= frameTime;
+bool VideoPlayer::createGpuResources() {
+    const int planeWidth[3] = {width, chromaWidth, chromaWidth};
+    const int planeHeight[3] = {height, chromaHeight, chromaHeight};
+    glGenTextures(3, planeTextures);
+    for (int p = 0; p < 3; p++) {
+        glBindTexture(GL_TEXTURE_2D, planeTextures[p]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, planeWidth[p], planeHeight[p], 0,
+                     GL_RED, GL_UNSIGNED_BYTE, nullptr);
     }
+
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint prevFbo = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFbo));
+    if (!complete) {
+        LOG_ERROR("VideoPlayer: output FBO incomplete");
+        return false;
+    }
+
+    // Core profile needs a bound VAO even for attribute-less draws
+    glGenVertexArrays(1, &vao);
+
+    yuvShader = std::make_unique<Shader>();
+    if (!yuvShader->loadFromSource(kYuvVertSrc, kYuvFragSrc)) {
+        LOG_ERROR("VideoPlayer: failed to create YUV conversion shader");
+        return false;
+    }
+    yuvShader->use();
+    yuvShader->setUniform("uPlaneY", 0);
+    yuvShader->setUniform("uPlaneU", 1);
+    yuvShader->setUniform("uPlaneV", 2);
+    yuvShader->setUniform("uFullRange", fullRange ? 1 : 0);
+    yuvShader->setUniform("uBt709", bt709 ? 1 : 0);
+    yuvShader->unuse();
+
+    glGenBuffers(1, &pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    uint8_t* mapped = nullptr;
+    if (GLEW_ARB_buffer_storage) {
+        const GLsizeiptr size = static_cast<GLsizeiptr>(slotStride * SLOT_COUNT);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+        mapped = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+        if (!mapped) {
+            // Storage is immutable; start over with a fresh name for the fallback
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &pbo);
+            glGenBuffers(1, &pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        }
+    }
+    persistentMapping = mapped != nullptr;
+    if (!persistentMapping) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(frameBytes), nullptr, GL_STREAM_DRAW);
+        cpuSlots.resize(slotStride * SLOT_COUNT);
+        mapped = cpuSlots.data();
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        slots[i].data = mapped + slotStride * i;
+        slots[i].state = SlotState::FREE;
+        slots[i].fence = nullptr;
+    }
+
+    LOG_INFO("VideoPlayer: ", width, "x", height, " @ ", 1.0 / frameTime, " fps, ",
+             persistentMapping ? "persistent PBO" : "streamed PBO", " upload");
+    return true;
 }
 
-bool VideoPlayer::decodeNextFrame() {
+void VideoPlayer::destroyGpuResources() {
+    for (auto& slot : slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        slot.data = nullptr;
+        slot.state = SlotState::FREE;
+    }
+    if (pbo) {
+        // Deleting a mapped buffer unmaps it
+        glDeleteBuffers(1, &pbo);
+        pbo = 0;
+    }
+    persistentMapping = false;
+    cpuSlots.clear();
+    cpuSlots.shrink_to_fit();
+
+    yuvShader.reset();
+    if (vao) {
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+    if (fbo) {
+        glDeleteFramebuffers(1, &fbo);
+        fbo = 0;
+    }
+    if (textureId) {
+        glDeleteTextures(1, &textureId);
+        textureId = 0;
+    }
+    if (planeTextures[0]) {
+        glDeleteTextures(3, planeTextures);
+        planeTextures[0] = planeTextures[1] = planeTextures[2] = 0;
+    }
+}
+
+void VideoPlayer::decodeLoop() {
+    while (true) {
+        int slot = -1;
+        {
+            std::unique_lock<std::mutex> lock(slotMutex);
+            slotCv.wait(lock, [this, &slot] {
+                if (stopDecode) return true;
+                for (int i = 0; i < SLOT_COUNT; i++) {
+                    if (slots[i].state == SlotState::FREE) {
+                        slot = i;
+                        return true;
+                    }
+                }
+                return false;
+            });
+            if (stopDecode) return;
+            slots[slot].state = SlotState::DECODING;
+        }
+
+        bool ok = decodeFrame(slots[slot].data);
+
+        std::lock_guard<std::mutex> lock(slotMutex);
+        if (!ok) {
+            // Keep showing the last frame
+            slots[slot].state = SlotState::FREE;
+            if (!stopDecode) LOG_WARNING("VideoPlayer: decoding stopped for ", sourcePath);
+            return;
+        }
+        slots[slot].state = SlotState::READY;
+        readyQueue.push_back(slot);
+    }
+}
+
+bool VideoPlayer::decodeFrame(uint8_t* dst) {
     AVFormatContext* fmt = reinterpret_cast<AVFormatContext*>(formatCtx);
     AVCodecContext* ctx = reinterpret_cast<AVCodecContext*>(codecCtx);
     AVFrame* f = reinterpret_cast<AVFrame*>(frame);
-    AVFrame* rgb = reinterpret_cast<AVFrame*>(rgbFrame);
     AVPacket* pkt = reinterpret_cast<AVPacket*>(packet);
-    SwsContext* sws = reinterpret_cast<SwsContext*>(swsCtx);
 
-    while (true) {
-        int ret = av_read_frame(fmt, pkt);
-        if (ret < 0) {
-            if (av_seek_frame(fmt, videoStreamIndex, 0, AVSEEK_FLAG_BACKWARD) >= 0) {
-                avcodec_flush_buffers(ctx);
+    // Loop the file: drain the decoder at end of stream, then seek back.
+    // Two rewinds without a frame means nothing in it decodes.
+    int emptyRewinds = 0;
+    while (!stopDecode) {
+        int ret = avcodec_receive_frame(ctx, f);
+        if (ret >= 0) {
+            if (f->width != width || f->height != height) {
+                av_frame_unref(f);
                 continue;
             }
-            return false;
+            break;
         }
-
-        if (pkt->stream_index != videoStreamIndex) {
-            av_packet_unref(pkt);
+        if (ret == AVERROR_EOF) {
+            if (++emptyRewinds > 1) return false;
+            if (av_seek_frame(fmt, videoStreamIndex, 0, AVSEEK_FLAG_BACKWARD) < 0) return false;
+            avcodec_flush_buffers(ctx);
             continue;
         }
 
-        if (avcodec_send_packet(ctx, pkt) < 0) {
-            av_packet_unref(pkt);
+        ret = av_read_frame(fmt, pkt);
+        if (ret < 0) {
+            avcodec_send_packet(ctx, nullptr);
             continue;
         }
+        if (pkt->stream_index == videoStreamIndex) {
+            avcodec_send_packet(ctx, pkt);
+        }
         av_packet_unref(pkt);
+    }
+    if (stopDecode) return false;
 
-        ret = avcodec_receive_frame(ctx, f);
-        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-            continue;
-        }
-        if (ret < 0) {
-            continue;
+    uint8_t* planes[4] = {
+        dst,
+        dst + static_cast<size_t>(width) * height,
+        dst + static_cast<size_t>(width) * height + static_cast<size_t>(chromaWidth) * chromaHeight,
+        nullptr
+    };
+    int strides[4] = {width, chromaWidth, chromaWidth, 0};
+
+    if (isPlanar420(f->format)) {
+        av_image_copy_plane(planes[0], strides[0], f->data[0], f->linesize[0], width, height);
+        av_image_copy_plane(planes[1], strides[1], f->data[1], f->linesize[1], chromaWidth, chromaHeight);
+        av_image_copy_plane(planes[2], strides[2], f->data[2], f->linesize[2], chromaWidth, chromaHeight);
+    } else {
+        SwsContext* sws = sws_getCachedContext(reinterpret_cast<SwsContext*>(swsCtx),
+                                               width, height, static_cast<AVPixelFormat>(f->format),
+                                               width, height, AV_PIX_FMT_YUV420P,
+                                               SWS_BILINEAR, nullptr, nullptr, nullptr);
+        swsCtx = sws;
+        if (!sws) {
+            av_frame_unref(f);
+            return false;
         }
+        sws_scale(sws, f->data, f->linesize, 0, height, planes, strides);
+    }
+    av_frame_unref(f);
+    return true;
+}
 
-        sws_scale(sws,
-                  f->data, f->linesize,
-                  0, ctx->height,
-                  rgb->data, rgb->linesize);
+void VideoPlayer::update(float deltaTime) {
+    if (!decodeThread.joinable()) return;
+    reclaimSlots();
 
-        uploadFrame();
-        return true;
+    accumulator += deltaTime;
+    int due = -1;
+    bool freed = false;
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        // Show the first frame as soon as it exists, then one per frameTime.
+        // If several are due, only the newest is uploaded.
+        bool first = !textureReady;
+        while (!readyQueue.empty() && (first || accumulator >= frameTime)) {
+            if (due >= 0) {
+                slots[due].state = SlotState::FREE;
+                freed = true;
+            }
+            due = readyQueue.front();
+            readyQueue.pop_front();
+            if (first) {
+                first = false;
+            } else {
+                accumulator -= frameTime;
+            }
+        }
+        // Decoder fell behind: don't fast-forward through a burst later
+        if (readyQueue.empty()) accumulator = std::min(accumulator, frameTime);
     }
+    if (freed) slotCv.notify_one();
+    if (due >= 0) presentSlot(due);
 }
 
-void VideoPlayer::uploadFrame() {
-    if (width <= 0 || height <= 0) return;
-    if (!textureId) {
-        glGenTextures(1, &textureId);
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, rgbBuffer.data());
+void VideoPlayer::reclaimSlots() {
+    if (!persistentMapping) return;
+    bool freed = false;
+    for (auto& slot : slots) {
+        if (!slot.fence) continue;
+        GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        std::lock_guard<std::mutex> lock(slotMutex);
+        slot.state = SlotState::FREE;
+        freed = true;
+    }
+    if (freed) slotCv.notify_one();
+}
+
+void VideoPlayer::presentSlot(int slot) {
+    const size_t base = persistentMapping ? slotStride * static_cast<size_t>(slot) : 0;
+    const size_t planeOffset[3] = {
+        0,
+        static_cast<size_t>(width) * height,
+        static_cast<size_t>(width) * height + static_cast<size_t>(chromaWidth) * chromaHeight
+    };
+    const int planeWidth[3] = {width, chromaWidth, chromaWidth};
+    const int planeHeight[3] = {height, chromaHeight, chromaHeight};
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    if (!persistentMapping) {
+        // Orphan so the driver never stalls on the previous frame's upload
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(frameBytes), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(frameBytes), slots[slot].data);
+    }
+
+    GLint prevAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int p = 0; p < 3; p++) {
+        glBindTexture(GL_TEXTURE_2D, planeTextures[p]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, planeWidth[p], planeHeight[p],
+                        GL_RED, GL_UNSIGNED_BYTE,
+                        reinterpret_cast<const void*>(base + planeOffset[p]));
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, prevAlignment);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        if (persistentMapping) {
+            slots[slot].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slots[slot].state = SlotState::IN_FLIGHT;
+        } else {
+            slots[slot].state = SlotState::FREE;
+        }
+    }
+    if (!persistentMapping) slotCv.notify_one();
+
+    // YUV -> RGB into the output texture
+    GLint prevViewport[4];
+    GLint prevFbo = 0;
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    GLboolean scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_SCISSOR_TEST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+    yuvShader->use();
+    for (int p = 0; p < 3; p++) {
+        glActiveTexture(GL_TEXTURE0 + p);
+        glBindTexture(GL_TEXTURE_2D, planeTextures[p]);
+    }
+    glBindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    for (int p = 2; p >= 0; p--) {
+        glActiveTexture(GL_TEXTURE0 + p);
         glBindTexture(GL_TEXTURE_2D, 0);
-        textureReady = true;
-        return;
     }
+    yuvShader->unuse();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFbo));
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+    if (blend) glEnable(GL_BLEND);
+    if (cullFace) glEnable(GL_CULL_FACE);
+    if (scissorTest) glEnable(GL_SCISSOR_TEST);
 
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
-                    GL_RGB, GL_UNSIGNED_BYTE, rgbBuffer.data());
-    glBindTexture(GL_TEXTURE_2D, 0);
     textureReady = true;
 }
 
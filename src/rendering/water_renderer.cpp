@@ -1,6 +1,7 @@
 #include "rendering/water_renderer.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/camera.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "pipeline/adt_loader.hpp"
 #include "pipeline/wmo_loader.hpp"
 #include "core/logger.hpp"
@@ -713,11 +714,11 @@ void WaterRenderer::createWaterMesh(WaterSurface& surface) {
 
     // Upload vertex data
     glBindBuffer(GL_ARRAY_BUFFER, surface.vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
 
     // Upload index data
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surface.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
 
     // Set vertex attributes
     // Position
@@ -1,6 +1,7 @@
 #include "rendering/wmo_renderer.hpp"
 #include "rendering/m2_renderer.hpp"
 #include "rendering/texture.hpp"
+#include "rendering/gpu_upload_manager.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/camera.hpp"
 #include "rendering/frustum.hpp"
@@ -244,7 +245,8 @@ void WMORenderer::shutdown() {
 
     loadedModels.clear();
     instances.clear();
-    spatialGrid.clear();
+    collisionTree_.clear();
+    shadowCasterVersion_++;
     instanceIndexById.clear();
     shader.reset();
 
@@ -514,6 +516,7 @@ void WMORenderer::unloadModel(uint32_t id) {
     }
 
     loadedModels.erase(it);
+    shadowCasterVersion_++;
     core::Logger::getInstance().info("WMO model ", id, " unloaded");
 }
 
@@ -574,15 +577,9 @@ uint32_t WMORenderer::createInstance(uint32_t modelId, const glm::vec3& position
     instances.push_back(instance);
     size_t idx = instances.size() - 1;
     instanceIndexById[instance.id] = idx;
-    GridCell minCell = toCell(instance.worldBoundsMin);
-    GridCell maxCell = toCell(instance.worldBoundsMax);
-    for (int z = minCell.z; z <= maxCell.z; z++) {
-        for (int y = minCell.y; y <= maxCell.y; y++) {
-            for (int x = minCell.x; x <= maxCell.x; x++) {
-                spatialGrid[GridCell{x, y, z}].push_back(instance.id);
-            }
-        }
-    }
+    instances[idx].bvhProxy = collisionTree_.insert(instance.worldBoundsMin, instance.worldBoundsMax,
+                                                    static_cast<uint32_t>(idx));
+    shadowCasterVersion_++;
     core::Logger::getInstance().debug("Created WMO instance ", instance.id, " (model ", modelId, ")");
     return instance.id;
 }
@@ -608,7 +605,8 @@ void WMORenderer::setInstancePosition(uint32_t instanceId, const glm::vec3& posi
             inst.worldGroupBounds.emplace_back(gMin, gMax);
         }
     }
-    rebuildSpatialIndex();
+    collisionTree_.update(inst.bvhProxy, inst.worldBoundsMin, inst.worldBoundsMax);
+    shadowCasterVersion_++;
 }
 
 void WMORenderer::setInstanceTransform(uint32_t instanceId, const glm::mat4& transform) {
@@ -660,20 +658,27 @@ void WMORenderer::setInstanceTransform(uint32_t instanceId, const glm::mat4& tra
         }
     }
 
-    // NOTE: Don't rebuild spatial index on every transform update - causes flickering
-    // Spatial grid is only used for collision queries, render iterates all instances
-    // rebuildSpatialIndex();
+    // Refit just this leaf (a containment check while a transport stays
+    // inside its fat box) rather than rebuilding the whole index.
+    collisionTree_.update(inst.bvhProxy, inst.worldBoundsMin, inst.worldBoundsMax);
+    shadowCasterVersion_++;
 }
 
-void WMORenderer::addDoodadToInstance(uint32_t instanceId, uint32_t m2InstanceId, const glm::mat4& localTransform) {
-    auto it = std::find_if(instances.begin(), instances.end(),
-                          [instanceId](const WMOInstance& inst) { return inst.id == instanceId; });
-    if (it != instances.end()) {
-        WMOInstance::DoodadInfo doodad;
-        doodad.m2InstanceId = m2InstanceId;
-        doodad.localTransform = localTransform;
-        it->doodads.push_back(doodad);
+bool WMORenderer::addDoodadToInstance(uint32_t instanceId, uint32_t m2InstanceId, const glm::mat4& localTransform) {
+    auto idxIt = instanceIndexById.find(instanceId);
+    if (idxIt == instanceIndexById.end()) return false;
+    auto& inst = instances[idxIt->second];
+
+    WMOInstance::DoodadInfo doodad;
+    doodad.m2InstanceId = m2InstanceId;
+    doodad.localTransform = localTransform;
+    inst.doodads.push_back(doodad);
+
+    // Place it now; doodads can be attached long after the instance was positioned
+    if (m2Renderer_) {
+        m2Renderer_->setInstanceTransform(m2InstanceId, inst.modelMatrix * localTransform);
     }
+    return true;
 }
 
 const std::vector<WMORenderer::DoodadTemplate>* WMORenderer::getDoodadTemplates(uint32_t modelId) const {
@@ -693,8 +698,10 @@ void WMORenderer::removeInstance(uint32_t instanceId) {
                 m2Renderer_->removeInstance(doodad.m2InstanceId);
             }
         }
+        collisionTree_.remove(it->bvhProxy);
         instances.erase(it);
-        rebuildSpatialIndex();
+        rebuildInstanceIndex();
+        shadowCasterVersion_++;
         core::Logger::getInstance().debug("Removed WMO instance ", instanceId);
     }
 }
@@ -718,13 +725,16 @@ void WMORenderer::removeInstances(const std::vector<uint32_t>& instanceIds) {
 
     const size_t oldSize = instances.size();
     instances.erase(std::remove_if(instances.begin(), instances.end(),
-                   [&toRemove](const WMOInstance& inst) {
-                       return toRemove.find(inst.id) != toRemove.end();
+                   [this, &toRemove](const WMOInstance& inst) {
+                       if (toRemove.find(inst.id) == toRemove.end()) return false;
+                       collisionTree_.remove(inst.bvhProxy);
+                       return true;
                    }),
                    instances.end());
 
     if (instances.size() != oldSize) {
-        rebuildSpatialIndex();
+        rebuildInstanceIndex();
+        shadowCasterVersion_++;
         core::Logger::getInstance().debug("Removed ", (oldSize - instances.size()),
                                           " WMO instances (batched)");
     }
@@ -739,8 +749,9 @@ void WMORenderer::clearInstances() {
         }
     }
     instances.clear();
-    spatialGrid.clear();
+    collisionTree_.clear();
     instanceIndexById.clear();
+    shadowCasterVersion_++;
     precomputedFloorGrid.clear();  // Invalidate floor cache when instances change
     core::Logger::getInstance().info("Cleared all WMO instances");
 }
@@ -915,66 +926,22 @@ void WMORenderer::precomputeFloorCache() {
                                      newEntries, " new entries, total ", precomputedFloorGrid.size());
 }
 
-WMORenderer::GridCell WMORenderer::toCell(const glm::vec3& p) const {
-    return GridCell{
-        static_cast<int>(std::floor(p.x / SPATIAL_CELL_SIZE)),
-        static_cast<int>(std::floor(p.y / SPATIAL_CELL_SIZE)),
-        static_cast<int>(std::floor(p.z / SPATIAL_CELL_SIZE))
-    };
-}
-
-void WMORenderer::rebuildSpatialIndex() {
-    spatialGrid.clear();
+void WMORenderer::rebuildInstanceIndex() {
     instanceIndexById.clear();
     instanceIndexById.reserve(instances.size());
 
     for (size_t i = 0; i < instances.size(); i++) {
         const auto& inst = instances[i];
         instanceIndexById[inst.id] = i;
-
-        GridCell minCell = toCell(inst.worldBoundsMin);
-        GridCell maxCell = toCell(inst.worldBoundsMax);
-        for (int z = minCell.z; z <= maxCell.z; z++) {
-            for (int y = minCell.y; y <= maxCell.y; y++) {
-                for (int x = minCell.x; x <= maxCell.x; x++) {
-                    spatialGrid[GridCell{x, y, z}].push_back(inst.id);
-                }
-            }
-        }
+        collisionTree_.setUserData(inst.bvhProxy, static_cast<uint32_t>(i));
     }
 }
 
 void WMORenderer::gatherCandidates(const glm::vec3& queryMin, const glm::vec3& queryMax,
-                                   std::vector<size_t>& outIndices) const {
-    outIndices.clear();
-    candidateIdScratch.clear();
-
-    GridCell minCell = toCell(queryMin);
-    GridCell maxCell = toCell(queryMax);
-    for (int z = minCell.z; z <= maxCell.z; z++) {
-        for (int y = minCell.y; y <= maxCell.y; y++) {
-            for (int x = minCell.x; x <= maxCell.x; x++) {
-                auto it = spatialGrid.find(GridCell{x, y, z});
-                if (it == spatialGrid.end()) continue;
-                for (uint32_t id : it->second) {
-                    if (!candidateIdScratch.insert(id).second) continue;
-                    auto idxIt = instanceIndexById.find(id);
-                    if (idxIt != instanceIndexById.end()) {
-                        outIndices.push_back(idxIt->second);
-                    }
-                }
-            }
-        }
-    }
-
-    // Safety fallback: if the grid misses due streaming/index drift, avoid
-    // tunneling by scanning all instances instead of returning no candidates.
-    if (outIndices.empty() && !instances.empty()) {
-        outIndices.reserve(instances.size());
-        for (size_t i = 0; i < instances.size(); i++) {
-            outIndices.push_back(i);
-        }
-    }
+                                   std::vector<uint32_t>& outIndices) const {
+    // Leaves are refit on every move and removed with their instance, so the
+    // tree never goes stale and an empty result really means nothing nearby.
+    collisionTree_.queryAABB(queryMin, queryMax, outIndices);
 }
 
 void WMORenderer::render(const Camera& camera, const glm::mat4& view, const glm::mat4& projection) {
@@ -983,6 +950,8 @@ void WMORenderer::render(const Camera& camera, const glm::mat4& view, const glm:
         return;
     }
 
+    collisionTree_.rebuildIfStale();
+
     lastDrawCalls = 0;
 
     // Set shader uniforms
@@ -1350,13 +1319,13 @@ bool WMORenderer::createGroupResources(const pipeline::WMOGroup& group, GroupRes
 
     // Upload vertex data
     glBindBuffer(GL_ARRAY_BUFFER, resources.vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexData),
-                vertices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexData),
+                    vertices.data(), GL_STATIC_DRAW);
 
     // Upload index data
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, resources.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, group.indices.size() * sizeof(uint16_t),
-                group.indices.data(), GL_STATIC_DRAW);
+    uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, group.indices.size() * sizeof(uint16_t),
+                    group.indices.data(), GL_STATIC_DRAW);
 
     // Vertex attributes
     // Position
@@ -1388,18 +1357,16 @@ bool WMORenderer::createGroupResources(const pipeline::WMOGroup& group, GroupRes
     }
     resources.collisionIndices = group.indices;
 
-    // Compute actual bounding box from vertices (WMO header bboxes can be unreliable)
-    if (!resources.collisionVertices.empty()) {
-        resources.boundingBoxMin = resources.collisionVertices[0];
-        resources.boundingBoxMax = resources.collisionVertices[0];
-        for (const auto& v : resources.collisionVertices) {
-            resources.boundingBoxMin = glm::min(resources.boundingBoxMin, v);
-            resources.boundingBoxMax = glm::max(resources.boundingBoxMax, v);
-        }
+    // 2D spatial grid for fast collision triangle lookup (cooked groups bring their own)
+    if (!group.collisionGrid.isEmpty()) {
+        resources.collisionGrid = group.collisionGrid;
+    } else {
+        resources.collisionGrid.build(resources.collisionVertices, resources.collisionIndices);
     }
 
-    // Build 2D spatial grid for fast collision triangle lookup
-    resources.buildCollisionGrid();
+    // Actual bounding box from vertices (WMO header bboxes can be unreliable)
+    resources.boundingBoxMin = resources.collisionGrid.boundsMin;
+    resources.boundingBoxMax = resources.collisionGrid.boundsMax;
 
     // Create batches
     if (!group.batches.empty()) {
@@ -1661,30 +1628,45 @@ GLuint WMORenderer::loadTexture(const std::string& path) {
         return it->second.id;
     }
 
-    // Load BLP texture
-    pipeline::BLPImage blp = assetManager->loadTexture(key);
-    if (!blp.isValid()) {
-        core::Logger::getInstance().warning("WMO: Failed to load texture: ", path);
-        // Do not cache failures as white. MPQ reads can fail transiently
-        // during streaming/contention, and caching white here permanently
-        // poisons the texture for this session.
-        return whiteTexture;
+    // Cooked DXT mip chain when available, else decode the BLP to RGBA8
+    pipeline::BLPCompressedImage dxt;
+    if (compressedTexturesSupported()) {
+        dxt = assetManager->loadCompressedTexture(key);
+    }
+    pipeline::BLPImage blp;
+    if (!dxt.isValid()) {
+        blp = assetManager->loadTexture(key);
+        if (!blp.isValid()) {
+            core::Logger::getInstance().warning("WMO: Failed to load texture: ", path);
+            // Do not cache failures as white. MPQ reads can fail transiently
+            // during streaming/contention, and caching white here permanently
+            // poisons the texture for this session.
+            return whiteTexture;
+        }
     }
+    const int width = dxt.isValid() ? dxt.width : blp.width;
+    const int height = dxt.isValid() ? dxt.height : blp.height;
 
-    core::Logger::getInstance().debug("WMO texture: ", path, " size=", blp.width, "x", blp.height);
+    core::Logger::getInstance().debug("WMO texture: ", path, " size=", width, "x", height);
 
     // Create OpenGL texture
     GLuint textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
 
-    // Upload texture data (BLP loader outputs RGBA8)
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-                 blp.width, blp.height, 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, blp.data.data());
+    size_t approxBytes = 0;
+    if (dxt.isValid()) {
+        uploadCompressedTexture(dxt);
+        for (const auto& level : dxt.levels) approxBytes += level.size();
+    } else {
+        // Upload texture data (BLP loader outputs RGBA8)
+        uploadTexImage2D(0, GL_RGBA, blp.width, blp.height, GL_RGBA, blp.data.data());
+        glGenerateMipmap(GL_TEXTURE_2D);
+        size_t base = static_cast<size_t>(blp.width) * static_cast<size_t>(blp.height) * 4ull;
+        approxBytes = base + (base / 3);
+    }
 
     // Set texture parameters with mipmaps
-    glGenerateMipmap(GL_TEXTURE_2D);
     applyAnisotropicFiltering();
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -1696,12 +1678,11 @@ GLuint WMORenderer::loadTexture(const std::string& path) {
     // Cache it
     TextureCacheEntry e;
     e.id = textureID;
-    size_t base = static_cast<size_t>(blp.width) * static_cast<size_t>(blp.height) * 4ull;
-    e.approxBytes = base + (base / 3);
+    e.approxBytes = approxBytes;
     e.lastUse = ++textureCacheCounter_;
     textureCacheBytes_ += e.approxBytes;
     textureCache[key] = e;
-    core::Logger::getInstance().debug("WMO: Loaded texture: ", path, " (", blp.width, "x", blp.height, ")");
+    core::Logger::getInstance().debug("WMO: Loaded texture: ", path, " (", width, "x", height, ")");
 
     return textureID;
 }
@@ -1845,188 +1826,22 @@ static glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a,
 
 // ---- Per-group 2D collision grid ----
 
-void WMORenderer::GroupResources::buildCollisionGrid() {
-    if (collisionVertices.empty() || collisionIndices.size() < 3) {
-        gridCellsX = 0;
-        gridCellsY = 0;
-        return;
-    }
-
-    gridOrigin = glm::vec2(boundingBoxMin.x, boundingBoxMin.y);
-    float extentX = boundingBoxMax.x - boundingBoxMin.x;
-    float extentY = boundingBoxMax.y - boundingBoxMin.y;
-
-    gridCellsX = std::max(1, static_cast<int>(std::ceil(extentX / COLLISION_CELL_SIZE)));
-    gridCellsY = std::max(1, static_cast<int>(std::ceil(extentY / COLLISION_CELL_SIZE)));
-
-    // Cap grid size to avoid excessive memory for huge groups
-    if (gridCellsX > 64) gridCellsX = 64;
-    if (gridCellsY > 64) gridCellsY = 64;
-
-    size_t totalCells = gridCellsX * gridCellsY;
-    cellTriangles.resize(totalCells);
-    cellFloorTriangles.resize(totalCells);
-    cellWallTriangles.resize(totalCells);
-
-    size_t numTriangles = collisionIndices.size() / 3;
-    triBounds.resize(numTriangles);
-
-    float invCellW = gridCellsX / std::max(0.01f, extentX);
-    float invCellH = gridCellsY / std::max(0.01f, extentY);
-
-    for (size_t i = 0; i + 2 < collisionIndices.size(); i += 3) {
-        const glm::vec3& v0 = collisionVertices[collisionIndices[i]];
-        const glm::vec3& v1 = collisionVertices[collisionIndices[i + 1]];
-        const glm::vec3& v2 = collisionVertices[collisionIndices[i + 2]];
-
-        // Triangle XY bounding box
-        float triMinX = std::min({v0.x, v1.x, v2.x});
-        float triMinY = std::min({v0.y, v1.y, v2.y});
-        float triMaxX = std::max({v0.x, v1.x, v2.x});
-        float triMaxY = std::max({v0.y, v1.y, v2.y});
-
-        // Per-triangle Z bounds
-        float triMinZ = std::min({v0.z, v1.z, v2.z});
-        float triMaxZ = std::max({v0.z, v1.z, v2.z});
-        triBounds[i / 3] = { triMinZ, triMaxZ };
-
-        // Classify floor vs wall by normal.
-        // Wall threshold matches MAX_WALK_SLOPE_DOT (cos 50° ≈ 0.6428) so that
-        // surfaces too steep to walk on are always tested for wall collision.
-        glm::vec3 edge1 = v1 - v0;
-        glm::vec3 edge2 = v2 - v0;
-        glm::vec3 normal = glm::cross(edge1, edge2);
-        float normalLen = glm::length(normal);
-        float absNz = (normalLen > 0.001f) ? std::abs(normal.z / normalLen) : 0.0f;
-        bool isFloor = (absNz >= 0.35f);  // ~70° max slope (relaxed for steep stairs)
-        bool isWall = (absNz < 0.65f);  // Matches walkable slope threshold
-
-        int cellMinX = std::max(0, static_cast<int>((triMinX - gridOrigin.x) * invCellW));
-        int cellMinY = std::max(0, static_cast<int>((triMinY - gridOrigin.y) * invCellH));
-        int cellMaxX = std::min(gridCellsX - 1, static_cast<int>((triMaxX - gridOrigin.x) * invCellW));
-        int cellMaxY = std::min(gridCellsY - 1, static_cast<int>((triMaxY - gridOrigin.y) * invCellH));
-
-        uint32_t triIdx = static_cast<uint32_t>(i);
-        for (int cy = cellMinY; cy <= cellMaxY; ++cy) {
-            for (int cx = cellMinX; cx <= cellMaxX; ++cx) {
-                int cellIdx = cy * gridCellsX + cx;
-                cellTriangles[cellIdx].push_back(triIdx);
-                if (isFloor) cellFloorTriangles[cellIdx].push_back(triIdx);
-                if (isWall) cellWallTriangles[cellIdx].push_back(triIdx);
-            }
-        }
-    }
-}
-
-const std::vector<uint32_t>* WMORenderer::GroupResources::getTrianglesAtLocal(float localX, float localY) const {
-    if (gridCellsX == 0 || gridCellsY == 0) return nullptr;
-
-    float extentX = boundingBoxMax.x - boundingBoxMin.x;
-    float extentY = boundingBoxMax.y - boundingBoxMin.y;
-    float invCellW = gridCellsX / std::max(0.01f, extentX);
-    float invCellH = gridCellsY / std::max(0.01f, extentY);
-
-    int cx = static_cast<int>((localX - gridOrigin.x) * invCellW);
-    int cy = static_cast<int>((localY - gridOrigin.y) * invCellH);
-
-    if (cx < 0 || cx >= gridCellsX || cy < 0 || cy >= gridCellsY) return nullptr;
-
-    return &cellTriangles[cy * gridCellsX + cx];
-}
-
 void WMORenderer::GroupResources::getTrianglesInRange(
         float minX, float minY, float maxX, float maxY,
         std::vector<uint32_t>& out) const {
-    out.clear();
-    if (gridCellsX == 0 || gridCellsY == 0) return;
-
-    float extentX = boundingBoxMax.x - boundingBoxMin.x;
-    float extentY = boundingBoxMax.y - boundingBoxMin.y;
-    float invCellW = gridCellsX / std::max(0.01f, extentX);
-    float invCellH = gridCellsY / std::max(0.01f, extentY);
-
-    int cellMinX = std::max(0, static_cast<int>((minX - gridOrigin.x) * invCellW));
-    int cellMinY = std::max(0, static_cast<int>((minY - gridOrigin.y) * invCellH));
-    int cellMaxX = std::min(gridCellsX - 1, static_cast<int>((maxX - gridOrigin.x) * invCellW));
-    int cellMaxY = std::min(gridCellsY - 1, static_cast<int>((maxY - gridOrigin.y) * invCellH));
-
-    if (cellMinX > cellMaxX || cellMinY > cellMaxY) return;
-
-    // Collect unique triangle indices from all overlapping cells
-    for (int cy = cellMinY; cy <= cellMaxY; ++cy) {
-        for (int cx = cellMinX; cx <= cellMaxX; ++cx) {
-            const auto& cell = cellTriangles[cy * gridCellsX + cx];
-            out.insert(out.end(), cell.begin(), cell.end());
-        }
-    }
-
-    // Remove duplicates (triangles spanning multiple cells)
-    if (cellMinX != cellMaxX || cellMinY != cellMaxY) {
-        std::sort(out.begin(), out.end());
-        out.erase(std::unique(out.begin(), out.end()), out.end());
-    }
+    collisionGrid.query(pipeline::WMOCollisionGrid::ALL, minX, minY, maxX, maxY, out);
 }
 
 void WMORenderer::GroupResources::getFloorTrianglesInRange(
         float minX, float minY, float maxX, float maxY,
         std::vector<uint32_t>& out) const {
-    out.clear();
-    if (gridCellsX == 0 || gridCellsY == 0 || cellFloorTriangles.empty()) return;
-
-    float extentX = boundingBoxMax.x - boundingBoxMin.x;
-    float extentY = boundingBoxMax.y - boundingBoxMin.y;
-    float invCellW = gridCellsX / std::max(0.01f, extentX);
-    float invCellH = gridCellsY / std::max(0.01f, extentY);
-
-    int cellMinX = std::max(0, static_cast<int>((minX - gridOrigin.x) * invCellW));
-    int cellMinY = std::max(0, static_cast<int>((minY - gridOrigin.y) * invCellH));
-    int cellMaxX = std::min(gridCellsX - 1, static_cast<int>((maxX - gridOrigin.x) * invCellW));
-    int cellMaxY = std::min(gridCellsY - 1, static_cast<int>((maxY - gridOrigin.y) * invCellH));
-
-    if (cellMinX > cellMaxX || cellMinY > cellMaxY) return;
-
-    for (int cy = cellMinY; cy <= cellMaxY; ++cy) {
-        for (int cx = cellMinX; cx <= cellMaxX; ++cx) {
-            const auto& cell = cellFloorTriangles[cy * gridCellsX + cx];
-            out.insert(out.end(), cell.begin(), cell.end());
-        }
-    }
-
-    if (cellMinX != cellMaxX || cellMinY != cellMaxY) {
-        std::sort(out.begin(), out.end());
-        out.erase(std::unique(out.begin(), out.end()), out.end());
-    }
+    collisionGrid.query(pipeline::WMOCollisionGrid::FLOOR, minX, minY, maxX, maxY, out);
 }
 
 void WMORenderer::GroupResources::getWallTrianglesInRange(
         float minX, float minY, float maxX, float maxY,
         std::vector<uint32_t>& out) const {
-    out.clear();
-    if (gridCellsX == 0 || gridCellsY == 0 || cellWallTriangles.empty()) return;
-
-    float extentX = boundingBoxMax.x - boundingBoxMin.x;
-    float extentY = boundingBoxMax.y - boundingBoxMin.y;
-    float invCellW = gridCellsX / std::max(0.01f, extentX);
-    float invCellH = gridCellsY / std::max(0.01f, extentY);
-
-    int cellMinX = std::max(0, static_cast<int>((minX - gridOrigin.x) * invCellW));
-    int cellMinY = std::max(0, static_cast<int>((minY - gridOrigin.y) * invCellH));
-    int cellMaxX = std::min(gridCellsX - 1, static_cast<int>((maxX - gridOrigin.x) * invCellW));
-    int cellMaxY = std::min(gridCellsY - 1, static_cast<int>((maxY - gridOrigin.y) * invCellH));
-
-    if (cellMinX > cellMaxX || cellMinY > cellMaxY) return;
-
-    for (int cy = cellMinY; cy <= cellMaxY; ++cy) {
-        for (int cx = cellMinX; cx <= cellMaxX; ++cx) {
-            const auto& cell = cellWallTriangles[cy * gridCellsX + cx];
-            out.insert(out.end(), cell.begin(), cell.end());
-        }
-    }
-
-    if (cellMinX != cellMaxX || cellMinY != cellMaxY) {
-        std::sort(out.begin(), out.end());
-        out.erase(std::unique(out.begin(), out.end()), out.end());
-    }
+    collisionGrid.query(pipeline::WMOCollisionGrid::WALL, minX, minY, maxX, maxY, out);
 }
 
 std::optional<float> WMORenderer::getFloorHeight(float glX, float glY, float glZ, float* outNormalZ) const {
@@ -2259,7 +2074,7 @@ bool WMORenderer::checkWallCollision(const glm::vec3& from, const glm::vec3& to,
 
             for (uint32_t triStart : wallTriScratch) {
                 // Use pre-computed Z bounds for fast vertical reject
-                const auto& tb = group.triBounds[triStart / 3];
+                const auto& tb = group.collisionGrid.triBounds[triStart / 3];
 
                 // Only collide with walls in player's vertical range
                 if (tb.maxZ < localFeetZ + 0.3f) continue;
@@ -2566,10 +2381,7 @@ float WMORenderer::raycastBoundingBoxes(const glm::vec3& origin, const glm::vec3
     constexpr float MAX_HIT_ABOVE_ORIGIN = 0.80f;
     constexpr float MIN_SURFACE_ALIGNMENT = 0.25f;
 
-    glm::vec3 rayEnd = origin + direction * maxDistance;
-    glm::vec3 queryMin = glm::min(origin, rayEnd) - glm::vec3(1.0f);
-    glm::vec3 queryMax = glm::max(origin, rayEnd) + glm::vec3(1.0f);
-    gatherCandidates(queryMin, queryMax, candidateScratch);
+    collisionTree_.queryRay(origin, direction, maxDistance, candidateScratch);
 
     for (size_t idx : candidateScratch) {
         const auto& instance = instances[idx];
@@ -25,6 +25,7 @@
 #include "pipeline/dbc_loader.hpp"
 #include "pipeline/blp_loader.hpp"
 #include "pipeline/dbc_layout.hpp"
+#include "pipeline/dbc_table.hpp"
 
 #include "game/expansion_profile.hpp"
 #include "core/logger.hpp"
@@ -2716,18 +2717,15 @@ void GameScreen::updateCharacterGeosets(game::Inventory& inventory) {
     auto* assetManager = app.getAssetManager();
 
     // Load ItemDisplayInfo.dbc for geosetGroup lookup
-    std::shared_ptr<pipeline::DBCFile> displayInfoDbc;
+    pipeline::DBCTable<pipeline::ItemDisplayInfoRecord> displayInfo;
     if (assetManager) {
-        displayInfoDbc = assetManager->loadDBC("ItemDisplayInfo.dbc");
+        displayInfo.bind(assetManager->loadDBC("ItemDisplayInfo.dbc"));
     }
 
     // Helper: get geosetGroup field for an equipped item's displayInfoId
-    // DBC binary fields: 7=geosetGroup_1, 8=geosetGroup_2, 9=geosetGroup_3
     auto getGeosetGroup = [&](uint32_t displayInfoId, int groupField) -> uint32_t {
-        if (!displayInfoDbc || displayInfoId == 0) return 0;
-        int32_t recIdx = displayInfoDbc->findRecordById(displayInfoId);
-        if (recIdx < 0) return 0;
-        return displayInfoDbc->getUInt32(static_cast<uint32_t>(recIdx), 7 + groupField);
+        if (displayInfoId == 0) return 0;
+        return displayInfo.getUInt32ById(displayInfoId, pipeline::ItemDisplayInfoRecord::geosetGroup(groupField));
     };
 
     // Helper: find first equipped item matching inventoryType, return its displayInfoId
@@ -3148,10 +3146,12 @@ void GameScreen::renderActionBar(game::GameHandler& gameHandler) {
             const auto& slot = bar[i];
             bool onCooldown = !slot.isReady();
 
-            auto getSpellName = [&](uint32_t spellId) -> std::string {
-                std::string name = spellbookScreen.lookupSpellName(spellId, assetMgr);
+            char spellNameFallback[24];
+            auto getSpellName = [&](uint32_t spellId) -> std::string_view {
+                std::string_view name = spellbookScreen.lookupSpellName(spellId, assetMgr);
                 if (!name.empty()) return name;
-                return "Spell #" + std::to_string(spellId);
+                int len = snprintf(spellNameFallback, sizeof(spellNameFallback), "Spell #%u", spellId);
+                return std::string_view(spellNameFallback, static_cast<size_t>(std::max(len, 0)));
             };
 
             // Try to get icon texture for this slot
@@ -3235,9 +3235,8 @@ void GameScreen::renderActionBar(game::GameHandler& gameHandler) {
 
                 char label[32];
                 if (slot.type == game::ActionBarSlot::SPELL) {
-                    std::string spellName = getSpellName(slot.id);
-                    if (spellName.size() > 6) spellName = spellName.substr(0, 6);
-                    snprintf(label, sizeof(label), "%s", spellName.c_str());
+                    std::string_view spellName = getSpellName(slot.id).substr(0, 6);
+                    snprintf(label, sizeof(label), "%.*s", static_cast<int>(spellName.size()), spellName.data());
                 } else if (slot.type == game::ActionBarSlot::ITEM && barItemDef) {
                     std::string itemName = barItemDef->name;
                     if (itemName.size() > 6) itemName = itemName.substr(0, 6);
@@ -3298,8 +3297,8 @@ void GameScreen::renderActionBar(game::GameHandler& gameHandler) {
             if (ImGui::IsItemHovered() && !slot.isEmpty() && slot.id != 0) {
                 ImGui::BeginTooltip();
                 if (slot.type == game::ActionBarSlot::SPELL) {
-                    std::string fullName = getSpellName(slot.id);
-                    ImGui::Text("%s", fullName.c_str());
+                    std::string_view fullName = getSpellName(slot.id);
+                    ImGui::TextUnformatted(fullName.data(), fullName.data() + fullName.size());
                     // Hearthstone: show bind point info
                     if (slot.id == 8690) {
                         uint32_t mapId = 0;
@@ -3660,9 +3659,10 @@ void GameScreen::renderCastBar(game::GameHandler& gameHandler) {
 
         char overlay[64];
         uint32_t currentSpellId = gameHandler.getCurrentCastSpellId();
-        const std::string& spellName = gameHandler.getSpellName(currentSpellId);
+        std::string_view spellName = gameHandler.getSpellName(currentSpellId);
         if (!spellName.empty())
-            snprintf(overlay, sizeof(overlay), "%s (%.1fs)", spellName.c_str(), gameHandler.getCastTimeRemaining());
+            snprintf(overlay, sizeof(overlay), "%.*s (%.1fs)", static_cast<int>(spellName.size()), spellName.data(),
+                     gameHandler.getCastTimeRemaining());
         else
             snprintf(overlay, sizeof(overlay), "Casting... (%.1fs)", gameHandler.getCastTimeRemaining());
         ImGui::ProgressBar(progress, ImVec2(-1, 20), overlay);
@@ -4145,8 +4145,13 @@ void GameScreen::renderBuffBar(game::GameHandler& gameHandler) {
 
             // Tooltip with spell name and live countdown
             if (ImGui::IsItemHovered()) {
-                std::string name = spellbookScreen.lookupSpellName(aura.spellId, assetMgr);
-                if (name.empty()) name = "Spell #" + std::to_string(aura.spellId);
+                std::string_view name = spellbookScreen.lookupSpellName(aura.spellId, assetMgr);
+                char nameFallback[24];
+                if (name.empty()) {
+                    int len = snprintf(nameFallback, sizeof(nameFallback), "Spell #%u", aura.spellId);
+                    name = std::string_view(nameFallback, static_cast<size_t>(std::max(len, 0)));
+                }
+                const int nameLen = static_cast<int>(name.size());
                 uint64_t nowMs = static_cast<uint64_t>(
                     std::chrono::duration_cast<std::chrono::milliseconds>(
                         std::chrono::steady_clock::now().time_since_epoch()).count());
@@ -4154,12 +4159,12 @@ void GameScreen::renderBuffBar(game::GameHandler& gameHandler) {
                 if (remaining > 0) {
                     int seconds = remaining / 1000;
                     if (seconds < 60) {
-                        ImGui::SetTooltip("%s (%ds)", name.c_str(), seconds);
+                        ImGui::SetTooltip("%.*s (%ds)", nameLen, name.data(), seconds);
                     } else {
-                        ImGui::SetTooltip("%s (%dm %ds)", name.c_str(), seconds / 60, seconds % 60);
+                        ImGui::SetTooltip("%.*s (%dm %ds)", nameLen, name.data(), seconds / 60, seconds % 60);
                     }
                 } else {
-                    ImGui::SetTooltip("%s", name.c_str());
+                    ImGui::SetTooltip("%.*s", nameLen, name.data());
                 }
             }
 
@@ -4982,13 +4987,15 @@ void GameScreen::renderTrainerWindow(game::GameHandler& gameHandler) {
 
                     // Spell name
                     ImGui::TableSetColumnIndex(0);
-                    const std::string& name = gameHandler.getSpellName(spell->spellId);
-                    const std::string& rank = gameHandler.getSpellRank(spell->spellId);
+                    std::string_view name = gameHandler.getSpellName(spell->spellId);
+                    std::string_view rank = gameHandler.getSpellRank(spell->spellId);
+                    const int nameLen = static_cast<int>(name.size());
                     if (!name.empty()) {
                         if (!rank.empty())
-                            ImGui::TextColored(color, "%s (%s)", name.c_str(), rank.c_str());
+                            ImGui::TextColored(color, "%.*s (%.*s)", nameLen, name.data(),
+                                               static_cast<int>(rank.size()), rank.data());
                         else
-                            ImGui::TextColored(color, "%s", name.c_str());
+                            ImGui::TextColored(color, "%.*s", nameLen, name.data());
                     } else {
                         ImGui::TextColored(color, "Spell #%u", spell->spellId);
                     }
@@ -4996,8 +5003,10 @@ void GameScreen::renderTrainerWindow(game::GameHandler& gameHandler) {
                     if (ImGui::IsItemHovered()) {
                         ImGui::BeginTooltip();
                         if (!name.empty()) {
-                            ImGui::Text("%s", name.c_str());
-                            if (!rank.empty()) ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "%s", rank.c_str());
+                            ImGui::TextUnformatted(name.data(), name.data() + name.size());
+                            if (!rank.empty())
+                                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "%.*s",
+                                                   static_cast<int>(rank.size()), rank.data());
                         }
                         ImGui::Text("Status: %s", statusLabel);
                         if (spell->reqLevel > 0) {
@@ -5008,10 +5017,11 @@ void GameScreen::renderTrainerWindow(game::GameHandler& gameHandler) {
                         auto showPrereq = [&](uint32_t node) {
                             if (node == 0) return;
                             bool met = isKnown(node);
-                            const std::string& pname = gameHandler.getSpellName(node);
+                            std::string_view pname = gameHandler.getSpellName(node);
                             ImVec4 pcolor = met ? ImVec4(0.3f, 0.9f, 0.3f, 1.0f) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
                             if (!pname.empty())
-                                ImGui::TextColored(pcolor, "Requires: %s%s", pname.c_str(), met ? " (known)" : "");
+                                ImGui::TextColored(pcolor, "Requires: %.*s%s", static_cast<int>(pname.size()), pname.data(),
+                                                   met ? " (known)" : "");
                             else
                                 ImGui::TextColored(pcolor, "Requires: Spell #%u%s", node, met ? " (known)" : "");
                         };
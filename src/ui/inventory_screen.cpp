@@ -8,6 +8,7 @@
 #include "pipeline/dbc_loader.hpp"
 #include "pipeline/blp_loader.hpp"
 #include "pipeline/dbc_layout.hpp"
+#include "pipeline/dbc_table.hpp"
 #include "core/logger.hpp"
 #include <imgui.h>
 #include <SDL2/SDL.h>
@@ -50,27 +51,16 @@ GLuint InventoryScreen::getItemIcon(uint32_t displayInfoId) {
     if (it != iconCache_.end()) return it->second;
 
     // Load ItemDisplayInfo.dbc
-    auto displayInfoDbc = assetManager_->loadDBC("ItemDisplayInfo.dbc");
-    if (!displayInfoDbc) {
-        iconCache_[displayInfoId] = 0;
-        return 0;
-    }
-
-    int32_t recIdx = displayInfoDbc->findRecordById(displayInfoId);
-    if (recIdx < 0) {
-        iconCache_[displayInfoId] = 0;
-        return 0;
-    }
-
-    // Field 5 = inventoryIcon_1
-    const auto* dispL = pipeline::getActiveDBCLayout() ? pipeline::getActiveDBCLayout()->getLayout("ItemDisplayInfo") : nullptr;
-    std::string iconName = displayInfoDbc->getString(static_cast<uint32_t>(recIdx), dispL ? (*dispL)["InventoryIcon"] : 5);
+    pipeline::DBCTable<pipeline::ItemDisplayInfoRecord> displayInfo;
+    displayInfo.bind(assetManager_->loadDBC("ItemDisplayInfo.dbc"));
+    std::string_view iconName = displayInfo.getStringById(displayInfoId, pipeline::ItemDisplayInfoRecord::InventoryIcon);
     if (iconName.empty()) {
         iconCache_[displayInfoId] = 0;
         return 0;
     }
 
-    std::string iconPath = "Interface\\Icons\\" + iconName + ".blp";
+    std::string iconPath = "Interface\\Icons\\";
+    iconPath.append(iconName).append(".blp");
     auto blpData = assetManager_->readFile(iconPath);
     if (blpData.empty()) {
         iconCache_[displayInfoId] = 0;
@@ -152,12 +142,12 @@ void InventoryScreen::updatePreviewEquipment(game::Inventory& inventory) {
 
     // --- Geosets (mirroring GameScreen::updateCharacterGeosets) ---
     auto displayInfoDbc = assetManager_->loadDBC("ItemDisplayInfo.dbc");
+    pipeline::DBCTable<pipeline::ItemDisplayInfoRecord> displayInfo;
+    displayInfo.bind(displayInfoDbc);
 
     auto getGeosetGroup = [&](uint32_t displayInfoId, int groupField) -> uint32_t {
-        if (!displayInfoDbc || displayInfoId == 0) return 0;
-        int32_t recIdx = displayInfoDbc->findRecordById(displayInfoId);
-        if (recIdx < 0) return 0;
-        return displayInfoDbc->getUInt32(static_cast<uint32_t>(recIdx), 7 + groupField);
+        if (displayInfoId == 0) return 0;
+        return displayInfo.getUInt32ById(displayInfoId, pipeline::ItemDisplayInfoRecord::geosetGroup(groupField));
     };
 
     auto findEquippedDisplayId = [&](std::initializer_list<uint8_t> types) -> uint32_t {
@@ -71,7 +71,7 @@ void SpellbookScreen::loadSpellDBC(pipeline::AssetManager* assetManager) {
     dbcLoaded = !spellData.empty();
 }
 
-std::string SpellbookScreen::lookupSpellName(uint32_t spellId, pipeline::AssetManager* assetManager) {
+std::string_view SpellbookScreen::lookupSpellName(uint32_t spellId, pipeline::AssetManager* assetManager) {
     if (!dbcLoadAttempted) {
         loadSpellDBC(assetManager);
     }
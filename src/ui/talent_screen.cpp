@@ -325,9 +325,10 @@ void TalentScreen::renderTalent(game::GameHandler& gameHandler,
         ImGui::BeginTooltip();
 
         // Spell name
-        const std::string& spellName = gameHandler.getSpellName(spellId);
+        std::string_view spellName = gameHandler.getSpellName(spellId);
         if (!spellName.empty()) {
-            ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.3f, 1.0f), "%s", spellName.c_str());
+            ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.3f, 1.0f), "%.*s",
+                               static_cast<int>(spellName.size()), spellName.data());
         } else {
             ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.3f, 1.0f), "Talent #%u", talent.talentId);
         }
@@ -367,12 +368,13 @@ void TalentScreen::renderTalent(game::GameHandler& gameHandler,
                     bool met = prereqCurrentRank >= talent.prereqRank[i];
                     ImVec4 prereqColor = met ? ImVec4(0.3f, 0.9f, 0.3f, 1.0f) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
 
-                    const std::string& prereqName = gameHandler.getSpellName(prereq->rankSpells[0]);
+                    std::string_view prereqName = gameHandler.getSpellName(prereq->rankSpells[0]);
+                    if (prereqName.empty()) prereqName = "prerequisite";
                     ImGui::Spacing();
-                    ImGui::TextColored(prereqColor, "Requires %u point%s in %s",
+                    ImGui::TextColored(prereqColor, "Requires %u point%s in %.*s",
                         talent.prereqRank[i],
                         talent.prereqRank[i] > 1 ? "s" : "",
-                        prereqName.empty() ? "prerequisite" : prereqName.c_str());
+                        static_cast<int>(prereqName.size()), prereqName.data());
                 }
             }
         }
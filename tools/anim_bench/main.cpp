@@ -0,0 +1,207 @@
+/**
+ * anim_bench - Measure skeletal pose evaluation throughput (bones/s).
+ *
+ * Usage: anim_bench [bones] [keys] [instances] [frames]
+ *
+ * Builds a synthetic M2 skeleton (binary-tree hierarchy, linear T/S tracks and
+ * slerped R tracks with `keys` keyframes over a 4 s sequence) and evaluates it
+ * for `instances` x `frames` poses with:
+ *   - legacy:    per-bone linear keyframe scan + glm::translate/toMat4/scale
+ *                composition (the code path M2Renderer used before the shared
+ *                evaluator)
+ *   - evaluator: rendering::evaluateBonePalette (cursor-cached keyframes,
+ *                SoA 3x4 composition)
+ * and reports throughput plus the largest element difference between the two.
+ */
+
+#include "rendering/animation_evaluator.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using wowee::pipeline::M2AnimationTrack;
+using wowee::pipeline::M2Bone;
+
+namespace {
+
+constexpr uint32_t kSequenceDurationMs = 4000;
+
+// --- Legacy reference path ---
+
+int legacyFindKeyframeIndex(const std::vector<uint32_t>& timestamps, float time) {
+    if (timestamps.empty()) return -1;
+    if (timestamps.size() == 1) return 0;
+    for (size_t i = 0; i < timestamps.size() - 1; i++) {
+        if (time < static_cast<float>(timestamps[i + 1])) {
+            return static_cast<int>(i);
+        }
+    }
+    return static_cast<int>(timestamps.size() - 2);
+}
+
+glm::vec3 legacyInterpVec3(const M2AnimationTrack& track, int seqIdx, float t, const glm::vec3& def) {
+    if (!track.hasData()) return def;
+    if (seqIdx < 0 || seqIdx >= static_cast<int>(track.sequences.size())) return def;
+    const auto& keys = track.sequences[seqIdx];
+    if (keys.timestamps.empty() || keys.vec3Values.empty()) return def;
+    if (keys.vec3Values.size() == 1) return keys.vec3Values[0];
+    int idx = legacyFindKeyframeIndex(keys.timestamps, t);
+    if (idx < 0) return def;
+    size_t i0 = static_cast<size_t>(idx);
+    size_t i1 = std::min(i0 + 1, keys.vec3Values.size() - 1);
+    if (i0 == i1) return keys.vec3Values[i0];
+    float t0 = static_cast<float>(keys.timestamps[i0]);
+    float t1 = static_cast<float>(keys.timestamps[i1]);
+    float dur = t1 - t0;
+    float frac = (dur > 0.0f) ? glm::clamp((t - t0) / dur, 0.0f, 1.0f) : 0.0f;
+    return glm::mix(keys.vec3Values[i0], keys.vec3Values[i1], frac);
+}
+
+glm::quat legacyInterpQuat(const M2AnimationTrack& track, int seqIdx, float t) {
+    glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
+    if (!track.hasData()) return identity;
+    if (seqIdx < 0 || seqIdx >= static_cast<int>(track.sequences.size())) return identity;
+    const auto& keys = track.sequences[seqIdx];
+    if (keys.timestamps.empty() || keys.quatValues.empty()) return identity;
+    if (keys.quatValues.size() == 1) return keys.quatValues[0];
+    int idx = legacyFindKeyframeIndex(keys.timestamps, t);
+    if (idx < 0) return identity;
+    size_t i0 = static_cast<size_t>(idx);
+    size_t i1 = std::min(i0 + 1, keys.quatValues.size() - 1);
+    if (i0 == i1) return keys.quatValues[i0];
+    float t0 = static_cast<float>(keys.timestamps[i0]);
+    float t1 = static_cast<float>(keys.timestamps[i1]);
+    float dur = t1 - t0;
+    float frac = (dur > 0.0f) ? glm::clamp((t - t0) / dur, 0.0f, 1.0f) : 0.0f;
+    return glm::slerp(keys.quatValues[i0], keys.quatValues[i1], frac);
+}
+
+void legacyComputeBones(const std::vector<M2Bone>& bones, float time, std::vector<glm::mat4>& out) {
+    out.resize(bones.size());
+    for (size_t i = 0; i < bones.size(); i++) {
+        const auto& bone = bones[i];
+        glm::vec3 trans = legacyInterpVec3(bone.translation, 0, time, glm::vec3(0.0f));
+        glm::quat rot = legacyInterpQuat(bone.rotation, 0, time);
+        glm::vec3 scl = legacyInterpVec3(bone.scale, 0, time, glm::vec3(1.0f));
+
+        glm::mat4 local = glm::translate(glm::mat4(1.0f), bone.pivot);
+        local = glm::translate(local, trans);
+        local *= glm::toMat4(rot);
+        local = glm::scale(local, scl);
+        local = glm::translate(local, -bone.pivot);
+
+        if (bone.parentBone >= 0) {
+            out[i] = out[bone.parentBone] * local;
+        } else {
+            out[i] = local;
+        }
+    }
+}
+
+// --- Synthetic skeleton ---
+
+std::vector<M2Bone> buildSkeleton(size_t numBones, size_t numKeys) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<M2Bone> bones(numBones);
+    for (size_t i = 0; i < numBones; i++) {
+        M2Bone& b = bones[i];
+        b.keyBoneId = -1;
+        b.flags = 0;
+        b.parentBone = (i == 0) ? -1 : static_cast<int16_t>((i - 1) / 2);
+        b.submeshId = 0;
+        b.pivot = glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f;
+
+        M2AnimationTrack::SequenceKeys t, r, s;
+        for (size_t k = 0; k < numKeys; k++) {
+            uint32_t ts = static_cast<uint32_t>(k * kSequenceDurationMs / std::max<size_t>(1, numKeys - 1));
+            t.timestamps.push_back(ts);
+            r.timestamps.push_back(ts);
+            s.timestamps.push_back(ts);
+            t.vec3Values.push_back(glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.1f);
+            s.vec3Values.push_back(glm::vec3(1.0f) + glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.05f);
+            glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.0f, 2.0f));
+            r.quatValues.push_back(glm::angleAxis(unit(rng) * 0.5f, axis));
+        }
+        b.translation.sequences.push_back(std::move(t));
+        b.rotation.sequences.push_back(std::move(r));
+        b.scale.sequences.push_back(std::move(s));
+    }
+    return bones;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t numBones = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 128;
+    size_t numKeys = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 60;
+    size_t numInstances = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 200;
+    size_t numFrames = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 300;
+    if (numBones == 0 || numKeys < 2 || numInstances == 0 || numFrames == 0) {
+        std::fprintf(stderr, "Usage: %s [bones>0] [keys>=2] [instances>0] [frames>0]\n", argv[0]);
+        return 1;
+    }
+
+    auto bones = buildSkeleton(numBones, numKeys);
+    const float frameMs = 1000.0f / 60.0f;
+
+    // Each instance starts at a different phase and advances at 60 Hz.
+    std::vector<float> phase(numInstances);
+    for (size_t i = 0; i < numInstances; i++) {
+        phase[i] = std::fmod(static_cast<float>(i) * 137.0f, static_cast<float>(kSequenceDurationMs));
+    }
+    auto timeAt = [&](size_t inst, size_t frame) {
+        return std::fmod(phase[inst] + frame * frameMs, static_cast<float>(kSequenceDurationMs));
+    };
+
+    std::vector<std::vector<glm::mat4>> legacyOut(numInstances);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t f = 0; f < numFrames; f++) {
+        for (size_t i = 0; i < numInstances; i++) {
+            legacyComputeBones(bones, timeAt(i, f), legacyOut[i]);
+        }
+    }
+    double legacySec = secondsSince(start);
+
+    std::vector<std::vector<glm::mat4>> evalOut(numInstances);
+    std::vector<wowee::rendering::AnimationCursor> cursors(numInstances);
+    wowee::rendering::BoneEvalOptions options;
+    start = std::chrono::steady_clock::now();
+    for (size_t f = 0; f < numFrames; f++) {
+        for (size_t i = 0; i < numInstances; i++) {
+            wowee::rendering::evaluateBonePalette(bones, numBones, 0, timeAt(i, f), options,
+                                                  cursors[i], evalOut[i]);
+        }
+    }
+    double evalSec = secondsSince(start);
+
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < numInstances; i++) {
+        for (size_t b = 0; b < numBones; b++) {
+            for (int c = 0; c < 4; c++) {
+                for (int r = 0; r < 4; r++) {
+                    maxDiff = std::max(maxDiff, std::fabs(legacyOut[i][b][c][r] - evalOut[i][b][c][r]));
+                }
+            }
+        }
+    }
+
+    double totalBones = static_cast<double>(numBones) * numInstances * numFrames;
+    std::printf("Skeleton: %zu bones, %zu keys/track, %zu instances x %zu frames\n",
+                numBones, numKeys, numInstances, numFrames);
+    std::printf("  legacy:    %8.3f s  %10.2f Mbones/s\n", legacySec, totalBones / legacySec / 1e6);
+    std::printf("  evaluator: %8.3f s  %10.2f Mbones/s  (%.2fx)\n", evalSec, totalBones / evalSec / 1e6,
+                legacySec / std::max(evalSec, 1e-9));
+    std::printf("  max |delta|: %g\n", maxDiff);
+    return 0;
+}
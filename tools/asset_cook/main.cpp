@@ -0,0 +1,300 @@
+/**
+ * asset_cook - Pre-build GPU-ready blobs for the client's asset loaders.
+ *
+ * Usage: asset_cook [--data <dir>] [--out <dir>]
+ *                   [--only textures|models|wmos|terrain]
+ *                   [--threads N] [--force] [--verbose]
+ *
+ * Reads the extracted data set in <dir> (assets.wpi pack index or
+ * manifest.json; default ./Data) and, on worker threads, runs the transforms
+ * the client would otherwise repeat on every load:
+ *   - textures: the DXT1/3/5 mip chain of each BLP2, kept compressed for
+ *     glCompressedTexImage2D (palette/ARGB BLPs are left to the runtime)
+ *   - models:   M2Loader::load + loadSkin(00.skin) -> M2Model with flat
+ *     vertex/index/collision arrays
+ *   - wmos:     WMOLoader::loadGroup for every group file of a root WMO,
+ *     plus each group's collision grid
+ *   - terrain:  TerrainMeshGenerator::generate chunk meshes per ADT
+ * Blobs go to <out> (default <dir>/cooked) and are stamped with the source
+ * size and CRC32 from the index (for M2s and WMOs, of every file they were
+ * built from); AssetManager uses a blob only while its stamp still matches,
+ * so re-running after a patch re-cooks just the files that changed.
+ */
+
+#include "pipeline/asset_manifest.hpp"
+#include "pipeline/asset_pack.hpp"
+#include "pipeline/blp_loader.hpp"
+#include "pipeline/cooked_asset.hpp"
+#include "pipeline/loose_file_reader.hpp"
+#include "pipeline/m2_loader.hpp"
+#include "pipeline/wmo_loader.hpp"
+#include "pipeline/adt_loader.hpp"
+#include "pipeline/terrain_mesh.hpp"
+#include "core/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wowee::pipeline;
+
+namespace {
+
+struct Job {
+    CookedKind kind;
+    const std::string* path;     // Normalized WoW path (owned by the index)
+    CookedSourceStamp stamp;     // WMOs: root only, groups are folded in once the root is parsed
+};
+
+bool endsWith(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// "..._NNN.wmo" is a group file, not a root
+bool isWMOGroupFile(const std::string& path) {
+    if (path.size() < 9 || !endsWith(path, ".wmo")) return false;
+    size_t u = path.size() - 8;
+    return path[u] == '_' && std::isdigit(static_cast<unsigned char>(path[u + 1])) &&
+           std::isdigit(static_cast<unsigned char>(path[u + 2])) &&
+           std::isdigit(static_cast<unsigned char>(path[u + 3]));
+}
+
+// Tile coordinates from "..._<x>_<y>.adt" (TerrainManager::getADTPath)
+bool parseADTCoord(const std::string& path, ADTCoord& coord) {
+    size_t end = path.size() - 4;
+    size_t ySep = path.rfind('_', end);
+    if (ySep == std::string::npos || ySep == 0) return false;
+    size_t xSep = path.rfind('_', ySep - 1);
+    if (xSep == std::string::npos) return false;
+    return std::sscanf(path.c_str() + xSep, "_%d_%d.adt", &coord.x, &coord.y) == 2;
+}
+
+void printUsage(const char* prog) {
+    std::printf("Usage: %s [--data <dir>] [--out <dir>] [--only textures|models|wmos|terrain]\n"
+                "          [--threads N] [--force] [--verbose]\n"
+                "\n"
+                "Cook DXT texture mip chains, skinned M2 models, WMO groups and terrain\n"
+                "meshes for the client.\n"
+                "\n"
+                "  --data <dir>     Extracted data (assets.wpi or manifest.json), default ./Data\n"
+                "  --out <dir>      Cooked output, default <data>/cooked (where the client looks)\n"
+                "  --only <kind>    Cook only textures, models, wmos or terrain\n"
+                "  --threads <N>    Worker threads (default: all cores)\n"
+                "  --force          Re-cook blobs that are already up to date\n"
+                "  --verbose        Log every cooked file\n", prog);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string dataDir = "./Data";
+    std::string outDir;
+    bool cookTextures = true, cookModels = true, cookWMOs = true, cookTerrain = true;
+    bool force = false, verbose = false;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            dataDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--only") == 0 && i + 1 < argc) {
+            std::string kind = argv[++i];
+            cookTextures = kind == "textures";
+            cookModels = kind == "models";
+            cookWMOs = kind == "wmos";
+            cookTerrain = kind == "terrain";
+            if (!cookTextures && !cookModels && !cookWMOs && !cookTerrain) {
+                std::fprintf(stderr, "Unknown --only kind: %s\n", kind.c_str());
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--force") == 0) {
+            force = true;
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (outDir.empty()) outDir = dataDir + "/cooked";
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (!verbose) wowee::core::Logger::getInstance().setLogLevel(wowee::core::LogLevel::WARNING);
+
+    // Source index: pack store preferred, like AssetManager
+    AssetPackReader pack;
+    AssetManifest manifest;
+    const std::string packIndex = dataDir + "/assets.wpi";
+    const std::string manifestPath = dataDir + "/manifest.json";
+    bool usePack = std::filesystem::exists(packIndex);
+    if (usePack ? !pack.open(packIndex) : !manifest.load(manifestPath)) {
+        std::fprintf(stderr, "No usable assets.wpi or manifest.json in %s\n", dataDir.c_str());
+        return 1;
+    }
+
+    auto stampOf = [&](const std::string& path, CookedSourceStamp& stamp) {
+        if (usePack) {
+            const auto* e = pack.lookup(path);
+            if (!e) return false;
+            stamp.size = e->blob.rawSize;
+            stamp.crc32 = e->blob.crc32;
+        } else {
+            const auto* e = manifest.lookup(path);
+            if (!e) return false;
+            stamp.size = e->size;
+            stamp.crc32 = e->crc32;
+        }
+        return true;
+    };
+    auto readSource = [&](const std::string& path) -> std::vector<uint8_t> {
+        if (usePack) {
+            const auto* e = pack.lookup(path);
+            return e ? pack.read(*e) : std::vector<uint8_t>();
+        }
+        return LooseFileReader::readFile(manifest.resolveFilesystemPath(path));
+    };
+
+    std::vector<Job> jobs;
+    auto addJob = [&](const std::string& path) {
+        Job job;
+        job.path = &path;
+        if (cookTextures && endsWith(path, ".blp")) {
+            job.kind = CookedKind::TEXTURE;
+        } else if (cookModels && endsWith(path, ".m2")) {
+            job.kind = CookedKind::M2_MODEL;
+            CookedSourceStamp skin;
+            if (stampOf(path.substr(0, path.size() - 3) + "00.skin", skin)) {
+                job.stamp.addDependency(skin.size, skin.crc32);
+            }
+        } else if (cookWMOs && endsWith(path, ".wmo") && !isWMOGroupFile(path)) {
+            job.kind = CookedKind::WMO_GROUPS;
+        } else if (cookTerrain && endsWith(path, ".adt")) {
+            job.kind = CookedKind::TERRAIN_MESH;
+        } else {
+            return;
+        }
+        stampOf(path, job.stamp);
+        jobs.push_back(job);
+    };
+    if (usePack) {
+        for (const auto& [path, entry] : pack.getEntries()) addJob(path);
+    } else {
+        for (const auto& [path, entry] : manifest.getEntries()) addJob(path);
+    }
+    // Big files first so the tail of the run stays parallel
+    std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.stamp.size > b.stamp.size; });
+
+    std::error_code ec;
+    std::filesystem::create_directories(outDir, ec);
+    CookedAssetStore store(outDir);
+    if (!store.isAvailable()) {
+        std::fprintf(stderr, "Cannot create output directory %s\n", outDir.c_str());
+        return 1;
+    }
+
+    std::printf("asset_cook: %zu candidates from %s (%s), %d threads -> %s\n", jobs.size(),
+                dataDir.c_str(), usePack ? "pack" : "loose", threads, outDir.c_str());
+
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> cooked{0}, upToDate{0}, failed{0}, bytesIn{0};
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+            const Job& job = jobs[i];
+            const std::string& path = *job.path;
+            // A WMO's stamp needs its group count, so it is checked after the root is parsed
+            if (!force && job.kind != CookedKind::WMO_GROUPS && store.isFresh(job.kind, path, job.stamp)) {
+                upToDate++;
+                continue;
+            }
+
+            std::vector<uint8_t> data = readSource(path);
+            bool ok = false;
+            if (!data.empty()) {
+                bytesIn += data.size();
+                if (job.kind == CookedKind::TEXTURE) {
+                    BLPCompressedImage image = BLPLoader::loadCompressed(data);
+                    ok = image.isValid() && store.storeTexture(path, job.stamp, image);
+                } else if (job.kind == CookedKind::M2_MODEL) {
+                    M2Model model = M2Loader::load(data);
+                    if (model.version >= 264 && job.stamp.auxSize) {
+                        auto skin = readSource(path.substr(0, path.size() - 3) + "00.skin");
+                        if (!skin.empty()) M2Loader::loadSkin(skin, model);
+                    }
+                    ok = model.isValid() && store.storeM2(path, job.stamp, model);
+                } else if (job.kind == CookedKind::WMO_GROUPS) {
+                    WMOModel model = WMOLoader::load(data);
+                    // Same stamp as AssetManager::loadWMOModel: root, then each group in order
+                    CookedSourceStamp stamp = job.stamp;
+                    for (uint32_t gi = 0; gi < model.nGroups; gi++) {
+                        CookedSourceStamp group;
+                        if (stampOf(WMOLoader::groupPath(path, gi), group)) {
+                            stamp.addDependency(group.size, group.crc32);
+                        } else {
+                            stamp.addDependency(0, 0);
+                        }
+                    }
+                    if (!force && model.nGroups > 0 && store.isFresh(job.kind, path, stamp)) {
+                        upToDate++;
+                        continue;
+                    }
+                    for (uint32_t gi = 0; gi < model.nGroups; gi++) {
+                        auto groupData = readSource(WMOLoader::groupPath(path, gi));
+                        if (groupData.empty()) continue;
+                        bytesIn += groupData.size();
+                        WMOLoader::loadGroup(groupData, model, gi);
+                    }
+                    ok = model.isValid() && store.storeWMOGroups(path, stamp, model);
+                } else {
+                    ADTTerrain terrain = ADTLoader::load(data);
+                    if (terrain.isLoaded() && parseADTCoord(path, terrain.coord)) {
+                        TerrainMesh mesh = TerrainMeshGenerator::generate(terrain);
+                        ok = store.storeTerrainMesh(path, job.stamp, mesh);
+                    }
+                }
+            }
+            if (ok) {
+                cooked++;
+                if (verbose) std::printf("  cooked %s\n", path.c_str());
+            } else {
+                failed++;
+                if (verbose) std::printf("  skipped %s (unreadable or not decodable)\n", path.c_str());
+            }
+
+            size_t done = cooked.load() + failed.load() + upToDate.load();
+            if (done % 2000 == 0) {
+                std::printf("\r  %zu / %zu", done, jobs.size());
+                std::fflush(stdout);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::printf("\r  cooked %llu, up to date %llu, skipped %llu (%.0f MB of sources) in %.1f s\n",
+                static_cast<unsigned long long>(cooked.load()),
+                static_cast<unsigned long long>(upToDate.load()),
+                static_cast<unsigned long long>(failed.load()),
+                bytesIn.load() / (1024.0 * 1024.0), secs);
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "extract_state.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace wowee {
+namespace tools {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kStateMagic = 0x54535857;  // "WXST"
+constexpr uint32_t kStateVersion = 1;
+
+class StateWriter {
+public:
+    template <typename T>
+    void pod(const T& v) {
+        const auto* p = reinterpret_cast<const char*>(&v);
+        buf.append(p, sizeof(T));
+    }
+    void string(const std::string& s) {
+        pod(static_cast<uint32_t>(s.size()));
+        buf.append(s);
+    }
+    std::string buf;
+};
+
+class StateReader {
+public:
+    explicit StateReader(const std::string& data) : p_(data.data()), end_(data.data() + data.size()) {}
+
+    template <typename T>
+    void pod(T& v) {
+        if (!ok || static_cast<size_t>(end_ - p_) < sizeof(T)) {
+            ok = false;
+            return;
+        }
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+    }
+    void string(std::string& s) {
+        uint32_t n = 0;
+        pod(n);
+        if (!ok || static_cast<size_t>(end_ - p_) < n) {
+            ok = false;
+            return;
+        }
+        s.assign(p_, n);
+        p_ += n;
+    }
+    bool ok = true;
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+} // namespace
+
+ExtractState::ArchiveId ExtractState::identify(const std::string& archivePath, const std::string& mpqDir) {
+    ArchiveId id;
+    std::error_code ec;
+    id.name = fs::path(archivePath).lexically_relative(mpqDir).generic_string();
+    if (id.name.empty()) id.name = fs::path(archivePath).filename().string();
+    id.size = fs::file_size(archivePath, ec);
+    if (ec) id.size = 0;
+    auto mtime = fs::last_write_time(archivePath, ec);
+    id.mtime = ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+    return id;
+}
+
+bool ExtractState::load(const std::string& path, bool pack) {
+    archives.clear();
+    records.clear();
+
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) return false;
+    auto size = f.tellg();
+    if (size <= 0) return false;
+    std::string data(static_cast<size_t>(size), '\0');
+    f.seekg(0);
+    if (!f.read(data.data(), size)) return false;
+
+    StateReader r(data);
+    uint32_t magic = 0, version = 0, mode = 0, archiveCount = 0, recordCount = 0;
+    r.pod(magic);
+    r.pod(version);
+    r.pod(mode);
+    if (!r.ok || magic != kStateMagic || version != kStateVersion || mode != (pack ? 1u : 0u)) {
+        return false;
+    }
+
+    r.pod(archiveCount);
+    for (uint32_t i = 0; i < archiveCount && r.ok; i++) {
+        ArchiveId id;
+        r.string(id.name);
+        r.pod(id.size);
+        r.pod(id.mtime);
+        archives.push_back(std::move(id));
+    }
+
+    r.pod(recordCount);
+    records.reserve(recordCount);
+    for (uint32_t i = 0; i < recordCount && r.ok; i++) {
+        Record rec;
+        r.string(rec.entry.wowPath);
+        r.string(rec.entry.filesystemPath);
+        r.pod(rec.entry.size);
+        r.pod(rec.entry.crc32);
+        r.pod(rec.source.archive);
+        r.pod(rec.source.hashIndex);
+        r.pod(rec.source.blockIndex);
+        r.pod(rec.source.fileSize);
+        r.pod(rec.source.compSize);
+        r.pod(rec.source.flags);
+        r.pod(rec.source.fileTime);
+        if (r.ok) {
+            std::string key = rec.entry.wowPath;
+            records.emplace(std::move(key), std::move(rec));
+        }
+    }
+
+    if (!r.ok) {
+        archives.clear();
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ExtractState::save(const std::string& path, bool pack) const {
+    StateWriter w;
+    w.buf.reserve(64 + records.size() * 96);
+    w.pod(kStateMagic);
+    w.pod(kStateVersion);
+    w.pod(static_cast<uint32_t>(pack ? 1 : 0));
+
+    w.pod(static_cast<uint32_t>(archives.size()));
+    for (const auto& id : archives) {
+        w.string(id.name);
+        w.pod(id.size);
+        w.pod(id.mtime);
+    }
+
+    w.pod(static_cast<uint32_t>(records.size()));
+    for (const auto& [key, rec] : records) {
+        w.string(rec.entry.wowPath);
+        w.string(rec.entry.filesystemPath);
+        w.pod(rec.entry.size);
+        w.pod(rec.entry.crc32);
+        w.pod(rec.source.archive);
+        w.pod(rec.source.hashIndex);
+        w.pod(rec.source.blockIndex);
+        w.pod(rec.source.fileSize);
+        w.pod(rec.source.compSize);
+        w.pod(rec.source.flags);
+        w.pod(rec.source.fileTime);
+    }
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(w.buf.data(), static_cast<std::streamsize>(w.buf.size()));
+        if (!out.good()) {
+            out.close();
+            std::error_code ec;
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+void ExtractState::remapArchives(const std::vector<ArchiveId>& current) {
+    constexpr uint32_t kGone = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(archives.size(), kGone);
+    for (size_t i = 0; i < archives.size(); i++) {
+        for (size_t j = 0; j < current.size(); j++) {
+            if (archives[i] == current[j]) {
+                remap[i] = static_cast<uint32_t>(j);
+                break;
+            }
+        }
+    }
+    for (auto& [key, rec] : records) {
+        rec.source.archive = rec.source.archive < remap.size() ? remap[rec.source.archive] : kGone;
+    }
+    archives = current;
+}
+
+} // namespace tools
+} // namespace wowee
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "manifest_writer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wowee {
+namespace tools {
+
+/**
+ * MPQ-side identity of one file: the archive that won it and that
+ * archive's hash/block table entry. Read from the enumeration pass, so no
+ * file needs to be opened to tell whether it changed.
+ */
+struct SourceStamp {
+    uint32_t archive = 0;       // Index into the run's archive table
+    uint32_t hashIndex = 0;
+    uint32_t blockIndex = 0;
+    uint32_t fileSize = 0;
+    uint32_t compSize = 0;
+    uint32_t flags = 0;
+    uint64_t fileTime = 0;
+
+    bool operator==(const SourceStamp& o) const {
+        return archive == o.archive && hashIndex == o.hashIndex && blockIndex == o.blockIndex &&
+               fileSize == o.fileSize && compSize == o.compSize && flags == o.flags &&
+               fileTime == o.fileTime;
+    }
+};
+
+/**
+ * Binary record of the previous extraction into an output directory
+ * (<output>/extract_state.bin): the archive table plus, per file, its
+ * SourceStamp and the manifest entry it produced. Lets a re-run skip files
+ * whose source entry is unchanged and rebuild the manifest without parsing
+ * manifest.json.
+ */
+class ExtractState {
+public:
+    struct ArchiveId {
+        std::string name;       // Path relative to the MPQ directory
+        uint64_t size = 0;
+        int64_t mtime = 0;
+
+        bool operator==(const ArchiveId& o) const {
+            return name == o.name && size == o.size && mtime == o.mtime;
+        }
+    };
+
+    struct Record {
+        SourceStamp source;
+        ManifestWriter::FileEntry entry;
+    };
+
+    /** Identify an archive by name, size and modification time. */
+    static ArchiveId identify(const std::string& archivePath, const std::string& mpqDir);
+
+    /**
+     * Load a state file written by save()
+     * @param pack Output mode of this run; state from the other mode is ignored
+     * @return false if missing, from another mode or unreadable
+     */
+    bool load(const std::string& path, bool pack);
+
+    /** Write atomically (temp file + rename). */
+    bool save(const std::string& path, bool pack) const;
+
+    /**
+     * Re-point record archive indices at the current archive table. Records
+     * whose archive is gone or changed get an index no file can match.
+     */
+    void remapArchives(const std::vector<ArchiveId>& current);
+
+    std::vector<ArchiveId> archives;
+    std::unordered_map<std::string, Record> records;  // Keyed by normalized WoW path
+};
+
+} // namespace tools
+} // namespace wowee
@@ -1,6 +1,7 @@
 #include "extractor.hpp"
 #include "path_mapper.hpp"
 #include "manifest_writer.hpp"
+#include "extract_state.hpp"
 
 #include <StormLib.h>
 
@@ -21,6 +22,7 @@
 #include <vector>
 
 #include "pipeline/dbc_loader.hpp"
+#include "pipeline/asset_pack.hpp"
 
 #ifndef INVALID_HANDLE_VALUE
 #define INVALID_HANDLE_VALUE ((HANDLE)(long long)-1)
@@ -31,12 +33,10 @@ namespace tools {
 
 namespace fs = std::filesystem;
 using wowee::pipeline::DBCFile;
+using wowee::pipeline::AssetPackReader;
+using wowee::pipeline::AssetPackWriter;
 
-// Archive descriptor for priority-based loading
-struct ArchiveDesc {
-    std::string path;
-    int priority;
-};
+using ArchiveDesc = Extractor::ArchiveDesc;
 
 static std::string toLowerStr(std::string s) {
     std::transform(s.begin(), s.end(), s.begin(),
@@ -139,8 +139,8 @@ static std::string csvEscape(const std::string& s) {
     return out;
 }
 
-static bool convertDbcToCsv(const std::string& dbcPath, const std::string& csvPath) {
-    auto rawData = readFileBytes(dbcPath);
+static bool convertDbcToCsv(const std::vector<uint8_t>& rawData, const std::string& dbcPath,
+                            const std::string& csvPath) {
     if (rawData.size() < 4 || std::memcmp(rawData.data(), "WDBC", 4) != 0) {
         std::cerr << "  DBC missing or not WDBC: " << dbcPath << "\n";
         return false;
@@ -326,10 +326,21 @@ static std::unordered_map<std::string, ManifestWriter::FileEntry> loadManifestEn
     return entries;
 }
 
-// Load all entry keys from a manifest.json into a set of normalized WoW paths.
+// Load all entry keys from a manifest.json (or an assets.wpi pack index)
+// into a set of normalized WoW paths.
 static std::unordered_set<std::string> loadManifestKeys(const std::string& manifestPath) {
-    auto entries = loadManifestEntries(manifestPath);
     std::unordered_set<std::string> keys;
+    if (fs::path(manifestPath).extension() == ".wpi") {
+        AssetPackReader index;
+        if (index.open(manifestPath)) {
+            keys.reserve(index.getEntryCount());
+            for (const auto& [k, v] : index.getEntries()) {
+                keys.insert(k);
+            }
+        }
+        return keys;
+    }
+    auto entries = loadManifestEntries(manifestPath);
     keys.reserve(entries.size());
     for (auto& [k, v] : entries) {
         keys.insert(k);
@@ -505,10 +516,10 @@ static std::vector<ArchiveDesc> discoverArchives(const std::string& mpqDir,
 }
 
 bool Extractor::enumerateFiles(const Options& opts,
-                               std::vector<std::string>& outFiles) {
+                               const std::vector<ArchiveDesc>& archives,
+                               std::vector<SourceFile>& outFiles) {
     // Open all archives, enumerate files from highest priority to lowest.
     // Use a set to deduplicate (highest-priority version wins).
-    auto archives = discoverArchives(opts.mpqDir, opts.expansion, opts.locale);
     if (archives.empty()) {
         std::cerr << "No MPQ archives found in: " << opts.mpqDir << "\n";
         return false;
@@ -523,6 +534,7 @@ bool Extractor::enumerateFiles(const Options& opts,
     std::vector<std::pair<std::string, std::string>> fileList; // (original name, archive path)
 
     for (auto it = archives.rbegin(); it != archives.rend(); ++it) {
+        const auto archiveIndex = static_cast<uint32_t>(std::distance(it, archives.rend()) - 1);
         HANDLE hMpq = nullptr;
         if (!SFileOpenArchive(it->path.c_str(), 0, 0, &hMpq)) {
             std::cerr << "  Failed to open: " << it->path << "\n";
@@ -553,8 +565,20 @@ bool Extractor::enumerateFiles(const Options& opts,
                     continue;
                 }
                 if (seenNormalized.insert(norm).second) {
-                    // First time seeing this file — this is the highest-priority version
-                    outFiles.push_back(fileName);
+                    // First time seeing this file — this is the highest-priority version.
+                    // The find data carries its hash/block table entry, which is all
+                    // incremental runs need to tell whether it changed.
+                    SourceFile sf;
+                    sf.wowPath = fileName;
+                    sf.stamp.archive = archiveIndex;
+                    sf.stamp.hashIndex = findData.dwHashIndex;
+                    sf.stamp.blockIndex = findData.dwBlockIndex;
+                    sf.stamp.fileSize = findData.dwFileSize;
+                    sf.stamp.compSize = findData.dwCompSize;
+                    sf.stamp.flags = findData.dwFileFlags;
+                    sf.stamp.fileTime = (static_cast<uint64_t>(findData.dwFileTimeHi) << 32) |
+                                        findData.dwFileTimeLo;
+                    outFiles.push_back(std::move(sf));
                 }
             } while (SFileFindNextFile(hFind, &findData));
             SFileFindClose(hFind);
@@ -567,14 +591,34 @@ bool Extractor::enumerateFiles(const Options& opts,
     return true;
 }
 
+// Run fn(i) for every i in [0, count) on up to numThreads threads
+template <typename Fn>
+static void parallelFor(size_t count, int numThreads, Fn&& fn) {
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < numThreads && static_cast<size_t>(t) < count; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
 bool Extractor::run(const Options& opts) {
     auto startTime = std::chrono::steady_clock::now();
 
     const std::string effectiveOutputDir = opts.outputDir;
 
     // Enumerate all unique files across all archives
-    std::vector<std::string> files;
-    if (!enumerateFiles(opts, files)) {
+    auto archives = discoverArchives(opts.mpqDir, opts.expansion, opts.locale);
+    std::vector<SourceFile> files;
+    if (!enumerateFiles(opts, archives, files)) {
         return false;
     }
 
@@ -586,8 +630,8 @@ bool Extractor::run(const Options& opts) {
         } else {
             size_t before = files.size();
             files.erase(std::remove_if(files.begin(), files.end(),
-                [&refKeys](const std::string& wowPath) {
-                    return refKeys.count(normalizeWowPath(wowPath)) > 0;
+                [&refKeys](const SourceFile& sf) {
+                    return refKeys.count(normalizeWowPath(sf.wowPath)) > 0;
                 }), files.end());
             std::cout << "Delta filter: " << before << " -> " << files.size()
                       << " files (" << (before - files.size()) << " already in reference)\n";
@@ -607,8 +651,6 @@ bool Extractor::run(const Options& opts) {
         return false;
     }
 
-    auto archives = discoverArchives(opts.mpqDir, opts.expansion, opts.locale);
-
     // Determine thread count
     int numThreads = opts.threads;
     if (numThreads <= 0) {
@@ -617,52 +659,133 @@ bool Extractor::run(const Options& opts) {
     }
 
     Stats stats;
-    std::mutex manifestMutex;
-    std::vector<ManifestWriter::FileEntry> manifestEntries;
 
-    // Partition files across threads
-    std::atomic<size_t> fileIndex{0};
-    size_t totalFiles = files.size();
-
-    auto workerFn = [&]() {
-        // Each thread opens ALL archives independently (StormLib is not thread-safe per handle).
-        // Sorted highest-priority last, so we iterate in reverse to find the winning version.
-        struct ThreadArchive {
-            HANDLE handle;
-            int priority;
-        };
-        std::vector<ThreadArchive> threadHandles;
-        for (const auto& ad : archives) {
-            HANDLE h = nullptr;
-            if (SFileOpenArchive(ad.path.c_str(), 0, 0, &h)) {
-                threadHandles.push_back({h, ad.priority});
+    // Pack mode: blobs go to the shared store, entries to <output>/assets.wpi
+    const std::string packIndexPath = effectiveOutputDir + "/assets.wpi";
+    AssetPackWriter packWriter;
+    if (opts.pack) {
+        const std::string storeDir = !opts.packStoreDir.empty()
+            ? opts.packStoreDir : effectiveOutputDir + "/packs";
+        AssetPackWriter::Options packOptions;
+        packOptions.compression = opts.packCompress
+            ? wowee::pipeline::PackCompression::ZLIB : wowee::pipeline::PackCompression::NONE;
+        if (!packWriter.open(storeDir, packIndexPath, packOptions)) {
+            std::cerr << "Failed to open pack store: " << storeDir << "\n";
+            return false;
+        }
+    }
+
+    // Previous run into this output directory: per-file archive entry stamps
+    // plus the manifest entries they produced
+    const std::string statePath = effectiveOutputDir + "/extract_state.bin";
+    std::vector<ExtractState::ArchiveId> archiveIds;
+    archiveIds.reserve(archives.size());
+    for (const auto& ad : archives) {
+        archiveIds.push_back(ExtractState::identify(ad.path, opts.mpqDir));
+    }
+    ExtractState state;
+    const bool haveState = opts.incremental && state.load(statePath, opts.pack);
+    if (haveState) {
+        state.remapArchives(archiveIds);
+    } else {
+        state.archives = archiveIds;
+        // Merge with an existing manifest so partial extractions don't nuke prior
+        // entries; without stamps these are re-extracted if enumerated again
+        std::string manifestPath = effectiveOutputDir + "/manifest.json";
+        if (!opts.pack && fs::exists(manifestPath)) {
+            auto existing = loadManifestEntries(manifestPath);
+            for (auto& [key, entry] : existing) {
+                ExtractState::Record rec;
+                rec.source.archive = UINT32_MAX;
+                rec.entry = std::move(entry);
+                state.records.emplace(key, std::move(rec));
+            }
+            if (!existing.empty()) {
+                std::cout << "Merging with existing manifest (" << existing.size() << " entries)\n";
             }
         }
-        if (threadHandles.empty()) {
-            std::cerr << "Worker thread: failed to open any archives\n";
-            return;
+    }
+
+    // Only files whose winning archive entry changed (or whose output went
+    // missing) are read from the MPQs
+    std::vector<const SourceFile*> jobs;
+    jobs.reserve(files.size());
+    for (const auto& sf : files) {
+        if (haveState) {
+            auto it = state.records.find(normalizeWowPath(sf.wowPath));
+            if (it != state.records.end() && it->second.source == sf.stamp &&
+                it->second.entry.filesystemPath == PathMapper::mapPath(sf.wowPath)) {
+                const auto& entry = it->second.entry;
+                bool present = false;
+                if (opts.pack) {
+                    present = packWriter.hasEntry(entry.wowPath, entry.crc32);
+                } else {
+                    std::error_code sizeEc;
+                    present = fs::file_size(effectiveOutputDir + "/" + entry.filesystemPath, sizeEc) == entry.size &&
+                              !sizeEc;
+                }
+                if (present) {
+                    stats.filesUnchanged++;
+                    continue;
+                }
+            }
         }
+        jobs.push_back(&sf);
+    }
+    if (haveState) {
+        std::cout << "Incremental: " << stats.filesUnchanged.load() << " unchanged, "
+                  << jobs.size() << " to extract\n";
+    }
+
+    // Archive order, then block order: sequential reads within each MPQ
+    std::sort(jobs.begin(), jobs.end(), [](const SourceFile* a, const SourceFile* b) {
+        if (a->stamp.archive != b->stamp.archive) return a->stamp.archive < b->stamp.archive;
+        return a->stamp.blockIndex < b->stamp.blockIndex;
+    });
+
+    // Partition files across threads; each thread collects its own manifest
+    // records, merged after the join
+    const size_t totalFiles = jobs.size();
+    numThreads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(numThreads, totalFiles)));
+    std::atomic<size_t> fileIndex{0};
+    std::vector<std::vector<ExtractState::Record>> threadRecords(numThreads);
+
+    auto workerFn = [&](int threadId) {
+        auto& results = threadRecords[threadId];
+
+        // StormLib is not thread-safe per handle, so each thread has its own,
+        // opened on first use: an incremental run touching one patch MPQ only
+        // opens that archive.
+        std::vector<HANDLE> handles(archives.size(), nullptr);
+        std::vector<bool> openFailed(archives.size(), false);
+        auto archiveHandle = [&](uint32_t index) -> HANDLE {
+            if (index >= handles.size()) return nullptr;
+            if (!handles[index] && !openFailed[index]) {
+                if (!SFileOpenArchive(archives[index].path.c_str(), 0, 0, &handles[index])) {
+                    handles[index] = nullptr;
+                    openFailed[index] = true;
+                    std::cerr << "Worker thread: failed to open " << archives[index].path << "\n";
+                }
+            }
+            return handles[index];
+        };
 
         while (true) {
             size_t idx = fileIndex.fetch_add(1);
             if (idx >= totalFiles) break;
 
-            const std::string& wowPath = files[idx];
+            const SourceFile& sf = *jobs[idx];
+            const std::string& wowPath = sf.wowPath;
             std::string normalized = normalizeWowPath(wowPath);
 
             // Map to new filesystem path
             std::string mappedPath = PathMapper::mapPath(wowPath);
             std::string fullOutputPath = effectiveOutputDir + "/" + mappedPath;
 
-            // Search archives in reverse priority order (highest priority first)
+            // Open from the archive that won it during enumeration
+            HANDLE hMpq = archiveHandle(sf.stamp.archive);
             HANDLE hFile = nullptr;
-            for (auto it = threadHandles.rbegin(); it != threadHandles.rend(); ++it) {
-                if (SFileOpenFileEx(it->handle, wowPath.c_str(), 0, &hFile)) {
-                    break;
-                }
-                hFile = nullptr;
-            }
-            if (!hFile) {
+            if (!hMpq || !SFileOpenFileEx(hMpq, wowPath.c_str(), 0, &hFile)) {
                 stats.filesFailed++;
                 continue;
             }
@@ -687,29 +810,34 @@ bool Extractor::run(const Options& opts) {
             // Compute CRC32
             uint32_t crc = ManifestWriter::computeCRC32(data.data(), data.size());
 
-            // Create output directory and write file
-            fs::path outPath(fullOutputPath);
-            fs::create_directories(outPath.parent_path(), ec);
-
-            std::ofstream out(fullOutputPath, std::ios::binary);
-            if (!out.is_open()) {
-                stats.filesFailed++;
-                continue;
+            if (opts.pack) {
+                if (!packWriter.add(normalized, mappedPath, data, crc)) {
+                    stats.filesFailed++;
+                    continue;
+                }
+            } else {
+                // Create output directory and write file
+                fs::path outPath(fullOutputPath);
+                std::error_code dirEc;
+                fs::create_directories(outPath.parent_path(), dirEc);
+
+                std::ofstream out(fullOutputPath, std::ios::binary);
+                if (!out.is_open()) {
+                    stats.filesFailed++;
+                    continue;
+                }
+                out.write(reinterpret_cast<const char*>(data.data()), data.size());
+                out.close();
             }
-            out.write(reinterpret_cast<const char*>(data.data()), data.size());
-            out.close();
 
             // Add manifest entry
-            ManifestWriter::FileEntry entry;
-            entry.wowPath = normalized;
-            entry.filesystemPath = mappedPath;
-            entry.size = data.size();
-            entry.crc32 = crc;
-
-            {
-                std::lock_guard<std::mutex> lock(manifestMutex);
-                manifestEntries.push_back(std::move(entry));
-            }
+            ExtractState::Record rec;
+            rec.source = sf.stamp;
+            rec.entry.wowPath = std::move(normalized);
+            rec.entry.filesystemPath = std::move(mappedPath);
+            rec.entry.size = data.size();
+            rec.entry.crc32 = crc;
+            results.push_back(std::move(rec));
 
             stats.filesExtracted++;
             stats.bytesExtracted += data.size();
@@ -722,98 +850,155 @@ bool Extractor::run(const Options& opts) {
             }
         }
 
-        for (auto& th : threadHandles) {
-            SFileCloseArchive(th.handle);
+        for (HANDLE h : handles) {
+            if (h) SFileCloseArchive(h);
         }
     };
 
-    std::cout << "Extracting " << totalFiles << " files using " << numThreads << " threads...\n";
+    if (totalFiles > 0) {
+        std::cout << "Extracting " << totalFiles << " files using " << numThreads << " threads...\n";
 
-    std::vector<std::thread> threads;
-    for (int i = 0; i < numThreads; ++i) {
-        threads.emplace_back(workerFn);
-    }
-    for (auto& t : threads) {
-        t.join();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; ++i) {
+            threads.emplace_back(workerFn, i);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
     }
 
     std::cout << "\r  Extracted " << stats.filesExtracted.load() << " files ("
               << stats.bytesExtracted.load() / (1024 * 1024) << " MB), "
+              << stats.filesUnchanged.load() << " unchanged, "
               << stats.filesSkipped.load() << " skipped, "
               << stats.filesFailed.load() << " failed\n";
 
-    // Merge with existing manifest so partial extractions don't nuke prior entries
-    std::string manifestPath = effectiveOutputDir + "/manifest.json";
-    if (fs::exists(manifestPath)) {
-        auto existing = loadManifestEntries(manifestPath);
-        if (!existing.empty()) {
-            // New entries override existing ones with same key
-            for (auto& entry : manifestEntries) {
-                existing[entry.wowPath] = entry;
+    // New entries override existing ones with same key
+    for (auto& results : threadRecords) {
+        for (auto& rec : results) {
+            std::string key = rec.entry.wowPath;
+            state.records[key] = std::move(rec);
+        }
+    }
+    threadRecords.clear();
+
+    std::mutex reportMutex;  // Serializes verification messages from worker threads
+    if (opts.pack) {
+        if (!packWriter.finish()) {
+            std::cerr << "Failed to finalize pack store\n";
+            return false;
+        }
+        const auto& ps = packWriter.getStats();
+        std::cout << "Wrote pack index: " << packIndexPath << " (" << packWriter.getEntryCount()
+                  << " entries)\n"
+                  << "  " << ps.blobsWritten.load() << " new blobs, " << ps.blobsDeduplicated.load()
+                  << " deduplicated; " << ps.rawBytes.load() / (1024 * 1024) << " MB in, "
+                  << ps.storedBytes.load() / (1024 * 1024) << " MB appended to the store\n";
+
+        // Verification pass: read every entry back through the runtime reader
+        if (opts.verify) {
+            std::cout << "Verifying packed files...\n";
+            std::atomic<uint64_t> verified{0}, verifyFailed{0};
+            AssetPackReader reader;
+            if (!reader.open(packIndexPath)) {
+                std::cerr << "  Failed to open pack index for verification\n";
+                return false;
             }
-            // Rebuild manifestEntries from merged map
-            manifestEntries.clear();
-            manifestEntries.reserve(existing.size());
-            for (auto& [k, v] : existing) {
-                manifestEntries.push_back(std::move(v));
+            std::vector<const std::pair<const std::string, AssetPackReader::Entry>*> packed;
+            packed.reserve(reader.getEntryCount());
+            for (const auto& kv : reader.getEntries()) {
+                packed.push_back(&kv);
             }
-            std::cout << "Merged with existing manifest (" << existing.size() << " total entries)\n";
+            parallelFor(packed.size(), numThreads, [&](size_t i) {
+                const auto& [key, entry] = *packed[i];
+                auto data = reader.read(entry);
+                if (data.size() != entry.blob.rawSize ||
+                    ManifestWriter::computeCRC32(data.data(), data.size()) != entry.blob.crc32) {
+                    std::lock_guard<std::mutex> lock(reportMutex);
+                    std::cerr << "  CRC MISMATCH: " << key << "\n";
+                    verifyFailed++;
+                    return;
+                }
+                verified++;
+            });
+            std::cout << "Verified " << verified.load() << " files";
+            if (verifyFailed > 0) {
+                std::cout << " (" << verifyFailed.load() << " FAILED)";
+            }
+            std::cout << "\n";
+        }
+    } else {
+        std::string manifestPath = effectiveOutputDir + "/manifest.json";
+        std::vector<ManifestWriter::FileEntry> manifestEntries;
+        manifestEntries.reserve(state.records.size());
+        for (const auto& [key, rec] : state.records) {
+            manifestEntries.push_back(rec.entry);
         }
-    }
 
-    // Sort manifest entries for deterministic output
-    std::sort(manifestEntries.begin(), manifestEntries.end(),
-              [](const ManifestWriter::FileEntry& a, const ManifestWriter::FileEntry& b) {
-                  return a.wowPath < b.wowPath;
-              });
+        // Sort manifest entries for deterministic output
+        std::sort(manifestEntries.begin(), manifestEntries.end(),
+                  [](const ManifestWriter::FileEntry& a, const ManifestWriter::FileEntry& b) {
+                      return a.wowPath < b.wowPath;
+                  });
 
-    // basePath is "." since manifest sits inside the output directory
-    if (!ManifestWriter::write(manifestPath, ".", manifestEntries)) {
-        std::cerr << "Failed to write manifest: " << manifestPath << "\n";
-        return false;
-    }
+        // basePath is "." since manifest sits inside the output directory
+        if (!ManifestWriter::write(manifestPath, ".", manifestEntries)) {
+            std::cerr << "Failed to write manifest: " << manifestPath << "\n";
+            return false;
+        }
 
-    std::cout << "Wrote manifest: " << manifestPath << " (" << manifestEntries.size() << " entries)\n";
+        std::cout << "Wrote manifest: " << manifestPath << " (" << manifestEntries.size() << " entries)\n";
+
+        // Verification pass
+        if (opts.verify) {
+            std::cout << "Verifying extracted files...\n";
+            std::atomic<uint64_t> verified{0}, verifyFailed{0};
+            parallelFor(manifestEntries.size(), numThreads, [&](size_t i) {
+                const auto& entry = manifestEntries[i];
+                std::string fsPath = effectiveOutputDir + "/" + entry.filesystemPath;
+                std::ifstream f(fsPath, std::ios::binary | std::ios::ate);
+                if (!f.is_open()) {
+                    std::lock_guard<std::mutex> lock(reportMutex);
+                    std::cerr << "  MISSING: " << fsPath << "\n";
+                    verifyFailed++;
+                    return;
+                }
 
-    // Verification pass
-    if (opts.verify) {
-        std::cout << "Verifying extracted files...\n";
-        uint64_t verified = 0, verifyFailed = 0;
-        for (const auto& entry : manifestEntries) {
-            std::string fsPath = effectiveOutputDir + "/" + entry.filesystemPath;
-            std::ifstream f(fsPath, std::ios::binary | std::ios::ate);
-            if (!f.is_open()) {
-                std::cerr << "  MISSING: " << fsPath << "\n";
-                verifyFailed++;
-                continue;
-            }
+                auto size = f.tellg();
+                if (static_cast<uint64_t>(size) != entry.size) {
+                    std::lock_guard<std::mutex> lock(reportMutex);
+                    std::cerr << "  SIZE MISMATCH: " << fsPath << " (expected "
+                              << entry.size << ", got " << size << ")\n";
+                    verifyFailed++;
+                    return;
+                }
 
-            auto size = f.tellg();
-            if (static_cast<uint64_t>(size) != entry.size) {
-                std::cerr << "  SIZE MISMATCH: " << fsPath << " (expected "
-                          << entry.size << ", got " << size << ")\n";
-                verifyFailed++;
-                continue;
-            }
+                f.seekg(0);
+                std::vector<uint8_t> data(static_cast<size_t>(size));
+                f.read(reinterpret_cast<char*>(data.data()), size);
 
-            f.seekg(0);
-            std::vector<uint8_t> data(static_cast<size_t>(size));
-            f.read(reinterpret_cast<char*>(data.data()), size);
+                uint32_t crc = ManifestWriter::computeCRC32(data.data(), data.size());
+                if (crc != entry.crc32) {
+                    std::lock_guard<std::mutex> lock(reportMutex);
+                    std::cerr << "  CRC MISMATCH: " << fsPath << "\n";
+                    verifyFailed++;
+                    return;
+                }
 
-            uint32_t crc = ManifestWriter::computeCRC32(data.data(), data.size());
-            if (crc != entry.crc32) {
-                std::cerr << "  CRC MISMATCH: " << fsPath << "\n";
-                verifyFailed++;
-                continue;
+                verified++;
+            });
+            std::cout << "Verified " << verified.load() << " files";
+            if (verifyFailed > 0) {
+                std::cout << " (" << verifyFailed.load() << " FAILED)";
             }
-
-            verified++;
+            std::cout << "\n";
         }
-        std::cout << "Verified " << verified << " files";
-        if (verifyFailed > 0) {
-            std::cout << " (" << verifyFailed << " FAILED)";
-        }
-        std::cout << "\n";
+    }
+
+    // Stamps for the next incremental run (written last, so a failed run
+    // above leaves the previous state in place)
+    if (!state.save(statePath, opts.pack)) {
+        std::cerr << "Warning: failed to write " << statePath << " (next run will be a full extraction)\n";
     }
 
     auto elapsed = std::chrono::steady_clock::now() - startTime;
@@ -827,16 +1012,29 @@ bool Extractor::run(const Options& opts) {
             ? opts.dbcCsvOutputDir
             : (opts.outputDir + "/expansions/" + csvExpansion + "/db");
 
+        AssetPackReader packedDbcs;
+        if (opts.pack) {
+            packedDbcs.open(packIndexPath);
+        }
+
         uint32_t ok = 0, fail = 0, missing = 0;
         for (const auto& base : getUsedDbcNamesForExpansion(opts.expansion)) {
             const std::string in = dbcDir + "/" + base + ".dbc";
             const std::string out = csvDir + "/" + base + ".csv";
-            if (!fs::exists(in)) {
+            std::vector<uint8_t> rawData;
+            if (opts.pack) {
+                if (const auto* entry = packedDbcs.lookup(normalizeWowPath("DBFilesClient\\" + base + ".dbc"))) {
+                    rawData = packedDbcs.read(*entry);
+                }
+            } else if (fs::exists(in)) {
+                rawData = readFileBytes(in);
+            }
+            if (rawData.empty()) {
                 std::cerr << "  Missing extracted DBC: " << in << "\n";
                 missing++;
                 continue;
             }
-            if (!convertDbcToCsv(in, out)) {
+            if (!convertDbcToCsv(rawData, in, out)) {
                 fail++;
             } else {
                 ok++;
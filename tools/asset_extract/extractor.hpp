@@ -1,5 +1,7 @@
 #pragma once
 
+#include "extract_state.hpp"
+
 #include <string>
 #include <vector>
 #include <atomic>
@@ -9,7 +11,8 @@ namespace wowee {
 namespace tools {
 
 /**
- * Extraction pipeline: MPQ archives → loose files + manifest
+ * Extraction pipeline: MPQ archives → loose files + manifest, or a
+ * content-addressed pack store + assets.wpi index (--pack)
  */
 class Extractor {
 public:
@@ -26,6 +29,10 @@ public:
         bool onlyUsedDbcs = false; // Extract only the DBC files wowee uses (implies DBFilesClient/*.dbc filter)
         std::string dbcCsvOutputDir; // When set, write CSVs into this directory instead of outputDir/expansions/<exp>/db
         std::string referenceManifest; // If set, only extract files NOT in this manifest (delta extraction)
+        bool pack = false;        // Write a pack store + assets.wpi instead of loose files + manifest.json
+        std::string packStoreDir; // Shared pack store (default: outputDir/packs)
+        bool packCompress = true; // zlib-compress blobs that shrink by at least 1/8
+        bool incremental = true;  // Skip files whose MPQ entry is unchanged since the last run
     };
 
     struct Stats {
@@ -33,6 +40,19 @@ public:
         std::atomic<uint64_t> bytesExtracted{0};
         std::atomic<uint64_t> filesSkipped{0};
         std::atomic<uint64_t> filesFailed{0};
+        std::atomic<uint64_t> filesUnchanged{0};
+    };
+
+    /** One MPQ archive, in load order. */
+    struct ArchiveDesc {
+        std::string path;
+        int priority;
+    };
+
+    /** A unique file and the archive entry that wins it. */
+    struct SourceFile {
+        std::string wowPath;
+        SourceStamp stamp;
     };
 
     /**
@@ -55,7 +75,8 @@ public:
 
 private:
     static bool enumerateFiles(const Options& opts,
-                               std::vector<std::string>& outFiles);
+                               const std::vector<ArchiveDesc>& archives,
+                               std::vector<SourceFile>& outFiles);
 };
 
 } // namespace tools
@@ -21,9 +21,17 @@ static void printUsage(const char* prog) {
               << "  --dbc-csv           Convert selected DBFilesClient/*.dbc to CSV under\n"
               << "                      <output>/expansions/<expansion>/db/*.csv (for committing)\n"
               << "  --reference-manifest <path>\n"
-              << "                      Only extract files NOT in this manifest (delta extraction)\n"
+              << "                      Only extract files NOT in this manifest or assets.wpi\n"
+              << "                      (delta extraction)\n"
+              << "  --pack              Write a packed, content-addressed store and <output>/assets.wpi\n"
+              << "                      instead of loose files and manifest.json\n"
+              << "  --pack-store <dir>  Pack store directory (default: <output>/packs). Point several\n"
+              << "                      expansions at one store to keep identical files once\n"
+              << "  --pack-no-compress  Store blobs uncompressed (default: zlib where it helps)\n"
               << "  --dbc-csv-out <dir> Write CSV DBCs into <dir> (overrides default output path)\n"
               << "  --verify            CRC32 verify all extracted files\n"
+              << "  --full              Re-extract everything instead of skipping files whose MPQ\n"
+              << "                      entry is unchanged since the last run (extract_state.bin)\n"
               << "  --threads <N>       Number of extraction threads (default: auto)\n"
               << "  --verbose           Verbose output\n"
               << "  --help              Show this help\n";
@@ -55,8 +63,17 @@ int main(int argc, char** argv) {
             opts.dbcCsvOutputDir = argv[++i];
         } else if (std::strcmp(argv[i], "--reference-manifest") == 0 && i + 1 < argc) {
             opts.referenceManifest = argv[++i];
+        } else if (std::strcmp(argv[i], "--pack") == 0) {
+            opts.pack = true;
+        } else if (std::strcmp(argv[i], "--pack-store") == 0 && i + 1 < argc) {
+            opts.packStoreDir = argv[++i];
+            opts.pack = true;
+        } else if (std::strcmp(argv[i], "--pack-no-compress") == 0) {
+            opts.packCompress = false;
         } else if (std::strcmp(argv[i], "--verify") == 0) {
             opts.verify = true;
+        } else if (std::strcmp(argv[i], "--full") == 0) {
+            opts.incremental = false;
         } else if (std::strcmp(argv[i], "--verbose") == 0) {
             opts.verbose = true;
         } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
@@ -119,6 +136,16 @@ int main(int argc, char** argv) {
         }
     }
 
+    if (opts.pack) {
+        std::cout << "Pack store:    "
+                  << (opts.packStoreDir.empty() ? opts.outputDir + "/packs" : opts.packStoreDir)
+                  << (opts.packCompress ? " (zlib)" : " (uncompressed)") << "\n";
+    }
+
+    if (!opts.incremental) {
+        std::cout << "Incremental:   off (full re-extraction)\n";
+    }
+
     if (!opts.referenceManifest.empty()) {
         std::cout << "Reference:     " << opts.referenceManifest << " (delta mode)\n";
     }
@@ -1,66 +1,208 @@
 #include "manifest_writer.hpp"
-#include <fstream>
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <zlib.h>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define WOWEE_CRC32_PCLMUL 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define WOWEE_CRC32_ARMV8 1
+#include <arm_acle.h>
+#endif
+
 namespace wowee {
 namespace tools {
 
+namespace {
+
+#if defined(WOWEE_CRC32_PCLMUL)
+// Carry-less multiply folding for the zlib (IEEE, reflected) polynomial,
+// after Intel's "Fast CRC Computation for Generic Polynomials Using
+// PCLMULQDQ". Takes and returns the non-inverted CRC register; len must be
+// at least 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1")))
+inline __m128i foldLane(__m128i acc, __m128i next, __m128i k) {
+    __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, next), lo);
+}
+
+__attribute__((target("pclmul,sse4.1")))
+uint32_t crc32Pclmul(const uint8_t* buf, size_t len, uint32_t crc) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    buf += 64;
+    len -= 64;
+
+    // Fold four 128-bit lanes in parallel
+    while (len >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x30)));
+        buf += 64;
+        len -= 64;
+    }
+
+    // Fold the four lanes into one
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = foldLane(x1, x2, k);
+    x1 = foldLane(x1, x3, k);
+    x1 = foldLane(x1, x4, k);
+    while (len >= 16) {
+        x1 = foldLane(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf)), k);
+        buf += 16;
+        len -= 16;
+    }
+
+    // 128 -> 64 bits
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+bool hasPclmul() {
+    static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+#endif
+
+// Manual JSON string escaping into an output buffer (paths only contain
+// printable characters, so only backslash and quote need care)
+void appendEscaped(std::string& out, const std::string& s) {
+    for (char c : s) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else out += c;
+    }
+}
+
+} // namespace
+
 uint32_t ManifestWriter::computeCRC32(const uint8_t* data, size_t size) {
-    return static_cast<uint32_t>(::crc32(::crc32(0L, Z_NULL, 0), data, static_cast<uInt>(size)));
+#if defined(WOWEE_CRC32_PCLMUL)
+    if (size >= 64 && hasPclmul()) {
+        size_t bulk = size & ~static_cast<size_t>(15);
+        uint32_t crc = ~crc32Pclmul(data, bulk, ~0u);
+        data += bulk;
+        size -= bulk;
+        if (size == 0) return crc;
+        return static_cast<uint32_t>(::crc32(crc, data, static_cast<uInt>(size)));
+    }
+#elif defined(WOWEE_CRC32_ARMV8)
+    uint32_t crc = ~0u;
+    for (; size >= 8; data += 8, size -= 8) {
+        uint64_t v;
+        std::memcpy(&v, data, sizeof(v));
+        crc = __crc32d(crc, v);
+    }
+    for (; size > 0; data++, size--) {
+        crc = __crc32b(crc, *data);
+    }
+    return ~crc;
+#endif
+    // zlib's crc32 takes a uInt length; feed large buffers in chunks
+    uLong crc = ::crc32(0L, Z_NULL, 0);
+    while (size > 0) {
+        uInt chunk = static_cast<uInt>(std::min<size_t>(size, 1u << 30));
+        crc = ::crc32(crc, data, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+    return static_cast<uint32_t>(crc);
 }
 
 bool ManifestWriter::write(const std::string& outputPath,
                            const std::string& basePath,
                            const std::vector<FileEntry>& entries) {
-    // Write JSON manually to avoid pulling nlohmann/json into the tool
-    // (though it would also work fine). This keeps the tool dependency-light.
-    std::ofstream file(outputPath);
-    if (!file.is_open()) {
+    // Write JSON manually to avoid pulling nlohmann/json into the tool.
+    // Lines are built into one buffer that is flushed in large blocks, and
+    // the file is written next to the target then renamed over it so an
+    // interrupted run never leaves a truncated manifest behind.
+    const std::string tmpPath = outputPath + ".tmp";
+    std::FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) {
         return false;
     }
 
-    file << "{\n";
-    file << "  \"version\": 1,\n";
-    file << "  \"basePath\": \"" << basePath << "\",\n";
-    file << "  \"fileCount\": " << entries.size() << ",\n";
-    file << "  \"entries\": {\n";
-
-    for (size_t i = 0; i < entries.size(); ++i) {
-        const auto& e = entries[i];
+    constexpr size_t kFlushThreshold = 1 << 20;
+    std::string buf;
+    buf.reserve(kFlushThreshold + 4096);
+    bool ok = true;
+    auto flush = [&]() {
+        if (!buf.empty() && std::fwrite(buf.data(), 1, buf.size(), file) != buf.size()) ok = false;
+        buf.clear();
+    };
 
-        // Escape backslashes in WoW path for JSON
-        std::string escapedKey;
-        for (char c : e.wowPath) {
-            if (c == '\\') escapedKey += "\\\\";
-            else if (c == '"') escapedKey += "\\\"";
-            else escapedKey += c;
-        }
+    buf += "{\n  \"version\": 1,\n  \"basePath\": \"";
+    appendEscaped(buf, basePath);
+    buf += "\",\n  \"fileCount\": ";
+    buf += std::to_string(entries.size());
+    buf += ",\n  \"entries\": {\n";
 
-        std::string escapedPath;
-        for (char c : e.filesystemPath) {
-            if (c == '\\') escapedPath += "\\\\";
-            else if (c == '"') escapedPath += "\\\"";
-            else escapedPath += c;
+    static const char kHex[] = "0123456789abcdef";
+    for (size_t i = 0; i < entries.size() && ok; ++i) {
+        const auto& e = entries[i];
+        buf += "    \"";
+        appendEscaped(buf, e.wowPath);
+        buf += "\": {\"p\": \"";
+        appendEscaped(buf, e.filesystemPath);
+        buf += "\", \"s\": ";
+        buf += std::to_string(e.size);
+        buf += ", \"h\": \"";
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            buf += kHex[(e.crc32 >> shift) & 0xF];
         }
-
-        // CRC32 as hex
-        std::ostringstream hexCrc;
-        hexCrc << std::hex << std::setfill('0') << std::setw(8) << e.crc32;
-
-        file << "    \"" << escapedKey << "\": {\"p\": \"" << escapedPath
-             << "\", \"s\": " << e.size
-             << ", \"h\": \"" << hexCrc.str() << "\"}";
-
-        if (i + 1 < entries.size()) file << ",";
-        file << "\n";
+        buf += "\"}";
+        if (i + 1 < entries.size()) buf += ',';
+        buf += '\n';
+        if (buf.size() >= kFlushThreshold) flush();
     }
 
-    file << "  }\n";
-    file << "}\n";
+    buf += "  }\n}\n";
+    flush();
+    if (std::fclose(file) != 0) ok = false;
 
-    return file.good();
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(tmpPath, outputPath, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        std::filesystem::remove(tmpPath, ec);
+    }
+    return ok;
 }
 
 } // namespace tools
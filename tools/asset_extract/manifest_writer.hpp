@@ -20,7 +20,7 @@ public:
     };
 
     /**
-     * Write manifest.json
+     * Write manifest.json (buffered, via a temp file renamed into place)
      * @param outputPath Full path to manifest.json
      * @param basePath Value for basePath field (e.g., "assets")
      * @param entries All extracted file entries
@@ -31,7 +31,8 @@ public:
                       const std::vector<FileEntry>& entries);
 
     /**
-     * Compute CRC32 of file data
+     * Compute CRC32 of file data (zlib polynomial). Uses PCLMULQDQ on x86
+     * or the ARMv8 CRC instructions when available, zlib otherwise.
      */
     static uint32_t computeCRC32(const uint8_t* data, size_t size);
 };
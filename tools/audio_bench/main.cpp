@@ -0,0 +1,271 @@
+/**
+ * audio_bench - Measure one-shot sound mixing cost on a null audio device.
+ *
+ * Usage: audio_bench [plays_per_second] [seconds] [radius]
+ *
+ * Runs a miniaudio engine without an output device and pulls mixed PCM by
+ * hand (ma_engine_read_pcm_frames), simulating 60 fps frames in which a
+ * burst of synthetic sounds (mixed categories, 60% positional within `radius`
+ * of the listener) is fired. The same event stream is played through:
+ *   - legacy: one heap-allocated ma_audio_buffer + ma_sound per play, reaped
+ *             by a linear scan (the code path AudioEngine used before the
+ *             voice pool)
+ *   - pool:   audio::VoicePool (fixed voices, per-category limits, distance
+ *             culling, virtual voices)
+ * and reports CPU time per frame, mix throughput and voice counts.
+ */
+
+#define MINIAUDIO_IMPLEMENTATION
+#include "audio/voice_pool.hpp"
+#include "../../extern/miniaudio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using wowee::audio::PcmClip;
+using wowee::audio::SoundCategory;
+using wowee::audio::VoicePool;
+using wowee::audio::VoiceRequest;
+
+namespace {
+
+constexpr uint32_t kEngineSampleRate = 48000;
+constexpr uint32_t kClipSampleRate = 22050;
+constexpr float kFrameSeconds = 1.0f / 60.0f;
+constexpr ma_uint64 kFramesPerTick = kEngineSampleRate / 60;
+
+PcmClip makeClip(float seconds, float frequency) {
+    PcmClip clip;
+    clip.format = ma_format_s16;
+    clip.channels = 1;
+    clip.sampleRate = kClipSampleRate;
+    clip.frames = static_cast<uint64_t>(seconds * kClipSampleRate);
+    auto pcm = std::make_shared<std::vector<uint8_t>>(clip.frames * sizeof(int16_t));
+    auto* samples = reinterpret_cast<int16_t*>(pcm->data());
+    for (uint64_t i = 0; i < clip.frames; i++) {
+        float t = static_cast<float>(i) / kClipSampleRate;
+        float envelope = std::exp(-3.0f * t / seconds);
+        samples[i] = static_cast<int16_t>(12000.0f * envelope * std::sin(6.2831853f * frequency * t));
+    }
+    clip.data = pcm;
+    return clip;
+}
+
+struct Event {
+    VoiceRequest request;
+};
+
+// Deterministic event stream shared by both modes
+std::vector<std::vector<Event>> makeEvents(const std::vector<PcmClip>& clips, int playsPerSecond,
+                                           int ticks, float radius) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<size_t> clipDist(0, clips.size() - 1);
+    const SoundCategory categories[] = {
+        SoundCategory::COMBAT, SoundCategory::COMBAT, SoundCategory::SPELL, SoundCategory::SPELL,
+        SoundCategory::FOOTSTEP, SoundCategory::FOOTSTEP, SoundCategory::AMBIENT, SoundCategory::VOICE,
+        SoundCategory::UI, SoundCategory::EFFECT,
+    };
+    std::uniform_int_distribution<size_t> categoryDist(0, sizeof(categories) / sizeof(categories[0]) - 1);
+
+    std::vector<std::vector<Event>> events(ticks);
+    double carry = 0.0;
+    for (int t = 0; t < ticks; t++) {
+        carry += playsPerSecond * kFrameSeconds;
+        int count = static_cast<int>(carry);
+        carry -= count;
+        for (int i = 0; i < count; i++) {
+            Event e;
+            e.request.clip = clips[clipDist(rng)];
+            e.request.category = categories[categoryDist(rng)];
+            e.request.volume = 0.5f + 0.5f * unit(rng);
+            e.request.positional = unit(rng) < 0.6f;
+            if (e.request.positional) {
+                float angle = unit(rng) * 6.2831853f;
+                float distance = std::sqrt(unit(rng)) * radius;
+                e.request.position = glm::vec3(std::cos(angle) * distance, std::sin(angle) * distance, 0.0f);
+                e.request.pitch = 0.95f + 0.1f * unit(rng);
+                e.request.maxDistance = 60.0f;
+            }
+            events[t].push_back(e);
+        }
+    }
+    return events;
+}
+
+// --- Legacy reference path: one allocation pair per play, unbounded ---
+
+struct LegacySound {
+    ma_sound* sound;
+    ma_audio_buffer* buffer;
+    std::shared_ptr<const std::vector<uint8_t>> pcm;
+};
+
+bool legacyPlay(ma_engine* engine, const VoiceRequest& req, std::vector<LegacySound>& active) {
+    ma_audio_buffer_config config = ma_audio_buffer_config_init(
+        static_cast<ma_format>(req.clip.format), req.clip.channels, req.clip.frames, req.clip.data->data(), nullptr);
+    config.sampleRate = req.clip.sampleRate;
+    auto* buffer = new ma_audio_buffer();
+    if (ma_audio_buffer_init(&config, buffer) != MA_SUCCESS) {
+        delete buffer;
+        return false;
+    }
+    auto* sound = new ma_sound();
+    ma_uint32 flags = MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC;
+    if (!req.positional) flags |= MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION;
+    if (ma_sound_init_from_data_source(engine, buffer, flags, nullptr, sound) != MA_SUCCESS) {
+        ma_audio_buffer_uninit(buffer);
+        delete buffer;
+        delete sound;
+        return false;
+    }
+    ma_sound_set_volume(sound, req.volume);
+    if (req.positional) {
+        ma_sound_set_position(sound, req.position.x, req.position.y, req.position.z);
+        ma_sound_set_pitch(sound, req.pitch);
+        ma_sound_set_attenuation_model(sound, ma_attenuation_model_inverse);
+        ma_sound_set_min_gain(sound, 0.0f);
+        ma_sound_set_max_gain(sound, 1.0f);
+        ma_sound_set_min_distance(sound, 1.0f);
+        ma_sound_set_max_distance(sound, req.maxDistance);
+        ma_sound_set_rolloff(sound, 1.0f);
+    }
+    ma_sound_start(sound);
+    active.push_back({sound, buffer, req.clip.data});
+    return true;
+}
+
+void legacyReap(std::vector<LegacySound>& active, bool all) {
+    for (auto it = active.begin(); it != active.end(); ) {
+        if (all || !ma_sound_is_playing(it->sound)) {
+            ma_sound_uninit(it->sound);
+            delete it->sound;
+            ma_audio_buffer_uninit(it->buffer);
+            delete it->buffer;
+            it = active.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+struct RunResult {
+    double playMs = 0.0;
+    double mixMs = 0.0;
+    double totalMs = 0.0;
+    uint32_t peakVoices = 0;
+    double avgVoices = 0.0;
+};
+
+bool initEngine(ma_engine& engine) {
+    ma_engine_config config = ma_engine_config_init();
+    config.noDevice = MA_TRUE;
+    config.channels = 2;
+    config.sampleRate = kEngineSampleRate;
+    return ma_engine_init(&config, &engine) == MA_SUCCESS;
+}
+
+template <typename PlayFn, typename TickFn, typename CountFn>
+RunResult run(ma_engine& engine, const std::vector<std::vector<Event>>& events,
+              PlayFn play, TickFn tick, CountFn countVoices) {
+    using clock = std::chrono::steady_clock;
+    std::vector<float> mixBuffer(kFramesPerTick * 2);
+    RunResult result;
+    double voiceSum = 0.0;
+    for (const auto& tickEvents : events) {
+        auto t0 = clock::now();
+        for (const Event& e : tickEvents) play(e.request);
+        tick();
+        auto t1 = clock::now();
+        ma_uint64 framesRead = 0;
+        ma_engine_read_pcm_frames(&engine, mixBuffer.data(), kFramesPerTick, &framesRead);
+        auto t2 = clock::now();
+
+        result.playMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        result.mixMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        uint32_t voices = countVoices();
+        result.peakVoices = std::max(result.peakVoices, voices);
+        voiceSum += voices;
+    }
+    result.totalMs = result.playMs + result.mixMs;
+    result.avgVoices = events.empty() ? 0.0 : voiceSum / events.size();
+    return result;
+}
+
+void printResult(const char* name, const RunResult& r, int ticks) {
+    double audioSeconds = ticks * kFrameSeconds;
+    std::printf("%-7s %8.3f ms/frame (play+reap %.3f, mix %.3f)  %7.1fx realtime  voices avg %.1f peak %u\n",
+                name, r.totalMs / ticks, r.playMs / ticks, r.mixMs / ticks,
+                audioSeconds * 1000.0 / std::max(r.mixMs, 1e-6), r.avgVoices, r.peakVoices);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int playsPerSecond = argc > 1 ? std::atoi(argv[1]) : 400;
+    float seconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 10.0f;
+    float radius = argc > 3 ? static_cast<float>(std::atof(argv[3])) : 80.0f;
+    if (playsPerSecond <= 0 || seconds <= 0.0f || radius <= 0.0f) {
+        std::fprintf(stderr, "usage: audio_bench [plays_per_second] [seconds] [radius]\n");
+        return 1;
+    }
+    const int ticks = static_cast<int>(seconds / kFrameSeconds);
+
+    std::vector<PcmClip> clips = {
+        makeClip(0.2f, 880.0f), makeClip(0.4f, 660.0f), makeClip(0.8f, 440.0f),
+        makeClip(1.5f, 330.0f), makeClip(3.0f, 220.0f), makeClip(6.0f, 110.0f),
+    };
+    auto events = makeEvents(clips, playsPerSecond, ticks, radius);
+    std::printf("audio_bench: %d plays/s, %.1f s (%d frames), radius %.0f, null device %u Hz\n",
+                playsPerSecond, seconds, ticks, radius, kEngineSampleRate);
+
+    {
+        ma_engine engine;
+        if (!initEngine(engine)) {
+            std::fprintf(stderr, "failed to initialize null-device engine\n");
+            return 1;
+        }
+        std::vector<LegacySound> active;
+        RunResult r = run(engine, events,
+            [&](const VoiceRequest& req) { legacyPlay(&engine, req, active); },
+            [&]() { legacyReap(active, false); },
+            [&]() { return static_cast<uint32_t>(active.size()); });
+        legacyReap(active, true);
+        ma_engine_uninit(&engine);
+        printResult("legacy", r, ticks);
+    }
+
+    {
+        ma_engine engine;
+        if (!initEngine(engine)) {
+            std::fprintf(stderr, "failed to initialize null-device engine\n");
+            return 1;
+        }
+        VoicePool::Stats stats;
+        RunResult r;
+        {
+            VoicePool pool(&engine);
+            pool.setListenerPosition(glm::vec3(0.0f));
+            r = run(engine, events,
+                [&](const VoiceRequest& req) { pool.play(req); },
+                [&]() { pool.update(kFrameSeconds); },
+                [&]() { return pool.getStats().realVoices; });
+            stats = pool.getStats();
+        }
+        ma_engine_uninit(&engine);
+        printResult("pool", r, ticks);
+        std::printf("        played %llu, virtualized %llu, resumed %llu, stolen %llu, dropped %llu\n",
+                    static_cast<unsigned long long>(stats.played),
+                    static_cast<unsigned long long>(stats.virtualized),
+                    static_cast<unsigned long long>(stats.resumed),
+                    static_cast<unsigned long long>(stats.stolen),
+                    static_cast<unsigned long long>(stats.dropped));
+    }
+    return 0;
+}
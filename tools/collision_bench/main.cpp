@@ -0,0 +1,313 @@
+/**
+ * collision_bench - Compare the collision broad phases (queries/s).
+ *
+ * Usage: collision_bench [instances] [queries] [moversPerFrame]
+ *
+ * Scatters `instances` doodad-sized boxes (plus a few building-sized ones)
+ * over a 4x4 ADT area and runs the query mix the renderers issue:
+ *   - box:    checkCollision-style swept player boxes
+ *   - sphere: collision-focus style radius queries
+ *   - ray:    camera-boom raycasts (origin near the ground, up to 30 units)
+ * against:
+ *   - grid: the 64-unit hash grid with unordered_set dedup that M2Renderer
+ *           and WMORenderer used before the shared BVH (rebuilt after moves)
+ *   - bvh:  rendering::DynamicBVH (rebuilt after the initial inserts, then
+ *           refit incrementally as instances move)
+ * Also times a frame of `moversPerFrame` transports/doodads moving, and
+ * checks that every true overlap found by the grid is also reported by the
+ * BVH.
+ */
+
+#include "rendering/dynamic_bvh.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using wowee::rendering::DynamicBVH;
+
+namespace {
+
+// --- Legacy reference path (hash grid) ---
+
+struct GridCell {
+    int x;
+    int y;
+    int z;
+    bool operator==(const GridCell& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+struct GridCellHash {
+    size_t operator()(const GridCell& c) const {
+        size_t h1 = std::hash<int>()(c.x);
+        size_t h2 = std::hash<int>()(c.y);
+        size_t h3 = std::hash<int>()(c.z);
+        return h1 ^ (h2 * 0x9e3779b9u) ^ (h3 * 0x85ebca6bu);
+    }
+};
+
+class LegacyGrid {
+public:
+    static constexpr float SPATIAL_CELL_SIZE = 64.0f;
+
+    void rebuild(const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxs) {
+        grid_.clear();
+        indexById_.clear();
+        indexById_.reserve(mins.size());
+        for (size_t i = 0; i < mins.size(); i++) {
+            uint32_t id = static_cast<uint32_t>(i) + 1;
+            indexById_[id] = i;
+            GridCell minCell = toCell(mins[i]);
+            GridCell maxCell = toCell(maxs[i]);
+            for (int z = minCell.z; z <= maxCell.z; z++) {
+                for (int y = minCell.y; y <= maxCell.y; y++) {
+                    for (int x = minCell.x; x <= maxCell.x; x++) {
+                        grid_[GridCell{x, y, z}].push_back(id);
+                    }
+                }
+            }
+        }
+    }
+
+    void gather(const glm::vec3& queryMin, const glm::vec3& queryMax, std::vector<size_t>& out) const {
+        out.clear();
+        seen_.clear();
+        GridCell minCell = toCell(queryMin);
+        GridCell maxCell = toCell(queryMax);
+        for (int z = minCell.z; z <= maxCell.z; z++) {
+            for (int y = minCell.y; y <= maxCell.y; y++) {
+                for (int x = minCell.x; x <= maxCell.x; x++) {
+                    auto it = grid_.find(GridCell{x, y, z});
+                    if (it == grid_.end()) continue;
+                    for (uint32_t id : it->second) {
+                        if (!seen_.insert(id).second) continue;
+                        auto idxIt = indexById_.find(id);
+                        if (idxIt != indexById_.end()) out.push_back(idxIt->second);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static GridCell toCell(const glm::vec3& p) {
+        return GridCell{
+            static_cast<int>(std::floor(p.x / SPATIAL_CELL_SIZE)),
+            static_cast<int>(std::floor(p.y / SPATIAL_CELL_SIZE)),
+            static_cast<int>(std::floor(p.z / SPATIAL_CELL_SIZE))
+        };
+    }
+
+    std::unordered_map<GridCell, std::vector<uint32_t>, GridCellHash> grid_;
+    std::unordered_map<uint32_t, size_t> indexById_;
+    mutable std::unordered_set<uint32_t> seen_;
+};
+
+// --- Query workload ---
+
+struct Query {
+    glm::vec3 a;        // Box min / sphere center / ray origin
+    glm::vec3 b;        // Box max / ray direction (unit)
+    float r = 0.0f;     // Sphere radius / ray length
+};
+
+bool boxesOverlap(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax) {
+    return aMin.x <= bMax.x && aMax.x >= bMin.x &&
+           aMin.y <= bMax.y && aMax.y >= bMin.y &&
+           aMin.z <= bMax.z && aMax.z >= bMin.z;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t numInstances = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t numQueries = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    size_t numMovers = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 32;
+    if (numInstances == 0 || numQueries == 0) {
+        std::fprintf(stderr, "Usage: %s [instances>0] [queries>0] [moversPerFrame]\n", argv[0]);
+        return 1;
+    }
+    numMovers = std::min(numMovers, numInstances);
+
+    constexpr float kWorldSize = 4.0f * 533.33333f;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> posXY(0.0f, kWorldSize);
+    std::uniform_real_distribution<float> posZ(-20.0f, 120.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<glm::vec3> mins(numInstances), maxs(numInstances);
+    for (size_t i = 0; i < numInstances; i++) {
+        glm::vec3 c(posXY(rng), posXY(rng), posZ(rng));
+        // Mostly 1-8 unit doodads, one in fifty building-sized.
+        float size = (i % 50 == 0) ? 40.0f + 120.0f * unit(rng) : 1.0f + 7.0f * unit(rng) * unit(rng);
+        glm::vec3 half(size * (0.5f + unit(rng)), size * (0.5f + unit(rng)), size);
+        mins[i] = c - half * 0.5f;
+        maxs[i] = c + half * 0.5f;
+    }
+
+    std::vector<Query> boxQueries(numQueries), sphereQueries(numQueries), rayQueries(numQueries);
+    for (size_t q = 0; q < numQueries; q++) {
+        glm::vec3 from(posXY(rng), posXY(rng), posZ(rng));
+        glm::vec3 to = from + glm::vec3(unit(rng) - 0.5f, unit(rng) - 0.5f, 0.0f);
+        boxQueries[q].a = glm::min(from, to) - glm::vec3(7.0f, 7.0f, 5.0f);
+        boxQueries[q].b = glm::max(from, to) + glm::vec3(7.0f, 7.0f, 5.0f);
+
+        sphereQueries[q].a = from;
+        sphereQueries[q].r = 4.0f + 12.0f * unit(rng);
+
+        float yaw = 6.2831853f * unit(rng);
+        float pitch = -0.6f + 1.2f * unit(rng);
+        rayQueries[q].a = from + glm::vec3(0.0f, 0.0f, 1.8f);
+        rayQueries[q].b = glm::vec3(std::cos(yaw) * std::cos(pitch), std::sin(yaw) * std::cos(pitch), std::sin(pitch));
+        rayQueries[q].r = 30.0f;
+    }
+
+    // Build
+    auto start = std::chrono::steady_clock::now();
+    LegacyGrid grid;
+    grid.rebuild(mins, maxs);
+    double gridBuildSec = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    DynamicBVH bvh(1.0f);
+    std::vector<int32_t> proxies(numInstances);
+    for (size_t i = 0; i < numInstances; i++) {
+        proxies[i] = bvh.insert(mins[i], maxs[i], static_cast<uint32_t>(i));
+    }
+    double bvhInsertSec = secondsSince(start);
+    int incrementalHeight = bvh.getHeight();
+    start = std::chrono::steady_clock::now();
+    bvh.rebuild();
+    double bvhRebuildSec = secondsSince(start);
+
+    // Queries. Both sides gather candidates, then run the first step every
+    // renderer loop does per candidate (model lookup) and a box test, so the
+    // cost of a loose candidate set shows up. The grid's sphere/ray paths
+    // query the shape's bounding box like the old renderer code did.
+    std::unordered_map<uint32_t, float> modelScale;
+    for (uint32_t m = 0; m < 512; m++) modelScale[m] = 1.0f + m * 0.001f;
+    auto narrowPhase = [&](size_t idx, const glm::vec3& qMin, const glm::vec3& qMax) {
+        auto it = modelScale.find(static_cast<uint32_t>(idx % 512));
+        return it != modelScale.end() && it->second > 0.0f && boxesOverlap(qMin, qMax, mins[idx], maxs[idx]);
+    };
+    auto queryBox = [](const Query& q, int kind, glm::vec3& qMin, glm::vec3& qMax) {
+        if (kind == 0) {
+            qMin = q.a;
+            qMax = q.b;
+        } else if (kind == 1) {
+            qMin = q.a - glm::vec3(q.r);
+            qMax = q.a + glm::vec3(q.r);
+        } else {
+            glm::vec3 end = q.a + q.b * q.r;
+            qMin = glm::min(q.a, end) - glm::vec3(1.0f);
+            qMax = glm::max(q.a, end) + glm::vec3(1.0f);
+        }
+    };
+
+    std::vector<size_t> gridOut;
+    std::vector<uint32_t> bvhOut;
+    uint64_t gridHits = 0, bvhHits = 0, gridCandidates = 0, bvhCandidates = 0;
+    size_t missed = 0;
+
+    auto runGrid = [&](const std::vector<Query>& queries, int kind) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (const auto& q : queries) {
+            glm::vec3 qMin, qMax;
+            queryBox(q, kind, qMin, qMax);
+            grid.gather(qMin, qMax, gridOut);
+            gridCandidates += gridOut.size();
+            for (size_t idx : gridOut) {
+                if (narrowPhase(idx, qMin, qMax)) gridHits++;
+            }
+        }
+        return secondsSince(t0);
+    };
+    auto runBvh = [&](const std::vector<Query>& queries, int kind) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (const auto& q : queries) {
+            glm::vec3 qMin, qMax;
+            queryBox(q, kind, qMin, qMax);
+            if (kind == 0) {
+                bvh.queryAABB(q.a, q.b, bvhOut);
+            } else if (kind == 1) {
+                bvh.querySphere(q.a, q.r, bvhOut);
+            } else {
+                bvh.queryRay(q.a, q.b, q.r, bvhOut);
+            }
+            bvhCandidates += bvhOut.size();
+            for (uint32_t idx : bvhOut) {
+                if (narrowPhase(idx, qMin, qMax)) bvhHits++;
+            }
+        }
+        return secondsSince(t0);
+    };
+
+    const char* names[] = {"box", "sphere", "ray"};
+    const std::vector<Query>* sets[] = {&boxQueries, &sphereQueries, &rayQueries};
+    std::printf("Instances: %zu, queries: %zu per kind\n", numInstances, numQueries);
+    std::printf("  build  grid: %.2f ms   bvh: %.2f ms incremental (height %d), %.2f ms rebuild (height %d)\n",
+                gridBuildSec * 1e3, bvhInsertSec * 1e3, incrementalHeight, bvhRebuildSec * 1e3, bvh.getHeight());
+    for (int kind = 0; kind < 3; kind++) {
+        gridCandidates = bvhCandidates = gridHits = bvhHits = 0;
+        double gridSec = runGrid(*sets[kind], kind);
+        double bvhSec = runBvh(*sets[kind], kind);
+        std::printf("  %-6s grid: %10.0f q/s (%5.1f cand/q)   bvh: %10.0f q/s (%5.1f cand/q)  (%.2fx)  hits %.2f / %.2f per q\n",
+                    names[kind], numQueries / gridSec, double(gridCandidates) / numQueries,
+                    numQueries / bvhSec, double(bvhCandidates) / numQueries, gridSec / std::max(bvhSec, 1e-9),
+                    double(gridHits) / numQueries, double(bvhHits) / numQueries);
+    }
+
+    // Every true box overlap the grid finds must also come out of the BVH.
+    std::vector<char> inBvh(numInstances, 0);
+    for (size_t q = 0; q < std::min<size_t>(numQueries, 20000); q++) {
+        const Query& bq = boxQueries[q];
+        grid.gather(bq.a, bq.b, gridOut);
+        bvh.queryAABB(bq.a, bq.b, bvhOut);
+        for (uint32_t idx : bvhOut) inBvh[idx] = 1;
+        for (size_t idx : gridOut) {
+            if (boxesOverlap(bq.a, bq.b, mins[idx], maxs[idx]) && !inBvh[idx]) missed++;
+        }
+        for (uint32_t idx : bvhOut) inBvh[idx] = 0;
+    }
+
+    // Moving instances: the old M2 path re-gridded everything once per frame
+    // after any move; the BVH refits only the leaves that left their fat box.
+    constexpr size_t kFrames = 120;
+    double gridMoveSec = 0.0, bvhMoveSec = 0.0;
+    size_t reinserts = 0;
+    if (numMovers > 0) {
+        for (size_t f = 0; f < kFrames; f++) {
+            for (size_t m = 0; m < numMovers; m++) {
+                size_t i = (m * 7919) % numInstances;
+                glm::vec3 step(0.25f * std::cos(f * 0.05f + m), 0.25f * std::sin(f * 0.05f + m), 0.0f);
+                mins[i] += step;
+                maxs[i] += step;
+            }
+            auto t0 = std::chrono::steady_clock::now();
+            grid.rebuild(mins, maxs);
+            gridMoveSec += secondsSince(t0);
+
+            t0 = std::chrono::steady_clock::now();
+            for (size_t m = 0; m < numMovers; m++) {
+                size_t i = (m * 7919) % numInstances;
+                if (bvh.update(proxies[i], mins[i], maxs[i])) reinserts++;
+            }
+            bvhMoveSec += secondsSince(t0);
+        }
+        std::printf("  move   grid: %8.3f ms/frame   bvh: %8.4f ms/frame (%zu movers, %zu reinserts over %zu frames)\n",
+                    gridMoveSec * 1e3 / kFrames, bvhMoveSec * 1e3 / kFrames, numMovers, reinserts, kFrames);
+    }
+
+    std::printf("  box overlaps missed by bvh: %zu%s\n", missed, missed ? "  <-- FAIL" : "");
+    return missed ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * warden_bench - Measure Warden MEM/PAGE check response latency.
+ *
+ * Usage: warden_bench [checks_per_request] [requests] [distinct_check_sets]
+ *
+ * Writes a synthetic PE32 image (several sections, a few MB) to a temp file,
+ * loads it through game::WardenMemory and replays CHEAT_CHECKS_REQUEST-sized
+ * batches of MEM_CHECK and PAGE_CHECK entries. Servers rotate through a small
+ * set of checks, so batches are drawn from `distinct_check_sets` fixed sets.
+ * Each batch does what GameHandler does per request: serve MEM reads, hash
+ * PAGE ranges, then SHA1 the result block for the checksum.
+ *
+ * Reports per-request latency for:
+ *   - direct:   HMAC-SHA1 computed for every PAGE check (no memoization)
+ *   - memoized: WardenMemory::pageMatches() with its (seed, addr, len) cache
+ * plus section-index lookup cost.
+ */
+
+#include "game/warden_memory.hpp"
+#include "auth/crypto.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using wowee::game::WardenMemory;
+using wowee::auth::Crypto;
+
+namespace {
+
+constexpr uint32_t kImageBase = 0x00400000;
+
+struct SectionSpec {
+    const char* name;
+    uint32_t rva;
+    uint32_t size;
+};
+
+const SectionSpec kSections[] = {
+    {".text",  0x00001000, 0x00500000},
+    {".rdata", 0x00501000, 0x00100000},
+    {".data",  0x00601000, 0x00080000},
+    {".rsrc",  0x00681000, 0x00020000},
+};
+
+void put16(std::vector<uint8_t>& b, size_t at, uint16_t v) {
+    b[at] = v & 0xFF; b[at + 1] = v >> 8;
+}
+void put32(std::vector<uint8_t>& b, size_t at, uint32_t v) {
+    for (int i = 0; i < 4; i++) b[at + i] = (v >> (8 * i)) & 0xFF;
+}
+
+// Minimal PE32: DOS stub, COFF, optional header, section table, raw data
+std::vector<uint8_t> makePE(std::mt19937& rng) {
+    const uint32_t headerSize = 0x1000;
+    const size_t numSections = sizeof(kSections) / sizeof(kSections[0]);
+    uint32_t fileSize = headerSize;
+    for (const auto& s : kSections) fileSize += s.size;
+
+    std::vector<uint8_t> pe(fileSize, 0);
+    pe[0] = 'M'; pe[1] = 'Z';
+    const uint32_t peOfs = 0x80;
+    put32(pe, 0x3C, peOfs);
+    pe[peOfs] = 'P'; pe[peOfs + 1] = 'E';
+
+    const size_t coff = peOfs + 4;
+    put16(pe, coff + 0, 0x014C);                      // i386
+    put16(pe, coff + 2, static_cast<uint16_t>(numSections));
+    put16(pe, coff + 16, 224);                        // SizeOfOptionalHeader
+
+    const size_t opt = coff + 20;
+    put16(pe, opt, 0x10B);                            // PE32
+    put32(pe, opt + 28, kImageBase);
+    const auto& last = kSections[numSections - 1];
+    put32(pe, opt + 56, last.rva + last.size);        // SizeOfImage
+    put32(pe, opt + 60, headerSize);                  // SizeOfHeaders
+
+    size_t secTable = opt + 224;
+    uint32_t raw = headerSize;
+    for (size_t i = 0; i < numSections; i++) {
+        size_t at = secTable + i * 40;
+        std::memcpy(pe.data() + at, kSections[i].name, std::strlen(kSections[i].name));
+        put32(pe, at + 8, kSections[i].size);
+        put32(pe, at + 12, kSections[i].rva);
+        put32(pe, at + 16, kSections[i].size);
+        put32(pe, at + 20, raw);
+        for (uint32_t j = 0; j < kSections[i].size; j += 4) {
+            put32(pe, raw + j, rng());
+        }
+        raw += kSections[i].size;
+    }
+    return pe;
+}
+
+struct Check {
+    bool page;
+    uint32_t seed;
+    uint32_t va;
+    uint8_t length;
+    uint8_t expected[20];
+};
+
+// HMAC-SHA1 of the range keyed by the seed, computed from scratch
+bool directHash(const WardenMemory& mem, const Check& c, uint8_t out[20]) {
+    uint8_t buf[256];
+    if (!mem.readMemory(c.va, c.length, buf)) return false;
+    std::vector<uint8_t> key = {
+        static_cast<uint8_t>(c.seed), static_cast<uint8_t>(c.seed >> 8),
+        static_cast<uint8_t>(c.seed >> 16), static_cast<uint8_t>(c.seed >> 24),
+    };
+    auto h = Crypto::hmacSHA1(key, std::vector<uint8_t>(buf, buf + c.length));
+    std::memcpy(out, h.data(), 20);
+    return true;
+}
+
+std::vector<Check> makeCheckSet(const WardenMemory& mem, std::mt19937& rng, int count) {
+    std::uniform_int_distribution<size_t> sectionDist(0, sizeof(kSections) / sizeof(kSections[0]) - 1);
+    std::vector<Check> checks(count);
+    for (auto& c : checks) {
+        const auto& sec = kSections[sectionDist(rng)];
+        c.page = (rng() % 3) != 0;                     // ~2/3 page checks
+        c.seed = rng();
+        c.length = c.page ? static_cast<uint8_t>(16 + rng() % 48) : static_cast<uint8_t>(1 + rng() % 32);
+        c.va = kImageBase + sec.rva + static_cast<uint32_t>(rng() % (sec.size - 256));
+        if (c.page) {
+            // Half of the page checks look for bytes that really are there
+            if (rng() & 1) {
+                directHash(mem, c, c.expected);
+            } else {
+                for (auto& b : c.expected) b = static_cast<uint8_t>(rng());
+            }
+        }
+    }
+    return checks;
+}
+
+template <typename PageFn>
+std::vector<double> run(const WardenMemory& mem, const std::vector<std::vector<Check>>& sets,
+                        int requests, PageFn pageMatches, uint32_t& foundOut) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> latencies;
+    latencies.reserve(requests);
+    uint32_t found = 0;
+    for (int r = 0; r < requests; r++) {
+        const auto& checks = sets[r % sets.size()];
+        auto t0 = clock::now();
+        std::vector<uint8_t> resultData;
+        resultData.reserve(checks.size() * 33);
+        for (const Check& c : checks) {
+            if (c.page) {
+                bool hit = pageMatches(c);
+                found += hit;
+                resultData.push_back(hit ? 0x4A : 0x00);
+            } else {
+                uint8_t buf[256];
+                bool ok = mem.readMemory(c.va, c.length, buf);
+                resultData.push_back(0x00);
+                resultData.insert(resultData.end(), buf, buf + (ok ? c.length : 0));
+            }
+        }
+        auto checksum = Crypto::sha1(resultData);
+        auto t1 = clock::now();
+        found += checksum.empty();  // keep the hash live
+        latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    foundOut = found;
+    return latencies;
+}
+
+void report(const char* name, std::vector<double> lat) {
+    double first = lat.front();
+    std::sort(lat.begin(), lat.end());
+    double sum = 0.0;
+    for (double v : lat) sum += v;
+    auto pct = [&](double p) { return lat[std::min(lat.size() - 1, static_cast<size_t>(p * lat.size()))]; };
+    std::printf("%-9s first %8.1f us  mean %7.2f us  p50 %7.2f us  p99 %7.2f us  max %8.1f us\n",
+                name, first, sum / lat.size(), pct(0.50), pct(0.99), lat.back());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int checksPerRequest = argc > 1 ? std::atoi(argv[1]) : 24;
+    int requests = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int distinctSets = argc > 3 ? std::atoi(argv[3]) : 8;
+    if (checksPerRequest <= 0 || requests <= 0 || distinctSets <= 0) {
+        std::fprintf(stderr, "usage: warden_bench [checks_per_request] [requests] [distinct_check_sets]\n");
+        return 1;
+    }
+
+    std::mt19937 rng(4242);
+    std::string path = (std::filesystem::temp_directory_path() / "warden_bench_image.exe").string();
+    {
+        std::vector<uint8_t> pe = makePE(rng);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(pe.data()), pe.size());
+    }
+
+    WardenMemory mem;
+    bool loaded = mem.loadFromFile(path);
+    std::filesystem::remove(path);
+    if (!loaded) {
+        std::fprintf(stderr, "failed to load synthetic PE image\n");
+        return 1;
+    }
+
+    std::vector<std::vector<Check>> sets;
+    for (int i = 0; i < distinctSets; i++) sets.push_back(makeCheckSet(mem, rng, checksPerRequest));
+
+    std::printf("warden_bench: %d checks/request, %d requests, %d distinct check sets, %zu sections\n",
+                checksPerRequest, requests, distinctSets, mem.getSections().size());
+
+    // Section index lookups
+    {
+        using clock = std::chrono::steady_clock;
+        const int lookups = 1000000;
+        uint32_t hits = 0;
+        auto t0 = clock::now();
+        for (int i = 0; i < lookups; i++) {
+            hits += mem.findSection(kImageBase + static_cast<uint32_t>(rng() % 0x6A0000)) != nullptr;
+        }
+        auto t1 = clock::now();
+        std::printf("section   %.1f ns/lookup (%u/%d mapped)\n",
+                    std::chrono::duration<double, std::nano>(t1 - t0).count() / lookups, hits, lookups);
+    }
+
+    uint32_t foundDirect = 0, foundMemo = 0;
+    auto direct = run(mem, sets, requests, [&](const Check& c) {
+        uint8_t h[20];
+        return directHash(mem, c, h) && std::memcmp(h, c.expected, 20) == 0;
+    }, foundDirect);
+
+    auto memo = run(mem, sets, requests, [&](const Check& c) {
+        return mem.pageMatches(c.seed, c.expected, c.va, c.length);
+    }, foundMemo);
+
+    report("direct", direct);
+    report("memoized", memo);
+    std::printf("          page cache %zu entries, %llu hits, %llu misses; matches direct=%u memoized=%u\n",
+                mem.getPageCacheSize(),
+                static_cast<unsigned long long>(mem.getPageCacheHits()),
+                static_cast<unsigned long long>(mem.getPageCacheMisses()),
+                foundDirect, foundMemo);
+    return foundDirect == foundMemo ? 0 : 2;
+}